@@ -0,0 +1,162 @@
+/****************************************************************************
+ * arch/sim/src/sim/up_chksum.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/net/netdev.h>
+
+#ifdef CONFIG_SIM_NET_CHKSUM_SIMD
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The checksum is accumulated in 32-bit vector lanes using GCC vector
+ * extensions, so no host headers are needed.  The function is compiled
+ * for the selected instruction set with the SIMD_TARGET attribute.
+ */
+
+#ifdef CONFIG_SIM_NET_CHKSUM_AVX2
+#  define VECSIZE      32
+#  define SIMD_TARGET  __attribute__((target("avx2")))
+#else
+#  define VECSIZE      16
+#  define SIMD_TARGET  __attribute__((target("sse2")))
+#endif
+
+#define NLANES         (VECSIZE / 4)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+typedef uint32_t vec32_t __attribute__((vector_size(VECSIZE), may_alias,
+                                        aligned(1)));
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: chksum
+ *
+ * Description:
+ *   Calculate the raw change some over the memory region described by
+ *   data and len, VECSIZE bytes at a time.
+ *
+ *   Each 32-bit lane of a vector holds two little-endian 16-bit words of
+ *   the data.  These are separated with a mask and a shift and added to
+ *   32-bit lane accumulators, which cannot overflow for a uint16_t
+ *   length.  The lanes are then added together and folded to 16 bits.
+ *   Because the words were summed in little-endian order, the folded sum
+ *   is byte swapped to obtain the network order sum (RFC 1071).
+ *
+ ****************************************************************************/
+
+SIMD_TARGET
+uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
+{
+  vec32_t acc;
+  uint64_t total = 0;
+  uint32_t result;
+  int i;
+
+  memset(&acc, 0, sizeof(vec32_t));
+
+  while (len >= 2 * VECSIZE)
+    {
+      vec32_t v0 = *(FAR const vec32_t *)data;
+      vec32_t v1 = *(FAR const vec32_t *)(data + VECSIZE);
+
+      acc  += (v0 & 0xffff) + (v0 >> 16);
+      acc  += (v1 & 0xffff) + (v1 >> 16);
+      data += 2 * VECSIZE;
+      len  -= 2 * VECSIZE;
+    }
+
+  if (len >= VECSIZE)
+    {
+      vec32_t v0 = *(FAR const vec32_t *)data;
+
+      acc  += (v0 & 0xffff) + (v0 >> 16);
+      data += VECSIZE;
+      len  -= VECSIZE;
+    }
+
+  for (i = 0; i < NLANES; i++)
+    {
+      total += acc[i];
+    }
+
+  /* Sum the remaining (fewer than VECSIZE) bytes */
+
+  while (len >= 2)
+    {
+      total += (uint32_t)data[0] | ((uint32_t)data[1] << 8);
+      data  += 2;
+      len   -= 2;
+    }
+
+  if (len > 0)
+    {
+      total += data[0];
+    }
+
+  /* Fold to 16 bits and convert to network order */
+
+  while ((total >> 16) != 0)
+    {
+      total = (total & 0xffff) + (total >> 16);
+    }
+
+  result = (uint32_t)total;
+  result = ((result << 8) | (result >> 8)) & 0xffff;
+
+  /* Add in the partial sum from the previous call */
+
+  result += sum;
+  result  = (result & 0xffff) + (result >> 16);
+
+  return (uint16_t)result;
+}
+
+#endif /* CONFIG_SIM_NET_CHKSUM_SIMD */
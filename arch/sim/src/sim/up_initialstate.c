@@ -67,6 +67,6 @@
 void up_initial_state(struct tcb_s *tcb)
 {
   memset(&tcb->xcp, 0, sizeof(struct xcptcontext));
-  tcb->xcp.regs[JB_SP] = (xcpt_reg_t)tcb->adj_stack_ptr;
+  tcb->xcp.regs[JB_SP] = SIM_STACK_ENTRY(tcb->adj_stack_ptr);
   tcb->xcp.regs[JB_PC] = (xcpt_reg_t)tcb->start;
 }
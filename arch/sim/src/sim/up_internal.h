@@ -155,6 +155,18 @@
 #  define JB_PC 9
 #endif
 
+/* A new task is entered by longjmp'ing to its entry point, not by a call, so
+ * no return address is pushed.  The x86 ABIs expect the stack pointer to be
+ * one return address below a 16-byte boundary on function entry; without
+ * this adjustment, the compiler's aligned SSE spills and loads fault.
+ */
+
+#if defined(CONFIG_HOST_X86_64) || defined(CONFIG_HOST_X86)
+#  define SIM_STACK_ENTRY(top) ((xcpt_reg_t)(top) - sizeof(xcpt_reg_t))
+#else
+#  define SIM_STACK_ENTRY(top) ((xcpt_reg_t)(top))
+#endif
+
 /* Simulated Heap Definitions **********************************************/
 
 /* Size of the simulated heap */
@@ -223,8 +235,8 @@ extern volatile int g_uart_data_available;
  * so that it will be ready for the next pause operation.
  */
 
-volatile spinlock_t g_cpu_wait[CONFIG_SMP_NCPUS] SP_SECTION;
-volatile spinlock_t g_cpu_paused[CONFIG_SMP_NCPUS] SP_SECTION;
+extern volatile spinlock_t g_cpu_wait[CONFIG_SMP_NCPUS] SP_SECTION;
+extern volatile spinlock_t g_cpu_paused[CONFIG_SMP_NCPUS] SP_SECTION;
 #endif
 
 /****************************************************************************
@@ -240,6 +252,10 @@ void up_longjmp(xcpt_reg_t *jb, int val) noreturn_function;
 
 int up_hostusleep(unsigned int usec);
 
+/* up_hosttime.c **********************************************************/
+
+uint64_t up_hosttime(void);
+
 /* up_simsmp.c ************************************************************/
 
 #ifdef CONFIG_SMP
@@ -360,12 +376,14 @@ FAR struct ioexpander_dev_s *sim_ioexpander_initialize(void);
 void tapdev_init(void);
 unsigned int tapdev_read(unsigned char *buf, unsigned int buflen);
 void tapdev_send(unsigned char *buf, unsigned int buflen);
+void tapdev_sendv(unsigned char **bufs, unsigned int *buflens, int nbufs);
 void tapdev_ifup(in_addr_t ifaddr);
 void tapdev_ifdown(void);
 
 #  define netdev_init()           tapdev_init()
 #  define netdev_read(buf,buflen) tapdev_read(buf,buflen)
 #  define netdev_send(buf,buflen) tapdev_send(buf,buflen)
+#  define netdev_sendv(bufs,buflens,nbufs) tapdev_sendv(bufs,buflens,nbufs)
 #  define netdev_ifup(ifaddr)     tapdev_ifup(ifaddr)
 #  define netdev_ifdown()         tapdev_ifdown()
 #endif
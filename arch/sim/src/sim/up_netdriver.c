@@ -56,6 +56,11 @@
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/arp.h>
 
+#if defined(CONFIG_NET_TCP_SEND_ZEROCOPY) || \
+    defined(CONFIG_NET_TCP_RECV_ZEROCOPY)
+#  include <nuttx/mm/iob.h>
+#endif
+
 #ifdef CONFIG_NET_PKT
 #  include <nuttx/net/pkt.h>
 #endif
@@ -68,6 +73,24 @@
 
 #define BUF ((struct eth_hdr_s *)g_sim_dev.d_buf)
 
+/* The TAP device can gather the TCP payload from the I/O buffer chain.
+ * SIM_MAXIOV must not exceed TAPDEV_MAXIOV in up_tapdev.c.
+ */
+
+#if defined(CONFIG_NET_TCP_SEND_ZEROCOPY) && defined(netdev_sendv)
+#  define SIM_NET_SENDV 1
+#  define SIM_MAXIOV    16
+#endif
+
+/* Frames are received directly into I/O buffers so that TCP can queue
+ * their payload without copying it.
+ */
+
+#ifdef CONFIG_NET_TCP_RECV_ZEROCOPY
+#  define SIM_NET_RXIOB 1
+#  define SIM_PKTBUFSIZE (MAX_NETDEV_PKTSIZE + CONFIG_NET_GUARDSIZE)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -112,6 +135,129 @@ void timer_reset(struct timer *t)
   t->start += t->interval;
 }
 
+/****************************************************************************
+ * Name: sim_rxbuffer
+ *
+ * Description:
+ *   Make sure that the driver has an I/O buffer large enough for a frame
+ *   in d_iob/d_buf.  The network takes the buffer when it queues the
+ *   payload of a received TCP segment and leaves a new one in its place,
+ *   which may be too small.  The static packet buffer is used if no I/O
+ *   buffer of the required size is available.
+ *
+ ****************************************************************************/
+
+#ifdef SIM_NET_RXIOB
+static void sim_rxbuffer(void)
+{
+  FAR struct iob_s *iob = g_sim_dev.d_iob;
+
+  if (iob != NULL && IOB_BUFSIZE(iob) < SIM_PKTBUFSIZE)
+    {
+      (void)iob_free(iob, IOBUSER_NET_TCP_READAHEAD);
+      iob = NULL;
+    }
+
+  if (iob == NULL)
+    {
+      iob = iob_tryalloc_size(SIM_PKTBUFSIZE, true,
+                              IOBUSER_NET_TCP_READAHEAD);
+      if (iob != NULL && IOB_BUFSIZE(iob) < SIM_PKTBUFSIZE)
+        {
+          (void)iob_free(iob, IOBUSER_NET_TCP_READAHEAD);
+          iob = NULL;
+        }
+    }
+
+  g_sim_dev.d_iob = iob;
+  g_sim_dev.d_buf = iob != NULL ? iob->io_data : g_pktbuf;
+}
+#else
+#  define sim_rxbuffer()
+#endif
+
+/****************************************************************************
+ * Name: sim_send
+ *
+ * Description:
+ *   Send the packet in d_buf.  If the TCP payload was left in an I/O buffer
+ *   chain (d_txiob), then the headers in d_buf and the payload in the chain
+ *   are gathered into a single frame.
+ *
+ ****************************************************************************/
+
+#ifdef SIM_NET_SENDV
+static void sim_send(void)
+{
+  FAR struct iob_s *iob = g_sim_dev.d_txiob;
+  unsigned char *bufs[SIM_MAXIOV];
+  unsigned int buflens[SIM_MAXIOV];
+  unsigned int offset;
+  unsigned int remaining;
+  int nbufs;
+
+  if (iob == NULL)
+    {
+      netdev_send(g_sim_dev.d_buf, g_sim_dev.d_len);
+      return;
+    }
+
+  DEBUGASSERT(g_sim_dev.d_txmss == 0);
+
+  /* The headers are in d_buf */
+
+  bufs[0]    = g_sim_dev.d_buf;
+  buflens[0] = g_sim_dev.d_len - g_sim_dev.d_txlen;
+  nbufs      = 1;
+
+  /* Skip to the I/O buffer containing the start of the payload */
+
+  offset = g_sim_dev.d_txoffset;
+  while (iob != NULL && offset >= iob->io_len)
+    {
+      offset -= iob->io_len;
+      iob     = iob->io_flink;
+    }
+
+  /* Then add each I/O buffer that contains part of the payload */
+
+  remaining = g_sim_dev.d_txlen;
+  while (iob != NULL && remaining > 0 && nbufs < SIM_MAXIOV)
+    {
+      unsigned int len = iob->io_len - offset;
+
+      if (len > remaining)
+        {
+          len = remaining;
+        }
+
+      bufs[nbufs]    = &iob->io_data[iob->io_offset + offset];
+      buflens[nbufs] = len;
+      nbufs++;
+
+      remaining -= len;
+      offset     = 0;
+      iob        = iob->io_flink;
+    }
+
+  if (remaining > 0)
+    {
+      /* Too many I/O buffers; copy the payload into d_buf instead */
+
+      devif_iob_linearize(&g_sim_dev);
+      netdev_send(g_sim_dev.d_buf, g_sim_dev.d_len);
+    }
+  else
+    {
+      netdev_sendv(bufs, buflens, nbufs);
+    }
+
+  g_sim_dev.d_txiob = NULL;
+}
+#else
+#  define sim_send() netdev_send(g_sim_dev.d_buf, g_sim_dev.d_len)
+#endif
+
 static int sim_txpoll(struct net_driver_s *dev)
 {
   /* If the polling resulted in data that should be sent out on the network,
@@ -147,7 +293,7 @@ static int sim_txpoll(struct net_driver_s *dev)
           /* Send the packet */
 
           NETDEV_TXPACKETS(dev);
-          netdev_send(g_sim_dev.d_buf, g_sim_dev.d_len);
+          sim_send();
           NETDEV_TXDONE(dev);
         }
     }
@@ -167,6 +313,10 @@ void netdriver_loop(void)
 {
   FAR struct eth_hdr_s *eth;
 
+  /* Get a buffer for the next frame */
+
+  sim_rxbuffer();
+
   /* Check for new frames.  If so, then poll the network for new XMIT data */
 
   net_lock();
@@ -242,7 +392,7 @@ void netdriver_loop(void)
 
                   /* And send the packet */
 
-                  netdev_send(g_sim_dev.d_buf, g_sim_dev.d_len);
+                  sim_send();
                 }
             }
           else
@@ -281,7 +431,7 @@ void netdriver_loop(void)
 
                   /* And send the packet */
 
-                  netdev_send(g_sim_dev.d_buf, g_sim_dev.d_len);
+                  sim_send();
                 }
             }
           else
@@ -352,6 +502,9 @@ int netdriver_init(void)
   g_sim_dev.d_buf    = g_pktbuf;         /* Single packet buffer */
   g_sim_dev.d_ifup   = netdriver_ifup;
   g_sim_dev.d_ifdown = netdriver_ifdown;
+#ifdef SIM_NET_SENDV
+  g_sim_dev.d_txcaps = NETDEV_TXCAP_IOB; /* Gather TCP payload from IOBs */
+#endif
 
   /* Register the device with the OS so that socket IOCTLs can be performed */
 
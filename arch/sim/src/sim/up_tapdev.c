@@ -76,6 +76,10 @@
 
 #define DEVTAP        "/dev/net/tun"
 
+/* The maximum number of buffers gathered into one frame by tapdev_sendv() */
+
+#define TAPDEV_MAXIOV 16
+
 /* Syslog priority (must match definitions in nuttx/include/syslog.h) */
 
 #define LOG_INFO      1  /* Informational message */
@@ -302,6 +306,34 @@ void tapdev_send(unsigned char *buf, unsigned int buflen)
   dump_ethhdr("write", buf, buflen);
 }
 
+void tapdev_sendv(unsigned char **bufs, unsigned int *buflens, int nbufs)
+{
+  struct iovec iov[TAPDEV_MAXIOV];
+  int ret;
+  int i;
+
+  if (nbufs > TAPDEV_MAXIOV)
+    {
+      syslog(LOG_ERR, "TAPDEV: too many buffers: %d", nbufs);
+      exit(1);
+    }
+
+  for (i = 0; i < nbufs; i++)
+    {
+      iov[i].iov_base = bufs[i];
+      iov[i].iov_len  = buflens[i];
+    }
+
+  ret = writev(gtapdevfd, iov, nbufs);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "TAPDEV: writev failed: %d", -ret);
+      exit(1);
+    }
+
+  dump_ethhdr("writev", bufs[0], buflens[0]);
+}
+
 void tapdev_ifup(in_addr_t ifaddr)
 {
   struct ifreq ifr;
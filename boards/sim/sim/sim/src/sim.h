@@ -42,6 +42,8 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -145,4 +147,145 @@ int sim_gpio_initialize(void);
 int sim_tsc_setup(int minor);
 #endif
 
+/****************************************************************************
+ * Name: sim_epolltest
+ *
+ * Description:
+ *   Check the events reported by epoll_wait() and the lifetime of an epoll
+ *   instance whose descriptor has been duplicated.
+ *
+ * Returned Value:
+ *   Zero (OK) if all checks passed; ERROR otherwise.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_EPOLLTEST
+int sim_epolltest(void);
+#endif
+
+/****************************************************************************
+ * Name: sim_bench
+ *
+ * Description:
+ *   Run the selected benchmarks and print their results in the format read
+ *   by tools/simbench.py.  All times are taken from the host clock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_BENCH
+int sim_bench(void);
+void sim_bench_report(FAR const char *test, FAR const char *metric,
+                      unsigned long value, FAR const char *unit);
+unsigned long sim_bench_rate(unsigned long count, uint64_t elapsed);
+uint32_t sim_bench_rand(FAR uint32_t *seed);
+#endif
+
+/****************************************************************************
+ * Name: sim_mmbench
+ *
+ * Description:
+ *   Heap allocation trace benchmark.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_BENCH_MM
+void sim_mmbench(void);
+#endif
+
+/****************************************************************************
+ * Name: sim_wdbench
+ *
+ * Description:
+ *   Watchdog timer scaling benchmark.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_BENCH_WDOG
+void sim_wdbench(void);
+#endif
+
+/****************************************************************************
+ * Name: sim_netbench
+ *
+ * Description:
+ *   Multi-flow loopback network throughput benchmark.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_BENCH_NET
+void sim_netbench(void);
+#endif
+
+/****************************************************************************
+ * Name: sim_mmsgbench
+ *
+ * Description:
+ *   Batched UDP datagram rate benchmark.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_BENCH_MMSG
+void sim_mmsgbench(void);
+#endif
+
+/****************************************************************************
+ * Name: sim_strbench
+ *
+ * Description:
+ *   String and memory function throughput benchmark.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_BENCH_STRING
+void sim_strbench(void);
+#endif
+
+/****************************************************************************
+ * Name: sim_fatbench
+ *
+ * Description:
+ *   FAT file system benchmark.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_BENCH_FAT
+void sim_fatbench(void);
+#endif
+
+/****************************************************************************
+ * Name: sim_inodebench
+ *
+ * Description:
+ *   Path look-up benchmark.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_BENCH_INODE
+void sim_inodebench(void);
+#endif
+
+/****************************************************************************
+ * Name: sim_mtdbench
+ *
+ * Description:
+ *   FLASH translation layer benchmark.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_BENCH_MTD
+void sim_mtdbench(void);
+#endif
+
+/****************************************************************************
+ * Name: sim_schedbench
+ *
+ * Description:
+ *   Context switch rate benchmark.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_BENCH_SCHED
+void sim_schedbench(void);
+#endif
+
 #endif /* __BOARDS_SIM_SIM_SIM_SRC_SIM_H */
\ No newline at end of file
@@ -83,6 +83,18 @@ int board_app_initialize(uintptr_t arg)
   up_rptun_init();
 #endif
 
+#ifdef CONFIG_SIM_EPOLLTEST
+  /* Run the epoll regression test */
+
+  (void)sim_epolltest();
+#endif
+
+#ifdef CONFIG_SIM_BENCH
+  /* Run the selected benchmarks */
+
+  (void)sim_bench();
+#endif
+
   return 0;
 }
 #endif /* CONFIG_LIB_BOARDCTL */
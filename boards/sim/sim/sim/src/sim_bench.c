@@ -0,0 +1,152 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_bench.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_BENCH
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_bench_report
+ *
+ * Description:
+ *   Print one result in the format read by tools/simbench.py.
+ *
+ ****************************************************************************/
+
+void sim_bench_report(FAR const char *test, FAR const char *metric,
+                      unsigned long value, FAR const char *unit)
+{
+  printf("simbench: %s %s %lu %s\n", test, metric, value, unit);
+}
+
+/****************************************************************************
+ * Name: sim_bench_rate
+ *
+ * Description:
+ *   Convert a count of events that took 'elapsed' host nanoseconds to a
+ *   rate per second.
+ *
+ ****************************************************************************/
+
+unsigned long sim_bench_rate(unsigned long count, uint64_t elapsed)
+{
+  if (elapsed == 0)
+    {
+      elapsed = 1;
+    }
+
+  return (unsigned long)((uint64_t)count * 1000000000ull / elapsed);
+}
+
+/****************************************************************************
+ * Name: sim_bench_rand
+ *
+ * Description:
+ *   A small linear congruential generator so that every run replays the
+ *   same pseudo-random sequence.
+ *
+ ****************************************************************************/
+
+uint32_t sim_bench_rand(FAR uint32_t *seed)
+{
+  *seed = *seed * 1103515245 + 12345;
+  return *seed >> 1;
+}
+
+/****************************************************************************
+ * Name: sim_bench
+ *
+ * Description:
+ *   Run the selected benchmarks.
+ *
+ ****************************************************************************/
+
+int sim_bench(void)
+{
+#ifdef CONFIG_SIM_BENCH_MM
+  sim_mmbench();
+#endif
+
+#ifdef CONFIG_SIM_BENCH_WDOG
+  sim_wdbench();
+#endif
+
+#ifdef CONFIG_SIM_BENCH_NET
+  sim_netbench();
+#endif
+
+#ifdef CONFIG_SIM_BENCH_MMSG
+  sim_mmsgbench();
+#endif
+
+#ifdef CONFIG_SIM_BENCH_STRING
+  sim_strbench();
+#endif
+
+#ifdef CONFIG_SIM_BENCH_FAT
+  sim_fatbench();
+#endif
+
+#ifdef CONFIG_SIM_BENCH_INODE
+  sim_inodebench();
+#endif
+
+#ifdef CONFIG_SIM_BENCH_MTD
+  sim_mtdbench();
+#endif
+
+#ifdef CONFIG_SIM_BENCH_SCHED
+  sim_schedbench();
+#endif
+
+  printf("simbench: done\n");
+  return OK;
+}
+
+#endif /* CONFIG_SIM_BENCH */
@@ -0,0 +1,261 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_epolltest.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/epoll.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "sim.h"
+
+#ifdef CONFIG_SIM_EPOLLTEST
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define EPOLLTEST_NEVENTS 4
+
+#define epolltest_check(c) \
+  do \
+    { \
+      if (!(c)) \
+        { \
+          printf("epolltest: line %d: %s failed\n", __LINE__, #c); \
+          g_nerrors++; \
+        } \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static int g_nerrors;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: epolltest_wait
+ *
+ * Description:
+ *   Poll an epoll instance without waiting and return the number of events
+ *   and the user data of the first one.
+ *
+ ****************************************************************************/
+
+static int epolltest_wait(int epfd, FAR uint32_t *data)
+{
+  struct epoll_event evs[EPOLLTEST_NEVENTS];
+  int ret;
+
+  ret = epoll_wait(epfd, evs, EPOLLTEST_NEVENTS, 0);
+  if (ret > 0 && data != NULL)
+    {
+      *data = evs[0].data.u32;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: epolltest_add
+ ****************************************************************************/
+
+static int epolltest_add(int epfd, int op, int fd, uint32_t events,
+                         uint32_t data)
+{
+  struct epoll_event ev;
+
+  ev.events   = events;
+  ev.data.u32 = data;
+  return epoll_ctl(epfd, op, fd, &ev);
+}
+
+/****************************************************************************
+ * Name: epolltest_triggers
+ *
+ * Description:
+ *   Level-triggered items are reported for as long as they are ready and no
+ *   longer; edge-triggered items once per new event; one-shot items once
+ *   per EPOLL_CTL_MOD.
+ *
+ ****************************************************************************/
+
+static void epolltest_triggers(int epfd, FAR int *lt, FAR int *et)
+{
+  uint32_t data = 0;
+  char ch = 'x';
+
+  epolltest_check(epolltest_add(epfd, EPOLL_CTL_ADD, lt[0], EPOLLIN, 1) ==
+                  0);
+  epolltest_check(epolltest_add(epfd, EPOLL_CTL_ADD, et[0],
+                                EPOLLIN | EPOLLET, 2) == 0);
+  epolltest_check(epolltest_wait(epfd, NULL) == 0);
+
+  /* Both are reported once the data arrives */
+
+  epolltest_check(write(lt[1], &ch, 1) == 1);
+  epolltest_check(write(et[1], &ch, 1) == 1);
+  epolltest_check(epolltest_wait(epfd, NULL) == 2);
+
+  /* Only the level-triggered item is reported again */
+
+  epolltest_check(epolltest_wait(epfd, &data) == 1 && data == 1);
+  epolltest_check(epolltest_wait(epfd, &data) == 1 && data == 1);
+
+  /* Once its data has been consumed, the level-triggered item must not be
+   * reported with the events it had when it was last polled.
+   */
+
+  epolltest_check(read(lt[0], &ch, 1) == 1);
+  epolltest_check(epolltest_wait(epfd, NULL) == 0);
+
+  /* New data is a new edge */
+
+  epolltest_check(write(et[1], &ch, 1) == 1);
+  epolltest_check(epolltest_wait(epfd, &data) == 1 && data == 2);
+  epolltest_check(epolltest_wait(epfd, NULL) == 0);
+  epolltest_check(read(et[0], &ch, 1) == 1);
+  epolltest_check(read(et[0], &ch, 1) == 1);
+
+  /* A one-shot item is disabled after it has been reported */
+
+  epolltest_check(epolltest_add(epfd, EPOLL_CTL_MOD, lt[0],
+                                EPOLLIN | EPOLLONESHOT, 3) == 0);
+  epolltest_check(write(lt[1], &ch, 1) == 1);
+  epolltest_check(epolltest_wait(epfd, &data) == 1 && data == 3);
+  epolltest_check(epolltest_wait(epfd, NULL) == 0);
+  epolltest_check(epolltest_add(epfd, EPOLL_CTL_MOD, lt[0],
+                                EPOLLIN | EPOLLONESHOT, 3) == 0);
+  epolltest_check(epolltest_wait(epfd, &data) == 1 && data == 3);
+  epolltest_check(read(lt[0], &ch, 1) == 1);
+
+  epolltest_check(epoll_ctl(epfd, EPOLL_CTL_DEL, et[0], NULL) == 0);
+  epolltest_check(epolltest_add(epfd, EPOLL_CTL_MOD, lt[0], EPOLLIN, 1) ==
+                  0);
+}
+
+/****************************************************************************
+ * Name: epolltest_dup
+ *
+ * Description:
+ *   An epoll instance must live as long as any descriptor refers to it,
+ *   however the descriptor was duplicated.
+ *
+ ****************************************************************************/
+
+static void epolltest_dup(int epfd, FAR int *lt)
+{
+  uint32_t data = 0;
+  char ch = 'x';
+  int fd1;
+  int fd2;
+
+  fd1 = dup(epfd);
+  epolltest_check(fd1 >= 0);
+  epolltest_check(close(epfd) == 0);
+
+  epolltest_check(write(lt[1], &ch, 1) == 1);
+  epolltest_check(epolltest_wait(fd1, &data) == 1 && data == 1);
+
+  fd2 = fcntl(fd1, F_DUPFD, 0);
+  epolltest_check(fd2 >= 0);
+  epolltest_check(close(fd1) == 0);
+
+  epolltest_check(epolltest_wait(fd2, &data) == 1 && data == 1);
+  epolltest_check(read(lt[0], &ch, 1) == 1);
+  epolltest_check(epolltest_wait(fd2, NULL) == 0);
+
+  /* Closing a monitored descriptor removes it from the interest list */
+
+  epolltest_check(write(lt[1], &ch, 1) == 1);
+  epolltest_check(close(lt[0]) == 0);
+  epolltest_check(epolltest_wait(fd2, NULL) == 0);
+  epolltest_check(epoll_ctl(fd2, EPOLL_CTL_DEL, lt[0], NULL) < 0);
+
+  epolltest_check(close(fd2) == 0);
+  epolltest_check(epolltest_wait(fd2, NULL) < 0);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_epolltest
+ *
+ * Description:
+ *   Check the events reported by epoll_wait() and the lifetime of an epoll
+ *   instance whose descriptor has been duplicated.
+ *
+ ****************************************************************************/
+
+int sim_epolltest(void)
+{
+  int epfd;
+  int lt[2];
+  int et[2];
+
+  g_nerrors = 0;
+
+  epfd = epoll_create1(0);
+  if (epfd < 0 || pipe(lt) < 0 || pipe(et) < 0)
+    {
+      printf("epolltest: setup failed\n");
+      return ERROR;
+    }
+
+  epolltest_triggers(epfd, lt, et);
+  epolltest_dup(epfd, lt);
+
+  close(lt[1]);
+  close(et[0]);
+  close(et[1]);
+
+  printf("epolltest: %s (%d errors)\n", g_nerrors > 0 ? "FAILED" : "PASSED",
+         g_nerrors);
+  return g_nerrors > 0 ? ERROR : OK;
+}
+
+#endif /* CONFIG_SIM_EPOLLTEST */
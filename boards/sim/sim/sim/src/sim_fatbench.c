@@ -0,0 +1,494 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_fatbench.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/mount.h>
+#include <sys/stat.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_BENCH_FAT
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define FATBENCH_DEVPATH      "/dev/fatbench"
+#define FATBENCH_MOUNTPT      "/mnt/fatbench"
+
+/* A 16 MiB FAT16 volume with 2 KiB clusters */
+
+#define FATBENCH_SECTORSIZE   512
+#define FATBENCH_NSECTORS     32768
+#define FATBENCH_CLUSTSIZE    4
+#define FATBENCH_ROOTENTRIES  512
+#define FATBENCH_FATSIZE \
+  (((FATBENCH_NSECTORS / FATBENCH_CLUSTSIZE + 2) * 2 + \
+    FATBENCH_SECTORSIZE - 1) / FATBENCH_SECTORSIZE)
+
+/* The workloads */
+
+#define FATBENCH_NFILES       128    /* Files in the listed directory */
+#define FATBENCH_NLISTS       16     /* Directory listings */
+#define FATBENCH_FILESIZE     (1024 * 1024)
+#define FATBENCH_NCOPIES      4      /* Copies of the file */
+#define FATBENCH_CHUNKSIZE    4096   /* Size of each read and write */
+#define FATBENCH_NRANDOM      4096   /* Random reads */
+#define FATBENCH_RANDSIZE     512    /* Size of each random read */
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static ssize_t fatbench_read(FAR struct inode *inode,
+                             FAR unsigned char *buffer, size_t start_sector,
+                             unsigned int nsectors);
+static ssize_t fatbench_write(FAR struct inode *inode,
+                              FAR const unsigned char *buffer,
+                              size_t start_sector, unsigned int nsectors);
+static int     fatbench_geometry(FAR struct inode *inode,
+                                 FAR struct geometry *geometry);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct block_operations g_fatbench_bops =
+{
+  NULL,              /* open */
+  NULL,              /* close */
+  fatbench_read,     /* read */
+  fatbench_write,    /* write */
+  fatbench_geometry, /* geometry */
+  NULL               /* ioctl */
+};
+
+static uint8_t g_fatbench_image[FATBENCH_NSECTORS * FATBENCH_SECTORSIZE];
+static uint8_t g_fatbench_buf[FATBENCH_CHUNKSIZE];
+
+/* Block driver transfers since the counts were last cleared */
+
+static unsigned long g_fatbench_nreads;
+static unsigned long g_fatbench_nwrites;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fatbench_read, fatbench_write and fatbench_geometry
+ *
+ * Description:
+ *   A RAM disk that counts its transfers.
+ *
+ ****************************************************************************/
+
+static ssize_t fatbench_read(FAR struct inode *inode,
+                             FAR unsigned char *buffer, size_t start_sector,
+                             unsigned int nsectors)
+{
+  if (start_sector + nsectors > FATBENCH_NSECTORS)
+    {
+      return -EINVAL;
+    }
+
+  memcpy(buffer, &g_fatbench_image[start_sector * FATBENCH_SECTORSIZE],
+         nsectors * FATBENCH_SECTORSIZE);
+  g_fatbench_nreads++;
+  return nsectors;
+}
+
+static ssize_t fatbench_write(FAR struct inode *inode,
+                              FAR const unsigned char *buffer,
+                              size_t start_sector, unsigned int nsectors)
+{
+  if (start_sector + nsectors > FATBENCH_NSECTORS)
+    {
+      return -EINVAL;
+    }
+
+  memcpy(&g_fatbench_image[start_sector * FATBENCH_SECTORSIZE], buffer,
+         nsectors * FATBENCH_SECTORSIZE);
+  g_fatbench_nwrites++;
+  return nsectors;
+}
+
+static int fatbench_geometry(FAR struct inode *inode,
+                             FAR struct geometry *geometry)
+{
+  memset(geometry, 0, sizeof(struct geometry));
+  geometry->geo_available    = true;
+  geometry->geo_writeenabled = true;
+  geometry->geo_nsectors     = FATBENCH_NSECTORS;
+  geometry->geo_sectorsize   = FATBENCH_SECTORSIZE;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fatbench_put16
+ ****************************************************************************/
+
+static void fatbench_put16(FAR uint8_t *dest, uint16_t value)
+{
+  dest[0] = value & 0xff;
+  dest[1] = value >> 8;
+}
+
+/****************************************************************************
+ * Name: fatbench_format
+ *
+ * Description:
+ *   Create an empty FAT16 volume in the RAM disk.
+ *
+ ****************************************************************************/
+
+static void fatbench_format(void)
+{
+  FAR uint8_t *bs = g_fatbench_image;
+  FAR uint8_t *fat;
+  int i;
+
+  memset(g_fatbench_image, 0, sizeof(g_fatbench_image));
+
+  /* The boot sector */
+
+  bs[0] = 0xeb;
+  bs[1] = 0x3c;
+  bs[2] = 0x90;
+  memcpy(&bs[3], "NUTTX   ", 8);
+  fatbench_put16(&bs[11], FATBENCH_SECTORSIZE);
+  bs[13] = FATBENCH_CLUSTSIZE;
+  fatbench_put16(&bs[14], 1);                    /* Reserved sectors */
+  bs[16] = 2;                                    /* Number of FATs */
+  fatbench_put16(&bs[17], FATBENCH_ROOTENTRIES);
+  fatbench_put16(&bs[19], FATBENCH_NSECTORS);
+  bs[21] = 0xf8;                                 /* Fixed media */
+  fatbench_put16(&bs[22], FATBENCH_FATSIZE);
+  fatbench_put16(&bs[24], 32);                   /* Sectors per track */
+  fatbench_put16(&bs[26], 2);                    /* Heads */
+  bs[36] = 0x80;                                 /* Drive number */
+  bs[38] = 0x29;                                 /* Extended boot signature */
+  memcpy(&bs[43], "NO NAME    FAT16   ", 19);
+  bs[510] = 0x55;
+  bs[511] = 0xaa;
+
+  /* The reserved entries at the start of both FATs */
+
+  for (i = 0; i < 2; i++)
+    {
+      fat = &g_fatbench_image[(1 + i * FATBENCH_FATSIZE) *
+                              FATBENCH_SECTORSIZE];
+      fatbench_put16(&fat[0], 0xfff8);
+      fatbench_put16(&fat[2], 0xffff);
+    }
+}
+
+/****************************************************************************
+ * Name: fatbench_report
+ *
+ * Description:
+ *   Report the rate of a workload and the block driver transfers that it
+ *   took.
+ *
+ ****************************************************************************/
+
+static void fatbench_report(FAR const char *name, unsigned long count,
+                            uint64_t start, FAR const char *unit)
+{
+  char metric[32];
+
+  sim_bench_report("fat", name,
+                   sim_bench_rate(count, up_hosttime() - start), unit);
+
+  snprintf(metric, sizeof(metric), "%s-reads", name);
+  sim_bench_report("fat", metric, g_fatbench_nreads, "xfers");
+  snprintf(metric, sizeof(metric), "%s-writes", name);
+  sim_bench_report("fat", metric, g_fatbench_nwrites, "xfers");
+
+  g_fatbench_nreads  = 0;
+  g_fatbench_nwrites = 0;
+}
+
+/****************************************************************************
+ * Name: fatbench_list
+ *
+ * Description:
+ *   List a directory of small files and stat() each one, as 'ls -l' does.
+ *
+ ****************************************************************************/
+
+static int fatbench_list(void)
+{
+  FAR struct dirent *entry;
+  FAR DIR *dirp;
+  struct stat buf;
+  char path[64];
+  unsigned long nentries = 0;
+  uint64_t start;
+  int fd;
+  int i;
+
+  if (mkdir(FATBENCH_MOUNTPT "/dir", 0777) < 0)
+    {
+      return ERROR;
+    }
+
+  for (i = 0; i < FATBENCH_NFILES; i++)
+    {
+      snprintf(path, sizeof(path), FATBENCH_MOUNTPT "/dir/f%03d.txt", i);
+      fd = open(path, O_WRONLY | O_CREAT, 0666);
+      if (fd < 0 || write(fd, path, strlen(path)) < 0)
+        {
+          return ERROR;
+        }
+
+      close(fd);
+    }
+
+  g_fatbench_nreads  = 0;
+  g_fatbench_nwrites = 0;
+  start = up_hosttime();
+
+  for (i = 0; i < FATBENCH_NLISTS; i++)
+    {
+      dirp = opendir(FATBENCH_MOUNTPT "/dir");
+      if (dirp == NULL)
+        {
+          return ERROR;
+        }
+
+      while ((entry = readdir(dirp)) != NULL)
+        {
+          snprintf(path, sizeof(path), FATBENCH_MOUNTPT "/dir/%s",
+                   entry->d_name);
+          if (stat(path, &buf) < 0)
+            {
+              closedir(dirp);
+              return ERROR;
+            }
+
+          nentries++;
+        }
+
+      closedir(dirp);
+    }
+
+  fatbench_report("list", nentries, start, "entries/s");
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fatbench_copy
+ *
+ * Description:
+ *   Copy a 1 MiB file in 4 KiB chunks.
+ *
+ ****************************************************************************/
+
+static int fatbench_copy(void)
+{
+  uint64_t start;
+  ssize_t nread;
+  int infd;
+  int outfd;
+  int i;
+
+  outfd = open(FATBENCH_MOUNTPT "/src.bin", O_WRONLY | O_CREAT | O_TRUNC,
+               0666);
+  if (outfd < 0)
+    {
+      return ERROR;
+    }
+
+  for (i = 0; i < FATBENCH_FILESIZE / FATBENCH_CHUNKSIZE; i++)
+    {
+      memset(g_fatbench_buf, i, FATBENCH_CHUNKSIZE);
+      if (write(outfd, g_fatbench_buf, FATBENCH_CHUNKSIZE) < 0)
+        {
+          close(outfd);
+          return ERROR;
+        }
+    }
+
+  close(outfd);
+
+  g_fatbench_nreads  = 0;
+  g_fatbench_nwrites = 0;
+  start = up_hosttime();
+
+  for (i = 0; i < FATBENCH_NCOPIES; i++)
+    {
+      infd  = open(FATBENCH_MOUNTPT "/src.bin", O_RDONLY);
+      outfd = open(FATBENCH_MOUNTPT "/dst.bin",
+                   O_WRONLY | O_CREAT | O_TRUNC, 0666);
+      if (infd < 0 || outfd < 0)
+        {
+          goto errout;
+        }
+
+      while ((nread = read(infd, g_fatbench_buf, FATBENCH_CHUNKSIZE)) > 0)
+        {
+          if (write(outfd, g_fatbench_buf, nread) != nread)
+            {
+              goto errout;
+            }
+        }
+
+      close(infd);
+      close(outfd);
+    }
+
+  fatbench_report("copy", FATBENCH_NCOPIES * FATBENCH_FILESIZE / 1024,
+                  start, "KiB/s");
+  return OK;
+
+errout:
+  if (infd >= 0)
+    {
+      close(infd);
+    }
+
+  if (outfd >= 0)
+    {
+      close(outfd);
+    }
+
+  return ERROR;
+}
+
+/****************************************************************************
+ * Name: fatbench_random
+ *
+ * Description:
+ *   Read 512 bytes at each of many random offsets in the 1 MiB file.
+ *
+ ****************************************************************************/
+
+static int fatbench_random(void)
+{
+  uint32_t seed = 1;
+  uint64_t start;
+  off_t offset;
+  int fd;
+  int i;
+
+  fd = open(FATBENCH_MOUNTPT "/src.bin", O_RDONLY);
+  if (fd < 0)
+    {
+      return ERROR;
+    }
+
+  g_fatbench_nreads  = 0;
+  g_fatbench_nwrites = 0;
+  start = up_hosttime();
+
+  for (i = 0; i < FATBENCH_NRANDOM; i++)
+    {
+      offset = sim_bench_rand(&seed) %
+               (FATBENCH_FILESIZE - FATBENCH_RANDSIZE);
+      if (lseek(fd, offset, SEEK_SET) != offset ||
+          read(fd, g_fatbench_buf, FATBENCH_RANDSIZE) != FATBENCH_RANDSIZE)
+        {
+          close(fd);
+          return ERROR;
+        }
+    }
+
+  fatbench_report("random", FATBENCH_NRANDOM, start, "reads/s");
+  close(fd);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_fatbench
+ *
+ * Description:
+ *   Measure directory listing, file copy and random read performance of a
+ *   FAT volume on a RAM disk and count the block driver transfers of each.
+ *
+ ****************************************************************************/
+
+void sim_fatbench(void)
+{
+  int ret;
+
+  fatbench_format();
+
+  ret = register_blockdriver(FATBENCH_DEVPATH, &g_fatbench_bops, 0666,
+                             NULL);
+  if (ret < 0)
+    {
+      printf("simbench: fat cannot register %s: %d\n", FATBENCH_DEVPATH,
+             ret);
+      return;
+    }
+
+  if (mount(FATBENCH_DEVPATH, FATBENCH_MOUNTPT, "vfat", 0, NULL) < 0)
+    {
+      printf("simbench: fat cannot mount %s\n", FATBENCH_DEVPATH);
+      goto errout;
+    }
+
+  if (fatbench_list() < 0 || fatbench_copy() < 0 || fatbench_random() < 0)
+    {
+      printf("simbench: fat failed\n");
+    }
+
+  (void)umount(FATBENCH_MOUNTPT);
+
+errout:
+  (void)unregister_blockdriver(FATBENCH_DEVPATH);
+}
+
+#endif /* CONFIG_SIM_BENCH_FAT */
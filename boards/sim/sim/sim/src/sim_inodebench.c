@@ -0,0 +1,207 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_inodebench.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/stat.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_BENCH_INODE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define INODEBENCH_NDEVICES 256
+#define INODEBENCH_NHOT     16       /* Devices of the small working set */
+#define INODEBENCH_PATHLEN  24
+
+/* Each run lasts 200 ms of host time */
+
+#define INODEBENCH_DURATION 200000000ull
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static ssize_t inodebench_read(FAR struct file *filep, FAR char *buffer,
+                               size_t buflen);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_inodebench_fops =
+{
+  NULL,              /* open */
+  NULL,              /* close */
+  inodebench_read,   /* read */
+  NULL,              /* write */
+  NULL,              /* seek */
+  NULL               /* ioctl */
+};
+
+static char g_inodebench_path[INODEBENCH_NDEVICES][INODEBENCH_PATHLEN];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inodebench_read
+ ****************************************************************************/
+
+static ssize_t inodebench_read(FAR struct file *filep, FAR char *buffer,
+                               size_t buflen)
+{
+  return 0;
+}
+
+/****************************************************************************
+ * Name: inodebench_run
+ *
+ * Description:
+ *   open() and close() or stat() the first 'npaths' devices in turn for
+ *   200 ms and report the rate.  The path of a missing device is looked up
+ *   if 'npaths' is zero.
+ *
+ ****************************************************************************/
+
+static void inodebench_run(FAR const char *metric, bool useopen,
+                           unsigned int npaths)
+{
+  FAR const char *path;
+  struct stat buf;
+  unsigned long nops = 0;
+  uint64_t deadline;
+  uint64_t start;
+  int ret;
+  int fd;
+
+  start    = up_hosttime();
+  deadline = start + INODEBENCH_DURATION;
+
+  while (up_hosttime() < deadline)
+    {
+      path = npaths > 0 ? g_inodebench_path[nops % npaths] :
+                          "/dev/nodevice";
+
+      if (useopen)
+        {
+          fd  = open(path, O_RDONLY);
+          ret = fd;
+          if (fd >= 0)
+            {
+              close(fd);
+            }
+        }
+      else
+        {
+          ret = stat(path, &buf);
+        }
+
+      if ((ret < 0) != (npaths == 0))
+        {
+          printf("simbench: inode %s failed\n", path);
+          return;
+        }
+
+      nops++;
+    }
+
+  sim_bench_report("inode", metric,
+                   sim_bench_rate(nops, up_hosttime() - start), "ops/s");
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_inodebench
+ *
+ * Description:
+ *   Register 256 devices under /dev and measure the rate of open() and
+ *   stat() on a few of them, on all of them and on a path that does not
+ *   exist.
+ *
+ ****************************************************************************/
+
+void sim_inodebench(void)
+{
+  unsigned int ndevices;
+  int ret;
+
+  for (ndevices = 0; ndevices < INODEBENCH_NDEVICES; ndevices++)
+    {
+      snprintf(g_inodebench_path[ndevices], INODEBENCH_PATHLEN,
+               "/dev/bench%03u", ndevices);
+      ret = register_driver(g_inodebench_path[ndevices],
+                            &g_inodebench_fops, 0444, NULL);
+      if (ret < 0)
+        {
+          printf("simbench: inode cannot register %s: %d\n",
+                 g_inodebench_path[ndevices], ret);
+          goto errout;
+        }
+    }
+
+  inodebench_run("open-16", true, INODEBENCH_NHOT);
+  inodebench_run("open-256", true, INODEBENCH_NDEVICES);
+  inodebench_run("stat-16", false, INODEBENCH_NHOT);
+  inodebench_run("stat-256", false, INODEBENCH_NDEVICES);
+  inodebench_run("stat-missing", false, 0);
+
+errout:
+  while (ndevices-- > 0)
+    {
+      (void)unregister_driver(g_inodebench_path[ndevices]);
+    }
+}
+
+#endif /* CONFIG_SIM_BENCH_INODE */
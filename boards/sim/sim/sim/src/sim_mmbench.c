@@ -0,0 +1,275 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_mmbench.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <nuttx/mm/mm.h>
+
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_BENCH_MM
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MMBENCH_HEAPSIZE  (1024 * 1024)
+#define MMBENCH_NSLOTS    512
+#define MMBENCH_NOPS      200000
+
+/* Latencies are also collected in a histogram of MMBENCH_NBUCKETS buckets,
+ * MMBENCH_BUCKETNS nanoseconds each, for the percentiles.  A preempted
+ * simulation shows up in the worst case, but hardly in the percentiles.
+ */
+
+#define MMBENCH_BUCKETNS  16
+#define MMBENCH_NBUCKETS  1024
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct mmbench_lat_s
+{
+  uint32_t max;                       /* Worst-case latency */
+  uint32_t count;                     /* Number of samples */
+  uint32_t hist[MMBENCH_NBUCKETS];    /* Latency histogram */
+};
+
+struct mmbench_s
+{
+  uint64_t elapsed;                   /* Time of the whole trace */
+  uint32_t nfailed;                   /* Allocations that failed */
+  struct mmbench_lat_s malloc_lat;    /* malloc() latencies */
+  struct mmbench_lat_s free_lat;      /* free() latencies */
+  struct mallinfo info;               /* Free space at the end */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct mm_heap_s g_mmbench_heap;
+static uint8_t g_mmbench_mem[MMBENCH_HEAPSIZE];
+static FAR void *g_mmbench_slot[MMBENCH_NSLOTS];
+static struct mmbench_s g_mmbench;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mmbench_size
+ *
+ * Description:
+ *   Pick an allocation size: mostly small objects, some buffers and a few
+ *   large blocks.
+ *
+ ****************************************************************************/
+
+static size_t mmbench_size(FAR uint32_t *seed)
+{
+  uint32_t r = sim_bench_rand(seed) % 100;
+
+  if (r < 70)
+    {
+      return 8 + sim_bench_rand(seed) % 120;
+    }
+  else if (r < 95)
+    {
+      return 128 + sim_bench_rand(seed) % 896;
+    }
+  else
+    {
+      return 1024 + sim_bench_rand(seed) % 15360;
+    }
+}
+
+/****************************************************************************
+ * Name: mmbench_addsample
+ ****************************************************************************/
+
+static void mmbench_addsample(FAR struct mmbench_lat_s *lat, uint64_t t0)
+{
+  uint32_t dt = (uint32_t)(up_hosttime() - t0);
+  uint32_t ndx = dt / MMBENCH_BUCKETNS;
+
+  if (dt > lat->max)
+    {
+      lat->max = dt;
+    }
+
+  lat->hist[ndx < MMBENCH_NBUCKETS ? ndx : MMBENCH_NBUCKETS - 1]++;
+  lat->count++;
+}
+
+/****************************************************************************
+ * Name: mmbench_percentile
+ *
+ * Description:
+ *   Return the latency that 'permille' of the samples did not exceed.
+ *
+ ****************************************************************************/
+
+static unsigned long mmbench_percentile(FAR struct mmbench_lat_s *lat,
+                                        uint32_t permille)
+{
+  uint32_t limit = (uint32_t)((uint64_t)lat->count * permille / 1000);
+  uint32_t sum = 0;
+  int i;
+
+  for (i = 0; i < MMBENCH_NBUCKETS - 1; i++)
+    {
+      sum += lat->hist[i];
+      if (sum >= limit)
+        {
+          break;
+        }
+    }
+
+  return (unsigned long)(i + 1) * MMBENCH_BUCKETNS;
+}
+
+/****************************************************************************
+ * Name: mmbench_trace
+ *
+ * Description:
+ *   Replay the trace on a fresh heap.  Each operation picks a slot at
+ *   random and frees it if it is in use or allocates it if it is not.  If
+ *   'timed' is true, the latency of every operation is measured; otherwise
+ *   only the time of the whole trace is.
+ *
+ ****************************************************************************/
+
+static void mmbench_trace(FAR struct mmbench_s *res, bool timed)
+{
+  uint32_t seed = 1;
+  uint64_t start;
+  uint64_t t0;
+  int slot;
+  int i;
+
+  memset(res, 0, sizeof(struct mmbench_s));
+  memset(g_mmbench_slot, 0, sizeof(g_mmbench_slot));
+  mm_initialize(&g_mmbench_heap, g_mmbench_mem, MMBENCH_HEAPSIZE);
+
+  start = up_hosttime();
+  for (i = 0; i < MMBENCH_NOPS; i++)
+    {
+      slot = sim_bench_rand(&seed) % MMBENCH_NSLOTS;
+      t0   = timed ? up_hosttime() : 0;
+
+      if (g_mmbench_slot[slot] != NULL)
+        {
+          mm_free(&g_mmbench_heap, g_mmbench_slot[slot]);
+          g_mmbench_slot[slot] = NULL;
+
+          if (timed)
+            {
+              mmbench_addsample(&res->free_lat, t0);
+            }
+        }
+      else
+        {
+          g_mmbench_slot[slot] = mm_malloc(&g_mmbench_heap,
+                                           mmbench_size(&seed));
+          if (g_mmbench_slot[slot] == NULL)
+            {
+              res->nfailed++;
+            }
+
+          if (timed)
+            {
+              mmbench_addsample(&res->malloc_lat, t0);
+            }
+        }
+    }
+
+  res->elapsed = up_hosttime() - start;
+  (void)mm_mallinfo(&g_mmbench_heap, &res->info);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_mmbench
+ *
+ * Description:
+ *   Replay a pseudo-random allocation trace on a private heap.  Report the
+ *   throughput, the 99th percentile and worst-case latencies and the
+ *   fragmentation of the free space that is left at the end: the share of
+ *   it that is not part of the largest free chunk.
+ *
+ ****************************************************************************/
+
+void sim_mmbench(void)
+{
+  FAR struct mmbench_s *res = &g_mmbench;
+  unsigned long frag = 0;
+
+  mmbench_trace(res, false);
+  sim_bench_report("mm", "ops", sim_bench_rate(MMBENCH_NOPS, res->elapsed),
+                   "op/s");
+
+  if (res->info.fordblks > 0)
+    {
+      frag = 100 - (unsigned long)res->info.mxordblk * 100 /
+             res->info.fordblks;
+    }
+
+  sim_bench_report("mm", "fragmentation", frag, "%");
+  sim_bench_report("mm", "failed", res->nfailed, "allocs");
+
+  mmbench_trace(res, true);
+  sim_bench_report("mm", "malloc-p99",
+                   mmbench_percentile(&res->malloc_lat, 990), "ns");
+  sim_bench_report("mm", "malloc-max", res->malloc_lat.max, "ns");
+  sim_bench_report("mm", "free-p99",
+                   mmbench_percentile(&res->free_lat, 990), "ns");
+  sim_bench_report("mm", "free-max", res->free_lat.max, "ns");
+}
+
+#endif /* CONFIG_SIM_BENCH_MM */
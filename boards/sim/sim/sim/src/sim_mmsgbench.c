@@ -0,0 +1,280 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_mmsgbench.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_BENCH_MMSG
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MMSGBENCH_MAXBATCH 16
+#define MMSGBENCH_PORT     5700
+#define MMSGBENCH_DGRAMLEN 64
+
+/* Each run lasts one second of host time */
+
+#define MMSGBENCH_DURATION 1000000000ull
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The number of datagrams moved per call.  A batch of one uses sendto()
+ * and recv().
+ */
+
+static const unsigned int g_mmsgbench_batch[] =
+{
+  1, 4, 8, MMSGBENCH_MAXBATCH
+};
+
+static char g_mmsgbench_buf[MMSGBENCH_MAXBATCH][MMSGBENCH_DGRAMLEN];
+static struct iovec g_mmsgbench_iov[MMSGBENCH_MAXBATCH];
+static struct mmsghdr g_mmsgbench_msg[MMSGBENCH_MAXBATCH];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mmsgbench_single
+ *
+ * Description:
+ *   Move one datagram with sendto() and recv().  Returns the number of
+ *   datagrams received or a negative value on a failure.
+ *
+ ****************************************************************************/
+
+static int mmsgbench_single(int txsd, int rxsd,
+                            FAR const struct sockaddr_in *addr)
+{
+  if (sendto(txsd, g_mmsgbench_buf[0], MMSGBENCH_DGRAMLEN, 0,
+             (FAR const struct sockaddr *)addr, sizeof(*addr)) < 0 ||
+      recv(rxsd, g_mmsgbench_buf[0], MMSGBENCH_DGRAMLEN, 0) < 0)
+    {
+      return ERROR;
+    }
+
+  return 1;
+}
+
+/****************************************************************************
+ * Name: mmsgbench_batch
+ *
+ * Description:
+ *   Move 'batch' datagrams with one sendmmsg() and as many recvmmsg() calls
+ *   as it takes to collect them.  Returns the number of datagrams received
+ *   or a negative value on a failure.
+ *
+ ****************************************************************************/
+
+static int mmsgbench_batch(int txsd, int rxsd,
+                           FAR const struct sockaddr_in *addr,
+                           unsigned int batch)
+{
+  unsigned int nrecvd = 0;
+  unsigned int i;
+  int ret;
+
+  for (i = 0; i < batch; i++)
+    {
+      g_mmsgbench_msg[i].msg_hdr.msg_name    = (FAR void *)addr;
+      g_mmsgbench_msg[i].msg_hdr.msg_namelen = sizeof(*addr);
+    }
+
+  ret = sendmmsg(txsd, g_mmsgbench_msg, batch, 0);
+  if (ret != (int)batch)
+    {
+      return ERROR;
+    }
+
+  for (i = 0; i < batch; i++)
+    {
+      g_mmsgbench_msg[i].msg_hdr.msg_name    = NULL;
+      g_mmsgbench_msg[i].msg_hdr.msg_namelen = 0;
+    }
+
+  while (nrecvd < batch)
+    {
+      ret = recvmmsg(rxsd, &g_mmsgbench_msg[nrecvd], batch - nrecvd,
+                     MSG_WAITFORONE, NULL);
+      if (ret <= 0)
+        {
+          return ERROR;
+        }
+
+      nrecvd += ret;
+    }
+
+  return nrecvd;
+}
+
+/****************************************************************************
+ * Name: mmsgbench_run
+ *
+ * Description:
+ *   Move datagrams in batches of 'batch' between two sockets over the
+ *   loopback device for one second and report the packet rate.
+ *
+ ****************************************************************************/
+
+static void mmsgbench_run(int txsd, int rxsd,
+                          FAR const struct sockaddr_in *addr,
+                          unsigned int batch)
+{
+  char metric[16];
+  unsigned long npackets = 0;
+  uint64_t deadline;
+  uint64_t start;
+  int ret;
+
+  start    = up_hosttime();
+  deadline = start + MMSGBENCH_DURATION;
+
+  while (up_hosttime() < deadline)
+    {
+      if (batch == 1)
+        {
+          ret = mmsgbench_single(txsd, rxsd, addr);
+        }
+      else
+        {
+          ret = mmsgbench_batch(txsd, rxsd, addr, batch);
+        }
+
+      if (ret < 0)
+        {
+          printf("simbench: mmsg batch %u failed\n", batch);
+          break;
+        }
+
+      npackets += ret;
+    }
+
+  snprintf(metric, sizeof(metric), "batch-%u", batch);
+  sim_bench_report("mmsg", metric,
+                   sim_bench_rate(npackets, up_hosttime() - start), "pps");
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_mmsgbench
+ *
+ * Description:
+ *   Measure the rate of small UDP datagrams over the loopback device when
+ *   they are sent and received one at a time and in batches with
+ *   sendmmsg() and recvmmsg().
+ *
+ ****************************************************************************/
+
+void sim_mmsgbench(void)
+{
+  static const struct timeval timeout =
+  {
+    1, 0
+  };
+
+  struct sockaddr_in addr;
+  unsigned int i;
+  int rxsd;
+  int txsd;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family      = AF_INET;
+  addr.sin_port        = htons(MMSGBENCH_PORT);
+  addr.sin_addr.s_addr = HTONL(INADDR_LOOPBACK);
+
+  rxsd = socket(AF_INET, SOCK_DGRAM, 0);
+  txsd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (rxsd < 0 || txsd < 0 ||
+      bind(rxsd, (FAR struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+      setsockopt(rxsd, SOL_SOCKET, SO_RCVTIMEO, &timeout,
+                 sizeof(timeout)) < 0)
+    {
+      printf("simbench: mmsg setup failed\n");
+      goto errout;
+    }
+
+  for (i = 0; i < MMSGBENCH_MAXBATCH; i++)
+    {
+      memset(g_mmsgbench_buf[i], 0xa5, MMSGBENCH_DGRAMLEN);
+
+      g_mmsgbench_iov[i].iov_base           = g_mmsgbench_buf[i];
+      g_mmsgbench_iov[i].iov_len            = MMSGBENCH_DGRAMLEN;
+      g_mmsgbench_msg[i].msg_hdr.msg_iov    = &g_mmsgbench_iov[i];
+      g_mmsgbench_msg[i].msg_hdr.msg_iovlen = 1;
+    }
+
+  for (i = 0; i < sizeof(g_mmsgbench_batch) / sizeof(int); i++)
+    {
+      mmsgbench_run(txsd, rxsd, &addr, g_mmsgbench_batch[i]);
+    }
+
+errout:
+  if (rxsd >= 0)
+    {
+      close(rxsd);
+    }
+
+  if (txsd >= 0)
+    {
+      close(txsd);
+    }
+}
+
+#endif /* CONFIG_SIM_BENCH_MMSG */
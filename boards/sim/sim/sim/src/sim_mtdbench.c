@@ -0,0 +1,346 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_mtdbench.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/mount.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <nuttx/fs/fs.h>
+#include <nuttx/mtd/mtd.h>
+
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_BENCH_MTD
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MTDBENCH_DEVPATH   "/dev/mtdbench"
+#define MTDBENCH_SECTSIZE  512
+#define MTDBENCH_ERASESIZE 65536
+#define MTDBENCH_SIZE      (2 * 1024 * 1024)
+#define MTDBENCH_NWRITES   4096
+
+#if defined(CONFIG_FILEMTD) && defined(CONFIG_FS_TMPFS)
+#  define MTDBENCH_FILEMTD 1
+#  define MTDBENCH_TMPDIR  "/tmp/mtdbench"
+#  define MTDBENCH_FILE    MTDBENCH_TMPDIR "/flash.img"
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* An MTD device that counts the erases and the writes of another one */
+
+struct mtdbench_dev_s
+{
+  struct mtd_dev_s mtd;
+  FAR struct mtd_dev_s *lower;
+  unsigned long nerases;       /* Erase blocks erased */
+  unsigned long nwritten;      /* Blocks written */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMMTD
+static uint8_t g_mtdbench_flash[MTDBENCH_SIZE];
+#endif
+
+static uint8_t g_mtdbench_buf[MTDBENCH_SECTSIZE];
+static struct mtdbench_dev_s g_mtdbench_dev;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mtdbench_erase, mtdbench_bread, mtdbench_bwrite, mtdbench_read and
+ *       mtdbench_ioctl
+ *
+ * Description:
+ *   Count erases and writes and pass each request on to the lower device.
+ *
+ ****************************************************************************/
+
+static int mtdbench_erase(FAR struct mtd_dev_s *dev, off_t startblock,
+                          size_t nblocks)
+{
+  FAR struct mtdbench_dev_s *priv = (FAR struct mtdbench_dev_s *)dev;
+
+  priv->nerases += nblocks;
+  return MTD_ERASE(priv->lower, startblock, nblocks);
+}
+
+static ssize_t mtdbench_bread(FAR struct mtd_dev_s *dev, off_t startblock,
+                              size_t nblocks, FAR uint8_t *buffer)
+{
+  FAR struct mtdbench_dev_s *priv = (FAR struct mtdbench_dev_s *)dev;
+
+  return MTD_BREAD(priv->lower, startblock, nblocks, buffer);
+}
+
+static ssize_t mtdbench_bwrite(FAR struct mtd_dev_s *dev, off_t startblock,
+                               size_t nblocks, FAR const uint8_t *buffer)
+{
+  FAR struct mtdbench_dev_s *priv = (FAR struct mtdbench_dev_s *)dev;
+
+  priv->nwritten += nblocks;
+  return MTD_BWRITE(priv->lower, startblock, nblocks, buffer);
+}
+
+static ssize_t mtdbench_read(FAR struct mtd_dev_s *dev, off_t offset,
+                             size_t nbytes, FAR uint8_t *buffer)
+{
+  FAR struct mtdbench_dev_s *priv = (FAR struct mtdbench_dev_s *)dev;
+
+  return MTD_READ(priv->lower, offset, nbytes, buffer);
+}
+
+static int mtdbench_ioctl(FAR struct mtd_dev_s *dev, int cmd,
+                          unsigned long arg)
+{
+  FAR struct mtdbench_dev_s *priv = (FAR struct mtdbench_dev_s *)dev;
+
+  return MTD_IOCTL(priv->lower, cmd, arg);
+}
+
+/****************************************************************************
+ * Name: mtdbench_run
+ *
+ * Description:
+ *   Put the FTL on top of 'lower', fill the device and then write single
+ *   sectors at random.  Report the rate of the random writes and the
+ *   erases and block writes that they took.
+ *
+ ****************************************************************************/
+
+static void mtdbench_run(FAR const char *name, FAR struct mtd_dev_s *lower)
+{
+  FAR struct mtdbench_dev_s *priv = &g_mtdbench_dev;
+  FAR struct inode *inode;
+  struct geometry geo;
+  char metric[32];
+  uint32_t seed = 1;
+  uint64_t start;
+  size_t sector;
+  int ret;
+  int i;
+
+  memset(priv, 0, sizeof(struct mtdbench_dev_s));
+  priv->mtd.erase  = mtdbench_erase;
+  priv->mtd.bread  = mtdbench_bread;
+  priv->mtd.bwrite = mtdbench_bwrite;
+  priv->mtd.read   = lower->read != NULL ? mtdbench_read : NULL;
+  priv->mtd.ioctl  = mtdbench_ioctl;
+  priv->mtd.name   = "mtdbench";
+  priv->lower      = lower;
+
+  /* Start from an erased device, as the FTL would find new FLASH */
+
+  ret = MTD_IOCTL(lower, MTDIOC_BULKERASE, 0);
+  if (ret >= 0)
+    {
+      ret = ftl_initialize_by_path(MTDBENCH_DEVPATH, &priv->mtd);
+    }
+
+  if (ret < 0)
+    {
+      printf("simbench: mtd %s cannot create the FTL: %d\n", name, ret);
+      return;
+    }
+
+  ret = open_blockdriver(MTDBENCH_DEVPATH, 0, &inode);
+  if (ret < 0)
+    {
+      printf("simbench: mtd %s cannot open the FTL: %d\n", name, ret);
+      goto errout;
+    }
+
+  ret = inode->u.i_bops->geometry(inode, &geo);
+  if (ret < 0 || geo.geo_sectorsize != MTDBENCH_SECTSIZE)
+    {
+      printf("simbench: mtd %s has no usable geometry\n", name);
+      goto errout_with_inode;
+    }
+
+  /* Fill the device so that garbage collection has to move data */
+
+  for (sector = 0; sector < geo.geo_nsectors; sector++)
+    {
+      memset(g_mtdbench_buf, (int)sector, MTDBENCH_SECTSIZE);
+      if (inode->u.i_bops->write(inode, g_mtdbench_buf, sector, 1) != 1)
+        {
+          printf("simbench: mtd %s fill failed\n", name);
+          goto errout_with_inode;
+        }
+    }
+
+  priv->nerases  = 0;
+  priv->nwritten = 0;
+  start = up_hosttime();
+
+  for (i = 0; i < MTDBENCH_NWRITES; i++)
+    {
+      sector = sim_bench_rand(&seed) % geo.geo_nsectors;
+      memset(g_mtdbench_buf, i, MTDBENCH_SECTSIZE);
+      if (inode->u.i_bops->write(inode, g_mtdbench_buf, sector, 1) != 1)
+        {
+          printf("simbench: mtd %s write failed\n", name);
+          goto errout_with_inode;
+        }
+    }
+
+  sim_bench_report("mtd", name,
+                   sim_bench_rate(MTDBENCH_NWRITES, up_hosttime() - start),
+                   "writes/s");
+  snprintf(metric, sizeof(metric), "%s-erases", name);
+  sim_bench_report("mtd", metric, priv->nerases, "blocks");
+  snprintf(metric, sizeof(metric), "%s-written", name);
+  sim_bench_report("mtd", metric, priv->nwritten, "blocks");
+
+errout_with_inode:
+  (void)close_blockdriver(inode);
+
+errout:
+  (void)unregister_blockdriver(MTDBENCH_DEVPATH);
+}
+
+/****************************************************************************
+ * Name: mtdbench_filemtd
+ *
+ * Description:
+ *   Run the benchmark on a FILE MTD device backed by a file in a TMPFS
+ *   file system.
+ *
+ ****************************************************************************/
+
+#ifdef MTDBENCH_FILEMTD
+static void mtdbench_filemtd(void)
+{
+  FAR struct mtd_dev_s *mtd;
+  int fd;
+  int i;
+
+  if (mount(NULL, MTDBENCH_TMPDIR, "tmpfs", 0, NULL) < 0)
+    {
+      printf("simbench: mtd cannot mount %s\n", MTDBENCH_TMPDIR);
+      return;
+    }
+
+  fd = open(MTDBENCH_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if (fd < 0)
+    {
+      printf("simbench: mtd cannot create %s\n", MTDBENCH_FILE);
+      goto errout;
+    }
+
+  memset(g_mtdbench_buf, 0xff, MTDBENCH_SECTSIZE);
+  for (i = 0; i < MTDBENCH_SIZE / MTDBENCH_SECTSIZE; i++)
+    {
+      if (write(fd, g_mtdbench_buf, MTDBENCH_SECTSIZE) != MTDBENCH_SECTSIZE)
+        {
+          printf("simbench: mtd cannot write %s\n", MTDBENCH_FILE);
+          close(fd);
+          goto errout;
+        }
+    }
+
+  close(fd);
+
+  mtd = filemtd_initialize(MTDBENCH_FILE, 0, MTDBENCH_SECTSIZE,
+                           MTDBENCH_ERASESIZE);
+  if (mtd == NULL)
+    {
+      printf("simbench: mtd cannot create the FILE MTD device\n");
+      goto errout;
+    }
+
+  mtdbench_run("filemtd", mtd);
+  filemtd_teardown(mtd);
+
+errout:
+  (void)unlink(MTDBENCH_FILE);
+  (void)umount(MTDBENCH_TMPDIR);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_mtdbench
+ *
+ * Description:
+ *   Measure random single-sector writes through the FTL on a RAM MTD and a
+ *   FILE MTD device with 64 KiB erase blocks and count the erases.
+ *
+ ****************************************************************************/
+
+void sim_mtdbench(void)
+{
+#ifdef CONFIG_RAMMTD
+  FAR struct mtd_dev_s *mtd;
+
+  /* The RAM MTD device is not torn down; it is only created once */
+
+  mtd = rammtd_initialize(g_mtdbench_flash, MTDBENCH_SIZE);
+  if (mtd != NULL)
+    {
+      mtdbench_run("rammtd", mtd);
+    }
+#endif
+
+#ifdef MTDBENCH_FILEMTD
+  mtdbench_filemtd();
+#endif
+}
+
+#endif /* CONFIG_SIM_BENCH_MTD */
@@ -0,0 +1,247 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_netbench.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/ip.h>
+
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_BENCH_NET
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define NETBENCH_MAXFLOWS 8
+#define NETBENCH_PORT     5600
+
+/* Full-sized datagrams for the loopback device.  sendto() does not check
+ * the length against the MTU, so larger datagrams must not be sent.
+ */
+
+#define NETBENCH_DGRAMLEN LO_UDP_MSS(IPv4_HDRLEN)
+
+/* Each run lasts one second of host time */
+
+#define NETBENCH_DURATION 1000000000ull
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct netbench_flow_s
+{
+  pthread_t thread;
+  uint64_t deadline;           /* Host time at which to stop */
+  unsigned long bytes;         /* Bytes received */
+  int port;                    /* Port that the flow receives on */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const int g_netbench_flows[] =
+{
+  1, 2, 4, NETBENCH_MAXFLOWS
+};
+
+static struct netbench_flow_s g_netbench_flow[NETBENCH_MAXFLOWS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netbench_thread
+ *
+ * Description:
+ *   Send datagrams to a socket of this flow over the loopback device and
+ *   receive them until the deadline.  Each flow keeps one datagram in
+ *   flight, so no datagram is dropped for lack of buffers.
+ *
+ ****************************************************************************/
+
+static FAR void *netbench_thread(FAR void *arg)
+{
+  FAR struct netbench_flow_s *flow = (FAR struct netbench_flow_s *)arg;
+  static const struct timeval timeout =
+  {
+    1, 0
+  };
+
+  struct sockaddr_in addr;
+  char buf[NETBENCH_DGRAMLEN];
+  ssize_t nrecvd;
+  int rxsd;
+  int txsd;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family      = AF_INET;
+  addr.sin_port        = htons(flow->port);
+  addr.sin_addr.s_addr = HTONL(INADDR_LOOPBACK);
+
+  rxsd = socket(AF_INET, SOCK_DGRAM, 0);
+  txsd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (rxsd < 0 || txsd < 0 ||
+      bind(rxsd, (FAR struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+      setsockopt(rxsd, SOL_SOCKET, SO_RCVTIMEO, &timeout,
+                 sizeof(timeout)) < 0)
+    {
+      printf("simbench: net flow %d setup failed\n", flow->port);
+      goto errout;
+    }
+
+  memset(buf, 0xa5, sizeof(buf));
+  while (up_hosttime() < flow->deadline)
+    {
+      if (sendto(txsd, buf, sizeof(buf), 0, (FAR struct sockaddr *)&addr,
+                 sizeof(addr)) < 0)
+        {
+          break;
+        }
+
+      nrecvd = recv(rxsd, buf, sizeof(buf), 0);
+      if (nrecvd < 0)
+        {
+          break;
+        }
+
+      flow->bytes += nrecvd;
+    }
+
+errout:
+  if (rxsd >= 0)
+    {
+      close(rxsd);
+    }
+
+  if (txsd >= 0)
+    {
+      close(txsd);
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: netbench_run
+ *
+ * Description:
+ *   Run 'nflows' flows concurrently for one second and report their
+ *   aggregate throughput.
+ *
+ ****************************************************************************/
+
+static void netbench_run(int nflows)
+{
+  char metric[16];
+  unsigned long bytes = 0;
+  uint64_t deadline;
+  uint64_t start;
+  int i;
+
+  start    = up_hosttime();
+  deadline = start + NETBENCH_DURATION;
+
+  for (i = 0; i < nflows; i++)
+    {
+      g_netbench_flow[i].deadline = deadline;
+      g_netbench_flow[i].bytes    = 0;
+      g_netbench_flow[i].port     = NETBENCH_PORT + i;
+
+      if (pthread_create(&g_netbench_flow[i].thread, NULL, netbench_thread,
+                         &g_netbench_flow[i]) != 0)
+        {
+          printf("simbench: net cannot start flow %d\n", i);
+          nflows = i;
+          break;
+        }
+    }
+
+  for (i = 0; i < nflows; i++)
+    {
+      (void)pthread_join(g_netbench_flow[i].thread, NULL);
+      bytes += g_netbench_flow[i].bytes;
+    }
+
+  snprintf(metric, sizeof(metric), "udp-%d", nflows);
+  sim_bench_report("net", metric,
+                   sim_bench_rate(bytes, up_hosttime() - start) / 1024,
+                   "KiB/s");
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_netbench
+ *
+ * Description:
+ *   Measure how the aggregate UDP throughput over the loopback device
+ *   scales with the number of concurrent flows.
+ *
+ ****************************************************************************/
+
+void sim_netbench(void)
+{
+  unsigned int i;
+
+  for (i = 0; i < sizeof(g_netbench_flows) / sizeof(int); i++)
+    {
+      netbench_run(g_netbench_flows[i]);
+    }
+}
+
+#endif /* CONFIG_SIM_BENCH_NET */
@@ -0,0 +1,283 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_schedbench.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <pthread.h>
+
+#include <nuttx/semaphore.h>
+
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_BENCH_SCHED
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* One pair of tasks per CPU */
+
+#ifdef CONFIG_SMP
+#  define SCHEDBENCH_MAXPAIRS CONFIG_SMP_NCPUS
+#else
+#  define SCHEDBENCH_MAXPAIRS 1
+#endif
+
+/* Each run lasts one second of host time */
+
+#define SCHEDBENCH_DURATION 1000000000ull
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct schedbench_pair_s
+{
+  pthread_t ping;
+  pthread_t pong;
+  sem_t pingsem;               /* Posted by pong to wake up ping */
+  sem_t pongsem;               /* Posted by ping to wake up pong */
+  uint64_t deadline;           /* Host time at which to stop */
+  unsigned long nswitches;     /* Context switches counted by ping */
+  volatile bool stop;          /* Set by ping when it is done */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct schedbench_pair_s g_schedbench_pair[SCHEDBENCH_MAXPAIRS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: schedbench_ping
+ *
+ * Description:
+ *   Hand control to the other task of the pair and wait for it to hand
+ *   control back until the deadline.  Every round trip is two context
+ *   switches on the CPU that the pair is bound to.
+ *
+ ****************************************************************************/
+
+static FAR void *schedbench_ping(FAR void *arg)
+{
+  FAR struct schedbench_pair_s *pair = (FAR struct schedbench_pair_s *)arg;
+
+  while (up_hosttime() < pair->deadline)
+    {
+      sem_post(&pair->pongsem);
+      sem_wait(&pair->pingsem);
+      pair->nswitches += 2;
+    }
+
+  pair->stop = true;
+  sem_post(&pair->pongsem);
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: schedbench_pong
+ ****************************************************************************/
+
+static FAR void *schedbench_pong(FAR void *arg)
+{
+  FAR struct schedbench_pair_s *pair = (FAR struct schedbench_pair_s *)arg;
+
+  for (; ; )
+    {
+      sem_wait(&pair->pongsem);
+      if (pair->stop)
+        {
+          break;
+        }
+
+      sem_post(&pair->pingsem);
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: schedbench_start
+ *
+ * Description:
+ *   Start one task of a pair.  In SMP mode, both tasks of pair 'n' may run
+ *   only on CPU 'n', so all of the switches of a pair happen on one CPU
+ *   and the pairs never compete for a CPU.
+ *
+ ****************************************************************************/
+
+static int schedbench_start(FAR pthread_t *thread,
+                            pthread_startroutine_t entry,
+                            FAR struct schedbench_pair_s *pair, int n)
+{
+  pthread_attr_t attr;
+#ifdef CONFIG_SMP
+  cpu_set_t cpuset;
+#endif
+  int ret;
+
+  pthread_attr_init(&attr);
+#ifdef CONFIG_SMP
+  CPU_ZERO(&cpuset);
+  CPU_SET(n, &cpuset);
+  pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &cpuset);
+#endif
+
+  ret = pthread_create(thread, &attr, entry, pair);
+  pthread_attr_destroy(&attr);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: schedbench_run
+ *
+ * Description:
+ *   Run 'npairs' pairs concurrently for one second and return their
+ *   aggregate rate of context switches.
+ *
+ ****************************************************************************/
+
+static unsigned long schedbench_run(int npairs)
+{
+  FAR struct schedbench_pair_s *pair;
+  unsigned long nswitches = 0;
+  uint64_t deadline;
+  uint64_t start;
+  int i;
+
+  start    = up_hosttime();
+  deadline = start + SCHEDBENCH_DURATION;
+
+  for (i = 0; i < npairs; i++)
+    {
+      pair            = &g_schedbench_pair[i];
+      pair->deadline  = deadline;
+      pair->nswitches = 0;
+      pair->stop      = false;
+
+      sem_init(&pair->pingsem, 0, 0);
+      sem_init(&pair->pongsem, 0, 0);
+      sem_setprotocol(&pair->pingsem, SEM_PRIO_NONE);
+      sem_setprotocol(&pair->pongsem, SEM_PRIO_NONE);
+
+      if (schedbench_start(&pair->pong, schedbench_pong, pair, i) != 0)
+        {
+          printf("simbench: sched cannot start pair %d\n", i);
+          npairs = i;
+          break;
+        }
+
+      if (schedbench_start(&pair->ping, schedbench_ping, pair, i) != 0)
+        {
+          printf("simbench: sched cannot start pair %d\n", i);
+          pair->stop = true;
+          sem_post(&pair->pongsem);
+          (void)pthread_join(pair->pong, NULL);
+          npairs = i;
+          break;
+        }
+    }
+
+  for (i = 0; i < npairs; i++)
+    {
+      pair = &g_schedbench_pair[i];
+      (void)pthread_join(pair->ping, NULL);
+      (void)pthread_join(pair->pong, NULL);
+      sem_destroy(&pair->pingsem);
+      sem_destroy(&pair->pongsem);
+      nswitches += pair->nswitches;
+    }
+
+  return sim_bench_rate(nswitches, up_hosttime() - start);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_schedbench
+ *
+ * Description:
+ *   Measure how the aggregate context switch rate scales with the number
+ *   of CPUs that are switching at the same time.
+ *
+ ****************************************************************************/
+
+void sim_schedbench(void)
+{
+  char metric[16];
+  unsigned long base = 0;
+  unsigned long rate;
+  int npairs;
+
+  for (npairs = 1; npairs <= SCHEDBENCH_MAXPAIRS; npairs++)
+    {
+      rate = schedbench_run(npairs);
+      snprintf(metric, sizeof(metric), "pairs-%d", npairs);
+      sim_bench_report("sched", metric, rate, "switches/s");
+
+      /* The scaling is the aggregate rate as a percentage of 'npairs'
+       * times the rate of a single pair.
+       */
+
+      if (npairs == 1)
+        {
+          base = rate;
+        }
+      else if (base > 0)
+        {
+          snprintf(metric, sizeof(metric), "scaling-%d", npairs);
+          sim_bench_report("sched", metric, rate * 100 / (base * npairs),
+                           "%");
+        }
+    }
+}
+
+#endif /* CONFIG_SIM_BENCH_SCHED */
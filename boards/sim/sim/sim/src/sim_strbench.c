@@ -0,0 +1,236 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_strbench.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <nuttx/compiler.h>
+
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_BENCH_STRING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define STRBENCH_MAXSIZE  4096
+#define STRBENCH_NREPEAT  64
+
+/* Each case runs for 20 ms of host time */
+
+#define STRBENCH_DURATION 20000000ull
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct strbench_op_s
+{
+  FAR const char *name;
+  void (*func)(size_t dstoff, size_t srcoff, size_t n);
+};
+
+struct strbench_align_s
+{
+  FAR const char *name;
+  size_t dstoff;               /* Offset of the destination from a 64-byte
+                                * boundary */
+  size_t srcoff;               /* Offset of the source */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void strbench_memcpy(size_t dstoff, size_t srcoff, size_t n);
+static void strbench_memset(size_t dstoff, size_t srcoff, size_t n);
+static void strbench_memcmp(size_t dstoff, size_t srcoff, size_t n);
+static void strbench_strlen(size_t dstoff, size_t srcoff, size_t n);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct strbench_op_s g_strbench_ops[] =
+{
+  { "memcpy", strbench_memcpy },
+  { "memset", strbench_memset },
+  { "memcmp", strbench_memcmp },
+  { "strlen", strbench_strlen }
+};
+
+static const size_t g_strbench_sizes[] =
+{
+  16, 64, 256, 1024, STRBENCH_MAXSIZE
+};
+
+/* Aligned buffers, and buffers that are misaligned by different amounts so
+ * that the source and destination cannot both be aligned.
+ */
+
+static const struct strbench_align_s g_strbench_aligns[] =
+{
+  { "a", 0, 0 },
+  { "u", 3, 1 }
+};
+
+static uint8_t g_strbench_dst[STRBENCH_MAXSIZE + 64] aligned_data(64);
+static uint8_t g_strbench_src[STRBENCH_MAXSIZE + 64] aligned_data(64);
+
+/* Results are stored here so that the calls cannot be optimized away */
+
+static volatile size_t g_strbench_sink;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: strbench_memcpy, strbench_memset, strbench_memcmp, strbench_strlen
+ *
+ * Description:
+ *   Call one of the measured functions on 'n' bytes of the buffers.
+ *
+ ****************************************************************************/
+
+static void strbench_memcpy(size_t dstoff, size_t srcoff, size_t n)
+{
+  memcpy(&g_strbench_dst[dstoff], &g_strbench_src[srcoff], n);
+}
+
+static void strbench_memset(size_t dstoff, size_t srcoff, size_t n)
+{
+  memset(&g_strbench_dst[dstoff], (int)n, n);
+}
+
+static void strbench_memcmp(size_t dstoff, size_t srcoff, size_t n)
+{
+  g_strbench_sink = memcmp(&g_strbench_dst[dstoff], &g_strbench_src[srcoff],
+                           n);
+}
+
+static void strbench_strlen(size_t dstoff, size_t srcoff, size_t n)
+{
+  g_strbench_sink = strlen((FAR const char *)&g_strbench_src[srcoff]);
+}
+
+/****************************************************************************
+ * Name: strbench_run
+ *
+ * Description:
+ *   Call one function on 'n' bytes at one pair of alignments for 20 ms and
+ *   report the throughput.  memcmp() compares equal buffers and strlen()
+ *   measures a string of 'n' characters, so both must process every byte.
+ *
+ ****************************************************************************/
+
+static void strbench_run(FAR const struct strbench_op_s *op,
+                         FAR const struct strbench_align_s *align, size_t n)
+{
+  char metric[32];
+  unsigned long nbytes = 0;
+  uint64_t deadline;
+  uint64_t start;
+  int i;
+
+  memset(g_strbench_src, 'a', sizeof(g_strbench_src));
+  g_strbench_src[align->srcoff + n] = '\0';
+  memcpy(&g_strbench_dst[align->dstoff], &g_strbench_src[align->srcoff], n);
+
+  start    = up_hosttime();
+  deadline = start + STRBENCH_DURATION;
+
+  do
+    {
+      for (i = 0; i < STRBENCH_NREPEAT; i++)
+        {
+          op->func(align->dstoff, align->srcoff, n);
+        }
+
+      nbytes += STRBENCH_NREPEAT * n;
+    }
+  while (up_hosttime() < deadline);
+
+  snprintf(metric, sizeof(metric), "%s-%lu-%s", op->name, (unsigned long)n,
+           align->name);
+  sim_bench_report("string", metric,
+                   sim_bench_rate(nbytes, up_hosttime() - start) >> 20,
+                   "MiB/s");
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_strbench
+ *
+ * Description:
+ *   Measure the throughput of memcpy(), memset(), memcmp() and strlen()
+ *   over a range of sizes with aligned and misaligned buffers.
+ *
+ ****************************************************************************/
+
+void sim_strbench(void)
+{
+  unsigned int i;
+  unsigned int j;
+  unsigned int k;
+
+  for (i = 0; i < sizeof(g_strbench_ops) / sizeof(g_strbench_ops[0]); i++)
+    {
+      for (j = 0; j < sizeof(g_strbench_sizes) / sizeof(size_t); j++)
+        {
+          for (k = 0;
+               k < sizeof(g_strbench_aligns) / sizeof(g_strbench_aligns[0]);
+               k++)
+            {
+              strbench_run(&g_strbench_ops[i], &g_strbench_aligns[k],
+                           g_strbench_sizes[j]);
+            }
+        }
+    }
+}
+
+#endif /* CONFIG_SIM_BENCH_STRING */
@@ -0,0 +1,190 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_wdbench.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <nuttx/wdog.h>
+
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_BENCH_WDOG
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WDBENCH_MAXTIMERS 4096
+#define WDBENCH_NRESTARTS 4096
+
+/* Delays are long enough that no timer expires during a run */
+
+#define WDBENCH_MINDELAY  1000
+#define WDBENCH_MAXDELAY  1000000
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const int g_wdbench_counts[] =
+{
+  16, 256, WDBENCH_MAXTIMERS
+};
+
+static WDOG_ID g_wdbench_wdog[WDBENCH_MAXTIMERS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wdbench_expired
+ ****************************************************************************/
+
+static void wdbench_expired(int argc, wdparm_t arg1, ...)
+{
+}
+
+/****************************************************************************
+ * Name: wdbench_delay
+ ****************************************************************************/
+
+static int32_t wdbench_delay(FAR uint32_t *seed)
+{
+  return WDBENCH_MINDELAY +
+         sim_bench_rand(seed) % (WDBENCH_MAXDELAY - WDBENCH_MINDELAY);
+}
+
+/****************************************************************************
+ * Name: wdbench_run
+ *
+ * Description:
+ *   Start 'count' timers with random delays, restart random ones of them
+ *   and finally cancel them all.  Report the average time of each
+ *   operation with 'count' timers active.
+ *
+ ****************************************************************************/
+
+static void wdbench_run(int count)
+{
+  char metric[16];
+  uint32_t seed = 1;
+  uint64_t start;
+  uint64_t elapsed;
+  int i;
+
+  start = up_hosttime();
+  for (i = 0; i < count; i++)
+    {
+      (void)wd_start(g_wdbench_wdog[i], wdbench_delay(&seed),
+                     wdbench_expired, 0);
+    }
+
+  elapsed = up_hosttime() - start;
+  snprintf(metric, sizeof(metric), "start-%d", count);
+  sim_bench_report("wdog", metric, (unsigned long)(elapsed / count), "ns");
+
+  start = up_hosttime();
+  for (i = 0; i < WDBENCH_NRESTARTS; i++)
+    {
+      (void)wd_start(g_wdbench_wdog[sim_bench_rand(&seed) % count],
+                     wdbench_delay(&seed), wdbench_expired, 0);
+    }
+
+  elapsed = up_hosttime() - start;
+  snprintf(metric, sizeof(metric), "restart-%d", count);
+  sim_bench_report("wdog", metric,
+                   (unsigned long)(elapsed / WDBENCH_NRESTARTS), "ns");
+
+  start = up_hosttime();
+  for (i = 0; i < count; i++)
+    {
+      (void)wd_cancel(g_wdbench_wdog[i]);
+    }
+
+  elapsed = up_hosttime() - start;
+  snprintf(metric, sizeof(metric), "cancel-%d", count);
+  sim_bench_report("wdog", metric, (unsigned long)(elapsed / count), "ns");
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_wdbench
+ *
+ * Description:
+ *   Measure how the cost of starting, restarting and cancelling watchdog
+ *   timers scales with the number of active timers.
+ *
+ ****************************************************************************/
+
+void sim_wdbench(void)
+{
+  unsigned int i;
+  int ntimers;
+
+  for (ntimers = 0; ntimers < WDBENCH_MAXTIMERS; ntimers++)
+    {
+      g_wdbench_wdog[ntimers] = wd_create();
+      if (g_wdbench_wdog[ntimers] == NULL)
+        {
+          break;
+        }
+    }
+
+  for (i = 0; i < sizeof(g_wdbench_counts) / sizeof(int); i++)
+    {
+      if (g_wdbench_counts[i] <= ntimers)
+        {
+          wdbench_run(g_wdbench_counts[i]);
+        }
+    }
+
+  while (ntimers > 0)
+    {
+      (void)wd_delete(g_wdbench_wdog[--ntimers]);
+    }
+}
+
+#endif /* CONFIG_SIM_BENCH_WDOG */
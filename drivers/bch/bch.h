@@ -98,6 +98,9 @@ EXTERN const struct file_operations bch_fops;
 EXTERN void bchlib_semtake(FAR struct bchlib_s *bch);
 EXTERN int  bchlib_flushsector(FAR struct bchlib_s *bch);
 EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, size_t sector);
+EXTERN int  bchlib_writesectors(FAR struct bchlib_s *bch,
+                                FAR const uint8_t *buffer, size_t sector,
+                                size_t nsectors);
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -197,3 +197,65 @@ int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
   return (int)ret;
 }
 
+/****************************************************************************
+ * Name: bchlib_writesectors
+ *
+ * Description:
+ *   Write full sectors directly from a user buffer.  If the sector buffer
+ *   holds the dirty sector that immediately precedes them (the initial
+ *   partial sector of the same write), it is written in the same vectored
+ *   request and is then in sync with the media.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_writesectors(FAR struct bchlib_s *bch, FAR const uint8_t *buffer,
+                        size_t sector, size_t nsectors)
+{
+  struct block_iovec_s iov[2];
+  ssize_t ret;
+  int niov = 0;
+
+  if (bch->dirty && bch->sector + 1 == sector)
+    {
+#if defined(CONFIG_BCH_ENCRYPTION)
+      bch_cypher(bch, CYPHER_ENCRYPT);
+#endif
+
+      iov[0].bv_sector   = bch->sector;
+      iov[0].bv_nsectors = 1;
+      iov[0].bv_buffer   = bch->buffer;
+      niov               = 1;
+    }
+
+  iov[niov].bv_sector   = sector;
+  iov[niov].bv_nsectors = nsectors;
+  iov[niov].bv_buffer   = (FAR uint8_t *)buffer;
+  niov++;
+
+  ret = block_writev(bch->inode, iov, niov);
+
+  if (niov > 1)
+    {
+#if defined(CONFIG_BCH_ENCRYPTION)
+      bch_cypher(bch, CYPHER_DECRYPT);
+#endif
+
+      /* The buffered sector was written first */
+
+      if (ret > 0)
+        {
+          bch->dirty = false;
+        }
+    }
+
+  if (ret < 0)
+    {
+      ferr("Write failed: %d\n", (int)ret);
+    }
+
+  return (int)ret;
+}
+
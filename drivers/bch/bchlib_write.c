@@ -141,10 +141,12 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
           nsectors = bch->nsectors - sector;
         }
 
-      /* Write the contiguous sectors */
+      /* Write the contiguous sectors (along with the initial partial
+       * sector, if there was one).
+       */
 
-      ret = bch->inode->u.i_bops->write(bch->inode, (FAR uint8_t *)buffer,
-                                        sector, nsectors);
+      ret = bchlib_writesectors(bch, (FAR const uint8_t *)buffer, sector,
+                                nsectors);
       if (ret < 0)
         {
           ferr("ERROR: Write failed: %d\n", ret);
@@ -101,6 +101,15 @@ static ssize_t loop_write(FAR struct inode *inode,
 #endif
 static int     loop_geometry(FAR struct inode *inode,
                              FAR struct geometry *geometry);
+static ssize_t loop_transferv(FAR struct inode *inode,
+                              FAR const struct block_iovec_s *iov,
+                              int iovcnt, bool write);
+static ssize_t loop_readv(FAR struct inode *inode,
+                          FAR const struct block_iovec_s *iov, int iovcnt);
+#ifdef CONFIG_FS_WRITABLE
+static ssize_t loop_writev(FAR struct inode *inode,
+                           FAR const struct block_iovec_s *iov, int iovcnt);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -117,9 +126,15 @@ static const struct block_operations g_bops =
   NULL,          /* write */
 #endif
   loop_geometry, /* geometry */
-  NULL           /* ioctl */
+  NULL,          /* ioctl */
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
-  , NULL         /* unlink */
+  NULL,          /* unlink */
+#endif
+  loop_readv,    /* readv */
+#ifdef CONFIG_FS_WRITABLE
+  loop_writev    /* writev */
+#else
+  NULL           /* writev */
 #endif
 };
 
@@ -245,6 +260,16 @@ static ssize_t loop_read(FAR struct inode *inode, FAR unsigned char *buffer,
       return -EIO;
     }
 
+  /* Hold the device so that the file position cannot be changed by a
+   * concurrent transfer between the seek and the read.
+   */
+
+  ret = loop_semtake(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
   /* Calculate the offset to read the sectors and seek to the position */
 
   offset = start_sector * dev->sectsize + dev->offset;
@@ -252,6 +277,7 @@ static ssize_t loop_read(FAR struct inode *inode, FAR unsigned char *buffer,
   if (ret < 0)
     {
       ferr("ERROR: Seek failed for offset=%d: %d\n", (int)offset, (int)ret);
+      loop_semgive(dev);
       return -EIO;
     }
 
@@ -264,11 +290,14 @@ static ssize_t loop_read(FAR struct inode *inode, FAR unsigned char *buffer,
       if (nbytesread < 0 && nbytesread != -EINTR)
         {
           ferr("ERROR: Read failed: %d\n", nbytesread);
+          loop_semgive(dev);
           return (int)nbytesread;
         }
     }
   while (nbytesread < 0);
 
+  loop_semgive(dev);
+
   /* Return the number of sectors read */
 
   return nbytesread / dev->sectsize;
@@ -294,6 +323,16 @@ static ssize_t loop_write(FAR struct inode *inode,
   DEBUGASSERT(inode && inode->i_private);
   dev = (FAR struct loop_struct_s *)inode->i_private;
 
+  /* Hold the device so that the file position cannot be changed by a
+   * concurrent transfer between the seek and the write.
+   */
+
+  ret = loop_semtake(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
   /* Calculate the offset to write the sectors and seek to the position */
 
   offset = start_sector * dev->sectsize + dev->offset;
@@ -312,11 +351,14 @@ static ssize_t loop_write(FAR struct inode *inode,
       if (nbyteswritten < 0 && nbyteswritten != -EINTR)
         {
           ferr("ERROR: nx_write failed: %d\n", nbyteswritten);
+          loop_semgive(dev);
           return nbyteswritten;
         }
     }
   while (nbyteswritten < 0);
 
+  loop_semgive(dev);
+
   /* Return the number of sectors written */
 
   return nbyteswritten / dev->sectsize;
@@ -354,6 +396,126 @@ static int loop_geometry(FAR struct inode *inode,
   return -EINVAL;
 }
 
+/****************************************************************************
+ * Name: loop_transferv
+ *
+ * Description:
+ *   Transfer a list of sector segments.  The device is held for the whole
+ *   request and the file position is only changed when a segment does not
+ *   continue the previous one.
+ *
+ ****************************************************************************/
+
+static ssize_t loop_transferv(FAR struct inode *inode,
+                              FAR const struct block_iovec_s *iov,
+                              int iovcnt, bool write)
+{
+  FAR struct loop_struct_s *dev;
+  size_t nextsector = (size_t)-1;
+  ssize_t nsectors = 0;
+  ssize_t nbytes;
+  size_t len;
+  off_t offset;
+  off_t pos;
+  int ret;
+  int i;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct loop_struct_s *)inode->i_private;
+
+  ret = loop_semtake(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      if (iov[i].bv_sector + iov[i].bv_nsectors > dev->nsectors)
+        {
+          ferr("ERROR: Access past end of file\n");
+          ret = -EIO;
+          break;
+        }
+
+      if (iov[i].bv_sector != nextsector)
+        {
+          offset = iov[i].bv_sector * dev->sectsize + dev->offset;
+          pos = file_seek(&dev->devfile, offset, SEEK_SET);
+          if (pos < 0)
+            {
+              ferr("ERROR: Seek failed for offset=%d: %d\n",
+                   (int)offset, (int)pos);
+              ret = -EIO;
+              break;
+            }
+        }
+
+      len = iov[i].bv_nsectors * dev->sectsize;
+      do
+        {
+          if (write)
+            {
+              nbytes = file_write(&dev->devfile, iov[i].bv_buffer, len);
+            }
+          else
+            {
+              nbytes = file_read(&dev->devfile, iov[i].bv_buffer, len);
+            }
+        }
+      while (nbytes == -EINTR);
+
+      if (nbytes < 0)
+        {
+          ferr("ERROR: Transfer failed: %d\n", (int)nbytes);
+          ret = (int)nbytes;
+          break;
+        }
+
+      nsectors += nbytes / dev->sectsize;
+      if ((size_t)nbytes < len)
+        {
+          break;
+        }
+
+      nextsector = iov[i].bv_sector + iov[i].bv_nsectors;
+    }
+
+  loop_semgive(dev);
+
+  /* Return the number of sectors transferred */
+
+  return nsectors > 0 ? nsectors : ret;
+}
+
+/****************************************************************************
+ * Name: loop_readv
+ *
+ * Description: Read a list of sector segments
+ *
+ ****************************************************************************/
+
+static ssize_t loop_readv(FAR struct inode *inode,
+                          FAR const struct block_iovec_s *iov, int iovcnt)
+{
+  return loop_transferv(inode, iov, iovcnt, false);
+}
+
+/****************************************************************************
+ * Name: loop_writev
+ *
+ * Description: Write a list of sector segments
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_WRITABLE
+static ssize_t loop_writev(FAR struct inode *inode,
+                           FAR const struct block_iovec_s *iov, int iovcnt)
+{
+  return loop_transferv(inode, iov, iovcnt, true);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
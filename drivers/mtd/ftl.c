@@ -57,6 +57,8 @@
 #include <nuttx/mtd/mtd.h>
 #include <nuttx/drivers/rwbuffer.h>
 
+#include "ftl_log.h"
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -87,7 +89,10 @@ struct ftl_struct_s
   uint16_t              blkper;  /* R/W blocks per erase block */
   uint16_t              refs;    /* Number of references */
   bool                  unlinked;/* The driver has been unlinked */
-#ifdef CONFIG_FS_WRITABLE
+#ifdef CONFIG_FTL_LOG
+  struct ftl_log_s      log;     /* Log-structured sector mapping */
+#endif
+#if defined(CONFIG_FS_WRITABLE) && !defined(CONFIG_FTL_LOG)
   FAR uint8_t          *eblock;  /* One, in-memory erase block */
 #endif
 };
@@ -180,7 +185,9 @@ static int ftl_close(FAR struct inode *inode)
 #ifdef FTL_HAVE_RWBUFFER
       rwb_uninitialize(&dev->rwb);
 #endif
-#ifdef CONFIG_FS_WRITABLE
+#ifdef CONFIG_FTL_LOG
+      ftl_log_uninitialize(&dev->log);
+#elif defined(CONFIG_FS_WRITABLE)
       if (dev->eblock)
         {
           kmm_free(dev->eblock);
@@ -205,9 +212,15 @@ static ssize_t ftl_reload(FAR void *priv, FAR uint8_t *buffer,
   struct ftl_struct_s *dev = (struct ftl_struct_s *)priv;
   ssize_t nread;
 
+#ifdef CONFIG_FTL_LOG
+  /* Read the sectors from wherever the log has put them */
+
+  nread   = ftl_log_read(&dev->log, buffer, startblock, nblocks);
+#else
   /* Read the full erase block into the buffer */
 
   nread   = MTD_BREAD(dev->mtd, startblock, nblocks, buffer);
+#endif
   if (nread != nblocks)
     {
       ferr("ERROR: Read %d blocks starting at block %d failed: %d\n",
@@ -248,7 +261,18 @@ static ssize_t ftl_read(FAR struct inode *inode, unsigned char *buffer,
  *
  ****************************************************************************/
 
-#ifdef CONFIG_FS_WRITABLE
+#if defined(CONFIG_FS_WRITABLE) && defined(CONFIG_FTL_LOG)
+static ssize_t ftl_flush(FAR void *priv, FAR const uint8_t *buffer,
+                         off_t startblock, size_t nblocks)
+{
+  struct ftl_struct_s *dev = (struct ftl_struct_s *)priv;
+
+  /* Append the sectors to the log.  No erase block is rewritten. */
+
+  return ftl_log_write(&dev->log, buffer, startblock, nblocks);
+}
+
+#elif defined(CONFIG_FS_WRITABLE)
 static int ftl_alloc_eblock(FAR struct ftl_struct_s *dev)
 {
   if (dev->eblock == NULL)
@@ -493,7 +517,11 @@ static int ftl_geometry(FAR struct inode *inode, struct geometry *geometry)
 #else
       geometry->geo_writeenabled  = false;
 #endif
+#ifdef CONFIG_FTL_LOG
+      geometry->geo_nsectors      = dev->log.nsectors;
+#else
       geometry->geo_nsectors      = dev->geo.neraseblocks * dev->blkper;
+#endif
       geometry->geo_sectorsize    = dev->geo.blocksize;
 
       finfo("available: true mediachanged: false writeenabled: %s\n",
@@ -529,6 +557,35 @@ static int ftl_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
    * different form).
    */
 
+#ifdef CONFIG_FTL_LOG
+  /* Sectors do not stay at fixed locations in the log-structured FTL, so
+   * they cannot be executed in place.
+   */
+
+  if (cmd == BIOC_XIPBASE)
+    {
+      return -ENOTTY;
+    }
+
+  /* Erasing the device invalidates the mapping tables.  Discard any data
+   * still buffered for the old contents and rebuild the tables.
+   */
+
+  if (cmd == MTDIOC_BULKERASE)
+    {
+#ifdef FTL_HAVE_RWBUFFER
+      ret = rwb_invalidate(&dev->rwb, 0, dev->rwb.nblocks);
+      if (ret < 0)
+        {
+          ferr("ERROR: rwb_invalidate failed: %d\n", ret);
+          return ret;
+        }
+
+#endif
+      return ftl_log_bulkerase(&dev->log);
+    }
+#endif
+
   if (cmd == BIOC_XIPBASE)
     {
       /* The argument accompanying the BIOC_XIPBASE should be non-NULL.  If
@@ -590,7 +647,9 @@ static int ftl_unlink(FAR struct inode *inode)
 #ifdef FTL_HAVE_RWBUFFER
       rwb_uninitialize(&dev->rwb);
 #endif
-#ifdef CONFIG_FS_WRITABLE
+#ifdef CONFIG_FTL_LOG
+      ftl_log_uninitialize(&dev->log);
+#elif defined(CONFIG_FS_WRITABLE)
       if (dev->eblock)
         {
           kmm_free(dev->eblock);
@@ -658,11 +717,27 @@ int ftl_initialize_by_path(FAR const char *path, FAR struct mtd_dev_s *mtd)
       dev->blkper = dev->geo.erasesize / dev->geo.blocksize;
       DEBUGASSERT(dev->blkper * dev->geo.blocksize == dev->geo.erasesize);
 
+#ifdef CONFIG_FTL_LOG
+      /* Rebuild the logical-to-physical sector map from the media */
+
+      ret = ftl_log_initialize(&dev->log, mtd, &dev->geo);
+      if (ret < 0)
+        {
+          ferr("ERROR: ftl_log_initialize failed: %d\n", ret);
+          kmm_free(dev);
+          return ret;
+        }
+#endif
+
       /* Configure read-ahead/write buffering */
 
 #ifdef FTL_HAVE_RWBUFFER
       dev->rwb.blocksize   = dev->geo.blocksize;
+#ifdef CONFIG_FTL_LOG
+      dev->rwb.nblocks     = dev->log.nsectors;
+#else
       dev->rwb.nblocks     = dev->geo.neraseblocks * dev->blkper;
+#endif
       dev->rwb.dev         = (FAR void *)dev;
       dev->rwb.wrflush     = ftl_flush;
       dev->rwb.rhreload    = ftl_reload;
@@ -679,6 +754,9 @@ int ftl_initialize_by_path(FAR const char *path, FAR struct mtd_dev_s *mtd)
       if (ret < 0)
         {
           ferr("ERROR: rwb_initialize failed: %d\n", ret);
+#ifdef CONFIG_FTL_LOG
+          ftl_log_uninitialize(&dev->log);
+#endif
           kmm_free(dev);
           return ret;
         }
@@ -692,6 +770,9 @@ int ftl_initialize_by_path(FAR const char *path, FAR struct mtd_dev_s *mtd)
           ferr("ERROR: register_blockdriver failed: %d\n", -ret);
 #ifdef FTL_HAVE_RWBUFFER
           rwb_uninitialize(&dev->rwb);
+#endif
+#ifdef CONFIG_FTL_LOG
+          ftl_log_uninitialize(&dev->log);
 #endif
           kmm_free(dev);
         }
@@ -0,0 +1,1319 @@
+/****************************************************************************
+ * drivers/mtd/ftl_log.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <semaphore.h>
+#include <assert.h>
+#include <crc32.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/signal.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/mtd/mtd.h>
+
+#include "ftl_log.h"
+
+#ifdef CONFIG_FTL_LOG
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_FTL_LOG_NSPARE
+#  define CONFIG_FTL_LOG_NSPARE 4
+#endif
+
+#if CONFIG_FTL_LOG_NSPARE < 2
+#  error CONFIG_FTL_LOG_NSPARE must be at least 2
+#endif
+
+#ifndef CONFIG_FTL_LOG_WLTHRESHOLD
+#  define CONFIG_FTL_LOG_WLTHRESHOLD 64
+#endif
+
+/* The minimum number of pages per erase block.  Every write costs a commit
+ * page in addition to its data pages, and every erase block a header page.
+ * With fewer pages per erase block, the log causes more erases than the
+ * read-modify-write of the default FTL and exports much less of the media.
+ */
+
+#define FTL_LOG_MINPAGES    16
+
+/* Magic numbers that identify the erase block header and commit pages */
+
+#define FTL_LOG_HDRMAGIC    0x484c5446  /* "FTLH" */
+#define FTL_LOG_CMTMAGIC    0x434c5446  /* "FTLC" */
+
+/* Marks an unmapped logical sector or a physical page without valid data */
+
+#define FTL_LOG_UNMAPPED    0xffffffff
+
+/* Erase block states */
+
+#define FTL_LOGBLK_FREE     0           /* No valid data, may be erased */
+#define FTL_LOGBLK_ACTIVE   1           /* Currently being written */
+#define FTL_LOGBLK_FULL     2           /* Written, candidate for GC */
+
+/* Only erase blocks with at most this many valid pages are collected when
+ * garbage collection is not strictly necessary.
+ */
+
+#define FTL_LOG_CHEAPGC(l)  ((l)->blkper >> 2)
+
+/* Opportunistic garbage collection runs on the low priority work queue if
+ * there is one.  Otherwise it runs after each write.
+ */
+
+#if defined(CONFIG_FS_WRITABLE) && defined(CONFIG_SCHED_LPWORK)
+#  define FTL_LOG_GCWORK    1
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The header written to the first page of each erase block after it has
+ * been erased.
+ */
+
+struct ftl_loghdr_s
+{
+  uint32_t magic;                /* FTL_LOG_HDRMAGIC */
+  uint32_t ecount;               /* Number of times the block was erased */
+  uint32_t crc;                  /* CRC32 of the preceding fields */
+};
+
+/* The rest of an erase block holds a chain of runs.  Each run is a commit
+ * page followed by the 'nentries' data pages that it describes, so the
+ * next commit page always follows the last data page of the previous run.
+ * Pages are only interpreted as commit pages at those positions; sector
+ * data is never mistaken for a commit page.
+ *
+ * A commit page begins with this header and is followed by 'nentries'
+ * instances of struct ftl_logentry_s.
+ */
+
+struct ftl_logcommit_s
+{
+  uint32_t magic;                /* FTL_LOG_CMTMAGIC */
+  uint32_t seq;                  /* Commit sequence number */
+  uint32_t nentries;             /* Number of entries that follow */
+  uint32_t crc;                  /* CRC32 of the header and entries */
+};
+
+/* The commit page is written before the data pages.  A run only takes
+ * effect if every data page matches the CRC in its entry, so a run that
+ * was interrupted by a power loss is ignored when the media is scanned.
+ */
+
+struct ftl_logentry_s
+{
+  uint32_t lsector;              /* Logical sector */
+  uint32_t crc;                  /* CRC32 of the data page */
+};
+
+/* In-memory state of one erase block */
+
+struct ftl_logblk_s
+{
+  uint32_t ecount;               /* Erase count */
+  uint16_t nvalid;               /* Number of pages with valid data */
+  uint8_t  state;                /* See FTL_LOGBLK_* definitions */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ftl_log_semtake
+ ****************************************************************************/
+
+static void ftl_log_semtake(FAR struct ftl_log_s *log)
+{
+  int ret;
+
+  do
+    {
+      /* Take the semaphore (perhaps waiting) */
+
+      ret = nxsem_wait(&log->exclsem);
+
+      /* The only case that an error should occur here is if the wait was
+       * awakened by a signal.
+       */
+
+      DEBUGASSERT(ret == OK || ret == -EINTR);
+    }
+  while (ret == -EINTR);
+}
+
+#define ftl_log_semgive(l) nxsem_post(&(l)->exclsem)
+
+/****************************************************************************
+ * Name: ftl_log_commitcrc
+ *
+ * Description:
+ *   Return the CRC32 of a commit page, excluding its crc field.
+ *
+ ****************************************************************************/
+
+static uint32_t ftl_log_commitcrc(FAR const uint8_t *page, uint32_t nentries)
+{
+  uint32_t crc;
+
+  crc = crc32(page, offsetof(struct ftl_logcommit_s, crc));
+  return crc32part(page + sizeof(struct ftl_logcommit_s),
+                   nentries * sizeof(struct ftl_logentry_s), crc);
+}
+
+/****************************************************************************
+ * Name: ftl_log_scanblock
+ *
+ * Description:
+ *   Read the header of one erase block, follow its chain of runs and apply
+ *   the complete runs to the logical-to-physical map.  The newest commit of
+ *   each sector, as determined by the sequence number, wins.
+ *
+ * Returned Value:
+ *   The largest commit sequence number found in the block.  The erase count
+ *   in 'blk' is set to UINT32_MAX if the block has no valid header.
+ *
+ ****************************************************************************/
+
+static uint32_t ftl_log_scanblock(FAR struct ftl_log_s *log, uint32_t block,
+                                  FAR uint32_t *seqmap)
+{
+  FAR struct ftl_logblk_s *blk = &log->blocks[block];
+  FAR struct ftl_loghdr_s *hdr;
+  FAR struct ftl_logcommit_s *cmt;
+  FAR struct ftl_logentry_s *entry;
+  uint32_t first = block * log->blkper;
+  uint32_t end = first + log->blkper;
+  uint32_t maxseq = 0;
+  uint32_t page;
+  uint32_t i;
+  ssize_t nread;
+
+  blk->ecount = UINT32_MAX;
+
+  nread = MTD_BREAD(log->mtd, first, 1, log->page);
+  if (nread != 1)
+    {
+      ferr("ERROR: Read block header %lu failed: %d\n",
+           (unsigned long)block, (int)nread);
+      return 0;
+    }
+
+  hdr = (FAR struct ftl_loghdr_s *)log->page;
+  if (hdr->magic != FTL_LOG_HDRMAGIC ||
+      hdr->crc != crc32(log->page, offsetof(struct ftl_loghdr_s, crc)))
+    {
+      /* Never written by this FTL or interrupted before the header was
+       * written.  There can be no committed data in the block.
+       */
+
+      return 0;
+    }
+
+  blk->ecount = hdr->ecount;
+
+  /* The commit page is read into the commit buffer, which is unused while
+   * scanning, so that the data pages can be checked in the page buffer.
+   */
+
+  cmt   = (FAR struct ftl_logcommit_s *)log->commit;
+  entry = (FAR struct ftl_logentry_s *)(log->commit + sizeof(*cmt));
+
+  for (page = first + 1; page < end; page += cmt->nentries + 1)
+    {
+      nread = MTD_BREAD(log->mtd, page, 1, log->commit);
+      if (nread != 1)
+        {
+          ferr("ERROR: Read page %lu failed: %d\n",
+               (unsigned long)page, (int)nread);
+          break;
+        }
+
+      if (cmt->magic != FTL_LOG_CMTMAGIC || cmt->seq == 0 ||
+          cmt->nentries == 0 || cmt->nentries > log->maxentries ||
+          cmt->nentries >= end - page ||
+          cmt->crc != ftl_log_commitcrc(log->commit, cmt->nentries))
+        {
+          /* An erased page or a commit page that was not written
+           * completely.  This is the end of the log in this block.
+           */
+
+          break;
+        }
+
+      if (cmt->seq > maxseq)
+        {
+          maxseq = cmt->seq;
+        }
+
+      /* The run only takes effect if all of its data pages were written */
+
+      for (i = 0; i < cmt->nentries; i++)
+        {
+          nread = MTD_BREAD(log->mtd, page + 1 + i, 1, log->page);
+          if (nread != 1 || entry[i].crc != crc32(log->page, log->blocksize))
+            {
+              break;
+            }
+        }
+
+      if (i < cmt->nentries)
+        {
+          finfo("Ignoring incomplete run at page %lu\n",
+                (unsigned long)page);
+          continue;
+        }
+
+      for (i = 0; i < cmt->nentries; i++)
+        {
+          if (entry[i].lsector < log->nsectors &&
+              cmt->seq >= seqmap[entry[i].lsector])
+            {
+              log->l2p[entry[i].lsector] = page + 1 + i;
+              seqmap[entry[i].lsector]   = cmt->seq;
+            }
+        }
+    }
+
+  return maxseq;
+}
+
+/****************************************************************************
+ * Name: ftl_log_scan
+ *
+ * Description:
+ *   Rebuild the mapping tables and erase block state from the media.
+ *
+ ****************************************************************************/
+
+static int ftl_log_scan(FAR struct ftl_log_s *log)
+{
+  FAR struct ftl_logblk_s *blk;
+  FAR uint32_t *seqmap;
+  uint64_t total = 0;
+  uint32_t nknown = 0;
+  uint32_t maxseq = 0;
+  uint32_t seq;
+  uint32_t page;
+  uint32_t i;
+
+  /* The sequence number of the commit that established each mapping is
+   * only needed during the scan.
+   */
+
+  seqmap = (FAR uint32_t *)kmm_zalloc(log->nsectors * sizeof(uint32_t));
+  if (seqmap == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  memset(log->l2p, 0xff, log->nsectors * sizeof(uint32_t));
+  memset(log->p2l, 0xff,
+         log->neraseblocks * log->blkper * sizeof(uint32_t));
+
+  for (i = 0; i < log->neraseblocks; i++)
+    {
+      seq = ftl_log_scanblock(log, i, seqmap);
+      if (seq > maxseq)
+        {
+          maxseq = seq;
+        }
+
+      if (log->blocks[i].ecount != UINT32_MAX)
+        {
+          total += log->blocks[i].ecount;
+          nknown++;
+        }
+    }
+
+  kmm_free(seqmap);
+
+  /* Derive the reverse map and the number of valid pages per block */
+
+  for (i = 0; i < log->nsectors; i++)
+    {
+      page = log->l2p[i];
+      if (page != FTL_LOG_UNMAPPED)
+        {
+          log->p2l[page] = i;
+          log->blocks[page / log->blkper].nvalid++;
+        }
+    }
+
+  /* Blocks without a valid header are assumed to have seen an average
+   * amount of wear.
+   */
+
+  log->nfree = 0;
+  for (i = 0; i < log->neraseblocks; i++)
+    {
+      blk = &log->blocks[i];
+      if (blk->ecount == UINT32_MAX)
+        {
+          blk->ecount = nknown > 0 ? (uint32_t)(total / nknown) : 0;
+        }
+
+      if (blk->nvalid > 0)
+        {
+          blk->state = FTL_LOGBLK_FULL;
+        }
+      else
+        {
+          blk->state = FTL_LOGBLK_FREE;
+          log->nfree++;
+        }
+    }
+
+  log->seq    = maxseq + 1;
+  log->active = -1;
+
+  finfo("nsectors: %lu free blocks: %lu next seq: %lu\n",
+        (unsigned long)log->nsectors, (unsigned long)log->nfree,
+        (unsigned long)log->seq);
+  return OK;
+}
+
+#ifdef CONFIG_FS_WRITABLE
+/****************************************************************************
+ * Name: ftl_log_open
+ *
+ * Description:
+ *   Erase the free block with the lowest erase count, write its header and
+ *   make it the active block.
+ *
+ ****************************************************************************/
+
+static int ftl_log_open(FAR struct ftl_log_s *log)
+{
+  FAR struct ftl_logblk_s *blk;
+  FAR struct ftl_loghdr_s *hdr;
+  int32_t block = -1;
+  ssize_t nxfrd;
+  uint32_t i;
+  int ret;
+
+  for (i = 0; i < log->neraseblocks; i++)
+    {
+      if (log->blocks[i].state == FTL_LOGBLK_FREE &&
+          (block < 0 || log->blocks[i].ecount < log->blocks[block].ecount))
+        {
+          block = i;
+        }
+    }
+
+  if (block < 0)
+    {
+      return -ENOSPC;
+    }
+
+  blk = &log->blocks[block];
+  DEBUGASSERT(blk->nvalid == 0);
+
+  ret = MTD_ERASE(log->mtd, block, 1);
+  if (ret < 0)
+    {
+      ferr("ERROR: Erase block=%ld failed: %d\n", (long)block, ret);
+      return ret;
+    }
+
+  blk->ecount++;
+
+  memset(log->page, 0xff, log->blocksize);
+  hdr         = (FAR struct ftl_loghdr_s *)log->page;
+  hdr->magic  = FTL_LOG_HDRMAGIC;
+  hdr->ecount = blk->ecount;
+  hdr->crc    = crc32(log->page, offsetof(struct ftl_loghdr_s, crc));
+
+  nxfrd = MTD_BWRITE(log->mtd, block * log->blkper, 1, log->page);
+  if (nxfrd != 1)
+    {
+      ferr("ERROR: Write block header %ld failed: %d\n",
+           (long)block, (int)nxfrd);
+      return -EIO;
+    }
+
+  blk->state    = FTL_LOGBLK_ACTIVE;
+  log->active   = block;
+  log->nextpage = 1;
+  log->nfree--;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_log_close
+ *
+ * Description:
+ *   Stop writing to the active block.  This is also done when a write to
+ *   the block fails:  The scan stops at the first damaged commit page of a
+ *   block, so nothing may be appended after it.
+ *
+ ****************************************************************************/
+
+static void ftl_log_close(FAR struct ftl_log_s *log)
+{
+  if (log->active >= 0)
+    {
+      log->blocks[log->active].state = FTL_LOGBLK_FULL;
+      log->active = -1;
+    }
+}
+
+/****************************************************************************
+ * Name: ftl_log_addentry
+ *
+ * Description:
+ *   Add the sector whose new data is in 'data' to the run being assembled.
+ *
+ ****************************************************************************/
+
+static void ftl_log_addentry(FAR struct ftl_log_s *log, uint32_t lsector,
+                             FAR const uint8_t *data)
+{
+  FAR struct ftl_logentry_s *entry;
+
+  DEBUGASSERT(log->npending < log->maxentries);
+
+  entry = (FAR struct ftl_logentry_s *)
+    (log->commit + sizeof(struct ftl_logcommit_s));
+  entry[log->npending].lsector = lsector;
+  entry[log->npending].crc     = crc32(data, log->blocksize);
+  log->npending++;
+}
+
+/****************************************************************************
+ * Name: ftl_log_putcommit
+ *
+ * Description:
+ *   Write the commit page of the run being assembled to the next page of
+ *   the active block and reserve the pages that follow it for the data.
+ *   The caller must write the data pages and then call ftl_log_remap(), or
+ *   call ftl_log_abort() if that fails.
+ *
+ * Input Parameters:
+ *   log   - The log-structured FTL state.
+ *   first - The location to return the page for the first data page.
+ *
+ ****************************************************************************/
+
+static int ftl_log_putcommit(FAR struct ftl_log_s *log, FAR uint32_t *first)
+{
+  FAR struct ftl_logcommit_s *cmt;
+  FAR struct ftl_logentry_s *entry;
+  uint32_t page;
+  ssize_t nxfrd;
+
+  DEBUGASSERT(log->active >= 0 && log->npending > 0 &&
+              log->nextpage + log->npending < log->blkper);
+
+  cmt           = (FAR struct ftl_logcommit_s *)log->commit;
+  cmt->magic    = FTL_LOG_CMTMAGIC;
+  cmt->seq      = log->seq;
+  cmt->nentries = log->npending;
+  cmt->crc      = ftl_log_commitcrc(log->commit, log->npending);
+
+  entry = (FAR struct ftl_logentry_s *)(log->commit + sizeof(*cmt));
+  memset(&entry[log->npending], 0xff, log->blocksize - sizeof(*cmt) -
+         log->npending * sizeof(struct ftl_logentry_s));
+
+  page           = log->active * log->blkper + log->nextpage;
+  nxfrd          = MTD_BWRITE(log->mtd, page, 1, log->commit);
+  log->nextpage += log->npending + 1;
+
+  if (nxfrd != 1)
+    {
+      ferr("ERROR: Write commit page %lu failed: %d\n",
+           (unsigned long)page, (int)nxfrd);
+      log->npending = 0;
+      ftl_log_close(log);
+      return -EIO;
+    }
+
+  *first = page + 1;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_log_abort
+ *
+ * Description:
+ *   Discard a run whose data pages could not be written.  Its CRCs will not
+ *   match, so the run is ignored when the media is scanned.
+ *
+ ****************************************************************************/
+
+static void ftl_log_abort(FAR struct ftl_log_s *log)
+{
+  log->npending = 0;
+  ftl_log_close(log);
+}
+
+/****************************************************************************
+ * Name: ftl_log_remap
+ *
+ * Description:
+ *   All data pages of the run starting at page 'first' have been written,
+ *   so the run is now durable.  Update the in-memory maps and retire the
+ *   old copies of its sectors.
+ *
+ ****************************************************************************/
+
+static void ftl_log_remap(FAR struct ftl_log_s *log, uint32_t first)
+{
+  FAR struct ftl_logentry_s *entry;
+  uint32_t page;
+  uint32_t old;
+  uint16_t i;
+
+  entry = (FAR struct ftl_logentry_s *)
+    (log->commit + sizeof(struct ftl_logcommit_s));
+
+  for (i = 0; i < log->npending; i++, entry++)
+    {
+      page = first + i;
+      old  = log->l2p[entry->lsector];
+      if (old != FTL_LOG_UNMAPPED)
+        {
+          log->p2l[old] = FTL_LOG_UNMAPPED;
+          log->blocks[old / log->blkper].nvalid--;
+        }
+
+      log->l2p[entry->lsector] = page;
+      log->p2l[page]           = entry->lsector;
+      log->blocks[page / log->blkper].nvalid++;
+    }
+
+  log->seq++;
+  log->npending = 0;
+}
+
+/****************************************************************************
+ * Name: ftl_log_victim
+ *
+ * Description:
+ *   Select the full erase block to be collected next.  When free blocks are
+ *   needed, this is the block with the fewest valid pages.  Otherwise, if
+ *   the erase counts have drifted too far apart, the least worn block is
+ *   chosen so that the static data it holds is moved and the block itself
+ *   returns to circulation; failing that, a block is only chosen if
+ *   collecting it is cheap.
+ *
+ ****************************************************************************/
+
+static int32_t ftl_log_victim(FAR struct ftl_log_s *log, bool idle)
+{
+  FAR struct ftl_logblk_s *blk;
+  int32_t leastvalid = -1;
+  int32_t leastworn = -1;
+  uint32_t maxecount = 0;
+  uint32_t i;
+
+  for (i = 0; i < log->neraseblocks; i++)
+    {
+      blk = &log->blocks[i];
+      if (blk->ecount > maxecount)
+        {
+          maxecount = blk->ecount;
+        }
+
+      if (blk->state != FTL_LOGBLK_FULL)
+        {
+          continue;
+        }
+
+      if (leastvalid < 0 || blk->nvalid < log->blocks[leastvalid].nvalid)
+        {
+          leastvalid = i;
+        }
+
+      if (leastworn < 0 || blk->ecount < log->blocks[leastworn].ecount)
+        {
+          leastworn = i;
+        }
+    }
+
+  if (leastvalid < 0 || !idle)
+    {
+      return leastvalid;
+    }
+
+  if (maxecount - log->blocks[leastworn].ecount > CONFIG_FTL_LOG_WLTHRESHOLD)
+    {
+      return leastworn;
+    }
+
+  if (log->nfree < CONFIG_FTL_LOG_NSPARE &&
+      log->blocks[leastvalid].nvalid <= FTL_LOG_CHEAPGC(log))
+    {
+      return leastvalid;
+    }
+
+  return -1;
+}
+
+/****************************************************************************
+ * Name: ftl_log_reserve
+ *
+ * Description:
+ *   Make sure that the active block has room for a commit page and at least
+ *   one data page, collecting garbage if free blocks are running out.
+ *
+ ****************************************************************************/
+
+static int ftl_log_collect(FAR struct ftl_log_s *log, bool idle);
+
+static int ftl_log_reserve(FAR struct ftl_log_s *log)
+{
+  uint32_t retries = 0;
+  int ret;
+
+  DEBUGASSERT(log->npending == 0);
+
+  while (log->active < 0 || log->blkper - log->nextpage < 2)
+    {
+      ftl_log_close(log);
+
+      /* Always keep one free block for garbage collection to copy into */
+
+      if (log->nfree < 2 && !log->ingc)
+        {
+          if (++retries > log->neraseblocks)
+            {
+              return -ENOSPC;
+            }
+
+          ret = ftl_log_collect(log, false);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          continue;
+        }
+
+      ret = ftl_log_open(log);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_log_collect
+ *
+ * Description:
+ *   Copy the valid pages of one erase block to the head of the log and
+ *   return the block to the free pool.  The block is not erased until it
+ *   is reused, and only after the copies have been committed.
+ *
+ *   The pages are copied in runs.  Each run is read twice:  Once to compute
+ *   the CRCs for the commit page that precedes the copies, and once to copy
+ *   the data.  The second read is checked against the CRC.
+ *
+ * Input Parameters:
+ *   log  - The log-structured FTL state.
+ *   idle - True if collection is opportunistic (see ftl_log_victim).
+ *          Finding no victim is not an error then.
+ *
+ ****************************************************************************/
+
+static int ftl_log_collect(FAR struct ftl_log_s *log, bool idle)
+{
+  FAR struct ftl_logblk_s *blk;
+  FAR struct ftl_logentry_s *entry;
+  uint32_t first;
+  uint32_t start;
+  uint32_t page;
+  uint32_t src;
+  uint32_t dest;
+  uint16_t room;
+  uint16_t i;
+  int32_t victim;
+  ssize_t nxfrd;
+  int ret = OK;
+
+  victim = ftl_log_victim(log, idle);
+  if (victim < 0)
+    {
+      return idle ? OK : -ENOSPC;
+    }
+
+  blk   = &log->blocks[victim];
+  first = victim * log->blkper;
+  entry = (FAR struct ftl_logentry_s *)
+    (log->commit + sizeof(struct ftl_logcommit_s));
+
+  finfo("Collect block %ld: %u valid pages\n", (long)victim, blk->nvalid);
+
+  log->ingc = true;
+  page      = first + 1;
+
+  while (blk->nvalid > 0)
+    {
+      /* Opening a new block uses the page buffer, so reserve space first */
+
+      ret = ftl_log_reserve(log);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      room = log->blkper - log->nextpage - 1;
+      if (room > log->maxentries)
+        {
+          room = log->maxentries;
+        }
+
+      /* Add the next valid pages to the run */
+
+      for (start = page;
+           page < first + log->blkper && log->npending < room;
+           page++)
+        {
+          if (log->p2l[page] == FTL_LOG_UNMAPPED)
+            {
+              continue;
+            }
+
+          nxfrd = MTD_BREAD(log->mtd, page, 1, log->page);
+          if (nxfrd != 1)
+            {
+              ferr("ERROR: Read page %lu failed: %d\n",
+                   (unsigned long)page, (int)nxfrd);
+              ret = -EIO;
+              break;
+            }
+
+          ftl_log_addentry(log, log->p2l[page], log->page);
+        }
+
+      if (ret < 0)
+        {
+          break;
+        }
+
+      DEBUGASSERT(log->npending > 0);
+
+      ret = ftl_log_putcommit(log, &dest);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      /* Copy the data pages */
+
+      for (src = start, i = 0; i < log->npending; src++)
+        {
+          if (log->p2l[src] == FTL_LOG_UNMAPPED)
+            {
+              continue;
+            }
+
+          nxfrd = MTD_BREAD(log->mtd, src, 1, log->page);
+          if (nxfrd != 1 || entry[i].crc != crc32(log->page, log->blocksize))
+            {
+              ferr("ERROR: Read page %lu failed: %d\n",
+                   (unsigned long)src, (int)nxfrd);
+              ret = -EIO;
+              break;
+            }
+
+          nxfrd = MTD_BWRITE(log->mtd, dest + i, 1, log->page);
+          if (nxfrd != 1)
+            {
+              ferr("ERROR: Write page %lu failed: %d\n",
+                   (unsigned long)(dest + i), (int)nxfrd);
+              ret = -EIO;
+              break;
+            }
+
+          i++;
+        }
+
+      if (ret < 0)
+        {
+          ftl_log_abort(log);
+          break;
+        }
+
+      ftl_log_remap(log, dest);
+    }
+
+  log->npending = 0;
+  log->ingc     = false;
+
+  if (ret >= 0)
+    {
+      DEBUGASSERT(blk->nvalid == 0);
+      blk->state = FTL_LOGBLK_FREE;
+      log->nfree++;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ftl_log_gcworker
+ *
+ * Description:
+ *   Reclaim a mostly stale block while it is cheap to do so, or move static
+ *   data for wear leveling.  This runs on the low priority work queue after
+ *   writes so that fewer writes have to wait for garbage collection later.
+ *   It reschedules itself while there is more to collect, unless the FTL is
+ *   being torn down.
+ *
+ ****************************************************************************/
+
+#ifdef FTL_LOG_GCWORK
+static void ftl_log_gcworker(FAR void *arg)
+{
+  FAR struct ftl_log_s *log = (FAR struct ftl_log_s *)arg;
+  int ret;
+
+  ftl_log_semtake(log);
+
+  if (!log->closing)
+    {
+      ret = ftl_log_collect(log, true);
+      if (ret < 0)
+        {
+          ferr("ERROR: Garbage collection failed: %d\n", ret);
+        }
+      else if (ftl_log_victim(log, true) >= 0)
+        {
+          (void)work_queue(LPWORK, &log->gcwork, ftl_log_gcworker, log, 0);
+          ftl_log_semgive(log);
+          return;
+        }
+    }
+
+  /* ftl_log_uninitialize() waits for this before freeing anything */
+
+  log->gcpending = false;
+  ftl_log_semgive(log);
+}
+#endif
+#endif /* CONFIG_FS_WRITABLE */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ftl_log_initialize
+ *
+ * Description:
+ *   Allocate the mapping tables of a log-structured FTL and rebuild them by
+ *   scanning the commit records on the MTD device.
+ *
+ ****************************************************************************/
+
+int ftl_log_initialize(FAR struct ftl_log_s *log, FAR struct mtd_dev_s *mtd,
+                       FAR const struct mtd_geometry_s *geo)
+{
+  uint32_t usable;
+  uint32_t perblock;
+  uint32_t npages;
+  int ret;
+
+  memset(log, 0, sizeof(struct ftl_log_s));
+
+  log->mtd          = mtd;
+  log->blocksize    = geo->blocksize;
+  log->neraseblocks = geo->neraseblocks;
+  log->blkper       = geo->erasesize / geo->blocksize;
+  log->active       = -1;
+
+  nxsem_init(&log->exclsem, 0, 1);
+
+  /* Each erase block needs a header page, data pages and the commit pages
+   * following them.  Too few pages per erase block make the log worse than
+   * the default FTL (see FTL_LOG_MINPAGES).
+   */
+
+  if (log->blkper < FTL_LOG_MINPAGES ||
+      log->neraseblocks <= CONFIG_FTL_LOG_NSPARE ||
+      log->blocksize < sizeof(struct ftl_logcommit_s) +
+                       sizeof(struct ftl_logentry_s))
+    {
+      ferr("ERROR: Unsupported geometry: %u pages per erase block\n",
+           (unsigned int)log->blkper);
+      nxsem_destroy(&log->exclsem);
+      return -EINVAL;
+    }
+
+  log->maxentries = (log->blocksize - sizeof(struct ftl_logcommit_s)) /
+                    sizeof(struct ftl_logentry_s);
+
+  /* Work out how many data pages fit in one erase block when every commit
+   * page is full.  One of them and the spare blocks are not exported so
+   * that garbage collection can always find a victim whose valid pages can
+   * be copied with room to spare in the destination block.
+   */
+
+  usable    = log->blkper - 1;
+  perblock  = (usable / (log->maxentries + 1)) * log->maxentries;
+  if (usable % (log->maxentries + 1) > 1)
+    {
+      perblock += usable % (log->maxentries + 1) - 1;
+    }
+
+  log->nsectors = (log->neraseblocks - CONFIG_FTL_LOG_NSPARE) *
+                  (perblock - 1);
+  npages        = log->neraseblocks * log->blkper;
+
+  log->l2p    = (FAR uint32_t *)kmm_malloc(log->nsectors * sizeof(uint32_t));
+  log->p2l    = (FAR uint32_t *)kmm_malloc(npages * sizeof(uint32_t));
+  log->blocks = (FAR struct ftl_logblk_s *)
+    kmm_zalloc(log->neraseblocks * sizeof(struct ftl_logblk_s));
+  log->commit = (FAR uint8_t *)kmm_malloc(log->blocksize);
+  log->page   = (FAR uint8_t *)kmm_malloc(log->blocksize);
+
+  if (log->l2p == NULL || log->p2l == NULL || log->blocks == NULL ||
+      log->commit == NULL || log->page == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  ret = ftl_log_scan(log);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  return OK;
+
+errout:
+  ferr("ERROR: Failed to initialize: %d\n", ret);
+  ftl_log_uninitialize(log);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ftl_log_uninitialize
+ *
+ * Description:
+ *   Release the resources held by a log-structured FTL.
+ *
+ ****************************************************************************/
+
+void ftl_log_uninitialize(FAR struct ftl_log_s *log)
+{
+#ifdef FTL_LOG_GCWORK
+  /* Stop the garbage collection worker from re-queuing itself and cancel it.
+   * work_cancel() does not wait for a worker that has already been started,
+   * so wait until a running worker has released the FTL.
+   */
+
+  ftl_log_semtake(log);
+  log->closing = true;
+  if (work_cancel(LPWORK, &log->gcwork) >= 0)
+    {
+      log->gcpending = false;
+    }
+
+  while (log->gcpending)
+    {
+      ftl_log_semgive(log);
+      (void)nxsig_usleep(USEC_PER_TICK);
+      ftl_log_semtake(log);
+    }
+
+  ftl_log_semgive(log);
+#endif
+
+  nxsem_destroy(&log->exclsem);
+
+  if (log->l2p != NULL)
+    {
+      kmm_free(log->l2p);
+      log->l2p = NULL;
+    }
+
+  if (log->p2l != NULL)
+    {
+      kmm_free(log->p2l);
+      log->p2l = NULL;
+    }
+
+  if (log->blocks != NULL)
+    {
+      kmm_free(log->blocks);
+      log->blocks = NULL;
+    }
+
+  if (log->commit != NULL)
+    {
+      kmm_free(log->commit);
+      log->commit = NULL;
+    }
+
+  if (log->page != NULL)
+    {
+      kmm_free(log->page);
+      log->page = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: ftl_log_bulkerase
+ *
+ * Description:
+ *   Erase the entire MTD device and reset the mapping tables to match.
+ *
+ ****************************************************************************/
+
+int ftl_log_bulkerase(FAR struct ftl_log_s *log)
+{
+  int ret;
+  int ret2;
+
+  ftl_log_semtake(log);
+
+  ret = MTD_IOCTL(log->mtd, MTDIOC_BULKERASE, 0);
+  if (ret < 0)
+    {
+      ferr("ERROR: MTD ioctl(MTDIOC_BULKERASE) failed: %d\n", ret);
+    }
+
+  /* Rescan even if the erase failed part way through */
+
+  log->npending = 0;
+  log->nextpage = 0;
+
+  ret2 = ftl_log_scan(log);
+  if (ret2 < 0)
+    {
+      ferr("ERROR: ftl_log_scan failed: %d\n", ret2);
+      ret = ret2;
+    }
+
+  ftl_log_semgive(log);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ftl_log_read
+ *
+ * Description:
+ *   Read the specified number of logical sectors.  Physically contiguous
+ *   runs are read from the MTD device with a single request.
+ *
+ ****************************************************************************/
+
+ssize_t ftl_log_read(FAR struct ftl_log_s *log, FAR uint8_t *buffer,
+                     off_t startblock, size_t nblocks)
+{
+  uint32_t sector = startblock;
+  uint32_t page;
+  size_t remaining = nblocks;
+  size_t n;
+  ssize_t nread;
+
+  if (startblock < 0 || startblock + nblocks > log->nsectors)
+    {
+      return -EINVAL;
+    }
+
+  ftl_log_semtake(log);
+
+  while (remaining > 0)
+    {
+      page = log->l2p[sector];
+      n    = 1;
+
+      if (page == FTL_LOG_UNMAPPED)
+        {
+          /* Never written: return erased data */
+
+          memset(buffer, 0xff, log->blocksize);
+        }
+      else
+        {
+          while (n < remaining && log->l2p[sector + n] == page + n)
+            {
+              n++;
+            }
+
+          nread = MTD_BREAD(log->mtd, page, n, buffer);
+          if (nread != (ssize_t)n)
+            {
+              ferr("ERROR: Read %d pages starting at page %lu failed: %d\n",
+                   (int)n, (unsigned long)page, (int)nread);
+              ftl_log_semgive(log);
+              return -EIO;
+            }
+        }
+
+      buffer    += n * log->blocksize;
+      sector    += n;
+      remaining -= n;
+    }
+
+  ftl_log_semgive(log);
+  return nblocks;
+}
+
+/****************************************************************************
+ * Name: ftl_log_write
+ *
+ * Description:
+ *   Append the specified number of logical sectors to the log and commit
+ *   them.  Consecutive sectors are written to the MTD device with a single
+ *   request for as long as they fit in the active block.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_WRITABLE
+ssize_t ftl_log_write(FAR struct ftl_log_s *log, FAR const uint8_t *buffer,
+                      off_t startblock, size_t nblocks)
+{
+  uint32_t sector = startblock;
+  uint32_t page;
+  size_t remaining = nblocks;
+  size_t n;
+  size_t i;
+  ssize_t nxfrd;
+  int ret = OK;
+
+  if (startblock < 0 || startblock + nblocks > log->nsectors)
+    {
+      return -EINVAL;
+    }
+
+  ftl_log_semtake(log);
+
+  while (remaining > 0)
+    {
+      ret = ftl_log_reserve(log);
+      if (ret < 0)
+        {
+          goto errout;
+        }
+
+      /* Leave room for the commit page */
+
+      n = log->blkper - log->nextpage - 1;
+      if (n > log->maxentries)
+        {
+          n = log->maxentries;
+        }
+
+      if (n > remaining)
+        {
+          n = remaining;
+        }
+
+      for (i = 0; i < n; i++)
+        {
+          ftl_log_addentry(log, sector + i, buffer + i * log->blocksize);
+        }
+
+      ret = ftl_log_putcommit(log, &page);
+      if (ret < 0)
+        {
+          goto errout;
+        }
+
+      nxfrd = MTD_BWRITE(log->mtd, page, n, buffer);
+      if (nxfrd != (ssize_t)n)
+        {
+          ferr("ERROR: Write %d pages starting at page %lu failed: %d\n",
+               (int)n, (unsigned long)page, (int)nxfrd);
+          ftl_log_abort(log);
+          ret = -EIO;
+          goto errout;
+        }
+
+      ftl_log_remap(log, page);
+
+      buffer    += n * log->blocksize;
+      sector    += n;
+      remaining -= n;
+    }
+
+  /* Reclaim a mostly stale block while it is cheap to do so, or move static
+   * data for wear leveling.  This is left to the low priority work queue if
+   * there is one.  The data has already been committed, so a failure here
+   * does not fail the write.
+   */
+
+#ifdef FTL_LOG_GCWORK
+  if (!log->gcpending && !log->closing)
+    {
+      log->gcpending = true;
+      (void)work_queue(LPWORK, &log->gcwork, ftl_log_gcworker, log, 0);
+    }
+#else
+  ret = ftl_log_collect(log, true);
+  if (ret < 0)
+    {
+      ferr("ERROR: Garbage collection failed: %d\n", ret);
+    }
+#endif
+
+  ftl_log_semgive(log);
+  return nblocks;
+
+errout:
+  ftl_log_semgive(log);
+  return ret;
+}
+#endif /* CONFIG_FS_WRITABLE */
+
+#endif /* CONFIG_FTL_LOG */
@@ -0,0 +1,178 @@
+/****************************************************************************
+ * drivers/mtd/ftl_log.h
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __DRIVERS_MTD_FTL_LOG_H
+#define __DRIVERS_MTD_FTL_LOG_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <semaphore.h>
+
+#include <nuttx/wqueue.h>
+#include <nuttx/mtd/mtd.h>
+
+#ifdef CONFIG_FTL_LOG
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The state of one log-structured FTL instance.  Every R/W block of the
+ * underlying MTD device is a physical page.  The first page of each erase
+ * block holds a header with the erase count of the block; the remaining
+ * pages hold runs of a commit record followed by the data pages that it
+ * binds to logical sectors.
+ */
+
+struct ftl_logblk_s;             /* Per-erase block state (see ftl_log.c) */
+
+struct ftl_log_s
+{
+  FAR struct mtd_dev_s *mtd;     /* Contained MTD interface */
+  sem_t     exclsem;             /* Supports mutually exclusive access */
+  uint32_t  blocksize;           /* Size of one page (MTD R/W block) */
+  uint32_t  neraseblocks;        /* Number of erase blocks */
+  uint32_t  nsectors;            /* Number of logical sectors exported */
+  uint32_t  nfree;               /* Number of erase blocks without data */
+  uint32_t  seq;                 /* Sequence number of the next commit */
+  int32_t   active;              /* Erase block being written (or -1) */
+  uint16_t  blkper;              /* Pages per erase block */
+  uint16_t  nextpage;            /* Next unwritten page in active block */
+  uint16_t  maxentries;          /* Number of entries in one commit page */
+  uint16_t  npending;            /* Entries in the commit being assembled */
+  bool      ingc;                /* Garbage collection in progress */
+  FAR uint32_t *l2p;             /* Logical sector -> physical page */
+  FAR uint32_t *p2l;             /* Physical page -> logical sector */
+  FAR struct ftl_logblk_s *blocks; /* State of each erase block */
+  FAR uint8_t *commit;           /* Commit page being assembled */
+  FAR uint8_t *page;             /* Page buffer for scanning and copying */
+#if defined(CONFIG_FS_WRITABLE) && defined(CONFIG_SCHED_LPWORK)
+  struct work_s gcwork;          /* Opportunistic garbage collection */
+  bool      gcpending;           /* gcwork is queued or running */
+  bool      closing;             /* Tear-down started; don't queue gcwork */
+#endif
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ftl_log_initialize
+ *
+ * Description:
+ *   Allocate the mapping tables of a log-structured FTL and rebuild them by
+ *   scanning the commit records on the MTD device.
+ *
+ * Input Parameters:
+ *   log - The log-structured FTL state to initialize.
+ *   mtd - The MTD device that supports the FLASH interface.
+ *   geo - The geometry of the MTD device.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int ftl_log_initialize(FAR struct ftl_log_s *log, FAR struct mtd_dev_s *mtd,
+                       FAR const struct mtd_geometry_s *geo);
+
+/****************************************************************************
+ * Name: ftl_log_uninitialize
+ *
+ * Description:
+ *   Release the resources held by a log-structured FTL.
+ *
+ ****************************************************************************/
+
+void ftl_log_uninitialize(FAR struct ftl_log_s *log);
+
+/****************************************************************************
+ * Name: ftl_log_bulkerase
+ *
+ * Description:
+ *   Erase the entire MTD device and reset the mapping tables to match.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int ftl_log_bulkerase(FAR struct ftl_log_s *log);
+
+/****************************************************************************
+ * Name: ftl_log_read
+ *
+ * Description:
+ *   Read the specified number of logical sectors.  Sectors that have never
+ *   been written read back as erased (0xff) data.
+ *
+ * Returned Value:
+ *   The number of sectors read on success; a negated errno value on
+ *   failure.
+ *
+ ****************************************************************************/
+
+ssize_t ftl_log_read(FAR struct ftl_log_s *log, FAR uint8_t *buffer,
+                     off_t startblock, size_t nblocks);
+
+/****************************************************************************
+ * Name: ftl_log_write
+ *
+ * Description:
+ *   Append the specified number of logical sectors to the log and commit
+ *   them.  The previous copies of the sectors remain valid on the media
+ *   until all data pages of the commit have been written.
+ *
+ * Returned Value:
+ *   The number of sectors written on success; a negated errno value on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_WRITABLE
+ssize_t ftl_log_write(FAR struct ftl_log_s *log, FAR const uint8_t *buffer,
+                      off_t startblock, size_t nblocks);
+#endif
+
+#endif /* CONFIG_FTL_LOG */
+#endif /* __DRIVERS_MTD_FTL_LOG_H */
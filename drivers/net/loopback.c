@@ -163,6 +163,10 @@ static int lo_txpoll(FAR struct net_driver_s *dev)
    * the case upon entry here and while the processing of the IPv4/6 packet
    * generates a new packet to be sent.  Sending, of course, just means
    * relaying back through the network for this driver.
+   *
+   * The checksums of a looped back packet were computed by this network
+   * only a moment ago and the packet never left memory, so they need not
+   * be verified on input.
    */
 
   while (priv->lo_dev.d_len > 0)
@@ -183,6 +187,7 @@ static int lo_txpoll(FAR struct net_driver_s *dev)
         {
           ninfo("IPv4 frame\n");
           NETDEV_RXIPV4(&priv->lo_dev);
+          priv->lo_dev.d_rxchksum = true;
           ipv4_input(&priv->lo_dev);
         }
       else
@@ -192,6 +197,7 @@ static int lo_txpoll(FAR struct net_driver_s *dev)
         {
           ninfo("Iv6 frame\n");
           NETDEV_RXIPV6(&priv->lo_dev);
+          priv->lo_dev.d_rxchksum = true;
           ipv6_input(&priv->lo_dev);
         }
       else
@@ -230,8 +236,9 @@ static void lo_poll_work(FAR void *arg)
 {
   FAR struct lo_driver_s *priv = (FAR struct lo_driver_s *)arg;
 
-  /* Perform the poll */
+  /* Perform the poll.  The device lock is taken before the network lock. */
 
+  net_devlock(&priv->lo_dev);
   net_lock();
   priv->lo_txdone = false;
   (void)devif_timer(&priv->lo_dev, lo_txpoll);
@@ -250,6 +257,7 @@ static void lo_poll_work(FAR void *arg)
 
   (void)wd_start(priv->lo_polldog, LO_WDDELAY, lo_poll_expiry, 1, priv);
   net_unlock();
+  net_devunlock(&priv->lo_dev);
 }
 
 /****************************************************************************
@@ -375,6 +383,7 @@ static void lo_txavail_work(FAR void *arg)
 
   /* Ignore the notification if the interface is not yet up */
 
+  net_devlock(&priv->lo_dev);
   net_lock();
   if (priv->lo_bifup)
     {
@@ -389,6 +398,7 @@ static void lo_txavail_work(FAR void *arg)
     }
 
   net_unlock();
+  net_devunlock(&priv->lo_dev);
 }
 
 /****************************************************************************
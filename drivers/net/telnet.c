@@ -67,6 +67,10 @@
 #include <nuttx/net/net.h>
 #include <nuttx/net/telnet.h>
 
+#ifdef CONFIG_NET_TCP_READAHEAD
+#  include <nuttx/mm/iob.h>
+#endif
+
 #ifdef CONFIG_NETDEV_TELNET
 
 /****************************************************************************
@@ -100,6 +104,17 @@
 #  define HAVE_SIGNALS
 #endif
 
+/* With TCP read-ahead, received data is taken from the socket as an I/O
+ * buffer chain without copying.  Otherwise it is copied into td_rxbuffer.
+ */
+
+#ifdef CONFIG_NET_TCP_READAHEAD
+#  define TELNET_PENDING(p)   ((p)->td_rxiob != NULL ? \
+                               (p)->td_rxiob->io_pktlen : 0)
+#else
+#  define TELNET_PENDING(p)   ((p)->td_pending)
+#endif
+
 /* Telnet protocol stuff ****************************************************/
 
 #define ISO_nl                0x0a
@@ -157,8 +172,10 @@ struct telnet_dev_s
   sem_t             td_exclsem;   /* Enforces mutually exclusive access */
   sem_t             td_iosem;     /* I/O thread will notify that data is available */
   uint8_t           td_state;     /* (See telnet_state_e) */
+#ifndef CONFIG_NET_TCP_READAHEAD
   uint8_t           td_pending;   /* Number of valid, pending bytes in the rxbuffer */
   uint8_t           td_offset;    /* Offset to the valid, pending bytes in the rxbuffer */
+#endif
   uint8_t           td_crefs;     /* The number of open references to the session */
   int               td_minor;     /* Minor device number */
 #ifdef CONFIG_TELNET_SUPPORT_NAWS
@@ -171,7 +188,11 @@ struct telnet_dev_s
 #endif
   struct pollfd     fds;
   FAR struct socket td_psock;     /* A clone of the internal socket structure */
+#ifdef CONFIG_NET_TCP_READAHEAD
+  FAR struct iob_s *td_rxiob;     /* Pending, received I/O buffer chain */
+#else
   char td_rxbuffer[CONFIG_TELNET_RXBUFFER_SIZE];
+#endif
   char td_txbuffer[CONFIG_TELNET_TXBUFFER_SIZE];
 };
 
@@ -404,6 +425,9 @@ static ssize_t telnet_receive(FAR struct telnet_dev_s *priv,
                               FAR const char *src, size_t srclen,
                               FAR char *dest, size_t destlen)
 {
+#ifdef CONFIG_NET_TCP_READAHEAD
+  FAR const char *start = src;
+#endif
   int nread;
   uint8_t ch;
 
@@ -592,6 +616,21 @@ static ssize_t telnet_receive(FAR struct telnet_dev_s *priv,
    * (2) if the user's buffer has become full.
    */
 
+#ifdef CONFIG_NET_TCP_READAHEAD
+  /* Release the processed bytes.  The remaining bytes will be returned the
+   * next time that telnet_read() is called.  iob_trimhead() leaves a single,
+   * empty I/O buffer behind when the whole chain is consumed.
+   */
+
+  priv->td_rxiob = iob_trimhead(priv->td_rxiob, src - start,
+                                IOBUSER_NET_TCP_READAHEAD);
+  if (priv->td_rxiob != NULL && priv->td_rxiob->io_pktlen == 0)
+    {
+      iob_free_chain(priv->td_rxiob, IOBUSER_NET_TCP_READAHEAD);
+      priv->td_rxiob = NULL;
+    }
+
+#else
   if (srclen > 0)
     {
       /* Remember where we left off.  These bytes will be returned the next
@@ -609,6 +648,7 @@ static ssize_t telnet_receive(FAR struct telnet_dev_s *priv,
       priv->td_offset  = 0;
     }
 
+#endif
   return nread;
 }
 
@@ -841,6 +881,15 @@ static int telnet_close(FAR struct file *filep)
 
       psock_close(&priv->td_psock);
 
+#ifdef CONFIG_NET_TCP_READAHEAD
+      /* Release any received data that was never read */
+
+      if (priv->td_rxiob != NULL)
+        {
+          iob_free_chain(priv->td_rxiob, IOBUSER_NET_TCP_READAHEAD);
+        }
+#endif
+
 #ifdef CONFIG_TERMCURSES
       if (priv->tcurs != NULL)
         {
@@ -892,7 +941,7 @@ static ssize_t telnet_read(FAR struct file *filep, FAR char *buffer,
     {
       FAR const char *src;
 
-      if (priv->td_pending == 0)
+      if (TELNET_PENDING(priv) == 0)
         {
           if (filep->f_oflags & O_NONBLOCK)
             {
@@ -921,8 +970,24 @@ static ssize_t telnet_read(FAR struct file *filep, FAR char *buffer,
 
       /* Process the buffered telnet data */
 
+#ifdef CONFIG_NET_TCP_READAHEAD
+      /* Only the first I/O buffer in the chain is processed on each pass */
+
+      if (priv->td_rxiob == NULL)
+        {
+          ret = 0;
+        }
+      else
+        {
+          src = (FAR const char *)&priv->td_rxiob->io_data[
+                                     priv->td_rxiob->io_offset];
+          ret = telnet_receive(priv, src, priv->td_rxiob->io_len,
+                               buffer, len);
+        }
+#else
       src = &priv->td_rxbuffer[priv->td_offset];
       ret = telnet_receive(priv, src, priv->td_pending, buffer, len);
+#endif
 
       nxsem_post(&priv->td_exclsem);
     }
@@ -1062,8 +1127,12 @@ static int telnet_session(FAR struct telnet_session_s *session)
 
   priv->td_state     = STATE_NORMAL;
   priv->td_crefs     = 0;
+#ifdef CONFIG_NET_TCP_READAHEAD
+  priv->td_rxiob     = NULL;
+#else
   priv->td_pending   = 0;
   priv->td_offset    = 0;
+#endif
 #ifdef HAVE_SIGNALS
   priv->pid          = -1;
 #endif
@@ -1262,7 +1331,7 @@ static int telnet_poll(FAR struct file *filep, FAR struct pollfd *fds,
 
   /* Test if we have cached data waiting to be read */
 
-  if (priv->td_pending > 0)
+  if (TELNET_PENDING(priv) > 0)
     {
       /* Yes.. then signal the poll logic */
 
@@ -1282,7 +1351,11 @@ static int telnet_poll(FAR struct file *filep, FAR struct pollfd *fds,
 static int telnet_io_main(int argc, FAR char** argv)
 {
   FAR struct telnet_dev_s *priv;
+#ifdef CONFIG_NET_TCP_READAHEAD
+  FAR struct iob_s *iob;
+#else
   FAR char *buffer;
+#endif
   int i;
 #ifdef HAVE_SIGNALS
   int c;
@@ -1304,6 +1377,7 @@ static int telnet_io_main(int argc, FAR char** argv)
               priv->fds.sem     = &g_iosem;
               priv->fds.events  = POLLIN | POLLHUP | POLLERR;
               priv->fds.revents = 0;
+              priv->fds.cb      = NULL;
 
               (void)psock_poll(&priv->td_psock, &priv->fds, TRUE);
             }
@@ -1329,6 +1403,56 @@ static int telnet_io_main(int argc, FAR char** argv)
               priv = g_telnet_clients[i];
               if (priv->fds.revents & POLLIN)
                 {
+#ifdef CONFIG_NET_TCP_READAHEAD
+                  if (TELNET_PENDING(priv) < CONFIG_TELNET_RXBUFFER_SIZE)
+                    {
+                      /* Take the read-ahead data from the socket without
+                       * copying it.
+                       */
+
+                      ret = psock_tcp_recviob(&priv->td_psock, &iob,
+                                              MSG_DONTWAIT);
+                      if (ret > 0)
+                        {
+#ifdef HAVE_SIGNALS
+                          FAR struct iob_s *seg;
+
+                          /* Check if any of the received characters is a
+                           * control that should generate a signal.
+                           */
+
+                          for (seg = iob; seg != NULL; seg = seg->io_flink)
+                            {
+                              for (c = 0; c < seg->io_len; c++)
+                                {
+                                  telnet_check_ctrl_char(priv,
+                                    seg->io_data[seg->io_offset + c]);
+                                }
+                            }
+#endif
+
+                          /* Take exclusive access to the pending data and
+                           * append the new chain.
+                           */
+
+                          nxsem_wait(&priv->td_exclsem);
+                          if (priv->td_rxiob == NULL)
+                            {
+                              priv->td_rxiob = iob;
+                            }
+                          else
+                            {
+                              iob_concat(priv->td_rxiob, iob);
+                            }
+
+                          nxsem_post(&priv->td_exclsem);
+                        }
+
+                      /* Notify the client thread that data is available */
+
+                      nxsem_post(&priv->td_iosem);
+                    }
+#else
                   if (priv->td_pending < CONFIG_TELNET_RXBUFFER_SIZE)
                     {
                       /* Take exclusive access to data buffer */
@@ -1360,6 +1484,7 @@ static int telnet_io_main(int argc, FAR char** argv)
                         }
 #endif
                     }
+#endif
                 }
 
               /* If poll was setup previously (events != 0), tear it down */
@@ -145,7 +145,7 @@ static void pipecommon_pollnotify(FAR struct pipe_dev_s *dev,
           if (fds->revents != 0)
             {
               finfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(&fds, 1, 0);
             }
         }
     }
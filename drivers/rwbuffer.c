@@ -67,18 +67,45 @@
 #  define CONFIG_DRVR_WRDELAY 350
 #endif
 
-#if !defined(CONFIG_SCHED_WORKQUEUE) && CONFIG_DRVR_WRDELAY != 0
+#if defined(CONFIG_DRVR_WRITEBUFFER) && !defined(CONFIG_SCHED_WORKQUEUE) && \
+    CONFIG_DRVR_WRDELAY != 0
 #  error "Worker thread support is required (CONFIG_SCHED_WORKQUEUE)"
 #endif
 
+#ifndef CONFIG_DRVR_WRDIRTY
+#  define CONFIG_DRVR_WRDIRTY 75
+#endif
+
+/* Helpers ******************************************************************/
+
+/* The address of write buffer slot 'n'.  The slot following the last one
+ * is used as scratch space when sorting the buffer.
+ */
+
+#define RWB_WRSLOT(r,n) (&(r)->wrbuffer[(size_t)(n) * (r)->blocksize])
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_READAHEAD
+static int rwb_rhdiscard(FAR struct rwbuffer_s *rwb, off_t startblock,
+                         size_t nblocks);
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
+/* A list of all initialized buffers for rwb_foreach() */
+
+static FAR struct rwbuffer_s *g_rwbuffers;
+static sem_t g_rwbsem = SEM_INITIALIZER(1);
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -120,6 +147,7 @@ static void rwb_semtake(sem_t *sem)
  * Name: rwb_overlap
  ****************************************************************************/
 
+#ifdef CONFIG_DRVR_READAHEAD
 static inline bool rwb_overlap(off_t blockstart1, size_t nblocks1,
                                off_t blockstart2, size_t nblocks2)
 {
@@ -138,6 +166,7 @@ static inline bool rwb_overlap(off_t blockstart1, size_t nblocks1,
       return true;
     }
 }
+#endif
 
 /****************************************************************************
  * Name: rwb_resetwrbuffer
@@ -148,43 +177,174 @@ static inline void rwb_resetwrbuffer(struct rwbuffer_s *rwb)
 {
   /* We assume that the caller holds the wrsem */
 
-  rwb->wrnblocks       = 0;
-  rwb->wrblockstart    = (off_t)-1;
-  rwb->wrexpectedblock = (off_t)-1;
+  rwb->wrnblocks = 0;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wrfind
+ *
+ * Description:
+ *   Return the write buffer slot that holds 'block' or -1 if the block is
+ *   not buffered.  The most recently added slots are searched first.
+ *
+ * Assumptions:
+ *   The caller holds the wrsem semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static int rwb_wrfind(FAR struct rwbuffer_s *rwb, off_t block)
+{
+  int slot;
+
+  for (slot = rwb->wrnblocks - 1; slot >= 0; slot--)
+    {
+      if (rwb->wrblocks[slot] == block)
+        {
+          break;
+        }
+    }
+
+  return slot;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wrsort
+ *
+ * Description:
+ *   Sort the write buffer slots by block number so that consecutive blocks
+ *   are also adjacent in memory.  The slot indices are sorted first and
+ *   then the data is moved along each cycle of the resulting permutation,
+ *   so that every block is copied at most once (plus once per cycle).
+ *
+ * Assumptions:
+ *   The caller holds the wrsem semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static void rwb_wrsort(FAR struct rwbuffer_s *rwb)
+{
+  FAR uint16_t *order = rwb->wrorder;
+  FAR uint8_t *scratch = RWB_WRSLOT(rwb, rwb->wrmaxblocks);
+  off_t block;
+  uint16_t tmp;
+  uint16_t i;
+  uint16_t j;
+  uint16_t k;
+
+  /* Insertion sort of the slot indices.  Writes are usually (nearly)
+   * sequential, so this is close to linear in practice.
+   */
+
+  for (i = 0; i < rwb->wrnblocks; i++)
+    {
+      tmp   = i;
+      block = rwb->wrblocks[i];
+      for (j = i; j > 0 && rwb->wrblocks[order[j - 1]] > block; j--)
+        {
+          order[j] = order[j - 1];
+        }
+
+      order[j] = tmp;
+    }
+
+  /* Now slot j must receive the content of slot order[j] */
+
+  for (i = 0; i < rwb->wrnblocks; i++)
+    {
+      if (order[i] == i)
+        {
+          continue;
+        }
+
+      memcpy(scratch, RWB_WRSLOT(rwb, i), rwb->blocksize);
+      block = rwb->wrblocks[i];
+
+      for (j = i; ; j = k)
+        {
+          k        = order[j];
+          order[j] = j;
+
+          if (k == i)
+            {
+              memcpy(RWB_WRSLOT(rwb, j), scratch, rwb->blocksize);
+              rwb->wrblocks[j] = block;
+              break;
+            }
+
+          memcpy(RWB_WRSLOT(rwb, j), RWB_WRSLOT(rwb, k), rwb->blocksize);
+          rwb->wrblocks[j] = rwb->wrblocks[k];
+        }
+    }
 }
 #endif
 
 /****************************************************************************
  * Name: rwb_wrflush
  *
+ * Description:
+ *   Write all buffered blocks to the media.  Each run of consecutive
+ *   blocks is written with one call to the flush callout.
+ *
  * Assumptions:
  *   The caller holds the wrsem semaphore.
  *
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
-static void rwb_wrflush(struct rwbuffer_s *rwb)
+static int rwb_wrflush(struct rwbuffer_s *rwb)
 {
+  uint16_t start;
+  uint16_t end;
+  int result = OK;
   int ret;
 
   if (rwb->wrnblocks > 0)
     {
-      finfo("Flushing: blockstart=0x%08lx nblocks=%d from buffer=%p\n",
-      (long)rwb->wrblockstart, rwb->wrnblocks, rwb->wrbuffer);
+      rwb_wrsort(rwb);
 
-      /* Flush cache.  On success, the flush method will return the number
-       * of blocks written.  Anything other than the number requested is
-       * an error.
-       */
-
-      ret = rwb->wrflush(rwb->dev, rwb->wrbuffer, rwb->wrblockstart, rwb->wrnblocks);
-      if (ret != rwb->wrnblocks)
+      for (start = 0; start < rwb->wrnblocks; start = end)
         {
-          ferr("ERROR: Error flushing write buffer: %d\n", ret);
+          for (end = start + 1;
+               end < rwb->wrnblocks &&
+               rwb->wrblocks[end] == rwb->wrblocks[end - 1] + 1;
+               end++);
+
+          finfo("Flushing: blockstart=0x%08lx nblocks=%d\n",
+                (long)rwb->wrblocks[start], end - start);
+
+          /* On success, the flush method will return the number of blocks
+           * written.  Anything other than the number requested is an
+           * error.
+           */
+
+          ret = rwb->wrflush(rwb->dev, RWB_WRSLOT(rwb, start),
+                             rwb->wrblocks[start], end - start);
+          rwb->nflush++;
+
+#ifdef CONFIG_DRVR_READAHEAD
+          /* The read-ahead buffer may have been loaded with the older
+           * content of these blocks from the media while they were
+           * buffered here.
+           */
+
+          (void)rwb_rhdiscard(rwb, rwb->wrblocks[start], end - start);
+#endif
+
+          if (ret != end - start)
+            {
+              ferr("ERROR: Error flushing write buffer: %d\n", ret);
+              result = ret < 0 ? ret : -EIO;
+            }
         }
 
       rwb_resetwrbuffer(rwb);
     }
+
+  return result;
 }
 #endif
 
@@ -202,19 +362,25 @@ static void rwb_wrtimeout(FAR void *arg)
 
   finfo("Timeout!\n");
 
-  /* If a timeout elapses with with write buffer activity, this watchdog
-   * handler function will be evoked on the thread of execution of the
-   * worker thread.
+  /* If a timeout elapses with with write buffer activity or the dirty
+   * threshold has been reached, this function will be evoked on the thread
+   * of execution of the worker thread.
    */
 
   rwb_semtake(&rwb->wrsem);
-  rwb_wrflush(rwb);
+  (void)rwb_wrflush(rwb);
   rwb_semgive(&rwb->wrsem);
 }
 #endif
 
 /****************************************************************************
  * Name: rwb_wrstarttimeout
+ *
+ * Description:
+ *   Schedule the write buffer to be flushed by the low priority worker:
+ *   Immediately if the dirty threshold has been reached, otherwise after
+ *   CONFIG_DRVR_WRDELAY milliseconds without write activity.
+ *
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
@@ -226,6 +392,13 @@ static void rwb_wrstarttimeout(FAR struct rwbuffer_s *rwb)
    */
 
   int ticks = MSEC2TICK(CONFIG_DRVR_WRDELAY);
+
+  if ((uint32_t)rwb->wrnblocks * 100 >=
+      (uint32_t)rwb->wrmaxblocks * CONFIG_DRVR_WRDIRTY)
+    {
+      ticks = 0;
+    }
+
   (void)work_queue(LPWORK, &rwb->work, rwb_wrtimeout, (FAR void *)rwb, ticks);
 #endif
 }
@@ -246,6 +419,10 @@ static inline void rwb_wrcanceltimeout(struct rwbuffer_s *rwb)
 
 /****************************************************************************
  * Name: rwb_writebuffer
+ *
+ * Assumptions:
+ *   The caller holds the wrsem semaphore.
+ *
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
@@ -253,53 +430,49 @@ static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
                                off_t startblock, uint32_t nblocks,
                                FAR const uint8_t *wrbuffer)
 {
+  uint32_t i;
+  int slot;
   int ret;
 
   /* Write writebuffer Logic */
 
   rwb_wrcanceltimeout(rwb);
 
-  /* First: Should we flush out our cache? We would do that if (1) we already
-   * buffering blocks and the next block writing is not in the same sequence,
-   * or (2) the number of blocks would exceed our allocated buffer capacity
-   */
-
-  if (((startblock != rwb->wrexpectedblock) && (rwb->wrnblocks)) ||
-      ((rwb->wrnblocks + nblocks) > rwb->wrmaxblocks))
+  for (i = 0; i < nblocks; i++)
     {
-      finfo("writebuffer miss, expected: %08x, given: %08x\n",
-            rwb->wrexpectedblock, startblock);
-
-      /* Flush the write buffer */
+      /* Is the block already buffered?  Then just replace its data. */
 
-      ret = rwb->wrflush(rwb->dev, rwb->wrbuffer, rwb->wrblockstart, rwb->wrnblocks);
-      if (ret < 0)
+      slot = rwb_wrfind(rwb, startblock + i);
+      if (slot >= 0)
         {
-          ferr("ERROR: Error writing multiple from cache: %d\n", -ret);
-          return ret;
+          rwb->wrhits++;
         }
+      else
+        {
+          /* Flush the write buffer if it is full */
 
-      rwb_resetwrbuffer(rwb);
-    }
-
-  /* writebuffer is empty? Then initialize it */
+          if (rwb->wrnblocks >= rwb->wrmaxblocks)
+            {
+              finfo("writebuffer full, flushing\n");
 
-  if (rwb->wrnblocks == 0)
-    {
-      finfo("Fresh cache starting at block: 0x%08x\n", startblock);
-      rwb->wrblockstart = startblock;
-    }
+              ret = rwb_wrflush(rwb);
+              if (ret < 0)
+                {
+                  ferr("ERROR: Error writing multiple from cache: %d\n",
+                       -ret);
+                  return ret;
+                }
+            }
 
-  /* Add data to cache */
+          slot = rwb->wrnblocks++;
+          rwb->wrblocks[slot] = startblock + i;
+          rwb->wrmisses++;
+        }
 
-  finfo("writebuffer: copying %d bytes from %p to %p\n",
-        nblocks * rwb->blocksize, wrbuffer,
-        &rwb->wrbuffer[rwb->wrnblocks * rwb->blocksize]);
-  memcpy(&rwb->wrbuffer[rwb->wrnblocks * rwb->blocksize],
-         wrbuffer, nblocks * rwb->blocksize);
+      memcpy(RWB_WRSLOT(rwb, slot), wrbuffer, rwb->blocksize);
+      wrbuffer += rwb->blocksize;
+    }
 
-  rwb->wrnblocks      += nblocks;
-  rwb->wrexpectedblock = rwb->wrblockstart + rwb->wrnblocks;
   rwb_wrstarttimeout(rwb);
   return nblocks;
 }
@@ -358,10 +531,10 @@ rwb_bufferread(struct rwbuffer_s *rwb,  off_t startblock,
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_READAHEAD
-static int rwb_rhreload(struct rwbuffer_s *rwb, off_t startblock)
+static int rwb_rhreload(struct rwbuffer_s *rwb, off_t startblock,
+                        size_t nblocks)
 {
   off_t  endblock;
-  size_t nblocks;
   int    ret;
 
   /* Check for attempts to read beyond the end of the media */
@@ -371,11 +544,9 @@ static int rwb_rhreload(struct rwbuffer_s *rwb, off_t startblock)
       return -ESPIPE;
     }
 
-  /* Get the block number +1 of the last block that will fit in the
-   * read-ahead buffer
-   */
+  /* Get the block number +1 of the last block that will be read */
 
-  endblock = startblock + rwb->rhmaxblocks;
+  endblock = startblock + nblocks;
 
   /* Make sure that we don't read past the end of the device */
 
@@ -413,137 +584,52 @@ static int rwb_rhreload(struct rwbuffer_s *rwb, off_t startblock)
  * Name: rwb_invalidate_writebuffer
  *
  * Description:
- *   Invalidate a region of the write buffer
+ *   Discard the buffered blocks in a region of the write buffer
  *
  ****************************************************************************/
 
 #if defined(CONFIG_DRVR_WRITEBUFFER) && defined(CONFIG_DRVR_INVALIDATE)
-int rwb_invalidate_writebuffer(FAR struct rwbuffer_s *rwb,
-                               off_t startblock, size_t blockcount)
+static int rwb_invalidate_writebuffer(FAR struct rwbuffer_s *rwb,
+                                      off_t startblock, size_t blockcount)
 {
-  int ret = OK;
+  off_t invend;
+  int slot;
+  int last;
 
   /* Is there a write buffer?  Is data saved in the write buffer? */
 
   if (rwb->wrmaxblocks > 0 && rwb->wrnblocks > 0)
     {
-      off_t wrbend;
-      off_t invend;
-
       finfo("startblock=%d blockcount=%p\n", startblock, blockcount);
 
       rwb_semtake(&rwb->wrsem);
 
-      /* Now there are five cases:
-       *
-       * 1. We invalidate nothing
-       */
+      /* Replace each invalidated slot with the last slot in use */
 
-      wrbend = rwb->wrblockstart + rwb->wrnblocks;
       invend = startblock + blockcount;
-
-      if (rwb->wrblockstart > invend || wrbend < startblock)
-        {
-          ret = OK;
-        }
-
-      /* 2. We invalidate the entire write buffer. */
-
-      else if (rwb->wrblockstart >= startblock && wrbend <= invend)
-        {
-          rwb->wrnblocks = 0;
-          ret = OK;
-        }
-
-      /* We are going to invalidate a subset of the write buffer.  Three
-       * more cases to consider:
-       *
-       * 2. We invalidate a portion in the middle of the write buffer
-       */
-
-      else if (rwb->wrblockstart < startblock && wrbend > invend)
+      for (slot = 0; slot < rwb->wrnblocks; )
         {
-          uint8_t *src;
-          off_t    block;
-          off_t    offset;
-          size_t   nblocks;
-
-          /* Write the blocks at the end of the media to hardware */
-
-          nblocks = wrbend - invend;
-          block   = invend;
-          offset  = block - rwb->wrblockstart;
-          src     = rwb->wrbuffer + offset * rwb->blocksize;
-
-          ret = rwb->wrflush(rwb->dev, src, block, nblocks);
-          if (ret < 0)
+          if (rwb->wrblocks[slot] >= startblock &&
+              rwb->wrblocks[slot] < invend)
             {
-              ferr("ERROR: wrflush failed: %d\n", ret);
+              last = --rwb->wrnblocks;
+              if (slot != last)
+                {
+                  memcpy(RWB_WRSLOT(rwb, slot), RWB_WRSLOT(rwb, last),
+                         rwb->blocksize);
+                  rwb->wrblocks[slot] = rwb->wrblocks[last];
+                }
             }
-
-          /* Keep the blocks at the beginning of the buffer up the
-           * start of the invalidated region.
-           */
           else
             {
-              rwb->wrnblocks = startblock - rwb->wrblockstart;
-              ret = OK;
+              slot++;
             }
         }
 
-      /* 3. We invalidate a portion at the end of the write buffer */
-
-      else if (wrbend > startblock && wrbend <= invend)
-        {
-          rwb->wrnblocks = wrbend - startblock;
-          ret = OK;
-        }
-
-      /* 4. We invalidate a portion at the beginning of the write buffer */
-
-      else /* if (rwb->wrblockstart >= startblock && wrbend > invend) */
-        {
-          uint8_t *src;
-          size_t   ninval;
-          size_t   nkeep;
-
-          DEBUGASSERT(rwb->wrblockstart >= startblock && wrbend > invend);
-
-          /* Copy the data from the uninvalidated region to the beginning
-           * of the write buffer.
-           *
-           * First calculate the source and destination of the transfer.
-           */
-
-          ninval = invend - rwb->wrblockstart;
-          src    = rwb->wrbuffer + ninval * rwb->blocksize;
-
-          /* Calculate the number of blocks we are keeping.  We keep
-           * the ones that we don't invalidate.
-           */
-
-          nkeep  = rwb->wrnblocks - ninval;
-
-          /* Then move the data that we are keeping to the beginning
-           * the write buffer.
-           */
-
-          memcpy(rwb->wrbuffer, src, nkeep * rwb->blocksize);
-
-          /* Update the block info.  The first block is now the one just
-           * after the invalidation region and the number buffered blocks
-           * is the number that we kept.
-           */
-
-          rwb->wrblockstart = invend;
-          rwb->wrnblocks    = nkeep;
-          ret = OK;
-        }
-
       rwb_semgive(&rwb->wrsem);
     }
 
-  return ret;
+  return OK;
 }
 #endif
 
@@ -556,10 +642,10 @@ int rwb_invalidate_writebuffer(FAR struct rwbuffer_s *rwb,
  ****************************************************************************/
 
 #if defined(CONFIG_DRVR_READAHEAD)  && defined(CONFIG_DRVR_INVALIDATE)
-int rwb_invalidate_readahead(FAR struct rwbuffer_s *rwb,
-                               off_t startblock, size_t blockcount)
+static int rwb_invalidate_readahead(FAR struct rwbuffer_s *rwb,
+                                    off_t startblock, size_t blockcount)
 {
-  int ret;
+  int ret = OK;
 
   if (rwb->rhmaxblocks > 0 && rwb->rhnblocks > 0)
     {
@@ -611,7 +697,7 @@ int rwb_invalidate_readahead(FAR struct rwbuffer_s *rwb,
 
       else if (rhbend > startblock && rhbend <= invend)
         {
-          rwb->rhnblocks = rhbend - startblock;
+          rwb->rhnblocks = startblock - rwb->rhblockstart;
           ret = OK;
         }
 
@@ -661,6 +747,51 @@ int rwb_invalidate_readahead(FAR struct rwbuffer_s *rwb,
 }
 #endif
 
+/****************************************************************************
+ * Name: rwb_rhdiscard
+ *
+ * Description:
+ *   Drop blocks that are about to be written from the read-ahead buffer.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_READAHEAD
+static int rwb_rhdiscard(FAR struct rwbuffer_s *rwb, off_t startblock,
+                         size_t nblocks)
+{
+  int ret = OK;
+
+  if (rwb->rhmaxblocks > 0)
+    {
+      /* If the new write data overlaps any part of the read buffer, then
+       * flush the data from the read buffer.  We could attempt some more
+       * exotic handling -- but this simple logic is well-suited for simple
+       * streaming applications.
+       */
+
+#ifdef CONFIG_DRVR_INVALIDATE
+      /* Just invalidate the read buffer startblock + nblocks data */
+
+      ret = rwb_invalidate_readahead(rwb, startblock, nblocks);
+      if (ret < 0)
+        {
+          ferr("ERROR: rwb_invalidate_readahead failed: %d\n", ret);
+        }
+#else
+      rwb_semtake(&rwb->rhsem);
+      if (rwb_overlap(rwb->rhblockstart, rwb->rhnblocks, startblock, nblocks))
+        {
+          rwb_resetrhbuffer(rwb);
+        }
+
+      rwb_semgive(&rwb->rhsem);
+#endif
+    }
+
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -684,12 +815,20 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
 #ifdef CONFIG_DRVR_WRITEBUFFER
   DEBUGASSERT(rwb->wrflush != NULL);
   rwb->wrbuffer = NULL;
+  rwb->wrblocks = NULL;
+  rwb->wrorder  = NULL;
 #endif
 #ifdef CONFIG_DRVR_READAHEAD
   DEBUGASSERT(rwb->rhreload != NULL);
   rwb->rhbuffer = NULL;
 #endif
 
+  rwb->rdhits   = 0;
+  rwb->rdmisses = 0;
+  rwb->wrhits   = 0;
+  rwb->wrmisses = 0;
+  rwb->nflush   = 0;
+
 #ifdef CONFIG_DRVR_WRITEBUFFER
   if (rwb->wrmaxblocks > 0)
     {
@@ -703,18 +842,21 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
 
       rwb_resetwrbuffer(rwb);
 
-      /* Allocate the write buffer */
+      /* Allocate the write buffer with one extra block of scratch space for
+       * sorting, and the block number and sort order of each slot.
+       */
+
+      allocsize     = (rwb->wrmaxblocks + 1) * rwb->blocksize;
+      rwb->wrbuffer = kmm_malloc(allocsize);
+      rwb->wrblocks = (FAR off_t *)
+        kmm_malloc(rwb->wrmaxblocks * sizeof(off_t));
+      rwb->wrorder  = (FAR uint16_t *)
+        kmm_malloc(rwb->wrmaxblocks * sizeof(uint16_t));
 
-      rwb->wrbuffer = NULL;
-      if (rwb->wrmaxblocks > 0)
+      if (!rwb->wrbuffer || !rwb->wrblocks || !rwb->wrorder)
         {
-          allocsize     = rwb->wrmaxblocks * rwb->blocksize;
-          rwb->wrbuffer = kmm_malloc(allocsize);
-          if (!rwb->wrbuffer)
-            {
-              ferr("Write buffer kmm_malloc(%d) failed\n", allocsize);
-              return -ENOMEM;
-            }
+          ferr("Write buffer kmm_malloc(%d) failed\n", allocsize);
+          goto errout_with_wrbuffer;
         }
 
       finfo("Write buffer size: %d bytes\n", allocsize);
@@ -733,6 +875,8 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
       /* Initialize read-ahead buffer parameters */
 
       rwb_resetrhbuffer(rwb);
+      rwb->rhwindow   = 0;
+      rwb->rhexpected = (off_t)-1;
 
       /* Allocate the read-ahead buffer */
 
@@ -744,7 +888,8 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
           if (!rwb->rhbuffer)
             {
               ferr("Read-ahead buffer kmm_malloc(%d) failed\n", allocsize);
-              return -ENOMEM;
+              nxsem_destroy(&rwb->rhsem);
+              goto errout_with_wrbuffer;
             }
         }
 
@@ -752,7 +897,41 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
     }
 #endif /* CONFIG_DRVR_READAHEAD */
 
+  /* Add the buffer to the list reported by rwb_foreach() */
+
+  rwb_semtake(&g_rwbsem);
+  rwb->flink  = g_rwbuffers;
+  g_rwbuffers = rwb;
+  rwb_semgive(&g_rwbsem);
+
   return OK;
+
+errout_with_wrbuffer:
+#ifdef CONFIG_DRVR_WRITEBUFFER
+  if (rwb->wrmaxblocks > 0)
+    {
+      nxsem_destroy(&rwb->wrsem);
+      if (rwb->wrbuffer)
+        {
+          kmm_free(rwb->wrbuffer);
+          rwb->wrbuffer = NULL;
+        }
+
+      if (rwb->wrblocks)
+        {
+          kmm_free(rwb->wrblocks);
+          rwb->wrblocks = NULL;
+        }
+
+      if (rwb->wrorder)
+        {
+          kmm_free(rwb->wrorder);
+          rwb->wrorder = NULL;
+        }
+    }
+#endif
+
+  return -ENOMEM;
 }
 
 /****************************************************************************
@@ -761,6 +940,30 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
 
 void rwb_uninitialize(FAR struct rwbuffer_s *rwb)
 {
+  FAR struct rwbuffer_s *prev;
+  FAR struct rwbuffer_s *curr;
+
+  /* Remove the buffer from the list, if it was added */
+
+  rwb_semtake(&g_rwbsem);
+  for (prev = NULL, curr = g_rwbuffers;
+       curr != NULL && curr != rwb;
+       prev = curr, curr = curr->flink);
+
+  if (curr != NULL)
+    {
+      if (prev != NULL)
+        {
+          prev->flink = rwb->flink;
+        }
+      else
+        {
+          g_rwbuffers = rwb->flink;
+        }
+    }
+
+  rwb_semgive(&g_rwbsem);
+
 #ifdef CONFIG_DRVR_WRITEBUFFER
   if (rwb->wrmaxblocks > 0)
     {
@@ -769,6 +972,19 @@ void rwb_uninitialize(FAR struct rwbuffer_s *rwb)
       if (rwb->wrbuffer)
         {
           kmm_free(rwb->wrbuffer);
+          rwb->wrbuffer = NULL;
+        }
+
+      if (rwb->wrblocks)
+        {
+          kmm_free(rwb->wrblocks);
+          rwb->wrblocks = NULL;
+        }
+
+      if (rwb->wrorder)
+        {
+          kmm_free(rwb->wrorder);
+          rwb->wrorder = NULL;
         }
     }
 #endif
@@ -780,6 +996,7 @@ void rwb_uninitialize(FAR struct rwbuffer_s *rwb)
       if (rwb->rhbuffer)
         {
           kmm_free(rwb->rhbuffer);
+          rwb->rhbuffer = NULL;
         }
     }
 #endif
@@ -798,6 +1015,9 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
   if (rwb->rhmaxblocks > 0)
     {
       size_t remaining;
+      size_t rdblocks;
+      size_t window;
+      bool sequential;
 
       /* Loop until we have read all of the requested blocks */
 
@@ -815,7 +1035,7 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
               bufferend = rwb->rhblockstart + rwb->rhnblocks;
               if (startblock >= rwb->rhblockstart && startblock < bufferend)
                 {
-                  size_t rdblocks = bufferend - startblock;
+                  rdblocks = bufferend - startblock;
                   if (rdblocks > remaining)
                     {
                       rdblocks = remaining;
@@ -824,27 +1044,84 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
                   /* Then read the data from the read-ahead buffer */
 
                   rwb_bufferread(rwb, startblock, rdblocks, &rdbuffer);
-                  startblock += rdblocks;
-                  remaining  -= rdblocks;
+                  startblock   += rdblocks;
+                  remaining    -= rdblocks;
+                  rwb->rdhits  += rdblocks;
+                  continue;
                 }
             }
 
-          /* If we did not get all of the data from the buffer, then we have
-           * to refill the buffer and try again.
+          /* A request at least as large as the read-ahead buffer is read
+           * directly into the caller's buffer.
            */
 
-          if (remaining > 0)
+          if (remaining >= rwb->rhmaxblocks)
             {
-              ret = rwb_rhreload(rwb, startblock);
-              if (ret < 0)
+              ret = rwb->rhreload(rwb->dev, rdbuffer, startblock, remaining);
+              if (ret != (int)remaining)
                 {
-                  ferr("ERROR: Failed to fill the read-ahead buffer: %d\n", ret);
+                  if (ret >= 0)
+                    {
+                      ret = -EIO;
+                    }
+
+                  ferr("ERROR: Failed to read %d blocks: %d\n",
+                       (int)remaining, ret);
                   rwb_semgive(&rwb->rhsem);
                   return (ssize_t)ret;
                 }
+
+              rwb->rdmisses += remaining;
+              startblock    += remaining;
+              remaining      = 0;
+              break;
+            }
+
+          /* Double the read-ahead window while the reads are sequential
+           * (i.e., continue where the previous read or the buffer ended).
+           * Otherwise, read only what was requested.
+           */
+
+          sequential = (startblock == rwb->rhexpected ||
+                        (rwb->rhnblocks > 0 &&
+                         startblock == rwb->rhblockstart + rwb->rhnblocks));
+
+          window = remaining;
+          if (sequential)
+            {
+              if (window < rwb->rhwindow)
+                {
+                  window = rwb->rhwindow;
+                }
+
+              window <<= 1;
+              if (window > rwb->rhmaxblocks)
+                {
+                  window = rwb->rhmaxblocks;
+                }
+            }
+
+          rwb->rhwindow = window;
+
+          /* Refill the buffer and take what we need from it */
+
+          ret = rwb_rhreload(rwb, startblock, window);
+          if (ret < 0)
+            {
+              ferr("ERROR: Failed to fill the read-ahead buffer: %d\n", ret);
+              rwb_semgive(&rwb->rhsem);
+              return (ssize_t)ret;
             }
+
+          rdblocks = (size_t)ret < remaining ? (size_t)ret : remaining;
+          rwb_bufferread(rwb, startblock, rdblocks, &rdbuffer);
+          startblock    += rdblocks;
+          remaining     -= rdblocks;
+          rwb->rdmisses += rdblocks;
         }
 
+      rwb->rhexpected = startblock;
+
       /* On success, return the number of blocks that we were requested to
        * read. This is for compatibility with the normal return of a block
        * driver read method
@@ -861,6 +1138,10 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
        */
 
       ret = rwb->rhreload(rwb->dev, rdbuffer, startblock, nblocks);
+      if (ret > 0)
+        {
+          rwb->rdmisses += ret;
+        }
     }
 
   return (ssize_t)ret;
@@ -873,70 +1154,74 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
 ssize_t rwb_read(FAR struct rwbuffer_s *rwb, off_t startblock,
                  size_t nblocks, FAR uint8_t *rdbuffer)
 {
-  int ret = OK;
-  size_t readblocks = 0;
-
   finfo("startblock=%ld nblocks=%ld rdbuffer=%p\n",
         (long)startblock, (long)nblocks, rdbuffer);
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
-  /* If the new read data overlaps any part of the write buffer, we
-   * directly copy write buffer to read buffer. This boost performance.
+  /* Blocks that are in the write buffer are newer than those on the media.
+   * If any of the requested blocks are buffered, the write buffer stays
+   * locked across the media read so that those blocks cannot be flushed
+   * (and dropped from the buffer) before they are copied.  Writers to the
+   * device are then delayed for the duration of the read.  That is the
+   * price of returning the newest data without re-checking the buffer
+   * after the read.  If none of the blocks are buffered, the lock is
+   * released before the media is read.
    */
 
   if (rwb->wrmaxblocks > 0)
     {
-      /* If the write buffer overlaps the block(s) requested */
+      size_t nhits = 0;
+      ssize_t ret;
+      int slot;
 
       rwb_semtake(&rwb->wrsem);
-      if (rwb_overlap(rwb->wrblockstart, rwb->wrnblocks, startblock, nblocks))
+      for (slot = 0; slot < rwb->wrnblocks; slot++)
         {
-          size_t rdblocks = 0;
-          size_t wrnpass  = 0;
-
-          if (rwb->wrblockstart > startblock)
+          if (rwb->wrblocks[slot] >= startblock &&
+              rwb->wrblocks[slot] < startblock + (off_t)nblocks)
             {
-              rdblocks = rwb->wrblockstart - startblock;
-              ret = rwb_read_(rwb, startblock, rdblocks, rdbuffer);
-              if (ret < 0)
-                {
-                  rwb_semgive(&rwb->wrsem);
-                  return (ssize_t)ret;
-                }
-
-              startblock += ret;
-              nblocks    -= ret;
-              rdbuffer   += ret * rwb->blocksize;
-              readblocks += ret;
+              nhits++;
             }
+        }
+
+      if (nhits == 0)
+        {
+          rwb_semgive(&rwb->wrsem);
+          return rwb_read_(rwb, startblock, nblocks, rdbuffer);
+        }
+
+      /* Read from the media unless every block is in the write buffer */
 
-          if (rwb->wrblockstart < startblock)
+      if (nhits < nblocks)
+        {
+          ret = rwb_read_(rwb, startblock, nblocks, rdbuffer);
+          if (ret < 0)
             {
-              wrnpass = startblock - rwb->wrblockstart;
+              rwb_semgive(&rwb->wrsem);
+              return ret;
             }
+        }
 
-          rdblocks = nblocks > (rwb->wrnblocks - wrnpass) ?
-                    (rwb->wrnblocks - wrnpass) : nblocks;
-          memcpy(rdbuffer, &rwb->wrbuffer[wrnpass * rwb->blocksize],
-                rdblocks * rwb->blocksize);
+      /* Then replace the buffered blocks with their newer content */
 
-          startblock += rdblocks;
-          nblocks    -= rdblocks;
-          rdbuffer   += rdblocks * rwb->blocksize;
-          readblocks += rdblocks;
+      for (slot = 0; nhits > 0 && slot < rwb->wrnblocks; slot++)
+        {
+          off_t offset = rwb->wrblocks[slot] - startblock;
+
+          if (offset >= 0 && offset < (off_t)nblocks)
+            {
+              memcpy(&rdbuffer[offset * rwb->blocksize],
+                     RWB_WRSLOT(rwb, slot), rwb->blocksize);
+              rwb->rdhits++;
+            }
         }
 
       rwb_semgive(&rwb->wrsem);
+      return nblocks;
     }
 #endif
 
-  ret = rwb_read_(rwb, startblock, nblocks, rdbuffer);
-  if (ret < 0)
-    {
-      return ret;
-    }
-
-  return readblocks + ret;
+  return rwb_read_(rwb, startblock, nblocks, rdbuffer);
 }
 
 /****************************************************************************
@@ -949,33 +1234,10 @@ ssize_t rwb_write(FAR struct rwbuffer_s *rwb, off_t startblock,
   int ret = OK;
 
 #ifdef CONFIG_DRVR_READAHEAD
-  if (rwb->rhmaxblocks > 0)
+  ret = rwb_rhdiscard(rwb, startblock, nblocks);
+  if (ret < 0)
     {
-      /* If the new write data overlaps any part of the read buffer, then
-       * flush the data from the read buffer.  We could attempt some more
-       * exotic handling -- but this simple logic is well-suited for simple
-       * streaming applications.
-       */
-
-      rwb_semtake(&rwb->rhsem);
-      if (rwb_overlap(rwb->rhblockstart, rwb->rhnblocks, startblock, nblocks))
-        {
-#ifdef CONFIG_DRVR_INVALIDATE
-          /* Just invalidate the read buffer startblock + nblocks data */
-
-          ret = rwb_invalidate_readahead(rwb, startblock, nblocks);
-          if (ret < 0)
-            {
-              ferr("ERROR: rwb_invalidate_readahead failed: %d\n", ret);
-              rwb_semgive(&rwb->rhsem);
-              return (ssize_t)ret;
-            }
-#else
-          rwb_resetrhbuffer(rwb);
-#endif
-        }
-
-      rwb_semgive(&rwb->rhsem);
+      return (ssize_t)ret;
     }
 #endif
 
@@ -988,15 +1250,19 @@ ssize_t rwb_write(FAR struct rwbuffer_s *rwb, off_t startblock,
 
       if (nblocks > rwb->wrmaxblocks)
         {
-          /* First flush the cache */
+          /* First flush the cache so that no buffered block can later
+           * overwrite the new data.
+           */
 
           rwb_semtake(&rwb->wrsem);
-          rwb_wrflush(rwb);
-          rwb_semgive(&rwb->wrsem);
+          rwb_wrcanceltimeout(rwb);
+          (void)rwb_wrflush(rwb);
 
           /* Then transfer the data directly to the media */
 
           ret = rwb->wrflush(rwb->dev, wrbuffer, startblock, nblocks);
+          rwb->nflush++;
+          rwb_semgive(&rwb->wrsem);
         }
       else
         {
@@ -1020,11 +1286,11 @@ ssize_t rwb_write(FAR struct rwbuffer_s *rwb, off_t startblock,
        */
 
       ret = rwb->wrflush(rwb->dev, wrbuffer, startblock, nblocks);
+      rwb->nflush++;
     }
 
   return (ssize_t)ret;
 }
-
 /****************************************************************************
  * Name: rwb_readbytes
  *
@@ -1134,14 +1400,69 @@ int rwb_invalidate(FAR struct rwbuffer_s *rwb,
 #ifdef CONFIG_DRVR_WRITEBUFFER
 int rwb_flush(FAR struct rwbuffer_s *rwb)
 {
+  int ret;
+
   rwb_semtake(&rwb->wrsem);
   rwb_wrcanceltimeout(rwb);
-  rwb_wrflush(rwb);
+  ret = rwb_wrflush(rwb);
   rwb_semgive(&rwb->wrsem);
 
-  return OK;
+  return ret;
 }
 #endif
 
+/****************************************************************************
+ * Name: rwb_info
+ *
+ * Description:
+ *   Return the current state and statistics of a buffer.  The statistics
+ *   are maintained without additional locking and are approximate.
+ *
+ ****************************************************************************/
+
+void rwb_info(FAR struct rwbuffer_s *rwb, FAR struct rwb_info_s *info)
+{
+  DEBUGASSERT(rwb != NULL && info != NULL);
+
+  memset(info, 0, sizeof(struct rwb_info_s));
+  info->dev         = rwb->dev;
+  info->blocksize   = rwb->blocksize;
+#ifdef CONFIG_DRVR_WRITEBUFFER
+  info->wrmaxblocks = rwb->wrmaxblocks;
+  info->wrnblocks   = rwb->wrnblocks;
+#endif
+#ifdef CONFIG_DRVR_READAHEAD
+  info->rhmaxblocks = rwb->rhmaxblocks;
+  info->rhwindow    = rwb->rhwindow;
+#endif
+  info->rdhits      = rwb->rdhits;
+  info->rdmisses    = rwb->rdmisses;
+  info->wrhits      = rwb->wrhits;
+  info->wrmisses    = rwb->wrmisses;
+  info->nflush      = rwb->nflush;
+}
+
+/****************************************************************************
+ * Name: rwb_foreach
+ *
+ * Description:
+ *   Call the handler for each buffer that has been initialized.  Buffers
+ *   cannot be uninitialized while the handler runs.
+ *
+ ****************************************************************************/
+
+void rwb_foreach(rwb_handler_t handler, FAR void *arg)
+{
+  FAR struct rwbuffer_s *rwb;
+
+  rwb_semtake(&g_rwbsem);
+  for (rwb = g_rwbuffers; rwb != NULL; rwb = rwb->flink)
+    {
+      handler(rwb, arg);
+    }
+
+  rwb_semgive(&g_rwbsem);
+}
+
 #endif /* CONFIG_DRVR_WRITEBUFFER || CONFIG_DRVR_READAHEAD */
 
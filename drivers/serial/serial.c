@@ -201,6 +201,14 @@ static void uart_pollnotify(FAR uart_dev_t *dev, pollevent_t eventset)
 
               finfo("Report events: %02x\n", fds->revents);
 
+              /* A waiter with a notification callback is always called */
+
+              if (fds->cb != NULL)
+                {
+                  fds->cb(fds);
+                  continue;
+                }
+
               /* Limit the number of times that the semaphore is posted.
                * The critical section is needed to make the following
                * operation atomic.
@@ -41,9 +41,12 @@
 
 #include <sys/types.h>
 #include <sched.h>
+#include <fcntl.h>
 #include <assert.h>
 #include <errno.h>
 
+#include <nuttx/clock.h>
+#include <nuttx/signal.h>
 #include <nuttx/sched_note.h>
 #include <nuttx/fs/fs.h>
 
@@ -91,6 +94,26 @@ static ssize_t note_read(FAR struct file *filep, FAR char *buffer,
 
   DEBUGASSERT(filep != 0 && buffer != NULL && buflen > 0);
 
+#if CONFIG_DRIVER_NOTE_POLLDELAY > 0
+  /* Wait until there is at least one note in the buffer */
+
+  while (sched_note_size() <= 0)
+    {
+      int ret;
+
+      if ((filep->f_oflags & O_NONBLOCK) != 0)
+        {
+          return -EAGAIN;
+        }
+
+      ret = nxsig_usleep(CONFIG_DRIVER_NOTE_POLLDELAY * USEC_PER_MSEC);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+#endif
+
   /* Then loop, adding as many notes as possible to the user buffer. */
 
   retlen = 0;
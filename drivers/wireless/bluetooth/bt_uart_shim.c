@@ -468,6 +468,7 @@ FAR void *bt_uart_shim_getdevice(FAR char *path)
   s->p.fd = s->h;
   s->p.events = POLLIN;
   s->p.sem = &s->dready;
+  s->p.cb = NULL;
 
   s->enabled = true;
 
@@ -0,0 +1,1270 @@
+/****************************************************************************
+ * fs/aio/ioring.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/ioring.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <poll.h>
+#include <queue.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/cancelpt.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "inode/inode.h"
+
+#ifdef CONFIG_FS_IORING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_FS_IORING_MAXENTRIES
+#  define CONFIG_FS_IORING_MAXENTRIES 64
+#endif
+
+#undef IORING_HAVE_PSOCK
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+#  define IORING_HAVE_PSOCK
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct ioring_ctx_s;
+
+/* One in-flight request.  These are pre-allocated when the ring is created
+ * so that no memory is allocated per operation.
+ */
+
+struct ioring_req_s
+{
+  dq_entry_t link;                   /* Free or ready list link */
+  FAR struct ioring_ctx_s *ctx;      /* The owning ring */
+  union
+  {
+    FAR struct file *filep;          /* File structure to use with the I/O */
+#ifdef IORING_HAVE_PSOCK
+    FAR struct socket *psock;        /* Socket to use with the I/O */
+#endif
+    FAR void *ptr;
+  } u;
+#ifdef IORING_HAVE_PSOCK
+  FAR struct socket *newsock;        /* ACCEPT: Socket for the connection */
+  int newfd;                         /* ACCEPT: Descriptor of newsock */
+#endif
+  struct pollfd pfd;                 /* Poll structure given to the driver */
+  FAR void *addr;                    /* Copied from the SQE */
+  size_t len;
+  off_t off;
+  uintptr_t user_data;
+  uint32_t op_flags;
+  pollevent_t revents;               /* Events reported to a POLL request */
+  uint8_t opcode;
+  bool issock;                       /* True: u.psock is valid */
+  bool polled;                       /* True: Wait until the fd is ready */
+  bool setup;                        /* True: The poll is set up */
+  bool armed;                        /* True: Accept poll notifications */
+  bool queued;                       /* True: The request is ready to run */
+};
+
+/* One ring.  The ready list and the state flags are modified by poll
+ * notifications which may run in interrupt context and so are protected
+ * by a critical section; the free list and the rings are protected by
+ * exclsem.
+ */
+
+struct ioring_ctx_s
+{
+  sem_t exclsem;                     /* Serializes submit and complete */
+  sem_t waitsem;                     /* Posted when a CQE is posted */
+  struct work_s work;                /* Runs the ready requests */
+  dq_queue_t ready;                  /* Requests ready to run */
+  dq_queue_t freeq;                  /* Unused requests */
+  FAR struct ioring_rings_s *rings;  /* Rings shared with the application */
+  FAR struct ioring_req_s *reqs;     /* The pre-allocated requests */
+  FAR struct ioring_req_s *current;  /* The request being performed */
+  uint32_t nreqs;                    /* Number of requests (= CQ size) */
+  uint32_t inflight;                 /* Number of requests in use */
+  uint16_t crefs;                    /* Open file structures and callers */
+  uint8_t nwaiters;                  /* Threads waiting for completions */
+  bool busy;                         /* True: The worker is queued/running */
+  bool closing;                      /* True: The ring is being destroyed */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int ioring_do_open(FAR struct file *filep);
+static int ioring_do_close(FAR struct file *filep);
+static void ioring_worker(FAR void *arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_ioring_ops =
+{
+  ioring_do_open,  /* open */
+  ioring_do_close, /* close */
+  NULL,            /* read */
+  NULL,            /* write */
+  NULL,            /* seek */
+  NULL,            /* ioctl */
+  NULL             /* poll */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , NULL           /* unlink */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ioring_semtake
+ *
+ * Description:
+ *   Take the ring semaphore, ignoring signals and cancellation.  On
+ *   failure, the semaphore is not held and the caller must not touch the
+ *   state of the ring.
+ *
+ ****************************************************************************/
+
+static int ioring_semtake(FAR struct ioring_ctx_s *ctx)
+{
+  int ret;
+
+  ret = nxsem_wait_uninterruptible(&ctx->exclsem);
+  DEBUGASSERT(ret == OK);
+  return ret;
+}
+
+#define ioring_semgive(ctx) nxsem_post(&(ctx)->exclsem)
+
+/****************************************************************************
+ * Name: ioring_getctx
+ *
+ * Description:
+ *   Return the ring associated with a file descriptor with a reference
+ *   held, or NULL if the descriptor does not refer to a ring.  The file
+ *   list semaphore keeps the descriptor from being closed until the
+ *   reference is taken.  The reference is released with ioring_putctx().
+ *
+ ****************************************************************************/
+
+static FAR struct ioring_ctx_s *ioring_getctx(int fd)
+{
+  FAR struct ioring_ctx_s *ctx = NULL;
+  FAR struct filelist *list;
+  FAR struct file *filep;
+
+  list = sched_getfiles();
+  if (list == NULL)
+    {
+      return NULL;
+    }
+
+  files_semtake(list);
+  if (fs_getfilep(fd, &filep) >= 0 && filep->f_inode != NULL &&
+      filep->f_inode->u.i_ops == &g_ioring_ops)
+    {
+      ctx = (FAR struct ioring_ctx_s *)filep->f_inode->i_private;
+      if (ioring_semtake(ctx) >= 0)
+        {
+          ctx->crefs++;
+          ioring_semgive(ctx);
+        }
+      else
+        {
+          ctx = NULL;
+        }
+    }
+
+  files_semgive(list);
+  return ctx;
+}
+
+/****************************************************************************
+ * Name: ioring_free
+ *
+ * Description:
+ *   Release all resources held by a ring.
+ *
+ ****************************************************************************/
+
+static void ioring_free(FAR struct ioring_ctx_s *ctx)
+{
+  nxsem_destroy(&ctx->waitsem);
+  nxsem_destroy(&ctx->exclsem);
+  kumm_free(ctx->rings);
+  kmm_free(ctx->reqs);
+  kmm_free(ctx);
+}
+
+/****************************************************************************
+ * Name: ioring_schedule
+ *
+ * Description:
+ *   Queue a request in the ready list and make sure that the worker will
+ *   run.
+ *
+ * Assumptions:
+ *   Called within a critical section.  May be called from interrupt
+ *   handlers.
+ *
+ ****************************************************************************/
+
+static void ioring_schedule(FAR struct ioring_req_s *req)
+{
+  FAR struct ioring_ctx_s *ctx = req->ctx;
+
+  if (!req->queued && !ctx->closing)
+    {
+      dq_addlast(&req->link, &ctx->ready);
+      req->queued = true;
+
+      if (!ctx->busy)
+        {
+          ctx->busy = true;
+          (void)work_queue(LPWORK, &ctx->work, ioring_worker, ctx, 0);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: ioring_notify
+ *
+ * Description:
+ *   The poll notification callback of a request waiting for its descriptor
+ *   to become ready.
+ *
+ * Assumptions:
+ *   May be called from interrupt handlers.
+ *
+ ****************************************************************************/
+
+static void ioring_notify(FAR struct pollfd *fds)
+{
+  FAR struct ioring_req_s *req = (FAR struct ioring_req_s *)fds->arg;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (req->armed)
+    {
+      ioring_schedule(req);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: ioring_fdsetup
+ *
+ * Description:
+ *   Set up or tear down the poll of the descriptor of a request.
+ *
+ ****************************************************************************/
+
+static int ioring_fdsetup(FAR struct ioring_req_s *req, bool setup)
+{
+#ifdef IORING_HAVE_PSOCK
+  if (req->issock)
+    {
+      return psock_poll(req->u.psock, &req->pfd, setup);
+    }
+#endif
+
+  return file_poll(req->u.filep, &req->pfd, setup);
+}
+
+/****************************************************************************
+ * Name: ioring_arm
+ *
+ * Description:
+ *   Wait for the descriptor of a request to become ready.  The driver
+ *   notifies immediately if the requested event is already pending.
+ *
+ ****************************************************************************/
+
+static int ioring_arm(FAR struct ioring_req_s *req)
+{
+  irqstate_t flags;
+  int ret;
+
+  switch (req->opcode)
+    {
+      case IORING_OP_POLL:
+        req->pfd.events = (pollevent_t)req->op_flags;
+        break;
+
+      case IORING_OP_WRITE:
+      case IORING_OP_SEND:
+        req->pfd.events = POLLOUT;
+        break;
+
+      default:
+        req->pfd.events = POLLIN;
+        break;
+    }
+
+  req->pfd.fd      = -1;
+  req->pfd.revents = 0;
+  req->pfd.ptr     = NULL;
+  req->pfd.sem     = &req->ctx->waitsem;
+  req->pfd.priv    = NULL;
+  req->pfd.cb      = ioring_notify;
+  req->pfd.arg     = req;
+
+  flags = enter_critical_section();
+  req->armed = true;
+  leave_critical_section(flags);
+
+  ret = ioring_fdsetup(req, true);
+  if (ret < 0)
+    {
+      flags = enter_critical_section();
+      req->armed = false;
+      leave_critical_section(flags);
+      return ret;
+    }
+
+  req->setup = true;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ioring_disarm
+ *
+ * Description:
+ *   Stop waiting for the descriptor of a request.
+ *
+ ****************************************************************************/
+
+static void ioring_disarm(FAR struct ioring_req_s *req)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  req->armed = false;
+  leave_critical_section(flags);
+
+  if (req->setup)
+    {
+      (void)ioring_fdsetup(req, false);
+      req->setup = false;
+    }
+}
+
+/****************************************************************************
+ * Name: ioring_scan
+ *
+ * Description:
+ *   Schedule armed requests whose poll events were reported by posting the
+ *   semaphore rather than through the notification callback.
+ *
+ ****************************************************************************/
+
+static void ioring_scan(FAR struct ioring_ctx_s *ctx)
+{
+  FAR struct ioring_req_s *req;
+  irqstate_t flags;
+  uint32_t i;
+
+  flags = enter_critical_section();
+  for (i = 0; i < ctx->nreqs; i++)
+    {
+      req = &ctx->reqs[i];
+      if (req->armed && req->pfd.revents != 0)
+        {
+          ioring_schedule(req);
+        }
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: ioring_post
+ *
+ * Description:
+ *   Post the CQE of a request and return the request to the free list.
+ *   There is always room in the completion ring because no more requests
+ *   are accepted than there are free CQEs.
+ *
+ * Assumptions:
+ *   The caller holds exclsem.
+ *
+ ****************************************************************************/
+
+static void ioring_post(FAR struct ioring_ctx_s *ctx,
+                        FAR struct ioring_req_s *req, ssize_t res)
+{
+  FAR struct ioring_rings_s *rings = ctx->rings;
+  FAR struct ioring_cqe_s *cqe;
+  uint32_t tail = rings->cq_tail;
+
+  DEBUGASSERT(tail - rings->cq_head <= rings->cq_mask);
+
+  /* The application has finished with the entry once cq_head has moved
+   * past it, and the CQE must be visible before the new tail.
+   */
+
+  IORING_DMB();
+  cqe            = &rings->cqes[tail & rings->cq_mask];
+  cqe->user_data = req->user_data;
+  cqe->res       = res;
+  IORING_DMB();
+  rings->cq_tail = tail + 1;
+
+  req->u.ptr     = NULL;
+  dq_addlast(&req->link, &ctx->freeq);
+  ctx->inflight--;
+
+  /* Only wake up a thread that is waiting in ioring_enter() */
+
+  if (ctx->nwaiters > 0)
+    {
+      nxsem_post(&ctx->waitsem);
+    }
+}
+
+/****************************************************************************
+ * Name: ioring_prepare
+ *
+ * Description:
+ *   Fill in a request from a SQE.  Called in the context of the submitting
+ *   task so that its descriptors can be resolved.
+ *
+ *   Reads and writes of regular files are performed on the work queue
+ *   directly.  Reads and writes of sockets and of other files wait until
+ *   the descriptor is ready and are then performed without blocking, so
+ *   that an idle peer cannot stall the work queue.  For files other than
+ *   sockets this requires the descriptor to be opened with O_NONBLOCK.
+ *
+ ****************************************************************************/
+
+static int ioring_prepare(FAR struct ioring_req_s *req,
+                          FAR const struct ioring_sqe_s *sqe)
+{
+  int ret;
+
+  req->opcode    = sqe->opcode;
+  req->addr      = sqe->addr;
+  req->len       = sqe->len;
+  req->off       = sqe->off;
+  req->op_flags  = sqe->op_flags;
+  req->user_data = sqe->user_data;
+  req->revents   = 0;
+  req->issock    = false;
+  req->polled    = (sqe->opcode >= IORING_OP_POLL);
+  req->setup     = false;
+  req->armed     = false;
+  req->queued    = false;
+#ifdef IORING_HAVE_PSOCK
+  req->newsock   = NULL;
+#endif
+
+  if (sqe->flags != 0 || sqe->reserved != 0 ||
+      sqe->opcode > IORING_OP_SEND)
+    {
+      return -EINVAL;
+    }
+
+  if (sqe->opcode == IORING_OP_NOP)
+    {
+      return OK;
+    }
+
+#ifdef IORING_HAVE_PSOCK
+  if ((unsigned int)sqe->fd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+      req->u.psock = sockfd_socket(sqe->fd);
+      if (req->u.psock == NULL || req->u.psock->s_crefs <= 0)
+        {
+          return -EBADF;
+        }
+
+      req->issock = true;
+      req->polled = (sqe->opcode != IORING_OP_NOP);
+
+      if (sqe->opcode == IORING_OP_FSYNC)
+        {
+          return -EINVAL;
+        }
+
+      /* As accept() does, allocate the descriptor for the new connection
+       * now so that it belongs to the submitting task.
+       */
+
+      if (sqe->opcode == IORING_OP_ACCEPT)
+        {
+          req->newfd = sockfd_allocate(0);
+          if (req->newfd < 0)
+            {
+              return -ENFILE;
+            }
+
+          req->newsock = sockfd_socket(req->newfd);
+          if (req->newsock == NULL)
+            {
+              sockfd_release(req->newfd);
+              return -ENFILE;
+            }
+        }
+
+      return OK;
+    }
+#endif
+
+  if (sqe->opcode == IORING_OP_ACCEPT || sqe->opcode == IORING_OP_RECV ||
+      sqe->opcode == IORING_OP_SEND)
+    {
+      return -ENOTSOCK;
+    }
+
+  ret = fs_getfilep(sqe->fd, &req->u.filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  DEBUGASSERT(req->u.filep != NULL);
+
+  if ((sqe->opcode == IORING_OP_READ || sqe->opcode == IORING_OP_WRITE) &&
+      req->u.filep->f_inode != NULL
+#ifndef CONFIG_DISABLE_MOUNTPOINT
+      && !INODE_IS_MOUNTPT(req->u.filep->f_inode)
+#endif
+     )
+    {
+      /* A pipe, terminal or other device could block the work queue
+       * indefinitely.
+       */
+
+      if ((req->u.filep->f_oflags & O_NONBLOCK) == 0)
+        {
+          return -EOPNOTSUPP;
+        }
+
+      req->polled = true;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ioring_execute
+ *
+ * Description:
+ *   Perform the operation of a request.  Returns -EAGAIN if a polled
+ *   operation would block.
+ *
+ ****************************************************************************/
+
+static ssize_t ioring_execute(FAR struct ioring_req_s *req)
+{
+  ssize_t ret;
+
+  switch (req->opcode)
+    {
+      case IORING_OP_NOP:
+        ret = 0;
+        break;
+
+      case IORING_OP_READ:
+#ifdef IORING_HAVE_PSOCK
+        if (req->issock)
+          {
+            ret = psock_recv(req->u.psock, req->addr, req->len,
+                             MSG_DONTWAIT);
+          }
+        else
+#endif
+        if (req->off < 0)
+          {
+            ret = file_read(req->u.filep, req->addr, req->len);
+          }
+        else
+          {
+            ret = file_pread(req->u.filep, req->addr, req->len, req->off);
+          }
+        break;
+
+      case IORING_OP_WRITE:
+#ifdef IORING_HAVE_PSOCK
+        if (req->issock)
+          {
+            ret = psock_send(req->u.psock, req->addr, req->len,
+                             MSG_DONTWAIT);
+          }
+        else
+#endif
+        if (req->off < 0)
+          {
+            ret = file_write(req->u.filep, req->addr, req->len);
+          }
+        else
+          {
+            ret = file_pwrite(req->u.filep, req->addr, req->len, req->off);
+          }
+        break;
+
+      case IORING_OP_FSYNC:
+        ret = file_fsync(req->u.filep);
+        break;
+
+      case IORING_OP_POLL:
+        ret = req->revents != 0 ? (ssize_t)req->revents : -EAGAIN;
+        break;
+
+#ifdef IORING_HAVE_PSOCK
+      case IORING_OP_ACCEPT:
+        {
+          socklen_t addrlen = (socklen_t)req->len;
+
+          ret = psock_accept(req->u.psock, (FAR struct sockaddr *)req->addr,
+                             req->addr != NULL ? &addrlen : NULL,
+                             req->newsock);
+          if (ret >= 0)
+            {
+              ret = req->newfd;
+            }
+        }
+        break;
+
+      case IORING_OP_RECV:
+        ret = psock_recv(req->u.psock, req->addr, req->len,
+                         req->op_flags | MSG_DONTWAIT);
+        break;
+
+      case IORING_OP_SEND:
+        ret = psock_send(req->u.psock, req->addr, req->len,
+                         req->op_flags | MSG_DONTWAIT);
+        break;
+#endif
+
+      default:
+        ret = -EINVAL;
+        break;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ioring_release
+ *
+ * Description:
+ *   Release the resources of a request that did not complete successfully.
+ *
+ ****************************************************************************/
+
+static void ioring_release(FAR struct ioring_req_s *req)
+{
+#ifdef IORING_HAVE_PSOCK
+  if (req->newsock != NULL)
+    {
+      psock_release(req->newsock);
+      req->newsock = NULL;
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: ioring_worker
+ *
+ * Description:
+ *   Run on the low-priority work queue.  Perform each ready request and
+ *   post its completion.
+ *
+ ****************************************************************************/
+
+static void ioring_worker(FAR void *arg)
+{
+  FAR struct ioring_ctx_s *ctx = (FAR struct ioring_ctx_s *)arg;
+  FAR struct ioring_req_s *req;
+  irqstate_t flags;
+  bool closing;
+  ssize_t ret;
+
+  for (; ; )
+    {
+      /* Take the next ready request.  Notifications for it are ignored
+       * from here on.
+       */
+
+      flags = enter_critical_section();
+      req = (FAR struct ioring_req_s *)dq_remfirst(&ctx->ready);
+      closing = ctx->closing;
+      if (req == NULL || closing)
+        {
+          ctx->busy = false;
+          leave_critical_section(flags);
+          break;
+        }
+
+      ctx->current = req;
+      req->queued  = false;
+      req->armed   = false;
+      req->revents = req->pfd.revents;
+      leave_critical_section(flags);
+
+      if (req->setup)
+        {
+          (void)ioring_fdsetup(req, false);
+          req->setup = false;
+        }
+
+      ret = ioring_execute(req);
+
+      /* A polled operation that would still block waits again */
+
+      if (ret == -EAGAIN && req->polled)
+        {
+          ret = ioring_arm(req);
+          if (ret >= 0)
+            {
+              /* ioring_do_close() does not disarm the current request */
+
+              if (!ctx->closing)
+                {
+                  continue;
+                }
+
+              ioring_disarm(req);
+              ret = -ECANCELED;
+            }
+        }
+
+#ifdef IORING_HAVE_PSOCK
+      /* Nobody can receive a connection accepted after the ring was
+       * closed.
+       */
+
+      if (ret >= 0 && ctx->closing && req->opcode == IORING_OP_ACCEPT)
+        {
+          (void)psock_close(req->newsock);
+          ret = -ECANCELED;
+        }
+#endif
+
+      if (ret < 0)
+        {
+          ferr("ERROR: ioring opcode %d failed: %d\n",
+               req->opcode, (int)ret);
+          ioring_release(req);
+        }
+
+      if (ioring_semtake(ctx) >= 0)
+        {
+          ioring_post(ctx, req, ret);
+          ioring_semgive(ctx);
+        }
+    }
+
+  /* The ring may have been closed while the worker was busy.  Wait for
+   * ioring_do_close() to finish with the ring before freeing it.
+   */
+
+  if (closing)
+    {
+      if (ioring_semtake(ctx) >= 0)
+        {
+          ioring_semgive(ctx);
+        }
+
+      ioring_free(ctx);
+    }
+}
+
+/****************************************************************************
+ * Name: ioring_submit_one
+ *
+ * Description:
+ *   Take one SQE from the submission ring and start it.
+ *
+ * Assumptions:
+ *   The caller holds exclsem and has verified that there is room for the
+ *   completion.
+ *
+ ****************************************************************************/
+
+static void ioring_submit_one(FAR struct ioring_ctx_s *ctx,
+                              FAR const struct ioring_sqe_s *sqe)
+{
+  FAR struct ioring_req_s *req;
+  irqstate_t flags;
+  int ret;
+
+  req = (FAR struct ioring_req_s *)dq_remfirst(&ctx->freeq);
+  DEBUGASSERT(req != NULL);
+  ctx->inflight++;
+
+  ret = ioring_prepare(req, sqe);
+  if (ret >= 0)
+    {
+      if (req->polled)
+        {
+          ret = ioring_arm(req);
+        }
+      else
+        {
+          flags = enter_critical_section();
+          ioring_schedule(req);
+          leave_critical_section(flags);
+        }
+    }
+
+  if (ret < 0)
+    {
+      ioring_release(req);
+      ioring_post(ctx, req, ret);
+    }
+}
+
+/****************************************************************************
+ * Name: ioring_do_open
+ *
+ * Description:
+ *   Called when the ring file descriptor is duplicated.
+ *
+ ****************************************************************************/
+
+static int ioring_do_open(FAR struct file *filep)
+{
+  FAR struct ioring_ctx_s *ctx = filep->f_inode->i_private;
+  int ret;
+
+  ret = ioring_semtake(ctx);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ctx->crefs++;
+  ioring_semgive(ctx);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ioring_putctx
+ *
+ * Description:
+ *   Release a reference to a ring.  The ring is destroyed with the last
+ *   reference.  Requests still waiting for their descriptors are
+ *   abandoned; a request that the worker is performing is allowed to
+ *   finish and the worker then frees the ring.
+ *
+ ****************************************************************************/
+
+static void ioring_putctx(FAR struct ioring_ctx_s *ctx)
+{
+  FAR struct ioring_req_s *current;
+  FAR struct ioring_req_s *req;
+  irqstate_t flags;
+  bool busy;
+  uint32_t i;
+
+  if (ioring_semtake(ctx) < 0)
+    {
+      return;
+    }
+
+  if (--ctx->crefs > 0)
+    {
+      ioring_semgive(ctx);
+      return;
+    }
+
+  /* Stop the worker from taking further requests.  If the worker has not
+   * started yet, it is cancelled; otherwise it frees the ring when it
+   * finishes.
+   */
+
+  flags = enter_critical_section();
+  ctx->closing = true;
+  dq_init(&ctx->ready);
+
+  if (ctx->busy && work_cancel(LPWORK, &ctx->work) == OK)
+    {
+      ctx->busy = false;
+    }
+
+  busy    = ctx->busy;
+  current = busy ? ctx->current : NULL;
+  leave_critical_section(flags);
+
+  /* Abandon the requests that are waiting for their descriptors */
+
+  for (i = 0; i < ctx->nreqs; i++)
+    {
+      req = &ctx->reqs[i];
+      if (req != current && req->u.ptr != NULL)
+        {
+          ioring_disarm(req);
+          ioring_release(req);
+        }
+    }
+
+  ioring_semgive(ctx);
+
+  if (!busy)
+    {
+      ioring_free(ctx);
+    }
+}
+
+/****************************************************************************
+ * Name: ioring_do_close
+ *
+ * Description:
+ *   Called when a ring file descriptor is closed.  The ring is destroyed
+ *   when the last descriptor referring to it is closed and no
+ *   ioring_enter() call is using it.
+ *
+ ****************************************************************************/
+
+static int ioring_do_close(FAR struct file *filep)
+{
+  ioring_putctx((FAR struct ioring_ctx_s *)filep->f_inode->i_private);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ioring_setup
+ *
+ * Description:
+ *   Create a ring with at least 'entries' submission queue entries and
+ *   twice as many completion queue entries.
+ *
+ * Input Parameters:
+ *   entries - The minimum number of submission queue entries
+ *   ring    - The location to return the description of the ring
+ *
+ * Returned Value:
+ *   The ring file descriptor on success; -1 (ERROR) on failure with errno
+ *   set appropriately.
+ *
+ ****************************************************************************/
+
+int ioring_setup(unsigned int entries, FAR struct ioring_s *ring)
+{
+  FAR struct ioring_rings_s *rings;
+  FAR struct ioring_ctx_s *ctx;
+  FAR struct inode *inode;
+  unsigned int sqsize;
+  unsigned int cqsize;
+  unsigned int i;
+  int errcode;
+  int fd;
+
+  if (ring == NULL || entries == 0 ||
+      entries > CONFIG_FS_IORING_MAXENTRIES)
+    {
+      errcode = EINVAL;
+      goto errout;
+    }
+
+  for (sqsize = 1; sqsize < entries; sqsize <<= 1);
+  cqsize = 2 * sqsize;
+
+  ctx = (FAR struct ioring_ctx_s *)kmm_zalloc(sizeof(struct ioring_ctx_s));
+  if (ctx == NULL)
+    {
+      errcode = ENOMEM;
+      goto errout;
+    }
+
+  /* The rings are allocated from the user heap as one block so that the
+   * application can access them directly.
+   */
+
+  rings = (FAR struct ioring_rings_s *)
+    kumm_zalloc(sizeof(struct ioring_rings_s) +
+                sqsize * sizeof(struct ioring_sqe_s) +
+                cqsize * sizeof(struct ioring_cqe_s));
+  if (rings == NULL)
+    {
+      errcode = ENOMEM;
+      goto errout_with_ctx;
+    }
+
+  rings->sq_mask = sqsize - 1;
+  rings->cq_mask = cqsize - 1;
+  rings->sqes    = (FAR struct ioring_sqe_s *)&rings[1];
+  rings->cqes    = (FAR struct ioring_cqe_s *)&rings->sqes[sqsize];
+
+  /* One request per CQE.  This bounds the number of requests in flight so
+   * that the completion ring can never overflow.
+   */
+
+  ctx->reqs = (FAR struct ioring_req_s *)
+    kmm_zalloc(cqsize * sizeof(struct ioring_req_s));
+  if (ctx->reqs == NULL)
+    {
+      errcode = ENOMEM;
+      goto errout_with_rings;
+    }
+
+  /* Each ring has an unlinked pseudo-inode so that it can be found from
+   * any duplicate of the descriptor.
+   */
+
+  inode = (FAR struct inode *)kmm_zalloc(FSNODE_SIZE(0));
+  if (inode == NULL)
+    {
+      errcode = ENOMEM;
+      goto errout_with_reqs;
+    }
+
+  nxsem_init(&ctx->exclsem, 0, 1);
+  nxsem_init(&ctx->waitsem, 0, 0);
+  nxsem_setprotocol(&ctx->waitsem, SEM_PRIO_NONE);
+  dq_init(&ctx->ready);
+  dq_init(&ctx->freeq);
+
+  for (i = 0; i < cqsize; i++)
+    {
+      ctx->reqs[i].ctx = ctx;
+      dq_addlast(&ctx->reqs[i].link, &ctx->freeq);
+    }
+
+  ctx->rings       = rings;
+  ctx->nreqs       = cqsize;
+  ctx->crefs       = 1;
+
+  inode->i_crefs   = 1;
+  inode->i_flags   = FSNODEFLAG_TYPE_DRIVER | FSNODEFLAG_DELETED;
+  inode->u.i_ops   = &g_ioring_ops;
+  inode->i_private = ctx;
+
+  fd = files_allocate(inode, O_RDOK, 0, 0);
+  if (fd < 0)
+    {
+      nxsem_destroy(&ctx->waitsem);
+      nxsem_destroy(&ctx->exclsem);
+      kmm_free(inode);
+      errcode = EMFILE;
+      goto errout_with_reqs;
+    }
+
+  ring->fd       = fd;
+  ring->sqe_tail = 0;
+  ring->rings    = rings;
+  return fd;
+
+errout_with_reqs:
+  kmm_free(ctx->reqs);
+
+errout_with_rings:
+  kumm_free(rings);
+
+errout_with_ctx:
+  kmm_free(ctx);
+
+errout:
+  set_errno(errcode);
+  return ERROR;
+}
+
+/****************************************************************************
+ * Name: ioring_enter
+ *
+ * Description:
+ *   Submit SQEs and optionally wait for completions.  Submission stops
+ *   early if the completion ring could not hold the completion of another
+ *   request; the caller must then reap some CQEs and submit again.
+ *
+ * Input Parameters:
+ *   fd           - The ring file descriptor
+ *   to_submit    - The maximum number of SQEs to consume
+ *   min_complete - The number of CQEs to wait for
+ *   flags        - Zero or IORING_ENTER_GETEVENTS
+ *
+ * Returned Value:
+ *   The number of SQEs consumed on success; -1 (ERROR) on failure with
+ *   errno set appropriately.
+ *
+ ****************************************************************************/
+
+int ioring_enter(int fd, unsigned int to_submit, unsigned int min_complete,
+                 unsigned int flags)
+{
+  FAR struct ioring_ctx_s *ctx;
+  FAR struct ioring_rings_s *rings;
+  struct ioring_sqe_s sqe;
+  unsigned int nsubmit = 0;
+  uint32_t head;
+  int semret;
+  int ret = OK;
+
+  /* ioring_enter() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  ctx = ioring_getctx(fd);
+  if (ctx == NULL)
+    {
+      ret = -EBADF;
+      goto errout;
+    }
+
+  if ((flags & ~IORING_ENTER_GETEVENTS) != 0 ||
+      min_complete > ctx->nreqs)
+    {
+      ret = -EINVAL;
+      goto errout_with_ctx;
+    }
+
+  rings = ctx->rings;
+
+  ret = ioring_semtake(ctx);
+  if (ret < 0)
+    {
+      goto errout_with_ctx;
+    }
+
+  head = rings->sq_head;
+
+  while (nsubmit < to_submit && head != rings->sq_tail)
+    {
+      /* Stop if the completion could not be posted */
+
+      if (ctx->inflight + (rings->cq_tail - rings->cq_head) >= ctx->nreqs)
+        {
+          break;
+        }
+
+      /* Copy the SQE so that the application cannot change it while it is
+       * being examined.  The SQE is read only after the tail that
+       * published it, and the copy is complete before the new head lets
+       * the application reuse the entry.
+       */
+
+      IORING_DMB();
+      sqe = rings->sqes[head & rings->sq_mask];
+      IORING_DMB();
+      rings->sq_head = ++head;
+
+      ioring_submit_one(ctx, &sqe);
+      nsubmit++;
+    }
+
+  if (nsubmit == 0 && to_submit > 0 && head != rings->sq_tail)
+    {
+      ioring_semgive(ctx);
+      ret = -EBUSY;
+      goto errout_with_ctx;
+    }
+
+  /* Wait for completions */
+
+  if ((flags & IORING_ENTER_GETEVENTS) != 0)
+    {
+      while (rings->cq_tail - rings->cq_head < min_complete)
+        {
+          ctx->nwaiters++;
+          ioring_semgive(ctx);
+
+          ret = nxsem_wait(&ctx->waitsem);
+
+          semret = ioring_semtake(ctx);
+          if (semret < 0)
+            {
+              ret = semret;
+              goto errout_with_ctx;
+            }
+
+          ctx->nwaiters--;
+
+          if (ret < 0)
+            {
+              break;
+            }
+
+          /* A wakeup may come from a driver that posts the semaphore
+           * directly instead of calling poll_notify().  Such requests are
+           * only found here, so their completions are not posted until
+           * some thread calls ioring_enter() with IORING_ENTER_GETEVENTS.
+           */
+
+          ioring_scan(ctx);
+        }
+    }
+
+  ioring_semgive(ctx);
+  ioring_putctx(ctx);
+
+  if (ret < 0 && nsubmit == 0)
+    {
+      goto errout;
+    }
+
+  leave_cancellation_point();
+  return nsubmit;
+
+errout_with_ctx:
+  ioring_putctx(ctx);
+
+errout:
+  leave_cancellation_point();
+  set_errno(-ret);
+  return ERROR;
+}
+
+#endif /* CONFIG_FS_IORING */
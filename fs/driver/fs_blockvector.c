@@ -0,0 +1,200 @@
+/****************************************************************************
+ * fs/driver/fs_blockvector.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: block_transferv
+ *
+ * Description:
+ *   Perform a vectored transfer with the driver's read or write method.
+ *   Adjacent segments that continue each other both on the media and in
+ *   memory are combined so that, for example, an SD card driver can still
+ *   use a single multi-block command for them.
+ *
+ ****************************************************************************/
+
+static ssize_t block_transferv(FAR struct inode *inode,
+                               FAR const struct block_iovec_s *iov,
+                               int iovcnt, bool write)
+{
+  FAR const struct block_operations *bops = inode->u.i_bops;
+  struct geometry geo;
+  FAR uint8_t *buffer;
+  size_t sectsize = 0;
+  size_t sector;
+  unsigned int nsectors;
+  ssize_t total = 0;
+  ssize_t nxfrd;
+  int ndx;
+
+  /* The sector size is needed to recognize segments that are contiguous in
+   * memory.  If it cannot be obtained, then each segment is transferred
+   * separately.
+   */
+
+  if (iovcnt > 1 && bops->geometry != NULL &&
+      bops->geometry(inode, &geo) >= 0)
+    {
+      sectsize = geo.geo_sectorsize;
+    }
+
+  for (ndx = 0; ndx < iovcnt; )
+    {
+      buffer   = (FAR uint8_t *)iov[ndx].bv_buffer;
+      sector   = iov[ndx].bv_sector;
+      nsectors = iov[ndx].bv_nsectors;
+
+      for (ndx++; ndx < iovcnt && sectsize > 0; ndx++)
+        {
+          if (iov[ndx].bv_sector != sector + nsectors ||
+              (FAR uint8_t *)iov[ndx].bv_buffer !=
+              buffer + nsectors * sectsize)
+            {
+              break;
+            }
+
+          nsectors += iov[ndx].bv_nsectors;
+        }
+
+      if (nsectors == 0)
+        {
+          continue;
+        }
+
+      if (write)
+        {
+          nxfrd = bops->write(inode, buffer, sector, nsectors);
+        }
+      else
+        {
+          nxfrd = bops->read(inode, buffer, sector, nsectors);
+        }
+
+      if (nxfrd < 0)
+        {
+          ferr("ERROR: Transfer of %u sectors at %lu failed: %d\n",
+               nsectors, (unsigned long)sector, (int)nxfrd);
+          return total > 0 ? total : nxfrd;
+        }
+
+      total += nxfrd;
+      if ((size_t)nxfrd < nsectors)
+        {
+          break;
+        }
+    }
+
+  return total;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: block_readv
+ *
+ * Description:
+ *   Read a list of sector segments from a block driver.  The driver's readv
+ *   method is used if it provides one; otherwise, the segments are read
+ *   with the read method.
+ *
+ ****************************************************************************/
+
+ssize_t block_readv(FAR struct inode *inode,
+                    FAR const struct block_iovec_s *iov, int iovcnt)
+{
+  DEBUGASSERT(inode != NULL && inode->u.i_bops != NULL &&
+              (iov != NULL || iovcnt == 0));
+
+  if (inode->u.i_bops->readv != NULL)
+    {
+      return inode->u.i_bops->readv(inode, iov, iovcnt);
+    }
+
+  if (inode->u.i_bops->read == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  return block_transferv(inode, iov, iovcnt, false);
+}
+
+/****************************************************************************
+ * Name: block_writev
+ *
+ * Description:
+ *   Write a list of sector segments to a block driver.  The driver's writev
+ *   method is used if it provides one; otherwise, the segments are written
+ *   with the write method.
+ *
+ ****************************************************************************/
+
+ssize_t block_writev(FAR struct inode *inode,
+                     FAR const struct block_iovec_s *iov, int iovcnt)
+{
+  DEBUGASSERT(inode != NULL && inode->u.i_bops != NULL &&
+              (iov != NULL || iovcnt == 0));
+
+  if (inode->u.i_bops->writev != NULL)
+    {
+      return inode->u.i_bops->writev(inode, iov, iovcnt);
+    }
+
+  if (inode->u.i_bops->write == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  return block_transferv(inode, iov, iovcnt, true);
+}
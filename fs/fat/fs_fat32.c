@@ -68,10 +68,25 @@
 #include "inode/inode.h"
 #include "fs_fat32.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The maximum number of clusters gathered into one direct transfer */
+
+#define FAT_MAXIOV 8
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
 
+#ifndef CONFIG_FAT_FORCE_INDIRECT
+static int     fat_directiov(FAR struct fat_mountpt_s *fs,
+                 FAR struct fat_file_s *ff, off_t pos, FAR uint8_t *buffer,
+                 FAR unsigned int *nsectors, bool extend,
+                 FAR struct block_iovec_s *iov);
+#endif
+
 static int     fat_open(FAR struct file *filep, FAR const char *relpath,
                  int oflags, mode_t mode);
 static int     fat_close(FAR struct file *filep);
@@ -162,6 +177,94 @@ const struct mountpt_operations fat_operations =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: fat_directiov
+ *
+ * Description:
+ *   Describe a direct transfer of up to *nsectors whole sectors starting at
+ *   the current sector of the file as a list of per-cluster segments of the
+ *   user buffer.  The cluster chain is followed (and extended if 'extend'
+ *   is true) for as long as the buffer covers more sectors, up to
+ *   FAT_MAXIOV clusters.  Clusters that are adjacent on the media are
+ *   merged into one transfer by the block layer.
+ *
+ *   The current cluster and sector of the file are advanced past the
+ *   described sectors and *nsectors is set to their number.  If the next
+ *   cluster cannot be found, the list ends early; the caller's loop will
+ *   then report the error.
+ *
+ * Returned Value:
+ *   The number of segments in iov (at least one).
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_FAT_FORCE_INDIRECT
+static int fat_directiov(FAR struct fat_mountpt_s *fs,
+                         FAR struct fat_file_s *ff, off_t pos,
+                         FAR uint8_t *buffer, FAR unsigned int *nsectors,
+                         bool extend, FAR struct block_iovec_s *iov)
+{
+  unsigned int total = 0;
+  unsigned int count;
+  int32_t cluster;
+  int iovcnt = 0;
+
+  for (; ; )
+    {
+      /* Add the remaining sectors of the current cluster */
+
+      count = *nsectors - total;
+      if (count > ff->ff_sectorsincluster)
+        {
+          count = ff->ff_sectorsincluster;
+        }
+
+      iov[iovcnt].bv_sector   = ff->ff_currentsector;
+      iov[iovcnt].bv_nsectors = count;
+      iov[iovcnt].bv_buffer   = &buffer[total * fs->fs_hwsectorsize];
+      iovcnt++;
+
+      ff->ff_sectorsincluster -= count;
+      ff->ff_currentsector    += count;
+      total                   += count;
+
+      if (total >= *nsectors || iovcnt >= FAT_MAXIOV)
+        {
+          break;
+        }
+
+      /* Move on to the next cluster */
+
+      if (extend)
+        {
+          cluster = fat_extendchain(fs, ff->ff_currentcluster);
+        }
+      else
+        {
+          cluster = fat_getcluster(fs, ff->ff_currentcluster);
+        }
+
+      if (cluster < 2 || cluster >= fs->fs_nclusters)
+        {
+          break;
+        }
+
+#ifdef CONFIG_FAT_EXTENTS
+      fat_extentadd(ff, (pos + total * fs->fs_hwsectorsize) /
+                        (fs->fs_fatsecperclus * fs->fs_hwsectorsize),
+                    cluster);
+#endif
+
+      ff->ff_currentcluster   = cluster;
+      ff->ff_currentsector    = fat_cluster2sector(fs, cluster);
+      ff->ff_sectorsincluster = fs->fs_fatsecperclus;
+    }
+
+  *nsectors = total;
+  return iovcnt;
+}
+#endif
+
 /****************************************************************************
  * Name: fat_open
  ****************************************************************************/
@@ -492,7 +595,12 @@ static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
   int ret;
 
 #ifndef CONFIG_FAT_FORCE_INDIRECT
+  struct block_iovec_s iov[FAT_MAXIOV];
   unsigned int nsectors;
+  uint32_t savecluster;
+  off_t savesector;
+  uint8_t savecount;
+  int iovcnt;
   bool force_indirect = false;
 #endif
 
@@ -588,6 +696,11 @@ static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
               goto errout_with_semaphore;
             }
 
+#ifdef CONFIG_FAT_EXTENTS
+          fat_extentadd(ff, filep->f_pos / (fs->fs_fatsecperclus *
+                                            fs->fs_hwsectorsize), cluster);
+#endif
+
           /* Setup to read the first sector from the new cluster */
 
           ff->ff_currentcluster   = cluster;
@@ -610,28 +723,32 @@ fat_read_restart:
         {
           /* Read maximum contiguous sectors directly to the user's
            * buffer without using our tiny read buffer.
-           *
-           * Limit the number of sectors that we read on this time
-           * through the loop to the remaining contiguous sectors
-           * in this cluster
            */
 
-          if (nsectors > ff->ff_sectorsincluster)
-            {
-              nsectors = ff->ff_sectorsincluster;
-            }
-
           /* We are not sure of the state of the file buffer so
            * the safest thing to do is just invalidate it
            */
 
           (void)fat_ffcacheinvalidate(fs, ff);
 
-          /* Read all of the sectors directly into user memory */
+          /* Read the sectors of this cluster and of any following clusters
+           * that the user buffer covers directly into user memory as one
+           * vectored request.
+           */
+
+          savecluster = ff->ff_currentcluster;
+          savesector  = ff->ff_currentsector;
+          savecount   = ff->ff_sectorsincluster;
 
-          ret = fat_hwread(fs, userbuffer, ff->ff_currentsector, nsectors);
+          iovcnt = fat_directiov(fs, ff, filep->f_pos, userbuffer,
+                                 &nsectors, false, iov);
+          ret    = fat_hwreadv(fs, iov, iovcnt);
           if (ret < 0)
             {
+              ff->ff_currentcluster   = savecluster;
+              ff->ff_currentsector    = savesector;
+              ff->ff_sectorsincluster = savecount;
+
 #ifdef CONFIG_FAT_DIRECT_RETRY
               /* The low-level driver may return -EFAULT in the case where
                * the transfer cannot be performed due to buffer memory
@@ -652,9 +769,7 @@ fat_read_restart:
               goto errout_with_semaphore;
             }
 
-          ff->ff_sectorsincluster -= nsectors;
-          ff->ff_currentsector    += nsectors;
-          bytesread                = nsectors * fs->fs_hwsectorsize;
+          bytesread = nsectors * fs->fs_hwsectorsize;
         }
       else
 #endif /* CONFIG_FAT_FORCE_INDIRECT */
@@ -726,7 +841,12 @@ static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
   int ret;
 
 #ifndef CONFIG_FAT_FORCE_INDIRECT
+  struct block_iovec_s iov[FAT_MAXIOV];
   unsigned int nsectors;
+  uint32_t savecluster;
+  off_t savesector;
+  uint8_t savecount;
+  int iovcnt;
   bool force_indirect = false;
 #endif
 
@@ -848,6 +968,11 @@ static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
               goto errout_with_semaphore;
             }
 
+#ifdef CONFIG_FAT_EXTENTS
+          fat_extentadd(ff, filep->f_pos / (fs->fs_fatsecperclus *
+                                            fs->fs_hwsectorsize), cluster);
+
+#endif
           /* Setup to write the first sector from the new cluster */
 
           ff->ff_currentcluster   = cluster;
@@ -869,17 +994,8 @@ fat_write_restart:
         {
           /* Write maximum contiguous sectors directly from the user's
            * buffer without using our tiny read buffer.
-           *
-           * Limit the number of sectors that we write on this time
-           * through the loop to the remaining contiguous sectors
-           * in this cluster
            */
 
-          if (nsectors > ff->ff_sectorsincluster)
-            {
-              nsectors = ff->ff_sectorsincluster;
-            }
-
           /* We are not sure of the state of the sector cache so the
            * safest thing to do is write back any dirty, cached sector
            * and invalidate the current cache content.
@@ -887,11 +1003,24 @@ fat_write_restart:
 
           (void)fat_ffcacheinvalidate(fs, ff);
 
-          /* Write all of the sectors directly from user memory */
+          /* Write the sectors of this cluster and of any following clusters
+           * that the user buffer covers directly from user memory as one
+           * vectored request.
+           */
+
+          savecluster = ff->ff_currentcluster;
+          savesector  = ff->ff_currentsector;
+          savecount   = ff->ff_sectorsincluster;
 
-          ret = fat_hwwrite(fs, userbuffer, ff->ff_currentsector, nsectors);
+          iovcnt = fat_directiov(fs, ff, filep->f_pos, userbuffer,
+                                 &nsectors, true, iov);
+          ret    = fat_hwwritev(fs, iov, iovcnt);
           if (ret < 0)
             {
+              ff->ff_currentcluster   = savecluster;
+              ff->ff_currentsector    = savesector;
+              ff->ff_sectorsincluster = savecount;
+
 #ifdef CONFIG_FAT_DIRECT_RETRY
               /* The low-level driver may return -EFAULT in the case where
                * the transfer cannot be performed due to buffer memory
@@ -912,10 +1041,8 @@ fat_write_restart:
               goto errout_with_semaphore;
             }
 
-          ff->ff_sectorsincluster -= nsectors;
-          ff->ff_currentsector    += nsectors;
-          writesize                = nsectors * fs->fs_hwsectorsize;
-          ff->ff_bflags           |= FFBUFF_MODIFIED;
+          writesize      = nsectors * fs->fs_hwsectorsize;
+          ff->ff_bflags |= FFBUFF_MODIFIED;
         }
       else
 #endif /* CONFIG_FAT_FORCE_INDIRECT */
@@ -1027,6 +1154,10 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
   int32_t cluster;
   off_t position;
   unsigned int clustersize;
+#ifdef CONFIG_FAT_EXTENTS
+  uint32_t known;
+  int fileclust;
+#endif
   int ret;
 
   /* Sanity checks */
@@ -1152,6 +1283,22 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
        */
 
       clustersize = fs->fs_fatsecperclus * fs->fs_hwsectorsize;
+
+#ifdef CONFIG_FAT_EXTENTS
+      /* Skip directly to the last known cluster at or before the
+       * requested position.
+       */
+
+      fat_extentadd(ff, 0, cluster);
+      fileclust = fat_extentlookup(ff, position / clustersize, &known);
+      if (fileclust > 0)
+        {
+          cluster       = known;
+          filep->f_pos  = (off_t)fileclust * clustersize;
+          position     -= filep->f_pos;
+        }
+
+#endif
       for (; ; )
         {
           /* Skip over clusters prior to the one containing
@@ -1218,6 +1365,10 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
               goto errout_with_semaphore;
             }
 
+#ifdef CONFIG_FAT_EXTENTS
+          fat_extentadd(ff, filep->f_pos / clustersize + 1, cluster);
+
+#endif
           /* Otherwise, update the position and continue looking */
 
           filep->f_pos += clustersize;
@@ -1412,6 +1563,21 @@ static int fat_sync(FAR struct file *filep)
       ret          = fat_updatefsinfo(fs);
     }
 
+#ifdef CONFIG_FAT_SECTORCACHE
+  /* Write back all deferred sector writes so that the file (and the FAT
+   * and directory sectors that describe it) actually reach the media.
+   */
+
+  if (ret >= 0)
+    {
+      ret = fat_fscacheflush(fs);
+      if (ret >= 0)
+        {
+          ret = fat_cacheflush(fs);
+        }
+    }
+
+#endif
 errout_with_semaphore:
   fat_semgive(fs);
   return ret;
@@ -1514,6 +1680,10 @@ static int fat_dup(FAR const struct file *oldp, FAR struct file *newp)
   newff->ff_startcluster     = oldff->ff_startcluster;     /* Start cluster of file on media */
   newff->ff_currentsector    = oldff->ff_currentsector;    /* Current sector */
   newff->ff_cachesector      = 0;                          /* Sector in file buffer */
+#ifdef CONFIG_FAT_EXTENTS
+  newff->ff_nextents         = oldff->ff_nextents;         /* Known cluster runs */
+  memcpy(newff->ff_extents, oldff->ff_extents, sizeof(newff->ff_extents));
+#endif
 
   /* Attach the private date to the struct file instance */
 
@@ -1713,6 +1883,9 @@ static int fat_truncate(FAR struct file *filep, off_t length)
   FAR struct inode *inode;
   FAR struct fat_mountpt_s *fs;
   FAR struct fat_file_s *ff;
+#ifdef CONFIG_FAT_EXTENTS
+  FAR struct fat_file_s *tmpff;
+#endif
   off_t oldsize;
   int ret;
 
@@ -1800,6 +1973,22 @@ static int fat_truncate(FAR struct file *filep, off_t length)
           ret = fat_dirshrink(fs, direntry, length);
         }
 
+#ifdef CONFIG_FAT_EXTENTS
+      /* Part of the cluster chain may have been released.  The clusters may
+       * be reallocated to other files, so the extents of every open file
+       * structure that refers to the same directory entry are stale.
+       */
+
+      for (tmpff = fs->fs_head; tmpff != NULL; tmpff = tmpff->ff_next)
+        {
+          if (tmpff->ff_dirsector == ff->ff_dirsector &&
+              tmpff->ff_dirindex == ff->ff_dirindex)
+            {
+              fat_extentinvalidate(tmpff);
+            }
+        }
+#endif
+
       if (ret >= 0)
         {
           /* The truncation has completed without error.  Update the file
@@ -2172,6 +2361,29 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
         }
     }
 
+#ifdef CONFIG_FAT_SECTORCACHE
+  /* Write back and release the sector cache before the block driver is
+   * closed.  There is nothing more that can be done if the write-back
+   * fails (the media may already be gone).
+   */
+
+  if (fs->fs_mounted)
+    {
+      int ret = fat_fscacheflush(fs);
+      if (ret >= 0)
+        {
+          ret = fat_cacheflush(fs);
+        }
+
+      if (ret < 0)
+        {
+          ferr("ERROR: Failed to flush the sector cache: %d\n", ret);
+        }
+    }
+
+  fat_cacheuninitialize(fs);
+
+#endif
   /* Unmount ... close the block driver */
 
   if (fs->fs_blkdriver)
@@ -2204,6 +2416,10 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
       fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
     }
 
+#ifdef CONFIG_FAT_FREEMAP
+  fat_freemapuninitialize(fs);
+#endif
+
   nxsem_destroy(&fs->fs_sem);
   kmm_free(fs);
   return OK;
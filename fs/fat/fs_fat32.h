@@ -867,6 +867,28 @@
  * Public Types
  ****************************************************************************/
 
+#ifdef CONFIG_FAT_SECTORCACHE
+/* This structure describes one sector held in the sector cache */
+
+struct fat_cacheslot_s
+{
+  off_t    cs_sector;              /* Sector held in this slot (-1: unused) */
+  uint32_t cs_lastuse;             /* Value of fs_cacheclock at last access */
+  bool     cs_dirty;               /* true: Sector must be written back */
+};
+#endif
+
+#ifdef CONFIG_FAT_EXTENTS
+/* This structure describes a run of contiguous clusters within a file */
+
+struct fat_extent_s
+{
+  uint32_t fe_fileclust;           /* Index of the first cluster in the file */
+  uint32_t fe_cluster;             /* Cluster number of the first cluster */
+  uint32_t fe_nclusters;           /* Number of contiguous clusters in the run */
+};
+#endif
+
 /* This structure represents the overall mountpoint state.  An instance of this
  * structure is retained as inode private data on each mountpoint that is
  * mounted with a fat32 filesystem.
@@ -901,6 +923,16 @@ struct fat_mountpt_s
   uint8_t  fs_fatsecperclus;       /* MBR: Sectors per allocation unit: 2**n, n=0..7 */
   uint8_t *fs_buffer;              /* This is an allocated buffer to hold one sector
                                     * from the device */
+#ifdef CONFIG_FAT_FREEMAP
+  bool     fs_nofreemap;           /* true: The bitmap could not be allocated */
+  uint32_t *fs_freemap;            /* Bitmap of in-use clusters (NULL: not built) */
+#endif
+#ifdef CONFIG_FAT_SECTORCACHE
+  uint32_t fs_cacheclock;          /* LRU clock: Incremented on each cache access */
+  uint8_t *fs_cache;               /* CONFIG_FAT_NCACHESECTORS contiguous sectors */
+  struct fat_cacheslot_s fs_slots[CONFIG_FAT_NCACHESECTORS];
+  struct block_iovec_s fs_iov[CONFIG_FAT_NCACHESECTORS]; /* For write-back */
+#endif
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -922,6 +954,10 @@ struct fat_file_s
   off_t    ff_currentsector;       /* Current sector being operated on */
   off_t    ff_cachesector;         /* Current sector in the file buffer */
   uint8_t *ff_buffer;              /* File buffer (for partial sector accesses) */
+#ifdef CONFIG_FAT_EXTENTS
+  uint8_t  ff_nextents;            /* Number of valid entries in ff_extents[] */
+  struct fat_extent_s ff_extents[CONFIG_FAT_NEXTENTS];
+#endif
 };
 
 /* This structure holds the sequence of directory entries used by one
@@ -1044,6 +1080,38 @@ EXTERN int    fat_hwread(struct fat_mountpt_s *fs, uint8_t *buffer,
                          off_t sector, unsigned int nsectors);
 EXTERN int    fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer,
                           off_t sector, unsigned int nsectors);
+EXTERN int    fat_hwreadv(struct fat_mountpt_s *fs,
+                          FAR const struct block_iovec_s *iov, int iovcnt);
+EXTERN int    fat_hwwritev(struct fat_mountpt_s *fs,
+                           FAR const struct block_iovec_s *iov, int iovcnt);
+
+EXTERN int    fat_rawread(struct fat_mountpt_s *fs, uint8_t *buffer,
+                          off_t sector, unsigned int nsectors);
+EXTERN int    fat_rawwrite(struct fat_mountpt_s *fs, uint8_t *buffer,
+                           off_t sector, unsigned int nsectors);
+EXTERN int    fat_rawreadv(struct fat_mountpt_s *fs,
+                           FAR const struct block_iovec_s *iov, int iovcnt);
+EXTERN int    fat_rawwritev(struct fat_mountpt_s *fs,
+                            FAR const struct block_iovec_s *iov, int iovcnt);
+
+/* Multi-sector LRU cache beneath fat_hwread() and fat_hwwrite() */
+
+#ifdef CONFIG_FAT_SECTORCACHE
+EXTERN int    fat_cacheinitialize(struct fat_mountpt_s *fs);
+EXTERN void   fat_cacheuninitialize(struct fat_mountpt_s *fs);
+EXTERN int    fat_cacheread(struct fat_mountpt_s *fs, uint8_t *buffer,
+                            off_t sector, unsigned int nsectors);
+EXTERN int    fat_cachewrite(struct fat_mountpt_s *fs, uint8_t *buffer,
+                             off_t sector, unsigned int nsectors);
+EXTERN int    fat_cacheflush(struct fat_mountpt_s *fs);
+EXTERN int    fat_cachesync(struct fat_mountpt_s *fs, off_t sector,
+                            unsigned int nsectors);
+EXTERN void   fat_cacheupdate(struct fat_mountpt_s *fs,
+                              const uint8_t *buffer, off_t sector,
+                              unsigned int nsectors);
+EXTERN void   fat_cachesetdirty(struct fat_mountpt_s *fs, off_t sector,
+                                unsigned int nsectors, bool dirty);
+#endif
 
 /* Cluster / cluster chain access helpers */
 
@@ -1056,6 +1124,27 @@ EXTERN int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster);
 
 #define fat_createchain(fs) fat_extendchain(fs, 0)
 
+/* Free-cluster bitmap */
+
+#ifdef CONFIG_FAT_FREEMAP
+EXTERN int    fat_freemapbuild(struct fat_mountpt_s *fs);
+EXTERN void   fat_freemapupdate(struct fat_mountpt_s *fs, uint32_t cluster,
+                                bool inuse);
+EXTERN uint32_t fat_freemapfind(struct fat_mountpt_s *fs,
+                                uint32_t startcluster);
+EXTERN void   fat_freemapuninitialize(struct fat_mountpt_s *fs);
+#endif
+
+/* Per-file cluster extent cache */
+
+#ifdef CONFIG_FAT_EXTENTS
+EXTERN void   fat_extentadd(struct fat_file_s *ff, uint32_t fileclust,
+                            uint32_t cluster);
+EXTERN int    fat_extentlookup(struct fat_file_s *ff, uint32_t fileclust,
+                               uint32_t *cluster);
+#  define fat_extentinvalidate(ff) ((ff)->ff_nextents = 0)
+#endif
+
 /* Help for traversing directory trees and accessing directory entries */
 
 EXTERN int    fat_nextdirentry(struct fat_mountpt_s *fs, struct fs_fatdir_s *dir);
@@ -0,0 +1,390 @@
+/****************************************************************************
+ * fs/fat/fs_fat32alloc.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/fat.h>
+
+#include "fs_fat32.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define FREEMAP_WORD(c)  ((c) >> 5)
+#define FREEMAP_BIT(c)   ((uint32_t)1 << ((c) & 31))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fat_freemapsearch
+ *
+ * Description:
+ *   Return the first free cluster in the range [first, last) or zero if
+ *   there is none.  Fully allocated words are skipped 32 clusters at a
+ *   time.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_FREEMAP
+static uint32_t fat_freemapsearch(FAR const uint32_t *map, uint32_t first,
+                                  uint32_t last)
+{
+  while (first < last)
+    {
+      uint32_t freebits = ~map[FREEMAP_WORD(first)] &
+                          ~(FREEMAP_BIT(first) - 1);
+
+      if (freebits != 0)
+        {
+          while ((freebits & FREEMAP_BIT(first)) == 0)
+            {
+              first++;
+            }
+
+          return first < last ? first : 0;
+        }
+
+      first = (FREEMAP_WORD(first) + 1) << 5;
+    }
+
+  return 0;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fat_freemapbuild
+ *
+ * Description:
+ *   Build the free-cluster bitmap (if it has not already been built) by
+ *   scanning the entire FAT.  The free cluster count is refreshed as a
+ *   side effect.
+ *
+ * Returned Value:
+ *   OK if the bitmap is available; a negated errno value if the FAT could
+ *   not be read or the bitmap could not be allocated.  The caller should
+ *   then fall back to searching the FAT.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_FREEMAP
+int fat_freemapbuild(FAR struct fat_mountpt_s *fs)
+{
+  FAR uint32_t *map;
+  uint32_t nwords;
+  uint32_t nfree;
+  uint32_t cluster;
+  off_t next;
+
+  if (fs->fs_freemap != NULL)
+    {
+      return OK;
+    }
+
+  /* Don't retry the allocation on every call if there is not enough
+   * memory for the bitmap.
+   */
+
+  if (fs->fs_nofreemap)
+    {
+      return -ENOMEM;
+    }
+
+  nwords = FREEMAP_WORD(fs->fs_nclusters + 31);
+  map    = (FAR uint32_t *)kmm_zalloc(nwords * sizeof(uint32_t));
+  if (map == NULL)
+    {
+      fwarn("WARNING: No memory for a %lu cluster bitmap\n",
+            (unsigned long)fs->fs_nclusters);
+      fs->fs_nofreemap = true;
+      return -ENOMEM;
+    }
+
+  /* Clusters 0 and 1 are reserved and the bits beyond the last cluster do
+   * not correspond to any cluster:  Mark them all as in use.
+   */
+
+  map[0] |= FREEMAP_BIT(0) | FREEMAP_BIT(1);
+  for (cluster = fs->fs_nclusters; cluster < (nwords << 5); cluster++)
+    {
+      map[FREEMAP_WORD(cluster)] |= FREEMAP_BIT(cluster);
+    }
+
+  /* Then scan the FAT.  Consecutive entries lie in the same sector so this
+   * costs one sector read per FAT sector.
+   */
+
+  nfree = 0;
+  for (cluster = 2; cluster < fs->fs_nclusters; cluster++)
+    {
+      next = fat_getcluster(fs, cluster);
+      if (next < 0)
+        {
+          kmm_free(map);
+          return (int)next;
+        }
+      else if (next != 0)
+        {
+          map[FREEMAP_WORD(cluster)] |= FREEMAP_BIT(cluster);
+        }
+      else
+        {
+          nfree++;
+        }
+    }
+
+  fs->fs_freemap = map;
+
+  /* Now we know the real free cluster count */
+
+  if (fs->fs_fsifreecount != nfree)
+    {
+      fs->fs_fsifreecount = nfree;
+      if (fs->fs_type == FSTYPE_FAT32)
+        {
+          fs->fs_fsidirty = true;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_freemapupdate
+ *
+ * Description:
+ *   Called by fat_putcluster() whenever a FAT entry is written to keep the
+ *   bitmap in agreement with the FAT.
+ *
+ ****************************************************************************/
+
+void fat_freemapupdate(FAR struct fat_mountpt_s *fs, uint32_t cluster,
+                       bool inuse)
+{
+  if (fs->fs_freemap != NULL && cluster >= 2 && cluster < fs->fs_nclusters)
+    {
+      if (inuse)
+        {
+          fs->fs_freemap[FREEMAP_WORD(cluster)] |= FREEMAP_BIT(cluster);
+        }
+      else
+        {
+          fs->fs_freemap[FREEMAP_WORD(cluster)] &= ~FREEMAP_BIT(cluster);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: fat_freemapfind
+ *
+ * Description:
+ *   Find a free cluster using the bitmap.  The search starts just after
+ *   'startcluster' and wraps around to the beginning of the FAT.
+ *
+ * Returned Value:
+ *   The free cluster number or zero if there are no free clusters.
+ *
+ ****************************************************************************/
+
+uint32_t fat_freemapfind(FAR struct fat_mountpt_s *fs, uint32_t startcluster)
+{
+  uint32_t cluster;
+
+  if (startcluster < 2 || startcluster >= fs->fs_nclusters)
+    {
+      startcluster = 1;
+    }
+
+  cluster = fat_freemapsearch(fs->fs_freemap, startcluster + 1,
+                              fs->fs_nclusters);
+  if (cluster == 0)
+    {
+      cluster = fat_freemapsearch(fs->fs_freemap, 2, startcluster + 1);
+    }
+
+  return cluster;
+}
+
+/****************************************************************************
+ * Name: fat_freemapuninitialize
+ *
+ * Description:
+ *   Free the bitmap when the volume is unmounted.
+ *
+ ****************************************************************************/
+
+void fat_freemapuninitialize(FAR struct fat_mountpt_s *fs)
+{
+  if (fs->fs_freemap != NULL)
+    {
+      kmm_free(fs->fs_freemap);
+      fs->fs_freemap = NULL;
+    }
+}
+#endif /* CONFIG_FAT_FREEMAP */
+
+/****************************************************************************
+ * Name: fat_extentadd
+ *
+ * Description:
+ *   Record that cluster number 'cluster' is the 'fileclust'th cluster of
+ *   the file.  Only the prefix of the cluster chain beginning at the start
+ *   of the file is remembered:  The cluster is recorded only if it
+ *   immediately follows the last known cluster.  It extends the last run if
+ *   it is also physically contiguous; otherwise a new run is begun (if
+ *   there is space).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_EXTENTS
+void fat_extentadd(FAR struct fat_file_s *ff, uint32_t fileclust,
+                   uint32_t cluster)
+{
+  FAR struct fat_extent_s *ext;
+
+  if (ff->ff_nextents == 0)
+    {
+      if (fileclust != 0)
+        {
+          return;
+        }
+
+      ext = &ff->ff_extents[0];
+    }
+  else
+    {
+      ext = &ff->ff_extents[ff->ff_nextents - 1];
+      if (fileclust != ext->fe_fileclust + ext->fe_nclusters)
+        {
+          return;
+        }
+
+      if (cluster == ext->fe_cluster + ext->fe_nclusters)
+        {
+          ext->fe_nclusters++;
+          return;
+        }
+
+      if (ff->ff_nextents >= CONFIG_FAT_NEXTENTS)
+        {
+          return;
+        }
+
+      ext++;
+    }
+
+  ext->fe_fileclust = fileclust;
+  ext->fe_cluster   = cluster;
+  ext->fe_nclusters = 1;
+  ff->ff_nextents++;
+}
+
+/****************************************************************************
+ * Name: fat_extentlookup
+ *
+ * Description:
+ *   Find the cluster number of the 'fileclust'th cluster of the file or, if
+ *   that cluster is beyond the known runs, of the last known cluster.  A
+ *   binary search is used so the cost is O(log extents).
+ *
+ * Returned Value:
+ *   The index within the file of the cluster returned in 'cluster' (which
+ *   is less than or equal to 'fileclust') or -ENOENT if nothing is known
+ *   about the file.
+ *
+ ****************************************************************************/
+
+int fat_extentlookup(FAR struct fat_file_s *ff, uint32_t fileclust,
+                     FAR uint32_t *cluster)
+{
+  FAR struct fat_extent_s *ext;
+  uint32_t offset;
+  int low;
+  int high;
+
+  if (ff->ff_nextents == 0)
+    {
+      return -ENOENT;
+    }
+
+  /* Find the last run that begins at or before 'fileclust'.  The first run
+   * always begins at file cluster zero.
+   */
+
+  low  = 0;
+  high = ff->ff_nextents - 1;
+
+  while (low < high)
+    {
+      int mid = (low + high + 1) >> 1;
+      if (ff->ff_extents[mid].fe_fileclust <= fileclust)
+        {
+          low = mid;
+        }
+      else
+        {
+          high = mid - 1;
+        }
+    }
+
+  ext    = &ff->ff_extents[low];
+  offset = fileclust - ext->fe_fileclust;
+  if (offset >= ext->fe_nclusters)
+    {
+      offset = ext->fe_nclusters - 1;
+    }
+
+  *cluster = ext->fe_cluster + offset;
+  return (int)(ext->fe_fileclust + offset);
+}
+#endif /* CONFIG_FAT_EXTENTS */
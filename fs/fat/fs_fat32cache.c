@@ -0,0 +1,611 @@
+/****************************************************************************
+ * fs/fat/fs_fat32cache.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/fat.h>
+
+#include "fs_fat32.h"
+
+#ifdef CONFIG_FAT_SECTORCACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* No single transfer (including read-ahead) may displace more than half of
+ * the cache.  Larger transfers bypass the cache altogether.
+ */
+
+#define FAT_CACHE_MAXRUN       (CONFIG_FAT_NCACHESECTORS / 2)
+
+/* Address of the sector buffer associated with a cache slot */
+
+#define FAT_CACHE_BUFFER(fs,n) (&(fs)->fs_cache[(n) * (fs)->fs_hwsectorsize])
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fat_cachefind
+ *
+ * Description:
+ *   Return the index of the cache slot holding 'sector' or -1 if the
+ *   sector is not cached.  The cache is small so a linear search is used.
+ *
+ ****************************************************************************/
+
+static int fat_cachefind(FAR struct fat_mountpt_s *fs, off_t sector)
+{
+  int ndx;
+
+  for (ndx = 0; ndx < CONFIG_FAT_NCACHESECTORS; ndx++)
+    {
+      if (fs->fs_slots[ndx].cs_sector == sector)
+        {
+          return ndx;
+        }
+    }
+
+  return -1;
+}
+
+/****************************************************************************
+ * Name: fat_cachetouch
+ *
+ * Description:
+ *   Mark a cache slot as the most recently used.
+ *
+ ****************************************************************************/
+
+static inline void fat_cachetouch(FAR struct fat_mountpt_s *fs, int ndx)
+{
+  fs->fs_slots[ndx].cs_lastuse = ++fs->fs_cacheclock;
+}
+
+/****************************************************************************
+ * Name: fat_cacheage
+ *
+ * Description:
+ *   Return the number of cache accesses since the slot was last used.
+ *   Unused slots are the oldest possible.  The unsigned subtraction keeps
+ *   the ordering correct when the LRU clock wraps.
+ *
+ ****************************************************************************/
+
+static uint32_t fat_cacheage(FAR struct fat_mountpt_s *fs, int ndx)
+{
+  if (fs->fs_slots[ndx].cs_sector < 0)
+    {
+      return UINT32_MAX;
+    }
+
+  return fs->fs_cacheclock - fs->fs_slots[ndx].cs_lastuse;
+}
+
+/****************************************************************************
+ * Name: fat_cachewriteback
+ *
+ * Description:
+ *   Write back the dirty sector in slot 'ndx'.  All dirty sectors that are
+ *   contiguous with it on the media are written in the same (vectored)
+ *   transfer, wherever they are held in the cache.
+ *
+ ****************************************************************************/
+
+static int fat_cachewriteback(FAR struct fat_mountpt_s *fs, int ndx)
+{
+  FAR struct fat_cacheslot_s *slots = fs->fs_slots;
+  FAR struct block_iovec_s *iov = fs->fs_iov;
+  off_t first;
+  off_t sector;
+  int niov;
+  int prev;
+  int ret;
+
+  /* Find the first sector of the run of dirty sectors */
+
+  first = slots[ndx].cs_sector;
+  while (first > 0 && (prev = fat_cachefind(fs, first - 1)) >= 0 &&
+         slots[prev].cs_dirty)
+    {
+      first--;
+    }
+
+  /* Then describe the run, using one segment for each group of sectors
+   * that are also held in neighboring slots.
+   */
+
+  niov = 0;
+  prev = -1;
+
+  for (sector = first;
+       (ndx = fat_cachefind(fs, sector)) >= 0 && slots[ndx].cs_dirty;
+       sector++)
+    {
+      if (niov > 0 && ndx == prev + 1)
+        {
+          iov[niov - 1].bv_nsectors++;
+        }
+      else
+        {
+          iov[niov].bv_sector   = sector;
+          iov[niov].bv_nsectors = 1;
+          iov[niov].bv_buffer   = FAT_CACHE_BUFFER(fs, ndx);
+          niov++;
+        }
+
+      prev = ndx;
+    }
+
+  ret = fat_rawwritev(fs, iov, niov);
+  if (ret < 0)
+    {
+      ferr("ERROR: Failed to write back %ld sectors at %ld: %d\n",
+           (long)(sector - first), (long)first, ret);
+      return ret;
+    }
+
+  for (ndx = 0; ndx < CONFIG_FAT_NCACHESECTORS; ndx++)
+    {
+      if (slots[ndx].cs_sector >= first && slots[ndx].cs_sector < sector)
+        {
+          slots[ndx].cs_dirty = false;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cacheselect
+ *
+ * Description:
+ *   Select 'count' adjacent cache slots to receive sectors beginning with
+ *   'sector', writing back and discarding their current content.  Adjacent
+ *   slots are required so that a multi-sector read (or write-back) can be
+ *   performed as one transfer.
+ *
+ * Returned Value:
+ *   The index of the first selected slot or a negated errno value.
+ *
+ ****************************************************************************/
+
+static int fat_cacheselect(FAR struct fat_mountpt_s *fs, off_t sector,
+                           int count)
+{
+  FAR struct fat_cacheslot_s *slots = fs->fs_slots;
+  uint32_t bestage = 0;
+  int best = 0;
+  int start;
+  int ndx;
+  int ret;
+
+  /* A single sector that follows a cached sector is placed in the next
+   * slot (if that slot is not busier than its neighbor) so that sequential
+   * writes are laid out contiguously and can be written back as a single
+   * segment.
+   */
+
+  if (count == 1 && sector > 0)
+    {
+      int prev = fat_cachefind(fs, sector - 1);
+      if (prev >= 0 && prev + 1 < CONFIG_FAT_NCACHESECTORS &&
+          !slots[prev + 1].cs_dirty &&
+          fat_cacheage(fs, prev + 1) > fat_cacheage(fs, prev))
+        {
+          best = prev + 1;
+          goto evict;
+        }
+    }
+
+  /* Otherwise, select the window whose most recently used slot is the
+   * least recently used.
+   */
+
+  for (start = 0; start + count <= CONFIG_FAT_NCACHESECTORS; start++)
+    {
+      uint32_t minage = UINT32_MAX;
+
+      for (ndx = start; ndx < start + count; ndx++)
+        {
+          uint32_t age = fat_cacheage(fs, ndx);
+          if (age < minage)
+            {
+              minage = age;
+            }
+        }
+
+      if (minage > bestage)
+        {
+          bestage = minage;
+          best    = start;
+        }
+    }
+
+evict:
+  for (ndx = best; ndx < best + count; ndx++)
+    {
+      if (slots[ndx].cs_dirty)
+        {
+          ret = fat_cachewriteback(fs, ndx);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+
+      slots[ndx].cs_sector = -1;
+    }
+
+  return best;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fat_cacheinitialize
+ *
+ * Description:
+ *   Allocate the sector cache.  Called from fat_mount() once the sector
+ *   size is known.
+ *
+ ****************************************************************************/
+
+int fat_cacheinitialize(FAR struct fat_mountpt_s *fs)
+{
+  int ndx;
+
+  fs->fs_cache = (FAR uint8_t *)
+    fat_io_alloc(CONFIG_FAT_NCACHESECTORS * fs->fs_hwsectorsize);
+
+  if (fs->fs_cache == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (ndx = 0; ndx < CONFIG_FAT_NCACHESECTORS; ndx++)
+    {
+      fs->fs_slots[ndx].cs_sector  = -1;
+      fs->fs_slots[ndx].cs_lastuse = 0;
+      fs->fs_slots[ndx].cs_dirty   = false;
+    }
+
+  fs->fs_cacheclock = 0;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cacheuninitialize
+ *
+ * Description:
+ *   Free the sector cache.  Any dirty sectors are discarded; the caller
+ *   should call fat_cacheflush() first.
+ *
+ ****************************************************************************/
+
+void fat_cacheuninitialize(FAR struct fat_mountpt_s *fs)
+{
+  if (fs->fs_cache != NULL)
+    {
+      fat_io_free(fs->fs_cache,
+                  CONFIG_FAT_NCACHESECTORS * fs->fs_hwsectorsize);
+      fs->fs_cache = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: fat_cacheread
+ *
+ * Description:
+ *   Read sectors through the cache.  A miss that follows an access to the
+ *   preceding sector is treated as sequential and extended by
+ *   CONFIG_FAT_READAHEAD sectors.  Transfers larger than half the cache
+ *   go directly to the block driver.
+ *
+ ****************************************************************************/
+
+int fat_cacheread(FAR struct fat_mountpt_s *fs, FAR uint8_t *buffer,
+                  off_t sector, unsigned int nsectors)
+{
+  FAR struct fat_cacheslot_s *slots = fs->fs_slots;
+  int ndx;
+  int ret;
+
+  if (nsectors > FAT_CACHE_MAXRUN)
+    {
+      ret = fat_cachesync(fs, sector, nsectors);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      return fat_rawread(fs, buffer, sector, nsectors);
+    }
+
+  for (; nsectors > 0; nsectors--, sector++)
+    {
+      ndx = fat_cachefind(fs, sector);
+      if (ndx < 0)
+        {
+          off_t count = nsectors;
+          off_t i;
+
+          if (sector > 0 && fat_cachefind(fs, sector - 1) >= 0)
+            {
+              count += CONFIG_FAT_READAHEAD;
+            }
+
+          if (count > FAT_CACHE_MAXRUN)
+            {
+              count = FAT_CACHE_MAXRUN;
+            }
+
+          if (sector + count > fs->fs_hwnsectors)
+            {
+              count = fs->fs_hwnsectors > sector ?
+                      fs->fs_hwnsectors - sector : 1;
+            }
+
+          /* Don't read a second copy of a sector that is already cached */
+
+          for (i = 1; i < count; i++)
+            {
+              if (fat_cachefind(fs, sector + i) >= 0)
+                {
+                  count = i;
+                  break;
+                }
+            }
+
+          ndx = fat_cacheselect(fs, sector, count);
+          if (ndx < 0)
+            {
+              return ndx;
+            }
+
+          ret = fat_rawread(fs, FAT_CACHE_BUFFER(fs, ndx), sector, count);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          for (i = 0; i < count; i++)
+            {
+              slots[ndx + i].cs_sector = sector + i;
+              slots[ndx + i].cs_dirty  = false;
+              fat_cachetouch(fs, ndx + i);
+            }
+        }
+
+      memcpy(buffer, FAT_CACHE_BUFFER(fs, ndx), fs->fs_hwsectorsize);
+      fat_cachetouch(fs, ndx);
+      buffer += fs->fs_hwsectorsize;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cachewrite
+ *
+ * Description:
+ *   Write sectors through the cache.  The sectors are only marked dirty;
+ *   they reach the media when evicted or when fat_cacheflush() is called.
+ *   Transfers larger than half the cache go directly to the block driver.
+ *
+ ****************************************************************************/
+
+int fat_cachewrite(FAR struct fat_mountpt_s *fs, FAR uint8_t *buffer,
+                   off_t sector, unsigned int nsectors)
+{
+  FAR struct fat_cacheslot_s *slots = fs->fs_slots;
+  int ndx;
+  int ret;
+
+  if (nsectors > FAT_CACHE_MAXRUN)
+    {
+      /* Update any cached copies in the range, then write the range.  The
+       * copies are clean if the write succeeds; otherwise they are left
+       * dirty so that the new data will be written again later.
+       */
+
+      fat_cacheupdate(fs, buffer, sector, nsectors);
+      ret = fat_rawwrite(fs, buffer, sector, nsectors);
+      fat_cachesetdirty(fs, sector, nsectors, ret < 0);
+      return ret;
+    }
+
+  for (; nsectors > 0; nsectors--, sector++)
+    {
+      ndx = fat_cachefind(fs, sector);
+      if (ndx < 0)
+        {
+          ndx = fat_cacheselect(fs, sector, 1);
+          if (ndx < 0)
+            {
+              return ndx;
+            }
+
+          slots[ndx].cs_sector = sector;
+        }
+
+      memcpy(FAT_CACHE_BUFFER(fs, ndx), buffer, fs->fs_hwsectorsize);
+      slots[ndx].cs_dirty = true;
+      fat_cachetouch(fs, ndx);
+      buffer += fs->fs_hwsectorsize;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cachesync
+ *
+ * Description:
+ *   Write back any dirty cached sectors in the range so that the media
+ *   holds the latest copy.  Used before the range is read from the media
+ *   without going through the cache.
+ *
+ ****************************************************************************/
+
+int fat_cachesync(FAR struct fat_mountpt_s *fs, off_t sector,
+                  unsigned int nsectors)
+{
+  FAR struct fat_cacheslot_s *slots = fs->fs_slots;
+  int ndx;
+  int ret;
+
+  for (ndx = 0; ndx < CONFIG_FAT_NCACHESECTORS; ndx++)
+    {
+      if (slots[ndx].cs_dirty && slots[ndx].cs_sector >= sector &&
+          slots[ndx].cs_sector < sector + nsectors)
+        {
+          ret = fat_cachewriteback(fs, ndx);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cacheupdate
+ *
+ * Description:
+ *   Copy new data for the range into any cached copies of its sectors.
+ *   Used before the range is written to the media without going through
+ *   the cache.
+ *
+ ****************************************************************************/
+
+void fat_cacheupdate(FAR struct fat_mountpt_s *fs, FAR const uint8_t *buffer,
+                     off_t sector, unsigned int nsectors)
+{
+  FAR struct fat_cacheslot_s *slots = fs->fs_slots;
+  off_t offset;
+  int ndx;
+
+  for (ndx = 0; ndx < CONFIG_FAT_NCACHESECTORS; ndx++)
+    {
+      offset = slots[ndx].cs_sector - sector;
+      if (slots[ndx].cs_sector >= 0 && offset >= 0 && offset < nsectors)
+        {
+          memcpy(FAT_CACHE_BUFFER(fs, ndx),
+                 &buffer[offset * fs->fs_hwsectorsize],
+                 fs->fs_hwsectorsize);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: fat_cachesetdirty
+ *
+ * Description:
+ *   Mark any cached copies of the sectors in the range clean (after they
+ *   were written to the media) or dirty (if that write failed).
+ *
+ ****************************************************************************/
+
+void fat_cachesetdirty(FAR struct fat_mountpt_s *fs, off_t sector,
+                       unsigned int nsectors, bool dirty)
+{
+  FAR struct fat_cacheslot_s *slots = fs->fs_slots;
+  int ndx;
+
+  for (ndx = 0; ndx < CONFIG_FAT_NCACHESECTORS; ndx++)
+    {
+      if (slots[ndx].cs_sector >= sector &&
+          slots[ndx].cs_sector < sector + nsectors)
+        {
+          slots[ndx].cs_dirty = dirty;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: fat_cacheflush
+ *
+ * Description:
+ *   Write back all dirty sectors in the cache.  Runs of dirty sectors that
+ *   are contiguous on the media are written with a single transfer.
+ *
+ ****************************************************************************/
+
+int fat_cacheflush(FAR struct fat_mountpt_s *fs)
+{
+  int ndx;
+  int ret;
+
+  if (fs->fs_cache == NULL)
+    {
+      return OK;
+    }
+
+  for (ndx = 0; ndx < CONFIG_FAT_NCACHESECTORS; ndx++)
+    {
+      if (fs->fs_slots[ndx].cs_dirty)
+        {
+          ret = fat_cachewriteback(fs, ndx);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return OK;
+}
+
+#endif /* CONFIG_FAT_SECTORCACHE */
@@ -278,6 +278,92 @@ static int fat_checkbootrecord(struct fat_mountpt_s *fs)
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_findfreecluster
+ *
+ * Description:
+ *   Find a free cluster, searching forward from the cluster after
+ *   'startcluster' and wrapping around to the beginning of the FAT.  The
+ *   free-cluster bitmap is used if it is available; otherwise the FAT is
+ *   read one entry at a time.
+ *
+ * Returned Value:
+ *   <0:error, 0: no free cluster, >=2: free cluster number
+ *
+ ****************************************************************************/
+
+static int32_t fat_findfreecluster(struct fat_mountpt_s *fs,
+                                   uint32_t startcluster)
+{
+  off_t    startsector;
+  uint32_t newcluster;
+
+#ifdef CONFIG_FAT_FREEMAP
+  if (fat_freemapbuild(fs) >= 0)
+    {
+      return (int32_t)fat_freemapfind(fs, startcluster);
+    }
+
+#endif
+  /* Loop until (1) we discover that there are not free clusters
+   * (return 0), an errors occurs (return -errno), or (3) we find
+   * the next cluster (return the new cluster number).
+   */
+
+  newcluster = startcluster;
+  for (; ; )
+    {
+      /* Examine the next cluster in the FAT */
+
+      newcluster++;
+      if (newcluster >= fs->fs_nclusters)
+        {
+          /* If we hit the end of the available clusters, then
+           * wrap back to the beginning because we might have
+           * started at a non-optimal place.  But don't continue
+           * past the start cluster.
+           */
+
+          newcluster = 2;
+          if (newcluster > startcluster)
+            {
+              /* We are back past the starting cluster, then there
+               * is no free cluster.
+               */
+
+              return 0;
+            }
+        }
+
+      /* We have a candidate cluster.  Check if the cluster number is
+       * mapped to a group of sectors.
+       */
+
+      startsector = fat_getcluster(fs, newcluster);
+      if (startsector == 0)
+        {
+          /* Found have found a free cluster */
+
+          return newcluster;
+        }
+      else if (startsector < 0)
+        {
+          /* Some error occurred, return the error number */
+
+          return startsector;
+        }
+
+      /* We wrap all the back to the starting cluster?  If so, then
+       * there are no free clusters.
+       */
+
+      if (newcluster == startcluster)
+        {
+          return 0;
+        }
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -663,6 +749,18 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
         }
     }
 
+#ifdef CONFIG_FAT_SECTORCACHE
+  /* Now that the geometry of the volume is known, allocate the sector
+   * cache.  All subsequent sector I/O will go through the cache.
+   */
+
+  ret = fat_cacheinitialize(fs);
+  if (ret < 0)
+    {
+      goto errout_with_buffer;
+    }
+
+#endif
   /* We did it! */
 
   finfo("FAT%d:\n", fs->fs_type == 0 ? 12 : fs->fs_type == 1  ? 16 : 32);
@@ -741,12 +839,129 @@ int fat_checkmount(struct fat_mountpt_s *fs)
  * Name: fat_hwread
  *
  * Description:
- *   Read the specified sector into the sector buffer
+ *   Read the specified sector into the sector buffer.  The read is satisfied
+ *   from the sector cache, if there is one.
  *
  ****************************************************************************/
 
 int fat_hwread(struct fat_mountpt_s *fs, uint8_t *buffer,  off_t sector,
                unsigned int nsectors)
+{
+#ifdef CONFIG_FAT_SECTORCACHE
+  if (fs != NULL && fs->fs_cache != NULL)
+    {
+      return fat_cacheread(fs, buffer, sector, nsectors);
+    }
+#endif
+
+  return fat_rawread(fs, buffer, sector, nsectors);
+}
+
+/****************************************************************************
+ * Name: fat_hwwrite
+ *
+ * Description:
+ *   Write the sector buffer to the specified sector.  If there is a sector
+ *   cache, then the write may be deferred until the cache is flushed.
+ *
+ ****************************************************************************/
+
+int fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
+                unsigned int nsectors)
+{
+#ifdef CONFIG_FAT_SECTORCACHE
+  if (fs != NULL && fs->fs_cache != NULL)
+    {
+      return fat_cachewrite(fs, buffer, sector, nsectors);
+    }
+#endif
+
+  return fat_rawwrite(fs, buffer, sector, nsectors);
+}
+
+/****************************************************************************
+ * Name: fat_hwreadv
+ *
+ * Description:
+ *   Read a list of sector segments as one vectored request.  The request
+ *   bypasses the sector cache, but any dirty cached copies of the sectors
+ *   are written back first.
+ *
+ ****************************************************************************/
+
+int fat_hwreadv(struct fat_mountpt_s *fs, FAR const struct block_iovec_s *iov,
+                int iovcnt)
+{
+#ifdef CONFIG_FAT_SECTORCACHE
+  int ret;
+  int i;
+
+  if (fs != NULL && fs->fs_cache != NULL)
+    {
+      for (i = 0; i < iovcnt; i++)
+        {
+          ret = fat_cachesync(fs, iov[i].bv_sector, iov[i].bv_nsectors);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+#endif
+
+  return fat_rawreadv(fs, iov, iovcnt);
+}
+
+/****************************************************************************
+ * Name: fat_hwwritev
+ *
+ * Description:
+ *   Write a list of sector segments as one vectored request.  The request
+ *   bypasses the sector cache, but any cached copies of the sectors are
+ *   updated.
+ *
+ ****************************************************************************/
+
+int fat_hwwritev(struct fat_mountpt_s *fs,
+                 FAR const struct block_iovec_s *iov, int iovcnt)
+{
+#ifdef CONFIG_FAT_SECTORCACHE
+  int ret;
+  int i;
+
+  if (fs != NULL && fs->fs_cache != NULL)
+    {
+      for (i = 0; i < iovcnt; i++)
+        {
+          fat_cacheupdate(fs, iov[i].bv_buffer, iov[i].bv_sector,
+                          iov[i].bv_nsectors);
+        }
+
+      ret = fat_rawwritev(fs, iov, iovcnt);
+
+      for (i = 0; i < iovcnt; i++)
+        {
+          fat_cachesetdirty(fs, iov[i].bv_sector, iov[i].bv_nsectors,
+                            ret < 0);
+        }
+
+      return ret;
+    }
+#endif
+
+  return fat_rawwritev(fs, iov, iovcnt);
+}
+
+/****************************************************************************
+ * Name: fat_rawread
+ *
+ * Description:
+ *   Read the specified sector(s) directly from the block driver
+ *
+ ****************************************************************************/
+
+int fat_rawread(struct fat_mountpt_s *fs, uint8_t *buffer,  off_t sector,
+                unsigned int nsectors)
 {
   int ret = -ENODEV;
   if (fs && fs->fs_blkdriver)
@@ -771,15 +986,15 @@ int fat_hwread(struct fat_mountpt_s *fs, uint8_t *buffer,  off_t sector,
 }
 
 /****************************************************************************
- * Name: fat_hwwrite
+ * Name: fat_rawwrite
  *
  * Description:
- *   Write the sector buffer to the specified sector
+ *   Write the sector(s) directly to the block driver
  *
  ****************************************************************************/
 
-int fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
-                unsigned int nsectors)
+int fat_rawwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
+                 unsigned int nsectors)
 {
   int ret = -ENODEV;
   if (fs && fs->fs_blkdriver)
@@ -804,6 +1019,90 @@ int fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
   return ret;
 }
 
+/****************************************************************************
+ * Name: fat_rawreadv
+ *
+ * Description:
+ *   Read a list of sector segments directly from the block driver as one
+ *   vectored request.
+ *
+ ****************************************************************************/
+
+int fat_rawreadv(struct fat_mountpt_s *fs,
+                 FAR const struct block_iovec_s *iov, int iovcnt)
+{
+  int ret = -ENODEV;
+  if (fs && fs->fs_blkdriver)
+    {
+      struct inode *inode = fs->fs_blkdriver;
+      if (inode && inode->u.i_bops &&
+          (inode->u.i_bops->readv || inode->u.i_bops->read))
+        {
+          ssize_t nsectorsread = block_readv(inode, iov, iovcnt);
+          ssize_t nsectors = 0;
+          int i;
+
+          for (i = 0; i < iovcnt; i++)
+            {
+              nsectors += iov[i].bv_nsectors;
+            }
+
+          if (nsectorsread == nsectors)
+            {
+              ret = OK;
+            }
+          else if (nsectorsread < 0)
+            {
+              ret = nsectorsread;
+            }
+        }
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: fat_rawwritev
+ *
+ * Description:
+ *   Write a list of sector segments directly to the block driver as one
+ *   vectored request.
+ *
+ ****************************************************************************/
+
+int fat_rawwritev(struct fat_mountpt_s *fs,
+                  FAR const struct block_iovec_s *iov, int iovcnt)
+{
+  int ret = -ENODEV;
+  if (fs && fs->fs_blkdriver)
+    {
+      struct inode *inode = fs->fs_blkdriver;
+      if (inode && inode->u.i_bops &&
+          (inode->u.i_bops->writev || inode->u.i_bops->write))
+        {
+          ssize_t nsectorswritten = block_writev(inode, iov, iovcnt);
+          ssize_t nsectors = 0;
+          int i;
+
+          for (i = 0; i < iovcnt; i++)
+            {
+              nsectors += iov[i].bv_nsectors;
+            }
+
+          if (nsectorswritten == nsectors)
+            {
+              ret = OK;
+            }
+          else if (nsectorswritten < 0)
+            {
+              ret = nsectorswritten;
+            }
+        }
+    }
+
+  return ret;
+}
+
 /****************************************************************************
  * Name: fat_cluster2sector
  *
@@ -1112,6 +1411,12 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
             return -EINVAL;
         }
 
+#ifdef CONFIG_FAT_FREEMAP
+      /* Keep the free-cluster bitmap in agreement with the FAT */
+
+      fat_freemapupdate(fs, clusterno, nextcluster != 0);
+
+#endif
       /* Mark the modified sector as "dirty" and return success */
 
       fs->fs_dirty = true;
@@ -1189,6 +1494,7 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
   off_t    startsector;
   uint32_t newcluster;
   uint32_t startcluster;
+  int32_t  found;
   int      ret;
 
   /* The special value 0 is used when the new chain should start */
@@ -1238,64 +1544,18 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
       startcluster = cluster;
     }
 
-  /* Loop until (1) we discover that there are not free clusters
-   * (return 0), an errors occurs (return -errno), or (3) we find
-   * the next cluster (return the new cluster number).
-   */
+  /* Find a free cluster, starting the search after startcluster */
 
-  newcluster = startcluster;
-  for (; ; )
+  found = fat_findfreecluster(fs, startcluster);
+  if (found <= 0)
     {
-      /* Examine the next cluster in the FAT */
-
-      newcluster++;
-      if (newcluster >= fs->fs_nclusters)
-        {
-          /* If we hit the end of the available clusters, then
-           * wrap back to the beginning because we might have
-           * started at a non-optimal place.  But don't continue
-           * past the start cluster.
-           */
-
-          newcluster = 2;
-          if (newcluster > startcluster)
-            {
-              /* We are back past the starting cluster, then there
-               * is no free cluster.
-               */
-
-              return 0;
-            }
-        }
+      /* No free cluster (0) or an error occurred (-errno) */
 
-      /* We have a candidate cluster.  Check if the cluster number is
-       * mapped to a group of sectors.
-       */
-
-      startsector = fat_getcluster(fs, newcluster);
-      if (startsector == 0)
-        {
-          /* Found have found a free cluster break out */
-
-          break;
-        }
-      else if (startsector < 0)
-        {
-          /* Some error occurred, return the error number */
-
-          return startsector;
-        }
-
-      /* We wrap all the back to the starting cluster?  If so, then
-       * there are no free clusters.
-       */
-
-      if (newcluster == startcluster)
-        {
-          return 0;
-        }
+      return found;
     }
 
+  newcluster = (uint32_t)found;
+
   /* We get here only if we break out with an available cluster
    * number in 'newcluster'  Now mark that cluster as in-use.
    */
@@ -1680,6 +1940,11 @@ int fat_dirextend(FAR struct fat_mountpt_s *fs, FAR struct fat_file_s *ff,
               return -ENOSPC;
             }
 
+#ifdef CONFIG_FAT_EXTENTS
+          fat_extentadd(ff, pos / (fs->fs_fatsecperclus *
+                                   fs->fs_hwsectorsize), cluster);
+
+#endif
           /* Setup to zero the first sector from the new cluster */
 
           ff->ff_currentcluster   = cluster;
@@ -2054,6 +2319,17 @@ int fat_nfreeclusters(struct fat_mountpt_s *fs, off_t *pfreeclusters)
       return OK;
     }
 
+#ifdef CONFIG_FAT_FREEMAP
+  /* Building the free-cluster bitmap also counts the free clusters */
+
+  if (fat_freemapbuild(fs) >= 0 &&
+      fs->fs_fsifreecount <= fs->fs_nclusters - 2)
+    {
+      *pfreeclusters = fs->fs_fsifreecount;
+      return OK;
+    }
+
+#endif
   /* Otherwise, we will have to count the number of free clusters */
 
   nfreeclusters = 0;
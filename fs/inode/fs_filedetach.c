@@ -133,8 +133,8 @@ int file_detach(int fd, FAR struct file *filep)
   /* If the file was properly opened, there should be an inode assigned */
 
   _files_semtake(list);
-  parent = &list->fl_files[fd];
-  if (parent->f_inode == NULL)
+  parent = files_fget(list, fd);
+  if (parent == NULL || parent->f_inode == NULL)
     {
       /* File is not open */
 
@@ -142,6 +142,13 @@ int file_detach(int fd, FAR struct file *filep)
       return -EBADF;
     }
 
+  /* The descriptor is going away, so remove it from any epoll interest
+   * lists, as close does.  The epoll items refer to the file structure in
+   * the list, which is about to be cleared.
+   */
+
+  epoll_release(parent);
+
   /* Duplicate the 'struct file' content into the user-provided file
    * structure.
    */
@@ -161,6 +168,7 @@ int file_detach(int fd, FAR struct file *filep)
   parent->f_inode  = NULL;
   parent->f_priv   = NULL;
 
+  files_clrused(list, fd);
   _files_semgive(list);
   return OK;
 }
@@ -42,6 +42,7 @@
 
 #include <sys/types.h>
 #include <string.h>
+#include <strings.h>
 #include <semaphore.h>
 #include <assert.h>
 #include <sched.h>
@@ -49,9 +50,22 @@
 
 #include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/spinlock.h>
 
 #include "inode/inode.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* A new row of file structures must be visible before the pointer to it
+ * (see _files_extend() and files_fget()).
+ */
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -85,6 +99,120 @@ static void _files_semtake(FAR struct filelist *list)
 
 #define _files_semgive(list) nxsem_post(&list->fl_sem)
 
+/****************************************************************************
+ * Name: _files_setused
+ *
+ * Description:
+ *   Mark a file descriptor as in use.  See files_clrused() for the reverse.
+ *
+ ****************************************************************************/
+
+#define _files_setused(list,fd) \
+  ((list)->fl_used[(fd) >> 5] |= (uint32_t)1 << ((fd) & 31))
+
+/****************************************************************************
+ * Name: _files_index
+ *
+ * Description:
+ *   Return the file descriptor of a file structure in the list, or -1 if
+ *   the structure is not part of the list.
+ *
+ ****************************************************************************/
+
+static int _files_index(FAR struct filelist *list, FAR struct file *filep)
+{
+  FAR struct file *row;
+  int i;
+
+  for (i = 0; i < FILELIST_NROWS; i++)
+    {
+      row = list->fl_rows[i];
+      if (row != NULL && filep >= row &&
+          filep < &row[CONFIG_NFILE_DESCRIPTORS_PER_BLOCK])
+        {
+          return i * CONFIG_NFILE_DESCRIPTORS_PER_BLOCK + (filep - row);
+        }
+    }
+
+  return -1;
+}
+
+/****************************************************************************
+ * Name: _files_ffz
+ *
+ * Description:
+ *   Return the lowest free file descriptor that is not less than 'minfd',
+ *   or -1 if all are in use.  One bitmap word is examined per 32
+ *   descriptors.
+ *
+ ****************************************************************************/
+
+static int _files_ffz(FAR struct filelist *list, int minfd)
+{
+  uint32_t freebits;
+  int fd;
+  int i;
+
+  for (i = minfd >> 5; i < FILELIST_NWORDS; i++)
+    {
+      freebits = ~list->fl_used[i];
+      if (i == (minfd >> 5))
+        {
+          freebits &= ~(((uint32_t)1 << (minfd & 31)) - 1);
+        }
+
+      if (freebits != 0)
+        {
+          fd = (i << 5) + ffs((int)freebits) - 1;
+          return fd < CONFIG_NFILE_DESCRIPTORS ? fd : -1;
+        }
+    }
+
+  return -1;
+}
+
+/****************************************************************************
+ * Name: _files_extend
+ *
+ * Description:
+ *   Return the file structure of a file descriptor, allocating its row if
+ *   necessary.  Returns NULL if memory could not be allocated.
+ *
+ * Assumptions:
+ *   The caller holds the list semaphore, or no other thread can access the
+ *   list.
+ *
+ ****************************************************************************/
+
+static FAR struct file *_files_extend(FAR struct filelist *list, int fd)
+{
+  FAR struct file *row;
+  int index = fd / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK;
+
+  row = list->fl_rows[index];
+  if (row == NULL)
+    {
+      /* The row is cleared before it is published so that lock-free
+       * look-ups never see uninitialized file structures.  The barrier
+       * makes sure that the cleared row reaches memory before the pointer
+       * to it does.
+       */
+
+      row = (FAR struct file *)
+        kmm_zalloc(CONFIG_NFILE_DESCRIPTORS_PER_BLOCK *
+                   sizeof(struct file));
+      if (row == NULL)
+        {
+          return NULL;
+        }
+
+      SP_DMB();
+      list->fl_rows[index] = row;
+    }
+
+  return &row[fd % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK];
+}
+
 /****************************************************************************
  * Name: _files_close
  *
@@ -105,6 +233,10 @@ static int _files_close(FAR struct file *filep)
 
   if (inode)
     {
+      /* Remove the file from any epoll interest lists first */
+
+      epoll_release(filep);
+
       /* Close the file, driver, or mountpoint. */
 
       if (inode->u.i_ops && inode->u.i_ops->close)
@@ -155,6 +287,11 @@ void files_initlist(FAR struct filelist *list)
 {
   DEBUGASSERT(list);
 
+  /* No file structures are allocated until they are needed */
+
+  memset(list->fl_used, 0, sizeof(list->fl_used));
+  memset(list->fl_rows, 0, sizeof(list->fl_rows));
+
   /* Initialize the list access mutex */
 
   (void)nxsem_init(&list->fl_sem, 0, 1);
@@ -170,7 +307,9 @@ void files_initlist(FAR struct filelist *list)
 
 void files_releaselist(FAR struct filelist *list)
 {
+  FAR struct file *row;
   int i;
+  int j;
 
   DEBUGASSERT(list);
 
@@ -179,16 +318,131 @@ void files_releaselist(FAR struct filelist *list)
    * there should not be any references in this context.
    */
 
-  for (i = 0; i < CONFIG_NFILE_DESCRIPTORS; i++)
+  for (i = 0; i < FILELIST_NROWS; i++)
     {
-      (void)_files_close(&list->fl_files[i]);
+      row = list->fl_rows[i];
+      if (row != NULL)
+        {
+          for (j = 0; j < CONFIG_NFILE_DESCRIPTORS_PER_BLOCK; j++)
+            {
+              (void)_files_close(&row[j]);
+            }
+
+          list->fl_rows[i] = NULL;
+          kmm_free(row);
+        }
     }
 
+  memset(list->fl_used, 0, sizeof(list->fl_used));
+
   /* Destroy the semaphore */
 
   (void)nxsem_destroy(&list->fl_sem);
 }
 
+/****************************************************************************
+ * Name: files_clrused
+ *
+ * Description:
+ *   Mark a file descriptor as free after its file structure has been
+ *   cleared.  The barrier makes sure that the cleared structure is visible
+ *   to lock-free look-ups before the descriptor can be allocated again.
+ *
+ * Assumptions:
+ *   The caller holds the list semaphore.
+ *
+ ****************************************************************************/
+
+void files_clrused(FAR struct filelist *list, int fd)
+{
+  SP_DMB();
+  list->fl_used[fd >> 5] &= ~((uint32_t)1 << (fd & 31));
+}
+
+/****************************************************************************
+ * Name: files_fget
+ *
+ * Description:
+ *   Return the file structure of a descriptor in a file list, or NULL if it
+ *   has never been allocated.  The descriptor must be in range.
+ *
+ *   This may be called without holding the list semaphore.  Once published,
+ *   a row stays in place until the list is released.  The row pointer is
+ *   read exactly once and the barrier pairs with the one in
+ *   _files_extend() so that the row is seen in its cleared state.
+ *
+ ****************************************************************************/
+
+FAR struct file *files_fget(FAR struct filelist *list, int fd)
+{
+  FAR struct file *row;
+
+  row = *(FAR struct file * volatile *)
+          &list->fl_rows[fd / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK];
+  if (row == NULL)
+    {
+      return NULL;
+    }
+
+  SP_DMB();
+  return &row[fd % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK];
+}
+
+/****************************************************************************
+ * Name: files_duplist
+ *
+ * Description:
+ *   Duplicate the first 'nfds' file descriptors of the file list 'plist'
+ *   into the new file list 'clist'.  Only the rows holding open
+ *   descriptors are allocated in the new list.
+ *
+ ****************************************************************************/
+
+void files_duplist(FAR struct filelist *plist, FAR struct filelist *clist,
+                   int nfds)
+{
+  FAR struct file *parent;
+  FAR struct file *child;
+  int fd;
+
+  DEBUGASSERT(plist != NULL && clist != NULL);
+
+  if (nfds > CONFIG_NFILE_DESCRIPTORS)
+    {
+      nfds = CONFIG_NFILE_DESCRIPTORS;
+    }
+
+  for (fd = 0; fd < nfds; fd++)
+    {
+      /* Skip whole bitmap words with no descriptors in use */
+
+      if ((fd & 31) == 0 && plist->fl_used[fd >> 5] == 0)
+        {
+          fd += 31;
+          continue;
+        }
+
+      if ((plist->fl_used[fd >> 5] & ((uint32_t)1 << (fd & 31))) == 0)
+        {
+          continue;
+        }
+
+      parent = files_fget(plist, fd);
+      if (parent == NULL || parent->f_inode == NULL)
+        {
+          continue;
+        }
+
+      /* The new list is not yet visible to any other thread */
+
+      child = _files_extend(clist, fd);
+      if (child != NULL && file_dup2(parent, child) >= 0)
+        {
+          _files_setused(clist, fd);
+        }
+    }
+}
+
 /****************************************************************************
  * Name: file_dup2
  *
@@ -285,6 +539,16 @@ int file_dup2(FAR struct file *filep1, FAR struct file *filep2)
 
   if (list != NULL)
     {
+      /* If the new file structure is a descriptor of this list, then that
+       * descriptor is now in use.
+       */
+
+      int fd = _files_index(list, filep2);
+      if (fd >= 0)
+        {
+          _files_setused(list, fd);
+        }
+
       _files_semgive(list);
     }
 
@@ -302,6 +566,14 @@ errout_with_inode:
 errout_with_sem:
   if (list != NULL)
     {
+      /* The descriptor of the new file structure has been closed */
+
+      int fd = _files_index(list, filep2);
+      if (fd >= 0)
+        {
+          files_clrused(list, fd);
+        }
+
       _files_semgive(list);
     }
 
@@ -320,29 +592,80 @@ errout_with_sem:
 int files_allocate(FAR struct inode *inode, int oflags, off_t pos, int minfd)
 {
   FAR struct filelist *list;
-  int i;
+  FAR struct file *filep;
+  int fd;
 
   /* Get the file descriptor list.  It should not be NULL in this context. */
 
   list = sched_getfiles();
   DEBUGASSERT(list != NULL);
 
+  if (minfd < 0)
+    {
+      minfd = 0;
+    }
+
+  /* Find the lowest free descriptor in the bitmap */
+
   _files_semtake(list);
-  for (i = minfd; i < CONFIG_NFILE_DESCRIPTORS; i++)
+  fd = _files_ffz(list, minfd);
+  if (fd < 0)
     {
-      if (!list->fl_files[i].f_inode)
-        {
-          list->fl_files[i].f_oflags = oflags;
-          list->fl_files[i].f_pos    = pos;
-          list->fl_files[i].f_inode  = inode;
-          list->fl_files[i].f_priv   = NULL;
-          _files_semgive(list);
-          return i;
-        }
+      _files_semgive(list);
+      return ERROR;
     }
 
+  filep = _files_extend(list, fd);
+  if (filep == NULL)
+    {
+      _files_semgive(list);
+      return ERROR;
+    }
+
+  filep->f_oflags = oflags;
+  filep->f_pos    = pos;
+  filep->f_inode  = inode;
+  filep->f_priv   = NULL;
+  _files_setused(list, fd);
+
+  _files_semgive(list);
+  return fd;
+}
+
+/****************************************************************************
+ * Name: files_extend
+ *
+ * Description:
+ *   Return the file structure of a file descriptor of the current task,
+ *   allocating it if it has never been used.  This is used when a specific
+ *   descriptor is to be opened, as by dup2().
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+int files_extend(int fd, FAR struct file **filep)
+{
+  FAR struct filelist *list;
+
+  if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+      return -EBADF;
+    }
+
+  list = sched_getfiles();
+  if (list == NULL)
+    {
+      return -EAGAIN;
+    }
+
+  _files_semtake(list);
+  *filep = _files_extend(list, fd);
   _files_semgive(list);
-  return ERROR;
+
+  return *filep != NULL ? OK : -ENOMEM;
 }
 
 /****************************************************************************
@@ -359,6 +682,7 @@ int files_allocate(FAR struct inode *inode, int oflags, off_t pos, int minfd)
 int files_close(int fd)
 {
   FAR struct filelist *list;
+  FAR struct file     *filep;
   int                  ret;
 
   /* Get the thread-specific file list.  It should never be NULL in this
@@ -370,7 +694,8 @@ int files_close(int fd)
 
   /* If the file was properly opened, there should be an inode assigned */
 
-  if (fd < 0 || fd >= CONFIG_NFILE_DESCRIPTORS || !list->fl_files[fd].f_inode)
+  if (fd < 0 || fd >= CONFIG_NFILE_DESCRIPTORS ||
+      (filep = files_fget(list, fd)) == NULL || !filep->f_inode)
     {
       return -EBADF;
     }
@@ -378,11 +703,35 @@ int files_close(int fd)
   /* Perform the protected close operation */
 
   _files_semtake(list);
-  ret = _files_close(&list->fl_files[fd]);
+  ret = _files_close(filep);
+  if (filep->f_inode == NULL)
+    {
+      files_clrused(list, fd);
+    }
+
   _files_semgive(list);
   return ret;
 }
 
+/****************************************************************************
+ * Name: files_semtake and files_semgive
+ *
+ * Description:
+ *   Take or give the file list semaphore.  No descriptor in the list can be
+ *   closed while the semaphore is held.
+ *
+ ****************************************************************************/
+
+void files_semtake(FAR struct filelist *list)
+{
+  _files_semtake(list);
+}
+
+void files_semgive(FAR struct filelist *list)
+{
+  _files_semgive(list);
+}
+
 /****************************************************************************
  * Name: files_release
  *
@@ -395,16 +744,19 @@ int files_close(int fd)
 void files_release(int fd)
 {
   FAR struct filelist *list;
+  FAR struct file *filep;
 
   list = sched_getfiles();
   DEBUGASSERT(list);
 
-  if (fd >= 0 && fd < CONFIG_NFILE_DESCRIPTORS)
+  if (fd >= 0 && fd < CONFIG_NFILE_DESCRIPTORS &&
+      (filep = files_fget(list, fd)) != NULL)
     {
       _files_semtake(list);
-      list->fl_files[fd].f_oflags  = 0;
-      list->fl_files[fd].f_pos     = 0;
-      list->fl_files[fd].f_inode = NULL;
+      filep->f_oflags  = 0;
+      filep->f_pos     = 0;
+      filep->f_inode   = NULL;
+      files_clrused(list, fd);
       _files_semgive(list);
     }
 }
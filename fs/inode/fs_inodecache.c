@@ -0,0 +1,245 @@
+/****************************************************************************
+ * fs/inode/fs_inodecache.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "inode/inode.h"
+
+#ifdef CONFIG_FS_INODE_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if (CONFIG_FS_INODE_CACHE_NENTRIES & \
+     (CONFIG_FS_INODE_CACHE_NENTRIES - 1)) != 0
+#  error CONFIG_FS_INODE_CACHE_NENTRIES must be a power of two
+#endif
+
+#define INODE_CACHE_MASK    (CONFIG_FS_INODE_CACHE_NENTRIES - 1)
+#define INODE_CACHE_NOREL   UINT16_MAX
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One cached result of a search of the inode tree.  A negative entry
+ * (result == -ENOENT) still holds the peer and parent inodes where the
+ * missing path would be inserted.
+ */
+
+struct inode_cache_s
+{
+  uint32_t gen;                      /* Tree generation; 0: Entry unused */
+  uint32_t hash;                     /* Hash of the path */
+  FAR struct inode *node;            /* The inode found */
+  FAR struct inode *peer;            /* Node to the "left" of the inode */
+  FAR struct inode *parent;          /* Node "above" the inode */
+  int16_t result;                    /* OK or -ENOENT */
+  uint16_t pathofs;                  /* Offset of the residual path */
+  uint16_t relofs;                   /* Offset of relpath or NOREL */
+  char path[CONFIG_FS_INODE_CACHE_PATHLEN];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The cache is protected by the inode tree semaphore.  Any change to the
+ * tree advances the generation, which discards all entries at once.
+ */
+
+static struct inode_cache_s g_inode_cache[CONFIG_FS_INODE_CACHE_NENTRIES];
+static uint32_t g_inode_cachegen = 1;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cache_hash
+ *
+ * Description:
+ *   Return the FNV-1a hash of a path and its length.
+ *
+ ****************************************************************************/
+
+static uint32_t inode_cache_hash(FAR const char *path, FAR size_t *len)
+{
+  FAR const char *ptr = path;
+  uint32_t hash = 2166136261u;
+
+  while (*ptr != '\0')
+    {
+      hash ^= (uint8_t)*ptr++;
+      hash *= 16777619u;
+    }
+
+  *len = ptr - path;
+  return hash;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cache_lookup
+ *
+ * Description:
+ *   Look up the result of a previous search for desc->path.  On a hit, the
+ *   search description is completed as inode_search() would have done.
+ *
+ * Returned Value:
+ *   true if the path was found in the cache; *result then holds the
+ *   return value of the search.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+bool inode_cache_lookup(FAR struct inode_search_s *desc, FAR int *result)
+{
+  FAR struct inode_cache_s *entry;
+  FAR const char *path = desc->path;
+  uint32_t hash;
+  size_t len;
+
+  hash  = inode_cache_hash(path, &len);
+  entry = &g_inode_cache[hash & INODE_CACHE_MASK];
+
+  if (entry->gen != g_inode_cachegen || entry->hash != hash ||
+      len >= CONFIG_FS_INODE_CACHE_PATHLEN || strcmp(entry->path, path) != 0)
+    {
+      return false;
+    }
+
+  desc->path    = path + entry->pathofs;
+  desc->node    = entry->node;
+  desc->peer    = entry->peer;
+  desc->parent  = entry->parent;
+  desc->relpath = entry->relofs == INODE_CACHE_NOREL ?
+                  NULL : path + entry->relofs;
+
+  *result       = entry->result;
+  return true;
+}
+
+/****************************************************************************
+ * Name: inode_cache_add
+ *
+ * Description:
+ *   Remember the result of a search for 'path'.  Only successful searches
+ *   and searches that failed because the path does not exist are cached,
+ *   and only when the results refer to 'path' itself (i.e., no soft link
+ *   was followed).
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_add(FAR const struct inode_search_s *desc,
+                     FAR const char *path, int result)
+{
+  FAR struct inode_cache_s *entry;
+  uint32_t hash;
+  size_t len;
+
+  if (result != OK && result != -ENOENT)
+    {
+      return;
+    }
+
+  hash = inode_cache_hash(path, &len);
+  if (len >= CONFIG_FS_INODE_CACHE_PATHLEN ||
+      desc->path < path || desc->path > path + len ||
+      (desc->relpath != NULL &&
+       (desc->relpath < path || desc->relpath > path + len)))
+    {
+      return;
+    }
+
+  entry          = &g_inode_cache[hash & INODE_CACHE_MASK];
+  entry->gen     = g_inode_cachegen;
+  entry->hash    = hash;
+  entry->node    = desc->node;
+  entry->peer    = desc->peer;
+  entry->parent  = desc->parent;
+  entry->result  = (int16_t)result;
+  entry->pathofs = (uint16_t)(desc->path - path);
+  entry->relofs  = desc->relpath == NULL ?
+                   INODE_CACHE_NOREL : (uint16_t)(desc->relpath - path);
+  memcpy(entry->path, path, len + 1);
+}
+
+/****************************************************************************
+ * Name: inode_cache_invalidate
+ *
+ * Description:
+ *   Discard all cached search results.  Called whenever the inode tree is
+ *   modified.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_invalidate(void)
+{
+  if (++g_inode_cachegen == 0)
+    {
+      /* The generation wrapped.  Clear the entries so that none of them can
+       * match a future generation.
+       */
+
+      memset(g_inode_cache, 0, sizeof(g_inode_cache));
+      g_inode_cachegen = 1;
+    }
+}
+
+#endif /* CONFIG_FS_INODE_CACHE */
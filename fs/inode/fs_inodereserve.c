@@ -251,6 +251,10 @@ int inode_reserve(FAR const char *path, FAR struct inode **inode)
       break;
     }
 
+  /* Cached searches may no longer describe the tree */
+
+  inode_cache_invalidate();
+
 errout_with_search:
   RELEASE_SEARCH(&desc);
   return ret;
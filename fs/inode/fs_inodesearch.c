@@ -461,6 +461,9 @@ static int _inode_search(FAR struct inode_search_s *desc)
 
 int inode_search(FAR struct inode_search_s *desc)
 {
+#ifdef CONFIG_FS_INODE_CACHE
+  FAR const char *path;
+#endif
   int ret;
 
   /* Perform the common _inode_search() logic.  This does everything except
@@ -473,7 +476,26 @@ int inode_search(FAR struct inode_search_s *desc)
   desc->linktgt = NULL;
 #endif
 
+#ifdef CONFIG_FS_INODE_CACHE
+  /* The result of _inode_search() depends only on the path and on the
+   * inode tree, so it can be cached until the tree changes.
+   */
+
+  path = desc->path;
+  if (!inode_cache_lookup(desc, &ret))
+    {
+      ret = _inode_search(desc);
+
+#ifdef CONFIG_PSEUDOFS_SOFTLINKS
+      if (desc->linktgt == NULL)
+#endif
+        {
+          inode_cache_add(desc, path, ret);
+        }
+    }
+#else
   ret = _inode_search(desc);
+#endif
 
 #ifdef CONFIG_PSEUDOFS_SOFTLINKS
   if (ret >= 0)
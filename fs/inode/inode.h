@@ -226,6 +226,28 @@ void inode_semgive(void);
 
 int inode_search(FAR struct inode_search_s *desc);
 
+/****************************************************************************
+ * Name: inode_cache_lookup, inode_cache_add, and inode_cache_invalidate
+ *
+ * Description:
+ *   Manage the cache of inode_search() results.  inode_cache_invalidate()
+ *   must be called whenever the shape of the inode tree changes or an
+ *   inode becomes (or stops being) a mountpoint or a soft link.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_CACHE
+bool inode_cache_lookup(FAR struct inode_search_s *desc, FAR int *result);
+void inode_cache_add(FAR const struct inode_search_s *desc,
+                     FAR const char *path, int result);
+void inode_cache_invalidate(void);
+#else
+#  define inode_cache_invalidate()
+#endif
+
 /****************************************************************************
  * Name: inode_find
  *
@@ -400,6 +422,17 @@ void weak_function files_initialize(void);
 
 int files_allocate(FAR struct inode *inode, int oflags, off_t pos, int minfd);
 
+/****************************************************************************
+ * Name: files_extend
+ *
+ * Description:
+ *   Return the file structure of a file descriptor of the current task,
+ *   allocating it if it has never been used.
+ *
+ ****************************************************************************/
+
+int files_extend(int fd, FAR struct file **filep);
+
 /****************************************************************************
  * Name: files_close
  *
@@ -424,6 +457,29 @@ int files_close(int fd);
 
 void files_release(int fd);
 
+/****************************************************************************
+ * Name: files_semtake and files_semgive
+ *
+ * Description:
+ *   Take or give the file list semaphore.  No descriptor in the list can be
+ *   closed while the semaphore is held.
+ *
+ ****************************************************************************/
+
+void files_semtake(FAR struct filelist *list);
+void files_semgive(FAR struct filelist *list);
+
+/****************************************************************************
+ * Name: files_clrused
+ *
+ * Description:
+ *   Mark a file descriptor as free after its file structure has been
+ *   cleared.  The caller must hold the list semaphore.
+ *
+ ****************************************************************************/
+
+void files_clrused(FAR struct filelist *list, int fd);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
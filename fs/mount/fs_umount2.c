@@ -151,6 +151,12 @@ int umount2(FAR const char *target, unsigned int flags)
   mountpt_inode->i_private = NULL;
   mountpt_inode->u.i_mops  = NULL;
 
+  /* Cached look-ups below the mountpoint resolved to the mountpoint inode
+   * and must now resolve to its pseudo-file children instead.
+   */
+
+  inode_cache_invalidate();
+
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   /* If the node has children, then do not delete it. */
 
@@ -82,6 +82,8 @@ extern const struct procfs_operations cpuload_operations;
 extern const struct procfs_operations critmon_operations;
 extern const struct procfs_operations meminfo_operations;
 extern const struct procfs_operations iobinfo_operations;
+extern const struct procfs_operations poolinfo_operations;
+extern const struct procfs_operations rwbinfo_operations;
 extern const struct procfs_operations module_operations;
 extern const struct procfs_operations uptime_operations;
 extern const struct procfs_operations version_operations;
@@ -144,10 +146,19 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "iobinfo",       &iobinfo_operations,         PROCFS_FILE_TYPE   },
 #endif
 
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_POOLINFO
+  { "poolinfo",      &poolinfo_operations,        PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_MODULE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MODULE)
   { "modules",       &module_operations,          PROCFS_FILE_TYPE   },
 #endif
 
+#if (defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD)) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_RWBINFO)
+  { "rwbinfo",       &rwbinfo_operations,         PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_BLOCKS
   { "fs/blocks",     &mount_procfsoperations,     PROCFS_FILE_TYPE   },
 #endif
@@ -355,6 +355,72 @@ static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
     }
 #endif
 
+#ifdef CONFIG_MM_CACHE
+  /* Followed by the per-CPU small chunk cache statistics */
+
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = snprintf(procfile->line, MEMINFO_LINELEN,
+                            "            cached       hits     misses\n");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      /* Show kernel heap cache information */
+
+#ifdef CONFIG_CAN_PASS_STRUCTS
+      mem        = kmm_mallinfo();
+#else
+      (void)kmm_mallinfo(&mem);
+#endif
+
+      linesize   = snprintf(procfile->line, MEMINFO_LINELEN,
+                            "Kcache:%11lu%11lu%11lu\n",
+                            (unsigned long)mem.cachedblks,
+                            (unsigned long)mem.cachehits,
+                            (unsigned long)mem.cachemisses);
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+#endif
+
+#if !defined(CONFIG_BUILD_KERNEL)
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      /* Show user heap cache information */
+
+#ifdef CONFIG_CAN_PASS_STRUCTS
+      mem        = kumm_mallinfo();
+#else
+      (void)kumm_mallinfo(&mem);
+#endif
+
+      linesize   = snprintf(procfile->line, MEMINFO_LINELEN,
+                            "Ucache:%11lu%11lu%11lu\n",
+                            (unsigned long)mem.cachedblks,
+                            (unsigned long)mem.cachehits,
+                            (unsigned long)mem.cachemisses);
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+#endif
+#endif /* CONFIG_MM_CACHE */
+
 #ifdef CONFIG_MM_PGALLOC
   if (totalsize < buflen)
     {
@@ -0,0 +1,355 @@
+/****************************************************************************
+ * fs/procfs/fs_procfspoolinfo.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/pool.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_POOLINFO)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define POOLINFO_LINELEN 80
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct poolinfo_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  unsigned int linesize;          /* Number of valid characters in line[] */
+  char line[POOLINFO_LINELEN];    /* Pre-allocated buffer for formatted lines */
+};
+
+/* This structure holds the state of one read() while traversing the pools */
+
+struct poolinfo_read_s
+{
+  FAR struct poolinfo_file_s *poolfile;
+  FAR char *buffer;               /* Next location in the user buffer */
+  size_t buflen;                  /* Size of the user buffer */
+  size_t totalsize;               /* Number of bytes copied so far */
+  off_t offset;                   /* Remaining file offset to skip */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     poolinfo_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     poolinfo_close(FAR struct file *filep);
+static ssize_t poolinfo_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     poolinfo_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     poolinfo_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations poolinfo_operations =
+{
+  poolinfo_open,   /* open */
+  poolinfo_close,  /* close */
+  poolinfo_read,   /* read */
+  NULL,            /* write */
+  poolinfo_dup,    /* dup */
+  NULL,            /* opendir */
+  NULL,            /* closedir */
+  NULL,            /* readdir */
+  NULL,            /* rewinddir */
+  poolinfo_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: poolinfo_open
+ ****************************************************************************/
+
+static int poolinfo_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct poolinfo_file_s *procfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   *
+   * REVISIT:  Write-able proc files could be quite useful.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "poolinfo" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "poolinfo") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = (FAR struct poolinfo_file_s *)
+    kmm_zalloc(sizeof(struct poolinfo_file_s));
+  if (!procfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: poolinfo_close
+ ****************************************************************************/
+
+static int poolinfo_close(FAR struct file *filep)
+{
+  FAR struct poolinfo_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct poolinfo_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: poolinfo_line
+ ****************************************************************************/
+
+static void poolinfo_line(FAR struct poolinfo_read_s *info,
+                          FAR const char *line, size_t linesize)
+{
+  size_t copysize;
+
+  if (info->totalsize < info->buflen)
+    {
+      copysize = procfs_memcpy(line, linesize, info->buffer,
+                               info->buflen - info->totalsize,
+                               &info->offset);
+      info->buffer    += copysize;
+      info->totalsize += copysize;
+    }
+}
+
+/****************************************************************************
+ * Name: poolinfo_callback
+ ****************************************************************************/
+
+static void poolinfo_callback(FAR struct kmm_pool_s *pool, FAR void *arg)
+{
+  FAR struct poolinfo_read_s *info = (FAR struct poolinfo_read_s *)arg;
+  FAR struct poolinfo_file_s *poolfile = info->poolfile;
+  struct kmm_poolinfo_s poolinfo;
+  size_t linesize;
+
+  kmm_pool_info(pool, &poolinfo);
+
+  linesize = snprintf(poolfile->line, POOLINFO_LINELEN,
+                      "%-16s%6lu%6lu%6lu%6lu%11lu%7lu\n",
+                      poolinfo.name != NULL ? poolinfo.name : "?",
+                      (unsigned long)poolinfo.blocksize,
+                      (unsigned long)poolinfo.ntotal,
+                      (unsigned long)poolinfo.nused,
+                      (unsigned long)poolinfo.hwm,
+                      (unsigned long)poolinfo.nalloc,
+                      (unsigned long)poolinfo.nfail);
+  poolinfo_line(info, poolfile->line, linesize);
+}
+
+/****************************************************************************
+ * Name: poolinfo_read
+ ****************************************************************************/
+
+static ssize_t poolinfo_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  struct poolinfo_read_s info;
+  size_t linesize;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+
+  /* Recover our private data from the struct file instance */
+
+  info.poolfile  = (FAR struct poolinfo_file_s *)filep->f_priv;
+  info.buffer    = buffer;
+  info.buflen    = buflen;
+  info.totalsize = 0;
+  info.offset    = filep->f_pos;
+  DEBUGASSERT(info.poolfile);
+
+  /* The first line is the headers */
+
+  linesize = snprintf(info.poolfile->line, POOLINFO_LINELEN,
+                      "%-16s%6s%6s%6s%6s%11s%7s\n",
+                      "NAME", "SIZE", "TOTAL", "USED", "HWM", "ALLOCS",
+                      "FAILS");
+  poolinfo_line(&info, info.poolfile->line, linesize);
+
+  /* Followed by one line for each pool */
+
+  kmm_pool_foreach(poolinfo_callback, &info);
+
+  /* Update the file offset */
+
+  filep->f_pos += info.totalsize;
+  return info.totalsize;
+}
+
+/****************************************************************************
+ * Name: poolinfo_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int poolinfo_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct poolinfo_file_s *oldattr;
+  FAR struct poolinfo_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct poolinfo_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct poolinfo_file_s *)
+    kmm_malloc(sizeof(struct poolinfo_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct poolinfo_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: poolinfo_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int poolinfo_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "poolinfo" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "poolinfo") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "poolinfo" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_POOLINFO */
@@ -0,0 +1,360 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsrwbinfo.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/drivers/rwbuffer.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    (defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD)) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_RWBINFO)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define RWBINFO_LINELEN 96
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct rwbinfo_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  unsigned int linesize;          /* Number of valid characters in line[] */
+  char line[RWBINFO_LINELEN];    /* Pre-allocated buffer for formatted lines */
+};
+
+/* This structure holds the state of one read() while traversing the
+ * buffers
+ */
+
+struct rwbinfo_read_s
+{
+  FAR struct rwbinfo_file_s *rwbfile;
+  FAR char *buffer;               /* Next location in the user buffer */
+  size_t buflen;                  /* Size of the user buffer */
+  size_t totalsize;               /* Number of bytes copied so far */
+  off_t offset;                   /* Remaining file offset to skip */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     rwbinfo_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     rwbinfo_close(FAR struct file *filep);
+static ssize_t rwbinfo_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     rwbinfo_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     rwbinfo_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations rwbinfo_operations =
+{
+  rwbinfo_open,   /* open */
+  rwbinfo_close,  /* close */
+  rwbinfo_read,   /* read */
+  NULL,            /* write */
+  rwbinfo_dup,    /* dup */
+  NULL,            /* opendir */
+  NULL,            /* closedir */
+  NULL,            /* readdir */
+  NULL,            /* rewinddir */
+  rwbinfo_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rwbinfo_open
+ ****************************************************************************/
+
+static int rwbinfo_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct rwbinfo_file_s *procfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   *
+   * REVISIT:  Write-able proc files could be quite useful.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "rwbinfo" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "rwbinfo") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = (FAR struct rwbinfo_file_s *)
+    kmm_zalloc(sizeof(struct rwbinfo_file_s));
+  if (!procfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: rwbinfo_close
+ ****************************************************************************/
+
+static int rwbinfo_close(FAR struct file *filep)
+{
+  FAR struct rwbinfo_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct rwbinfo_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: rwbinfo_line
+ ****************************************************************************/
+
+static void rwbinfo_line(FAR struct rwbinfo_read_s *info,
+                          FAR const char *line, size_t linesize)
+{
+  size_t copysize;
+
+  if (info->totalsize < info->buflen)
+    {
+      copysize = procfs_memcpy(line, linesize, info->buffer,
+                               info->buflen - info->totalsize,
+                               &info->offset);
+      info->buffer    += copysize;
+      info->totalsize += copysize;
+    }
+}
+
+/****************************************************************************
+ * Name: rwbinfo_callback
+ ****************************************************************************/
+
+static void rwbinfo_callback(FAR struct rwbuffer_s *rwb, FAR void *arg)
+{
+  FAR struct rwbinfo_read_s *info = (FAR struct rwbinfo_read_s *)arg;
+  FAR struct rwbinfo_file_s *rwbfile = info->rwbfile;
+  struct rwb_info_s rwbinfo;
+  size_t linesize;
+
+  rwb_info(rwb, &rwbinfo);
+
+  linesize = snprintf(rwbfile->line, RWBINFO_LINELEN,
+                      "%-12p%5u%4u/%-4u%4u/%-4u%9lu%9lu%9lu%9lu%8lu\n",
+                      rwbinfo.dev, rwbinfo.blocksize,
+                      rwbinfo.wrnblocks, rwbinfo.wrmaxblocks,
+                      rwbinfo.rhwindow, rwbinfo.rhmaxblocks,
+                      (unsigned long)rwbinfo.rdhits,
+                      (unsigned long)rwbinfo.rdmisses,
+                      (unsigned long)rwbinfo.wrhits,
+                      (unsigned long)rwbinfo.wrmisses,
+                      (unsigned long)rwbinfo.nflush);
+  rwbinfo_line(info, rwbfile->line, linesize);
+}
+
+/****************************************************************************
+ * Name: rwbinfo_read
+ ****************************************************************************/
+
+static ssize_t rwbinfo_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  struct rwbinfo_read_s info;
+  size_t linesize;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+
+  /* Recover our private data from the struct file instance */
+
+  info.rwbfile   = (FAR struct rwbinfo_file_s *)filep->f_priv;
+  info.buffer    = buffer;
+  info.buflen    = buflen;
+  info.totalsize = 0;
+  info.offset    = filep->f_pos;
+  DEBUGASSERT(info.rwbfile);
+
+  /* The first line is the headers */
+
+  linesize = snprintf(info.rwbfile->line, RWBINFO_LINELEN,
+                      "%-12s%5s%9s%9s%9s%9s%9s%9s%8s\n",
+                      "DEVICE", "SIZE", "DIRTY", "WINDOW", "RDHITS",
+                      "RDMISSES", "WRHITS", "WRMISSES", "FLUSHES");
+  rwbinfo_line(&info, info.rwbfile->line, linesize);
+
+  /* Followed by one line for each buffer */
+
+  rwb_foreach(rwbinfo_callback, &info);
+
+  /* Update the file offset */
+
+  filep->f_pos += info.totalsize;
+  return info.totalsize;
+}
+
+/****************************************************************************
+ * Name: rwbinfo_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int rwbinfo_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct rwbinfo_file_s *oldattr;
+  FAR struct rwbinfo_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct rwbinfo_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct rwbinfo_file_s *)
+    kmm_malloc(sizeof(struct rwbinfo_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct rwbinfo_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: rwbinfo_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int rwbinfo_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "rwbinfo" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "rwbinfo") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "rwbinfo" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * (CONFIG_DRVR_WRITEBUFFER || CONFIG_DRVR_READAHEAD) &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_RWBINFO */
@@ -74,7 +74,10 @@
 
 int file_dup(FAR struct file *filep, int minfd)
 {
+  FAR struct file *filep2;
+  FAR struct inode *inode;
   int fd2;
+  int ret;
 
   /* Verify that fd is a valid, open file descriptor */
 
@@ -85,17 +88,53 @@ int file_dup(FAR struct file *filep, int minfd)
 
   /* Increment the reference count on the contained inode */
 
-  inode_addref(filep->f_inode);
+  inode = filep->f_inode;
+  inode_addref(inode);
 
   /* Then allocate a new file descriptor for the inode */
 
-  fd2 = files_allocate(filep->f_inode, filep->f_oflags, filep->f_pos, minfd);
+  fd2 = files_allocate(inode, filep->f_oflags, filep->f_pos, minfd);
   if (fd2 < 0)
     {
-      inode_release(filep->f_inode);
+      inode_release(inode);
       return -EMFILE;
     }
 
+  /* Call the open method on the file, driver, mountpoint so that it can
+   * maintain the correct open counts, as file_dup2() does.
+   */
+
+  if (inode->u.i_ops && inode->u.i_ops->open)
+    {
+      ret = fs_getfilep(fd2, &filep2);
+      if (ret >= 0)
+        {
+#ifndef CONFIG_DISABLE_MOUNTPOINT
+          if (INODE_IS_MOUNTPT(inode))
+            {
+              /* Dup the open file on the in the new file structure */
+
+              ret = inode->u.i_mops->dup(filep, filep2);
+            }
+          else
+#endif
+            {
+              /* (Re-)open the pseudo file or device driver */
+
+              ret = inode->u.i_ops->open(filep2);
+            }
+        }
+
+      /* Handle open failures */
+
+      if (ret < 0)
+        {
+          files_release(fd2);
+          inode_release(inode);
+          return ret;
+        }
+    }
+
   return fd2;
 }
 
@@ -91,7 +91,9 @@ int dup2(int fd1, int fd2)
   ret = fs_getfilep(fd1, &filep1);
   if (ret >= 0)
     {
-      ret = fs_getfilep(fd2, &filep2);
+      /* fd2 may never have been used before */
+
+      ret = files_extend(fd2, &filep2);
     }
 
   if (ret < 0)
@@ -42,194 +42,1205 @@
 #include <sys/epoll.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <poll.h>
+#include <queue.h>
+#include <fcntl.h>
 #include <errno.h>
 #include <string.h>
+#include <unistd.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/cancelpt.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "inode/inode.h"
 
 /****************************************************************************
- * Public Functions
+ * Pre-processor Definitions
  ****************************************************************************/
 
+/* Number of buckets in the per-instance interest hash (a power of two) */
+
+#define EPOLL_NBUCKETS      16
+#define EPOLL_HASH(fd)      ((unsigned int)(fd) & (EPOLL_NBUCKETS - 1))
+
+/* Hash of a monitored struct file or struct socket in the global table */
+
+#define EPOLL_OBJHASH(obj)  (((uintptr_t)(obj) >> 4) & (EPOLL_NBUCKETS - 1))
+
+/* The epoll events that map directly onto poll events */
+
+#define EPOLL_POLLEVENTS    (EPOLLIN | EPOLLOUT | EPOLLERR | EPOLLHUP)
+
 /****************************************************************************
- * Name: epoll_create
+ * Private Types
+ ****************************************************************************/
+
+struct epoll_head_s;
+
+/* One file descriptor in the interest list of an epoll instance */
+
+struct epoll_item_s
+{
+  dq_entry_t rnode;                  /* Ready list link (must be first) */
+  FAR struct epoll_item_s *flink;    /* Next item in the same hash bucket */
+  FAR struct epoll_item_s *olink;    /* Next item in the same object bucket */
+  FAR struct epoll_item_s *rlink;    /* Next item to requeue (epoll_harvest) */
+  FAR struct epoll_head_s *eph;      /* The owning epoll instance */
+  FAR void *obj;                     /* The monitored struct file or socket */
+  struct epoll_event event;          /* Registered events and user data */
+  struct pollfd pfd;                 /* Poll structure given to the driver */
+  int fd;                            /* The monitored file descriptor */
+  bool issock;                       /* True: obj is a struct socket */
+  bool armed;                        /* True: The poll is set up */
+  bool queued;                       /* True: The item is in the ready list */
+};
+
+/* One epoll instance.  The ready list is modified by poll notifications
+ * which may run in interrupt context and so is protected by a critical
+ * section; the reference count is protected by g_epollsem; everything else
+ * is protected by exclsem.
+ */
+
+struct epoll_head_s
+{
+  sem_t exclsem;                     /* Serializes epoll_ctl()/epoll_wait() */
+  sem_t waitsem;                     /* Posted when an item becomes ready */
+  dq_queue_t ready;                  /* Items with pending events */
+  uint16_t nposts;                   /* Unconsumed posts by epoll_notify() */
+  uint16_t crefs;                    /* Open file structures and callers */
+  FAR struct epoll_item_s *hash[EPOLL_NBUCKETS];
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int epoll_do_open(FAR struct file *filep);
+static int epoll_do_close(FAR struct file *filep);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_epoll_ops =
+{
+  epoll_do_open,   /* open */
+  epoll_do_close,  /* close */
+  NULL,            /* read */
+  NULL,            /* write */
+  NULL,            /* seek */
+  NULL,            /* ioctl */
+  NULL             /* poll */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , NULL           /* unlink */
+#endif
+};
+
+/* Every item of every epoll instance, hashed by the monitored file or
+ * socket, so that the items can be removed when the file or socket is
+ * closed.  The semaphore also protects the reference counts of the
+ * instances.  Locks are always taken in the order:  file list semaphore,
+ * g_epollsem, exclsem.
+ */
+
+static sem_t g_epollsem = SEM_INITIALIZER(1);
+static FAR struct epoll_item_s *g_epollobj[EPOLL_NBUCKETS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: epoll_takesem
  *
  * Description:
+ *   Take a semaphore, ignoring signals and cancellation.  On failure, the
+ *   semaphore is not held and the caller must not touch the state that it
+ *   protects.
  *
- * Input Parameters:
+ ****************************************************************************/
+
+static int epoll_takesem(FAR sem_t *sem)
+{
+  int ret;
+
+  ret = nxsem_wait_uninterruptible(sem);
+  DEBUGASSERT(ret == OK);
+  return ret;
+}
+
+#define epoll_semtake(eph) epoll_takesem(&(eph)->exclsem)
+#define epoll_semgive(eph) nxsem_post(&(eph)->exclsem)
+
+/****************************************************************************
+ * Name: epoll_gethead
+ *
+ * Description:
+ *   Return the epoll instance associated with a file descriptor with a
+ *   reference held, or NULL if the descriptor does not refer to an epoll
+ *   instance.  The file list semaphore keeps the descriptor from being
+ *   closed until the reference is taken.  The reference is released with
+ *   epoll_puthead().
+ *
+ ****************************************************************************/
+
+static FAR struct epoll_head_s *epoll_gethead(int epfd)
+{
+  FAR struct epoll_head_s *eph = NULL;
+  FAR struct filelist *list;
+  FAR struct file *filep;
+
+  list = sched_getfiles();
+  if (list == NULL)
+    {
+      return NULL;
+    }
+
+  files_semtake(list);
+  if (fs_getfilep(epfd, &filep) >= 0 && filep->f_inode != NULL &&
+      filep->f_inode->u.i_ops == &g_epoll_ops)
+    {
+      if (epoll_takesem(&g_epollsem) >= 0)
+        {
+          eph = (FAR struct epoll_head_s *)filep->f_inode->i_private;
+          eph->crefs++;
+          nxsem_post(&g_epollsem);
+        }
+    }
+
+  files_semgive(list);
+  return eph;
+}
+
+/****************************************************************************
+ * Name: epoll_find
+ *
+ * Description:
+ *   Find the interest list entry for a file descriptor.
+ *
+ ****************************************************************************/
+
+static FAR struct epoll_item_s *epoll_find(FAR struct epoll_head_s *eph,
+                                           int fd)
+{
+  FAR struct epoll_item_s *epi;
+
+  for (epi = eph->hash[EPOLL_HASH(fd)]; epi != NULL; epi = epi->flink)
+    {
+      if (epi->fd == fd)
+        {
+          break;
+        }
+    }
+
+  return epi;
+}
+
+/****************************************************************************
+ * Name: epoll_notify
+ *
+ * Description:
+ *   The poll notification callback.  Queue the item in the ready list of
+ *   its epoll instance and wake up any waiter.
+ *
+ * Assumptions:
+ *   May be called from interrupt handlers.
+ *
+ ****************************************************************************/
+
+static void epoll_notify(FAR struct pollfd *fds)
+{
+  FAR struct epoll_item_s *epi = (FAR struct epoll_item_s *)fds->arg;
+  FAR struct epoll_head_s *eph = epi->eph;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (!epi->queued)
+    {
+      dq_addlast(&epi->rnode, &eph->ready);
+      epi->queued = true;
+      eph->nposts++;
+      nxsem_post(&eph->waitsem);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_fdsetup
+ *
+ * Description:
+ *   Set up or tear down the poll of the file or socket monitored by an
+ *   item.  The structure captured by epoll_ctl() is used rather than the
+ *   descriptor, which may since have been reused.
+ *
+ ****************************************************************************/
+
+static int epoll_fdsetup(FAR struct epoll_item_s *epi, bool setup)
+{
+#ifdef CONFIG_NET
+  if (epi->issock)
+    {
+      return psock_poll((FAR struct socket *)epi->obj, &epi->pfd, setup);
+    }
+#endif
+
+  return file_poll((FAR struct file *)epi->obj, &epi->pfd, setup);
+}
+
+/****************************************************************************
+ * Name: epoll_arm
+ *
+ * Description:
+ *   Set up the poll for an item.  The driver notifies immediately if any
+ *   requested event is already pending.
+ *
+ ****************************************************************************/
+
+static int epoll_arm(FAR struct epoll_item_s *epi)
+{
+  int ret;
+
+  epi->pfd.fd      = epi->fd;
+  epi->pfd.events  = (pollevent_t)(epi->event.events & EPOLL_POLLEVENTS);
+  epi->pfd.revents = 0;
+  epi->pfd.ptr     = NULL;
+  epi->pfd.sem     = &epi->eph->waitsem;
+  epi->pfd.priv    = NULL;
+  epi->pfd.cb      = epoll_notify;
+  epi->pfd.arg     = epi;
+
+  ret = epoll_fdsetup(epi, true);
+  if (ret >= 0)
+    {
+      epi->armed = true;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: epoll_disarm
+ *
+ * Description:
+ *   Tear down the poll for an item and discard any pending events.
+ *
+ ****************************************************************************/
+
+static void epoll_disarm(FAR struct epoll_item_s *epi)
+{
+  irqstate_t flags;
+
+  if (epi->armed)
+    {
+      (void)epoll_fdsetup(epi, false);
+      epi->armed = false;
+    }
+
+  flags = enter_critical_section();
+  if (epi->queued)
+    {
+      dq_rem(&epi->rnode, &epi->eph->ready);
+      epi->queued = false;
+    }
+
+  epi->pfd.revents = 0;
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_repoll
+ *
+ * Description:
+ *   Poll an item again and return the events that are pending now.  The
+ *   ready list may hold an item whose events have since been consumed, so
+ *   the events recorded by the notification cannot be reported as they
+ *   are.  Most drivers report a poll setup only once, so the poll is torn
+ *   down and set up again; setup notifies at once if any event is pending.
+ *   That notification is taken here rather than left in the ready list.
+ *
+ ****************************************************************************/
+
+static pollevent_t epoll_repoll(FAR struct epoll_item_s *epi)
+{
+  pollevent_t revents;
+  irqstate_t flags;
+
+  if (epi->armed)
+    {
+      (void)epoll_fdsetup(epi, false);
+      epi->armed = false;
+    }
+
+  if (epoll_arm(epi) < 0)
+    {
+      ferr("ERROR: Failed to re-arm fd=%d\n", epi->fd);
+      return 0;
+    }
+
+  flags = enter_critical_section();
+  if (epi->queued)
+    {
+      dq_rem(&epi->rnode, &epi->eph->ready);
+      epi->queued = false;
+    }
+
+  revents          = epi->pfd.revents;
+  epi->pfd.revents = 0;
+  leave_critical_section(flags);
+
+  return revents;
+}
+
+/****************************************************************************
+ * Name: epoll_getobj
+ *
+ * Description:
+ *   Find the file or socket structure of a descriptor for a new item.  A
+ *   file item holds a reference on the inode; socket items are instead
+ *   removed by epoll_release() before the socket is torn down.
+ *
+ * Assumptions:
+ *   The caller holds the file list semaphore and g_epollsem.
+ *
+ ****************************************************************************/
+
+static int epoll_getobj(FAR struct epoll_item_s *epi, int fd)
+{
+  FAR struct file *filep;
+  int ret;
+
+#ifdef CONFIG_NET
+  if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+      FAR struct socket *psock = sockfd_socket(fd);
+
+      if (psock == NULL || psock->s_crefs <= 0)
+        {
+          return -EBADF;
+        }
+
+      epi->obj    = psock;
+      epi->issock = true;
+      return OK;
+    }
+#endif
+
+  ret = fs_getfilep(fd, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (filep->f_inode == NULL)
+    {
+      return -EBADF;
+    }
+
+  inode_addref(filep->f_inode);
+  epi->obj = filep;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: epoll_freeitem
+ *
+ * Description:
+ *   Tear down an item that has been removed from all lists, drop its
+ *   reference and free it.
+ *
+ ****************************************************************************/
+
+static void epoll_freeitem(FAR struct epoll_item_s *epi)
+{
+  epoll_disarm(epi);
+
+  if (!epi->issock)
+    {
+      inode_release(((FAR struct file *)epi->obj)->f_inode);
+    }
+
+  kmm_free(epi);
+}
+
+/****************************************************************************
+ * Name: epoll_unlink
+ *
+ * Description:
+ *   Remove an item from the interest list of its instance and from the
+ *   global table.
+ *
+ * Assumptions:
+ *   The caller holds g_epollsem and, unless the instance is being
+ *   destroyed, its exclsem.
+ *
+ ****************************************************************************/
+
+static void epoll_unlink(FAR struct epoll_item_s *epi)
+{
+  FAR struct epoll_item_s **link;
+
+  for (link = &epi->eph->hash[EPOLL_HASH(epi->fd)]; *link != epi;
+       link = &(*link)->flink)
+    {
+    }
+
+  *link = epi->flink;
+
+  for (link = &g_epollobj[EPOLL_OBJHASH(epi->obj)]; *link != epi;
+       link = &(*link)->olink)
+    {
+    }
+
+  *link = epi->olink;
+}
+
+/****************************************************************************
+ * Name: epoll_puthead
+ *
+ * Description:
+ *   Release a reference to an epoll instance.  The instance is destroyed
+ *   with the last reference.
+ *
+ ****************************************************************************/
+
+static void epoll_puthead(FAR struct epoll_head_s *eph)
+{
+  FAR struct epoll_item_s *epi;
+  int i;
+
+  if (epoll_takesem(&g_epollsem) < 0)
+    {
+      return;
+    }
+
+  if (--eph->crefs > 0)
+    {
+      nxsem_post(&g_epollsem);
+      return;
+    }
+
+  for (i = 0; i < EPOLL_NBUCKETS; i++)
+    {
+      while ((epi = eph->hash[i]) != NULL)
+        {
+          epoll_unlink(epi);
+          epoll_freeitem(epi);
+        }
+    }
+
+  nxsem_post(&g_epollsem);
+
+  nxsem_destroy(&eph->waitsem);
+  nxsem_destroy(&eph->exclsem);
+  kmm_free(eph);
+}
+
+/****************************************************************************
+ * Name: epoll_drain
+ *
+ * Description:
+ *   Consume all pending posts of the wait semaphore.  Polling an item
+ *   again while it is still ready notifies (and posts) at once, so posts
+ *   accumulate whenever epoll_wait() returns without waiting.  They must
+ *   be discarded before each harvest so that the semaphore count stays
+ *   bounded.
  *
  * Returned Value:
+ *   True if any of the consumed posts was not made by epoll_notify() and so
+ *   came from a driver that posts the semaphore directly.
  *
  ****************************************************************************/
 
-int epoll_create(int size)
+static bool epoll_drain(FAR struct epoll_head_s *eph)
 {
-  FAR struct epoll_head *eph =
-    (FAR struct epoll_head *)kmm_malloc(sizeof(struct epoll_head));
+  irqstate_t flags;
+  bool foreign;
+  int nposts = 0;
 
-  eph->size = size;
-  eph->occupied = 0;
-  eph->evs = kmm_malloc(sizeof(struct epoll_event) * eph->size);
+  flags = enter_critical_section();
+  while (nxsem_trywait(&eph->waitsem) >= 0)
+    {
+      nposts++;
+    }
+
+  foreign     = nposts > eph->nposts;
+  eph->nposts = 0;
+  leave_critical_section(flags);
+
+  return foreign;
+}
 
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
+/****************************************************************************
+ * Name: epoll_woken
+ *
+ * Description:
+ *   Account for the post consumed by a wakeup of epoll_wait().
+ *
+ * Returned Value:
+ *   True if the post was not made by epoll_notify().
+ *
+ ****************************************************************************/
+
+static bool epoll_woken(FAR struct epoll_head_s *eph)
+{
+  irqstate_t flags;
+  bool foreign = false;
+
+  flags = enter_critical_section();
+  if (eph->nposts > 0)
+    {
+      eph->nposts--;
+    }
+  else
+    {
+      foreign = true;
+    }
+
+  leave_critical_section(flags);
+  return foreign;
+}
+
+/****************************************************************************
+ * Name: epoll_scan
+ *
+ * Description:
+ *   Drivers that have not been converted to poll_notify() post the
+ *   semaphore directly without calling the notification callback.  When
+ *   such a post is seen, look for their items by their revents.  This is
+ *   the only operation whose cost depends on the size of the interest
+ *   list.
+ *
+ ****************************************************************************/
+
+static void epoll_scan(FAR struct epoll_head_s *eph)
+{
+  FAR struct epoll_item_s *epi;
+  irqstate_t flags;
+  int i;
+
+  for (i = 0; i < EPOLL_NBUCKETS; i++)
+    {
+      for (epi = eph->hash[i]; epi != NULL; epi = epi->flink)
+        {
+          flags = enter_critical_section();
+          if (epi->armed && !epi->queued && epi->pfd.revents != 0)
+            {
+              dq_addlast(&epi->rnode, &eph->ready);
+              epi->queued = true;
+            }
+
+          leave_critical_section(flags);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: epoll_harvest
+ *
+ * Description:
+ *   Move up to maxevents ready items into the caller's event array.  Each
+ *   item is polled again before it is reported so that events consumed
+ *   since the notification are not reported.  A level-triggered item is
+ *   then put back in the ready list to be polled again by the next
+ *   epoll_wait(); an edge-triggered item stays armed and waits for the next
+ *   notification; a one-shot item is disarmed.
+ *
+ * Returned Value:
+ *   The number of events returned.
+ *
+ ****************************************************************************/
+
+static int epoll_harvest(FAR struct epoll_head_s *eph,
+                         FAR struct epoll_event *evs, int maxevents)
+{
+  FAR struct epoll_item_s *requeue = NULL;
+  FAR struct epoll_item_s *epi;
+  dq_queue_t ready;
+  pollevent_t revents;
+  irqstate_t flags;
+  int nevents = 0;
+
+  /* Only the items that are ready now are harvested.  Notifications that
+   * arrive while they are being polled go to the ready list of the
+   * instance, so no item is reported twice by one call.  The items keep
+   * their queued flag until they are polled so that a notification cannot
+   * link them into both lists.
+   */
+
+  flags = enter_critical_section();
+  dq_init(&ready);
+  dq_cat(&eph->ready, &ready);
+  leave_critical_section(flags);
+
+  while (nevents < maxevents)
+    {
+      flags = enter_critical_section();
+      epi = (FAR struct epoll_item_s *)dq_remfirst(&ready);
+      if (epi != NULL)
+        {
+          epi->queued      = false;
+          epi->pfd.revents = 0;
+        }
+
+      leave_critical_section(flags);
+
+      if (epi == NULL)
+        {
+          break;
+        }
+
+      if (!epi->armed)
+        {
+          continue;
+        }
+
+      revents  = epoll_repoll(epi);
+      revents &= epi->pfd.events | POLLERR | POLLHUP;
+      if (revents == 0)
+        {
+          continue;
+        }
+
+      evs[nevents].events = revents;
+      evs[nevents].data   = epi->event.data;
+      nevents++;
+
+      if ((epi->event.events & EPOLLONESHOT) != 0)
+        {
+          epoll_disarm(epi);
+        }
+      else if ((epi->event.events & EPOLLET) == 0)
+        {
+          epi->rlink = requeue;
+          requeue    = epi;
+        }
+    }
+
+  /* Return the items that did not fit in the caller's array to the head of
+   * the ready list and queue the level-triggered items after them.
    */
 
-  return (int)((intptr_t)eph);
+  flags = enter_critical_section();
+  while ((epi = (FAR struct epoll_item_s *)dq_remlast(&ready)) != NULL)
+    {
+      dq_addfirst(&epi->rnode, &eph->ready);
+    }
+
+  for (epi = requeue; epi != NULL; epi = epi->rlink)
+    {
+      if (!epi->queued)
+        {
+          dq_addlast(&epi->rnode, &eph->ready);
+          epi->queued = true;
+        }
+    }
+
+  leave_critical_section(flags);
+  return nevents;
 }
 
 /****************************************************************************
- * Name: epoll_close
+ * Name: epoll_do_open
+ *
+ * Description:
+ *   Called when the epoll file descriptor is duplicated.
+ *
+ ****************************************************************************/
+
+static int epoll_do_open(FAR struct file *filep)
+{
+  FAR struct epoll_head_s *eph = filep->f_inode->i_private;
+  int ret;
+
+  ret = epoll_takesem(&g_epollsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  eph->crefs++;
+  nxsem_post(&g_epollsem);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: epoll_do_close
+ *
+ * Description:
+ *   Called when an epoll file descriptor is closed.  The instance is
+ *   destroyed when the last descriptor referring to it is closed and no
+ *   epoll_ctl() or epoll_wait() call is using it.
+ *
+ ****************************************************************************/
+
+static int epoll_do_close(FAR struct file *filep)
+{
+  epoll_puthead((FAR struct epoll_head_s *)filep->f_inode->i_private);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: epoll_create1
  *
  * Description:
+ *   Create an epoll instance and return a file descriptor referring to it.
+ *   The instance is released when the last descriptor referring to it is
+ *   closed.
  *
  * Input Parameters:
+ *   flags - Zero or EPOLL_CLOEXEC
  *
  * Returned Value:
+ *   A new file descriptor on success; -1 (ERROR) on failure with errno set
+ *   appropriately.
  *
  ****************************************************************************/
 
-void epoll_close(int epfd)
+int epoll_create1(int flags)
 {
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
+  FAR struct epoll_head_s *eph;
+  FAR struct inode *inode;
+  int errcode;
+  int fd;
+
+  if ((flags & ~EPOLL_CLOEXEC) != 0)
+    {
+      errcode = EINVAL;
+      goto errout;
+    }
+
+  eph = (FAR struct epoll_head_s *)kmm_zalloc(sizeof(struct epoll_head_s));
+  if (eph == NULL)
+    {
+      errcode = ENOMEM;
+      goto errout;
+    }
+
+  /* Each instance has its own unlinked pseudo-inode so that the instance
+   * can be found from any duplicate of the descriptor.  The inode is freed
+   * by inode_release() when the last reference is dropped.
    */
 
-  FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
+  inode = (FAR struct inode *)kmm_zalloc(FSNODE_SIZE(0));
+  if (inode == NULL)
+    {
+      errcode = ENOMEM;
+      goto errout_with_eph;
+    }
+
+  nxsem_init(&eph->exclsem, 0, 1);
+  nxsem_init(&eph->waitsem, 0, 0);
+  nxsem_setprotocol(&eph->waitsem, SEM_PRIO_NONE);
+  dq_init(&eph->ready);
+  eph->crefs       = 1;
+
+  inode->i_crefs   = 1;
+  inode->i_flags   = FSNODEFLAG_TYPE_DRIVER | FSNODEFLAG_DELETED;
+  inode->u.i_ops   = &g_epoll_ops;
+  inode->i_private = eph;
 
-  kmm_free(eph->evs);
+  fd = files_allocate(inode, O_RDOK, 0, 0);
+  if (fd < 0)
+    {
+      nxsem_destroy(&eph->waitsem);
+      nxsem_destroy(&eph->exclsem);
+      kmm_free(inode);
+      errcode = EMFILE;
+      goto errout_with_eph;
+    }
+
+  return fd;
+
+errout_with_eph:
   kmm_free(eph);
+
+errout:
+  set_errno(errcode);
+  return ERROR;
+}
+
+/****************************************************************************
+ * Name: epoll_create
+ *
+ * Description:
+ *   Create an epoll instance.  The size argument is only a hint and must
+ *   be positive.
+ *
+ ****************************************************************************/
+
+int epoll_create(int size)
+{
+  if (size <= 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  return epoll_create1(0);
+}
+
+/****************************************************************************
+ * Name: epoll_release
+ *
+ * Description:
+ *   Remove a file or socket from the interest list of every epoll instance.
+ *   Called when the file or socket is closed, before it is torn down, so
+ *   that no driver is left holding a poll structure for it.
+ *
+ * Input Parameters:
+ *   obj - The struct file or struct socket that is being closed
+ *
+ ****************************************************************************/
+
+void epoll_release(FAR void *obj)
+{
+  FAR struct epoll_item_s **link;
+  FAR struct epoll_item_s *epi;
+  FAR struct epoll_head_s *eph;
+
+  if (epoll_takesem(&g_epollsem) < 0)
+    {
+      return;
+    }
+
+  link = &g_epollobj[EPOLL_OBJHASH(obj)];
+  while ((epi = *link) != NULL)
+    {
+      if (epi->obj != obj)
+        {
+          link = &epi->olink;
+          continue;
+        }
+
+      eph = epi->eph;
+      if (epoll_semtake(eph) < 0)
+        {
+          break;
+        }
+
+      epoll_unlink(epi);
+      epoll_freeitem(epi);
+      epoll_semgive(eph);
+    }
+
+  nxsem_post(&g_epollsem);
+}
+
+/****************************************************************************
+ * Name: epoll_close
+ *
+ * Description:
+ *   Close an epoll instance.  Equivalent to close(epfd).
+ *
+ ****************************************************************************/
+
+void epoll_close(int epfd)
+{
+  (void)close(epfd);
 }
 
 /****************************************************************************
  * Name: epoll_ctl
  *
  * Description:
+ *   Add, modify or remove an entry in the interest list of an epoll
+ *   instance.  An entry is removed automatically when its file descriptor
+ *   is closed.
  *
  * Input Parameters:
+ *   epfd - The epoll instance
+ *   op   - EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL
+ *   fd   - The file or socket descriptor of interest
+ *   ev   - The events of interest and the user data to return with them.
+ *          Ignored for EPOLL_CTL_DEL.
  *
  * Returned Value:
+ *   Zero (OK) on success; -1 (ERROR) on failure with errno set
+ *   appropriately.
  *
  ****************************************************************************/
 
-int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
+int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
 {
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
+  FAR struct filelist *list;
+  FAR struct epoll_head_s *eph;
+  FAR struct epoll_item_s *epi;
+  int ret = OK;
+
+  if (fd == epfd || fd < 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  if (op != EPOLL_CTL_DEL && ev == NULL)
+    {
+      set_errno(EFAULT);
+      return ERROR;
+    }
+
+  eph = epoll_gethead(epfd);
+  if (eph == NULL)
+    {
+      set_errno(EBADF);
+      return ERROR;
+    }
+
+  /* The file list semaphore keeps the descriptor from being closed while a
+   * new item is set up.
    */
 
-  FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
+  list = sched_getfiles();
+  files_semtake(list);
+  ret = epoll_takesem(&g_epollsem);
+  if (ret < 0)
+    {
+      goto errout_with_list;
+    }
+
+  ret = epoll_semtake(eph);
+  if (ret < 0)
+    {
+      goto errout_with_epollsem;
+    }
+
+  epi = epoll_find(eph, fd);
 
   switch (op)
     {
       case EPOLL_CTL_ADD:
-        finfo("%08x CTL ADD(%d): fd=%d ev=%08x\n",
-              epfd, eph->occupied, fd, ev->events);
+        finfo("%d CTL ADD: fd=%d ev=%08x\n", epfd, fd, ev->events);
 
-        eph->evs[eph->occupied].events = ev->events | POLLERR | POLLHUP;
-        eph->evs[eph->occupied++].data.fd = fd;
-        return 0;
+        if (epi != NULL)
+          {
+            ret = -EEXIST;
+            break;
+          }
 
-      case EPOLL_CTL_DEL:
-        {
-          int i;
+        epi = (FAR struct epoll_item_s *)
+          kmm_zalloc(sizeof(struct epoll_item_s));
+        if (epi == NULL)
+          {
+            ret = -ENOMEM;
+            break;
+          }
 
-          for (i = 0; i < eph->occupied; i++)
-            {
-              if (eph->evs[i].data.fd == fd)
-                {
-                  if (i != eph->occupied - 1)
-                    {
-                      memmove(&eph->evs[i], &eph->evs[i + 1],
-                              eph->occupied - i);
-                    }
-
-                  eph->occupied--;
-                  return 0;
-                }
-            }
+        epi->eph   = eph;
+        epi->fd    = fd;
+        epi->event = *ev;
 
-          return -ENOENT;
-        }
+        ret = epoll_getobj(epi, fd);
+        if (ret < 0)
+          {
+            kmm_free(epi);
+            break;
+          }
+
+        ret = epoll_arm(epi);
+        if (ret < 0)
+          {
+            epoll_freeitem(epi);
+            break;
+          }
+
+        epi->flink                = eph->hash[EPOLL_HASH(fd)];
+        eph->hash[EPOLL_HASH(fd)] = epi;
+
+        epi->olink = g_epollobj[EPOLL_OBJHASH(epi->obj)];
+        g_epollobj[EPOLL_OBJHASH(epi->obj)] = epi;
+        break;
 
       case EPOLL_CTL_MOD:
-        {
-          int i;
+        finfo("%d CTL MOD: fd=%d ev=%08x\n", epfd, fd, ev->events);
 
-          finfo("%08x CTL MOD(%d): fd=%d ev=%08x\n",
-                epfd, eph->occupied, fd, ev->events);
+        if (epi == NULL)
+          {
+            ret = -ENOENT;
+            break;
+          }
 
-          for (i = 0; i < eph->occupied; i++)
-            {
-              if (eph->evs[i].data.fd == fd)
-                {
-                  eph->evs[i].events = ev->events | POLLERR | POLLHUP;
-                  return 0;
-                }
-            }
+        epoll_disarm(epi);
+        epi->event = *ev;
+        ret = epoll_arm(epi);
+        break;
 
-          return -ENOENT;
-        }
+      case EPOLL_CTL_DEL:
+        finfo("%d CTL DEL: fd=%d\n", epfd, fd);
+
+        if (epi == NULL)
+          {
+            ret = -ENOENT;
+            break;
+          }
+
+        epoll_unlink(epi);
+        epoll_freeitem(epi);
+        break;
+
+      default:
+        ret = -EINVAL;
+        break;
     }
 
-  return -EINVAL;
+  epoll_semgive(eph);
+
+errout_with_epollsem:
+  nxsem_post(&g_epollsem);
+
+errout_with_list:
+  files_semgive(list);
+  epoll_puthead(eph);
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      return ERROR;
+    }
+
+  return OK;
 }
 
 /****************************************************************************
  * Name: epoll_wait
  *
  * Description:
+ *   Wait for events on an epoll instance.  Events are taken from the ready
+ *   list filled by the drivers' poll notifications, so the cost depends on
+ *   the number of ready descriptors rather than on the size of the interest
+ *   list.
  *
  * Input Parameters:
+ *   epfd      - The epoll instance
+ *   evs       - The array that receives the ready events
+ *   maxevents - The size of evs
+ *   timeout   - The maximum time to wait in milliseconds.  Zero returns
+ *               immediately; a negative value waits forever.
  *
  * Returned Value:
+ *   The number of events returned in evs, zero on a timeout, or -1 (ERROR)
+ *   on failure with errno set appropriately.
  *
  ****************************************************************************/
 
 int epoll_wait(int epfd, FAR struct epoll_event *evs, int maxevents,
                int timeout)
 {
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
-   */
+  FAR struct epoll_head_s *eph;
+  clock_t start;
+  clock_t ticks = 0;
+  bool scan = false;
+  int ret;
 
-  FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
-  int counter;
-  int rc;
-  int i;
+  /* epoll_wait() is a cancellation point */
 
-  rc = poll((FAR struct pollfd *)eph->evs, eph->occupied, timeout);
+  (void)enter_cancellation_point();
 
-  if (rc <= 0)
+  if (evs == NULL || maxevents <= 0)
     {
-      if (rc < 0)
-        {
-          ferr("ERROR: %08x poll fail: %d for %d, %d msecs\n",
-               epfd, rc, eph->occupied, timeout);
+      ret = -EINVAL;
+      goto errout;
+    }
 
-          for (i = 0; i < eph->occupied; i++)
-            {
-              ferr("  %02d: fd=%d\n", i, eph->evs[i].data.fd);
-            }
-        }
+  eph = epoll_gethead(epfd);
+  if (eph == NULL)
+    {
+      ret = -EBADF;
+      goto errout;
+    }
 
-      return rc;
+  if (timeout > 0)
+    {
+      /* Round the timeout up to the next full tick, as poll() does */
+
+#if (MSEC_PER_TICK * USEC_PER_MSEC) != USEC_PER_TICK && \
+    defined(CONFIG_HAVE_LONG_LONG)
+      ticks = (((unsigned long long)timeout * USEC_PER_MSEC) +
+               (USEC_PER_TICK - 1)) /
+              USEC_PER_TICK;
+#else
+      ticks = ((unsigned int)timeout + (MSEC_PER_TICK - 1)) /
+              MSEC_PER_TICK;
+#endif
     }
 
-  /* Iterate over non NULL event fds */
+  start = clock_systimer();
 
-  for (i = 0, counter = 0; i < rc && counter < eph->size; counter++)
+  for (; ; )
     {
-      if (eph->evs[counter].revents != 0)
+      ret = epoll_semtake(eph);
+      if (ret < 0)
+        {
+          goto errout_with_eph;
+        }
+
+      /* Discard the posts left behind by earlier calls.  Items that are
+       * still ready remain in the ready list.
+       */
+
+      if (epoll_drain(eph) || scan)
+        {
+          epoll_scan(eph);
+        }
+
+      ret = epoll_harvest(eph, evs, maxevents);
+      epoll_semgive(eph);
+
+      if (ret > 0 || timeout == 0)
+        {
+          break;
+        }
+
+      /* Nothing ready.  Wait for a notification, a signal, or the end of
+       * the timeout measured from the start of the call.
+       */
+
+      if (timeout > 0)
+        {
+          ret = nxsem_tickwait(&eph->waitsem, start, ticks);
+          if (ret == -ETIMEDOUT)
+            {
+              ret = 0;
+              break;
+            }
+        }
+      else
         {
-          evs[i].data.fd = eph->evs[counter].data.fd;
-          evs[i].events  = eph->evs[counter].revents;
-          i += 1;
+          ret = nxsem_wait(&eph->waitsem);
         }
+
+      if (ret < 0)
+        {
+          goto errout_with_eph;
+        }
+
+      /* The wakeup may come from a driver that posts the semaphore
+       * directly.
+       */
+
+      scan = epoll_woken(eph);
     }
 
-  return i;
-}
+  epoll_puthead(eph);
+  leave_cancellation_point();
+  return ret;
+
+errout_with_eph:
+  epoll_puthead(eph);
 
+errout:
+  leave_cancellation_point();
+  set_errno(-ret);
+  return ERROR;
+}
@@ -100,8 +100,12 @@ int fs_getfilep(int fd, FAR struct file **filep)
       return -EAGAIN;
     }
 
-  /* And return the file pointer from the list */
+  /* And return the file pointer from the list.  No lock is needed: once
+   * allocated, a row of file structures stays in place until the list is
+   * released, and files_fget() orders the read of the row pointer with the
+   * read of the row.
+   */
 
-  *filep = &list->fl_files[fd];
-  return OK;
+  *filep = files_fget(list, fd);
+  return *filep != NULL ? OK : -EBADF;
 }
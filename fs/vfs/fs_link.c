@@ -159,19 +159,22 @@ int link(FAR const char *path1, FAR const char *path2)
 
       inode_semtake();
       ret = inode_reserve(path2, &inode);
-      inode_semgive();
-
       if (ret < 0)
         {
+          inode_semgive();
           kmm_free(newpath2);
           errcode = -ret;
           goto errout_with_search;
         }
 
-      /* Initialize the inode */
+      /* Initialize the inode before the tree is unlocked so that no search
+       * can see (and cache) it as an ordinary node.
+       */
 
       INODE_SET_SOFTLINK(inode);
       inode->u.i_link = newpath2;
+      inode_cache_invalidate();
+      inode_semgive();
     }
 
   /* Symbolic link successfully created */
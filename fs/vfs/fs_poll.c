@@ -151,6 +151,8 @@ static inline int poll_setup(FAR struct pollfd *fds, nfds_t nfds,
       fds[i].sem     = sem;
       fds[i].revents = 0;
       fds[i].priv    = NULL;
+      fds[i].cb      = NULL;
+      fds[i].arg     = NULL;
 
       /* Check for invalid descriptors. "If the value of fd is less than 0,
        * events shall be ignored, and revents shall be set to 0 in that entry
@@ -306,6 +308,55 @@ static inline int poll_teardown(FAR struct pollfd *fds, nfds_t nfds,
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: poll_notify
+ *
+ * Description:
+ *   Report poll events to a set of waiters.  Each non-NULL entry of afds
+ *   has the requested events in eventset (along with POLLERR and POLLHUP)
+ *   added to its revents.  Any entry with pending revents is then notified
+ *   by calling its callback if one is set, or by posting its semaphore
+ *   otherwise.
+ *
+ * Input Parameters:
+ *   afds     - An array of references to poll structures
+ *   nfds     - The number of entries in afds
+ *   eventset - The set of events to report
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   May be called from interrupt handlers.
+ *
+ ****************************************************************************/
+
+void poll_notify(FAR struct pollfd **afds, int nfds, pollevent_t eventset)
+{
+  FAR struct pollfd *fds;
+  int i;
+
+  for (i = 0; i < nfds; i++)
+    {
+      fds = afds[i];
+      if (fds != NULL)
+        {
+          fds->revents |= eventset & (fds->events | POLLERR | POLLHUP);
+          if (fds->revents != 0)
+            {
+              if (fds->cb != NULL)
+                {
+                  fds->cb(fds);
+                }
+              else
+                {
+                  nxsem_post(fds->sem);
+                }
+            }
+        }
+    }
+}
+
 /****************************************************************************
  * Name: file_poll
  *
@@ -357,11 +408,7 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
         {
           if (setup)
             {
-              fds->revents |= (fds->events & (POLLIN | POLLOUT));
-              if (fds->revents != 0)
-                {
-                  nxsem_post(fds->sem);
-                }
+              poll_notify(&fds, 1, POLLIN | POLLOUT);
             }
 
           ret = OK;
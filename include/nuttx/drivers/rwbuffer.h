@@ -67,7 +67,15 @@ typedef CODE ssize_t (*rwbreload_t)(FAR void *dev, FAR uint8_t *buffer,
 typedef CODE ssize_t (*rwbflush_t)(FAR void *dev, FAR const uint8_t *buffer,
                                    off_t startblock, size_t nblocks);
 
-/* This structure holds the state of the buffers.  In typical usage,
+/* This structure holds the state of the buffers.  The write buffer is a
+ * write-combining cache of individual blocks:  Rewriting a block that is
+ * already buffered just replaces its data and unrelated blocks may be
+ * buffered together.  When the buffer is flushed, the blocks are sorted
+ * and each run of consecutive blocks is passed to the flush callout in a
+ * single call.  The read-ahead window grows while reads are sequential
+ * and shrinks back to the request size when they are not.
+ *
+ * In typical usage,
  * an instance of this structure is declared within each block driver
  * status structure like:
  *
@@ -137,11 +145,11 @@ struct rwbuffer_s
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
   sem_t         wrsem;           /* Enforces exclusive access to the write buffer */
-  struct work_s work;            /* Delayed work to flush buffer after a delay with no activity */
-  uint8_t      *wrbuffer;        /* Allocated write buffer */
+  struct work_s work;            /* Work to flush the write buffer */
+  uint8_t      *wrbuffer;        /* Write buffer plus one scratch block */
+  FAR off_t    *wrblocks;        /* Block held in each buffer slot */
+  FAR uint16_t *wrorder;         /* Used to sort the slots when flushing */
   uint16_t      wrnblocks;       /* Number of blocks in write buffer */
-  off_t         wrblockstart;    /* First block in write buffer */
-  off_t         wrexpectedblock; /* Next block expected */
 #endif
 
   /* This is the state of the read-ahead buffering */
@@ -150,10 +158,44 @@ struct rwbuffer_s
   sem_t         rhsem;           /* Enforces exclusive access to the write buffer */
   uint8_t      *rhbuffer;        /* Allocated read-ahead buffer */
   uint16_t      rhnblocks;       /* Number of blocks in read-ahead buffer */
+  uint16_t      rhwindow;        /* Number of blocks to read ahead next */
   off_t         rhblockstart;    /* First block in read-ahead buffer */
+  off_t         rhexpected;      /* Block following the previous read */
 #endif
+
+  /* Statistics (in blocks, except for nflush) */
+
+  uint32_t      rdhits;          /* Blocks read from the buffers */
+  uint32_t      rdmisses;        /* Blocks read from the media */
+  uint32_t      wrhits;          /* Writes combined with a buffered block */
+  uint32_t      wrmisses;        /* Blocks added to the write buffer */
+  uint32_t      nflush;          /* Number of calls to the flush callout */
+
+  FAR struct rwbuffer_s *flink;  /* Supports a list of all buffers */
+};
+
+/* Form in which the state of a buffer is returned by rwb_info() */
+
+struct rwb_info_s
+{
+  FAR void *dev;                 /* Device state of the buffer's owner */
+  uint16_t  blocksize;           /* The size of one block */
+  uint16_t  wrmaxblocks;         /* Size of the write buffer in blocks */
+  uint16_t  wrnblocks;           /* Number of dirty blocks */
+  uint16_t  rhmaxblocks;         /* Size of the read-ahead buffer in blocks */
+  uint16_t  rhwindow;            /* Current read-ahead window in blocks */
+  uint32_t  rdhits;              /* Blocks read from the buffers */
+  uint32_t  rdmisses;            /* Blocks read from the media */
+  uint32_t  wrhits;              /* Writes combined with a buffered block */
+  uint32_t  wrmisses;            /* Blocks added to the write buffer */
+  uint32_t  nflush;              /* Number of calls to the flush callout */
 };
 
+/* Callback used by rwb_foreach() */
+
+typedef CODE void (*rwb_handler_t)(FAR struct rwbuffer_s *rwb,
+                                   FAR void *arg);
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -206,6 +248,11 @@ int rwb_invalidate(FAR struct rwbuffer_s *rwb,
 int rwb_flush(FAR struct rwbuffer_s *rwb);
 #endif
 
+/* Statistics */
+
+void rwb_info(FAR struct rwbuffer_s *rwb, FAR struct rwb_info_s *info);
+void rwb_foreach(rwb_handler_t handler, FAR void *arg);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
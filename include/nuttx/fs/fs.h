@@ -49,6 +49,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <semaphore.h>
+#include <poll.h>
 
 #ifdef CONFIG_FS_NAMED_SEMAPHORES
 #  include <nuttx/semaphore.h>
@@ -203,6 +204,17 @@
 #define OPEN_SETFD(f)   ((f) | OPEN_MAGIC)
 #define OPEN_GETFD(r)   ((r) & OPEN_MASK)
 
+/* File descriptor lists */
+
+#ifndef CONFIG_NFILE_DESCRIPTORS_PER_BLOCK
+#  define CONFIG_NFILE_DESCRIPTORS_PER_BLOCK 8
+#endif
+
+#define FILELIST_NROWS \
+  ((CONFIG_NFILE_DESCRIPTORS + CONFIG_NFILE_DESCRIPTORS_PER_BLOCK - 1) / \
+   CONFIG_NFILE_DESCRIPTORS_PER_BLOCK)
+#define FILELIST_NWORDS ((CONFIG_NFILE_DESCRIPTORS + 31) >> 5)
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -258,6 +270,19 @@ struct geometry
   size_t geo_sectorsize;   /* Size of one sector */
 };
 
+/* One segment of a vectored block transfer:  'bv_nsectors' sectors
+ * beginning with sector 'bv_sector' are transferred to/from 'bv_buffer'.
+ * The segments of one request need not be contiguous on the media or in
+ * memory.
+ */
+
+struct block_iovec_s
+{
+  size_t       bv_sector;   /* First sector of the segment */
+  unsigned int bv_nsectors; /* Number of sectors in the segment */
+  FAR void    *bv_buffer;   /* Memory holding the sectors */
+};
+
 /* This structure is provided by block devices when they register with the
  * system.  It is used by file systems to perform filesystem transfers.  It
  * differs from the normal driver vtable in several ways -- most notably in
@@ -278,6 +303,17 @@ struct block_operations
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   int     (*unlink)(FAR struct inode *inode);
 #endif
+
+  /* Optional vectored transfers.  These perform all of the segments as one
+   * request (e.g., one multi-block command) and return the number of
+   * sectors transferred.  Drivers that do not provide these are accessed
+   * through block_readv() and block_writev() one segment at a time.
+   */
+
+  ssize_t (*readv)(FAR struct inode *inode,
+            FAR const struct block_iovec_s *iov, int iovcnt);
+  ssize_t (*writev)(FAR struct inode *inode,
+            FAR const struct block_iovec_s *iov, int iovcnt);
 };
 
 /* This structure is provided by a filesystem to describe a mount point.
@@ -421,12 +457,18 @@ struct file
   void             *f_priv;     /* Per file driver private data */
 };
 
-/* This defines a list of files indexed by the file descriptor */
+/* This defines a list of files indexed by the file descriptor.  The file
+ * structures are allocated on demand in rows of
+ * CONFIG_NFILE_DESCRIPTORS_PER_BLOCK entries.  A row is never freed or
+ * moved until the list is released, so a file structure can be looked up
+ * without taking fl_sem.  fl_used holds one bit per descriptor in use.
+ */
 
 struct filelist
 {
   sem_t   fl_sem;               /* Manage access to the file list */
-  struct file fl_files[CONFIG_NFILE_DESCRIPTORS];
+  uint32_t fl_used[FILELIST_NWORDS];
+  FAR struct file *fl_rows[FILELIST_NROWS];
 };
 
 /* The following structure defines the list of files used for standard C I/O.
@@ -711,6 +753,30 @@ void files_initlist(FAR struct filelist *list);
 
 void files_releaselist(FAR struct filelist *list);
 
+/****************************************************************************
+ * Name: files_fget
+ *
+ * Description:
+ *   Return the file structure of a descriptor in a file list, or NULL if it
+ *   has never been allocated.  The descriptor must be in range.  This may
+ *   be called without holding the list semaphore.
+ *
+ ****************************************************************************/
+
+FAR struct file *files_fget(FAR struct filelist *list, int fd);
+
+/****************************************************************************
+ * Name: files_duplist
+ *
+ * Description:
+ *   Duplicate the first 'nfds' file descriptors of the file list 'plist'
+ *   into the new file list 'clist'.
+ *
+ ****************************************************************************/
+
+void files_duplist(FAR struct filelist *plist, FAR struct filelist *clist,
+                   int nfds);
+
 /****************************************************************************
  * Name: file_dup2
  *
@@ -906,6 +972,35 @@ int open_blockdriver(FAR const char *pathname, int mountflags,
 
 int close_blockdriver(FAR struct inode *inode);
 
+/****************************************************************************
+ * Name: block_readv and block_writev
+ *
+ * Description:
+ *   Perform a vectored transfer with a block driver.  The driver's readv or
+ *   writev method is used if it provides one.  Otherwise, the segments are
+ *   transferred in order with the read or write method; segments that are
+ *   contiguous both on the media and in memory are combined into a single
+ *   transfer.
+ *
+ * Input Parameters:
+ *   inode  - reference to the inode of a block driver
+ *   iov    - the list of segments to transfer
+ *   iovcnt - the number of segments in the list
+ *
+ * Returned Value:
+ *   The total number of sectors transferred (which is less than requested
+ *   only if the driver returned a short count) or a negated errno value if
+ *   no sectors could be transferred.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_MOUNTPOINT
+ssize_t block_readv(FAR struct inode *inode,
+                    FAR const struct block_iovec_s *iov, int iovcnt);
+ssize_t block_writev(FAR struct inode *inode,
+                     FAR const struct block_iovec_s *iov, int iovcnt);
+#endif
+
 /****************************************************************************
  * Name: fs_ioctl
  *
@@ -1235,6 +1330,49 @@ int file_vfcntl(FAR struct file *filep, int cmd, va_list ap);
 
 int file_fcntl(FAR struct file *filep, int cmd, ...);
 
+/****************************************************************************
+ * Name: poll_notify
+ *
+ * Description:
+ *   Report poll events to a set of waiters.  Each non-NULL entry of afds
+ *   has the requested events in eventset (along with POLLERR and POLLHUP)
+ *   added to its revents.  Any entry with pending revents is then notified
+ *   by calling its callback if one is set, or by posting its semaphore
+ *   otherwise.
+ *
+ * Input Parameters:
+ *   afds     - An array of references to poll structures
+ *   nfds     - The number of entries in afds
+ *   eventset - The set of events to report
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   May be called from interrupt handlers.
+ *
+ ****************************************************************************/
+
+void poll_notify(FAR struct pollfd **afds, int nfds, pollevent_t eventset);
+
+/****************************************************************************
+ * Name: epoll_release
+ *
+ * Description:
+ *   Remove a file or socket from the interest list of every epoll instance.
+ *   Called when the file or socket is closed, before it is torn down, so
+ *   that no driver is left holding a poll structure for it.
+ *
+ * Input Parameters:
+ *   obj - The struct file or struct socket that is being closed
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void epoll_release(FAR void *obj);
+
 /****************************************************************************
  * Name: file_poll
  *
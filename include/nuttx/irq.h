@@ -46,6 +46,9 @@
 #ifndef __ASSEMBLY__
 # include <stdint.h>
 # include <assert.h>
+# ifdef CONFIG_SMP
+#   include <nuttx/spinlock.h>
+# endif
 #endif
 
 /****************************************************************************
@@ -296,6 +299,67 @@ void spin_unlock_irqrestore(irqstate_t flags);
 #  define spin_unlock_irqrestore(f) leave_critical_section(f)
 #endif
 
+/****************************************************************************
+ * Name: spin_lock_save
+ *
+ * Description:
+ *   If SMP is enabled:
+ *     Disable local interrupts and take the caller-provided spinlock.
+ *     Unlike enter_critical_section(), this does not stall other CPUs
+ *     unless they also need the same lock.  This is intended to protect
+ *     private data structures (free lists and the like) that are also
+ *     accessed from interrupt handlers.
+ *
+ *     NOTE: The lock is not re-entrant.  The caller must not block, call
+ *     any function that may suspend the caller (e.g. nxsem_wait), or take
+ *     the same lock again before spin_unlock_restore() is called.
+ *
+ *   If SMP is not enabled:
+ *     This function is equivalent to enter_critical_section() and the
+ *     lock is not referenced (and need not exist).
+ *
+ * Input Parameters:
+ *   lock - The spinlock that protects the data
+ *
+ * Returned Value:
+ *   An opaque, architecture-specific value that represents the state of
+ *   the interrupts prior to the call to spin_lock_save();
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+irqstate_t spin_lock_save(FAR volatile spinlock_t *lock);
+#else
+#  define spin_lock_save(l) enter_critical_section()
+#endif
+
+/****************************************************************************
+ * Name: spin_unlock_restore
+ *
+ * Description:
+ *   If SMP is enabled:
+ *     Release the spinlock taken by spin_lock_save() and restore the
+ *     interrupt state as it was prior to that call.
+ *
+ *   If SMP is not enabled:
+ *     This function is equivalent to leave_critical_section().
+ *
+ * Input Parameters:
+ *   lock  - The spinlock that was passed to spin_lock_save()
+ *   flags - The architecture-specific value that represents the state of
+ *           the interrupts prior to the call to spin_lock_save();
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+void spin_unlock_restore(FAR volatile spinlock_t *lock, irqstate_t flags);
+#else
+#  define spin_unlock_restore(l,f) leave_critical_section(f)
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
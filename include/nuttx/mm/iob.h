@@ -80,14 +80,40 @@
 #  error CONFIG_IOB_NBUFFERS is zero
 #endif
 
-#if CONFIG_IOB_NBUFFERS <= CONFIG_IOB_THROTTLE
+/* A second pool of large I/O buffers may also be provided */
+
+#if !defined(CONFIG_IOB_NLARGE)
+#  define CONFIG_IOB_NLARGE 0
+#endif
+
+#if CONFIG_IOB_NLARGE > 0
+#  if !defined(CONFIG_IOB_LARGE_BUFSIZE) || \
+      CONFIG_IOB_LARGE_BUFSIZE <= CONFIG_IOB_BUFSIZE
+#    error CONFIG_IOB_LARGE_BUFSIZE must be larger than CONFIG_IOB_BUFSIZE
+#  endif
+#  define IOB_MAXBUFSIZE CONFIG_IOB_LARGE_BUFSIZE
+#else
+#  define IOB_MAXBUFSIZE CONFIG_IOB_BUFSIZE
+#endif
+
+/* The total number of I/O buffers of all sizes */
+
+#define IOB_NBUFFERS_TOTAL (CONFIG_IOB_NBUFFERS + CONFIG_IOB_NLARGE)
+
+#if IOB_NBUFFERS_TOTAL <= CONFIG_IOB_THROTTLE
 #  error CONFIG_IOB_NBUFFERS <= CONFIG_IOB_THROTTLE
 #endif
 
 /* IOB helpers */
 
+#if CONFIG_IOB_NLARGE > 0
+#  define IOB_BUFSIZE(p) ((p)->io_bufsize)
+#else
+#  define IOB_BUFSIZE(p) CONFIG_IOB_BUFSIZE
+#endif
+
 #define IOB_DATA(p)      (&(p)->io_data[(p)->io_offset])
-#define IOB_FREESPACE(p) (CONFIG_IOB_BUFSIZE - (p)->io_len - (p)->io_offset)
+#define IOB_FREESPACE(p) (IOB_BUFSIZE(p) - (p)->io_len - (p)->io_offset)
 
 #if CONFIG_IOB_NCHAINS > 0
 /* Queue helpers */
@@ -103,6 +129,10 @@
 /* Represents one I/O buffer.  A packet is contained by one or more I/O
  * buffers in a chain.  The io_pktlen is only valid for the I/O buffer at
  * the head of the chain.
+ *
+ * If there are large I/O buffers, then the buffers in a chain may be of
+ * different sizes and the size of each must be obtained with
+ * IOB_BUFSIZE().  No buffer is smaller than CONFIG_IOB_BUFSIZE.
  */
 
 struct iob_s
@@ -113,7 +143,7 @@ struct iob_s
 
   /* Payload */
 
-#if CONFIG_IOB_BUFSIZE < 256
+#if IOB_MAXBUFSIZE < 256
   uint8_t  io_len;      /* Length of the data in the entry */
   uint8_t  io_offset;   /* Data begins at this offset */
 #else
@@ -121,8 +151,16 @@ struct iob_s
   uint16_t io_offset;   /* Data begins at this offset */
 #endif
   uint16_t io_pktlen;   /* Total length of the packet */
+#ifdef CONFIG_IOB_QUOTA
+  int8_t   io_user;     /* Consumer charged for the buffer */
+#endif
 
+#if CONFIG_IOB_NLARGE > 0
+  uint16_t io_bufsize;  /* Size of the data buffer */
+  FAR uint8_t *io_data; /* The data buffer */
+#else
   uint8_t  io_data[CONFIG_IOB_BUFSIZE];
+#endif
 };
 
 #if CONFIG_IOB_NCHAINS > 0
@@ -265,6 +303,64 @@ FAR struct iob_s *iob_alloc(bool throttled, enum iob_user_e consumerid);
 
 FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid);
 
+/****************************************************************************
+ * Name: iob_alloc_size
+ *
+ * Description:
+ *   Allocate an I/O buffer that is intended to hold 'size' bytes of data.
+ *   A large I/O buffer is preferred if 'size' will not fit into a small
+ *   one (see CONFIG_IOB_NLARGE).  A buffer of the other size is returned if
+ *   there are none of the preferred size; the caller must use IOB_BUFSIZE()
+ *   to determine the size of the buffer that was returned.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_size(unsigned int size, bool throttled,
+                                 enum iob_user_e consumerid);
+
+/****************************************************************************
+ * Name: iob_tryalloc_size
+ *
+ * Description:
+ *   Try to allocate an I/O buffer that is intended to hold 'size' bytes of
+ *   data as with iob_alloc_size(), but without waiting for a buffer to
+ *   become free.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_size(unsigned int size, bool throttled,
+                                    enum iob_user_e consumerid);
+
+/****************************************************************************
+ * Name: iob_setquota
+ *
+ * Description:
+ *   Set the I/O buffer quota of one consumer.
+ *
+ * Input Parameters:
+ *   userid  - The consumer whose quota is being set
+ *   reserve - The number of I/O buffers reserved for the consumer.  Other
+ *             consumers may not allocate these buffers while the consumer
+ *             holds fewer than 'reserve' buffers.
+ *   limit   - The maximum number of I/O buffers that the consumer may hold
+ *             at any time or zero if there is no limit.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure:
+ *
+ *   -EINVAL - The consumer is invalid or the limit is less than the
+ *             reservation.
+ *   -ENOSPC - The total of all reservations would exceed the number of
+ *             I/O buffers.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_QUOTA
+int iob_setquota(enum iob_user_e userid, unsigned int reserve,
+                 unsigned int limit);
+#endif
+
 /****************************************************************************
  * Name: iob_navail
  *
@@ -275,6 +371,19 @@ FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid);
 
 int iob_navail(bool throttled);
 
+/****************************************************************************
+ * Name: iob_navail_large
+ *
+ * Description:
+ *   Return the number of available large IOBs.  These are included in the
+ *   count returned by iob_navail().
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_NLARGE > 0
+int iob_navail_large(void);
+#endif
+
 /****************************************************************************
  * Name: iob_qentry_navail
  *
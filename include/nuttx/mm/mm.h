@@ -110,6 +110,21 @@
 #  undef CONFIG_MM_KERNEL_HEAP
 #endif
 
+/* The per-CPU small chunk caches are protected by disabling local
+ * interrupts.  That is only possible for heaps that are managed from
+ * privileged code:  The single heap of the FLAT build or the kernel heap.
+ * The cache storage is, however, always part of struct mm_heap_s when
+ * CONFIG_MM_CACHE is selected so that the structure has the same layout
+ * in the kernel and in the user pass of a PROTECTED build; the kernel code
+ * only uses the cache of heaps that have mm_cacheon set.
+ */
+
+#undef MM_HAVE_CACHE
+#if defined(CONFIG_MM_CACHE) && \
+    (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+#  define MM_HAVE_CACHE 1
+#endif
+
 /* Chunk Header Definitions *************************************************/
 /* These definitions define the characteristics of allocator
  *
@@ -162,6 +177,43 @@
 #define MM_MAX_CHUNK     (1 << MM_MAX_SHIFT)
 #define MM_NNODES        (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
 
+/* Two-level segregated fit (TLSF) free list definitions.
+ *
+ * MM_TLSF_SLBITS is the log2 of the number of second level lists in each
+ *   first level (power-of-two) size range.
+ * MM_TLSF_FLSHIFT - Sizes below (1 << MM_TLSF_FLSHIFT) are all held in
+ *   first level list 0 which is divided linearly in MM_MIN_CHUNK steps.
+ * MM_TLSF_FLCOUNT - The number of first level lists.  The last first
+ *   level list holds only chunks of size MM_MAX_CHUNK or larger.
+ */
+
+#ifdef CONFIG_MM_TLSF
+#  define MM_TLSF_SLBITS   CONFIG_MM_TLSF_SLBITS
+#  define MM_TLSF_SLCOUNT  (1 << MM_TLSF_SLBITS)
+#  define MM_TLSF_FLSHIFT  (MM_MIN_SHIFT + MM_TLSF_SLBITS)
+#  define MM_TLSF_FLCOUNT  (MM_MAX_SHIFT - MM_TLSF_FLSHIFT + 2)
+#endif
+
+/* Per-CPU cache definitions.
+ *
+ * MM_CACHE_MAXCHUNK - The largest chunk (including the allocated node
+ *   header) that may be held in the cache.
+ * MM_CACHE_NCLASSES - The number of cache size classes.  There is one size
+ *   class per MM_MIN_CHUNK granule up to MM_CACHE_MAXCHUNK.
+ */
+
+#ifdef CONFIG_MM_CACHE
+#  define MM_CACHE_MAXCHUNK MM_ALIGN_UP(CONFIG_MM_CACHE_MAXSIZE)
+#  define MM_CACHE_NCLASSES (MM_CACHE_MAXCHUNK >> MM_MIN_SHIFT)
+#  define MM_CACHE_NDX(s)   (((s) >> MM_MIN_SHIFT) - 1)
+
+#  ifdef CONFIG_SMP
+#    define MM_CACHE_NCPUS  CONFIG_SMP_NCPUS
+#  else
+#    define MM_CACHE_NCPUS  1
+#  endif
+#endif
+
 #define MM_GRAN_MASK     (MM_MIN_CHUNK-1)
 #define MM_ALIGN_UP(a)   (((a) + MM_GRAN_MASK) & ~MM_GRAN_MASK)
 #define MM_ALIGN_DOWN(a) ((a) & ~MM_GRAN_MASK)
@@ -232,6 +284,22 @@ struct mm_freenode_s
 #define CHECK_FREENODE_SIZE \
   DEBUGASSERT(sizeof(struct mm_freenode_s) == SIZEOF_MM_FREENODE)
 
+/* This describes the small chunk cache of one CPU.  Cached chunks remain
+ * marked as allocated in the heap.  They are held in singly linked lists,
+ * one per size class, with the link stored in the user memory of the
+ * chunk.
+ */
+
+#ifdef CONFIG_MM_CACHE
+struct mm_cache_s
+{
+  FAR void *mc_head[MM_CACHE_NCLASSES];   /* Cached chunks per size class */
+  uint8_t mc_count[MM_CACHE_NCLASSES];    /* Number of chunks per class */
+  uint32_t mc_hits;                       /* Allocations from the cache */
+  uint32_t mc_misses;                     /* Allocations from the heap */
+};
+#endif
+
 /* This describes one heap (possibly with multiple regions) */
 
 struct mm_heap_s
@@ -257,12 +325,33 @@ struct mm_heap_s
   int mm_nregions;
 #endif
 
+#ifdef CONFIG_MM_TLSF
+  /* All free nodes are maintained in unsorted, doubly linked lists
+   * segregated by size class.  mm_flbitmap has one bit set for each first
+   * level list with at least one non-empty second level list;
+   * mm_slbitmap[] has one bit set for each non-empty second level list.
+   */
+
+  uint32_t mm_flbitmap;
+  uint32_t mm_slbitmap[MM_TLSF_FLCOUNT];
+  struct mm_freenode_s mm_nodelist[MM_TLSF_FLCOUNT][MM_TLSF_SLCOUNT];
+#else
   /* All free nodes are maintained in a doubly linked list.  This
    * array provides some hooks into the list at various points to
    * speed searches for free nodes.
    */
 
   struct mm_freenode_s mm_nodelist[MM_NNODES];
+#endif
+
+#ifdef CONFIG_MM_CACHE
+  /* Per-CPU caches of small chunks.  mm_cacheon is only set for heaps
+   * whose caches may be used (see MM_HAVE_CACHE).
+   */
+
+  bool mm_cacheon;
+  struct mm_cache_s mm_cache[MM_CACHE_NCPUS];
+#endif
 };
 
 /****************************************************************************
@@ -367,6 +456,7 @@ void kmm_givesemaphore(void);
 
 /* Functions contained in mm_malloc.c ***************************************/
 
+FAR void *mm_allocchunk(FAR struct mm_heap_s *heap, size_t alignsize);
 FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size);
 
 /* Functions contained in kmm_malloc.c **************************************/
@@ -377,6 +467,7 @@ FAR void *kmm_malloc(size_t size);
 
 /* Functions contained in mm_free.c *****************************************/
 
+void mm_freechunk(FAR struct mm_heap_s *heap, FAR void *mem);
 void mm_free(FAR struct mm_heap_s *heap, FAR void *mem);
 
 /* Functions contained in kmm_free.c ****************************************/
@@ -514,10 +605,33 @@ void mm_shrinkchunk(FAR struct mm_heap_s *heap,
 void mm_addfreechunk(FAR struct mm_heap_s *heap,
                      FAR struct mm_freenode_s *node);
 
+/* Functions contained in mm_delfreechunk.c *********************************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node);
+
 /* Functions contained in mm_size2ndx.c.c ***********************************/
 
 int mm_size2ndx(size_t size);
 
+/* Functions contained in mm_tlsf.c *****************************************/
+
+#ifdef CONFIG_MM_TLSF
+void mm_tlsf_mapping(size_t size, FAR int *fl, FAR int *sl);
+FAR struct mm_freenode_s *mm_tlsf_search(FAR struct mm_heap_s *heap,
+                                         size_t size);
+#endif
+
+/* Functions contained in mm_cache.c ****************************************/
+
+#ifdef MM_HAVE_CACHE
+FAR void *mm_cache_alloc(FAR struct mm_heap_s *heap, size_t alignsize);
+void mm_cache_refill(FAR struct mm_heap_s *heap, size_t alignsize);
+bool mm_cache_free(FAR struct mm_heap_s *heap, FAR void *mem);
+void mm_cache_flush(FAR struct mm_heap_s *heap);
+void mm_cache_info(FAR struct mm_heap_s *heap, FAR struct mallinfo *info);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
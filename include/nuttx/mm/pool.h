@@ -0,0 +1,219 @@
+/****************************************************************************
+ * include/nuttx/mm/pool.h
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_MM_POOL_H
+#define __INCLUDE_NUTTX_MM_POOL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <queue.h>
+
+#include <nuttx/irq.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The actual size of each block in a pool of blocks of size 's' and the
+ * memory required to hold 'n' such blocks.
+ */
+
+#define KMM_POOL_BLOCKSIZE(s) \
+  (((s) + sizeof(FAR void *) - 1) & ~(sizeof(FAR void *) - 1))
+#define KMM_POOL_SIZE(s,n)    (KMM_POOL_BLOCKSIZE(s) * (n))
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This describes one pool of fixed-size blocks.  The structure is normally
+ * statically allocated by the pool owner and initialized with
+ * kmm_pool_initialize().  None of its fields should be accessed directly.
+ *
+ * Free blocks are kept in a singly linked list with the link in the first
+ * bytes of each block.  Blocks are taken from the caller-provided memory
+ * first and then, if mp_nexpand is non-zero, from the kernel heap in
+ * groups of mp_nexpand blocks.  Memory added from the heap is never
+ * returned to the heap.
+ */
+
+struct kmm_pool_s
+{
+  FAR struct kmm_pool_s *mp_flink; /* Supports a list of all pools */
+  FAR const char *mp_name;         /* Name for procfs */
+  sq_queue_t mp_freelist;          /* List of free blocks */
+  size_t mp_blocksize;             /* Size of each block */
+  uint16_t mp_nexpand;             /* Blocks added from the heap when empty */
+  uint32_t mp_ntotal;              /* Total number of blocks in the pool */
+  uint32_t mp_nused;               /* Number of blocks in use */
+  uint32_t mp_hwm;                 /* High water mark of mp_nused */
+  uint32_t mp_nalloc;              /* Total number of allocations */
+  uint32_t mp_nfail;               /* Number of failed allocations */
+#ifdef CONFIG_SMP
+  spinlock_t mp_lock;              /* Protects the free list and counts */
+#endif
+};
+
+/* Form in which the state of a pool is returned */
+
+struct kmm_poolinfo_s
+{
+  FAR const char *name;            /* Name of the pool */
+  size_t   blocksize;              /* Size of each block */
+  uint32_t ntotal;                 /* Total number of blocks */
+  uint32_t nused;                  /* Number of blocks in use */
+  uint32_t hwm;                    /* Maximum number of blocks ever in use */
+  uint32_t nalloc;                 /* Total number of allocations */
+  uint32_t nfail;                  /* Number of failed allocations */
+};
+
+/* Callback used by kmm_pool_foreach() */
+
+typedef CODE void (*kmm_pool_handler_t)(FAR struct kmm_pool_s *pool,
+                                        FAR void *arg);
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: kmm_pool_initialize
+ *
+ * Description:
+ *   Initialize a pool of fixed-size blocks and add it to the list of all
+ *   pools.
+ *
+ * Input Parameters:
+ *   pool      - The pool structure to be initialized
+ *   name      - The name of the pool as shown in /proc/poolinfo.  The string
+ *               must persist for the lifetime of the pool.
+ *   blocksize - The size of each block.  This will be rounded up so that
+ *               each block is aligned like a pointer.
+ *   mem       - Memory for the initial blocks.  May be NULL if nblocks is
+ *               zero.
+ *   nblocks   - The number of blocks of size blocksize in mem.  Because of
+ *               the rounding of blocksize, mem must be large enough to hold
+ *               nblocks of the rounded size.  Use KMM_POOL_SIZE() to get
+ *               the required size.
+ *   nexpand   - The number of blocks to allocate from the kernel heap when
+ *               the pool is empty.  Zero means that the pool never grows.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void kmm_pool_initialize(FAR struct kmm_pool_s *pool, FAR const char *name,
+                         size_t blocksize, FAR void *mem, uint16_t nblocks,
+                         uint16_t nexpand);
+
+/****************************************************************************
+ * Name: kmm_pool_alloc
+ *
+ * Description:
+ *   Allocate one block from the pool.  This may be called from interrupt
+ *   handlers but the pool will not grow when called from an interrupt
+ *   handler.
+ *
+ * Input Parameters:
+ *   pool - The pool to allocate from
+ *
+ * Returned Value:
+ *   The allocated block or NULL if the pool is exhausted.  The content of
+ *   the block is undefined.
+ *
+ ****************************************************************************/
+
+FAR void *kmm_pool_alloc(FAR struct kmm_pool_s *pool);
+
+/****************************************************************************
+ * Name: kmm_pool_free
+ *
+ * Description:
+ *   Return a block to the pool from which it was allocated.  This may be
+ *   called from interrupt handlers.
+ *
+ * Input Parameters:
+ *   pool - The pool that the block was allocated from
+ *   blk  - The block to be freed
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void kmm_pool_free(FAR struct kmm_pool_s *pool, FAR void *blk);
+
+/****************************************************************************
+ * Name: kmm_pool_info
+ *
+ * Description:
+ *   Return the current state and statistics of a pool.
+ *
+ ****************************************************************************/
+
+void kmm_pool_info(FAR struct kmm_pool_s *pool,
+                   FAR struct kmm_poolinfo_s *info);
+
+/****************************************************************************
+ * Name: kmm_pool_foreach
+ *
+ * Description:
+ *   Call the handler for each pool that has been initialized.
+ *
+ ****************************************************************************/
+
+void kmm_pool_foreach(kmm_pool_handler_t handler, FAR void *arg);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_MM_POOL_H */
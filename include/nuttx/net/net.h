@@ -190,6 +190,13 @@ struct sock_intf_s
   CODE int        (*si_ioctl)(FAR struct socket *psock, int cmd,
                     FAR void *arg, size_t arglen);
 #endif
+
+  /* Optional.  If NULL, sendmsg() with more than one I/O vector is
+   * emulated with si_send() or si_sendto().
+   */
+
+  CODE ssize_t    (*si_sendmsg)(FAR struct socket *psock,
+                    FAR struct msghdr *msg, int flags);
 };
 
 /* Each socket refers to a connection structure of type FAR void *.  Each
@@ -486,6 +493,55 @@ void net_initlist(FAR struct socketlist *list);
 
 void net_releaselist(FAR struct socketlist *list);
 
+/****************************************************************************
+ * Name: sockfd_allocate
+ *
+ * Description:
+ *   Allocate a socket descriptor
+ *
+ * Input Parameters:
+ *   Lowest socket descriptor index to be used.
+ *
+ * Returned Value:
+ *   On success, a socket descriptor >= minsd is returned.  A negated errno
+ *   value is returned on failure.
+ *
+ ****************************************************************************/
+
+int sockfd_allocate(int minsd);
+
+/****************************************************************************
+ * Name: psock_release
+ *
+ * Description:
+ *   Free a socket.
+ *
+ * Input Parameters:
+ *   psock - A reference to the socket instance to be freed.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void psock_release(FAR struct socket *psock);
+
+/****************************************************************************
+ * Name: sockfd_release
+ *
+ * Description:
+ *   Free the socket by its socket descriptor.
+ *
+ * Input Parameters:
+ *   sockfd - Socket descriptor identifies the socket to be released.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sockfd_release(int sockfd);
+
 /****************************************************************************
  * Name: sockfd_socket
  *
@@ -961,6 +1017,87 @@ ssize_t psock_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
 #define psock_recv(psock,buf,len,flags) \
   psock_recvfrom(psock,buf,len,flags,NULL,0)
 
+/****************************************************************************
+ * Name: psock_sendmsg
+ *
+ * Description:
+ *   psock_sendmsg() sends a message gathered from the I/O vectors of msg.
+ *   This is an internal OS interface.  It is functionally equivalent to
+ *   sendmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   msg   - The message to send
+ *   flags - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On any failure, a
+ *   negated errno value is returned (see comments with sendto() for a list
+ *   of appropriate errno values).
+ *
+ ****************************************************************************/
+
+ssize_t psock_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags);
+
+/****************************************************************************
+ * Name: psock_recvmsg
+ *
+ * Description:
+ *   psock_recvmsg() receives a message and scatters it into the I/O vectors
+ *   of msg.  This is an internal OS interface.  It is functionally
+ *   equivalent to recvmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   msg   - Describes the buffers to receive the message and its source
+ *   flags - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On any
+ *   failure, a negated errno value is returned (see comments with
+ *   recvfrom() for a list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags);
+
+/****************************************************************************
+ * Name: psock_tcp_recviob
+ *
+ * Description:
+ *   Receive data from a TCP socket as an I/O buffer chain.  Read-ahead data
+ *   is handed over without copying.  The caller must free the chain with
+ *   iob_free_chain(iob, IOBUSER_NET_TCP_READAHEAD).
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   iobp  - The location to return the I/O buffer chain
+ *   flags - Receive flags (MSG_DONTWAIT)
+ *
+ * Returned Value:
+ *   The number of bytes in the returned chain on success; zero if the peer
+ *   has performed an orderly shutdown.  Otherwise a negated errno value is
+ *   returned.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_TCP) && defined(CONFIG_NET_TCP_READAHEAD)
+ssize_t psock_tcp_recviob(FAR struct socket *psock, FAR struct iob_s **iobp,
+                          int flags);
+#endif
+
 /****************************************************************************
  * Name: nx_recvfrom
  *
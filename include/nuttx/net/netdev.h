@@ -50,7 +50,10 @@
 #include <nuttx/config.h>
 
 #include <sys/ioctl.h>
+#include <sys/types.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include <semaphore.h>
 
 #ifdef CONFIG_NET_MCASTGROUP
 #  include <queue.h>
@@ -95,6 +98,12 @@
 #  define RADIO_MAX_ADDRLEN CONFIG_PKTRADIO_ADDRLEN
 #endif
 
+/* Transmission capabilities of a network driver (d_txcaps) */
+
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+#  define NETDEV_TXCAP_IOB (1 << 0) /* Can gather payload from d_txiob */
+#endif
+
 /* Helper macros for network device statistics */
 
 #ifdef CONFIG_NETDEV_STATISTICS
@@ -304,6 +313,46 @@ struct net_driver_s
 
   FAR uint8_t *d_buf;
 
+#ifdef CONFIG_NET_TCP_RECV_ZEROCOPY
+  /* d_iob is optional.  If the driver received the packet directly into an
+   * I/O buffer, d_iob refers to that buffer and d_buf points into its
+   * io_data[].  The network may take ownership of the buffer:  In that case
+   * it replaces both d_iob and d_buf with a new I/O buffer that the driver
+   * then owns.  NULL if d_buf is not I/O buffer memory.
+   */
+
+  FAR struct iob_s *d_iob;
+#endif
+
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+  /* Transmission capabilities of the driver (see NETDEV_TXCAP_*) and the
+   * largest TCP payload that the driver can segment (zero if the driver
+   * cannot segment TCP payloads).  These are set by the driver.
+   */
+
+  uint8_t d_txcaps;
+  uint16_t d_tsomax;
+
+  /* If d_txiob is not NULL, then the payload of the outgoing packet was
+   * not copied into d_buf:  d_len includes d_txlen bytes of payload that
+   * follow the headers in d_buf and that begin d_txoffset bytes into the
+   * I/O buffer chain d_txiob.  The network retains ownership of the chain;
+   * it is only valid until the driver's poll callback (or the input
+   * function) returns and the driver must set d_txiob to NULL once the
+   * packet has been transmitted.
+   *
+   * If d_txmss is non-zero, then the payload is larger than the MSS and
+   * the driver must send it as a sequence of TCP segments carrying at most
+   * d_txmss bytes each, adjusting the IP length, identification and
+   * checksum and the TCP sequence number, flags, and checksum of each.
+   */
+
+  FAR struct iob_s *d_txiob;
+  uint16_t d_txoffset;
+  uint16_t d_txlen;
+  uint16_t d_txmss;
+#endif
+
   /* d_appdata points to the location where application data can be read from
    * or written to in the packet buffer.
    */
@@ -343,6 +392,22 @@ struct net_driver_s
 
   uint16_t d_sndlen;
 
+  /* d_rxchksum is set if the TCP or UDP checksum of the received packet in
+   * d_buf is already known to be good, either because devif_rxchksum() has
+   * verified it or because the hardware did.  The input functions then do
+   * not compute it again.  It is cleared when the packet has been processed.
+   */
+
+  bool d_rxchksum;
+
+  /* The device lock serializes the input and poll processing of this
+   * device.  See net_devlock().
+   */
+
+  sem_t d_lock;
+  pid_t d_lockholder;
+  unsigned int d_lockcount;
+
   /* Multicast group support */
 
 #ifdef CONFIG_NET_IGMP
@@ -491,6 +556,55 @@ int sixlowpan_input(FAR struct radio_driver_s *ieee,
                     FAR struct iob_s *framelist, FAR const void *metadata);
 #endif
 
+/****************************************************************************
+ * Name: net_devlock and net_devunlock
+ *
+ * Description:
+ *   Take and release the re-entrant lock of one network device.
+ *
+ *   ipv4_input(), ipv6_input(), devif_poll() and devif_timer() take the
+ *   lock of the device for as long as they use it, so the input and poll
+ *   processing of one device is serialized by its own lock and not only by
+ *   the network lock.
+ *
+ *   A driver may take the device lock itself and hold it while it works on
+ *   d_buf without the network lock; for example, while it receives or
+ *   transmits a packet or verifies checksums with devif_rxchksum().  Such a
+ *   driver must then take the device lock before the network lock in every
+ *   thread that uses the device.  A driver that calls the input and poll
+ *   functions with the network lock already held must never hold its
+ *   device lock without the network lock in another thread.  The network
+ *   lock must not be broken (for example by net_lockedwait()) while a
+ *   device lock is held.
+ *
+ *   Both are no-ops in interrupt context:  Drivers that process packets in
+ *   interrupt handlers are serialized by the interrupts themselves.
+ *
+ ****************************************************************************/
+
+void net_devlock(FAR struct net_driver_s *dev);
+void net_devunlock(FAR struct net_driver_s *dev);
+
+/****************************************************************************
+ * Name: devif_rxchksum
+ *
+ * Description:
+ *   Verify the TCP or UDP checksum of the IPv4 or IPv6 packet that the
+ *   driver has received into d_buf and, if it is good, set d_rxchksum so
+ *   that ipv4_input() or ipv6_input() do not compute it again.
+ *
+ *   This needs only the device lock, so a driver may call it before it
+ *   takes the network lock and so keep the one pass over the payload out
+ *   of the network lock.  Packets that cannot be checked here (fragments,
+ *   IPv6 extension headers, other protocols, and bad checksums) are left
+ *   to the input functions.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IPv4) || defined(CONFIG_NET_IPv6)
+void devif_rxchksum(FAR struct net_driver_s *dev);
+#endif
+
 /****************************************************************************
  * Polling of connections
  *
@@ -594,6 +708,23 @@ void neighbor_out(FAR struct net_driver_s *dev);
 
 int devif_loopback(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * Name: devif_iob_linearize
+ *
+ * Description:
+ *   If the payload of the outgoing packet was left in an I/O buffer chain
+ *   (d_txiob), then copy it into d_buf following the headers so that the
+ *   packet is complete in d_buf.  This may be used by drivers that set
+ *   NETDEV_TXCAP_IOB but cannot gather a particular packet.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+void devif_iob_linearize(FAR struct net_driver_s *dev);
+#else
+#  define devif_iob_linearize(dev)
+#endif
+
 /****************************************************************************
  * Carrier detection
  *
@@ -627,6 +758,31 @@ int netdev_carrier_off(FAR struct net_driver_s *dev);
 ssize_t net_ioctl_arglen(int cmd);
 #endif
 
+/****************************************************************************
+ * Name: chksum
+ *
+ * Description:
+ *   Calculate the raw change some over the memory region described by
+ *   data and len.
+ *
+ *   If CONFIG_NET_ARCH_CHKSUM_PARTIAL is defined, then this function must
+ *   be provided by architecture-specific logic.  The remaining checksum
+ *   functions are built on top of it.
+ *
+ * Input Parameters:
+ *   sum  - Partial calculations carried over from a previous call to
+ *          chksum().  This should be zero on the first time that check
+ *          sum is called.
+ *   data - Beginning of the data to include in the checksum.
+ *   len  - Length of the data to include in the checksum.
+ *
+ * Returned Value:
+ *   The updated checksum value in host byte order.
+ *
+ ****************************************************************************/
+
+uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len);
+
 /****************************************************************************
  * Name: net_chksum
  *
@@ -106,8 +106,17 @@ enum note_type_e
   NOTE_SPINLOCK_UNLOCK = 16,
   NOTE_SPINLOCK_ABORT  = 17
 #endif
+  ,
+  NOTE_DROPPED         = 18
 };
 
+/* Notes are stored and returned in a compact binary form:  Each note
+ * begins with the common header below and all multi-byte values are
+ * little endian byte arrays so that the notes need not be aligned.  The
+ * time stamp is in system timer ticks or, if CONFIG_SCHED_NOTE_HIRES is
+ * selected, in the units of up_critmon_gettime().
+ */
+
 /* This structure provides the common header of each note */
 
 struct note_common_s
@@ -234,6 +243,17 @@ struct note_spinlock_s
   uint8_t nsp_value;            /* Value of spinlock */
 };
 #endif /* CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS */
+
+/* This is the specific form of the NOTE_DROPPED note.  It precedes the
+ * first note that could be buffered after notes were dropped because the
+ * buffer was full.
+ */
+
+struct note_dropped_s
+{
+  struct note_common_s ndr_cmn; /* Common note parameters */
+  uint8_t ndr_count[2];         /* Number of notes dropped (saturates) */
+};
 #endif /* CONFIG_SCHED_INSTRUMENTATION_BUFFER */
 
 /****************************************************************************
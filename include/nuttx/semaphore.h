@@ -249,6 +249,42 @@ int nxsem_wait(FAR sem_t *sem);
 
 int nxsem_trywait(FAR sem_t *sem);
 
+/****************************************************************************
+ * Name: nxsem_trytake
+ *
+ * Description:
+ *   Take a count from the semaphore if one is available.  Unlike
+ *   nxsem_trywait(), this may be called from interrupt handlers and with
+ *   other spinlocks held.  No holder is recorded.
+ *
+ * Input Parameters:
+ *   sem - the semaphore descriptor
+ *
+ * Returned Value:
+ *   Zero (OK) if a count was taken; -EAGAIN if the count was not positive.
+ *
+ ****************************************************************************/
+
+int nxsem_trytake(FAR sem_t *sem);
+
+/****************************************************************************
+ * Name: nxsem_decrement
+ *
+ * Description:
+ *   Take a count from the semaphore even if none is available, leaving the
+ *   count negative without any task waiting.  This may be called from
+ *   interrupt handlers and with other spinlocks held.
+ *
+ * Input Parameters:
+ *   sem - the semaphore descriptor
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxsem_decrement(FAR sem_t *sem);
+
 /****************************************************************************
  * Name: nxsem_timedwait
  *
@@ -353,6 +389,25 @@ int nxsem_tickwait(FAR sem_t *sem, clock_t start, uint32_t delay);
 
 int nxsem_post(FAR sem_t *sem);
 
+/****************************************************************************
+ * Name: nxsem_trygive
+ *
+ * Description:
+ *   Give a count back to the semaphore if no task is waiting for it.  This
+ *   may be called from interrupt handlers and with other spinlocks held.
+ *   No holder is released.
+ *
+ * Input Parameters:
+ *   sem - Semaphore descriptor
+ *
+ * Returned Value:
+ *   Zero (OK) if the count was given back; -EAGAIN if a task may be waiting
+ *   and nxsem_post() must be used instead.
+ *
+ ****************************************************************************/
+
+int nxsem_trygive(FAR sem_t *sem);
+
 /****************************************************************************
  * Name:  nxsem_getvalue
  *
@@ -70,6 +70,24 @@
 #  error CONFIG_WDOG_INTRESERVE >= CONFIG_PREALLOC_WDOGS
 #endif
 
+#ifdef CONFIG_WDOG_TIMERWHEEL
+#  ifndef CONFIG_WDOG_TIMERWHEEL_BITS
+#    define CONFIG_WDOG_TIMERWHEEL_BITS 6
+#  endif
+
+#  ifndef CONFIG_WDOG_TIMERWHEEL_LEVELS
+#    define CONFIG_WDOG_TIMERWHEEL_LEVELS 4
+#  endif
+
+#  if CONFIG_WDOG_TIMERWHEEL_LEVELS < 2
+#    error CONFIG_WDOG_TIMERWHEEL_LEVELS < 2
+#  endif
+
+#  if CONFIG_WDOG_TIMERWHEEL_BITS * CONFIG_WDOG_TIMERWHEEL_LEVELS > 31
+#    error CONFIG_WDOG_TIMERWHEEL_BITS * CONFIG_WDOG_TIMERWHEEL_LEVELS > 31
+#  endif
+#endif
+
 /* Watchdog Definitions *****************************************************/
 
 /* Flag bits for the flags field of struct wdog_s */
@@ -95,7 +113,11 @@
 #define wd_static(w) \
   do { (w)->next = NULL; (w)->flags = WDOGF_STATIC; } while (0)
 
-#ifdef CONFIG_PIC
+#if defined(CONFIG_WDOG_TIMERWHEEL) && defined(CONFIG_PIC)
+#  define WDOG_INITIAILIZER { NULL, NULL, NULL, NULL, 0, WDOGF_STATIC, 0 }
+#elif defined(CONFIG_WDOG_TIMERWHEEL)
+#  define WDOG_INITIAILIZER { NULL, NULL, NULL, 0, WDOGF_STATIC, 0 }
+#elif defined(CONFIG_PIC)
 #  define WDOG_INITIAILIZER { NULL, NULL, NULL, 0, WDOGF_STATIC, 0 }
 #else
 #  define WDOG_INITIAILIZER { NULL, NULL, 0, WDOGF_STATIC, 0 }
@@ -139,13 +161,24 @@ typedef CODE void (*wdentry_t)(int argc, wdparm_t arg1, ...);
 struct wdog_s
 {
   FAR struct wdog_s *next;       /* Support for singly linked lists. */
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  FAR struct wdog_s *prev;       /* Support for doubly linked wheel slots */
+#endif
   wdentry_t          func;       /* Function to execute when delay expires */
 #ifdef CONFIG_PIC
   FAR void          *picbase;    /* PIC base address */
 #endif
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  uint32_t           expire;     /* Wheel tick at which the delay expires */
+#else
   int                lag;        /* Timer associated with the delay */
+#endif
   uint8_t            flags;      /* See WDOGF_* definitions above */
   uint8_t            argc;       /* The number of parameters to pass */
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  uint8_t            level;      /* Timing wheel level holding the watchdog */
+  uint8_t            slot;       /* Slot within that timing wheel level */
+#endif
   wdparm_t           parm[CONFIG_MAX_WDOGPARMS];
 };
 
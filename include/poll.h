@@ -110,6 +110,15 @@ typedef unsigned int nfds_t;
 
 typedef uint8_t pollevent_t;
 
+/* The type of the optional notification callback in struct pollfd.  When
+ * a driver reports an event through poll_notify(), the callback, if
+ * non-NULL, is called instead of posting the semaphore.  It may be called
+ * from interrupt handlers.
+ */
+
+struct pollfd;
+typedef CODE void (*pollcb_t)(FAR struct pollfd *fds);
+
 /* This is the Nuttx variant of the standard pollfd structure.  The poll()
  * interfaces receive a variable length array of such structures.
  *
@@ -132,6 +141,8 @@ struct pollfd
   FAR void    *ptr;     /* The psock or file being polled */
   FAR sem_t   *sem;     /* Pointer to semaphore used to post output event */
   FAR void    *priv;    /* For use by drivers */
+  pollcb_t     cb;      /* Notification callback (NULL: post sem) */
+  FAR void    *arg;     /* Argument for use by the callback */
 };
 
 /****************************************************************************
@@ -95,6 +95,12 @@ struct mallinfo
                  * chunks handed out by malloc. */
   int fordblks; /* This is the total size of memory occupied
                  * by free (not in use) chunks.*/
+#ifdef CONFIG_MM_CACHE
+  int cachedblks;  /* The part of uordblks that is held in the per-CPU
+                    * small chunk caches */
+  int cachehits;   /* Number of small allocations taken from the caches */
+  int cachemisses; /* Number of small allocations taken from the heap */
+#endif
 };
 
 /* Structure type returned by the div() function. */
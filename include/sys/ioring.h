@@ -0,0 +1,302 @@
+/****************************************************************************
+ * include/sys/ioring.h
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_SYS_IORING_H
+#define __INCLUDE_SYS_IORING_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/spinlock.h>
+
+#ifdef CONFIG_FS_IORING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Submission queue entry opcodes */
+
+#define IORING_OP_NOP           0  /* No operation; completes with zero */
+#define IORING_OP_READ          1  /* read() or pread() */
+#define IORING_OP_WRITE         2  /* write() or pwrite() */
+#define IORING_OP_FSYNC         3  /* fsync() */
+#define IORING_OP_POLL          4  /* Wait for poll events */
+#define IORING_OP_ACCEPT        5  /* accept() when a connection is pending */
+#define IORING_OP_RECV          6  /* recv() when data is available */
+#define IORING_OP_SEND          7  /* send() when buffer space is available */
+
+/* ioring_enter() flags */
+
+#define IORING_ENTER_GETEVENTS  (1 << 0) /* Wait for min_complete CQEs */
+
+/* Memory barrier between the access to a ring entry and the access to the
+ * index that passes the entry between the application and the OS.  This is
+ * only needed on SMP targets.
+ */
+
+#ifdef SP_DMB
+#  define IORING_DMB()          SP_DMB()
+#else
+#  define IORING_DMB()
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Submission queue entry.  The meaning of the fields depends on the opcode:
+ *
+ *   READ/WRITE - addr/len describe the buffer.  off is the file offset or
+ *                -1 to use (and update) the current file position.
+ *                Files other than regular files and sockets must be
+ *                opened with O_NONBLOCK, or the request fails with
+ *                -EOPNOTSUPP.
+ *   POLL       - op_flags holds the poll events to wait for.  The CQE
+ *                result is the returned poll events.
+ *   ACCEPT     - addr/len describe an optional buffer that receives the
+ *                address of the peer.  The CQE result is the new socket
+ *                descriptor.
+ *   RECV/SEND  - addr/len describe the buffer.  op_flags holds MSG_* flags.
+ */
+
+struct ioring_sqe_s
+{
+  uint8_t   opcode;             /* IORING_OP_* */
+  uint8_t   flags;              /* Reserved; must be zero */
+  uint16_t  reserved;           /* Reserved; must be zero */
+  int       fd;                 /* File or socket descriptor */
+  off_t     off;                /* File offset */
+  FAR void *addr;               /* Buffer address */
+  size_t    len;                /* Buffer length */
+  uint32_t  op_flags;           /* Opcode-specific flags */
+  uintptr_t user_data;          /* Returned unmodified in the CQE */
+};
+
+/* Completion queue entry */
+
+struct ioring_cqe_s
+{
+  uintptr_t user_data;          /* user_data of the completed SQE */
+  ssize_t   res;                /* Result or negated errno value */
+};
+
+/* The rings shared between the application and the OS.  The application
+ * fills SQEs at sq_tail and the OS consumes them at sq_head; the OS posts
+ * CQEs at cq_tail and the application reaps them at cq_head.  The indices
+ * run freely and are masked to find an entry.
+ */
+
+struct ioring_rings_s
+{
+  volatile uint32_t sq_head;    /* Next SQE to be consumed (OS) */
+  volatile uint32_t sq_tail;    /* Next SQE to be submitted (application) */
+  volatile uint32_t cq_head;    /* Next CQE to be reaped (application) */
+  volatile uint32_t cq_tail;    /* Next CQE to be posted (OS) */
+  uint32_t sq_mask;             /* Number of SQEs - 1 */
+  uint32_t cq_mask;             /* Number of CQEs - 1 */
+  FAR struct ioring_sqe_s *sqes;
+  FAR struct ioring_cqe_s *cqes;
+};
+
+/* The application's handle for a ring, initialized by ioring_setup() */
+
+struct ioring_s
+{
+  int fd;                       /* Ring file descriptor */
+  uint32_t sqe_tail;            /* Next SQE handed out, not yet submitted */
+  FAR struct ioring_rings_s *rings;
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: ioring_setup
+ *
+ * Description:
+ *   Create a ring with at least 'entries' submission queue entries and
+ *   twice as many completion queue entries.  The rings are allocated in
+ *   memory accessible to the caller and described by 'ring'.  The ring is
+ *   destroyed when its file descriptor is closed.
+ *
+ * Returned Value:
+ *   The ring file descriptor on success; -1 (ERROR) on failure with errno
+ *   set appropriately.
+ *
+ ****************************************************************************/
+
+int ioring_setup(unsigned int entries, FAR struct ioring_s *ring);
+
+/****************************************************************************
+ * Name: ioring_enter
+ *
+ * Description:
+ *   Submit up to 'to_submit' SQEs from the submission ring and, if
+ *   IORING_ENTER_GETEVENTS is set in 'flags', wait until at least
+ *   'min_complete' CQEs are available in the completion ring.
+ *
+ * Returned Value:
+ *   The number of SQEs consumed on success; -1 (ERROR) on failure with
+ *   errno set appropriately.  Errors in individual requests are reported
+ *   in their CQEs.
+ *
+ ****************************************************************************/
+
+int ioring_enter(int fd, unsigned int to_submit, unsigned int min_complete,
+                 unsigned int flags);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ioring_get_sqe
+ *
+ * Description:
+ *   Return a cleared SQE for the caller to fill in, or NULL if the
+ *   submission ring is full.  The SQE is passed to the OS by
+ *   ioring_submit().
+ *
+ ****************************************************************************/
+
+static inline FAR struct ioring_sqe_s *
+ioring_get_sqe(FAR struct ioring_s *ring)
+{
+  FAR struct ioring_rings_s *rings = ring->rings;
+  FAR struct ioring_sqe_s *sqe;
+
+  if (ring->sqe_tail - rings->sq_head > rings->sq_mask)
+    {
+      return NULL;
+    }
+
+  /* The OS has finished with the entry once sq_head has moved past it */
+
+  IORING_DMB();
+  sqe = &rings->sqes[ring->sqe_tail & rings->sq_mask];
+  memset(sqe, 0, sizeof(struct ioring_sqe_s));
+  ring->sqe_tail++;
+  return sqe;
+}
+
+/****************************************************************************
+ * Name: ioring_submit
+ *
+ * Description:
+ *   Submit all SQEs obtained with ioring_get_sqe() and optionally wait for
+ *   'wait_nr' completions.
+ *
+ ****************************************************************************/
+
+static inline int ioring_submit(FAR struct ioring_s *ring,
+                                unsigned int wait_nr)
+{
+  FAR struct ioring_rings_s *rings = ring->rings;
+
+  /* The SQEs must be visible before the new tail */
+
+  IORING_DMB();
+  rings->sq_tail = ring->sqe_tail;
+  return ioring_enter(ring->fd, ring->sqe_tail - rings->sq_head, wait_nr,
+                      wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0);
+}
+
+/****************************************************************************
+ * Name: ioring_peek_cqe
+ *
+ * Description:
+ *   Return the oldest unreaped CQE, or NULL if there is none.  No system
+ *   call is made.
+ *
+ ****************************************************************************/
+
+static inline FAR struct ioring_cqe_s *
+ioring_peek_cqe(FAR struct ioring_s *ring)
+{
+  FAR struct ioring_rings_s *rings = ring->rings;
+  uint32_t head = rings->cq_head;
+
+  if (head == rings->cq_tail)
+    {
+      return NULL;
+    }
+
+  /* Read the CQE only after the tail that published it */
+
+  IORING_DMB();
+  return &rings->cqes[head & rings->cq_mask];
+}
+
+/****************************************************************************
+ * Name: ioring_cqe_seen
+ *
+ * Description:
+ *   Release the CQE returned by ioring_peek_cqe().
+ *
+ ****************************************************************************/
+
+static inline void ioring_cqe_seen(FAR struct ioring_s *ring)
+{
+  /* Finish reading the CQE before the OS may reuse it */
+
+  IORING_DMB();
+  ring->rings->cq_head++;
+}
+
+#endif /* CONFIG_FS_IORING */
+#endif /* __INCLUDE_SYS_IORING_H */
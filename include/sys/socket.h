@@ -126,6 +126,7 @@
 #define MSG_ERRQUEUE   0x2000 /* Fetch message from error queue.  */
 #define MSG_NOSIGNAL   0x4000 /* Do not generate SIGPIPE.  */
 #define MSG_MORE       0x8000 /* Sender will send more.  */
+#define MSG_WAITFORONE 0x10000 /* Wait for the first message only */
 
 /* Protocol levels supported by get/setsockopt(): */
 
@@ -314,6 +315,16 @@ struct cmsghdr
   int cmsg_type;                /* Protocol-specific type */
 };
 
+/* Used with sendmmsg()/recvmmsg() */
+
+struct mmsghdr
+{
+  struct msghdr msg_hdr;        /* The message */
+  unsigned int msg_len;         /* Number of bytes transferred */
+};
+
+struct timespec;                /* Forward reference (see time.h) */
+
 /****************************************************************************
  * Inline Functions
  ****************************************************************************/
@@ -382,6 +393,11 @@ int getpeername(int sockfd, FAR struct sockaddr *addr,
 ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags);
 ssize_t sendmsg(int sockfd, FAR struct msghdr *msg, int flags);
 
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout);
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
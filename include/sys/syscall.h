@@ -304,9 +304,17 @@
 #  define SYS_aio_write              (__SYS_descriptors + 7)
 #  define SYS_aio_fsync              (__SYS_descriptors + 8)
 #  define SYS_aio_cancel             (__SYS_descriptors + 9)
-#  define __SYS_poll                 (__SYS_descriptors + 10)
+#  define __SYS_ioring               (__SYS_descriptors + 10)
 #else
-#  define __SYS_poll                 (__SYS_descriptors + 6)
+#  define __SYS_ioring               (__SYS_descriptors + 6)
+#endif
+
+#ifdef CONFIG_FS_IORING
+#  define SYS_ioring_setup           __SYS_ioring
+#  define SYS_ioring_enter           (__SYS_ioring + 1)
+#  define __SYS_poll                 (__SYS_ioring + 2)
+#else
+#  define __SYS_poll                 __SYS_ioring
 #endif
 
 #define SYS_poll                     __SYS_poll
@@ -545,10 +553,14 @@
 #  define SYS_listen                   (__SYS_network + 6)
 #  define SYS_recv                     (__SYS_network + 7)
 #  define SYS_recvfrom                 (__SYS_network + 8)
-#  define SYS_send                     (__SYS_network + 9)
-#  define SYS_sendto                   (__SYS_network + 10)
-#  define SYS_setsockopt               (__SYS_network + 11)
-#  define SYS_socket                   (__SYS_network + 12)
+#  define SYS_recvmmsg                 (__SYS_network + 9)
+#  define SYS_recvmsg                  (__SYS_network + 10)
+#  define SYS_send                     (__SYS_network + 11)
+#  define SYS_sendmmsg                 (__SYS_network + 12)
+#  define SYS_sendmsg                  (__SYS_network + 13)
+#  define SYS_sendto                   (__SYS_network + 14)
+#  define SYS_setsockopt               (__SYS_network + 15)
+#  define SYS_socket                   (__SYS_network + 16)
 #else
 #  define SYS_socket                    __SYS_network
 #endif
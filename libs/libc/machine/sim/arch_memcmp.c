@@ -0,0 +1,92 @@
+/****************************************************************************
+ * libs/libc/machine/sim/arch_memcmp.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "arch_simd.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: memcmp
+ *
+ * Description:
+ *   Compare VECSIZE bytes at a time.  The byte-equality mask of each pair
+ *   of vectors locates the first difference directly.
+ *
+ ****************************************************************************/
+
+SIMD_TARGET
+int memcmp(FAR const void *s1, FAR const void *s2, size_t n)
+{
+  FAR const unsigned char *p1 = (FAR const unsigned char *)s1;
+  FAR const unsigned char *p2 = (FAR const unsigned char *)s2;
+  uint32_t mask;
+  size_t i;
+
+  while (n >= VECSIZE)
+    {
+      mask = VEC_MOVEMASK((vec_t)(VEC_LOAD(p1) == VEC_LOAD(p2)));
+      if (mask != VECMASK_ALL)
+        {
+          i = __builtin_ctz(~mask);
+          return p1[i] < p2[i] ? -1 : 1;
+        }
+
+      p1 += VECSIZE;
+      p2 += VECSIZE;
+      n  -= VECSIZE;
+    }
+
+  for (; n > 0; n--, p1++, p2++)
+    {
+      if (*p1 != *p2)
+        {
+          return *p1 < *p2 ? -1 : 1;
+        }
+    }
+
+  return 0;
+}
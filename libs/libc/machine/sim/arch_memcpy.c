@@ -0,0 +1,110 @@
+/****************************************************************************
+ * libs/libc/machine/sim/arch_memcpy.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <string.h>
+
+#include "arch_simd.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: memcpy
+ *
+ * Description:
+ *   Copy VECSIZE bytes at a time with unaligned vector loads and stores.
+ *   The final partial vector is handled by copying the last VECSIZE bytes
+ *   again, overlapping the previous store.
+ *
+ ****************************************************************************/
+
+SIMD_TARGET
+FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
+{
+  FAR unsigned char *pout = (FAR unsigned char *)dest;
+  FAR const unsigned char *pin = (FAR const unsigned char *)src;
+  vec_t v0;
+  vec_t v1;
+  vec_t v2;
+  vec_t v3;
+
+  if (n < VECSIZE)
+    {
+      while (n-- > 0)
+        {
+          *pout++ = *pin++;
+        }
+
+      return dest;
+    }
+
+  v0 = VEC_LOAD(&pin[n - VECSIZE]);
+
+  while (n >= 4 * VECSIZE)
+    {
+      v1 = VEC_LOAD(pin);
+      v2 = VEC_LOAD(pin + VECSIZE);
+      v3 = VEC_LOAD(pin + 2 * VECSIZE);
+      VEC_STORE(pout, v1);
+      VEC_STORE(pout + VECSIZE, v2);
+      VEC_STORE(pout + 2 * VECSIZE, v3);
+      v1 = VEC_LOAD(pin + 3 * VECSIZE);
+      VEC_STORE(pout + 3 * VECSIZE, v1);
+      pin  += 4 * VECSIZE;
+      pout += 4 * VECSIZE;
+      n    -= 4 * VECSIZE;
+    }
+
+  while (n > VECSIZE)
+    {
+      VEC_STORE(pout, VEC_LOAD(pin));
+      pin  += VECSIZE;
+      pout += VECSIZE;
+      n    -= VECSIZE;
+    }
+
+  /* The last (possibly overlapping) vector was loaded before the loop */
+
+  VEC_STORE(pout + n - VECSIZE, v0);
+  return dest;
+}
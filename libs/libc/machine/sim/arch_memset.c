@@ -1,7 +1,7 @@
 /****************************************************************************
- * libc/net/lib_recvmsg.c
+ * libs/libc/machine/sim/arch_memset.c
  *
- *   Copyright (C) 2007, 2008, 2012, 2008 Gregory Nutt. All rights reserved.
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
  *   Author: Gregory Nutt <gnutt@nuttx.org>
  *
  * Redistribution and use in source and binary forms, with or without
@@ -39,51 +39,62 @@
 
 #include <nuttx/config.h>
 
-#ifdef CONFIG_NET
-
 #include <sys/types.h>
-#include <sys/socket.h>
-#include <errno.h>
+#include <string.h>
+
+#include "arch_simd.h"
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Function: recvmsg
+ * Name: memset
  *
  * Description:
- *   The recvmsg() call is identical to recvfrom() with a NULL from parameter.
- *
- * Parameters:
- *   sockfd   Socket descriptor of socket
- *   buf      Buffer to receive data
- *   len      Length of buffer
- *   flags    Receive flags
- *
- * Returned Value:
- *  (see recvfrom)
- *
- * Assumptions:
+ *   Store VECSIZE bytes at a time with unaligned vector stores.  The final
+ *   partial vector overlaps the previous store.
  *
  ****************************************************************************/
 
-ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags)
+SIMD_TARGET
+FAR void *memset(FAR void *s, int c, size_t n)
 {
-  FAR void *buf             = msg->msg_iov->iov_base;
-  FAR struct sockaddr *from = msg->msg_name;
-  FAR socklen_t *fromlen    = (FAR socklen_t *)&msg->msg_namelen;
-  size_t len                = msg->msg_iov->iov_len;
+  FAR unsigned char *p = (FAR unsigned char *)s;
+  vec_t v;
 
-  if (msg->msg_iovlen == 1)
+  if (n < VECSIZE)
     {
-      return recvfrom(sockfd, buf, len, flags, from, fromlen);
+      while (n-- > 0)
+        {
+          *p++ = (unsigned char)c;
+        }
+
+      return s;
     }
-  else
+
+  /* Replicate the byte into every lane */
+
+  v = VEC_SPLAT(c);
+
+  VEC_STORE(p + n - VECSIZE, v);
+
+  while (n >= 4 * VECSIZE)
     {
-      set_errno(ENOTSUP);
-      return ERROR;
+      VEC_STORE(p, v);
+      VEC_STORE(p + VECSIZE, v);
+      VEC_STORE(p + 2 * VECSIZE, v);
+      VEC_STORE(p + 3 * VECSIZE, v);
+      p += 4 * VECSIZE;
+      n -= 4 * VECSIZE;
     }
-}
 
-#endif /* CONFIG_NET */
+  while (n > VECSIZE)
+    {
+      VEC_STORE(p, v);
+      p += VECSIZE;
+      n -= VECSIZE;
+    }
+
+  return s;
+}
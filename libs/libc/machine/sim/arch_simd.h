@@ -0,0 +1,90 @@
+/****************************************************************************
+ * libs/libc/machine/sim/arch_simd.h
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBC_MACHINE_SIM_ARCH_SIMD_H
+#define __LIBS_LIBC_MACHINE_SIM_ARCH_SIMD_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The simulator string functions use the SSE2 or AVX2 vector instructions
+ * of the x86 host through GCC vector extensions.  No host headers are
+ * needed.  The instruction set is selected at build time; each function is
+ * compiled for that instruction set with the SIMD_TARGET attribute.
+ */
+
+#ifdef CONFIG_SIM_STRING_AVX2
+#  define VECSIZE          32
+#  define VECMASK_ALL      0xffffffffu
+#  define SIMD_TARGET      __attribute__((target("avx2")))
+#  define VEC_MOVEMASK(v)  ((uint32_t)__builtin_ia32_pmovmskb256((v)))
+#else
+#  define VECSIZE          16
+#  define VECMASK_ALL      0xffffu
+#  define SIMD_TARGET      __attribute__((target("sse2")))
+#  define VEC_MOVEMASK(v)  ((uint32_t)__builtin_ia32_pmovmskb128((v)))
+#endif
+
+/* Load or store a vector at any alignment */
+
+#define VEC_LOAD(p)        (*(FAR const vec_u_t *)(p))
+#define VEC_STORE(p, v)    (*(FAR vec_u_t *)(p) = (v))
+
+/* Load a vector from an address aligned to VECSIZE */
+
+#define VEC_LOADA(p)       (*(FAR const vec_t *)(p))
+
+/* A vector with the byte c in every lane */
+
+#define VEC_SPLAT(c)       ((vec_t){ 0 } + (char)(c))
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+typedef char vec_t __attribute__((vector_size(VECSIZE), may_alias));
+typedef char vec_u_t __attribute__((vector_size(VECSIZE), may_alias,
+                                    aligned(1)));
+
+#endif /* __LIBS_LIBC_MACHINE_SIM_ARCH_SIMD_H */
@@ -1,7 +1,7 @@
 /****************************************************************************
- * libc/net/lib_sendmsg.c
+ * libs/libc/machine/sim/arch_strlen.c
  *
- *   Copyright (C) 2007, 2008, 2012, 2018 Gregory Nutt. All rights reserved.
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
  *   Author: Gregory Nutt <gnutt@nuttx.org>
  *
  * Redistribution and use in source and binary forms, with or without
@@ -39,51 +39,48 @@
 
 #include <nuttx/config.h>
 
-#ifdef CONFIG_NET
-
 #include <sys/types.h>
-#include <sys/socket.h>
-#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "arch_simd.h"
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Function: sendmsg
+ * Name: strlen
  *
  * Description:
- *   The sendmsg() call is identical to sendto() with a NULL from parameter.
- *
- * Parameters:
- *   sockfd   Socket descriptor of socket
- *   buf      Buffer to send data
- *   len      Length of buffer
- *   flags    Receive flags
- *
- * Returned Value:
- *  (see sendto)
- *
- * Assumptions:
+ *   Scan VECSIZE bytes at a time.  Only aligned vectors are loaded so that
+ *   no load crosses a page boundary beyond the terminator; the bytes
+ *   before the start of the string in the first vector are masked off.
  *
  ****************************************************************************/
 
-ssize_t sendmsg(int sockfd, FAR struct msghdr *msg, int flags)
+SIMD_TARGET
+size_t strlen(FAR const char *s)
 {
-  FAR void *buf           = msg->msg_iov->iov_base;
-  FAR struct sockaddr *to = msg->msg_name;
-  socklen_t tolen         = msg->msg_namelen;
-  size_t len              = msg->msg_iov->iov_len;
+  FAR const char *p;
+  vec_t zero = VEC_SPLAT(0);
+  uint32_t mask;
 
-  if (msg->msg_iovlen == 1)
+  p    = (FAR const char *)((uintptr_t)s & ~(uintptr_t)(VECSIZE - 1));
+  mask = VEC_MOVEMASK((vec_t)(VEC_LOADA(p) == zero));
+  mask >>= (uintptr_t)s & (VECSIZE - 1);
+
+  if (mask != 0)
     {
-      return sendto(sockfd, buf, len, flags, to, tolen);
+      return __builtin_ctz(mask);
     }
-  else
+
+  do
     {
-      set_errno(ENOTSUP);
-      return ERROR;
+      p   += VECSIZE;
+      mask = VEC_MOVEMASK((vec_t)(VEC_LOADA(p) == zero));
     }
-}
+  while (mask == 0);
 
-#endif /* CONFIG_NET */
+  return (size_t)(p - s) + __builtin_ctz(mask);
+}
@@ -39,8 +39,20 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+/* Equal prefixes are skipped a machine word (uintptr_t) at a time */
+
+#  define WORDSIZE       sizeof(uintptr_t)
+#  define WORDMASK       (WORDSIZE - 1)
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -51,6 +63,46 @@ int memcmp(FAR const void *s1, FAR const void *s2, size_t n)
   unsigned char *p1 = (unsigned char *)s1;
   unsigned char *p2 = (unsigned char *)s2;
 
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  /* Words can only be compared if both buffers have the same alignment */
+
+  if (n >= 2 * WORDSIZE &&
+      (((uintptr_t)p1 ^ (uintptr_t)p2) & WORDMASK) == 0)
+    {
+      FAR const uintptr_t *w1;
+      FAR const uintptr_t *w2;
+
+      while (((uintptr_t)p1 & WORDMASK) != 0)
+        {
+          if (*p1 != *p2)
+            {
+              return *p1 < *p2 ? -1 : 1;
+            }
+
+          p1++;
+          p2++;
+          n--;
+        }
+
+      /* Skip equal words.  The first differing word, if any, is then
+       * compared byte by byte below.
+       */
+
+      w1 = (FAR const uintptr_t *)p1;
+      w2 = (FAR const uintptr_t *)p2;
+
+      while (n >= WORDSIZE && *w1 == *w2)
+        {
+          w1++;
+          w2++;
+          n -= WORDSIZE;
+        }
+
+      p1 = (unsigned char *)w1;
+      p2 = (unsigned char *)w2;
+    }
+#endif
+
   while (n-- > 0)
     {
       if (*p1 < *p2)
@@ -39,8 +39,22 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+/* Copies are done a machine word (uintptr_t) at a time */
+
+#  define WORDSIZE       sizeof(uintptr_t)
+#  define WORDMASK       (WORDSIZE - 1)
+#  define WORDBITS       (8 * WORDSIZE)
+#  define UNALIGNED(p)   (((uintptr_t)(p) & WORDMASK) != 0)
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -54,6 +68,85 @@ FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
 {
   FAR unsigned char *pout = (FAR unsigned char *)dest;
   FAR unsigned char *pin  = (FAR unsigned char *)src;
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  /* Short copies are not worth the setup */
+
+  if (n >= 2 * WORDSIZE)
+    {
+      FAR uintptr_t *wout;
+      FAR const uintptr_t *win;
+
+      /* Copy bytes until the destination is aligned */
+
+      while (UNALIGNED(pout))
+        {
+          *pout++ = *pin++;
+          n--;
+        }
+
+      wout = (FAR uintptr_t *)pout;
+
+      if (!UNALIGNED(pin))
+        {
+          /* Both are aligned.  Copy four words at a time, then single
+           * words.
+           */
+
+          win = (FAR const uintptr_t *)pin;
+
+          while (n >= 4 * WORDSIZE)
+            {
+              wout[0] = win[0];
+              wout[1] = win[1];
+              wout[2] = win[2];
+              wout[3] = win[3];
+              wout   += 4;
+              win    += 4;
+              n      -= 4 * WORDSIZE;
+            }
+
+          while (n >= WORDSIZE)
+            {
+              *wout++ = *win++;
+              n      -= WORDSIZE;
+            }
+
+          pin = (FAR unsigned char *)win;
+        }
+      else
+        {
+          unsigned int shift = ((uintptr_t)pin & WORDMASK) * 8;
+          uintptr_t w0;
+          uintptr_t w1;
+
+          /* The source is misaligned.  Read aligned source words and merge
+           * each pair into one destination word.  No word is read that does
+           * not hold at least one byte that is copied.
+           */
+
+          win = (FAR const uintptr_t *)
+                ((uintptr_t)pin & ~(uintptr_t)WORDMASK);
+          w0  = *win++;
+
+          while (n >= WORDSIZE)
+            {
+              w1 = *win++;
+#ifdef CONFIG_ENDIAN_BIG
+              *wout++ = (w0 << shift) | (w1 >> (WORDBITS - shift));
+#else
+              *wout++ = (w0 >> shift) | (w1 << (WORDBITS - shift));
+#endif
+              w0   = w1;
+              pin += WORDSIZE;
+              n   -= WORDSIZE;
+            }
+        }
+
+      pout = (FAR unsigned char *)wout;
+    }
+#endif
+
   while (n-- > 0) *pout++ = *pin++;
   return dest;
 }
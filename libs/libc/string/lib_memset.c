@@ -58,6 +58,13 @@
 #  undef CONFIG_MEMSET_64BIT
 #endif
 
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+/* Stores are done a machine word (uintptr_t) at a time */
+
+#  define WORDSIZE       sizeof(uintptr_t)
+#  define WORDMASK       (WORDSIZE - 1)
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -65,7 +72,52 @@
 #ifndef CONFIG_LIBC_ARCH_MEMSET
 FAR void *memset(FAR void *s, int c, size_t n)
 {
-#ifdef CONFIG_MEMSET_OPTSPEED
+#if defined(CONFIG_LIBC_STRING_OPTSPEED)
+  /* Store bytes until the destination is word-aligned, then four words at
+   * a time, then single words, then the trailing bytes.
+   */
+
+  FAR unsigned char *p = (FAR unsigned char *)s;
+  FAR uintptr_t *wp;
+  uintptr_t val;
+
+  if (n >= 2 * WORDSIZE)
+    {
+      /* Replicate the byte into every byte of a word */
+
+      val = (uintptr_t)(unsigned char)c;
+      val = val * (~(uintptr_t)0 / 0xff);
+
+      while (((uintptr_t)p & WORDMASK) != 0)
+        {
+          *p++ = (unsigned char)c;
+          n--;
+        }
+
+      wp = (FAR uintptr_t *)p;
+
+      while (n >= 4 * WORDSIZE)
+        {
+          wp[0] = val;
+          wp[1] = val;
+          wp[2] = val;
+          wp[3] = val;
+          wp   += 4;
+          n    -= 4 * WORDSIZE;
+        }
+
+      while (n >= WORDSIZE)
+        {
+          *wp++ = val;
+          n    -= WORDSIZE;
+        }
+
+      p = (FAR unsigned char *)wp;
+    }
+
+  while (n-- > 0) *p++ = (unsigned char)c;
+
+#elif defined(CONFIG_MEMSET_OPTSPEED)
   /* This version is optimized for speed (you could do better
    * still by exploiting processor caching or memory burst
    * knowledge.)
@@ -39,8 +39,25 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+/* The string is scanned a machine word (uintptr_t) at a time.  HASZERO()
+ * is non-zero if any byte of the word is zero.
+ */
+
+#  define WORDSIZE       sizeof(uintptr_t)
+#  define WORDMASK       (WORDSIZE - 1)
+#  define ONES           (~(uintptr_t)0 / 0xff)
+#  define HIGHS          (ONES << 7)
+#  define HASZERO(w)     (((w) - ONES) & ~(w) & HIGHS)
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -49,7 +66,30 @@
 size_t strlen(const char *s)
 {
   const char *sc;
-  for (sc = s; *sc != '\0'; ++sc);
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  FAR const uintptr_t *ws;
+
+  /* Check bytes until aligned.  An aligned word never crosses a page (or
+   * MPU region) boundary, so reading a whole word that holds the
+   * terminator is safe.
+   */
+
+  for (sc = s; ((uintptr_t)sc & WORDMASK) != 0; ++sc)
+    {
+      if (*sc == '\0')
+        {
+          return sc - s;
+        }
+    }
+
+  for (ws = (FAR const uintptr_t *)sc; !HASZERO(*ws); ws++);
+  sc = (const char *)ws;
+#else
+  sc = s;
+#endif
+
+  for (; *sc != '\0'; ++sc);
   return sc - s;
 }
 #endif
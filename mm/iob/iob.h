@@ -45,6 +45,7 @@
 #include <semaphore.h>
 #include <debug.h>
 
+#include <nuttx/spinlock.h>
 #include <nuttx/mm/iob.h>
 
 #ifdef CONFIG_MM_IOB
@@ -91,6 +92,12 @@
 
 extern FAR struct iob_s *g_iob_freelist;
 
+#if CONFIG_IOB_NLARGE > 0
+/* A list of all free, unallocated large I/O buffers */
+
+extern FAR struct iob_s *g_iob_lfreelist;
+#endif
+
 /* A list of I/O buffers that are committed for allocation */
 
 extern FAR struct iob_s *g_iob_committed;
@@ -115,10 +122,71 @@ extern sem_t g_throttle_sem;  /* Counts available I/O buffers when throttled */
 extern sem_t g_qentry_sem;    /* Counts free I/O buffer queue containers */
 #endif
 
+#ifdef CONFIG_SMP
+/* This spinlock protects the free and committed lists and the quotas.  It
+ * is taken before the semaphore count lock, never after, and the critical
+ * section is never entered while it is held.
+ */
+
+extern volatile spinlock_t g_iob_lock;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: iob_quota_limited
+ *
+ * Description:
+ *   Return true if the consumer already holds the maximum number of I/O
+ *   buffers that it is permitted.  Must be called with g_iob_lock held.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_QUOTA
+bool iob_quota_limited(enum iob_user_e consumerid);
+#endif
+
+/****************************************************************************
+ * Name: iob_quota_check
+ *
+ * Description:
+ *   Check if the consumer may allocate one more I/O buffer when 'navail'
+ *   I/O buffers are free.  Must be called with g_iob_lock held.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_QUOTA
+bool iob_quota_check(enum iob_user_e consumerid, int navail);
+#endif
+
+/****************************************************************************
+ * Name: iob_quota_charge
+ *
+ * Description:
+ *   Charge a newly allocated I/O buffer to the consumer.  Must be called
+ *   with g_iob_lock held.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_QUOTA
+void iob_quota_charge(FAR struct iob_s *iob, enum iob_user_e consumerid);
+#endif
+
+/****************************************************************************
+ * Name: iob_quota_release
+ *
+ * Description:
+ *   Return an I/O buffer that is being freed to the quota of the consumer
+ *   that allocated it.  Must be called with g_iob_lock held.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_QUOTA
+void iob_quota_release(FAR struct iob_s *iob);
+#endif
+
 /****************************************************************************
  * Name: iob_alloc_qentry
  *
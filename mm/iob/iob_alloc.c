@@ -46,6 +46,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/mm/iob.h>
 
 #include "iob.h"
@@ -54,12 +55,67 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: iob_remove_free
+ *
+ * Description:
+ *   Remove an I/O buffer from the free list of the size preferred for 'size'
+ *   bytes of data or, if that list is empty, from the other free list.  Must
+ *   be called with g_iob_lock held.
+ *
+ ****************************************************************************/
+
+static FAR struct iob_s *iob_remove_free(unsigned int size)
+{
+  FAR struct iob_s *iob;
+#if CONFIG_IOB_NLARGE > 0
+  FAR struct iob_s **first;
+  FAR struct iob_s **second;
+
+  if (size > CONFIG_IOB_BUFSIZE)
+    {
+      first  = &g_iob_lfreelist;
+      second = &g_iob_freelist;
+    }
+  else
+    {
+      first  = &g_iob_freelist;
+      second = &g_iob_lfreelist;
+    }
+
+  iob = *first;
+  if (iob != NULL)
+    {
+      *first = iob->io_flink;
+    }
+  else
+    {
+      iob = *second;
+      if (iob != NULL)
+        {
+          *second = iob->io_flink;
+        }
+    }
+#else
+  UNUSED(size);
+
+  iob = g_iob_freelist;
+  if (iob != NULL)
+    {
+      g_iob_freelist = iob->io_flink;
+    }
+#endif
+
+  return iob;
+}
+
 /****************************************************************************
  * Name: iob_alloc_committed
  *
  * Description:
  *   Allocate an I/O buffer by taking the buffer at the head of the committed
- *   list.
+ *   list.  NULL is returned if the list is empty or if the quotas do not
+ *   permit the consumer to have another buffer.
  *
  ****************************************************************************/
 
@@ -68,11 +124,11 @@ static FAR struct iob_s *iob_alloc_committed(enum iob_user_e consumerid)
   FAR struct iob_s *iob = NULL;
   irqstate_t flags;
 
-  /* We don't know what context we are called from so we use extreme measures
-   * to protect the committed list:  We disable interrupts very briefly.
+  /* We don't know what context we are called from so we disable interrupts
+   * very briefly while holding the lock that protects the committed list.
    */
 
-  flags = enter_critical_section();
+  flags = spin_lock_save(&g_iob_lock);
 
   /* Take the I/O buffer from the head of the committed list */
 
@@ -83,6 +139,42 @@ static FAR struct iob_s *iob_alloc_committed(enum iob_user_e consumerid)
 
       g_iob_committed = iob->io_flink;
 
+#ifdef CONFIG_IOB_QUOTA
+      /* The buffer was committed to this allocation when it was freed, but
+       * the quotas are checked as in iob_tryalloc_size():  Another thread
+       * of the same consumer may have reached its limit in the meantime.
+       * The committed buffer is the only one counted as free unless the
+       * semaphore count shows more.
+       */
+
+      if (!iob_quota_check(consumerid,
+                           g_iob_sem.semcount > 0 ?
+                           g_iob_sem.semcount + 1 : 1))
+        {
+          /* Put the buffer on the free list.  The caller releases its count
+           * so that the buffer can go to another allocation.
+           */
+
+#if CONFIG_IOB_NLARGE > 0
+          if (iob->io_bufsize > CONFIG_IOB_BUFSIZE)
+            {
+              iob->io_flink   = g_iob_lfreelist;
+              g_iob_lfreelist = iob;
+            }
+          else
+#endif
+            {
+              iob->io_flink   = g_iob_freelist;
+              g_iob_freelist  = iob;
+            }
+
+          spin_unlock_restore(&g_iob_lock, flags);
+          return NULL;
+        }
+
+      iob_quota_charge(iob, consumerid);
+#endif
+
       /* Put the I/O buffer in a known state */
 
       iob->io_flink  = NULL; /* Not in a chain */
@@ -96,7 +188,7 @@ static FAR struct iob_s *iob_alloc_committed(enum iob_user_e consumerid)
 #endif
     }
 
-  leave_critical_section(flags);
+  spin_unlock_restore(&g_iob_lock, flags);
   return iob;
 }
 
@@ -109,11 +201,14 @@ static FAR struct iob_s *iob_alloc_committed(enum iob_user_e consumerid)
  *
  ****************************************************************************/
 
-static FAR struct iob_s *iob_allocwait(bool throttled,
+static FAR struct iob_s *iob_allocwait(unsigned int size, bool throttled,
                                        enum iob_user_e consumerid)
 {
   FAR struct iob_s *iob;
+#ifdef CONFIG_IOB_QUOTA
   irqstate_t flags;
+  bool refused;
+#endif
   FAR sem_t *sem;
   int ret = OK;
 
@@ -125,21 +220,35 @@ static FAR struct iob_s *iob_allocwait(bool throttled,
   sem = &g_iob_sem;
 #endif
 
-  /* The following must be atomic; interrupt must be disabled so that there
-   * is no conflict with interrupt level I/O buffer allocations.  This is
-   * not as bad as it sounds because interrupts will be re-enabled while
-   * we are waiting for I/O buffers to become free.
-   */
-
-  flags = enter_critical_section();
-
   /* Try to get an I/O buffer.  If successful, the semaphore count will be
-   * decremented atomically.
+   * decremented atomically.  No lock is held across the wait below:  A
+   * buffer that is freed before we wait leaves its count on the semaphore,
+   * so the wait returns at once and the buffer is found on the free list.
    */
 
-  iob = iob_tryalloc(throttled, consumerid);
+  iob = iob_tryalloc_size(size, throttled, consumerid);
   while (ret == OK && iob == NULL)
     {
+#ifdef CONFIG_IOB_QUOTA
+      /* Don't wait if the allocation was refused by a quota:  Either the
+       * consumer already holds its limit or the I/O buffers that are still
+       * free are reserved for other consumers.  If buffers were freed
+       * since iob_tryalloc() failed, the wait below returns at once and we
+       * try again.
+       */
+
+      flags   = spin_lock_save(&g_iob_lock);
+      refused = iob_quota_limited(consumerid) ||
+                (sem->semcount > 0 &&
+                 !iob_quota_check(consumerid, sem->semcount));
+      spin_unlock_restore(&g_iob_lock, flags);
+
+      if (refused)
+        {
+          break;
+        }
+#endif
+
       /* If not successful, then the semaphore count was less than or equal
        * to zero (meaning that there are no free buffers).  We need to wait
        * for an I/O buffer to be released and placed in the committed
@@ -177,16 +286,17 @@ static FAR struct iob_s *iob_allocwait(bool throttled,
               /* We need release our count so that it is available to
                * iob_tryalloc(), perhaps allowing another thread to take our
                * count.  In that event, iob_tryalloc() will fail above and
-               * we will have to wait again.
+               * we will have to wait again.  If a quota refused the
+               * committed buffer, iob_tryalloc() refuses it too and the
+               * loop ends or waits as above.
                */
 
               nxsem_post(sem);
-              iob = iob_tryalloc(throttled, consumerid);
+              iob = iob_tryalloc_size(size, throttled, consumerid);
             }
 
-          /* REVISIT: I think this logic should be moved inside of
-           * iob_alloc_committed, so that it can exist inside of the critical
-           * section along with all other sem count changes.
+          /* The buffer also takes a count from the other semaphore.  The
+           * throttle count may be overdrawn, so take it unconditionally.
            */
 
 #if CONFIG_IOB_THROTTLE > 0
@@ -194,18 +304,17 @@ static FAR struct iob_s *iob_allocwait(bool throttled,
             {
               if (throttled)
                 {
-                  g_iob_sem.semcount--;
+                  nxsem_decrement(&g_iob_sem);
                 }
               else
                 {
-                  g_throttle_sem.semcount--;
+                  nxsem_decrement(&g_throttle_sem);
                 }
             }
 #endif
         }
     }
 
-  leave_critical_section(flags);
   return iob;
 }
 
@@ -222,6 +331,37 @@ static FAR struct iob_s *iob_allocwait(bool throttled,
  ****************************************************************************/
 
 FAR struct iob_s *iob_alloc(bool throttled, enum iob_user_e consumerid)
+{
+  return iob_alloc_size(0, throttled, consumerid);
+}
+
+/****************************************************************************
+ * Name: iob_tryalloc
+ *
+ * Description:
+ *   Try to allocate an I/O buffer by taking the buffer at the head of the
+ *   free list without waiting for a buffer to become free.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid)
+{
+  return iob_tryalloc_size(0, throttled, consumerid);
+}
+
+/****************************************************************************
+ * Name: iob_alloc_size
+ *
+ * Description:
+ *   Allocate an I/O buffer that is intended to hold 'size' bytes of data.
+ *   A large I/O buffer is preferred if 'size' will not fit into a small
+ *   one.  A buffer of the other size is returned if there are none of the
+ *   preferred size.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_size(unsigned int size, bool throttled,
+                                 enum iob_user_e consumerid)
 {
   /* Were we called from the interrupt level? */
 
@@ -229,30 +369,32 @@ FAR struct iob_s *iob_alloc(bool throttled, enum iob_user_e consumerid)
     {
       /* Yes, then try to allocate an I/O buffer without waiting */
 
-      return iob_tryalloc(throttled, consumerid);
+      return iob_tryalloc_size(size, throttled, consumerid);
     }
   else
     {
       /* Then allocate an I/O buffer, waiting as necessary */
 
-      return iob_allocwait(throttled, consumerid);
+      return iob_allocwait(size, throttled, consumerid);
     }
 }
 
 /****************************************************************************
- * Name: iob_tryalloc
+ * Name: iob_tryalloc_size
  *
  * Description:
- *   Try to allocate an I/O buffer by taking the buffer at the head of the
- *   free list without waiting for a buffer to become free.
+ *   Try to allocate an I/O buffer that is intended to hold 'size' bytes of
+ *   data as with iob_alloc_size(), but without waiting for a buffer to
+ *   become free.
  *
  ****************************************************************************/
 
-FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid)
+FAR struct iob_s *iob_tryalloc_size(unsigned int size, bool throttled,
+                                    enum iob_user_e consumerid)
 {
   FAR struct iob_s *iob;
   irqstate_t flags;
-#if CONFIG_IOB_THROTTLE > 0
+#if CONFIG_IOB_THROTTLE > 0 || defined(CONFIG_IOB_QUOTA)
   FAR sem_t *sem;
 #endif
 
@@ -260,57 +402,70 @@ FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid)
   /* Select the semaphore count to check. */
 
   sem = (throttled ? &g_throttle_sem : &g_iob_sem);
+#elif defined(CONFIG_IOB_QUOTA)
+  sem = &g_iob_sem;
 #endif
 
-  /* We don't know what context we are called from so we use extreme measures
-   * to protect the free list:  We disable interrupts very briefly.
+  /* We don't know what context we are called from so we disable interrupts
+   * very briefly while holding the lock that protects the free lists.  The
+   * free lists, the semaphore counts and the quotas must change together,
+   * so they are not split into per-CPU or lock-free lists.
    */
 
-  flags = enter_critical_section();
+  flags = spin_lock_save(&g_iob_lock);
 
 #if CONFIG_IOB_THROTTLE > 0
   /* If there are free I/O buffers for this allocation */
 
   if (sem->semcount > 0)
+#endif
+#ifdef CONFIG_IOB_QUOTA
+  /* And if the quotas permit the consumer to have another one */
+
+  if (iob_quota_check(consumerid, sem->semcount))
 #endif
     {
-      /* Take the I/O buffer from the head of the free list */
+      /* Take a semaphore count.  Note that we cannot do this in the
+       * orthodox way by calling nxsem_wait() or nxsem_trywait() because
+       * this function may be called from an interrupt handler.  This fails
+       * if there is no free buffer or if waiting tasks have claimed them.
+       */
 
-      iob = g_iob_freelist;
-      if (iob != NULL)
+      if (nxsem_trytake(&g_iob_sem) == OK)
         {
-          /* Remove the I/O buffer from the free list and decrement the
-           * counting semaphore(s) that tracks the number of available
-           * IOBs.
-           */
-
-          g_iob_freelist = iob->io_flink;
+          /* Take the I/O buffer from the head of the free list */
 
-          /* Take a semaphore count.  Note that we cannot do this in
-           * in the orthodox way by calling nxsem_wait() or nxsem_trywait()
-           * because this function may be called from an interrupt
-           * handler. Fortunately we know at at least one free buffer
-           * so a simple decrement is all that is needed.
-           */
+          iob = iob_remove_free(size);
+          if (iob == NULL)
+            {
+              /* This should not happen:  A count on the semaphore means a
+               * buffer on the free list.  Give the count back.
+               */
 
-          g_iob_sem.semcount--;
-          DEBUGASSERT(g_iob_sem.semcount >= 0);
+              spin_unlock_restore(&g_iob_lock, flags);
+              nxsem_post(&g_iob_sem);
+              return NULL;
+            }
 
 #if CONFIG_IOB_THROTTLE > 0
           /* The throttle semaphore is a little more complicated because
            * it can be negative!  Decrementing is still safe, however.
            */
 
-          g_throttle_sem.semcount--;
+          nxsem_decrement(&g_throttle_sem);
           DEBUGASSERT(g_throttle_sem.semcount >= -CONFIG_IOB_THROTTLE);
 #endif
 
+#ifdef CONFIG_IOB_QUOTA
+          iob_quota_charge(iob, consumerid);
+#endif
+
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
     defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
           iob_stats_onalloc(consumerid);
 #endif
 
-          leave_critical_section(flags);
+          spin_unlock_restore(&g_iob_lock, flags);
 
           /* Put the I/O buffer in a known state */
 
@@ -322,6 +477,6 @@ FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid)
         }
     }
 
-  leave_critical_section(flags);
+  spin_unlock_restore(&g_iob_lock, flags);
   return NULL;
 }
@@ -45,6 +45,7 @@
 
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/mm/iob.h>
 
 #include "iob.h"
@@ -69,11 +70,11 @@ static FAR struct iob_qentry_s *iob_alloc_qcommitted(void)
   FAR struct iob_qentry_s *iobq = NULL;
   irqstate_t flags;
 
-  /* We don't know what context we are called from so we use extreme measures
-   * to protect the committed list:  We disable interrupts very briefly.
+  /* We don't know what context we are called from so we disable interrupts
+   * very briefly while holding the lock that protects the committed list.
    */
 
-  flags = enter_critical_section();
+  flags = spin_lock_save(&g_iob_lock);
 
   /* Take the I/O buffer from the head of the committed list */
 
@@ -89,7 +90,7 @@ static FAR struct iob_qentry_s *iob_alloc_qcommitted(void)
       iobq->qe_head = NULL; /* Nothing is contained */
     }
 
-  leave_critical_section(flags);
+  spin_unlock_restore(&g_iob_lock, flags);
   return iobq;
 }
 
@@ -106,19 +107,13 @@ static FAR struct iob_qentry_s *iob_alloc_qcommitted(void)
 static FAR struct iob_qentry_s *iob_allocwait_qentry(void)
 {
   FAR struct iob_qentry_s *qentry;
-  irqstate_t flags;
   int ret = OK;
 
-  /* The following must be atomic; interrupt must be disabled so that there
-   * is no conflict with interrupt level I/O buffer chain container
-   * allocations.  This is not as bad as it sounds because interrupts will be
-   * re-enabled while we are waiting for I/O buffers to become free.
-   */
-
-  flags = enter_critical_section();
-
   /* Try to get an I/O buffer chain container.  If successful, the semaphore
-   * count will bedecremented atomically.
+   * count will bedecremented atomically.  No lock is held across the wait
+   * below:  A container that is freed before we wait leaves its count on
+   * the semaphore, so the wait returns at once and the container is found
+   * on the free list.
    */
 
   qentry = iob_tryalloc_qentry();
@@ -178,7 +173,6 @@ static FAR struct iob_qentry_s *iob_allocwait_qentry(void)
         }
     }
 
-  leave_critical_section(flags);
   return qentry;
 }
 
@@ -229,37 +223,42 @@ FAR struct iob_qentry_s *iob_tryalloc_qentry(void)
   FAR struct iob_qentry_s *iobq;
   irqstate_t flags;
 
-  /* We don't know what context we are called from so we use extreme measures
-   * to protect the free list:  We disable interrupts very briefly.
+  /* We don't know what context we are called from so we disable interrupts
+   * very briefly while holding the lock that protects the free list.
+   *
+   * Take a semaphore count.  Note that we cannot do this in the orthodox
+   * way by calling nxsem_wait() or nxsem_trywait() because this function
+   * may be called from an interrupt handler.  This fails if there is no
+   * free container or if waiting tasks have claimed them.
    */
 
-  flags = enter_critical_section();
-  iobq  = g_iob_freeqlist;
-  if (iobq)
+  flags = spin_lock_save(&g_iob_lock);
+  if (nxsem_trytake(&g_qentry_sem) < 0)
     {
-      /* Remove the I/O buffer chain container from the free list and
-       * decrement the counting semaphore that tracks the number of free
-       * containers.
-       */
+      spin_unlock_restore(&g_iob_lock, flags);
+      return NULL;
+    }
 
-      g_iob_freeqlist = iobq->qe_flink;
+  /* Remove the I/O buffer chain container from the free list */
 
-      /* Take a semaphore count.  Note that we cannot do this in
-       * in the orthodox way by calling nxsem_wait() or nxsem_trywait()
-       * because this function may be called from an interrupt
-       * handler. Fortunately we know at at least one free buffer
-       * so a simple decrement is all that is needed.
+  iobq = g_iob_freeqlist;
+  if (iobq == NULL)
+    {
+      /* This should not happen:  A count on the semaphore means a
+       * container on the free list.  Give the count back.
        */
 
-      g_qentry_sem.semcount--;
-      DEBUGASSERT(g_qentry_sem.semcount >= 0);
+      spin_unlock_restore(&g_iob_lock, flags);
+      nxsem_post(&g_qentry_sem);
+      return NULL;
+    }
 
-      /* Put the I/O buffer in a known state */
+  g_iob_freeqlist = iobq->qe_flink;
+  spin_unlock_restore(&g_iob_lock, flags);
 
-      iobq->qe_head = NULL; /* Nothing is contained */
-    }
+  /* Put the I/O buffer in a known state */
 
-  leave_critical_section(flags);
+  iobq->qe_head = NULL; /* Nothing is contained */
   return iobq;
 }
 
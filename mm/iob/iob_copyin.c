@@ -135,7 +135,7 @@ static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
 
               /* Yes.. We can extend this buffer to the up to the very end. */
 
-              maxlen = CONFIG_IOB_BUFSIZE - iob->io_offset;
+              maxlen = IOB_BUFSIZE(iob) - iob->io_offset;
 
               /* This is the new buffer length that we need.  Of course,
                * clipped to the maximum possible size in this buffer.
@@ -183,18 +183,19 @@ static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
 
       if (len > 0 && !next)
         {
-          /* Yes.. allocate a new buffer.
+          /* Yes.. allocate a new buffer, preferring one that is large
+           * enough for the rest of the data.
            *
            * Copy as many bytes as possible. Block if we're allowed.
            */
 
           if (can_block)
             {
-              next = iob_alloc(throttled, consumerid);
+              next = iob_alloc_size(len, throttled, consumerid);
             }
           else
             {
-              next = iob_tryalloc(throttled, consumerid);
+              next = iob_tryalloc_size(len, throttled, consumerid);
             }
 
           if (next == NULL)
@@ -46,6 +46,7 @@
 
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/mm/iob.h>
 
 #include "iob.h"
@@ -74,6 +75,35 @@
 
 #define IOB_MASK      (IOB_DIVIDER - 1)
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_add_free
+ *
+ * Description:
+ *   Add an I/O buffer to the head of the free list of its size.  Must be
+ *   called with g_iob_lock held.
+ *
+ ****************************************************************************/
+
+static void iob_add_free(FAR struct iob_s *iob)
+{
+#if CONFIG_IOB_NLARGE > 0
+  if (iob->io_bufsize > CONFIG_IOB_BUFSIZE)
+    {
+      iob->io_flink   = g_iob_lfreelist;
+      g_iob_lfreelist = iob;
+    }
+  else
+#endif
+    {
+      iob->io_flink   = g_iob_freelist;
+      g_iob_freelist  = iob;
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -92,6 +122,7 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob,
 {
   FAR struct iob_s *next = iob->io_flink;
   irqstate_t flags;
+  irqstate_t lflags;
 #ifdef CONFIG_IOB_NOTIFIER
   int16_t navail;
 #endif
@@ -131,46 +162,74 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob,
 
   /* Free the I/O buffer by adding it to the head of the free or the
    * committed list. We don't know what context we are called from so
-   * we use extreme measures to protect the free list:  We disable
-   * interrupts very briefly.
+   * we disable interrupts very briefly while holding the lock that
+   * protects the lists.
    */
 
-  flags = enter_critical_section();
+  flags = spin_lock_save(&g_iob_lock);
+
+#ifdef CONFIG_IOB_QUOTA
+  /* Return the I/O buffer to the quota of the consumer that allocated it */
+
+  iob_quota_release(iob);
+#endif
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+  iob_stats_onfree(producerid);
+#endif
 
-  /* Which list?  If there is a task waiting for an IOB, then put
-   * the IOB on either the free list or on the committed list where
-   * it is reserved for that allocation (and not available to
-   * iob_tryalloc()).
+  /* Which list?  If no task is waiting for an IOB, then give the count
+   * back and put the IOB on the free list while still holding the lock,
+   * so that iob_tryalloc() sees both change together.
    */
 
-  if (g_iob_sem.semcount < 0)
+  if (nxsem_trygive(&g_iob_sem) == OK)
     {
-      iob->io_flink   = g_iob_committed;
-      g_iob_committed = iob;
+      iob_add_free(iob);
+      spin_unlock_restore(&g_iob_lock, flags);
     }
   else
     {
-      iob->io_flink   = g_iob_freelist;
-      g_iob_freelist  = iob;
-    }
+      /* A task is waiting for an IOB.  Put the IOB on the committed list
+       * where it is reserved for that allocation (and not available to
+       * iob_tryalloc()).  nxsem_post() may wake up the task, so it cannot
+       * be called with the lock held.  The critical section keeps the
+       * waiting task from giving up its wait before it gets the count.
+       */
 
-  /* Signal that an IOB is available.  If there is a thread blocked,
-   * waiting for an IOB, this will wake up exactly one thread.  The
-   * semaphore count will correctly indicated that the awakened task
-   * owns an IOB and should find it in the committed list.
-   */
+      spin_unlock_restore(&g_iob_lock, flags);
+      flags = enter_critical_section();
+
+      lflags = spin_lock_save(&g_iob_lock);
+      if (g_iob_sem.semcount < 0)
+        {
+          iob->io_flink   = g_iob_committed;
+          g_iob_committed = iob;
+        }
+      else
+        {
+          iob_add_free(iob);
+        }
 
-  nxsem_post(&g_iob_sem);
-  DEBUGASSERT(g_iob_sem.semcount <= CONFIG_IOB_NBUFFERS);
+      spin_unlock_restore(&g_iob_lock, lflags);
 
-#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
-    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
-  iob_stats_onfree(producerid);
-#endif
+      /* Signal that an IOB is available.  This will wake up exactly one
+       * thread.  The semaphore count will correctly indicated that the
+       * awakened task owns an IOB and should find it in the committed
+       * list.
+       */
+
+      nxsem_post(&g_iob_sem);
+      leave_critical_section(flags);
+    }
+
+  DEBUGASSERT(g_iob_sem.semcount <= IOB_NBUFFERS_TOTAL);
 
 #if CONFIG_IOB_THROTTLE > 0
   nxsem_post(&g_throttle_sem);
-  DEBUGASSERT(g_throttle_sem.semcount <= (CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE));
+  DEBUGASSERT(g_throttle_sem.semcount <=
+              (IOB_NBUFFERS_TOTAL - CONFIG_IOB_THROTTLE));
 #endif
 
 #ifdef CONFIG_IOB_NOTIFIER
@@ -189,8 +248,6 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob,
     }
 #endif
 
-  leave_critical_section(flags);
-
   /* And return the I/O buffer after the one that was freed */
 
   return next;
@@ -44,6 +44,7 @@
 
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/mm/iob.h>
 
 #include "iob.h"
@@ -67,42 +68,61 @@ FAR struct iob_qentry_s *iob_free_qentry(FAR struct iob_qentry_s *iobq)
 {
   FAR struct iob_qentry_s *nextq = iobq->qe_flink;
   irqstate_t flags;
+  irqstate_t lflags;
 
   /* Free the I/O buffer chain container by adding it to the head of the
    * free or the committed list. We don't know what context we are called
-   * from so we use extreme measures to protect the free list:  We disable
-   * interrupts very briefly.
+   * from so we disable interrupts very briefly while holding the lock that
+   * protects the lists.
+   *
+   * Which list?  If no task is waiting for an IOB chain, then give the
+   * count back and put the IOB chain on the free list while still holding
+   * the lock, so that iob_tryalloc_qentry() sees both change together.
    */
 
-  flags = enter_critical_section();
-
-  /* Which list?  If there is a task waiting for an IOB chain, then put
-   * the IOB chain on either the free list or on the committed list where
-   * it is reserved for that allocation (and not available to
-   * iob_tryalloc_qentry()).
-   */
-
-  if (g_qentry_sem.semcount < 0)
+  flags = spin_lock_save(&g_iob_lock);
+  if (nxsem_trygive(&g_qentry_sem) == OK)
     {
-      iobq->qe_flink   = g_iob_qcommitted;
-      g_iob_qcommitted = iobq;
+      iobq->qe_flink  = g_iob_freeqlist;
+      g_iob_freeqlist = iobq;
+      spin_unlock_restore(&g_iob_lock, flags);
     }
   else
     {
-      iobq->qe_flink   = g_iob_freeqlist;
-      g_iob_freeqlist  = iobq;
+      /* A task is waiting.  Put the IOB chain on the committed list where
+       * it is reserved for that allocation (and not available to
+       * iob_tryalloc_qentry()).  nxsem_post() may wake up the task, so it
+       * cannot be called with the lock held.  The critical section keeps
+       * the waiting task from giving up its wait before it gets the count.
+       */
+
+      spin_unlock_restore(&g_iob_lock, flags);
+      flags = enter_critical_section();
+
+      lflags = spin_lock_save(&g_iob_lock);
+      if (g_qentry_sem.semcount < 0)
+        {
+          iobq->qe_flink   = g_iob_qcommitted;
+          g_iob_qcommitted = iobq;
+        }
+      else
+        {
+          iobq->qe_flink   = g_iob_freeqlist;
+          g_iob_freeqlist  = iobq;
+        }
+
+      spin_unlock_restore(&g_iob_lock, lflags);
+
+      /* Signal that an I/O buffer chain container is available.  This will
+       * wake up exactly one thread.  The semaphore count will correctly
+       * indicated that the awakened task owns an I/O buffer chain container
+       * and should find it in the committed list.
+       */
+
+      nxsem_post(&g_qentry_sem);
+      leave_critical_section(flags);
     }
 
-  /* Signal that an I/O buffer chain container is available.  If there
-   * is a thread waiting for an I/O buffer chain container, this will
-   * wake up exactly one thread.  The semaphore count will correctly
-   * indicated that the awakened task owns an I/O buffer chain container
-   * and should find it in the committed list.
-   */
-
-  nxsem_post(&g_qentry_sem);
-  leave_critical_section(flags);
-
   /* And return the I/O buffer chain container after the one that was freed */
 
   return nextq;
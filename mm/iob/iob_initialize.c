@@ -39,6 +39,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <stdbool.h>
 
 #include <nuttx/semaphore.h>
@@ -61,6 +62,16 @@
 /* This is a pool of pre-allocated I/O buffers */
 
 static struct iob_s        g_iob_pool[CONFIG_IOB_NBUFFERS];
+#if CONFIG_IOB_NLARGE > 0
+static struct iob_s        g_iob_lpool[CONFIG_IOB_NLARGE];
+
+/* If there are large I/O buffers, then the data buffers are separate from
+ * the I/O buffer structures.
+ */
+
+static uint8_t g_iob_buffers[CONFIG_IOB_NBUFFERS][CONFIG_IOB_BUFSIZE];
+static uint8_t g_iob_lbuffers[CONFIG_IOB_NLARGE][CONFIG_IOB_LARGE_BUFSIZE];
+#endif
 #if CONFIG_IOB_NCHAINS > 0
 static struct iob_qentry_s g_iob_qpool[CONFIG_IOB_NCHAINS];
 #endif
@@ -73,6 +84,12 @@ static struct iob_qentry_s g_iob_qpool[CONFIG_IOB_NCHAINS];
 
 FAR struct iob_s *g_iob_freelist;
 
+#if CONFIG_IOB_NLARGE > 0
+/* A list of all free, unallocated large I/O buffers */
+
+FAR struct iob_s *g_iob_lfreelist;
+#endif
+
 /* A list of I/O buffers that are committed for allocation */
 
 FAR struct iob_s *g_iob_committed;
@@ -97,6 +114,12 @@ sem_t g_throttle_sem;       /* Counts available I/O buffers when throttled */
 sem_t g_qentry_sem;         /* Counts free I/O buffer queue containers */
 #endif
 
+#ifdef CONFIG_SMP
+/* This spinlock protects the free and committed lists and the quotas */
+
+volatile spinlock_t g_iob_lock SP_SECTION = SP_UNLOCKED;
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -124,17 +147,44 @@ void iob_initialize(void)
         {
           FAR struct iob_s *iob = &g_iob_pool[i];
 
+#if CONFIG_IOB_NLARGE > 0
+          iob->io_bufsize = CONFIG_IOB_BUFSIZE;
+          iob->io_data    = g_iob_buffers[i];
+#endif
+
           /* Add the pre-allocate I/O buffer to the head of the free list */
 
           iob->io_flink  = g_iob_freelist;
           g_iob_freelist = iob;
         }
 
+#if CONFIG_IOB_NLARGE > 0
+      /* Add each large I/O buffer to the large free list */
+
+      for (i = 0; i < CONFIG_IOB_NLARGE; i++)
+        {
+          FAR struct iob_s *iob = &g_iob_lpool[i];
+
+          iob->io_bufsize = CONFIG_IOB_LARGE_BUFSIZE;
+          iob->io_data    = g_iob_lbuffers[i];
+          iob->io_flink   = g_iob_lfreelist;
+          g_iob_lfreelist = iob;
+        }
+#endif
+
       g_iob_committed = NULL;
 
-      nxsem_init(&g_iob_sem, 0, CONFIG_IOB_NBUFFERS);
+      /* The semaphores count the I/O buffers of all sizes.  They are used
+       * for counting only, so priority inheritance must be disabled.  That
+       * also lets the counts be changed without the critical section.
+       */
+
+      nxsem_init(&g_iob_sem, 0, IOB_NBUFFERS_TOTAL);
+      (void)nxsem_setprotocol(&g_iob_sem, SEM_PRIO_NONE);
 #if CONFIG_IOB_THROTTLE > 0
-      nxsem_init(&g_throttle_sem, 0, CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE);
+      nxsem_init(&g_throttle_sem, 0,
+                 IOB_NBUFFERS_TOTAL - CONFIG_IOB_THROTTLE);
+      (void)nxsem_setprotocol(&g_throttle_sem, SEM_PRIO_NONE);
 #endif
 
 #if CONFIG_IOB_NCHAINS > 0
@@ -153,6 +203,7 @@ void iob_initialize(void)
       g_iob_qcommitted = NULL;
 
       nxsem_init(&g_qentry_sem, 0, CONFIG_IOB_NCHAINS);
+      (void)nxsem_setprotocol(&g_qentry_sem, SEM_PRIO_NONE);
 #endif
 
       initialized = true;
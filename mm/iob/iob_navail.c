@@ -41,6 +41,7 @@
 
 #include <stdbool.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/mm/iob.h>
 
@@ -92,6 +93,33 @@ int iob_navail(bool throttled)
   return ret;
 }
 
+/****************************************************************************
+ * Name: iob_navail_large
+ *
+ * Description:
+ *   Return the number of available large IOBs.  These are included in the
+ *   count returned by iob_navail().
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_NLARGE > 0
+int iob_navail_large(void)
+{
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+  int navail = 0;
+
+  flags = spin_lock_save(&g_iob_lock);
+  for (iob = g_iob_lfreelist; iob != NULL; iob = iob->io_flink)
+    {
+      navail++;
+    }
+
+  spin_unlock_restore(&g_iob_lock, flags);
+  return navail;
+}
+#endif
+
 /****************************************************************************
  * Name: iob_qentry_navail
  *
@@ -0,0 +1,296 @@
+/****************************************************************************
+ * mm/iob/iob_quota.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/mm/iob.h>
+
+#include "iob.h"
+
+#ifdef CONFIG_IOB_QUOTA
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The quota and I/O buffer usage of one consumer */
+
+struct iob_quota_s
+{
+  int16_t iq_reserve;   /* Number of I/O buffers reserved for the consumer */
+  int16_t iq_limit;     /* Maximum number of I/O buffers (0 = no limit) */
+  int16_t iq_inuse;     /* Number of I/O buffers held by the consumer */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct iob_quota_s g_iob_quota[IOBUSER_NENTRIES];
+
+/* The number of reserved I/O buffers that have not yet been allocated by
+ * the consumers for which they are reserved.
+ */
+
+static int16_t g_iob_reserved;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_quota_unused
+ *
+ * Description:
+ *   Return the number of the consumer's reserved I/O buffers that it has
+ *   not yet allocated.
+ *
+ ****************************************************************************/
+
+static inline int iob_quota_unused(FAR struct iob_quota_s *quota)
+{
+  return quota->iq_inuse < quota->iq_reserve ?
+         quota->iq_reserve - quota->iq_inuse : 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_quota_limited
+ *
+ * Description:
+ *   Return true if the consumer already holds the maximum number of I/O
+ *   buffers that it is permitted.  Must be called with g_iob_lock held.
+ *
+ ****************************************************************************/
+
+bool iob_quota_limited(enum iob_user_e consumerid)
+{
+  FAR struct iob_quota_s *quota;
+
+  if (consumerid < 0 || consumerid >= IOBUSER_NENTRIES)
+    {
+      return false;
+    }
+
+  quota = &g_iob_quota[consumerid];
+  return quota->iq_limit > 0 && quota->iq_inuse >= quota->iq_limit;
+}
+
+/****************************************************************************
+ * Name: iob_quota_check
+ *
+ * Description:
+ *   Check if the consumer may allocate one more I/O buffer when 'navail'
+ *   I/O buffers are free.  Must be called with g_iob_lock held.
+ *
+ ****************************************************************************/
+
+bool iob_quota_check(enum iob_user_e consumerid, int navail)
+{
+  FAR struct iob_quota_s *quota;
+
+  if (consumerid >= 0 && consumerid < IOBUSER_NENTRIES)
+    {
+      quota = &g_iob_quota[consumerid];
+
+      /* The consumer may never hold more than its limit */
+
+      if (quota->iq_limit > 0 && quota->iq_inuse >= quota->iq_limit)
+        {
+          return false;
+        }
+
+      /* But it may always have a buffer from its own reservation */
+
+      if (quota->iq_inuse < quota->iq_reserve)
+        {
+          return navail > 0;
+        }
+    }
+
+  /* Otherwise, the free I/O buffers that are reserved for other consumers
+   * are not available.
+   */
+
+  return navail > g_iob_reserved;
+}
+
+/****************************************************************************
+ * Name: iob_quota_charge
+ *
+ * Description:
+ *   Charge a newly allocated I/O buffer to the consumer.  Must be called
+ *   with g_iob_lock held.
+ *
+ ****************************************************************************/
+
+void iob_quota_charge(FAR struct iob_s *iob, enum iob_user_e consumerid)
+{
+  FAR struct iob_quota_s *quota;
+
+  if (consumerid < 0 || consumerid >= IOBUSER_NENTRIES)
+    {
+      iob->io_user = IOBUSER_UNKNOWN;
+      return;
+    }
+
+  iob->io_user = consumerid;
+  quota        = &g_iob_quota[consumerid];
+
+  if (quota->iq_inuse < quota->iq_reserve)
+    {
+      g_iob_reserved--;
+    }
+
+  quota->iq_inuse++;
+}
+
+/****************************************************************************
+ * Name: iob_quota_release
+ *
+ * Description:
+ *   Return an I/O buffer that is being freed to the quota of the consumer
+ *   that allocated it.  Must be called with g_iob_lock held.
+ *
+ ****************************************************************************/
+
+void iob_quota_release(FAR struct iob_s *iob)
+{
+  FAR struct iob_quota_s *quota;
+
+  if (iob->io_user < 0 || iob->io_user >= IOBUSER_NENTRIES)
+    {
+      return;
+    }
+
+  quota = &g_iob_quota[iob->io_user];
+  DEBUGASSERT(quota->iq_inuse > 0);
+
+  quota->iq_inuse--;
+  if (quota->iq_inuse < quota->iq_reserve)
+    {
+      g_iob_reserved++;
+    }
+
+  iob->io_user = IOBUSER_UNKNOWN;
+}
+
+/****************************************************************************
+ * Name: iob_setquota
+ *
+ * Description:
+ *   Set the I/O buffer quota of one consumer.
+ *
+ * Input Parameters:
+ *   userid  - The consumer whose quota is being set
+ *   reserve - The number of I/O buffers reserved for the consumer.  Other
+ *             consumers may not allocate these buffers while the consumer
+ *             holds fewer than 'reserve' buffers.
+ *   limit   - The maximum number of I/O buffers that the consumer may hold
+ *             at any time or zero if there is no limit.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure:
+ *
+ *   -EINVAL - The consumer is invalid or the limit is less than the
+ *             reservation.
+ *   -ENOSPC - The total of all reservations would exceed the number of
+ *             I/O buffers.
+ *
+ ****************************************************************************/
+
+int iob_setquota(enum iob_user_e userid, unsigned int reserve,
+                 unsigned int limit)
+{
+  FAR struct iob_quota_s *quota;
+  irqstate_t flags;
+  int total;
+  int i;
+
+  if (userid < 0 || userid >= IOBUSER_GLOBAL ||
+      reserve > IOB_NBUFFERS_TOTAL || limit > IOB_NBUFFERS_TOTAL ||
+      (limit > 0 && limit < reserve))
+    {
+      return -EINVAL;
+    }
+
+  quota = &g_iob_quota[userid];
+  flags = spin_lock_save(&g_iob_lock);
+
+  /* The reservations must leave at least one I/O buffer for everyone
+   * else.
+   */
+
+  for (i = 0, total = reserve; i < IOBUSER_NENTRIES; i++)
+    {
+      if (i != userid)
+        {
+          total += g_iob_quota[i].iq_reserve;
+        }
+    }
+
+  if (total >= IOB_NBUFFERS_TOTAL)
+    {
+      spin_unlock_restore(&g_iob_lock, flags);
+      return -ENOSPC;
+    }
+
+  /* Replace the consumer's unused reservation with the new one */
+
+  g_iob_reserved    -= iob_quota_unused(quota);
+  quota->iq_reserve  = reserve;
+  quota->iq_limit    = limit;
+  g_iob_reserved    += iob_quota_unused(quota);
+
+  spin_unlock_restore(&g_iob_lock, flags);
+  return OK;
+}
+
+#endif /* CONFIG_IOB_QUOTA */
@@ -73,7 +73,13 @@ struct mm_heap_s g_kmmheap;
 
 void kmm_initialize(FAR void *heap_start, size_t heap_size)
 {
-  return mm_initialize(&g_kmmheap, heap_start, heap_size);
+  mm_initialize(&g_kmmheap, heap_start, heap_size);
+
+#ifdef MM_HAVE_CACHE
+  /* The kernel heap is only accessed from privileged code */
+
+  g_kmmheap.mm_cacheon = true;
+#endif
 }
 
 #endif /* CONFIG_MM_KERNEL_HEAP */
@@ -58,7 +58,24 @@ void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 {
   FAR struct mm_freenode_s *next;
   FAR struct mm_freenode_s *prev;
+#ifdef CONFIG_MM_TLSF
+  int fl;
+  int sl;
 
+  /* Convert the size to first and second level list indices */
+
+  mm_tlsf_mapping(node->size, &fl, &sl);
+
+  /* The size class lists are not sorted.  Just add the new node at the
+   * head of the list and mark the list as non-empty.
+   */
+
+  prev = &heap->mm_nodelist[fl][sl];
+  next = prev->flink;
+
+  heap->mm_flbitmap     |= (1u << fl);
+  heap->mm_slbitmap[fl] |= (1u << sl);
+#else
   /* Convert the size to a nodelist index */
 
   int ndx = mm_size2ndx(node->size);
@@ -68,6 +85,7 @@ void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
   for (prev = &heap->mm_nodelist[ndx], next = heap->mm_nodelist[ndx].flink;
        next && next->size && next->size < node->size;
        prev = next, next = next->flink);
+#endif
 
   /* Does it go in mid next or at the end? */
 
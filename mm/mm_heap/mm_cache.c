@@ -0,0 +1,306 @@
+/****************************************************************************
+ * mm/mm_heap/mm_cache.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/mm/mm.h>
+
+#ifdef MM_HAVE_CACHE
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cache_drain
+ *
+ * Description:
+ *   Return a list of cached chunks to the heap.
+ *
+ ****************************************************************************/
+
+static void mm_cache_drain(FAR struct mm_heap_s *heap, FAR void *list)
+{
+  FAR void *next;
+
+  mm_takesemaphore(heap);
+  while (list != NULL)
+    {
+      next = *(FAR void **)list;
+      mm_freechunk(heap, list);
+      list = next;
+    }
+
+  mm_givesemaphore(heap);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cache_alloc
+ *
+ * Description:
+ *   Try to allocate a chunk of size 'alignsize' from this CPU's cache.
+ *   Local interrupts are disabled so that the task cannot be preempted or
+ *   migrated while the cache is being modified; the MM semaphore is not
+ *   needed.
+ *
+ * Returned Value:
+ *   The allocated memory or NULL on a cache miss.
+ *
+ ****************************************************************************/
+
+FAR void *mm_cache_alloc(FAR struct mm_heap_s *heap, size_t alignsize)
+{
+  FAR struct mm_cache_s *cache;
+  FAR void *mem;
+  irqstate_t flags;
+  int ndx = MM_CACHE_NDX(alignsize);
+
+  flags = up_irq_save();
+  cache = &heap->mm_cache[up_cpu_index()];
+
+  mem = cache->mc_head[ndx];
+  if (mem != NULL)
+    {
+      cache->mc_head[ndx] = *(FAR void **)mem;
+      cache->mc_count[ndx]--;
+      cache->mc_hits++;
+    }
+  else
+    {
+      cache->mc_misses++;
+    }
+
+  up_irq_restore(flags);
+  return mem;
+}
+
+/****************************************************************************
+ * Name: mm_cache_refill
+ *
+ * Description:
+ *   Allocate up to CONFIG_MM_CACHE_BATCH chunks of size 'alignsize' from
+ *   the heap and add them to this CPU's cache.  It is assumed that the
+ *   caller holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+void mm_cache_refill(FAR struct mm_heap_s *heap, size_t alignsize)
+{
+  FAR struct mm_cache_s *cache;
+  FAR void *mem;
+  irqstate_t flags;
+  int ndx = MM_CACHE_NDX(alignsize);
+  int i;
+
+  for (i = 0; i < CONFIG_MM_CACHE_BATCH; i++)
+    {
+      mem = mm_allocchunk(heap, alignsize);
+      if (mem == NULL)
+        {
+          break;
+        }
+
+      flags = up_irq_save();
+      cache = &heap->mm_cache[up_cpu_index()];
+
+      if (cache->mc_count[ndx] >= CONFIG_MM_CACHE_DEPTH)
+        {
+          up_irq_restore(flags);
+          mm_freechunk(heap, mem);
+          break;
+        }
+
+      *(FAR void **)mem   = cache->mc_head[ndx];
+      cache->mc_head[ndx] = mem;
+      cache->mc_count[ndx]++;
+
+      up_irq_restore(flags);
+    }
+}
+
+/****************************************************************************
+ * Name: mm_cache_free
+ *
+ * Description:
+ *   Try to return a chunk to this CPU's cache.  If the cache for that size
+ *   class is full, then a batch of CONFIG_MM_CACHE_BATCH cached chunks is
+ *   drained back to the heap to make space.
+ *
+ * Returned Value:
+ *   True if the chunk was cached; false if the chunk is too large for the
+ *   cache and must be freed to the heap by the caller.
+ *
+ ****************************************************************************/
+
+bool mm_cache_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_allocnode_s *node;
+  FAR struct mm_cache_s *cache;
+  FAR void *drain = NULL;
+  FAR void *tail;
+  irqstate_t flags;
+  int ndx;
+  int i;
+
+  node = (FAR struct mm_allocnode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+  DEBUGASSERT(node->preceding & MM_ALLOC_BIT);
+
+  if (node->size > MM_CACHE_MAXCHUNK)
+    {
+      return false;
+    }
+
+  ndx   = MM_CACHE_NDX(node->size);
+  flags = up_irq_save();
+  cache = &heap->mm_cache[up_cpu_index()];
+
+  if (cache->mc_count[ndx] >= CONFIG_MM_CACHE_DEPTH)
+    {
+      /* Detach a batch of chunks from the head of the list */
+
+      drain = cache->mc_head[ndx];
+      tail  = drain;
+
+      for (i = 1; i < CONFIG_MM_CACHE_BATCH; i++)
+        {
+          tail = *(FAR void **)tail;
+        }
+
+      cache->mc_head[ndx]   = *(FAR void **)tail;
+      cache->mc_count[ndx] -= CONFIG_MM_CACHE_BATCH;
+      *(FAR void **)tail    = NULL;
+    }
+
+  *(FAR void **)mem   = cache->mc_head[ndx];
+  cache->mc_head[ndx] = mem;
+  cache->mc_count[ndx]++;
+
+  up_irq_restore(flags);
+
+  /* Now return the detached chunks to the heap */
+
+  if (drain != NULL)
+    {
+      mm_cache_drain(heap, drain);
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: mm_cache_flush
+ *
+ * Description:
+ *   Return all of the chunks in this CPU's cache to the heap.  This is done
+ *   when an allocation from the heap fails.  The caches of other CPUs
+ *   cannot be safely accessed and are not flushed.
+ *
+ ****************************************************************************/
+
+void mm_cache_flush(FAR struct mm_heap_s *heap)
+{
+  FAR struct mm_cache_s *cache;
+  FAR void *list;
+  irqstate_t flags;
+  int ndx;
+
+  for (ndx = 0; ndx < MM_CACHE_NCLASSES; ndx++)
+    {
+      flags = up_irq_save();
+      cache = &heap->mm_cache[up_cpu_index()];
+
+      list                 = cache->mc_head[ndx];
+      cache->mc_head[ndx]  = NULL;
+      cache->mc_count[ndx] = 0;
+
+      up_irq_restore(flags);
+
+      if (list != NULL)
+        {
+          mm_cache_drain(heap, list);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mm_cache_info
+ *
+ * Description:
+ *   Add the cache occupancy and hit statistics of all CPUs to 'info'.  The
+ *   values are sampled without locking and so are only approximate.
+ *
+ ****************************************************************************/
+
+void mm_cache_info(FAR struct mm_heap_s *heap, FAR struct mallinfo *info)
+{
+  FAR struct mm_cache_s *cache;
+  size_t chunksize;
+  int cpu;
+  int ndx;
+
+  info->cachedblks  = 0;
+  info->cachehits   = 0;
+  info->cachemisses = 0;
+
+  for (cpu = 0; cpu < MM_CACHE_NCPUS; cpu++)
+    {
+      cache = &heap->mm_cache[cpu];
+
+      for (ndx = 0; ndx < MM_CACHE_NCLASSES; ndx++)
+        {
+          chunksize         = (size_t)(ndx + 1) << MM_MIN_SHIFT;
+          info->cachedblks += cache->mc_count[ndx] * chunksize;
+        }
+
+      info->cachehits   += cache->mc_hits;
+      info->cachemisses += cache->mc_misses;
+    }
+}
+
+#endif /* MM_HAVE_CACHE */
@@ -49,35 +49,21 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: mm_free
+ * Name: mm_freechunk
  *
  * Description:
  *   Returns a chunk of memory to the list of free nodes,  merging with
- *   adjacent free chunks if possible.
+ *   adjacent free chunks if possible.  It is assumed that the caller holds
+ *   the mm semaphore.
  *
  ****************************************************************************/
 
-void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
+void mm_freechunk(FAR struct mm_heap_s *heap, FAR void *mem)
 {
   FAR struct mm_freenode_s *node;
   FAR struct mm_freenode_s *prev;
   FAR struct mm_freenode_s *next;
 
-  minfo("Freeing %p\n", mem);
-
-  /* Protect against attempts to free a NULL reference */
-
-  if (!mem)
-    {
-      return;
-    }
-
-  /* We need to hold the MM semaphore while we muck with the
-   * nodelist.
-   */
-
-  mm_takesemaphore(heap);
-
   /* Map the memory chunk into a free node */
 
   node = (FAR struct mm_freenode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
@@ -103,16 +89,9 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 
       andbeyond = (FAR struct mm_allocnode_s *)((FAR char *)next + next->size);
 
-      /* Remove the next node.  There must be a predecessor,
-       * but there may not be a successor node.
-       */
+      /* Remove the next node from the nodelist */
 
-      DEBUGASSERT(next->blink);
-      next->blink->flink = next->flink;
-      if (next->flink)
-        {
-          next->flink->blink = next->blink;
-        }
+      mm_delfreechunk(heap, next);
 
       /* Then merge the two chunks */
 
@@ -129,16 +108,9 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
   DEBUGASSERT((node->preceding & ~MM_ALLOC_BIT) == prev->size);
   if ((prev->preceding & MM_ALLOC_BIT) == 0)
     {
-      /* Remove the node.  There must be a predecessor, but there may
-       * not be a successor node.
-       */
+      /* Remove the previous node from the nodelist */
 
-      DEBUGASSERT(prev->blink);
-      prev->blink->flink = prev->flink;
-      if (prev->flink)
-        {
-          prev->flink->blink = prev->blink;
-        }
+      mm_delfreechunk(heap, prev);
 
       /* Then merge the two chunks */
 
@@ -150,5 +122,44 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
   /* Add the merged node to the nodelist */
 
   mm_addfreechunk(heap, node);
+}
+
+/****************************************************************************
+ * Name: mm_free
+ *
+ * Description:
+ *   Returns a chunk of memory to the list of free nodes,  merging with
+ *   adjacent free chunks if possible.
+ *
+ ****************************************************************************/
+
+void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  minfo("Freeing %p\n", mem);
+
+  /* Protect against attempts to free a NULL reference */
+
+  if (!mem)
+    {
+      return;
+    }
+
+#ifdef MM_HAVE_CACHE
+  /* Small chunks are returned to this CPU's cache without taking the MM
+   * semaphore (unless the cache is full and must be drained).
+   */
+
+  if (heap->mm_cacheon && mm_cache_free(heap, mem))
+    {
+      return;
+    }
+#endif
+
+  /* We need to hold the MM semaphore while we muck with the
+   * nodelist.
+   */
+
+  mm_takesemaphore(heap);
+  mm_freechunk(heap, mem);
   mm_givesemaphore(heap);
 }
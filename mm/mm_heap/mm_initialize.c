@@ -155,7 +155,9 @@ void mm_addregion(FAR struct mm_heap_s *heap, FAR void *heapstart,
 void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
                    size_t heapsize)
 {
+#ifndef CONFIG_MM_TLSF
   int i;
+#endif
 
   minfo("Heap: start=%p size=%u\n", heapstart, heapsize);
 
@@ -179,12 +181,37 @@ void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
 
   /* Initialize the node array */
 
+#ifdef CONFIG_MM_TLSF
+  /* Each size class list is independent and initially empty */
+
+  heap->mm_flbitmap = 0;
+  memset(heap->mm_slbitmap, 0, sizeof(heap->mm_slbitmap));
+  memset(heap->mm_nodelist, 0, sizeof(heap->mm_nodelist));
+#else
   memset(heap->mm_nodelist, 0, sizeof(struct mm_freenode_s) * MM_NNODES);
   for (i = 1; i < MM_NNODES; i++)
     {
       heap->mm_nodelist[i-1].flink = &heap->mm_nodelist[i];
       heap->mm_nodelist[i].blink   = &heap->mm_nodelist[i-1];
     }
+#endif
+
+#ifdef MM_HAVE_CACHE
+  /* All of the per-CPU caches are initially empty.  Outside of the FLAT
+   * build, the kernel code may also initialize the user heap whose cache
+   * cannot be protected; the cache is enabled only for the kernel heap by
+   * kmm_initialize().
+   */
+
+  memset(heap->mm_cache, 0, sizeof(heap->mm_cache));
+#  ifdef CONFIG_BUILD_FLAT
+  heap->mm_cacheon = true;
+#  else
+  heap->mm_cacheon = false;
+#  endif
+#elif defined(CONFIG_MM_CACHE)
+  heap->mm_cacheon = false;
+#endif
 
   /* Initialize the malloc semaphore to one (to support one-at-
    * a-time access to private data sets).
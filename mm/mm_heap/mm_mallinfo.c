@@ -126,5 +126,14 @@ int mm_mallinfo(FAR struct mm_heap_s *heap, FAR struct mallinfo *info)
   info->mxordblk = mxordblk;
   info->uordblks = uordblks;
   info->fordblks = fordblks;
+
+#ifdef MM_HAVE_CACHE
+  mm_cache_info(heap, info);
+#elif defined(CONFIG_MM_CACHE)
+  info->cachedblks  = 0;
+  info->cachehits   = 0;
+  info->cachemisses = 0;
+#endif
+
   return OK;
 }
@@ -59,41 +59,31 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: mm_malloc
+ * Name: mm_allocchunk
  *
  * Description:
  *  Find the smallest chunk that satisfies the request. Take the memory from
- *  that chunk, save the remaining, smaller chunk (if any).
- *
- *  8-byte alignment of the allocated data is assured.
+ *  that chunk, save the remaining, smaller chunk (if any).  'alignsize'
+ *  includes the allocated node header and is already aligned to the granule
+ *  size.  It is assumed that the caller holds the mm semaphore.
  *
  ****************************************************************************/
 
-FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+FAR void *mm_allocchunk(FAR struct mm_heap_s *heap, size_t alignsize)
 {
   FAR struct mm_freenode_s *node;
-  size_t alignsize;
   void *ret = NULL;
+#ifndef CONFIG_MM_TLSF
   int ndx;
+#endif
 
-  /* Ignore zero-length allocations */
-
-  if (size < 1)
-    {
-      return NULL;
-    }
-
-  /* Adjust the size to account for (1) the size of the allocated node and
-   * (2) to make sure that it is an even multiple of our granule size.
+#ifdef CONFIG_MM_TLSF
+  /* Use the size class bitmaps to find a large enough chunk in constant
+   * time.  This is a good fit, but not necessarily the best fit.
    */
 
-  alignsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
-  DEBUGASSERT(alignsize >= size);  /* Check for integer overflow */
-
-  /* We need to hold the MM semaphore while we muck with the nodelist. */
-
-  mm_takesemaphore(heap);
-
+  node = mm_tlsf_search(heap, alignsize);
+#else
   /* Get the location in the node list to start the search. Special case
    * really big allocations
    */
@@ -117,6 +107,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
   for (node = heap->mm_nodelist[ndx].flink;
        node && node->size < alignsize;
        node = node->flink);
+#endif
 
   /* If we found a node with non-zero size, then this is one to use. Since
    * the list is ordered, we know that is must be best fitting chunk
@@ -129,16 +120,9 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       FAR struct mm_freenode_s *next;
       size_t remaining;
 
-      /* Remove the node.  There must be a predecessor, but there may not be
-       * a successor node.
-       */
+      /* Remove the node from the nodelist */
 
-      DEBUGASSERT(node->blink);
-      node->blink->flink = node->flink;
-      if (node->flink)
-        {
-          node->flink->blink = node->blink;
-        }
+      mm_delfreechunk(heap, node);
 
       /* Check if we have to split the free node into one of the allocated
        * size and another smaller freenode.  In some cases, the remaining
@@ -183,7 +167,79 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       ret = (void *)((FAR char *)node + SIZEOF_MM_ALLOCNODE);
     }
 
-  mm_givesemaphore(heap);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mm_malloc
+ *
+ * Description:
+ *  Find the smallest chunk that satisfies the request. Take the memory from
+ *  that chunk, save the remaining, smaller chunk (if any).
+ *
+ *  8-byte alignment of the allocated data is assured.
+ *
+ ****************************************************************************/
+
+FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  size_t alignsize;
+  void *ret = NULL;
+
+  /* Ignore zero-length allocations */
+
+  if (size < 1)
+    {
+      return NULL;
+    }
+
+  /* Adjust the size to account for (1) the size of the allocated node and
+   * (2) to make sure that it is an even multiple of our granule size.
+   */
+
+  alignsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
+  DEBUGASSERT(alignsize >= size);  /* Check for integer overflow */
+
+#ifdef MM_HAVE_CACHE
+  /* Small allocations are first satisfied from this CPU's cache without
+   * taking the MM semaphore.
+   */
+
+  if (heap->mm_cacheon && alignsize <= MM_CACHE_MAXCHUNK)
+    {
+      ret = mm_cache_alloc(heap, alignsize);
+    }
+
+  if (ret == NULL)
+#endif
+    {
+      /* We need to hold the MM semaphore while we muck with the
+       * nodelist.
+       */
+
+      mm_takesemaphore(heap);
+      ret = mm_allocchunk(heap, alignsize);
+
+#ifdef MM_HAVE_CACHE
+      if (heap->mm_cacheon && ret == NULL)
+        {
+          /* Perhaps the memory that we need is sitting in the cache */
+
+          mm_cache_flush(heap);
+          ret = mm_allocchunk(heap, alignsize);
+        }
+      else if (heap->mm_cacheon && alignsize <= MM_CACHE_MAXCHUNK)
+        {
+          /* That was a cache miss.  Refill the cache with a batch of
+           * chunks of the same size while we hold the semaphore.
+           */
+
+          mm_cache_refill(heap, alignsize);
+        }
+#endif
+
+      mm_givesemaphore(heap);
+    }
 
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
   if (ret)
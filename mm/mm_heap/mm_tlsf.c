@@ -0,0 +1,173 @@
+/****************************************************************************
+ * mm/mm_heap/mm_tlsf.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <strings.h>
+#include <assert.h>
+
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_MM_TLSF
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_tlsf_mapping
+ *
+ * Description:
+ *   Convert a chunk size into the indices of the first and second level
+ *   free lists that hold chunks of that size.
+ *
+ ****************************************************************************/
+
+void mm_tlsf_mapping(size_t size, FAR int *fl, FAR int *sl)
+{
+  int msb;
+
+  if (size >= MM_MAX_CHUNK)
+    {
+      /* Really big chunks all go into the single, last list */
+
+      *fl = MM_TLSF_FLCOUNT - 1;
+      *sl = 0;
+    }
+  else if (size < (1 << MM_TLSF_FLSHIFT))
+    {
+      /* Small chunks are spread linearly over the first level 0 lists */
+
+      *fl = 0;
+      *sl = (int)(size >> MM_MIN_SHIFT);
+    }
+  else
+    {
+      msb = fls((int)size) - 1;
+      *fl = msb - MM_TLSF_FLSHIFT + 1;
+      *sl = (int)(size >> (msb - MM_TLSF_SLBITS)) & (MM_TLSF_SLCOUNT - 1);
+    }
+}
+
+/****************************************************************************
+ * Name: mm_tlsf_search
+ *
+ * Description:
+ *   Find a free chunk of at least 'size' bytes.  The request size is first
+ *   rounded up to the next size class boundary so that any chunk in that
+ *   class (or a larger one) is guaranteed to satisfy the request.  The
+ *   bitmaps then give the first non-empty list in constant time.
+ *
+ *   Only if that fails is the list for the unrounded size searched.  That
+ *   list may still hold a chunk that is large enough.
+ *
+ *   The chunk is not removed from the free list.  It is assumed that the
+ *   caller holds the mm semaphore.
+ *
+ * Returned Value:
+ *   The free chunk or NULL if there is no free chunk large enough.
+ *
+ ****************************************************************************/
+
+FAR struct mm_freenode_s *mm_tlsf_search(FAR struct mm_heap_s *heap,
+                                         size_t size)
+{
+  FAR struct mm_freenode_s *node;
+  size_t alignsize = size;
+  uint32_t flmap;
+  uint32_t slmap;
+  int fl;
+  int sl;
+
+  if (size >= MM_MAX_CHUNK)
+    {
+      /* Chunks this large all share one unsorted list.  These are rare
+       * and that list must be searched for the first chunk that fits.
+       */
+
+      for (node = heap->mm_nodelist[MM_TLSF_FLCOUNT - 1][0].flink;
+           node && node->size < size;
+           node = node->flink);
+
+      return node;
+    }
+
+  /* Round the size up to the next size class boundary */
+
+  if (size >= (1 << MM_TLSF_FLSHIFT))
+    {
+      size += (1 << (fls((int)size) - 1 - MM_TLSF_SLBITS)) - 1;
+    }
+
+  mm_tlsf_mapping(size, &fl, &sl);
+
+  /* Look for a non-empty list in this first level range first, then in
+   * the next larger, non-empty first level range.
+   */
+
+  slmap = heap->mm_slbitmap[fl] & (~(uint32_t)0 << sl);
+  if (slmap == 0)
+    {
+      flmap = heap->mm_flbitmap & (~(uint32_t)0 << (fl + 1));
+      if (flmap == 0)
+        {
+          /* Nothing larger is available.  Fall back to a first fit search
+           * of the list holding chunks of the requested size.
+           */
+
+          mm_tlsf_mapping(alignsize, &fl, &sl);
+          for (node = heap->mm_nodelist[fl][sl].flink;
+               node && node->size < alignsize;
+               node = node->flink);
+
+          return node;
+        }
+
+      fl    = ffs((int)flmap) - 1;
+      slmap = heap->mm_slbitmap[fl];
+    }
+
+  sl = ffs((int)slmap) - 1;
+
+  node = heap->mm_nodelist[fl][sl].flink;
+  DEBUGASSERT(node != NULL);
+  return node;
+}
+
+#endif /* CONFIG_MM_TLSF */
@@ -0,0 +1,140 @@
+/****************************************************************************
+ * mm/pool/kmm_poolalloc.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/pool.h>
+
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: kmm_pool_expand
+ *
+ * Description:
+ *   Add mp_nexpand blocks allocated from the kernel heap to the pool.
+ *
+ ****************************************************************************/
+
+static void kmm_pool_expand(FAR struct kmm_pool_s *pool)
+{
+  FAR uint8_t *blk;
+  irqstate_t flags;
+  int i;
+
+  blk = (FAR uint8_t *)kmm_malloc(pool->mp_blocksize * pool->mp_nexpand);
+  if (blk != NULL)
+    {
+      flags = spin_lock_save(&pool->mp_lock);
+      for (i = 0; i < pool->mp_nexpand; i++, blk += pool->mp_blocksize)
+        {
+          sq_addlast((FAR sq_entry_t *)blk, &pool->mp_freelist);
+        }
+
+      pool->mp_ntotal += pool->mp_nexpand;
+      spin_unlock_restore(&pool->mp_lock, flags);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: kmm_pool_alloc
+ *
+ * Description:
+ *   Allocate one block from the pool.  This may be called from interrupt
+ *   handlers but the pool will not grow when called from an interrupt
+ *   handler.
+ *
+ * Input Parameters:
+ *   pool - The pool to allocate from
+ *
+ * Returned Value:
+ *   The allocated block or NULL if the pool is exhausted.
+ *
+ ****************************************************************************/
+
+FAR void *kmm_pool_alloc(FAR struct kmm_pool_s *pool)
+{
+  FAR void *blk;
+  irqstate_t flags;
+
+  DEBUGASSERT(pool != NULL);
+
+  /* Expand the pool first if it is empty and expansion is possible.  The
+   * heap cannot be used from an interrupt handler.
+   */
+
+  if (sq_empty(&pool->mp_freelist) && pool->mp_nexpand > 0 &&
+      !up_interrupt_context())
+    {
+      kmm_pool_expand(pool);
+    }
+
+  flags = spin_lock_save(&pool->mp_lock);
+  blk   = sq_remfirst(&pool->mp_freelist);
+  if (blk != NULL)
+    {
+      pool->mp_nused++;
+      pool->mp_nalloc++;
+      if (pool->mp_nused > pool->mp_hwm)
+        {
+          pool->mp_hwm = pool->mp_nused;
+        }
+    }
+  else
+    {
+      pool->mp_nfail++;
+    }
+
+  spin_unlock_restore(&pool->mp_lock, flags);
+  return blk;
+}
+
+#endif /* CONFIG_BUILD_FLAT || __KERNEL__ */
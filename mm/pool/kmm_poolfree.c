@@ -0,0 +1,99 @@
+/****************************************************************************
+ * mm/pool/kmm_poolfree.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/mm/pool.h>
+
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: kmm_pool_free
+ *
+ * Description:
+ *   Return a block to the pool from which it was allocated.  This may be
+ *   called from interrupt handlers.
+ *
+ * Input Parameters:
+ *   pool - The pool that the block was allocated from
+ *   blk  - The block to be freed
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void kmm_pool_free(FAR struct kmm_pool_s *pool, FAR void *blk)
+{
+#ifdef CONFIG_DEBUG_FEATURES
+  FAR sq_entry_t *curr;
+#endif
+  irqstate_t flags;
+
+  DEBUGASSERT(pool != NULL && blk != NULL);
+
+  /* Recently freed blocks are reused first; they are more likely to still
+   * be in the cache.
+   */
+
+  flags = spin_lock_save(&pool->mp_lock);
+  DEBUGASSERT(pool->mp_nused > 0);
+
+#ifdef CONFIG_DEBUG_FEATURES
+  /* Check for double freed blocks */
+
+  for (curr = sq_peek(&pool->mp_freelist); curr != NULL; curr = curr->flink)
+    {
+      DEBUGASSERT(curr != (FAR sq_entry_t *)blk);
+    }
+#endif
+
+  sq_addfirst((FAR sq_entry_t *)blk, &pool->mp_freelist);
+  pool->mp_nused--;
+  spin_unlock_restore(&pool->mp_lock, flags);
+}
+
+#endif /* CONFIG_BUILD_FLAT || __KERNEL__ */
@@ -0,0 +1,101 @@
+/****************************************************************************
+ * mm/pool/kmm_poolinfo.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/mm/pool.h>
+
+#include "pool/pool.h"
+
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: kmm_pool_info
+ *
+ * Description:
+ *   Return the current state and statistics of a pool.
+ *
+ ****************************************************************************/
+
+void kmm_pool_info(FAR struct kmm_pool_s *pool,
+                   FAR struct kmm_poolinfo_s *info)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(pool != NULL && info != NULL);
+
+  flags           = spin_lock_save(&pool->mp_lock);
+  info->name      = pool->mp_name;
+  info->blocksize = pool->mp_blocksize;
+  info->ntotal    = pool->mp_ntotal;
+  info->nused     = pool->mp_nused;
+  info->hwm       = pool->mp_hwm;
+  info->nalloc    = pool->mp_nalloc;
+  info->nfail     = pool->mp_nfail;
+  spin_unlock_restore(&pool->mp_lock, flags);
+}
+
+/****************************************************************************
+ * Name: kmm_pool_foreach
+ *
+ * Description:
+ *   Call the handler for each pool that has been initialized.  Pools are
+ *   never removed from the list so the list may be traversed without
+ *   holding any lock.
+ *
+ ****************************************************************************/
+
+void kmm_pool_foreach(kmm_pool_handler_t handler, FAR void *arg)
+{
+  FAR struct kmm_pool_s *pool;
+
+  for (pool = g_kmm_pools; pool != NULL; pool = pool->mp_flink)
+    {
+      handler(pool, arg);
+    }
+}
+
+#endif /* CONFIG_BUILD_FLAT || __KERNEL__ */
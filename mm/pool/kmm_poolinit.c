@@ -0,0 +1,121 @@
+/****************************************************************************
+ * mm/pool/kmm_poolinit.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/mm/pool.h>
+
+#include "pool/pool.h"
+
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The list of all initialized pools */
+
+FAR struct kmm_pool_s *g_kmm_pools;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: kmm_pool_initialize
+ *
+ * Description:
+ *   Initialize a pool of fixed-size blocks and add it to the list of all
+ *   pools.
+ *
+ * Input Parameters:
+ *   pool      - The pool structure to be initialized
+ *   name      - The name of the pool as shown in /proc/poolinfo
+ *   blocksize - The size of each block
+ *   mem       - Memory for the initial blocks.  May be NULL.
+ *   nblocks   - The number of blocks in mem
+ *   nexpand   - The number of blocks to allocate from the kernel heap when
+ *               the pool is empty.  Zero means that the pool never grows.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void kmm_pool_initialize(FAR struct kmm_pool_s *pool, FAR const char *name,
+                         size_t blocksize, FAR void *mem, uint16_t nblocks,
+                         uint16_t nexpand)
+{
+  FAR uint8_t *blk;
+  irqstate_t flags;
+  int i;
+
+  DEBUGASSERT(pool != NULL && (mem != NULL || nblocks == 0));
+
+  memset(pool, 0, sizeof(struct kmm_pool_s));
+  pool->mp_name      = name;
+  pool->mp_blocksize = KMM_POOL_BLOCKSIZE(blocksize);
+  pool->mp_nexpand   = nexpand;
+  pool->mp_ntotal    = nblocks;
+#ifdef CONFIG_SMP
+  spin_initialize(&pool->mp_lock, SP_UNLOCKED);
+#endif
+
+  /* Put the initial blocks in the free list */
+
+  for (i = 0, blk = (FAR uint8_t *)mem;
+       i < nblocks;
+       i++, blk += pool->mp_blocksize)
+    {
+      sq_addlast((FAR sq_entry_t *)blk, &pool->mp_freelist);
+    }
+
+  /* Add the pool to the list of all pools */
+
+  flags          = enter_critical_section();
+  pool->mp_flink = g_kmm_pools;
+  g_kmm_pools    = pool;
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_BUILD_FLAT || __KERNEL__ */
@@ -261,6 +261,9 @@ void arp_out(FAR struct net_driver_s *dev)
        * the IP packet with an ARP request.
        */
 
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+      dev->d_txiob = NULL;
+#endif
       arp_format(dev, ipaddr);
       arp_dump(ARPBUF);
       return;
@@ -495,6 +495,29 @@ void devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *buf,
                     unsigned int len, unsigned int offset);
 #endif
 
+/****************************************************************************
+ * Name: devif_iob_send_nocopy
+ *
+ * Description:
+ *   Called from socket logic in response to a xmit or poll request from the
+ *   the network interface driver.
+ *
+ *   This is identical to calling devif_iob_send() except that the data is
+ *   not copied into the device buffer.  The driver, which must support
+ *   NETDEV_TXCAP_IOB, gathers the payload from the I/O buffer chain when it
+ *   transmits the packet.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+void devif_iob_send_nocopy(FAR struct net_driver_s *dev,
+                           FAR struct iob_s *buf, unsigned int len,
+                           unsigned int offset);
+#endif
+
 /****************************************************************************
  * Name: devif_pkt_send
  *
@@ -46,6 +46,7 @@
 #include <debug.h>
 #include <assert.h>
 
+#include <nuttx/mm/pool.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -58,7 +59,7 @@
  ****************************************************************************/
 
 static struct devif_callback_s g_cbprealloc[CONFIG_NET_NACTIVESOCKETS];
-static FAR struct devif_callback_s *g_cbfreelist = NULL;
+static struct kmm_pool_s g_cbpool;
 
 /****************************************************************************
  * Private Functions
@@ -68,7 +69,7 @@ static FAR struct devif_callback_s *g_cbfreelist = NULL;
  * Name: devif_callback_free
  *
  * Description:
- *   Return a callback container to the free list.
+ *   Return a callback container to the pool.
  *
  * Assumptions:
  *   This function is called with the network locked.
@@ -86,18 +87,6 @@ static void devif_callback_free(FAR struct net_driver_s *dev,
     {
       net_lock();
 
-#ifdef CONFIG_DEBUG_FEATURES
-      /* Check for double freed callbacks */
-
-      curr = g_cbfreelist;
-
-      while (curr != NULL)
-        {
-          DEBUGASSERT(cb != curr);
-          curr = curr->nxtconn;
-        }
-#endif
-
       /* Remove the callback structure from the device notification list if
        * it is supposed to be in the device notification list.
        */
@@ -154,11 +143,9 @@ static void devif_callback_free(FAR struct net_driver_s *dev,
             }
         }
 
-      /* Put the structure into the free list */
+      /* Put the structure back into the pool */
 
-      cb->nxtconn  = g_cbfreelist;
-      cb->nxtdev   = NULL;
-      g_cbfreelist = cb;
+      kmm_pool_free(&g_cbpool, cb);
       net_unlock();
     }
 }
@@ -210,7 +197,7 @@ static bool devif_event_trigger(uint16_t events, uint16_t triggers)
  * Name: devif_callback_init
  *
  * Description:
- *   Configure the pre-allocated callback structures into a free list.
+ *   Configure the pre-allocated callback structures into a pool.
  *
  * Assumptions:
  *   Called early in the initialization sequence so that no special
@@ -220,20 +207,16 @@ static bool devif_event_trigger(uint16_t events, uint16_t triggers)
 
 void devif_callback_init(void)
 {
-  int i;
-
-  for (i = 0; i < CONFIG_NET_NACTIVESOCKETS; i++)
-    {
-      g_cbprealloc[i].nxtconn = g_cbfreelist;
-      g_cbfreelist = &g_cbprealloc[i];
-    }
+  kmm_pool_initialize(&g_cbpool, "devif_callback",
+                      sizeof(struct devif_callback_s), g_cbprealloc,
+                      CONFIG_NET_NACTIVESOCKETS, 0);
 }
 
 /****************************************************************************
  * Name: devif_callback_alloc
  *
  * Description:
- *   Allocate a callback container from the free list.
+ *   Allocate a callback container from the pool.
  *
  *   If dev is non-NULL, then this function verifies that the device
  *   reference is still  valid and that the device is still UP status.  If
@@ -251,15 +234,12 @@ FAR struct devif_callback_s *
 {
   FAR struct devif_callback_s *ret;
 
-  /* Check  the head of the free list */
+  /* Allocate a callback structure from the pool */
 
   net_lock();
-  ret  = g_cbfreelist;
+  ret = (FAR struct devif_callback_s *)kmm_pool_alloc(&g_cbpool);
   if (ret)
     {
-      /* Remove the next instance from the head of the free list */
-
-      g_cbfreelist = ret->nxtconn;
       memset(ret, 0, sizeof(struct devif_callback_s));
 
       /* Add the newly allocated instance to the head of the device event
@@ -279,7 +259,7 @@ FAR struct devif_callback_s *
             {
               /* No.. release the callback structure and fail */
 
-              devif_callback_free(NULL, NULL, list);
+              kmm_pool_free(&g_cbpool, ret);
               net_unlock();
               return NULL;
             }
@@ -311,7 +291,7 @@ FAR struct devif_callback_s *
  * Name: devif_conn_callback_free
  *
  * Description:
- *   Return a connection/port callback container to the free list.
+ *   Return a connection/port callback container to the pool.
  *
  *   This function is just a front-end for devif_callback_free().  If the
  *   dev argument is non-NULL, it will verify that the device reference is
@@ -350,7 +330,7 @@ void devif_conn_callback_free(FAR struct net_driver_s *dev,
  * Name: devif_dev_callback_free
  *
  * Description:
- *   Return a device callback container to the free list.
+ *   Return a device callback container to the pool.
  *
  *   This function is just a front-end for devif_callback_free().  If the
  *   de argument is non-NULL, it will verify that the device reference is
@@ -39,6 +39,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <string.h>
 #include <assert.h>
 #include <debug.h>
@@ -84,5 +85,70 @@ void devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
 #endif
 }
 
+/****************************************************************************
+ * Name: devif_iob_send_nocopy
+ *
+ * Description:
+ *   Called from socket logic in response to a xmit or poll request from the
+ *   the network interface driver.
+ *
+ *   This is identical to calling devif_iob_send() except that the data is
+ *   not copied into the device buffer.  Rather, the driver will gather the
+ *   payload from the I/O buffer chain when the packet is transmitted.  This
+ *   may only be used if the driver supports NETDEV_TXCAP_IOB.  The I/O
+ *   buffer chain must not be modified or freed until the driver's poll
+ *   callback has returned.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+void devif_iob_send_nocopy(FAR struct net_driver_s *dev,
+                           FAR struct iob_s *iob, unsigned int len,
+                           unsigned int offset)
+{
+  DEBUGASSERT(dev != NULL && iob != NULL && len > 0 && len <= UINT16_MAX);
+  DEBUGASSERT((dev->d_txcaps & NETDEV_TXCAP_IOB) != 0);
+
+  dev->d_txiob    = iob;
+  dev->d_txoffset = offset;
+  dev->d_txlen    = len;
+  dev->d_txmss    = 0;
+  dev->d_sndlen   = len;
+}
+
+/****************************************************************************
+ * Name: devif_iob_linearize
+ *
+ * Description:
+ *   If the outgoing packet in the device buffer refers to payload in an I/O
+ *   buffer chain (see devif_iob_send_nocopy()), then copy that payload into
+ *   the device buffer following the headers so that the packet is complete
+ *   in d_buf.  This is needed by drivers (or paths like the local loopback)
+ *   that cannot gather the packet from the I/O buffer chain.
+ *
+ *   The packet must not require segmentation (d_txmss must be zero).
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void devif_iob_linearize(FAR struct net_driver_s *dev)
+{
+  if (dev->d_txiob != NULL)
+    {
+      DEBUGASSERT(dev->d_txmss == 0 && dev->d_len >= dev->d_txlen &&
+                  dev->d_len <= NETDEV_PKTSIZE(dev));
+
+      iob_copyout(&dev->d_buf[dev->d_len - dev->d_txlen], dev->d_txiob,
+                  dev->d_txlen, dev->d_txoffset);
+      dev->d_txiob = NULL;
+    }
+}
+#endif /* CONFIG_NET_TCP_SEND_ZEROCOPY */
+
 #endif /* CONFIG_MM_IOB */
 
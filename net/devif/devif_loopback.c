@@ -111,6 +111,10 @@ int devif_loopback(FAR struct net_driver_s *dev)
 
   do
     {
+      /* The input logic requires the complete packet in d_buf */
+
+      devif_iob_linearize(dev);
+
        NETDEV_TXPACKETS(dev);
        NETDEV_RXPACKETS(dev);
 
@@ -41,6 +41,7 @@
 #include <nuttx/config.h>
 #ifdef CONFIG_NET
 
+#include <stdbool.h>
 #include <debug.h>
 
 #include <nuttx/clock.h>
@@ -62,6 +63,16 @@
 #include "ipforward/ipforward.h"
 #include "sixlowpan/sixlowpan.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The maximum number of segments sent by one TCP connection per poll */
+
+#ifndef CONFIG_NET_TCP_SEND_BURST
+#  define CONFIG_NET_TCP_SEND_BURST 1
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -539,17 +550,30 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
 
   while (!bstop && (conn = tcp_nextconn(conn)))
     {
-      /* Perform the TCP TX poll */
+      int nsegs = 0;
+      bool sent;
 
-      tcp_poll(dev, conn);
+      /* Poll the same connection again for as long as it sends data, up to
+       * CONFIG_NET_TCP_SEND_BURST segments, and the driver can accept more
+       * packets.
+       */
 
-      /* Perform any necessary conversions on outgoing packets */
+      do
+        {
+          /* Perform the TCP TX poll */
 
-      devif_packet_conversion(dev, DEVIF_TCP);
+          tcp_poll(dev, conn);
 
-      /* Call back into the driver */
+          /* Perform any necessary conversions on outgoing packets */
 
-      bstop = callback(dev);
+          devif_packet_conversion(dev, DEVIF_TCP);
+          sent = (dev->d_len > 0 && dev->d_sndlen > 0);
+
+          /* Call back into the driver */
+
+          bstop = callback(dev);
+        }
+      while (!bstop && sent && ++nsegs < CONFIG_NET_TCP_SEND_BURST);
     }
 
   return bstop;
@@ -627,7 +651,7 @@ static inline int devif_poll_tcp_timer(FAR struct net_driver_s *dev,
  *
  * Assumptions:
  *   This function is called from the MAC device driver with the network
- *   locked.
+ *   locked.  It takes the device lock for the duration of the poll.
  *
  ****************************************************************************/
 
@@ -635,6 +659,10 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
 {
   int bstop = false;
 
+  /* The device buffer is used until the poll is complete */
+
+  net_devlock(dev);
+
   /* Traverse all of the active packet connections and perform the poll
    * action.
    */
@@ -743,6 +771,7 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
       /* Nothing more to do */
     }
 
+  net_devunlock(dev);
   return bstop;
 }
 
@@ -766,7 +795,7 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
  *
  * Assumptions:
  *   This function is called from the MAC device driver with the network
- *   locked.
+ *   locked.  It takes the device lock for the duration of the poll.
  *
  ****************************************************************************/
 
@@ -776,6 +805,8 @@ int devif_timer(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
   clock_t elapsed;
   int bstop = false;
 
+  net_devlock(dev);
+
   /* Get the elapsed time since the last poll in units of half seconds
    * (truncating).
    */
@@ -829,6 +860,7 @@ int devif_timer(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
       bstop = devif_poll(dev, callback);
     }
 
+  net_devunlock(dev);
   return bstop;
 }
 
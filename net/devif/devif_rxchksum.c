@@ -0,0 +1,271 @@
+/****************************************************************************
+ * net/devif/devif_rxchksum.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && (defined(CONFIG_NET_IPv4) || defined(CONFIG_NET_IPv6))
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/tcp.h>
+#include <nuttx/net/udp.h>
+
+#include "tcp/tcp.h"
+#include "udp/udp.h"
+#include "utils/utils.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define IPv4BUF ((FAR struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
+#define IPv6BUF ((FAR struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rxchksum_offset
+ *
+ * Description:
+ *   Return the offset of the checksum in the header of a transport protocol
+ *   whose checksum can be verified here, or zero if it cannot be verified.
+ *
+ ****************************************************************************/
+
+static unsigned int rxchksum_offset(uint8_t proto)
+{
+  switch (proto)
+    {
+#ifdef NET_TCP_HAVE_STACK
+      case IP_PROTO_TCP:
+        return 16;
+#endif
+
+#if defined(NET_UDP_HAVE_STACK) && defined(CONFIG_NET_UDP_CHECKSUMS)
+      case IP_PROTO_UDP:
+        return 6;
+#endif
+
+      default:
+        return 0;
+    }
+}
+
+/****************************************************************************
+ * Name: rxchksum_ipv4
+ *
+ * Description:
+ *   Verify the transport checksum of an unfragmented IPv4 packet.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static bool rxchksum_ipv4(FAR struct net_driver_s *dev)
+{
+  FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+  FAR uint8_t *upper;
+  unsigned int iphdrlen;
+  unsigned int offset;
+  uint16_t totlen;
+
+  /* Make the same checks of the header as ipv4_input() before relying on
+   * the lengths that it holds.
+   */
+
+  if (NET_LL_HDRLEN(dev) + IPv4_HDRLEN > dev->d_len ||
+      (ipv4->vhl & IP_VERSION_MASK) != IPv4_VERSION ||
+      (ipv4->vhl & IPv4_HLMASK) < 5 ||
+      (ipv4->ipoffset[0] & 0x3f) != 0 || ipv4->ipoffset[1] != 0)
+    {
+      return false;
+    }
+
+  offset   = rxchksum_offset(ipv4->proto);
+  iphdrlen = (ipv4->vhl & IPv4_HLMASK) << 2;
+  totlen   = ((uint16_t)ipv4->len[0] << 8) + ipv4->len[1];
+
+  if (offset == 0 || totlen < iphdrlen + offset + 2 ||
+      totlen > dev->d_len - NET_LL_HDRLEN(dev))
+    {
+      return false;
+    }
+
+  /* A UDP checksum of zero means that the sender did not compute one */
+
+  upper = (FAR uint8_t *)ipv4 + iphdrlen;
+  if (ipv4->proto == IP_PROTO_UDP &&
+      upper[offset] == 0 && upper[offset + 1] == 0)
+    {
+      return false;
+    }
+
+#ifdef NET_TCP_HAVE_STACK
+  if (ipv4->proto == IP_PROTO_TCP)
+    {
+      return tcp_ipv4_chksum(dev) == 0xffff;
+    }
+#endif
+
+#if defined(NET_UDP_HAVE_STACK) && defined(CONFIG_NET_UDP_CHECKSUMS)
+  if (ipv4->proto == IP_PROTO_UDP)
+    {
+      return udp_ipv4_chksum(dev) == 0xffff;
+    }
+#endif
+
+  return false;
+}
+#endif
+
+/****************************************************************************
+ * Name: rxchksum_ipv6
+ *
+ * Description:
+ *   Verify the transport checksum of an IPv6 packet without extension
+ *   headers.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+static bool rxchksum_ipv6(FAR struct net_driver_s *dev)
+{
+  FAR struct ipv6_hdr_s *ipv6 = IPv6BUF;
+  FAR uint8_t *upper;
+  unsigned int offset;
+  uint16_t paylen;
+
+  if (NET_LL_HDRLEN(dev) + IPv6_HDRLEN > dev->d_len ||
+      (ipv6->vtc & 0xf0) != IPv6_VERSION)
+    {
+      return false;
+    }
+
+  offset = rxchksum_offset(ipv6->proto);
+  paylen = ((uint16_t)ipv6->len[0] << 8) + ipv6->len[1];
+
+  if (offset == 0 || paylen < offset + 2 ||
+      paylen + IPv6_HDRLEN > dev->d_len - NET_LL_HDRLEN(dev))
+    {
+      return false;
+    }
+
+  upper = (FAR uint8_t *)ipv6 + IPv6_HDRLEN;
+  if (ipv6->proto == IP_PROTO_UDP &&
+      upper[offset] == 0 && upper[offset + 1] == 0)
+    {
+      return false;
+    }
+
+#ifdef NET_TCP_HAVE_STACK
+  if (ipv6->proto == IP_PROTO_TCP)
+    {
+      return tcp_ipv6_chksum(dev) == 0xffff;
+    }
+#endif
+
+#if defined(NET_UDP_HAVE_STACK) && defined(CONFIG_NET_UDP_CHECKSUMS)
+  if (ipv6->proto == IP_PROTO_UDP)
+    {
+      return udp_ipv6_chksum(dev) == 0xffff;
+    }
+#endif
+
+  return false;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_rxchksum
+ *
+ * Description:
+ *   Verify the TCP or UDP checksum of the IPv4 or IPv6 packet that the
+ *   driver has received into d_buf and, if it is good, set d_rxchksum so
+ *   that ipv4_input() or ipv6_input() do not compute it again.
+ *
+ * Input Parameters:
+ *   dev - The device holding the received packet in d_buf and d_len
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The device is locked.  The network need not be locked.
+ *
+ ****************************************************************************/
+
+void devif_rxchksum(FAR struct net_driver_s *dev)
+{
+  FAR uint8_t *ip = &dev->d_buf[NET_LL_HDRLEN(dev)];
+
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+  /* The received packet does not refer to any I/O buffer chain */
+
+  dev->d_txiob = NULL;
+#endif
+
+  dev->d_rxchksum = false;
+  if (dev->d_len <= NET_LL_HDRLEN(dev))
+    {
+      return;
+    }
+
+#ifdef CONFIG_NET_IPv4
+  if ((ip[0] & IP_VERSION_MASK) == IPv4_VERSION)
+    {
+      dev->d_rxchksum = rxchksum_ipv4(dev);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if ((ip[0] & 0xf0) == IPv6_VERSION)
+    {
+      dev->d_rxchksum = rxchksum_ipv6(dev);
+    }
+#endif
+}
+
+#endif /* CONFIG_NET && (CONFIG_NET_IPv4 || CONFIG_NET_IPv6) */
@@ -311,24 +311,15 @@ nullreturn:
 #endif /* CONFIG_NET_IPv4_REASSEMBLY */
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: ipv4_input
+ * Name: ipv4_in
  *
  * Description:
- *
- * Returned Value:
- *   OK    - The packet was processed (or dropped) and can be discarded.
- *   ERROR - Hold the packet and try again later.  There is a listening
- *           socket but no receive in place to catch the packet yet.  The
- *           device's d_len will be set to zero in this case as there is
- *           no outgoing data.
+ *   Process an incoming IPv4 packet with the device locked.  See
+ *   ipv4_input().
  *
  ****************************************************************************/
 
-int ipv4_input(FAR struct net_driver_s *dev)
+static int ipv4_in(FAR struct net_driver_s *dev)
 {
   FAR struct ipv4_hdr_s *ipv4 = BUF;
   in_addr_t destipaddr;
@@ -337,6 +328,12 @@ int ipv4_input(FAR struct net_driver_s *dev)
 
   /* This is where the input processing starts. */
 
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+  /* The incoming packet does not refer to any I/O buffer chain */
+
+  dev->d_txiob = NULL;
+#endif
+
 #ifdef CONFIG_NET_STATISTICS
   g_netstats.ipv4.recv++;
 #endif
@@ -591,4 +588,41 @@ drop:
   dev->d_len = 0;
   return OK;
 }
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipv4_input
+ *
+ * Description:
+ *   Receive an IPv4 packet from the network device.  The device is locked
+ *   while the packet is processed.
+ *
+ * Returned Value:
+ *   OK    - The packet was processed (or dropped) and can be discarded.
+ *   ERROR - Hold the packet and try again later.  There is a listening
+ *           socket but no receive in place to catch the packet yet.  The
+ *           device's d_len will be set to zero in this case as there is
+ *           no outgoing data.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int ipv4_input(FAR struct net_driver_s *dev)
+{
+  int ret;
+
+  net_devlock(dev);
+  ret = ipv4_in(dev);
+
+  /* Any checksum verified in advance was for this packet only */
+
+  dev->d_rxchksum = false;
+  net_devunlock(dev);
+  return ret;
+}
 #endif /* CONFIG_NET_IPv4 */
@@ -242,36 +242,15 @@ static bool check_destipaddr(FAR struct net_driver_s *dev,
 }
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: ipv6_input
+ * Name: ipv6_in
  *
  * Description:
- *   Receive an IPv6 packet from the network device.  Verify and forward to
- *   L3 packet handling logic if the packet is destined for us.
- *
- * Input Parameters:
- *   dev   - The device on which the packet was received and which contains
- *           the IPv6 packet.
- * Returned Value:
- *   OK    - The packet was processed (or dropped) and can be discarded.
- *   ERROR - Hold the packet and try again later.  There is a listening
- *           socket but no receive in place to catch the packet yet.  The
- *           device's d_len will be set to zero in this case as there is
- *           no outgoing data.
- *
- *   If this function returns to the network driver with dev->d_len > 0,
- *   that is an indication to the driver that there is an outgoing response
- *   to this input.
- *
- * Assumptions:
- *   The network is locked.
+ *   Process an incoming IPv6 packet with the device locked.  See
+ *   ipv6_input().
  *
  ****************************************************************************/
 
-int ipv6_input(FAR struct net_driver_s *dev)
+static int ipv6_in(FAR struct net_driver_s *dev)
 {
   FAR struct ipv6_hdr_s *ipv6 = IPv6BUF;
   FAR uint8_t *payload;
@@ -285,6 +264,12 @@ int ipv6_input(FAR struct net_driver_s *dev)
 
   /* This is where the input processing starts. */
 
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+  /* The incoming packet does not refer to any I/O buffer chain */
+
+  dev->d_txiob = NULL;
+#endif
+
 #ifdef CONFIG_NET_STATISTICS
   g_netstats.ipv6.recv++;
 #endif
@@ -571,4 +556,49 @@ drop:
   dev->d_len = 0;
   return OK;
 }
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipv6_input
+ *
+ * Description:
+ *   Receive an IPv6 packet from the network device.  Verify and forward to
+ *   L3 packet handling logic if the packet is destined for us.  The device
+ *   is locked while the packet is processed.
+ *
+ * Input Parameters:
+ *   dev   - The device on which the packet was received and which contains
+ *           the IPv6 packet.
+ * Returned Value:
+ *   OK    - The packet was processed (or dropped) and can be discarded.
+ *   ERROR - Hold the packet and try again later.  There is a listening
+ *           socket but no receive in place to catch the packet yet.  The
+ *           device's d_len will be set to zero in this case as there is
+ *           no outgoing data.
+ *
+ *   If this function returns to the network driver with dev->d_len > 0,
+ *   that is an indication to the driver that there is an outgoing response
+ *   to this input.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int ipv6_input(FAR struct net_driver_s *dev)
+{
+  int ret;
+
+  net_devlock(dev);
+  ret = ipv6_in(dev);
+
+  /* Any checksum verified in advance was for this packet only */
+
+  dev->d_rxchksum = false;
+  net_devunlock(dev);
+  return ret;
+}
 #endif /* CONFIG_NET_IPv6 */
@@ -70,6 +70,7 @@
 #include "socket/socket.h"
 #include "usrsock/usrsock.h"
 #include "inet/inet.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -202,7 +203,9 @@ static size_t inet_recvfrom_newdata(FAR struct net_driver_s *dev,
  *   pstate   recvfrom state structure
  *
  * Returned Value:
- *   None.
+ *   true if the data was consumed.  false if the part of the packet that
+ *   does not fit into the user buffer could not be buffered.  Nothing has
+ *   been taken from the packet then, and it must not be ACKed.
  *
  * Assumptions:
  *   The network is locked.
@@ -210,56 +213,42 @@ static size_t inet_recvfrom_newdata(FAR struct net_driver_s *dev,
  ****************************************************************************/
 
 #ifdef NET_TCP_HAVE_STACK
-static inline void inet_tcp_newdata(FAR struct net_driver_s *dev,
+static inline bool inet_tcp_newdata(FAR struct net_driver_s *dev,
                                     FAR struct inet_recvfrom_s *pstate)
 {
-  /* Take as much data from the packet as we can */
-
-  size_t recvlen = inet_recvfrom_newdata(dev, pstate);
-
-  /* If there is more data left in the packet that we could not buffer, then
-   * add it to the read-ahead buffers.
+  /* If there is more data in the packet than we can take, then add the rest
+   * to the read-ahead buffers first.  That may fail, for example if another
+   * thread is reading from the read-ahead buffers.  The packet is then left
+   * alone, so that it is not ACKed and the peer will send it again.
+   * Otherwise, the bytes that did not fit would be ACKed but lost.
    */
 
-  if (recvlen < dev->d_len)
+  if (dev->d_len > pstate->ir_buflen)
     {
 #ifdef CONFIG_NET_TCP_READAHEAD
       FAR struct tcp_conn_s *conn = (FAR struct tcp_conn_s *)pstate->ir_sock->s_conn;
-      FAR uint8_t *buffer = (FAR uint8_t *)dev->d_appdata + recvlen;
-      uint16_t buflen = dev->d_len - recvlen;
-#ifdef CONFIG_DEBUG_NET
-      uint16_t nsaved;
+      FAR uint8_t *buffer = (FAR uint8_t *)dev->d_appdata + pstate->ir_buflen;
+      uint16_t buflen = dev->d_len - pstate->ir_buflen;
 
-      nsaved = tcp_datahandler(conn, buffer, buflen);
-#else
-      (void)tcp_datahandler(conn, buffer, buflen);
-#endif
-
-      /* There are complicated buffering issues that are not addressed fully
-       * here.  For example, what if up_datahandler() cannot buffer the
-       * remainder of the packet?  In that case, the data will be dropped but
-       * still ACKed.  Therefore it would not be resent.
-       *
-       * This is probably not an issue here because we only get here if the
-       * read-ahead buffers are empty and there would have to be something
-       * serioulsy wrong with the configuration not to be able to buffer a
-       * partial packet in this context.
-       */
-
-#ifdef CONFIG_DEBUG_NET
-      if (nsaved < buflen)
+      if (tcp_datahandler(conn, buffer, buflen) < buflen)
         {
-          nerr("ERROR: packet data not saved (%d bytes)\n", buflen - nsaved);
+          ninfo("Packet not consumed (%d bytes)\n", dev->d_len);
+          return false;
         }
-#endif
 #else
-      nerr("ERROR: packet data lost (%d bytes)\n", dev->d_len - recvlen);
+      nerr("ERROR: packet data lost (%d bytes)\n",
+           dev->d_len - pstate->ir_buflen);
 #endif
     }
 
+  /* Take as much data from the packet as we can */
+
+  (void)inet_recvfrom_newdata(dev, pstate);
+
   /* Indicate no data in the buffer */
 
   dev->d_len = 0;
+  return true;
 }
 #endif /* NET_TCP_HAVE_STACK */
 
@@ -308,7 +297,10 @@ static inline void inet_udp_newdata(FAR struct net_driver_s *dev,
  *   None
  *
  * Assumptions:
- *   The network is locked.
+ *   The network may or may not be locked.  The read-ahead lock is only
+ *   held to peek at or modify the read-ahead queue; the data is copied to
+ *   the user buffer without it so that the device path never has to drop
+ *   a packet because of a slow reader.
  *
  ****************************************************************************/
 
@@ -320,16 +312,26 @@ static inline void inet_tcp_readahead(struct inet_recvfrom_s *pstate)
   int recvlen;
 
   /* Check there is any TCP data already buffered in a read-ahead
-   * buffer.
+   * buffer.  Only one reader at a time may consume the head of the queue.
    */
 
-  while ((iob = iob_peek_queue(&conn->readahead)) != NULL &&
-          pstate->ir_buflen > 0)
+  net_connlock(&conn->rcvlock);
+  while (pstate->ir_buflen > 0)
     {
+      net_connlock(&conn->rdlock);
+      iob = iob_peek_queue(&conn->readahead);
+      net_connunlock(&conn->rdlock);
+
+      if (iob == NULL)
+        {
+          break;
+        }
+
       DEBUGASSERT(iob->io_pktlen > 0);
 
       /* Transfer that buffered data from the I/O buffer chain into
-       * the user buffer.
+       * the user buffer.  The chain at the head of the queue is not
+       * modified by the device path.
        */
 
       recvlen = iob_copyout(pstate->ir_buffer, iob, pstate->ir_buflen, 0);
@@ -345,6 +347,7 @@ static inline void inet_tcp_readahead(struct inet_recvfrom_s *pstate)
        * beginning of the I/O buffer chain.
        */
 
+      net_connlock(&conn->rdlock);
       if (recvlen >= iob->io_pktlen)
         {
           FAR struct iob_s *tmp;
@@ -356,6 +359,7 @@ static inline void inet_tcp_readahead(struct inet_recvfrom_s *pstate)
           tmp = iob_remove_queue(&conn->readahead);
           DEBUGASSERT(tmp == iob);
           UNUSED(tmp);
+          net_connunlock(&conn->rdlock);
 
           /* And free the I/O buffer chain */
 
@@ -370,8 +374,11 @@ static inline void inet_tcp_readahead(struct inet_recvfrom_s *pstate)
 
           (void)iob_trimhead_queue(&conn->readahead, recvlen,
                                    IOBUSER_NET_TCP_READAHEAD);
+          net_connunlock(&conn->rdlock);
         }
     }
+
+  net_connunlock(&conn->rcvlock);
 }
 #endif /* NET_TCP_HAVE_STACK && CONFIG_NET_TCP_READAHEAD */
 
@@ -384,14 +391,18 @@ static inline void inet_udp_readahead(struct inet_recvfrom_s *pstate)
   int recvlen;
 
   /* Check there is any UDP datagram already buffered in a read-ahead
-   * buffer.
+   * buffer.  The datagram is removed from the queue before it is copied
+   * out; any part that does not fit in the user buffer is discarded.
    */
 
   pstate->ir_recvlen = -1;
 
-  if ((iob = iob_peek_queue(&conn->readahead)) != NULL)
+  net_connlock(&conn->rdlock);
+  iob = iob_remove_queue(&conn->readahead);
+  net_connunlock(&conn->rdlock);
+
+  if (iob != NULL)
     {
-      FAR struct iob_s *tmp;
       uint8_t src_addr_size;
 
       DEBUGASSERT(iob->io_pktlen > 0);
@@ -448,14 +459,6 @@ static inline void inet_udp_readahead(struct inet_recvfrom_s *pstate)
         }
 
 out:
-      /* Remove the I/O buffer chain from the head of the read-ahead
-       * buffer queue.
-       */
-
-      tmp = iob_remove_queue(&conn->readahead);
-      DEBUGASSERT(tmp == iob);
-      UNUSED(tmp);
-
       /* And free the I/O buffer chain */
 
       (void)iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
@@ -660,10 +663,14 @@ static uint16_t inet_tcp_eventhandler(FAR struct net_driver_s *dev,
       if ((flags & TCP_NEWDATA) != 0)
         {
           /* Copy the data from the packet (saving any unused bytes from the
-           * packet in the read-ahead buffer).
+           * packet in the read-ahead buffer).  If that is not possible,
+           * drop the packet without an ACK.
            */
 
-          inet_tcp_newdata(dev, pstate);
+          if (!inet_tcp_newdata(dev, pstate))
+            {
+              return flags & ~(TCP_NEWDATA | TCP_SNDACK);
+            }
 
           /* Save the sender's address in the caller's 'from' location */
 
@@ -1179,6 +1186,7 @@ static ssize_t inet_recvfrom_result(int result, struct inet_recvfrom_s *pstate)
  *   psock  Pointer to the socket structure for the SOCK_DRAM socket
  *   buf    Buffer to receive data
  *   len    Length of buffer
+ *   flags  Receive flags (only MSG_DONTWAIT is used)
  *   from   INET address of source (may be NULL)
  *
  * Returned Value:
@@ -1191,7 +1199,8 @@ static ssize_t inet_recvfrom_result(int result, struct inet_recvfrom_s *pstate)
 
 #ifdef NET_UDP_HAVE_STACK
 static ssize_t inet_udp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
-                                 FAR struct sockaddr *from, FAR socklen_t *fromlen)
+                                 int flags, FAR struct sockaddr *from,
+                                 FAR socklen_t *fromlen)
 {
   FAR struct udp_conn_s *conn = (FAR struct udp_conn_s *)psock->s_conn;
   FAR struct net_driver_s *dev;
@@ -1200,17 +1209,30 @@ static ssize_t inet_udp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
 
   /* Perform the UDP recvfrom() operation */
 
-  /* Initialize the state structure.  This is done with the network locked
-   * because we don't want anything to happen until we are ready.
+  /* Initialize the state structure.  Nothing can happen until the
+   * callback is set up below with the network locked.
    */
 
-  net_lock();
   inet_recvfrom_initialize(psock, buf, len, from, fromlen, &state);
 
 #ifdef CONFIG_NET_UDP_READAHEAD
-  /* Copy the read-ahead data from the packet */
+  /* Copy the read-ahead data from the packet.  This is done before the
+   * network is locked so that the copy does not hold off the processing
+   * of other connections and devices.
+   */
 
   inet_udp_readahead(&state);
+#endif
+
+  net_lock();
+
+#ifdef CONFIG_NET_UDP_READAHEAD
+  /* A datagram may have been buffered before the network was locked */
+
+  if (state.ir_recvlen < 0)
+    {
+      inet_udp_readahead(&state);
+    }
 
   /* The default return value is the number of bytes that we just copied
    * into the user buffer.  We will return this if the socket has become
@@ -1229,9 +1251,9 @@ static ssize_t inet_udp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
 #endif
 
 #ifdef CONFIG_NET_UDP_READAHEAD
-  /* Handle non-blocking UDP sockets */
+  /* Handle non-blocking UDP sockets and MSG_DONTWAIT */
 
-  if (_SS_ISNONBLOCK(psock->s_flags))
+  if (_SS_ISNONBLOCK(psock->s_flags) || (flags & MSG_DONTWAIT) != 0)
     {
       /* Return the number of bytes read from the read-ahead buffer if
        * something was received (already in 'ret'); EAGAIN if not.
@@ -1307,6 +1329,7 @@ static ssize_t inet_udp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
  *   psock  Pointer to the socket structure for the SOCK_DRAM socket
  *   buf    Buffer to receive data
  *   len    Length of buffer
+ *   flags  Receive flags (only MSG_DONTWAIT is used)
  *   from   INET address of source (may be NULL)
  *
  * Returned Value:
@@ -1319,25 +1342,39 @@ static ssize_t inet_udp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
 
 #ifdef NET_TCP_HAVE_STACK
 static ssize_t inet_tcp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
-                                 FAR struct sockaddr *from, FAR socklen_t *fromlen)
+                                 int flags, FAR struct sockaddr *from,
+                                 FAR socklen_t *fromlen)
 {
   struct inet_recvfrom_s state;
   int               ret;
 
-  /* Initialize the state structure.  This is done with the network locked
-   * because we don't want anything to happen until we are ready.
+  /* Initialize the state structure.  Nothing can happen until the
+   * callback is set up below with the network locked.
    */
 
-  net_lock();
   inet_recvfrom_initialize(psock, buf, len, from, fromlen, &state);
 
   /* Handle any any TCP data already buffered in a read-ahead buffer.  NOTE
    * that there may be read-ahead data to be retrieved even after the
    * socket has been disconnected.
+   *
+   * This is done before the network is locked so that copying the data
+   * does not hold off the processing of other connections and devices.
    */
 
 #ifdef CONFIG_NET_TCP_READAHEAD
   inet_tcp_readahead(&state);
+#endif
+
+  net_lock();
+
+#ifdef CONFIG_NET_TCP_READAHEAD
+  /* More data may have been buffered before the network was locked */
+
+  if (state.ir_buflen > 0)
+    {
+      inet_tcp_readahead(&state);
+    }
 
   /* The default return value is the number of bytes that we just copied
    * into the user buffer.  We will return this if the socket has become
@@ -1393,7 +1430,7 @@ static ssize_t inet_tcp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
 
   else
 #ifdef CONFIG_NET_TCP_READAHEAD
-  if (_SS_ISNONBLOCK(psock->s_flags))
+  if (_SS_ISNONBLOCK(psock->s_flags) || (flags & MSG_DONTWAIT) != 0)
     {
       /* Return the number of bytes read from the read-ahead buffer if
        * something was received (already in 'ret'); EAGAIN if not.
@@ -1560,7 +1597,7 @@ ssize_t inet_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
     case SOCK_STREAM:
       {
 #ifdef NET_TCP_HAVE_STACK
-        ret = inet_tcp_recvfrom(psock, buf, len, from, fromlen);
+        ret = inet_tcp_recvfrom(psock, buf, len, flags, from, fromlen);
 #else
         ret = -ENOSYS;
 #endif
@@ -1572,7 +1609,7 @@ ssize_t inet_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
     case SOCK_DGRAM:
       {
 #ifdef NET_UDP_HAVE_STACK
-        ret = inet_udp_recvfrom(psock, buf, len, from, fromlen);
+        ret = inet_udp_recvfrom(psock, buf, len, flags, from, fromlen);
 #else
         ret = -ENOSYS;
 #endif
@@ -58,6 +58,20 @@
 
 #ifdef HAVE_INET_SOCKETS
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* UDP datagrams can be gathered directly from the sendmsg() I/O vectors
+ * into write buffers.  Otherwise, sendmsg() falls back to gathering the
+ * data into a temporary buffer and calling sendto().
+ */
+
+#if defined(NET_UDP_HAVE_STACK) && defined(CONFIG_NET_UDP_WRITE_BUFFERS) && \
+   !defined(CONFIG_NET_6LOWPAN)
+#  define HAVE_INET_SENDMSG 1
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -90,6 +104,10 @@ static ssize_t    inet_sendto(FAR struct socket *psock, FAR const void *buf,
 static ssize_t    inet_sendfile(FAR struct socket *psock, FAR struct file *infile,
                     FAR off_t *offset, size_t count);
 #endif
+#ifdef HAVE_INET_SENDMSG
+static ssize_t    inet_sendmsg(FAR struct socket *psock,
+                    FAR struct msghdr *msg, int flags);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -113,7 +131,15 @@ static const struct sock_intf_s g_inet_sockif =
   inet_sendfile,    /* si_sendfile */
 #endif
   inet_recvfrom,    /* si_recvfrom */
-  inet_close        /* si_close */
+  inet_close,       /* si_close */
+#ifdef CONFIG_NET_USRSOCK
+  NULL,             /* si_ioctl */
+#endif
+#ifdef HAVE_INET_SENDMSG
+  inet_sendmsg      /* si_sendmsg */
+#else
+  NULL              /* si_sendmsg */
+#endif
 };
 
 /****************************************************************************
@@ -1252,6 +1278,74 @@ static ssize_t inet_sendto(FAR struct socket *psock, FAR const void *buf,
   return nsent;
 }
 
+/****************************************************************************
+ * Name: inet_sendmsg
+ *
+ * Description:
+ *   Send a UDP datagram gathered from the I/O vectors of msg.  The data is
+ *   copied directly from the user buffers into the I/O buffer chain that
+ *   is passed to the network device.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msg      The message to send
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On  error, a negated
+ *   errno value is returned (see sendto() for the list of appropriate error
+ *   values.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_INET_SENDMSG
+static ssize_t inet_sendmsg(FAR struct socket *psock,
+                            FAR struct msghdr *msg, int flags)
+{
+  FAR const struct sockaddr *to = (FAR const struct sockaddr *)msg->msg_name;
+  socklen_t minlen;
+
+  if (psock->s_type != SOCK_DGRAM)
+    {
+      nerr("ERROR: Unsupported socket type: %d\n", psock->s_type);
+      return -EOPNOTSUPP;
+    }
+
+  /* Verify that a valid address has been provided */
+
+  if (to != NULL && msg->msg_namelen > 0)
+    {
+      switch (to->sa_family)
+        {
+#ifdef CONFIG_NET_IPv4
+        case AF_INET:
+          minlen = sizeof(struct sockaddr_in);
+          break;
+#endif
+
+#ifdef CONFIG_NET_IPv6
+        case AF_INET6:
+          minlen = sizeof(struct sockaddr_in6);
+          break;
+#endif
+
+        default:
+          nerr("ERROR: Unrecognized address family: %d\n", to->sa_family);
+          return -EAFNOSUPPORT;
+        }
+
+      if (msg->msg_namelen < minlen)
+        {
+          nerr("ERROR: Invalid address length: %d < %d\n",
+               msg->msg_namelen, minlen);
+          return -EBADF;
+        }
+    }
+
+  return psock_udp_sendmsg(psock, msg, flags);
+}
+#endif
+
 /****************************************************************************
  * Name: inet_sendfile
  *
@@ -152,8 +152,8 @@ static int ipv4_hdrsize(FAR struct ipv4_hdr_s *ipv4)
 
 static int ipv4_decr_ttl(FAR struct ipv4_hdr_s *ipv4)
 {
-  uint16_t iphdrlen;
-  uint16_t sum;
+  uint16_t oldword;
+  uint16_t newword;
   int ttl;
 
   /* Check time-to-live (TTL) */
@@ -172,31 +172,20 @@ static int ipv4_decr_ttl(FAR struct ipv4_hdr_s *ipv4)
       return 0;
     }
 
-  /* Save the updated TTL value */
-
-  ipv4->ttl = ttl;
-
-  /* Get the IP header length (accounting for possible options). */
-
-  iphdrlen = (ipv4->vhl & IPv4_HLMASK) << 2;
-
-  /* Re-calculate the IPv4 checksum.  This checksum is the Internet checksum
-   * of the 20 bytes of the IPv4 header.  This checksum will be different
-   * because we just modify the IPv4 TTL.
+  /* Update the IPv4 checksum incrementally (RFC 1624) rather than summing
+   * the whole header again.  Only the 16-bit word holding the TTL and the
+   * protocol has changed.  The header checksum and this word are both held
+   * in network order.
    */
 
-  ipv4->ipchksum = 0;
-  sum            = chksum(0, (FAR const uint8_t *)ipv4, iphdrlen);
-  if (sum == 0)
-    {
-      sum = 0xffff;
-    }
-  else
-    {
-      sum = htons(sum);
-    }
+  oldword        = ((uint16_t)ipv4->ttl << 8) | ipv4->proto;
+  newword        = ((uint16_t)ttl << 8) | ipv4->proto;
+  ipv4->ipchksum = net_chksum_adjust(ipv4->ipchksum, htons(oldword),
+                                     htons(newword));
+
+  /* Save the updated TTL value */
 
-  ipv4->ipchksum = ~sum;
+  ipv4->ttl = ttl;
   return ttl;
 }
 
@@ -129,6 +129,26 @@ errout:
 }
 #endif
 
+/****************************************************************************
+ * Name: local_shadow_notify
+ *
+ * Description:
+ *   Forward events reported on one of the shadow poll structures used for
+ *   (POLLIN | POLLOUT) polls to the caller's poll structure.  This is only
+ *   needed when the caller has a notification callback; otherwise the
+ *   shadow structures simply post the caller's semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_STREAM
+static void local_shadow_notify(FAR struct pollfd *shadowfds)
+{
+  FAR struct pollfd *fds = (FAR struct pollfd *)shadowfds->arg;
+
+  poll_notify(&fds, 1, shadowfds->revents);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -152,7 +172,7 @@ void local_accept_pollnotify(FAR struct local_conn_s *conn,
           if (fds->revents != 0)
             {
               ninfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(&fds, 1, 0);
             }
         }
     }
@@ -226,10 +246,14 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
           shadowfds[0].fd     = 0; /* Does not matter */
           shadowfds[0].sem    = fds->sem;
           shadowfds[0].events = fds->events & ~POLLOUT;
+          shadowfds[0].cb     = fds->cb != NULL ? local_shadow_notify : NULL;
+          shadowfds[0].arg    = fds;
 
           shadowfds[1].fd     = 1; /* Does not matter */
           shadowfds[1].sem    = fds->sem;
           shadowfds[1].events = fds->events & ~POLLIN;
+          shadowfds[1].cb     = shadowfds[0].cb;
+          shadowfds[1].arg    = fds;
 
           /* Setup poll for both shadow pollfds. */
 
@@ -294,8 +318,7 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
   return ret;
 
 pollerr:
-  fds->revents |= POLLERR;
-  nxsem_post(fds->sem);
+  poll_notify(&fds, 1, POLLERR);
   return OK;
 }
 
@@ -185,6 +185,9 @@ void neighbor_ethernet_out(FAR struct net_driver_s *dev)
            * message.
            */
 
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+          dev->d_txiob = NULL;
+#endif
           icmpv6_solicit(dev, ipaddr);
         }
     }
@@ -50,6 +50,7 @@
 
 #include <net/if.h>
 #include <net/ethernet.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ethernet.h>
@@ -343,6 +344,13 @@ int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
       dev->d_conncb = NULL;
       dev->d_devcb = NULL;
 
+      /* Nobody holds the device lock yet */
+
+      nxsem_init(&dev->d_lock, 0, 1);
+      dev->d_lockholder = (pid_t)-1;
+      dev->d_lockcount  = 0;
+      dev->d_rxchksum   = false;
+
       /* We need exclusive access for the following operations */
 
       net_lock();
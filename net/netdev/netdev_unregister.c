@@ -49,6 +49,7 @@
 
 #include <net/if.h>
 #include <net/ethernet.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/net/netdev.h>
 
 #include "utils/utils.h"
@@ -166,6 +167,8 @@ int netdev_unregister(FAR struct net_driver_s *dev)
 #endif
       net_unlock();
 
+      nxsem_destroy(&dev->d_lock);
+
 #ifdef CONFIG_NET_ETHERNET
       ninfo("Unregistered MAC: %02x:%02x:%02x:%02x:%02x:%02x as dev: %s\n",
             dev->d_mac.ether.ether_addr_octet[0],
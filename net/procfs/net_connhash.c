@@ -0,0 +1,192 @@
+/****************************************************************************
+ * net/procfs/net_connhash.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Output format:
+ *
+ *   Table       Buckets Used Entries MaxChain
+ *   TCP active     xxxx xxxx    xxxx     xxxx
+ *   TCP listen     xxxx xxxx    xxxx     xxxx
+ *   UDP            xxxx xxxx    xxxx     xxxx
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <debug.h>
+
+#include "tcp/tcp.h"
+#include "udp/udp.h"
+#include "utils/utils.h"
+#include "procfs/procfs.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_NET) && \
+    defined(NETPROCFS_HAVE_CONNHASH)
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* Line generating functions */
+
+static int netprocfs_connhash_header(FAR struct netprocfs_file_s *netfile);
+#ifdef CONFIG_NET_TCP_CONNHASH
+static int netprocfs_connhash_tcp(FAR struct netprocfs_file_s *netfile);
+static int netprocfs_connhash_listen(FAR struct netprocfs_file_s *netfile);
+#endif
+#ifdef CONFIG_NET_UDP_CONNHASH
+static int netprocfs_connhash_udp(FAR struct netprocfs_file_s *netfile);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Line generating functions */
+
+static const linegen_t g_connhash_linegen[] =
+{
+  netprocfs_connhash_header
+#ifdef CONFIG_NET_TCP_CONNHASH
+  , netprocfs_connhash_tcp
+  , netprocfs_connhash_listen
+#endif
+#ifdef CONFIG_NET_UDP_CONNHASH
+  , netprocfs_connhash_udp
+#endif
+};
+
+#define NHASH_LINES (sizeof(g_connhash_linegen) / sizeof(linegen_t))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_connhash_line
+ ****************************************************************************/
+
+static int netprocfs_connhash_line(FAR struct netprocfs_file_s *netfile,
+                                   FAR const char *name,
+                                   FAR const struct net_hashstat_s *stats)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "%-11s %7u %4u %7u %8u\n", name,
+                  stats->nbuckets, stats->nused, stats->nentries,
+                  stats->maxchain);
+}
+
+/****************************************************************************
+ * Name: netprocfs_connhash_header
+ ****************************************************************************/
+
+static int netprocfs_connhash_header(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "Table       Buckets Used Entries MaxChain\n");
+}
+
+/****************************************************************************
+ * Name: netprocfs_connhash_tcp and netprocfs_connhash_listen
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONNHASH
+static int netprocfs_connhash_tcp(FAR struct netprocfs_file_s *netfile)
+{
+  struct net_hashstat_s stats;
+
+  tcp_hashstats(&stats);
+  return netprocfs_connhash_line(netfile, "TCP active", &stats);
+}
+
+static int netprocfs_connhash_listen(FAR struct netprocfs_file_s *netfile)
+{
+  struct net_hashstat_s stats;
+
+  tcp_listen_hashstats(&stats);
+  return netprocfs_connhash_line(netfile, "TCP listen", &stats);
+}
+#endif
+
+/****************************************************************************
+ * Name: netprocfs_connhash_udp
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_CONNHASH
+static int netprocfs_connhash_udp(FAR struct netprocfs_file_s *netfile)
+{
+  struct net_hashstat_s stats;
+
+  udp_hashstats(&stats);
+  return netprocfs_connhash_line(netfile, "UDP", &stats);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_read_connhash
+ *
+ * Description:
+ *   Read and format connection hash table statistics.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which network status will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+ssize_t netprocfs_read_connhash(FAR struct netprocfs_file_s *priv,
+                                FAR char *buffer, size_t buflen)
+{
+  return netprocfs_read_linegen(priv, buffer, buflen, g_connhash_linegen,
+                                NHASH_LINES);
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_NET && NETPROCFS_HAVE_CONNHASH */
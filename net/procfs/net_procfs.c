@@ -85,9 +85,16 @@
 
 #ifdef CONFIG_NET_ROUTE
 #  define ROUTE_INDEX    _ROUTE_INDEX
-#  define DEV_INDEX      (_ROUTE_INDEX + 1)
+#  define _HASH_INDEX    (_ROUTE_INDEX + 1)
 #else
-#  define DEV_INDEX      _ROUTE_INDEX
+#  define _HASH_INDEX    _ROUTE_INDEX
+#endif
+
+#ifdef NETPROCFS_HAVE_CONNHASH
+#  define HASH_INDEX     _HASH_INDEX
+#  define DEV_INDEX      (_HASH_INDEX + 1)
+#else
+#  define DEV_INDEX      _HASH_INDEX
 #endif
 
 /****************************************************************************
@@ -206,6 +213,19 @@ static int netprocfs_open(FAR struct file *filep, FAR const char *relpath,
     }
   else
 #endif
+
+#ifdef NETPROCFS_HAVE_CONNHASH
+  /* "net/connhash" is an acceptable value for the relpath only if a
+   * connection hash table is enabled.
+   */
+
+  if (strcmp(relpath, "net/connhash") == 0)
+    {
+      entry = NETPROCFS_SUBDIR_CONNHASH;
+      dev   = NULL;
+    }
+  else
+#endif
     {
       FAR char *devname;
       FAR char *copy;
@@ -323,6 +343,15 @@ static ssize_t netprocfs_read(FAR struct file *filep, FAR char *buffer,
 #endif
 #endif
 
+#ifdef NETPROCFS_HAVE_CONNHASH
+      case NETPROCFS_SUBDIR_CONNHASH:
+
+        /* Show the connection hash table statistics */
+
+        nreturned = netprocfs_read_connhash(priv, buffer, buflen);
+        break;
+#endif
+
 #ifdef CONFIG_NET_ROUTE
       case NETPROCFS_SUBDIR_ROUTE:
         nerr("ERROR: Cannot read from directory net/route\n");
@@ -446,6 +475,9 @@ static int netprocfs_opendir(FAR const char *relpath,
 #endif
 #ifdef CONFIG_NET_ROUTE
       level1->base.nentries++;
+#endif
+#ifdef NETPROCFS_HAVE_CONNHASH
+      level1->base.nentries++;
 #endif
     }
   else
@@ -559,6 +591,16 @@ static int netprocfs_readdir(FAR struct fs_dirent_s *dir)
           strncpy(dir->fd_dir.d_name, "route", NAME_MAX + 1);
         }
       else
+#endif
+#ifdef NETPROCFS_HAVE_CONNHASH
+      if (index == HASH_INDEX)
+        {
+          /* Copy the connection hash statistics file entry */
+
+          dir->fd_dir.d_type = DTYPE_FILE;
+          strncpy(dir->fd_dir.d_name, "connhash", NAME_MAX + 1);
+        }
+      else
 #endif
         {
           int ifindex;
@@ -689,6 +731,15 @@ static int netprocfs_stat(FAR const char *relpath, FAR struct stat *buf)
       buf->st_mode = S_IFDIR | S_IROTH | S_IRGRP | S_IRUSR;
     }
   else
+#endif
+#ifdef NETPROCFS_HAVE_CONNHASH
+  /* Check for connection hash statistics "net/connhash" */
+
+  if (strcmp(relpath, "net/connhash") == 0)
+    {
+      buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+    }
+  else
 #endif
     {
       FAR struct net_driver_s *dev;
@@ -54,6 +54,12 @@
 #  undef CONFIG_NET_ROUTE
 #endif
 
+/* /proc/net/connhash is provided if any connection hash table is enabled */
+
+#if defined(CONFIG_NET_TCP_CONNHASH) || defined(CONFIG_NET_UDP_CONNHASH)
+#  define NETPROCFS_HAVE_CONNHASH 1
+#endif
+
 /* Determines the size of an intermediate buffer that must be large enough
  * to handle the longest line generated by this logic.
  */
@@ -78,6 +84,9 @@ enum netprocfs_entry_e
 #ifdef CONFIG_NET_ROUTE
   , NETPROCFS_SUBDIR_ROUTE           /* /proc/net/route */
 #endif
+#ifdef NETPROCFS_HAVE_CONNHASH
+  , NETPROCFS_SUBDIR_CONNHASH        /* /proc/net/connhash */
+#endif
 };
 
 /* This structure describes one open "file" */
@@ -218,6 +227,29 @@ ssize_t netprocfs_read_routes(FAR struct netprocfs_file_s *priv,
                               FAR char *buffer, size_t buflen);
 #endif
 
+/****************************************************************************
+ * Name: netprocfs_read_connhash
+ *
+ * Description:
+ *   Read and format connection hash table statistics.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which network status will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+#ifdef NETPROCFS_HAVE_CONNHASH
+ssize_t netprocfs_read_connhash(FAR struct netprocfs_file_s *priv,
+                                FAR char *buffer, size_t buflen);
+#endif
+
 /****************************************************************************
  * Name: netprocfs_read_devstats
  *
@@ -39,6 +39,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
@@ -270,7 +271,19 @@ static int sixlowpan_tcp_header(FAR struct tcp_conn_s *conn,
     {
       /* Update the TCP received window based on I/O buffer availability */
 
-      uint16_t recvwndo = tcp_get_recvwindow(dev);
+      uint32_t recvwndo = tcp_get_recvwindow(dev);
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+      if ((conn->tcpopts & TCP_OPTF_WS) != 0)
+        {
+          recvwndo >>= conn->rcv_wscale;
+        }
+#endif
+
+      if (recvwndo > UINT16_MAX)
+        {
+          recvwndo = UINT16_MAX;
+        }
 
       /* Set the TCP Window */
 
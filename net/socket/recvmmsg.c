@@ -0,0 +1,166 @@
+/****************************************************************************
+ * net/socket/recvmmsg.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdbool.h>
+#include <time.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/cancelpt.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: recvmmsg
+ *
+ * Description:
+ *   Receive several messages from a socket with a single call.  The network
+ *   is locked once for the whole batch rather than once per message; it is
+ *   still released while a receive waits for data.  The number of bytes
+ *   received for each message is returned in its msg_len field.
+ *
+ *   If MSG_WAITFORONE is set in flags, only the first receive may block;
+ *   the batch ends as soon as no more data is immediately available.
+ *
+ * Input Parameters:
+ *   sockfd  - Socket descriptor of socket
+ *   msgvec  - The array of messages to receive into
+ *   vlen    - The number of messages in msgvec
+ *   flags   - Receive flags, applied to every message
+ *   timeout - If not NULL, no further receive is started once this much
+ *             time has passed since the call.  As with Linux, a blocked
+ *             receive is not interrupted by the timeout.
+ *
+ * Returned Value:
+ *   The number of messages received.  If the first receive failed, -1
+ *   (ERROR) is returned and errno is set appropriately (see recvmsg()).
+ *   An error on a later message ends the batch early.
+ *
+ ****************************************************************************/
+
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout)
+{
+  FAR struct socket *psock;
+  clock_t start = 0;
+  clock_t ticks = 0;
+  unsigned int i;
+  ssize_t nrecvd = 0;
+  bool waitforone;
+
+  /* recvmmsg() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  psock = sockfd_socket(sockfd);
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      nrecvd = -EBADF;
+      goto errout;
+    }
+
+  if (msgvec == NULL && vlen > 0)
+    {
+      nrecvd = -EINVAL;
+      goto errout;
+    }
+
+  if (timeout != NULL)
+    {
+      if (timeout->tv_nsec < 0 || timeout->tv_nsec >= NSEC_PER_SEC)
+        {
+          nrecvd = -EINVAL;
+          goto errout;
+        }
+
+      ticks = SEC2TICK(timeout->tv_sec) + NSEC2TICK(timeout->tv_nsec);
+      start = clock_systimer();
+    }
+
+  waitforone = (flags & MSG_WAITFORONE) != 0;
+  flags     &= ~MSG_WAITFORONE;
+
+  net_lock();
+  for (i = 0; i < vlen; i++)
+    {
+      nrecvd = psock_recvmsg(psock, &msgvec[i].msg_hdr, flags);
+      if (nrecvd < 0)
+        {
+          break;
+        }
+
+      msgvec[i].msg_len = (unsigned int)nrecvd;
+
+      /* After the first message, only take what is already queued */
+
+      if (waitforone)
+        {
+          flags |= MSG_DONTWAIT;
+        }
+
+      if (timeout != NULL && clock_systimer() - start >= ticks)
+        {
+          i++;
+          break;
+        }
+    }
+
+  net_unlock();
+
+  if (i > 0 || nrecvd >= 0)
+    {
+      leave_cancellation_point();
+      return (int)i;
+    }
+
+errout:
+  set_errno((int)-nrecvd);
+  leave_cancellation_point();
+  return ERROR;
+}
@@ -0,0 +1,217 @@
+/****************************************************************************
+ * net/socket/recvmsg.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmsg
+ *
+ * Description:
+ *   psock_recvmsg() receives a message and scatters it into the I/O vectors
+ *   of msg.  A single I/O vector is received into directly.  Otherwise the
+ *   message is received into a temporary buffer and then scattered, so
+ *   that a datagram is never split across several receive operations.
+ *
+ *   Control messages are not supported:  msg_controllen is always returned
+ *   as zero.
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   msg   - Describes the buffers to receive the message and its source
+ *   flags - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On any
+ *   failure, a negated errno value is returned (see comments with
+ *   recvfrom() for a list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags)
+{
+  FAR struct sockaddr *from;
+  FAR struct iovec *iov;
+  FAR uint8_t *buf;
+  socklen_t fromlen;
+  ssize_t nrecvd;
+  size_t total;
+  size_t ncopy;
+  size_t offset;
+  unsigned long i;
+
+  if (msg == NULL || (msg->msg_iov == NULL && msg->msg_iovlen > 0))
+    {
+      return -EINVAL;
+    }
+
+  from    = (FAR struct sockaddr *)msg->msg_name;
+  fromlen = from != NULL ? (socklen_t)msg->msg_namelen : 0;
+  iov     = msg->msg_iov;
+
+  if (msg->msg_iovlen <= 1)
+    {
+      nrecvd = psock_recvfrom(psock,
+                              msg->msg_iovlen > 0 ? iov->iov_base : NULL,
+                              msg->msg_iovlen > 0 ? iov->iov_len : 0,
+                              flags, from, from != NULL ? &fromlen : NULL);
+    }
+  else
+    {
+      /* The total length must be representable in the returned ssize_t */
+
+      for (i = 0, total = 0; i < msg->msg_iovlen; i++)
+        {
+          if (iov[i].iov_len > SSIZE_MAX - total)
+            {
+              return -EINVAL;
+            }
+
+          total += iov[i].iov_len;
+        }
+
+      /* Receive no more than fits in the temporary buffer.  That is more
+       * than any datagram, and a stream may always return less than was
+       * requested.
+       */
+
+      if (total > _SS_MAXMSGBUF)
+        {
+          total = _SS_MAXMSGBUF;
+        }
+
+      buf = (FAR uint8_t *)kmm_malloc(total > 0 ? total : 1);
+      if (buf == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      nrecvd = psock_recvfrom(psock, buf, total, flags, from,
+                              from != NULL ? &fromlen : NULL);
+
+      for (i = 0, offset = 0;
+           nrecvd > 0 && offset < (size_t)nrecvd && i < msg->msg_iovlen;
+           i++)
+        {
+          ncopy = (size_t)nrecvd - offset;
+          if (ncopy > iov[i].iov_len)
+            {
+              ncopy = iov[i].iov_len;
+            }
+
+          memcpy(iov[i].iov_base, &buf[offset], ncopy);
+          offset += ncopy;
+        }
+
+      kmm_free(buf);
+    }
+
+  if (nrecvd >= 0)
+    {
+      msg->msg_namelen    = fromlen;
+      msg->msg_controllen = 0;
+      msg->msg_flags      = 0;
+    }
+
+  return nrecvd;
+}
+
+/****************************************************************************
+ * Name: recvmsg
+ *
+ * Description:
+ *   Receive a message and scatter it into the I/O vectors of msg.  The
+ *   source address is returned in msg->msg_name if it is not NULL.
+ *
+ * Input Parameters:
+ *   sockfd - Socket descriptor of socket
+ *   msg    - Describes the buffers to receive the message and its source
+ *   flags  - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On any
+ *   failure, -1 (ERROR) is returned and errno is set appropriately (see
+ *   recvfrom()).
+ *
+ ****************************************************************************/
+
+ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags)
+{
+  FAR struct socket *psock;
+  ssize_t ret;
+
+  /* recvmsg() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  psock = sockfd_socket(sockfd);
+
+  /* And let psock_recvmsg do all of the work */
+
+  ret = psock_recvmsg(psock, msg, flags);
+  if (ret < 0)
+    {
+      set_errno((int)-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
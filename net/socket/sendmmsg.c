@@ -0,0 +1,127 @@
+/****************************************************************************
+ * net/socket/sendmmsg.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sendmmsg
+ *
+ * Description:
+ *   Send several messages on a socket with a single call.  The network is
+ *   locked once for the whole batch rather than once per message; it is
+ *   still released while a send waits for buffers or copies user data.
+ *   The number of bytes sent for each message is returned in its msg_len
+ *   field.
+ *
+ * Input Parameters:
+ *   sockfd - Socket descriptor of socket
+ *   msgvec - The array of messages to send
+ *   vlen   - The number of messages in msgvec
+ *   flags  - Send flags, applied to every message
+ *
+ * Returned Value:
+ *   The number of messages sent.  If the first message could not be sent,
+ *   -1 (ERROR) is returned and errno is set appropriately (see sendmsg()).
+ *   An error on a later message ends the batch early.
+ *
+ ****************************************************************************/
+
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags)
+{
+  FAR struct socket *psock;
+  unsigned int i;
+  ssize_t nsent = 0;
+
+  /* sendmmsg() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  psock = sockfd_socket(sockfd);
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      nsent = -EBADF;
+      goto errout;
+    }
+
+  if (msgvec == NULL && vlen > 0)
+    {
+      nsent = -EINVAL;
+      goto errout;
+    }
+
+  net_lock();
+  for (i = 0; i < vlen; i++)
+    {
+      nsent = psock_sendmsg(psock, &msgvec[i].msg_hdr, flags);
+      if (nsent < 0)
+        {
+          break;
+        }
+
+      msgvec[i].msg_len = (unsigned int)nsent;
+    }
+
+  net_unlock();
+
+  if (i > 0 || nsent >= 0)
+    {
+      leave_cancellation_point();
+      return (int)i;
+    }
+
+errout:
+  set_errno((int)-nsent);
+  leave_cancellation_point();
+  return ERROR;
+}
@@ -0,0 +1,276 @@
+/****************************************************************************
+ * net/socket/sendmsg.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sendmsg_buffer
+ *
+ * Description:
+ *   Send one contiguous buffer to the destination of the message, or to the
+ *   connected peer if the message has no destination.
+ *
+ ****************************************************************************/
+
+static ssize_t sendmsg_buffer(FAR struct socket *psock,
+                              FAR const void *buf, size_t len, int flags,
+                              FAR const struct sockaddr *to,
+                              socklen_t tolen)
+{
+  if (to == NULL)
+    {
+      return psock_send(psock, buf, len, flags);
+    }
+
+  return psock_sendto(psock, buf, len, flags, to, tolen);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_sendmsg
+ *
+ * Description:
+ *   psock_sendmsg() sends a message gathered from the I/O vectors of msg.
+ *   A single I/O vector is sent directly.  Stream sockets send the I/O
+ *   vectors in turn.  Datagram sockets use the address family's
+ *   si_sendmsg() method, which builds the packet from the I/O vectors, if
+ *   there is one and otherwise gather the data into a temporary buffer so
+ *   that the message is still sent as one datagram.
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   msg   - The message to send
+ *   flags - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On any failure, a
+ *   negated errno value is returned (see comments with sendto() for a list
+ *   of appropriate errno values).
+ *
+ ****************************************************************************/
+
+ssize_t psock_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags)
+{
+  FAR const struct sockaddr *to;
+  FAR struct iovec *iov;
+  FAR uint8_t *buf;
+  socklen_t tolen;
+  ssize_t nsent;
+  size_t len;
+  size_t total;
+  unsigned long i;
+
+  /* Verify that the psock corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      nerr("ERROR: Invalid socket\n");
+      return -EBADF;
+    }
+
+  if (msg == NULL || (msg->msg_iov == NULL && msg->msg_iovlen > 0))
+    {
+      return -EINVAL;
+    }
+
+  /* A missing or empty name means that the socket must be connected */
+
+  to    = (FAR const struct sockaddr *)msg->msg_name;
+  tolen = msg->msg_namelen;
+
+  if (to == NULL || tolen <= 0)
+    {
+      to    = NULL;
+      tolen = 0;
+    }
+
+  iov = msg->msg_iov;
+  if (msg->msg_iovlen == 0)
+    {
+      return sendmsg_buffer(psock, NULL, 0, flags, to, tolen);
+    }
+  else if (msg->msg_iovlen == 1)
+    {
+      return sendmsg_buffer(psock, iov->iov_base, iov->iov_len, flags,
+                            to, tolen);
+    }
+
+  /* The total length must be representable in the returned ssize_t */
+
+  for (i = 0, total = 0; i < msg->msg_iovlen; i++)
+    {
+      if (iov[i].iov_len > SSIZE_MAX - total)
+        {
+          return -EINVAL;
+        }
+
+      total += iov[i].iov_len;
+    }
+
+  /* A stream has no message boundaries:  Just send each I/O vector in turn,
+   * stopping at the first short send.
+   */
+
+  if (psock->s_type == SOCK_STREAM)
+    {
+      total = 0;
+      for (i = 0; i < msg->msg_iovlen; i++)
+        {
+          if (iov[i].iov_len == 0)
+            {
+              continue;
+            }
+
+          nsent = sendmsg_buffer(psock, iov[i].iov_base, iov[i].iov_len,
+                                 flags, to, tolen);
+          if (nsent < 0)
+            {
+              return total > 0 ? (ssize_t)total : nsent;
+            }
+
+          total += nsent;
+          if ((size_t)nsent < iov[i].iov_len)
+            {
+              break;
+            }
+        }
+
+      return total;
+    }
+
+  /* Let the address family build the datagram from the I/O vectors if it
+   * can.
+   */
+
+  DEBUGASSERT(psock->s_sockif != NULL);
+  if (psock->s_sockif->si_sendmsg != NULL)
+    {
+      return psock->s_sockif->si_sendmsg(psock, msg, flags);
+    }
+
+  /* Otherwise, gather the datagram into a temporary buffer */
+
+  if (total > _SS_MAXMSGBUF)
+    {
+      return -EMSGSIZE;
+    }
+
+  buf = (FAR uint8_t *)kmm_malloc(total > 0 ? total : 1);
+  if (buf == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (i = 0, len = 0; i < msg->msg_iovlen; i++)
+    {
+      memcpy(&buf[len], iov[i].iov_base, iov[i].iov_len);
+      len += iov[i].iov_len;
+    }
+
+  nsent = sendmsg_buffer(psock, buf, total, flags, to, tolen);
+  kmm_free(buf);
+  return nsent;
+}
+
+/****************************************************************************
+ * Name: sendmsg
+ *
+ * Description:
+ *   Send a message gathered from the I/O vectors of msg to the address in
+ *   msg->msg_name, or to the connected peer if msg->msg_name is NULL.
+ *
+ * Input Parameters:
+ *   sockfd - Socket descriptor of socket
+ *   msg    - The message to send
+ *   flags  - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On any failure, -1
+ *   (ERROR) is returned and errno is set appropriately (see sendto()).
+ *
+ ****************************************************************************/
+
+ssize_t sendmsg(int sockfd, FAR struct msghdr *msg, int flags)
+{
+  FAR struct socket *psock;
+  ssize_t ret;
+
+  /* sendmsg() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  psock = sockfd_socket(sockfd);
+
+  /* And let psock_sendmsg do all of the work */
+
+  ret = psock_sendmsg(psock, msg, flags);
+  if (ret < 0)
+    {
+      set_errno((int)-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
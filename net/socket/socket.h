@@ -89,6 +89,12 @@
 #define _SS_ISCONNECTED(s)  (((s) & _SF_CONNECTED) != 0)
 #define _SS_ISCLOSED(s)     (((s) & _SF_CLOSED)    != 0)
 
+/* The largest temporary buffer used by sendmsg() and recvmsg() to gather
+ * or scatter I/O vectors.  No datagram can be larger.
+ */
+
+#define _SS_MAXMSGBUF    UINT16_MAX
+
 /* This macro converts a socket option value into a bit setting */
 
 #define _SO_BIT(o)       (1 << (o))
@@ -148,55 +154,6 @@ extern "C"
  * Public Function Prototypes
  ****************************************************************************/
 
-/****************************************************************************
- * Name: sockfd_allocate
- *
- * Description:
- *   Allocate a socket descriptor
- *
- * Input Parameters:
- *   Lowest socket descriptor index to be used.
- *
- * Returned Value:
- *   On success, a socket descriptor >= minsd is returned.  A negated errno
- *   value is returned on failure.
- *
- ****************************************************************************/
-
-int sockfd_allocate(int minsd);
-
-/****************************************************************************
- * Name: psock_release
- *
- * Description:
- *   Free a socket.
- *
- * Input Parameters:
- *   psock - A reference to the socket instance to be freed.
- *
- * Returned Value:
- *   None
- *
- ****************************************************************************/
-
-void psock_release(FAR struct socket *psock);
-
-/****************************************************************************
- * Name: sockfd_release
- *
- * Description:
- *   Free the socket by its socket descriptor.
- *
- * Input Parameters:
- *   sockfd - Socket descriptor identifies the socket to be released.
- *
- * Returned Value:
- *   None
- *
- ****************************************************************************/
-
-void sockfd_release(int sockfd);
-
 /****************************************************************************
  * Name: sockfd_socket
  *
@@ -44,6 +44,7 @@
 
 #include <sys/types.h>
 #include <queue.h>
+#include <semaphore.h>
 
 #include <nuttx/clock.h>
 #include <nuttx/mm/iob.h>
@@ -61,6 +62,75 @@
 
 #define NET_TCP_HAVE_STACK 1
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+/* Hash a local port, a remote port and (the low 32-bits of) a remote
+ * address into a bucket index.  All values are in network order.
+ */
+
+#  define TCP_HASH_MASK (CONFIG_NET_TCP_CONNHASH_SIZE - 1)
+#  define TCP_HASH(lport,rport,raddr) \
+     (((((uint32_t)(raddr) ^ ((uint32_t)(lport) << 16) ^ (rport)) * \
+        0x9e3779b1) >> 16) & TCP_HASH_MASK)
+
+#  define TCP_IPv6_HASHADDR(a) (((uint32_t)(a)[6] << 16) | (a)[7])
+#endif
+
+/* Comparison of TCP sequence numbers, allowing for wrap-around */
+
+#define TCP_SEQ_LT(a,b)   ((int32_t)((a) - (b)) < 0)
+#define TCP_SEQ_LTE(a,b)  ((int32_t)((a) - (b)) <= 0)
+#define TCP_SEQ_GT(a,b)   ((int32_t)((a) - (b)) > 0)
+#define TCP_SEQ_GTE(a,b)  ((int32_t)((a) - (b)) >= 0)
+
+/* TCP options negotiated when the connection is established */
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) || \
+    defined(CONFIG_NET_TCP_TIMESTAMPS) || defined(CONFIG_NET_TCP_SACK)
+#  define TCP_HAVE_OPTIONS 1
+#endif
+
+#define TCP_OPTF_WS        (1 << 0)  /* Window scaling */
+#define TCP_OPTF_TS        (1 << 1)  /* Timestamps */
+#define TCP_OPTF_SACK      (1 << 2)  /* Selective acknowledgements */
+
+/* The timestamps option padded with two NOPs to a 32-bit boundary.  This
+ * is added to every segment once timestamps have been negotiated.
+ */
+
+#define TCP_OPT_TS_PADLEN  12
+
+/* The clock used for TCP timestamps and by congestion control (msec) */
+
+#define TCP_CLOCK()        ((uint32_t)TICK2MSEC((uint64_t)clock_systimer()))
+
+/* Units of the retransmission timer and time-out calculation (msec) */
+
+#define TCP_HSEC_MS        500
+
+/* The maximum number of SACK blocks retained from an incoming ACK */
+
+#define TCP_SACK_NBLOCKS   4
+
+#ifdef CONFIG_NET_TCP_CC
+/* Congestion control state flags (ccflags) */
+
+#  define TCP_CC_RECOVERY  (1 << 0)  /* In fast recovery */
+#  define TCP_CC_REXMIT    (1 << 1)  /* Fast retransmission pending */
+
+/* The number of duplicate ACKs that indicate a lost segment */
+
+#  define TCP_CC_DUPTHRESH 3
+
+/* The amount of data that the connection may have in flight is limited by
+ * both the peer's receive window and the congestion window.
+ */
+
+#  define TCP_SNDWND(conn) \
+     ((conn)->winsize < (conn)->cwnd ? (conn)->winsize : (conn)->cwnd)
+#else
+#  define TCP_SNDWND(conn) ((conn)->winsize)
+#endif
+
 /* Conditions for support TCP poll/select operations */
 
 #ifdef CONFIG_NET_TCP_READAHEAD
@@ -123,6 +193,8 @@ struct net_driver_s;      /* Forward reference */
 struct devif_callback_s;  /* Forward reference */
 struct tcp_backlog_s;     /* Forward reference */
 struct tcp_hdr_s;         /* Forward reference */
+struct net_hashstat_s;    /* Forward reference */
+struct tcp_cc_ops_s;      /* Forward reference */
 
 struct tcp_conn_s
 {
@@ -130,6 +202,15 @@ struct tcp_conn_s
 
   dq_entry_t node;        /* Implements a doubly linked list */
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+  /* Link in a hash chain.  An active connection is linked into the
+   * connection hash table; a listening connection is linked into the
+   * listener hash table.  A connection is never in both.
+   */
+
+  FAR struct tcp_conn_s *hnext;
+#endif
+
   /* TCP callbacks:
    *
    * Data transfer events are retained in 'list'.  Event handlers in 'list'
@@ -179,13 +260,35 @@ struct tcp_conn_s
   uint16_t rport;         /* The remoteTCP port, in network byte order */
   uint16_t mss;           /* Current maximum segment size for the
                            * connection */
-  uint16_t winsize;       /* Current window size of the connection */
+  uint32_t winsize;       /* Current window size of the connection */
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   uint32_t unacked;       /* Number bytes sent but not yet ACKed */
 #else
   uint16_t unacked;       /* Number bytes sent but not yet ACKed */
 #endif
 
+#ifdef TCP_HAVE_OPTIONS
+  /* TCP options negotiated with the peer
+   *
+   *   tcpopts    - The set of negotiated options (see TCP_OPTF_*)
+   *   snd_wscale - Shift applied to the window advertised by the peer
+   *   rcv_wscale - Shift applied to the window that we advertise
+   *   ts_recent  - The most recent timestamp value received from the peer
+   *   rtt        - The most recent round trip time measured from the
+   *                timestamp echoed by the peer (milliseconds)
+   */
+
+  uint8_t  tcpopts;       /* Negotiated options */
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  uint8_t  snd_wscale;    /* Peer's window scale shift */
+  uint8_t  rcv_wscale;    /* Our window scale shift */
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  uint32_t ts_recent;     /* Timestamp to echo to the peer */
+  uint32_t rtt;           /* Last measured round trip time (msec) */
+#endif
+#endif
+
   /* If the TCP socket is bound to a local address, then this is
    * a reference to the device that routes traffic on the corresponding
    * network.
@@ -198,9 +301,18 @@ struct tcp_conn_s
    *
    *   readahead - A singly linked list of type struct iob_qentry_s
    *               where the TCP/IP read-ahead data is retained.
+   *   rdlock    - Protects the read-ahead queue.  It is only held while
+   *               the queue itself is modified, so the device path may
+   *               wait for it.
+   *   rcvlock   - Serializes the readers of the read-ahead queue.  The
+   *               holder may copy out the data of the chain at the head
+   *               of the queue without holding rdlock or the network lock:
+   *               the device path only appends to the queue.
    */
 
   struct iob_queue_s readahead;   /* Read-ahead buffering */
+  sem_t rdlock;                   /* Protects readahead */
+  sem_t rcvlock;                  /* Serializes readers of readahead */
 #endif
 
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
@@ -222,6 +334,54 @@ struct tcp_conn_s
                            * segment (next greater sndseq) */
 #endif
 
+#ifdef CONFIG_NET_TCP_CC
+  /* Congestion control (see tcp_cc.c).  Window sizes are in bytes.
+   *
+   *   cc        - The congestion control algorithm
+   *   cwnd      - The congestion window
+   *   ssthresh  - The slow start threshold
+   *   ccbytes   - Bytes ACKed but not yet accounted for in cwnd
+   *   snduna    - The oldest unacknowledged sequence number
+   *   recover   - The highest sequence number sent when loss recovery
+   *               began (RFC 6582)
+   *   rexmitseq - The next sequence number to be fast-retransmitted
+   *   dupacks   - The number of consecutive duplicate ACKs received
+   *   ccflags   - See TCP_CC_*
+   *   sack      - The SACK blocks of the last duplicate ACK, each the
+   *               sequence numbers of the first byte and the byte after
+   *               the last byte received by the peer
+   */
+
+  FAR const struct tcp_cc_ops_s *cc;
+  uint32_t   cwnd;        /* Congestion window */
+  uint32_t   ssthresh;    /* Slow start threshold */
+  uint32_t   ccbytes;     /* ACKed bytes not yet added to cwnd */
+  uint32_t   snduna;      /* Oldest unacknowledged sequence number */
+  uint32_t   recover;     /* End of the recovery episode */
+  uint32_t   rexmitseq;   /* Next sequence number to fast-retransmit */
+  uint8_t    dupacks;     /* Count of duplicate ACKs */
+  uint8_t    ccflags;     /* Congestion control flags */
+#ifdef CONFIG_NET_TCP_SACK
+  uint8_t    nsack;       /* Number of valid SACK blocks */
+  uint32_t   sack[TCP_SACK_NBLOCKS][2];
+#endif
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  /* CUBIC state (RFC 8312)
+   *
+   *   wmax   - The congestion window just before the last reduction
+   *   k      - Time that the cubic function takes to reach wmax (msec)
+   *   epoch  - Start of the current congestion avoidance epoch (msec)
+   *   west   - Window that standard TCP would have reached in the epoch
+   */
+
+  uint32_t   wmax;        /* Window before the last reduction */
+  uint32_t   k;           /* Time to reach wmax (msec) */
+  uint32_t   epoch;       /* Start of the epoch (msec) */
+  uint32_t   west;        /* TCP-friendly window estimate */
+  bool       epochvalid;  /* True: epoch has been started */
+#endif
+#endif
+
 #ifdef CONFIG_NET_TCPBACKLOG
   /* Listen backlog support
    *
@@ -272,6 +432,32 @@ struct tcp_conn_s
   int (*accept)(FAR struct tcp_conn_s *listener, FAR struct tcp_conn_s *conn);
 };
 
+#ifdef CONFIG_NET_TCP_CC
+/* A congestion control algorithm.  Slow start is common to all algorithms
+ * and is performed by tcp_cc.c; the algorithm is consulted only once the
+ * congestion window has reached the slow start threshold.
+ *
+ *   name    - The name of the algorithm
+ *   init    - Initialize the algorithm's state when the connection is
+ *             established.  cwnd and ssthresh are already set.
+ *   ack     - Grow cwnd in congestion avoidance.  'acked' is the number
+ *             of newly acknowledged bytes.
+ *   loss    - A loss was detected by duplicate ACKs:  Set the new ssthresh
+ *             and cwnd for the recovery that follows.
+ *   timeout - The retransmission timer expired:  Set the new ssthresh and
+ *             cwnd.
+ */
+
+struct tcp_cc_ops_s
+{
+  FAR const char *name;
+  CODE void (*init)(FAR struct tcp_conn_s *conn);
+  CODE void (*ack)(FAR struct tcp_conn_s *conn, uint32_t acked);
+  CODE void (*loss)(FAR struct tcp_conn_s *conn);
+  CODE void (*timeout)(FAR struct tcp_conn_s *conn);
+};
+#endif
+
 /* This structure supports TCP write buffering */
 
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
@@ -327,6 +513,17 @@ extern "C"
 
 EXTERN struct net_driver_s *g_netdevices;
 
+#ifdef CONFIG_NET_TCP_CC
+/* The available congestion control algorithms */
+
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+EXTERN const struct tcp_cc_ops_s g_tcp_cc_newreno;
+#endif
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+EXTERN const struct tcp_cc_ops_s g_tcp_cc_cubic;
+#endif
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -399,6 +596,21 @@ FAR struct tcp_conn_s *tcp_active(FAR struct net_driver_s *dev,
 
 FAR struct tcp_conn_s *tcp_nextconn(FAR struct tcp_conn_s *conn);
 
+/****************************************************************************
+ * Name: tcp_hashstats
+ *
+ * Description:
+ *   Return the occupancy of the active connection hash table.
+ *
+ * Assumptions:
+ *   Called from normal user code.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONNHASH
+void tcp_hashstats(FAR struct net_hashstat_s *stats);
+#endif
+
 /****************************************************************************
  * Name: tcp_local_ipv4_device
  *
@@ -842,6 +1054,21 @@ int tcp_unlisten(FAR struct tcp_conn_s *conn);
 
 int tcp_listen(FAR struct tcp_conn_s *conn);
 
+/****************************************************************************
+ * Name: tcp_listen_hashstats
+ *
+ * Description:
+ *   Return the occupancy of the listener hash table.
+ *
+ * Assumptions:
+ *   Called from normal user code.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONNHASH
+void tcp_listen_hashstats(FAR struct net_hashstat_s *stats);
+#endif
+
 /****************************************************************************
  * Name: tcp_islistener
  *
@@ -1382,7 +1609,115 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
  *
  ****************************************************************************/
 
-uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev);
+uint32_t tcp_get_recvwindow(FAR struct net_driver_s *dev);
+
+/****************************************************************************
+ * Name: tcp_wscale_shift
+ *
+ * Description:
+ *   Return the window scale shift that we will offer to the peer.  This is
+ *   the smallest shift that can represent the largest receive window that
+ *   tcp_get_recvwindow() could return.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The window scale shift (0-TCP_WS_MAXSHIFT).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+uint8_t tcp_wscale_shift(void);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_initialize
+ *
+ * Description:
+ *   Initialize the congestion control state of a connection that has just
+ *   entered the ESTABLISHED state.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_initialize(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_ackinput
+ *
+ * Description:
+ *   Update the congestion control state for an incoming ACK.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection
+ *   ackseq - The acknowledgement number of the segment
+ *   dupack - True if the segment is a duplicate ACK:  It acknowledges
+ *            nothing new, carries no data, and does not change the window
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_ackinput(FAR struct tcp_conn_s *conn, uint32_t ackseq,
+                     bool dupack);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Update the congestion control state when the retransmission timer
+ *   expires.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_rtt
+ *
+ * Description:
+ *   Return the best available estimate of the round trip time of a
+ *   connection in milliseconds.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   The round trip time (msec).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+uint32_t tcp_cc_rtt(FAR struct tcp_conn_s *conn);
+#endif
 
 /****************************************************************************
  * Name: psock_tcp_cansend
@@ -50,6 +50,7 @@
 
 #include "devif/devif.h"
 #include "tcp/tcp.h"
+#include "utils/utils.h"
 
 #ifdef NET_TCP_HAVE_STACK
 
@@ -57,6 +58,118 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_iobhandler
+ *
+ * Description:
+ *   Buffer new data in the read-ahead queue.  If the driver received the
+ *   packet directly into an I/O buffer (d_iob), that buffer is trimmed to
+ *   the TCP payload and queued as it is, and the driver is given a new I/O
+ *   buffer holding a copy of the packet headers in its place.  Otherwise
+ *   the payload is copied as by tcp_datahandler().
+ *
+ * Returned Value:
+ *   The number of bytes actually buffered; either zero or d_len.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_RECV_ZEROCOPY
+static uint16_t tcp_iobhandler(FAR struct net_driver_s *dev,
+                               FAR struct tcp_conn_s *conn)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+  FAR struct iob_s *newiob;
+  unsigned int bufoff;
+  unsigned int hdrlen;
+  unsigned int dataoff;
+  int ret;
+
+  /* Copy the data if the packet does not lie within an I/O buffer */
+
+  if (iob == NULL || dev->d_buf < iob->io_data ||
+      (FAR uint8_t *)dev->d_appdata + dev->d_len >
+      &iob->io_data[IOB_BUFSIZE(iob)])
+    {
+      return tcp_datahandler(conn, dev->d_appdata, dev->d_len);
+    }
+
+  /* Get the buffer that will replace the driver's buffer (without waiting
+   * and throttling as necessary).  The driver may build a full frame in
+   * it, so it must be no smaller than the original.  Otherwise fall back
+   * to copying the data.
+   */
+
+  newiob = iob_tryalloc_size(IOB_BUFSIZE(iob), true,
+                             IOBUSER_NET_TCP_READAHEAD);
+  if (newiob != NULL && IOB_BUFSIZE(newiob) < IOB_BUFSIZE(iob))
+    {
+      (void)iob_free(newiob, IOBUSER_NET_TCP_READAHEAD);
+      return tcp_datahandler(conn, dev->d_appdata, dev->d_len);
+    }
+
+  if (newiob == NULL)
+    {
+      nerr("ERROR: Failed to allocate a replacement I/O buffer\n");
+      return 0;
+    }
+
+  bufoff  = dev->d_buf - iob->io_data;
+  hdrlen  = (FAR uint8_t *)dev->d_appdata - dev->d_buf;
+  dataoff = bufoff + hdrlen;
+
+  /* The response will be built in the replacement buffer.  Preserve the
+   * packet headers there now:  Once the original buffer is queued, the
+   * reader may consume and free it at any time.
+   */
+
+  memcpy(&newiob->io_data[bufoff], dev->d_buf, hdrlen);
+
+  /* Trim the original buffer to the payload and queue it (again without
+   * waiting for a free queue entry).
+   */
+
+  iob->io_flink  = NULL;
+  iob->io_offset = dataoff;
+  iob->io_len    = dev->d_len;
+  iob->io_pktlen = dev->d_len;
+
+  /* Readers hold the read-ahead lock only while they modify the queue */
+
+  net_connlock(&conn->rdlock);
+  ret = iob_tryadd_queue(iob, &conn->readahead);
+  net_connunlock(&conn->rdlock);
+
+  if (ret < 0)
+    {
+      /* The driver keeps its buffer */
+
+      nerr("ERROR: Failed to queue the I/O buffer chain: %d\n", ret);
+      (void)iob_free(newiob, IOBUSER_NET_TCP_READAHEAD);
+      return 0;
+    }
+
+  /* Give the replacement buffer to the driver */
+
+  dev->d_iob     = newiob;
+  dev->d_buf     = &newiob->io_data[bufoff];
+  dev->d_appdata = &dev->d_buf[hdrlen];
+
+#ifdef CONFIG_TCP_NOTIFIER
+  /* Provide notification(s) that additional TCP read-ahead data is
+   * available.
+   */
+
+  tcp_readahead_signal(conn);
+#endif
+
+  ninfo("Queued %d bytes without copying\n", dev->d_len);
+  return dev->d_len;
+}
+#endif
+
 /****************************************************************************
  * Name: tcp_data_event
  *
@@ -90,7 +203,9 @@ tcp_data_event(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   if (dev->d_len > 0)
     {
 #ifdef CONFIG_NET_TCP_READAHEAD
+#ifndef CONFIG_NET_TCP_RECV_ZEROCOPY
       uint8_t *buffer = dev->d_appdata;
+#endif
       int      buflen = dev->d_len;
       uint16_t recvlen;
 #endif
@@ -102,7 +217,11 @@ tcp_data_event(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
        * partial packets will not be buffered.
        */
 
+#ifdef CONFIG_NET_TCP_RECV_ZEROCOPY
+      recvlen = tcp_iobhandler(dev, conn);
+#else
       recvlen = tcp_datahandler(conn, buffer, buflen);
+#endif
       if (recvlen < buflen)
 #endif
         {
@@ -232,7 +351,8 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *
  * Returned Value:
  *   The number of bytes actually buffered is returned.  This will be either
- *   zero or equal to buflen; partial packets are not buffered.
+ *   zero or equal to buflen; partial packets are not buffered.  Zero is also
+ *   returned if the read-ahead queue is in use by a reader.
  *
  * Assumptions:
  * - The caller has checked that TCP_NEWDATA is set in flags and that is no
@@ -276,10 +396,14 @@ uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
     }
 
   /* Add the new I/O buffer chain to the tail of the read-ahead queue (again
-   * without waiting).
+   * without waiting for a free queue entry).  Readers hold the read-ahead
+   * lock only while they modify the queue, never while copying data.
    */
 
+  net_connlock(&conn->rdlock);
   ret = iob_tryadd_queue(iob, &conn->readahead);
+  net_connunlock(&conn->rdlock);
+
   if (ret < 0)
     {
       nerr("ERROR: Failed to queue the I/O buffer chain: %d\n", ret);
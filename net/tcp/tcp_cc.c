@@ -0,0 +1,337 @@
+/****************************************************************************
+ * net/tcp/tcp_cc.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && \
+    defined(CONFIG_NET_TCP_CC)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <debug.h>
+
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The congestion control algorithm used by all connections */
+
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+#  define TCP_CC_ALGORITHM (&g_tcp_cc_cubic)
+#else
+#  define TCP_CC_ALGORITHM (&g_tcp_cc_newreno)
+#endif
+
+/* The largest congestion window (well beyond any window that the peer can
+ * advertise).
+ */
+
+#define TCP_CC_MAXCWND   0x40000000
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cc_initialize
+ *
+ * Description:
+ *   Initialize the congestion control state of a connection that has just
+ *   entered the ESTABLISHED state.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_initialize(FAR struct tcp_conn_s *conn)
+{
+  uint32_t iw;
+
+  /* The initial window is two to four segments (RFC 3390) */
+
+  iw = 4380;
+  if (iw < 2 * (uint32_t)conn->mss)
+    {
+      iw = 2 * (uint32_t)conn->mss;
+    }
+  else if (iw > 4 * (uint32_t)conn->mss)
+    {
+      iw = 4 * (uint32_t)conn->mss;
+    }
+
+  /* The slow start threshold is initially arbitrarily high (RFC 5681).
+   * Duplicate ACKs for data up to 'recover' do not start a recovery.
+   */
+
+  conn->cc        = TCP_CC_ALGORITHM;
+  conn->cwnd      = iw;
+  conn->ssthresh  = UINT32_MAX;
+  conn->ccbytes   = 0;
+  conn->snduna    = conn->isn;
+  conn->recover   = conn->isn - 1;
+  conn->rexmitseq = conn->isn;
+  conn->dupacks   = 0;
+  conn->ccflags   = 0;
+#ifdef CONFIG_NET_TCP_SACK
+  conn->nsack     = 0;
+#endif
+
+  conn->cc->init(conn);
+
+  ninfo("cc=%s mss=%u cwnd=%u\n", conn->cc->name, conn->mss, conn->cwnd);
+}
+
+/****************************************************************************
+ * Name: tcp_cc_ackinput
+ *
+ * Description:
+ *   Update the congestion control state for an incoming ACK.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection
+ *   ackseq - The acknowledgement number of the segment
+ *   dupack - True if the segment is a duplicate ACK:  It acknowledges
+ *            nothing new, carries no data, and does not change the window
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_ackinput(FAR struct tcp_conn_s *conn, uint32_t ackseq,
+                     bool dupack)
+{
+  uint32_t acked;
+
+  DEBUGASSERT(conn->cc != NULL);
+
+  if (TCP_SEQ_GT(ackseq, conn->snduna))
+    {
+      /* New data has been acknowledged */
+
+      acked         = ackseq - conn->snduna;
+      conn->snduna  = ackseq;
+      conn->dupacks = 0;
+
+      if ((conn->ccflags & TCP_CC_RECOVERY) != 0)
+        {
+          if (TCP_SEQ_GTE(ackseq, conn->recover))
+            {
+              /* A full acknowledgement ends the recovery (RFC 6582).  The
+               * congestion window was already reduced when it began.
+               */
+
+              conn->ccflags &= ~(TCP_CC_RECOVERY | TCP_CC_REXMIT);
+              ninfo("Recovered: cwnd=%u ssthresh=%u\n",
+                    conn->cwnd, conn->ssthresh);
+            }
+          else
+            {
+              /* A partial acknowledgement:  The segment that starts at
+               * ackseq was lost too.  Retransmit it (or, with SACK, the
+               * next range that the peer has not received) right away.
+               */
+
+#ifdef CONFIG_NET_TCP_SACK
+              if (conn->nsack == 0 || TCP_SEQ_LT(conn->rexmitseq, ackseq))
+#endif
+                {
+                  conn->rexmitseq = ackseq;
+                }
+
+              conn->ccflags |= TCP_CC_REXMIT;
+            }
+
+          return;
+        }
+
+      if (conn->cwnd < conn->ssthresh)
+        {
+          /* Slow start:  Grow by the number of bytes acknowledged, but by
+           * no more than one segment per ACK (RFC 5681).
+           */
+
+          conn->cwnd += acked < conn->mss ? acked : conn->mss;
+        }
+      else
+        {
+          /* Congestion avoidance */
+
+          conn->cc->ack(conn, acked);
+        }
+
+      if (conn->cwnd > TCP_CC_MAXCWND)
+        {
+          conn->cwnd = TCP_CC_MAXCWND;
+        }
+    }
+  else if (dupack)
+    {
+      if (conn->dupacks < UINT8_MAX)
+        {
+          conn->dupacks++;
+        }
+
+      if ((conn->ccflags & TCP_CC_RECOVERY) == 0)
+        {
+          /* The third duplicate ACK indicates that the segment at snduna
+           * was lost.  Ignore duplicate ACKs for data that was sent before
+           * the last recovery began (RFC 6582).
+           */
+
+          if (conn->dupacks == TCP_CC_DUPTHRESH &&
+              TCP_SEQ_GT(ackseq, conn->recover))
+            {
+              conn->cc->loss(conn);
+
+              conn->recover   = conn->sndseq_max;
+              conn->rexmitseq = conn->snduna;
+              conn->ccflags  |= TCP_CC_RECOVERY | TCP_CC_REXMIT;
+
+              ninfo("Fast retransmit: seq=%u cwnd=%u ssthresh=%u\n",
+                    conn->snduna, conn->cwnd, conn->ssthresh);
+            }
+        }
+#ifdef CONFIG_NET_TCP_SACK
+      else if (conn->nsack > 0)
+        {
+          /* Each further duplicate ACK in the recovery reports data that
+           * has left the network.  Retransmit the next missing range.
+           */
+
+          conn->ccflags |= TCP_CC_REXMIT;
+        }
+#endif
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Update the congestion control state when the retransmission timer
+ *   expires.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn)
+{
+  DEBUGASSERT(conn->cc != NULL);
+
+  /* Only the first timeout of a segment reduces the slow start threshold;
+   * later timeouts of the same segment only reset the window.
+   */
+
+  if (conn->nrtx <= 1)
+    {
+      conn->cc->timeout(conn);
+    }
+  else
+    {
+      conn->cwnd = conn->mss;
+    }
+
+  /* Any recovery is abandoned:  All un-ACKed data will be sent again */
+
+  conn->ccbytes = 0;
+  conn->dupacks = 0;
+  conn->ccflags = 0;
+  conn->recover = conn->sndseq_max;
+#ifdef CONFIG_NET_TCP_SACK
+  conn->nsack   = 0;
+#endif
+
+  ninfo("Timeout: cwnd=%u ssthresh=%u\n", conn->cwnd, conn->ssthresh);
+}
+
+/****************************************************************************
+ * Name: tcp_cc_rtt
+ *
+ * Description:
+ *   Return the best available estimate of the round trip time of a
+ *   connection in milliseconds.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   The round trip time (msec).
+ *
+ ****************************************************************************/
+
+uint32_t tcp_cc_rtt(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  /* The most recent measurement from the timestamps option */
+
+  if ((conn->tcpopts & TCP_OPTF_TS) != 0 && conn->rtt > 0)
+    {
+      return conn->rtt;
+    }
+#endif
+
+  /* Otherwise, the much coarser smoothed estimate maintained for the
+   * retransmission time-out (sa is scaled by 8).
+   */
+
+  return ((uint32_t)conn->sa >> 3) * TCP_HSEC_MS;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_CC */
@@ -0,0 +1,325 @@
+/****************************************************************************
+ * net/tcp/tcp_cc_cubic.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && \
+    defined(CONFIG_NET_TCP_CC_CUBIC)
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The multiplicative decrease factor, beta = 0.7 (RFC 8312) */
+
+#define CUBIC_BETA_NUM    7
+#define CUBIC_BETA_DEN    10
+
+/* The scaling constant C = 0.4 segments/sec^3 is applied as 2/5.  Times are
+ * in milliseconds, so the cube of a time must also be divided by 10^9.
+ */
+
+#define CUBIC_C_NUM       2
+#define CUBIC_C_DEN       5
+
+/* Times are limited to 100 seconds to keep the arithmetic within 64 bits */
+
+#define CUBIC_MAXTIME     100000
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void cubic_init(FAR struct tcp_conn_s *conn);
+static void cubic_ack(FAR struct tcp_conn_s *conn, uint32_t acked);
+static void cubic_loss(FAR struct tcp_conn_s *conn);
+static void cubic_timeout(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_cubic =
+{
+  "cubic",           /* name */
+  cubic_init,        /* init */
+  cubic_ack,         /* ack */
+  cubic_loss,        /* loss */
+  cubic_timeout      /* timeout */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cubic_cbrt
+ *
+ * Description:
+ *   Return the integer cube root of a 64-bit value.
+ *
+ ****************************************************************************/
+
+static uint32_t cubic_cbrt(uint64_t x)
+{
+  uint64_t y = 0;
+  uint64_t b;
+  int s;
+
+  for (s = 63; s >= 0; s -= 3)
+    {
+      y <<= 1;
+      b   = 3 * y * (y + 1) + 1;
+      if ((x >> s) >= b)
+        {
+          x -= b << s;
+          y++;
+        }
+    }
+
+  return (uint32_t)y;
+}
+
+/****************************************************************************
+ * Name: cubic_reduce
+ *
+ * Description:
+ *   Remember the window at which the loss occurred and reduce the slow
+ *   start threshold to beta times the window.  If the window did not
+ *   reach the previous maximum, the network's capacity has probably
+ *   dropped and the maximum is reduced further (fast convergence).
+ *
+ ****************************************************************************/
+
+static void cubic_reduce(FAR struct tcp_conn_s *conn)
+{
+  uint64_t cwnd = conn->cwnd;
+
+  if (conn->cwnd < conn->wmax)
+    {
+      conn->wmax = (uint32_t)(cwnd * (CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+                              (2 * CUBIC_BETA_DEN));
+    }
+  else
+    {
+      conn->wmax = conn->cwnd;
+    }
+
+  conn->ssthresh = (uint32_t)(cwnd * CUBIC_BETA_NUM / CUBIC_BETA_DEN);
+  if (conn->ssthresh < 2 * (uint32_t)conn->mss)
+    {
+      conn->ssthresh = 2 * (uint32_t)conn->mss;
+    }
+
+  conn->epochvalid = false;
+  conn->ccbytes    = 0;
+}
+
+/****************************************************************************
+ * Name: cubic_target
+ *
+ * Description:
+ *   Return the window given by the cubic function at the time 't'
+ *   (milliseconds since the start of the epoch):
+ *
+ *     W(t) = C * (t - K)^3 + Wmax
+ *
+ ****************************************************************************/
+
+static uint32_t cubic_target(FAR struct tcp_conn_s *conn, uint32_t t)
+{
+  uint64_t dt;
+  uint64_t delta;
+
+  dt = t > conn->k ? t - conn->k : conn->k - t;
+  if (dt > CUBIC_MAXTIME)
+    {
+      dt = CUBIC_MAXTIME;
+    }
+
+  /* delta = C * dt^3 segments, dt in msec */
+
+  delta = (dt * dt * dt) / 1000;
+  delta = (delta * CUBIC_C_NUM * conn->mss) / (CUBIC_C_DEN * 1000000);
+
+  if (t > conn->k)
+    {
+      delta += conn->wmax;
+      return delta > UINT32_MAX ? UINT32_MAX : (uint32_t)delta;
+    }
+
+  return delta >= conn->wmax ? conn->mss : conn->wmax - (uint32_t)delta;
+}
+
+/****************************************************************************
+ * Name: cubic_init
+ *
+ * Description:
+ *   Initialize the algorithm's state.
+ *
+ ****************************************************************************/
+
+static void cubic_init(FAR struct tcp_conn_s *conn)
+{
+  conn->wmax       = 0;
+  conn->k          = 0;
+  conn->epoch      = 0;
+  conn->west       = 0;
+  conn->epochvalid = false;
+}
+
+/****************************************************************************
+ * Name: cubic_ack
+ *
+ * Description:
+ *   Congestion avoidance:  Grow the window towards the value of the cubic
+ *   function one round trip from now, or towards the window that standard
+ *   TCP would have reached if that is larger (the TCP-friendly region).
+ *
+ ****************************************************************************/
+
+static void cubic_ack(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  uint32_t now = TCP_CLOCK();
+  uint32_t target;
+  uint64_t need;
+
+  if (!conn->epochvalid)
+    {
+      /* Start a new epoch.  K is the time that the cubic function takes to
+       * climb from the current window back to Wmax:
+       *
+       *   K = cbrt((Wmax - cwnd) / C)
+       */
+
+      conn->epochvalid = true;
+      conn->epoch      = now;
+      conn->west       = conn->cwnd;
+      conn->ccbytes    = 0;
+
+      if (conn->cwnd < conn->wmax)
+        {
+          conn->k = cubic_cbrt((uint64_t)(conn->wmax - conn->cwnd) *
+                               CUBIC_C_DEN * 500000000 / conn->mss);
+        }
+      else
+        {
+          conn->k    = 0;
+          conn->wmax = conn->cwnd;
+        }
+    }
+
+  /* The window one round trip from now */
+
+  target = cubic_target(conn, now - conn->epoch + tcp_cc_rtt(conn));
+
+  /* Standard TCP would grow by 3 * (1 - beta) / (1 + beta) segments per
+   * round trip with this beta.
+   */
+
+  conn->west += (uint32_t)((uint64_t)acked * conn->mss *
+                           3 * (CUBIC_BETA_DEN - CUBIC_BETA_NUM) /
+                           ((uint64_t)conn->cwnd *
+                            (CUBIC_BETA_DEN + CUBIC_BETA_NUM)));
+  if (target < conn->west)
+    {
+      target = conn->west;
+    }
+
+  if (target > conn->cwnd + conn->cwnd / 2)
+    {
+      target = conn->cwnd + conn->cwnd / 2;
+    }
+
+  /* Grow by one segment for each cwnd / (target - cwnd) segments that are
+   * acknowledged.  Beyond the target, grow very slowly (by one segment per
+   * 100 round trips).
+   */
+
+  if (target > conn->cwnd)
+    {
+      need = (uint64_t)conn->cwnd * conn->mss / (target - conn->cwnd);
+    }
+  else
+    {
+      need = 100 * (uint64_t)conn->cwnd;
+    }
+
+  conn->ccbytes += acked;
+  if (conn->ccbytes >= need)
+    {
+      conn->ccbytes = 0;
+      conn->cwnd   += conn->mss;
+    }
+}
+
+/****************************************************************************
+ * Name: cubic_loss
+ *
+ * Description:
+ *   A segment was lost:  Reduce the window to beta times its size.
+ *
+ ****************************************************************************/
+
+static void cubic_loss(FAR struct tcp_conn_s *conn)
+{
+  cubic_reduce(conn);
+  conn->cwnd = conn->ssthresh;
+}
+
+/****************************************************************************
+ * Name: cubic_timeout
+ *
+ * Description:
+ *   The retransmission timer expired:  Reduce the slow start threshold and
+ *   restart from a window of one segment.
+ *
+ ****************************************************************************/
+
+static void cubic_timeout(FAR struct tcp_conn_s *conn)
+{
+  cubic_reduce(conn);
+  conn->cwnd = conn->mss;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_CC_CUBIC */
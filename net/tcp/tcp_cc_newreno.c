@@ -0,0 +1,156 @@
+/****************************************************************************
+ * net/tcp/tcp_cc_newreno.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && \
+    defined(CONFIG_NET_TCP_CC_NEWRENO)
+
+#include <stdint.h>
+
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void newreno_init(FAR struct tcp_conn_s *conn);
+static void newreno_ack(FAR struct tcp_conn_s *conn, uint32_t acked);
+static void newreno_loss(FAR struct tcp_conn_s *conn);
+static void newreno_timeout(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_newreno =
+{
+  "newreno",         /* name */
+  newreno_init,      /* init */
+  newreno_ack,       /* ack */
+  newreno_loss,      /* loss */
+  newreno_timeout    /* timeout */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: newreno_ssthresh
+ *
+ * Description:
+ *   Return the slow start threshold after a loss:  Half of the data in
+ *   flight, but no less than two segments (RFC 5681).
+ *
+ ****************************************************************************/
+
+static uint32_t newreno_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  uint32_t ssthresh = conn->unacked / 2;
+
+  if (ssthresh < 2 * (uint32_t)conn->mss)
+    {
+      ssthresh = 2 * (uint32_t)conn->mss;
+    }
+
+  return ssthresh;
+}
+
+/****************************************************************************
+ * Name: newreno_init
+ *
+ * Description:
+ *   Initialize the algorithm's state.  NewReno has no state of its own.
+ *
+ ****************************************************************************/
+
+static void newreno_init(FAR struct tcp_conn_s *conn)
+{
+}
+
+/****************************************************************************
+ * Name: newreno_ack
+ *
+ * Description:
+ *   Congestion avoidance:  Grow the window by one segment for each window
+ *   of data acknowledged, i.e., by one segment per round trip.
+ *
+ ****************************************************************************/
+
+static void newreno_ack(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  conn->ccbytes += acked;
+  if (conn->ccbytes >= conn->cwnd)
+    {
+      conn->ccbytes -= conn->cwnd;
+      conn->cwnd    += conn->mss;
+    }
+}
+
+/****************************************************************************
+ * Name: newreno_loss
+ *
+ * Description:
+ *   A segment was lost:  Halve the window.
+ *
+ ****************************************************************************/
+
+static void newreno_loss(FAR struct tcp_conn_s *conn)
+{
+  conn->ssthresh = newreno_ssthresh(conn);
+  conn->cwnd     = conn->ssthresh;
+  conn->ccbytes  = 0;
+}
+
+/****************************************************************************
+ * Name: newreno_timeout
+ *
+ * Description:
+ *   The retransmission timer expired:  Halve the slow start threshold and
+ *   restart from a window of one segment.
+ *
+ ****************************************************************************/
+
+static void newreno_timeout(FAR struct tcp_conn_s *conn)
+{
+  conn->ssthresh = newreno_ssthresh(conn);
+  conn->cwnd     = conn->mss;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_CC_NEWRENO */
@@ -55,6 +55,7 @@
 #include <arch/irq.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -64,6 +65,7 @@
 #include "devif/devif.h"
 #include "inet/inet.h"
 #include "tcp/tcp.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -72,6 +74,11 @@
 #define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+#if defined(CONFIG_NET_TCP_CONNHASH) && \
+    (CONFIG_NET_TCP_CONNHASH_SIZE & (CONFIG_NET_TCP_CONNHASH_SIZE - 1)) != 0
+#  error CONFIG_NET_TCP_CONNHASH_SIZE must be a power of two
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -88,6 +95,15 @@ static dq_queue_t g_free_tcp_connections;
 
 static dq_queue_t g_active_tcp_connections;
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+/* The active connections again, hashed on the local port, remote port and
+ * remote address so that incoming segments can be matched without
+ * searching the whole active list.
+ */
+
+static FAR struct tcp_conn_s *g_tcp_hashtab[CONFIG_NET_TCP_CONNHASH_SIZE];
+#endif
+
 /* Last port used by a TCP connection connection. */
 
 static uint16_t g_last_tcp_port;
@@ -96,6 +112,97 @@ static uint16_t g_last_tcp_port;
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_conn_hash
+ *
+ * Description:
+ *   Return the hash table index of an active connection.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONNHASH
+static unsigned int tcp_conn_hash(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      return TCP_HASH(conn->lport, conn->rport, conn->u.ipv4.raddr);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      return TCP_HASH(conn->lport, conn->rport,
+                      TCP_IPv6_HASHADDR(conn->u.ipv6.raddr));
+    }
+#endif /* CONFIG_NET_IPv6 */
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_hash_insert
+ *
+ * Description:
+ *   Add a connection to the tail of its hash chain.  Connections are
+ *   inserted when they are added to the active list, so each chain keeps
+ *   the oldest-first order of that list and lookups return the same
+ *   connection that the linear search would.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONNHASH
+static void tcp_hash_insert(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **link = &g_tcp_hashtab[tcp_conn_hash(conn)];
+
+  while (*link != NULL)
+    {
+      link = &(*link)->hnext;
+    }
+
+  conn->hnext = NULL;
+  *link       = conn;
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_hash_remove
+ *
+ * Description:
+ *   Remove a connection from its hash chain.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONNHASH
+static void tcp_hash_remove(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **link = &g_tcp_hashtab[tcp_conn_hash(conn)];
+
+  while (*link != NULL)
+    {
+      if (*link == conn)
+        {
+          *link       = conn->hnext;
+          conn->hnext = NULL;
+          break;
+        }
+
+      link = &(*link)->hnext;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: tcp_ipv4_listener
  *
@@ -327,10 +434,16 @@ static inline FAR struct tcp_conn_s *
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+  conn       = g_tcp_hashtab[TCP_HASH(tcp->destport, tcp->srcport,
+                                      srcipaddr)];
+#else
+  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
+
   while (conn)
     {
       /* Find an open connection matching the TCP input. The following
@@ -366,7 +479,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+      conn = conn->hnext;
+#else
       conn = (FAR struct tcp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -394,10 +511,16 @@ static inline FAR struct tcp_conn_s *
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+  conn       = g_tcp_hashtab[TCP_HASH(tcp->destport, tcp->srcport,
+                                      TCP_IPv6_HASHADDR(ip->srcipaddr))];
+#else
+  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
+
   while (conn)
     {
       /* Find an open connection matching the TCP input. The following
@@ -433,7 +556,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+      conn = conn->hnext;
+#else
       conn = (FAR struct tcp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -572,6 +699,45 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 }
 #endif /* CONFIG_NET_IPv6 */
 
+/****************************************************************************
+ * Name: tcp_initoptions
+ *
+ * Description:
+ *   Select all of the TCP options that we support for a new connection.
+ *   These are offered in (or accepted from) the SYN and reduced to those
+ *   that the peer also supports when its SYN or SYN-ACK is received.
+ *
+ * Input Parameters:
+ *   conn - The new TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef TCP_HAVE_OPTIONS
+static void tcp_initoptions(FAR struct tcp_conn_s *conn)
+{
+  conn->tcpopts    = 0;
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  conn->tcpopts   |= TCP_OPTF_WS;
+  conn->snd_wscale = 0;
+  conn->rcv_wscale = tcp_wscale_shift();
+#endif
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  conn->tcpopts   |= TCP_OPTF_TS;
+  conn->ts_recent  = 0;
+  conn->rtt        = 0;
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+  conn->tcpopts   |= TCP_OPTF_SACK;
+#endif
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -715,6 +881,10 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
     {
       memset(conn, 0, sizeof(struct tcp_conn_s));
       conn->tcpstateflags = TCP_ALLOCATED;
+#ifdef CONFIG_NET_TCP_READAHEAD
+      nxsem_init(&conn->rdlock, 0, 1);
+      nxsem_init(&conn->rcvlock, 0, 1);
+#endif
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
       conn->domain        = domain;
 #endif
@@ -773,12 +943,17 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       /* Remove the connection from the active list */
 
       dq_rem(&conn->node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_CONNHASH
+      tcp_hash_remove(conn);
+#endif
     }
 
 #ifdef CONFIG_NET_TCP_READAHEAD
   /* Release any read-ahead buffers attached to the connection */
 
   iob_free_queue(&conn->readahead, IOBUSER_NET_TCP_READAHEAD);
+  nxsem_destroy(&conn->rdlock);
+  nxsem_destroy(&conn->rcvlock);
 #endif
 
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
@@ -879,6 +1054,50 @@ FAR struct tcp_conn_s *tcp_nextconn(FAR struct tcp_conn_s *conn)
     }
 }
 
+/****************************************************************************
+ * Name: tcp_hashstats
+ *
+ * Description:
+ *   Return the occupancy of the active connection hash table.
+ *
+ * Assumptions:
+ *   Called from normal user code.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONNHASH
+void tcp_hashstats(FAR struct net_hashstat_s *stats)
+{
+  FAR struct tcp_conn_s *conn;
+  unsigned int len;
+  int i;
+
+  memset(stats, 0, sizeof(struct net_hashstat_s));
+  stats->nbuckets = CONFIG_NET_TCP_CONNHASH_SIZE;
+
+  net_lock();
+  for (i = 0; i < CONFIG_NET_TCP_CONNHASH_SIZE; i++)
+    {
+      for (len = 0, conn = g_tcp_hashtab[i]; conn; conn = conn->hnext)
+        {
+          len++;
+        }
+
+      if (len > 0)
+        {
+          stats->nused++;
+          stats->nentries += len;
+          if (len > stats->maxchain)
+            {
+              stats->maxchain = len;
+            }
+        }
+    }
+
+  net_unlock();
+}
+#endif
+
 /****************************************************************************
  * Name: tcp_alloc_accept
  *
@@ -1015,6 +1234,9 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
       conn->sent          = 0;
       conn->sndseq_max    = 0;
 #endif
+#ifdef TCP_HAVE_OPTIONS
+      tcp_initoptions(conn);
+#endif
 
       /* rcvseq should be the seqno from the incoming packet + 1. */
 
@@ -1038,6 +1260,9 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        */
 
       dq_addlast(&conn->node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_CONNHASH
+      tcp_hash_insert(conn);
+#endif
     }
 
   return conn;
@@ -1256,6 +1481,9 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   conn->sent       = 0;
   conn->sndseq_max = 0;
 #endif
+#ifdef TCP_HAVE_OPTIONS
+  tcp_initoptions(conn);
+#endif
 
 #ifdef CONFIG_NET_TCP_READAHEAD
   /* Initialize the list of TCP read-ahead buffers */
@@ -1273,6 +1501,9 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   /* And, finally, put the connection structure into the active list. */
 
   dq_addlast(&conn->node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_CONNHASH
+  tcp_hash_insert(conn);
+#endif
   ret = OK;
 
 errout_with_lock:
@@ -68,10 +68,217 @@
 
 #define IPv4BUF ((FAR struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The options of a received TCP segment */
+
+struct tcp_options_s
+{
+  uint8_t  flags;          /* Options present (see TCP_OPTF_*) */
+  uint8_t  wscale;         /* Window scale shift */
+  uint16_t mss;            /* Maximum segment size (zero if not present) */
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  uint32_t tsval;          /* Timestamp value */
+  uint32_t tsecr;          /* Timestamp echo reply */
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+  uint8_t  nsack;          /* Number of SACK blocks */
+  uint32_t sack[TCP_SACK_NBLOCKS][2];
+#endif
+};
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_parse_options
+ *
+ * Description:
+ *   Parse the options of a received TCP segment.  Options that are not
+ *   supported are skipped and parsing stops at the first malformed option.
+ *
+ * Input Parameters:
+ *   tcp  - The TCP header of the received segment
+ *   opts - The location to return the options
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void tcp_parse_options(FAR struct tcp_hdr_s *tcp,
+                              FAR struct tcp_options_s *opts)
+{
+  FAR uint8_t *optdata = (FAR uint8_t *)tcp + TCP_HDRLEN;
+  unsigned int optlen = (tcp->tcpoffset >> 4) << 2;
+  unsigned int i = 0;
+  uint8_t len;
+
+  memset(opts, 0, sizeof(struct tcp_options_s));
+
+  optlen = optlen > TCP_HDRLEN ? optlen - TCP_HDRLEN : 0;
+  while (i < optlen)
+    {
+      if (optdata[i] == TCP_OPT_END)
+        {
+          /* End of options. */
+
+          break;
+        }
+      else if (optdata[i] == TCP_OPT_NOOP)
+        {
+          /* NOP option. */
+
+          i++;
+          continue;
+        }
+
+      /* All other options have a length field, so that we easily can skip
+       * past them.  If the length is invalid, the options are malformed and
+       * we don't process them further.
+       */
+
+      if (i + 1 >= optlen)
+        {
+          break;
+        }
+
+      len = optdata[i + 1];
+      if (len < 2 || i + len > optlen)
+        {
+          break;
+        }
+
+      switch (optdata[i])
+        {
+          case TCP_OPT_MSS:
+            if (len == TCP_OPT_MSS_LEN)
+              {
+                opts->mss = ((uint16_t)optdata[i + 2] << 8) |
+                            (uint16_t)optdata[i + 3];
+              }
+            break;
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+          case TCP_OPT_WS:
+            if (len == TCP_OPT_WS_LEN)
+              {
+                opts->flags |= TCP_OPTF_WS;
+                opts->wscale = optdata[i + 2] > TCP_WS_MAXSHIFT ?
+                               TCP_WS_MAXSHIFT : optdata[i + 2];
+              }
+            break;
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+          case TCP_OPT_SACK_PERM:
+            if (len == TCP_OPT_SACK_PERM_LEN)
+              {
+                opts->flags |= TCP_OPTF_SACK;
+              }
+            break;
+
+          case TCP_OPT_SACK:
+            {
+              unsigned int j;
+
+              for (j = 2; j + 8 <= len && opts->nsack < TCP_SACK_NBLOCKS;
+                   j += 8)
+                {
+                  opts->sack[opts->nsack][0] =
+                    tcp_getsequence(&optdata[i + j]);
+                  opts->sack[opts->nsack][1] =
+                    tcp_getsequence(&optdata[i + j + 4]);
+                  opts->nsack++;
+                }
+            }
+            break;
+#endif
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+          case TCP_OPT_TS:
+            if (len == TCP_OPT_TS_LEN)
+              {
+                opts->flags |= TCP_OPTF_TS;
+                opts->tsval  = tcp_getsequence(&optdata[i + 2]);
+                opts->tsecr  = tcp_getsequence(&optdata[i + 6]);
+              }
+            break;
+#endif
+
+          default:
+            break;
+        }
+
+      i += len;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_synoptions
+ *
+ * Description:
+ *   Apply the options of a received SYN or SYN-ACK segment to a new
+ *   connection:  Set the MSS and keep only those of the options that we
+ *   support (or offered in our SYN) that the peer also included.
+ *
+ * Input Parameters:
+ *   dev   - The device driver structure containing the received segment
+ *   conn  - The new TCP connection
+ *   opts  - The options of the received segment
+ *   iplen - Length of the IP header (IPv4_HDRLEN or IPv6_HDRLEN).
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void tcp_synoptions(FAR struct net_driver_s *dev,
+                           FAR struct tcp_conn_s *conn,
+                           FAR struct tcp_options_s *opts,
+                           unsigned int iplen)
+{
+  if (opts->mss != 0)
+    {
+      uint16_t tcp_mss = TCP_MSS(dev, iplen);
+
+      conn->mss = opts->mss > tcp_mss ? tcp_mss : opts->mss;
+    }
+
+#ifdef TCP_HAVE_OPTIONS
+  conn->tcpopts &= opts->flags;
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* Window scaling is used in both directions or not at all */
+
+  if ((conn->tcpopts & TCP_OPTF_WS) != 0)
+    {
+      conn->snd_wscale = opts->wscale;
+    }
+  else
+    {
+      conn->snd_wscale = 0;
+      conn->rcv_wscale = 0;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  /* Every segment will now carry the timestamps option.  Reduce the MSS
+   * accordingly.
+   */
+
+  if ((conn->tcpopts & TCP_OPTF_TS) != 0)
+    {
+      conn->ts_recent = opts->tsval;
+      conn->mss      -= TCP_OPT_TS_PADLEN;
+    }
+#endif
+#endif
+}
+
 /****************************************************************************
  * Name: tcp_input
  *
@@ -96,14 +303,19 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 {
   FAR struct tcp_hdr_s *tcp;
   FAR struct tcp_conn_s *conn = NULL;
+  struct tcp_options_s opts;
   unsigned int tcpiplen;
-  unsigned int hdrlen;
   uint16_t tmp16;
   uint16_t flags;
   uint16_t result;
-  uint8_t  opt;
+#ifdef CONFIG_NET_TCP_CC
+  uint32_t oldwnd;
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  int      rttsample = -1;
+#endif
+  unsigned int txhdrlen;
   int      len;
-  int      i;
 
 #ifdef CONFIG_NET_STATISTICS
   /* Bump up the count of TCP packets received */
@@ -117,23 +329,22 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
   tcp = (FAR struct tcp_hdr_s *)&dev->d_buf[iplen + NET_LL_HDRLEN(dev)];
 
-  /* Get the size of the IP header and the TCP header.
-   *
-   * REVISIT:  TCP header is *not* a constant!  It can be larger if the
-   * TCP header includes options.  The constant TCP_HDRLEN should be
-   * replaced with the macro TCP_OPT_HDRLEN(n) which will calculate the
-   * correct header length in all cases.
+  /* Get the size of the IP header and the TCP header (without options) of
+   * the responses that we send.  The size of the received TCP header is
+   * given by tcpoffset.
    */
 
   tcpiplen = iplen + TCP_HDRLEN;
 
-  /* Get the size of the link layer header, the IP header, and the TCP header */
-
-  hdrlen = tcpiplen + NET_LL_HDRLEN(dev);
-
-  /* Start of TCP input header processing code. */
+  /* Start of TCP input header processing code.  The checksum need not be
+   * computed again if the driver has already verified it.
+   */
 
-  if (tcp_chksum(dev) != 0xffff)
+  if (dev->d_rxchksum)
+    {
+      dev->d_rxchksum = false;
+    }
+  else if (tcp_chksum(dev) != 0xffff)
     {
       /* Compute and check the TCP checksum. */
 
@@ -239,59 +450,10 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
           net_incr32(conn->rcvseq, 1);
 
-          /* Parse the TCP MSS option, if present. */
+          /* Parse the TCP options and select those that we will use */
 
-          if ((tcp->tcpoffset & 0xf0) > 0x50)
-            {
-              for (i = 0; i < ((tcp->tcpoffset >> 4) - 5) << 2 ; )
-                {
-                  opt = dev->d_buf[hdrlen + i];
-                  if (opt == TCP_OPT_END)
-                    {
-                      /* End of options. */
-
-                      break;
-                    }
-                  else if (opt == TCP_OPT_NOOP)
-                    {
-                      /* NOP option. */
-
-                      ++i;
-                    }
-                  else if (opt == TCP_OPT_MSS &&
-                          dev->d_buf[hdrlen + 1 + i] == TCP_OPT_MSS_LEN)
-                    {
-                      uint16_t tcp_mss = TCP_MSS(dev, iplen);
-
-                      /* An MSS option with the right option length. */
-
-                      tmp16 = ((uint16_t)dev->d_buf[hdrlen + 2 + i] << 8) |
-                               (uint16_t)dev->d_buf[hdrlen + 3 + i];
-                      conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
-
-                      /* And we are done processing options. */
-
-                      break;
-                    }
-                  else
-                    {
-                      /* All other options have a length field, so that we
-                       * easily can skip past them.
-                       */
-
-                      if (dev->d_buf[hdrlen + 1 + i] == 0)
-                        {
-                          /* If the length field is zero, the options are
-                           * malformed and we don't process them further.
-                           */
-
-                          break;
-                        }
-
-                      i += dev->d_buf[hdrlen + 1 + i];
-                    }
-                }
-            }
+          tcp_parse_options(tcp, &opts);
+          tcp_synoptions(dev, conn, &opts, iplen);
 
           /* Our response will be a SYNACK. */
 
@@ -323,10 +485,26 @@ reset:
 
 found:
 
+  /* Parse the TCP options */
+
+  tcp_parse_options(tcp, &opts);
+
   /* Update the connection's window size */
 
+#ifdef CONFIG_NET_TCP_CC
+  oldwnd        = conn->winsize;
+#endif
   conn->winsize = ((uint16_t)tcp->wnd[0] << 8) + (uint16_t)tcp->wnd[1];
 
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* The window in a SYN segment is never scaled */
+
+  if ((conn->tcpopts & TCP_OPTF_WS) != 0 && (tcp->flags & TCP_SYN) == 0)
+    {
+      conn->winsize <<= conn->snd_wscale;
+    }
+#endif
+
   flags = 0;
 
   /* We do a very naive form of TCP reset processing; we just accept
@@ -393,10 +571,43 @@ found:
 
   /* d_len will contain the length of the actual TCP data. This is
    * calculated by subtracting the length of the TCP header (in
-   * len) and the length of the IP header.
+   * len) and the length of the IP header.  The data follows the TCP
+   * header, including any options.
    */
 
-  dev->d_len -= (len + iplen);
+  dev->d_len    -= (len + iplen);
+
+  /* The application callbacks may also send, writing up to MSS bytes at
+   * d_appdata.  The MSS allows only for our own options, so the data may
+   * not be further into d_buf than it would be in a segment that we send.
+   * If the peer's options are longer than ours, move the data down.
+   */
+
+  txhdrlen = TCP_HDRLEN;
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  /* In SYN_SENT, the timestamps option has been offered but may not be
+   * accepted.  The MSS has not yet been reduced for it.
+   */
+
+  if ((conn->tcpopts & TCP_OPTF_TS) != 0 &&
+      (conn->tcpstateflags & TCP_STATE_MASK) != TCP_SYN_SENT)
+    {
+      txhdrlen += TCP_OPT_TS_PADLEN;
+    }
+#endif
+
+  if (len > txhdrlen)
+    {
+      if (dev->d_len > 0)
+        {
+          memmove((FAR uint8_t *)tcp + txhdrlen, (FAR uint8_t *)tcp + len,
+                  dev->d_len);
+        }
+
+      len = txhdrlen;
+    }
+
+  dev->d_appdata = (FAR uint8_t *)tcp + len;
 
 #ifdef CONFIG_NET_TCP_KEEPALIVE
   /* Check for a to KeepAlive probes.  These packets have these properties:
@@ -466,6 +677,19 @@ found:
         }
     }
 
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  /* The segment is in sequence:  Remember the peer's timestamp so that it
+   * will be echoed in our next segment (RFC 7323).
+   */
+
+  if ((conn->tcpopts & TCP_OPTF_TS) != 0 &&
+      (opts.flags & TCP_OPTF_TS) != 0 &&
+      TCP_SEQ_GTE(opts.tsval, conn->ts_recent))
+    {
+      conn->ts_recent = opts.tsval;
+    }
+#endif
+
   /* Check if the incoming segment acknowledges any outstanding data. If so,
    * we update the sequence number, reset the length of the outstanding
    * data, calculate RTT estimations, and reset the retransmission timer.
@@ -502,6 +726,27 @@ found:
 
       if (ackseq <= unackseq)
         {
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+          /* If the segment acknowledges new data, measure the round trip
+           * time from the timestamp that it echoes.
+           */
+
+          if ((conn->tcpopts & TCP_OPTF_TS) != 0 &&
+              (opts.flags & TCP_OPTF_TS) != 0 && opts.tsecr != 0 &&
+              unackseq - ackseq < conn->unacked)
+            {
+              conn->rtt  = TCP_CLOCK() - opts.tsecr;
+              rttsample  = (conn->rtt + TCP_HSEC_MS - 1) / TCP_HSEC_MS;
+
+              /* Keep the scaled estimate within its 8-bit state */
+
+              if (rttsample > 31)
+                {
+                  rttsample = 31;
+                }
+            }
+#endif
+
           /* Calculate the new number of outstanding, unacknowledged bytes */
 
           conn->unacked = unackseq - ackseq;
@@ -534,12 +779,30 @@ found:
             tcp_getsequence(conn->sndseq), ackseq, unackseq, conn->unacked);
       tcp_setsequence(conn->sndseq, ackseq);
 
-      /* Do RTT estimation, unless we have done retransmissions. */
+      /* Do RTT estimation.  A measurement from the timestamps option is
+       * used if there is one; it is valid even after retransmissions
+       * (RFC 7323).  Otherwise, estimate from the retransmission timer
+       * unless we have done retransmissions.
+       */
 
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+      if (rttsample >= 0 || conn->nrtx == 0)
+#else
       if (conn->nrtx == 0)
+#endif
         {
           signed char m;
-          m = conn->rto - conn->timer;
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+          if (rttsample >= 0)
+            {
+              m = rttsample;
+            }
+          else
+#endif
+            {
+              m = conn->rto - conn->timer;
+            }
 
           /* This is taken directly from VJs original code in his paper */
 
@@ -555,6 +818,29 @@ found:
           conn->rto = (conn->sa >> 3) + conn->sv;
         }
 
+#ifdef CONFIG_NET_TCP_CC
+      /* Update the congestion control state.  A duplicate ACK acknowledges
+       * nothing new, carries no data, and does not change the window
+       * (RFC 5681).
+       */
+
+      if ((conn->tcpstateflags & TCP_STATE_MASK) == TCP_ESTABLISHED)
+        {
+#ifdef CONFIG_NET_TCP_SACK
+          if ((conn->tcpopts & TCP_OPTF_SACK) != 0)
+            {
+              conn->nsack = opts.nsack;
+              memcpy(conn->sack, opts.sack, sizeof(conn->sack));
+            }
+#endif
+
+          tcp_cc_ackinput(conn, ackseq,
+                          ackseq == conn->snduna && dev->d_len == 0 &&
+                          (tcp->flags & (TCP_SYN | TCP_FIN)) == 0 &&
+                          conn->winsize == oldwnd);
+        }
+#endif
+
       /* Set the acknowledged flag. */
 
       flags |= TCP_ACKDATA;
@@ -618,6 +904,9 @@ found:
             tcp_setsequence(conn->sndseq, conn->isn);
             conn->sent          = 0;
             conn->sndseq_max    = 0;
+#endif
+#ifdef CONFIG_NET_TCP_CC
+            tcp_cc_initialize(conn);
 #endif
             conn->unacked       = 0;
             flags               = TCP_CONNECTED;
@@ -655,60 +944,9 @@ found:
         if ((flags & TCP_ACKDATA) != 0 &&
             (tcp->flags & TCP_CTL) == (TCP_SYN | TCP_ACK))
           {
-            /* Parse the TCP MSS option, if present. */
+            /* Select the TCP options that we will use */
 
-            if ((tcp->tcpoffset & 0xf0) > 0x50)
-              {
-                for (i = 0; i < ((tcp->tcpoffset >> 4) - 5) << 2 ; )
-                  {
-                    opt = dev->d_buf[hdrlen + i];
-                    if (opt == TCP_OPT_END)
-                      {
-                        /* End of options. */
-
-                        break;
-                      }
-                    else if (opt == TCP_OPT_NOOP)
-                      {
-                        /* NOP option. */
-
-                        ++i;
-                      }
-                    else if (opt == TCP_OPT_MSS &&
-                              dev->d_buf[hdrlen + 1 + i] == TCP_OPT_MSS_LEN)
-                      {
-                        uint16_t tcp_mss = TCP_MSS(dev, iplen);
-
-                        /* An MSS option with the right option length. */
-
-                        tmp16 =
-                          (dev->d_buf[hdrlen + 2 + i] << 8) |
-                          dev->d_buf[hdrlen + 3 + i];
-                        conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
-
-                        /* And we are done processing options. */
-
-                        break;
-                      }
-                    else
-                      {
-                        /* All other options have a length field, so that we
-                         * easily can skip past them.
-                         */
-
-                        if (dev->d_buf[hdrlen + 1 + i] == 0)
-                          {
-                            /* If the length field is zero, the options are
-                             * malformed and we don't process them further.
-                             */
-
-                            break;
-                          }
-
-                        i += dev->d_buf[hdrlen + 1 + i];
-                      }
-                  }
-              }
+            tcp_synoptions(dev, conn, &opts, iplen);
 
             conn->tcpstateflags = TCP_ESTABLISHED;
             memcpy(conn->rcvseq, tcp->seqno, 4);
@@ -719,6 +957,9 @@ found:
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
             conn->isn           = tcp_getsequence(tcp->ackno);
             tcp_setsequence(conn->sndseq, conn->isn);
+#endif
+#ifdef CONFIG_NET_TCP_CC
+            tcp_cc_initialize(conn);
 #endif
             dev->d_len          = 0;
             dev->d_sndlen       = 0;
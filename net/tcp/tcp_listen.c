@@ -46,6 +46,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include <debug.h>
 
 #include <nuttx/net/netconfig.h>
@@ -53,6 +54,7 @@
 
 #include "devif/devif.h"
 #include "tcp/tcp.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Private Data
@@ -60,7 +62,18 @@
 
 /* The tcp_listenports list all currently listening ports. */
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+/* The listening connections hashed on the local port number.  The number
+ * of listeners is still bounded by CONFIG_NET_MAX_LISTENPORTS.  The order
+ * of a chain does not matter: tcp_listen() refuses a second listener on
+ * the same port (and domain), so at most one entry can match.
+ */
+
+static FAR struct tcp_conn_s *g_tcp_listenhash[CONFIG_NET_TCP_CONNHASH_SIZE];
+static unsigned int g_tcp_nlisteners;
+#else
 static FAR struct tcp_conn_s *tcp_listenports[CONFIG_NET_MAX_LISTENPORTS];
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -83,6 +96,25 @@ FAR struct tcp_conn_s *tcp_findlistener(uint16_t portno, uint8_t domain)
 FAR struct tcp_conn_s *tcp_findlistener(uint16_t portno)
 #endif
 {
+#ifdef CONFIG_NET_TCP_CONNHASH
+  FAR struct tcp_conn_s *conn;
+
+  /* Examine each connection structure in the hash chain for this port */
+
+  for (conn = g_tcp_listenhash[TCP_HASH(portno, 0, 0)];
+       conn != NULL;
+       conn = conn->hnext)
+    {
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+      if (conn->lport == portno && conn->domain == domain)
+#else
+      if (conn->lport == portno)
+#endif
+        {
+          return conn;
+        }
+    }
+#else
   int ndx;
 
   /* Examine each connection structure in each slot of the listener list */
@@ -105,6 +137,7 @@ FAR struct tcp_conn_s *tcp_findlistener(uint16_t portno)
           return conn;
         }
     }
+#endif
 
   /* No listener for this port */
 
@@ -129,11 +162,16 @@ FAR struct tcp_conn_s *tcp_findlistener(uint16_t portno)
 
 void tcp_listen_initialize(void)
 {
+#ifdef CONFIG_NET_TCP_CONNHASH
+  memset(g_tcp_listenhash, 0, sizeof(g_tcp_listenhash));
+  g_tcp_nlisteners = 0;
+#else
   int ndx;
   for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
     {
       tcp_listenports[ndx] = NULL;
     }
+#endif
 }
 
 /****************************************************************************
@@ -149,10 +187,30 @@ void tcp_listen_initialize(void)
 
 int tcp_unlisten(FAR struct tcp_conn_s *conn)
 {
+#ifdef CONFIG_NET_TCP_CONNHASH
+  FAR struct tcp_conn_s **link;
+#else
   int ndx;
+#endif
   int ret = -EINVAL;
 
   net_lock();
+
+#ifdef CONFIG_NET_TCP_CONNHASH
+  for (link = &g_tcp_listenhash[TCP_HASH(conn->lport, 0, 0)];
+       *link != NULL;
+       link = &(*link)->hnext)
+    {
+      if (*link == conn)
+        {
+          *link       = conn->hnext;
+          conn->hnext = NULL;
+          g_tcp_nlisteners--;
+          ret         = OK;
+          break;
+        }
+    }
+#else
   for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
     {
       if (tcp_listenports[ndx] == conn)
@@ -162,6 +220,7 @@ int tcp_unlisten(FAR struct tcp_conn_s *conn)
           break;
         }
     }
+#endif
 
   net_unlock();
   return ret;
@@ -180,7 +239,11 @@ int tcp_unlisten(FAR struct tcp_conn_s *conn)
 
 int tcp_listen(FAR struct tcp_conn_s *conn)
 {
+#ifdef CONFIG_NET_TCP_CONNHASH
+  int hash;
+#else
   int ndx;
+#endif
   int ret;
 
   /* This must be done with network locked because the listener table
@@ -209,6 +272,18 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
 
       ret = -ENOBUFS; /* Assume failure */
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+      /* Add the connection to the head of the hash chain for its port */
+
+      if (g_tcp_nlisteners < CONFIG_NET_MAX_LISTENPORTS)
+        {
+          hash                   = TCP_HASH(conn->lport, 0, 0);
+          conn->hnext            = g_tcp_listenhash[hash];
+          g_tcp_listenhash[hash] = conn;
+          g_tcp_nlisteners++;
+          ret                    = OK;
+        }
+#else
       /* Search all slots until an available slot is found */
 
       for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
@@ -224,12 +299,57 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
               break;
             }
         }
+#endif
     }
 
   net_unlock();
   return ret;
 }
 
+/****************************************************************************
+ * Name: tcp_listen_hashstats
+ *
+ * Description:
+ *   Return the occupancy of the listener hash table.
+ *
+ * Assumptions:
+ *   Called from normal user code.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONNHASH
+void tcp_listen_hashstats(FAR struct net_hashstat_s *stats)
+{
+  FAR struct tcp_conn_s *conn;
+  unsigned int len;
+  int i;
+
+  memset(stats, 0, sizeof(struct net_hashstat_s));
+  stats->nbuckets = CONFIG_NET_TCP_CONNHASH_SIZE;
+
+  net_lock();
+  for (i = 0; i < CONFIG_NET_TCP_CONNHASH_SIZE; i++)
+    {
+      for (len = 0, conn = g_tcp_listenhash[i]; conn; conn = conn->hnext)
+        {
+          len++;
+        }
+
+      if (len > 0)
+        {
+          stats->nused++;
+          stats->nentries += len;
+          if (len > stats->maxchain)
+            {
+              stats->maxchain = len;
+            }
+        }
+    }
+
+  net_unlock();
+}
+#endif
+
 /****************************************************************************
  * Name: tcp_islistener
  *
@@ -45,6 +45,7 @@
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/net.h>
@@ -54,6 +55,7 @@
 #include "socket/socket.h"
 #include "inet/inet.h"
 #include "tcp/tcp.h"
+#include "utils/utils.h"
 
 #ifdef HAVE_TCP_POLL
 
@@ -151,8 +153,7 @@ static uint16_t tcp_poll_eventhandler(FAR struct net_driver_s *dev,
           info->cb->priv    = NULL;
           info->cb->event   = NULL;
 
-          info->fds->revents |= eventset;
-          nxsem_post(info->fds->sem);
+          poll_notify(&info->fds, 1, eventset);
         }
     }
 
@@ -207,8 +208,7 @@ static inline void tcp_iob_work(FAR void *arg)
            * exceptional event.
            */
 
-          fds->revents |= (POLLERR | POLLHUP);
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, POLLERR | POLLHUP);
         }
     }
 
@@ -225,8 +225,7 @@ static inline void tcp_iob_work(FAR void *arg)
         {
           /* Yes.. then signal the poll logic */
 
-          fds->revents |= POLLWRNORM;
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, POLLWRNORM);
         }
       else
         {
@@ -374,21 +373,31 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 
   fds->priv    = (FAR void *)info;
 
-#ifdef CONFIG_NET_TCPBACKLOG
-  /* Check for read data or backlogged connection availability now */
-
-  if (!IOB_QEMPTY(&conn->readahead) || tcp_backlogavailable(conn))
-#else
-  /* Check for read data availability now */
+  /* Check for read data availability now.  The read-ahead queue is
+   * protected by the connection lock, not by the network lock.
+   */
 
+  net_connlock(&conn->rdlock);
   if (!IOB_QEMPTY(&conn->readahead))
-#endif
     {
       /* Normal data may be read without blocking. */
 
       fds->revents |= (POLLRDNORM & fds->events);
     }
 
+  net_connunlock(&conn->rdlock);
+
+#ifdef CONFIG_NET_TCPBACKLOG
+  /* Check for backlogged connection availability now */
+
+  if (tcp_backlogavailable(conn))
+    {
+      /* A connection may be accepted without blocking. */
+
+      fds->revents |= (POLLRDNORM & fds->events);
+    }
+#endif
+
   /* Check for a loss of connection events.  We need to be careful here.
    * There are four possibilities:
    *
@@ -449,7 +458,7 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_notify(&fds, 1, 0);
     }
 
 #if defined(CONFIG_NET_TCP_WRITE_BUFFERS) && defined(CONFIG_IOB_NOTIFIER)
@@ -48,6 +48,7 @@
 #include <nuttx/net/tcp.h>
 
 #include "tcp/tcp.h"
+#include "utils/utils.h"
 
 #ifdef CONFIG_TCP_NOTIFIER
 
@@ -87,15 +88,20 @@ int tcp_readahead_notifier_setup(worker_t worker,
 {
 #ifdef CONFIG_NET_TCP_READAHEAD
   struct work_notifier_s info;
+  int ret;
 
   DEBUGASSERT(worker != NULL);
 
   /* If there is already buffered read-ahead data, then return zero without
-   * setting up the notification.
+   * setting up the notification.  The connection lock is held until the
+   * notification is in place so that data queued in the meantime is not
+   * missed.
    */
 
+  net_connlock(&conn->rdlock);
   if (conn->readahead.qh_head != NULL)
     {
+      net_connunlock(&conn->rdlock);
       return 0;
     }
 
@@ -107,7 +113,9 @@ int tcp_readahead_notifier_setup(worker_t worker,
   info.arg       = arg;
   info.worker    = worker;
 
-  return work_notifier_setup(&info);
+  ret = work_notifier_setup(&info);
+  net_connunlock(&conn->rdlock);
+  return ret;
 #else
   return 0;
 #endif
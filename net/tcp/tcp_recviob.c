@@ -0,0 +1,163 @@
+/****************************************************************************
+ * net/tcp/tcp_recviob.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+#include "tcp/tcp.h"
+#include "utils/utils.h"
+
+#if defined(NET_TCP_HAVE_STACK) && defined(CONFIG_NET_TCP_READAHEAD)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_tcp_recviob
+ *
+ * Description:
+ *   Receive data from a TCP socket as an I/O buffer chain rather than
+ *   copying it into a caller buffer.  If read-ahead data is queued, the
+ *   oldest queued chain is removed from the read-ahead queue and returned
+ *   without copying.  Otherwise the call waits for data as recv() does and
+ *   receives it directly into a new I/O buffer.
+ *
+ *   This is an internal OS interface for kernel consumers of socket data.
+ *   The caller owns the returned chain and must free it with
+ *   iob_free_chain(iob, IOBUSER_NET_TCP_READAHEAD).
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   iobp  - The location to return the I/O buffer chain
+ *   flags - Receive flags (MSG_DONTWAIT)
+ *
+ * Returned Value:
+ *   The number of bytes in the returned chain on success.  Zero is returned
+ *   (with *iobp set to NULL) if the peer has performed an orderly
+ *   shutdown.  Otherwise a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+ssize_t psock_tcp_recviob(FAR struct socket *psock, FAR struct iob_s **iobp,
+                          int flags)
+{
+  FAR struct tcp_conn_s *conn;
+  FAR struct iob_s *iob;
+  ssize_t ret;
+
+  DEBUGASSERT(iobp != NULL);
+  *iobp = NULL;
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  if (psock->s_type != SOCK_STREAM ||
+      (psock->s_domain != PF_INET && psock->s_domain != PF_INET6))
+    {
+      return -EOPNOTSUPP;
+    }
+
+  conn = (FAR struct tcp_conn_s *)psock->s_conn;
+  DEBUGASSERT(conn != NULL);
+
+  /* Take the oldest read-ahead chain if there is one.  A reader that is
+   * copying from the head of the queue must finish first.
+   */
+
+  net_connlock(&conn->rcvlock);
+  net_connlock(&conn->rdlock);
+  iob = iob_remove_queue(&conn->readahead);
+  net_connunlock(&conn->rdlock);
+  net_connunlock(&conn->rcvlock);
+
+  if (iob != NULL)
+    {
+      *iobp = iob;
+      return iob->io_pktlen;
+    }
+
+  /* Nothing is buffered.  Receive the next data directly into a new I/O
+   * buffer.
+   */
+
+  if (_SS_ISNONBLOCK(psock->s_flags) || (flags & MSG_DONTWAIT) != 0)
+    {
+      iob = iob_tryalloc(true, IOBUSER_NET_TCP_READAHEAD);
+      if (iob == NULL)
+        {
+          return -EAGAIN;
+        }
+    }
+  else
+    {
+      iob = iob_alloc(true, IOBUSER_NET_TCP_READAHEAD);
+      if (iob == NULL)
+        {
+          return -ENOMEM;
+        }
+    }
+
+  ret = psock_recv(psock, iob->io_data, CONFIG_IOB_BUFSIZE, flags);
+  if (ret <= 0)
+    {
+      (void)iob_free(iob, IOBUSER_NET_TCP_READAHEAD);
+      return ret;
+    }
+
+  iob->io_offset = 0;
+  iob->io_len    = ret;
+  iob->io_pktlen = ret;
+
+  *iobp = iob;
+  return ret;
+}
+
+#endif /* NET_TCP_HAVE_STACK && CONFIG_NET_TCP_READAHEAD */
@@ -70,14 +70,17 @@
  *
  ****************************************************************************/
 
-uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
+uint32_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
 {
   uint16_t iplen;
   uint16_t mss;
-  uint16_t recvwndo;
+  uint32_t recvwndo;
 #ifdef CONFIG_NET_TCP_READAHEAD
   int  niob_avail;
   int  nqentry_avail;
+#if CONFIG_IOB_NLARGE > 0
+  int  nlarge_avail;
+#endif
 #endif
 
 #ifdef CONFIG_NET_IPv6
@@ -158,14 +161,34 @@ uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
        */
 
       rwnd = (niob_avail * CONFIG_IOB_BUFSIZE) + mss;
+
+#if CONFIG_IOB_NLARGE > 0
+      /* Some of the available IOBs may be large ones.  Count no more of
+       * those than the number of IOBs that may be used.
+       */
+
+      nlarge_avail = iob_navail_large();
+      if (nlarge_avail > niob_avail)
+        {
+          nlarge_avail = niob_avail;
+        }
+
+      rwnd += nlarge_avail *
+              (uint32_t)(CONFIG_IOB_LARGE_BUFSIZE - CONFIG_IOB_BUFSIZE);
+#endif
+
+#ifndef CONFIG_NET_TCP_WINDOW_SCALE
+      /* Without window scaling, the window cannot exceed 64KiB */
+
       if (rwnd > UINT16_MAX)
         {
           rwnd = UINT16_MAX;
         }
+#endif
 
       /* Save the new receive window size */
 
-      recvwndo = (uint16_t)rwnd;
+      recvwndo = rwnd;
     }
   else /* nqentry_avail == 0 || niob_avail == 0 */
 #endif
@@ -183,3 +206,42 @@ uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
 
   return recvwndo;
 }
+
+/****************************************************************************
+ * Name: tcp_wscale_shift
+ *
+ * Description:
+ *   Return the window scale shift that we will offer to the peer.  This is
+ *   the smallest shift that can represent the largest receive window that
+ *   tcp_get_recvwindow() could return.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The window scale shift (0-TCP_WS_MAXSHIFT).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+uint8_t tcp_wscale_shift(void)
+{
+  uint32_t maxwnd;
+  uint8_t shift = 0;
+
+  /* The largest window is all of the I/O buffers, of both sizes, plus one
+   * MSS.
+   */
+
+  maxwnd = (uint32_t)CONFIG_IOB_NBUFFERS * CONFIG_IOB_BUFSIZE + UINT16_MAX;
+#if CONFIG_IOB_NLARGE > 0
+  maxwnd += (uint32_t)CONFIG_IOB_NLARGE * CONFIG_IOB_LARGE_BUFSIZE;
+#endif
+  while ((maxwnd >> shift) > UINT16_MAX && shift < TCP_WS_MAXSHIFT)
+    {
+      shift++;
+    }
+
+  return shift;
+}
+#endif
@@ -262,6 +262,17 @@ static inline void tcp_ipv6_sendcomplete(FAR struct net_driver_s *dev,
 static void tcp_sendcomplete(FAR struct net_driver_s *dev,
                              FAR struct tcp_hdr_s *tcp)
 {
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+  /* A packet with no payload (such as a pure ACK) must not refer to the
+   * I/O buffer chain of a previous packet.
+   */
+
+  if (dev->d_sndlen == 0)
+    {
+      dev->d_txiob = NULL;
+    }
+#endif
+
 #ifdef CONFIG_NET_IPv6
 #ifdef CONFIG_NET_IPv4
   if (IFF_IS_IPv6(dev->d_flags))
@@ -360,7 +371,21 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
     {
       /* Update the TCP received window based on I/O buffer availability */
 
-      uint16_t recvwndo = tcp_get_recvwindow(dev);
+      uint32_t recvwndo = tcp_get_recvwindow(dev);
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+      /* The window in a SYN segment is never scaled */
+
+      if ((conn->tcpopts & TCP_OPTF_WS) != 0 && (tcp->flags & TCP_SYN) == 0)
+        {
+          recvwndo >>= conn->rcv_wscale;
+        }
+#endif
+
+      if (recvwndo > UINT16_MAX)
+        {
+          recvwndo = UINT16_MAX;
+        }
 
       /* Set the TCP Window */
 
@@ -373,6 +398,44 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
   tcp_sendcomplete(dev, tcp);
 }
 
+/****************************************************************************
+ * Name: tcp_timestamps
+ *
+ * Description:
+ *   Write the timestamps option, preceded by two NOPs, to the TCP options.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection structure holding connection information
+ *   opt  - The location of the option in the TCP header
+ *
+ * Returned Value:
+ *   The length of the option (TCP_OPT_TS_PADLEN)
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+static unsigned int tcp_timestamps(FAR struct tcp_conn_s *conn,
+                                   FAR uint8_t *opt)
+{
+  uint32_t tsval = TCP_CLOCK();
+
+  opt[0]  = TCP_OPT_NOOP;
+  opt[1]  = TCP_OPT_NOOP;
+  opt[2]  = TCP_OPT_TS;
+  opt[3]  = TCP_OPT_TS_LEN;
+  opt[4]  = tsval >> 24;
+  opt[5]  = (tsval >> 16) & 0xff;
+  opt[6]  = (tsval >> 8) & 0xff;
+  opt[7]  = tsval & 0xff;
+  opt[8]  = conn->ts_recent >> 24;
+  opt[9]  = (conn->ts_recent >> 16) & 0xff;
+  opt[10] = (conn->ts_recent >> 8) & 0xff;
+  opt[11] = conn->ts_recent & 0xff;
+
+  return TCP_OPT_TS_PADLEN;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -388,7 +451,7 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
  *   conn   - The TCP connection structure holding connection information
  *   flags  - flags to apply to the TCP header
  *   len    - length of the message (includes the length of the IP and TCP
- *            headers)
+ *            headers, but not of any TCP options added by tcp_send())
  *
  * Returned Value:
  *   None
@@ -402,10 +465,54 @@ void tcp_send(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
               uint16_t flags, uint16_t len)
 {
   FAR struct tcp_hdr_s *tcp = tcp_header(dev);
+  FAR uint8_t *payload;
+  unsigned int optlen = 0;
+  unsigned int hdrlen;
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  /* Once negotiated, the timestamps option is sent in every segment except
+   * resets.
+   */
+
+  if ((conn->tcpopts & TCP_OPTF_TS) != 0 && (flags & TCP_RST) == 0)
+    {
+      optlen = TCP_OPT_TS_PADLEN;
+    }
+#endif
+
+  /* Any payload was written at d_appdata, which need not immediately follow
+   * the TCP header (the received segment may have carried options).  Move
+   * it so that it follows the TCP header and our options.
+   */
+
+  payload = (FAR uint8_t *)tcp + TCP_HDRLEN + optlen;
+  hdrlen  = (FAR uint8_t *)tcp - &dev->d_buf[NET_LL_HDRLEN(dev)] +
+            TCP_HDRLEN;
+
+  if (len > hdrlen && payload != (FAR uint8_t *)dev->d_appdata)
+    {
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+      /* The payload is not in d_buf if it is sent from d_txiob */
+
+      if (dev->d_txiob == NULL)
+#endif
+        {
+          memmove(payload, dev->d_appdata, len - hdrlen);
+        }
+
+      dev->d_appdata = payload;
+    }
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  if (optlen > 0)
+    {
+      tcp_timestamps(conn, (FAR uint8_t *)tcp + TCP_HDRLEN);
+    }
+#endif
 
   tcp->flags     = flags;
-  dev->d_len     = len;
-  tcp->tcpoffset = (TCP_HDRLEN / 4) << 4;
+  dev->d_len     = len + optlen;
+  tcp->tcpoffset = ((TCP_HDRLEN + optlen) / 4) << 4;
   tcp_sendcommon(dev, conn, tcp);
 }
 
@@ -569,6 +676,8 @@ void tcp_ack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
              uint8_t ack)
 {
   struct tcp_hdr_s *tcp;
+  FAR uint8_t *opt;
+  unsigned int optlen;
   uint16_t tcp_mss;
 
   /* Get values that vary with the underlying IP domain */
@@ -583,9 +692,9 @@ void tcp_ack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
       tcp     = TCPIPv6BUF;
       tcp_mss = TCP_IPv6_MSS(dev);
 
-      /* Set the packet length for the TCP Maximum Segment Size */
+      /* Set the packet length for the TCP header */
 
-      dev->d_len  = IPv6TCP_HDRLEN + TCP_OPT_MSS_LEN;
+      dev->d_len  = IPv6TCP_HDRLEN;
     }
 #endif /* CONFIG_NET_IPv6 */
 
@@ -599,9 +708,9 @@ void tcp_ack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
       tcp     = TCPIPv4BUF;
       tcp_mss = TCP_IPv4_MSS(dev);
 
-      /* Set the packet length for the TCP Maximum Segment Size */
+      /* Set the packet length for the TCP header */
 
-      dev->d_len  = IPv4TCP_HDRLEN + TCP_OPT_MSS_LEN;
+      dev->d_len  = IPv4TCP_HDRLEN;
     }
 #endif /* CONFIG_NET_IPv4 */
 
@@ -611,11 +720,48 @@ void tcp_ack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
   /* We send out the TCP Maximum Segment Size option with our ack. */
 
-  tcp->optdata[0] = TCP_OPT_MSS;
-  tcp->optdata[1] = TCP_OPT_MSS_LEN;
-  tcp->optdata[2] = tcp_mss >> 8;
-  tcp->optdata[3] = tcp_mss & 0xff;
-  tcp->tcpoffset  = ((TCP_HDRLEN + TCP_OPT_MSS_LEN) / 4) << 4;
+  opt             = (FAR uint8_t *)tcp + TCP_HDRLEN;
+  opt[0]          = TCP_OPT_MSS;
+  opt[1]          = TCP_OPT_MSS_LEN;
+  opt[2]          = tcp_mss >> 8;
+  opt[3]          = tcp_mss & 0xff;
+  optlen          = TCP_OPT_MSS_LEN;
+
+  /* Followed by the other options in conn->tcpopts.  For an active open,
+   * these are all of the options that we support; for a passive open,
+   * only those that the peer also offered in its SYN.  Each is padded
+   * with NOPs to a 32-bit boundary.
+   */
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  if ((conn->tcpopts & TCP_OPTF_WS) != 0)
+    {
+      opt[optlen++] = TCP_OPT_NOOP;
+      opt[optlen++] = TCP_OPT_WS;
+      opt[optlen++] = TCP_OPT_WS_LEN;
+      opt[optlen++] = conn->rcv_wscale;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+  if ((conn->tcpopts & TCP_OPTF_SACK) != 0)
+    {
+      opt[optlen++] = TCP_OPT_NOOP;
+      opt[optlen++] = TCP_OPT_NOOP;
+      opt[optlen++] = TCP_OPT_SACK_PERM;
+      opt[optlen++] = TCP_OPT_SACK_PERM_LEN;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  if ((conn->tcpopts & TCP_OPTF_TS) != 0)
+    {
+      optlen += tcp_timestamps(conn, &opt[optlen]);
+    }
+#endif
+
+  dev->d_len     += optlen;
+  tcp->tcpoffset  = ((TCP_HDRLEN + optlen) / 4) << 4;
 
   /* Complete the common portions of the TCP message */
 
@@ -95,6 +95,13 @@
 #define TCPIPv4BUF ((struct tcp_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev) + IPv4_HDRLEN])
 #define TCPIPv6BUF ((struct tcp_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev) + IPv6_HDRLEN])
 
+/* The largest TCP payload that will be passed to a driver that supports
+ * segmentation offload.  This leaves room for the link layer, IP, and TCP
+ * headers within the 16-bit packet length.
+ */
+
+#define TCP_MAXTSO 0xff00
+
 /* Debug */
 
 #ifdef CONFIG_NET_TCP_WRBUFFER_DUMP
@@ -291,6 +298,223 @@ static inline void send_ipselect(FAR struct net_driver_s *dev,
 }
 #endif
 
+/****************************************************************************
+ * Name: send_maxlen
+ *
+ * Description:
+ *   Return the largest amount of data that may be sent in one segment.
+ *   This is the MSS unless the driver can gather the payload from an I/O
+ *   buffer chain and segment it (see d_tsomax).  Segmentation offload is
+ *   not used for packets to our own address:  These are looped back to the
+ *   input logic by devif_loopback() which accepts only segments of up to
+ *   one MSS.
+ *
+ * Input Parameters:
+ *   dev  - The structure of the network driver that caused the event
+ *   conn - The TCP connection structure
+ *
+ * Returned Value:
+ *   The maximum segment size to use
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+static uint32_t send_maxlen(FAR struct net_driver_s *dev,
+                            FAR struct tcp_conn_s *conn)
+{
+  if ((dev->d_txcaps & NETDEV_TXCAP_IOB) == 0 ||
+      dev->d_tsomax <= conn->mss)
+    {
+      return conn->mss;
+    }
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      if (net_ipv4addr_cmp(conn->u.ipv4.raddr, dev->d_ipaddr))
+        {
+          return conn->mss;
+        }
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      if (net_ipv6addr_cmp(conn->u.ipv6.raddr, dev->d_ipv6addr))
+        {
+          return conn->mss;
+        }
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+  return dev->d_tsomax < TCP_MAXTSO ? dev->d_tsomax : TCP_MAXTSO;
+}
+#else
+#  define send_maxlen(dev,conn) ((conn)->mss)
+#endif
+
+/****************************************************************************
+ * Name: send_fastrexmit
+ *
+ * Description:
+ *   Retransmit one segment of data that the peer's duplicate ACKs indicate
+ *   has been lost (see tcp_cc.c).  The segment starts at conn->rexmitseq
+ *   (or, with SACK, at the next range that the peer has not reported as
+ *   received) and holds at most one MSS of data.  The data remains in the
+ *   write buffers and the accounting of sent and un-ACKed data is not
+ *   changed.
+ *
+ * Input Parameters:
+ *   dev  - The structure of the network driver that caused the event
+ *   conn - The TCP connection structure
+ *
+ * Returned Value:
+ *   True if a segment was set up for transmission.
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+static bool send_fastrexmit(FAR struct net_driver_s *dev,
+                            FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_wrbuffer_s *wrb = NULL;
+  FAR sq_entry_t *entry;
+  uint32_t seqno;
+  uint32_t limit;
+  uint32_t offset;
+  uint32_t sndlen;
+#ifdef CONFIG_NET_TCP_SACK
+  bool hole = false;
+  int i;
+#endif
+
+  conn->ccflags &= ~TCP_CC_REXMIT;
+
+  seqno = conn->rexmitseq;
+  if (TCP_SEQ_LT(seqno, conn->snduna))
+    {
+      seqno = conn->snduna;
+    }
+
+  limit = conn->sndseq_max;
+
+#ifdef CONFIG_NET_TCP_SACK
+  /* Skip over any data that the peer has already received.  The SACK
+   * blocks are not necessarily in sequence number order.
+   */
+
+  for (i = 0; i < conn->nsack; i++)
+    {
+      if (TCP_SEQ_GTE(seqno, conn->sack[i][0]) &&
+          TCP_SEQ_LT(seqno, conn->sack[i][1]))
+        {
+          seqno = conn->sack[i][1];
+          i     = -1;
+        }
+    }
+
+  /* The hole ends where the next received range begins.  Beyond the last
+   * received range, nothing is known to be lost.
+   */
+
+  for (i = 0; i < conn->nsack; i++)
+    {
+      if (TCP_SEQ_GT(conn->sack[i][0], seqno) &&
+          TCP_SEQ_LT(conn->sack[i][0], limit) &&
+          TCP_SEQ_GT(conn->sack[i][1], seqno))
+        {
+          limit = conn->sack[i][0];
+          hole  = true;
+        }
+    }
+
+  if (conn->nsack > 0 && !hole && seqno != conn->snduna)
+    {
+      return false;
+    }
+#endif
+
+  if (TCP_SEQ_GTE(seqno, limit))
+    {
+      return false;
+    }
+
+  /* Find the write buffer holding the data:  Either one of the sent write
+   * buffers in the unacked_q or the partially sent head of the write_q.
+   */
+
+  for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
+    {
+      wrb = (FAR struct tcp_wrbuffer_s *)entry;
+      if (TCP_SEQ_GTE(seqno, TCP_WBSEQNO(wrb)) &&
+          TCP_SEQ_LT(seqno, TCP_WBSEQNO(wrb) + TCP_WBSENT(wrb)))
+        {
+          break;
+        }
+
+      wrb = NULL;
+    }
+
+  if (wrb == NULL)
+    {
+      wrb = (FAR struct tcp_wrbuffer_s *)sq_peek(&conn->write_q);
+      if (wrb == NULL || TCP_WBSENT(wrb) == 0 ||
+          TCP_SEQ_LT(seqno, TCP_WBSEQNO(wrb)) ||
+          TCP_SEQ_GTE(seqno, TCP_WBSEQNO(wrb) + TCP_WBSENT(wrb)))
+        {
+          return false;
+        }
+    }
+
+  offset = seqno - TCP_WBSEQNO(wrb);
+  sndlen = TCP_WBSENT(wrb) - offset;
+  if (sndlen > conn->mss)
+    {
+      sndlen = conn->mss;
+    }
+
+  if (sndlen > limit - seqno)
+    {
+      sndlen = limit - seqno;
+    }
+
+  ninfo("REXMIT: wrb=%p seqno=%u sndlen=%u\n", wrb, seqno, sndlen);
+
+  /* Send the segment with its original sequence number */
+
+  tcp_setsequence(conn->sndseq, seqno);
+
+#ifdef NEED_IPDOMAIN_SUPPORT
+  send_ipselect(dev, conn);
+#endif
+
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+  if ((dev->d_txcaps & NETDEV_TXCAP_IOB) != 0)
+    {
+      devif_iob_send_nocopy(dev, TCP_WBIOB(wrb), sndlen, offset);
+    }
+  else
+#endif
+    {
+      devif_iob_send(dev, TCP_WBIOB(wrb), sndlen, offset);
+    }
+
+  conn->rexmitseq = seqno + sndlen;
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Name: psock_send_eventhandler
  *
@@ -679,21 +903,36 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       return flags;
     }
 
+#ifdef CONFIG_NET_TCP_CC
+  /* A fast retransmission requested by congestion control takes the
+   * place of new data.
+   */
+
+  if ((conn->ccflags & TCP_CC_REXMIT) != 0 &&
+      (conn->tcpstateflags & TCP_STATE_MASK) == TCP_ESTABLISHED &&
+      send_fastrexmit(dev, conn))
+    {
+      return flags & ~TCP_POLL;
+    }
+#endif
+
   /* We get here if (1) not all of the data has been ACKed, (2) we have been
    * asked to retransmit data, (3) the connection is still healthy, and (4)
    * the outgoing packet is available for our use.  In this case, we are
    * now free to send more data to receiver -- UNLESS the buffer contains
-   * unprocessed incoming data or window size is zero.  In that event, we
-   * will have to wait for the next polling cycle.
+   * unprocessed incoming data or the receiver's window (or the congestion
+   * window) is full.  In that event, we will have to wait for the next
+   * polling cycle.
    */
 
   if ((conn->tcpstateflags & TCP_ESTABLISHED) &&
       (flags & (TCP_POLL | TCP_REXMIT)) &&
       !(sq_empty(&conn->write_q)) &&
-      conn->winsize > 0)
+      TCP_SNDWND(conn) > conn->unacked)
     {
       FAR struct tcp_wrbuffer_s *wrb;
       uint32_t predicted_seqno;
+      uint32_t maxlen;
       size_t sndlen;
 
       /* Peek at the head of the write queue (but don't remove anything
@@ -706,25 +945,27 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
       /* Get the amount of data that we can send in the next packet.
        * We will send either the remaining data in the buffer I/O
-       * buffer chain, or as much as will fit given the MSS and current
-       * window size.
+       * buffer chain, or as much as will fit given the MSS (or the
+       * driver's segmentation offload limit) and the part of the current
+       * window that is not already occupied by un-ACKed data.
        */
 
+      maxlen = send_maxlen(dev, conn);
       sndlen = TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb);
-      if (sndlen > conn->mss)
+      if (sndlen > maxlen)
         {
-          sndlen = conn->mss;
+          sndlen = maxlen;
         }
 
-      if (sndlen > conn->winsize)
+      if (sndlen > TCP_SNDWND(conn) - conn->unacked)
         {
-          sndlen = conn->winsize;
+          sndlen = TCP_SNDWND(conn) - conn->unacked;
         }
 
       ninfo("SEND: wrb=%p pktlen=%u sent=%u sndlen=%u mss=%u "
             "winsize=%u\n",
             wrb, TCP_WBPKTLEN(wrb), TCP_WBSENT(wrb), sndlen, conn->mss,
-            conn->winsize);
+            TCP_SNDWND(conn));
 
       /* Set the sequence number for this segment.  If we are
        * retransmitting, then the sequence number will already
@@ -759,7 +1000,25 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
        * won't actually happen until the polling cycle completes).
        */
 
-      devif_iob_send(dev, TCP_WBIOB(wrb), sndlen, TCP_WBSENT(wrb));
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+      if ((dev->d_txcaps & NETDEV_TXCAP_IOB) != 0)
+        {
+          /* The driver will gather the payload from the I/O buffer chain
+           * and, if it is larger than the MSS, segment it.
+           */
+
+          devif_iob_send_nocopy(dev, TCP_WBIOB(wrb), sndlen,
+                                TCP_WBSENT(wrb));
+          if (sndlen > conn->mss)
+            {
+              dev->d_txmss = conn->mss;
+            }
+        }
+      else
+#endif
+        {
+          devif_iob_send(dev, TCP_WBIOB(wrb), sndlen, TCP_WBSENT(wrb));
+        }
 
       /* Remember how much data we send out now so that we know
        * when everything has been acknowledged.  Just increment
@@ -813,7 +1072,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
         }
 
       /* Only one data can be sent by low level driver at once,
-       * tell the caller stop polling the other connection.
+       * tell the caller stop polling the other connection.  The caller
+       * may poll this connection again for the next segment (see
+       * CONFIG_NET_TCP_SEND_BURST).
        */
 
       flags &= ~TCP_POLL;
@@ -936,6 +1197,8 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
   FAR struct tcp_conn_s *conn;
   FAR struct tcp_wrbuffer_s *wrb;
   ssize_t    result = 0;
+  unsigned int count;
+  int        blresult;
   int        ret = OK;
 
   if (psock == NULL || psock->s_crefs <= 0)
@@ -1053,10 +1316,46 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
       TCP_WBSEQNO(wrb) = (unsigned)-1;
       TCP_WBNRTX(wrb)  = 0;
 
-      /* Copy the user data into the write buffer.  We cannot wait for
-       * buffer space if the socket was opened non-blocking.
+      /* Copy the user data into the write buffer.  The write buffer is not
+       * yet visible to the network so the network is unlocked during the
+       * copy:  Other connections and devices may then make progress and,
+       * in the blocking case, iob_copyin() may have to wait for buffers to
+       * be freed which could never happen with the network locked.
+       */
+
+      blresult = net_breaklock(&count);
+
+      /* We cannot wait for buffer space if the socket was opened
+       * non-blocking.
+       */
+
+      if (_SS_ISNONBLOCK(psock->s_flags))
+        {
+          result = TCP_WBTRYCOPYIN(wrb, (FAR uint8_t *)buf, len);
+        }
+      else
+        {
+          result = TCP_WBCOPYIN(wrb, (FAR uint8_t *)buf, len);
+        }
+
+      if (blresult >= 0)
+        {
+          net_restorelock(count);
+        }
+
+      /* The connection may have been lost while the network was unlocked.
+       * In that case its write buffers have already been freed and the
+       * callback disabled, so the new buffer must not be queued.
        */
 
+      if (!_SS_ISCONNECTED(psock->s_flags) ||
+          (conn->tcpstateflags & TCP_STATE_MASK) == TCP_CLOSED)
+        {
+          nerr("ERROR: Connection lost during copy\n");
+          ret = -ENOTCONN;
+          goto errout_with_wrb;
+        }
+
       if (_SS_ISNONBLOCK(psock->s_flags))
         {
           /* The return value from TCP_WBTRYCOPYIN is either OK or
@@ -1067,7 +1366,6 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
            * remaining data.
            */
 
-          result = TCP_WBTRYCOPYIN(wrb, (FAR uint8_t *)buf, len);
           if (result == -ENOMEM)
             {
               if (TCP_WBPKTLEN(wrb) > 0)
@@ -1087,23 +1385,6 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
               result = len;
             }
         }
-      else
-        {
-          unsigned int count;
-          int blresult;
-
-          /* iob_copyin might wait for buffers to be freed, but if network is
-           * locked this might never happen, since network driver is also locked,
-           * therefore we need to break the lock
-           */
-
-          blresult = net_breaklock(&count);
-          result = TCP_WBCOPYIN(wrb, (FAR uint8_t *)buf, len);
-          if (blresult >= 0)
-            {
-              net_restorelock(count);
-            }
-        }
 
       /* Dump I/O buffer chain */
 
@@ -125,6 +125,9 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
   dev->d_len    = 0;
   dev->d_sndlen = 0;
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+  dev->d_txiob  = NULL;
+#endif
 
   /* Check if the connection is in a state in which we simply wait
    * for the connection to time out. If so, we increase the
@@ -332,6 +335,13 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
                      * the code for sending out the packet.
                      */
 
+#ifdef CONFIG_NET_TCP_CC
+                    /* A retransmission timeout is a sign of severe
+                     * congestion.  Shrink the congestion window.
+                     */
+
+                    tcp_cc_timeout(conn);
+#endif
                     result = tcp_callback(dev, conn, TCP_REXMIT);
                     tcp_rexmit(dev, conn, result);
                     goto done;
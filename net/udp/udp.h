@@ -45,6 +45,7 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <queue.h>
+#include <semaphore.h>
 
 #include <nuttx/clock.h>
 #include <nuttx/net/ip.h>
@@ -95,6 +96,14 @@
 
 #define _UDP_ISCONNECTMODE(f) (((f) & _UDP_FLAG_CONNECTMODE) != 0)
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+/* Hash a local port number (network order) into a bucket index */
+
+#  define UDP_HASH_MASK (CONFIG_NET_UDP_CONNHASH_SIZE - 1)
+#  define UDP_HASH(lport) \
+     ((((uint32_t)(lport) * 0x9e3779b1) >> 16) & UDP_HASH_MASK)
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -103,6 +112,7 @@
 
 struct devif_callback_s;  /* Forward reference */
 struct udp_hdr_s;         /* Forward reference */
+struct net_hashstat_s;    /* Forward reference */
 
 struct udp_conn_s
 {
@@ -110,6 +120,10 @@ struct udp_conn_s
 
   dq_entry_t node;        /* Supports a doubly linked list */
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+  FAR struct udp_conn_s *hnext; /* Link in the local port hash chain */
+#endif
+
   /* This is a list of UDP connection callbacks.  Each callback represents
    * a thread that is stalled, waiting for a device-specific event.
    */
@@ -136,9 +150,14 @@ struct udp_conn_s
    *
    *   readahead - A singly linked list of type struct iob_qentry_s
    *               where the UDP/IP read-ahead data is retained.
+   *   rdlock    - Protects the read-ahead queue.  It is only held while
+   *               the queue itself is modified, so the device path may
+   *               wait for it.  A reader removes a datagram from the queue
+   *               before copying it out.
    */
 
   struct iob_queue_s readahead;   /* Read-ahead buffering */
+  sem_t rdlock;                   /* Protects readahead */
 #endif
 
 #ifdef CONFIG_NET_UDP_WRITE_BUFFERS
@@ -251,6 +270,21 @@ FAR struct udp_conn_s *udp_active(FAR struct net_driver_s *dev,
 
 FAR struct udp_conn_s *udp_nextconn(FAR struct udp_conn_s *conn);
 
+/****************************************************************************
+ * Name: udp_hashstats
+ *
+ * Description:
+ *   Return the occupancy of the local port hash table.
+ *
+ * Assumptions:
+ *   Called from normal user code.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_CONNHASH
+void udp_hashstats(FAR struct net_hashstat_s *stats);
+#endif
+
 /****************************************************************************
  * Name: udp_bind
  *
@@ -637,6 +671,31 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
                          size_t len, int flags, FAR const struct sockaddr *to,
                          socklen_t tolen);
 
+/****************************************************************************
+ * Name: psock_udp_sendmsg
+ *
+ * Description:
+ *   This function implements the UDP-specific logic of the standard
+ *   sendmsg() socket operation.  The datagram is gathered directly from the
+ *   I/O vectors of the message into a write buffer.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msg      The message to send
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On  error,
+ *   a negated errno value is returned.  See the description in
+ *   net/socket/sendto.c for the list of appropriate return value.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_WRITE_BUFFERS
+ssize_t psock_udp_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                          int flags);
+#endif
+
 /****************************************************************************
  * Name: udp_pollsetup
  *
@@ -51,6 +51,7 @@
 
 #include "devif/devif.h"
 #include "udp/udp.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -224,9 +225,15 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
         }
     }
 
-  /* Add the new I/O buffer chain to the tail of the read-ahead queue */
+  /* Add the new I/O buffer chain to the tail of the read-ahead queue.
+   * Readers hold the read-ahead lock only while they modify the queue,
+   * never while copying data.
+   */
 
+  net_connlock(&conn->rdlock);
   ret = iob_tryadd_queue(iob, &conn->readahead);
+  net_connunlock(&conn->rdlock);
+
   if (ret < 0)
     {
       nerr("ERROR: Failed to queue the I/O buffer chain: %d\n", ret);
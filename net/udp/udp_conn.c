@@ -65,6 +65,7 @@
 #include "netdev/netdev.h"
 #include "inet/inet.h"
 #include "udp/udp.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -73,6 +74,11 @@
 #define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+#if defined(CONFIG_NET_UDP_CONNHASH) && \
+    (CONFIG_NET_UDP_CONNHASH_SIZE & (CONFIG_NET_UDP_CONNHASH_SIZE - 1)) != 0
+#  error CONFIG_NET_UDP_CONNHASH_SIZE must be a power of two
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -90,6 +96,18 @@ static sem_t g_free_sem;
 
 static dq_queue_t g_active_udp_connections;
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+/* The bound connections (those with a non-zero lport) hashed on the local
+ * port number.  Each chain is kept in bind order.  When overlapping binds
+ * on the same port (e.g. INADDR_ANY and a specific address) both match an
+ * incoming packet, the connection that was bound first receives it.  This
+ * can differ from the linear search, which returns the connection that
+ * was allocated first.
+ */
+
+static FAR struct udp_conn_s *g_udp_hashtab[CONFIG_NET_UDP_CONNHASH_SIZE];
+#endif
+
 /* Last port used by a UDP connection connection. */
 
 static uint16_t g_last_udp_port;
@@ -126,6 +144,63 @@ static inline void _udp_semtake(FAR sem_t *sem)
 
 #define _udp_semgive(sem) nxsem_post(sem)
 
+/****************************************************************************
+ * Name: udp_setport
+ *
+ * Description:
+ *   Set the local port number of a connection, moving the connection to
+ *   the hash chain for the new port.  A port number of zero unbinds the
+ *   connection.
+ *
+ ****************************************************************************/
+
+static void udp_setport(FAR struct udp_conn_s *conn, uint16_t portno)
+{
+#ifdef CONFIG_NET_UDP_CONNHASH
+  FAR struct udp_conn_s **link;
+
+  net_lock();
+
+  /* Remove the connection from the chain for its old port */
+
+  if (conn->lport != 0)
+    {
+      for (link = &g_udp_hashtab[UDP_HASH(conn->lport)];
+           *link != NULL;
+           link = &(*link)->hnext)
+        {
+          if (*link == conn)
+            {
+              *link = conn->hnext;
+              break;
+            }
+        }
+    }
+
+  /* Add it to the tail of the chain for the new port so that the chain
+   * stays in bind order.
+   */
+
+  conn->hnext = NULL;
+  conn->lport = portno;
+
+  if (portno != 0)
+    {
+      for (link = &g_udp_hashtab[UDP_HASH(portno)];
+           *link != NULL;
+           link = &(*link)->hnext)
+        {
+        }
+
+      *link = conn;
+    }
+
+  net_unlock();
+#else
+  conn->lport = portno;
+#endif
+}
+
 /****************************************************************************
  * Name: udp_find_conn()
  *
@@ -142,13 +217,22 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
                                             uint16_t portno)
 {
   FAR struct udp_conn_s *conn;
+#ifndef CONFIG_NET_UDP_CONNHASH
   int i;
+#endif
 
   /* Now search each connection structure. */
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+  for (conn = g_udp_hashtab[UDP_HASH(portno)];
+       conn != NULL;
+       conn = conn->hnext)
+    {
+#else
   for (i = 0; i < CONFIG_NET_UDP_CONNS; i++)
     {
       conn = &g_udp_connections[i];
+#endif
 
       /* If the port local port number assigned to the connections matches
        * AND the IP address of the connection matches, then return a
@@ -266,7 +350,11 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
   FAR struct udp_conn_s *conn;
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+  conn = g_udp_hashtab[UDP_HASH(udp->destport)];
+#else
   conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+#endif
   while (conn)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -379,7 +467,11 @@ static inline FAR struct udp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+      conn = conn->hnext;
+#else
       conn = (FAR struct udp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -405,7 +497,11 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
   FAR struct udp_conn_s *conn;
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+  conn = g_udp_hashtab[UDP_HASH(udp->destport)];
+#else
   conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+#endif
   while (conn != NULL)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -518,7 +614,11 @@ static inline FAR struct udp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+      conn = conn->hnext;
+#else
       conn = (FAR struct udp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -553,6 +653,9 @@ void udp_initialize(void)
       /* Mark the connection closed and move it to the free list */
 
       g_udp_connections[i].lport = 0;
+#ifdef CONFIG_NET_UDP_READAHEAD
+      nxsem_init(&g_udp_connections[i].rdlock, 0, 1);
+#endif
       dq_addlast(&g_udp_connections[i].node, &g_free_udp_connections);
     }
 
@@ -624,7 +727,7 @@ void udp_free(FAR struct udp_conn_s *conn)
   DEBUGASSERT(conn->crefs == 0);
 
   _udp_semtake(&g_free_sem);
-  conn->lport = 0;
+  udp_setport(conn, 0);
 
   /* Remove the connection from the active list */
 
@@ -709,6 +812,50 @@ FAR struct udp_conn_s *udp_nextconn(FAR struct udp_conn_s *conn)
     }
 }
 
+/****************************************************************************
+ * Name: udp_hashstats
+ *
+ * Description:
+ *   Return the occupancy of the local port hash table.
+ *
+ * Assumptions:
+ *   Called from normal user code.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_CONNHASH
+void udp_hashstats(FAR struct net_hashstat_s *stats)
+{
+  FAR struct udp_conn_s *conn;
+  unsigned int len;
+  int i;
+
+  memset(stats, 0, sizeof(struct net_hashstat_s));
+  stats->nbuckets = CONFIG_NET_UDP_CONNHASH_SIZE;
+
+  net_lock();
+  for (i = 0; i < CONFIG_NET_UDP_CONNHASH_SIZE; i++)
+    {
+      for (len = 0, conn = g_udp_hashtab[i]; conn; conn = conn->hnext)
+        {
+          len++;
+        }
+
+      if (len > 0)
+        {
+          stats->nused++;
+          stats->nentries += len;
+          if (len > stats->maxchain)
+            {
+              stats->maxchain = len;
+            }
+        }
+    }
+
+  net_unlock();
+}
+#endif
+
 /****************************************************************************
  * Name: udp_bind
  *
@@ -775,8 +922,8 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
     {
       /* Yes.. Select any unused local port number */
 
-      conn->lport = htons(udp_select_port(conn->domain, &conn->u));
-      ret         = OK;
+      udp_setport(conn, htons(udp_select_port(conn->domain, &conn->u)));
+      ret = OK;
     }
   else
     {
@@ -790,7 +937,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         {
           /* No.. then bind the socket to the port */
 
-          conn->lport = portno;
+          udp_setport(conn, portno);
           ret         = OK;
         }
       else
@@ -843,7 +990,7 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * connection structure.
        */
 
-      conn->lport = htons(udp_select_port(conn->domain, &conn->u));
+      udp_setport(conn, htons(udp_select_port(conn->domain, &conn->u)));
     }
 
   /* Is there a remote port (rport)? */
@@ -130,8 +130,17 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
   dev->d_appdata = &dev->d_buf[hdrlen];
 
 #ifdef CONFIG_NET_UDP_CHECKSUMS
+  /* The checksum need not be computed again if the driver has already
+   * verified it.
+   */
+
   chksum = udp->udpchksum;
-  if (chksum != 0)
+  if (dev->d_rxchksum)
+    {
+      dev->d_rxchksum = false;
+      chksum = 0;
+    }
+  else if (chksum != 0)
     {
 #ifdef CONFIG_NET_IPv6
 #ifdef CONFIG_NET_IPv4
@@ -45,6 +45,7 @@
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/net.h>
@@ -53,6 +54,7 @@
 #include "netdev/netdev.h"
 #include "socket/socket.h"
 #include "udp/udp.h"
+#include "utils/utils.h"
 
 #ifdef HAVE_UDP_POLL
 
@@ -142,8 +144,7 @@ static uint16_t udp_poll_eventhandler(FAR struct net_driver_s *dev,
 
       if (eventset)
         {
-          info->fds->revents |= eventset;
-          nxsem_post(info->fds->sem);
+          poll_notify(&info->fds, 1, eventset);
         }
     }
 
@@ -198,8 +199,7 @@ static inline void udp_iob_work(FAR void *arg)
         {
           /* Yes.. then signal the poll logic */
 
-          fds->revents |= POLLWRNORM;
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, POLLWRNORM);
         }
       else
         {
@@ -369,8 +369,11 @@ int udp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 
   fds->priv = (FAR void *)info;
 
-  /* Check for read data availability now */
+  /* Check for read data availability now.  The read-ahead queue is
+   * protected by the connection lock, not by the network lock.
+   */
 
+  net_connlock(&conn->rdlock);
   if (!IOB_QEMPTY(&conn->readahead))
     {
       /* Normal data may be read without blocking. */
@@ -378,6 +381,8 @@ int udp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
       fds->revents |= (POLLRDNORM & fds->events);
     }
 
+  net_connunlock(&conn->rdlock);
+
   if (psock_udp_cansend(psock) >= 0)
     {
       /* Normal data may be sent without blocking (at least one byte). */
@@ -391,7 +396,7 @@ int udp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_notify(&fds, 1, 0);
     }
 
 #if defined(CONFIG_NET_UDP_WRITE_BUFFERS) && defined(CONFIG_IOB_NOTIFIER)
@@ -76,6 +76,7 @@
 #include "neighbor/neighbor.h"
 #include "udp/udp.h"
 #include "devif/devif.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -532,41 +533,40 @@ static uint16_t sendto_eventhandler(FAR struct net_driver_s *dev,
 }
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: psock_udp_sendto
+ * Name: sendto_iovec
  *
  * Description:
- *   This function implements the UDP-specific logic of the standard
- *   sendto() socket operation.
+ *   Queue one UDP datagram gathered from a list of I/O vectors.  The data
+ *   is copied straight from the user buffers into the I/O buffer chain of a
+ *   write buffer; there is no intermediate contiguous copy.
  *
  * Input Parameters:
  *   psock    A pointer to a NuttX-specific, internal socket structure
- *   buf      Data to send
- *   len      Length of data to send
+ *   iov      The I/O vectors holding the data to send
+ *   iovcnt   The number of I/O vectors
  *   flags    Send flags
- *   to       Address of recipient
+ *   to       Address of recipient (NULL if the socket is connected)
  *   tolen    The length of the address structure
  *
- *   NOTE: All input parameters were verified by sendto() before this
- *   function was called.
- *
  * Returned Value:
  *   On success, returns the number of characters sent.  On  error,
- *   a negated errno value is returned.  See the description in
- *   net/socket/sendto.c for the list of appropriate return value.
+ *   a negated errno value is returned.
  *
  ****************************************************************************/
 
-ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
-                         size_t len, int flags, FAR const struct sockaddr *to,
-                         socklen_t tolen)
+static ssize_t sendto_iovec(FAR struct socket *psock,
+                            FAR const struct iovec *iov,
+                            unsigned long iovcnt, int flags,
+                            FAR const struct sockaddr *to, socklen_t tolen)
 {
   FAR struct udp_conn_s *conn;
   FAR struct udp_wrbuffer_s *wrb;
+  unsigned long i;
+  unsigned int count;
+  size_t offset;
+  size_t len;
   bool empty;
+  int blresult;
   int ret = OK;
 
   /* If the UDP socket was previously assigned a remote peer address via
@@ -690,9 +690,13 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
     }
 #endif /* CONFIG_NET_ARP_SEND || CONFIG_NET_ICMPv6_NEIGHBOR */
 
-  /* Dump the incoming buffer */
+  /* Get the total size of the datagram and dump the incoming buffers */
 
-  BUF_DUMP("psock_udp_send", buf, len);
+  for (i = 0, len = 0; i < iovcnt; i++)
+    {
+      BUF_DUMP("psock_udp_send", iov[i].iov_base, iov[i].iov_len);
+      len += iov[i].iov_len;
+    }
 
   /* Set the socket state to sending */
 
@@ -764,19 +768,61 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
       wrb->wb_start = clock_systimer();
 #endif
 
-      /* Copy the user data into the write buffer.  We cannot wait for
-       * buffer space if the socket was opened non-blocking.
+      /* Gather the user data directly into the write buffer's I/O buffer
+       * chain.  The write buffer is not yet visible to the network so the
+       * network is unlocked during the copy:  Other connections and devices
+       * may then make progress and, in the blocking case, iob_copyin() may
+       * have to wait for buffers to be freed which could never happen with
+       * the network locked.
        */
 
-      if (_SS_ISNONBLOCK(psock->s_flags))
+      blresult = net_breaklock(&count);
+
+      for (i = 0, offset = 0; i < iovcnt && ret >= 0; i++)
+        {
+          if (iov[i].iov_len == 0)
+            {
+              continue;
+            }
+
+          /* We cannot wait for buffer space if the socket was opened
+           * non-blocking.
+           */
+
+          if (_SS_ISNONBLOCK(psock->s_flags))
+            {
+              ret = iob_trycopyin(wrb->wb_iob,
+                                  (FAR const uint8_t *)iov[i].iov_base,
+                                  iov[i].iov_len, offset, false,
+                                  IOBUSER_NET_SOCK_UDP);
+            }
+          else
+            {
+              ret = iob_copyin(wrb->wb_iob,
+                               (FAR const uint8_t *)iov[i].iov_base,
+                               iov[i].iov_len, offset, false,
+                               IOBUSER_NET_SOCK_UDP);
+            }
+
+          offset += iov[i].iov_len;
+        }
+
+      if (blresult >= 0)
         {
-          ret = iob_trycopyin(wrb->wb_iob, (FAR uint8_t *)buf, len, 0, false,
-                              IOBUSER_NET_SOCK_UDP);
+          net_restorelock(count);
         }
-      else
+
+      /* The socket may have been closed by another thread while the
+       * network was unlocked.  In that case the connection has already been
+       * freed (and may even have been reused), so the new buffer must not
+       * be queued.
+       */
+
+      if (psock->s_crefs <= 0 || psock->s_conn != conn || conn->crefs == 0)
         {
-          ret = iob_copyin(wrb->wb_iob, (FAR uint8_t *)buf, len, 0, false,
-                           IOBUSER_NET_SOCK_UDP);
+          nerr("ERROR: Socket closed during copy\n");
+          ret = -EBADF;
+          goto errout_with_wrb;
         }
 
       if (ret < 0)
@@ -841,6 +887,82 @@ errout_with_lock:
   return ret;
 }
 
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_udp_sendto
+ *
+ * Description:
+ *   This function implements the UDP-specific logic of the standard
+ *   sendto() socket operation.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   buf      Data to send
+ *   len      Length of data to send
+ *   flags    Send flags
+ *   to       Address of recipient
+ *   tolen    The length of the address structure
+ *
+ *   NOTE: All input parameters were verified by sendto() before this
+ *   function was called.
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On  error,
+ *   a negated errno value is returned.  See the description in
+ *   net/socket/sendto.c for the list of appropriate return value.
+ *
+ ****************************************************************************/
+
+ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
+                         size_t len, int flags, FAR const struct sockaddr *to,
+                         socklen_t tolen)
+{
+  struct iovec iov;
+
+  iov.iov_base = (FAR void *)buf;
+  iov.iov_len  = len;
+
+  return sendto_iovec(psock, &iov, 1, flags, to, tolen);
+}
+
+/****************************************************************************
+ * Name: psock_udp_sendmsg
+ *
+ * Description:
+ *   This function implements the UDP-specific logic of the standard
+ *   sendmsg() socket operation.  The datagram is built directly from the
+ *   I/O vectors of the message.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msg      The message to send.  msg_name is NULL for a connected socket.
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On  error,
+ *   a negated errno value is returned.  See the description in
+ *   net/socket/sendto.c for the list of appropriate return value.
+ *
+ ****************************************************************************/
+
+ssize_t psock_udp_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                          int flags)
+{
+  FAR const struct sockaddr *to = (FAR const struct sockaddr *)msg->msg_name;
+  socklen_t tolen = msg->msg_namelen;
+
+  if (to == NULL || tolen <= 0)
+    {
+      to    = NULL;
+      tolen = 0;
+    }
+
+  return sendto_iovec(psock, msg->msg_iov, msg->msg_iovlen, flags, to, tolen);
+}
+
 /****************************************************************************
  * Name: psock_udp_cansend
  *
@@ -42,8 +42,11 @@
 #ifdef CONFIG_NET
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
 #include <debug.h>
 
+#include <nuttx/mm/iob.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ip.h>
@@ -67,7 +70,10 @@
  *
  * Description:
  *   Calculate the raw change some over the memory region described by
- *   data and len.
+ *   data and len.  This generic version sums a 32-bit word (or a 16-bit
+ *   word if the toolchain has no 64-bit integer type) per addition.  If
+ *   CONFIG_NET_ARCH_CHKSUM_PARTIAL is defined, then this function must be
+ *   provided by architecture-specific logic instead.
  *
  * Input Parameters:
  *   sum  - Partial calculations carried over from a previous call to
@@ -81,45 +87,127 @@
  *
  ****************************************************************************/
 
-#ifndef CONFIG_NET_ARCH_CHKSUM
+#if !defined(CONFIG_NET_ARCH_CHKSUM) && !defined(CONFIG_NET_ARCH_CHKSUM_PARTIAL)
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 {
-  FAR const uint8_t *dataptr;
-  FAR const uint8_t *last_byte;
-  uint16_t t;
+  union
+  {
+    uint16_t u16;
+    uint8_t  u8[2];
+  } part;
+
+#ifdef CONFIG_HAVE_LONG_LONG
+  uint64_t acc = 0;
+#else
+  uint32_t acc = 0;
+#endif
+  uint32_t result;
+  bool odd;
 
-  dataptr = data;
-  last_byte = data + len - 1;
+  /* The data is summed as native, aligned 16-bit words and the byte order
+   * is corrected at the end (RFC 1071, "Byte Order Independence").  If the
+   * data begins on an odd address, the first byte is summed on its own and
+   * every following byte then lies in the opposite half of the aligned
+   * words.
+   */
 
-  while (dataptr < last_byte)
+  odd = ((uintptr_t)data & 1) != 0;
+  if (odd && len > 0)
     {
-      /* At least two more bytes */
+      part.u8[0] = 0;
+      part.u8[1] = *data++;
+      acc       += part.u16;
+      len--;
+    }
 
-      t = ((uint16_t)dataptr[0] << 8) + dataptr[1];
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+#ifdef CONFIG_HAVE_LONG_LONG
+  /* Sum 32-bit words into the 64-bit accumulator.  The carries out of each
+   * 32-bit word collect in the upper half and are folded back in below.
+   */
 
-      dataptr += 2;
+  if (((uintptr_t)data & 2) != 0 && len >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
     }
 
-  if (dataptr == last_byte)
+  while (len >= 16)
     {
-      t = (dataptr[0] << 8) + 0;
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+      FAR const uint32_t *data32 = (FAR const uint32_t *)data;
+
+      acc  += data32[0];
+      acc  += data32[1];
+      acc  += data32[2];
+      acc  += data32[3];
+      data += 16;
+      len  -= 16;
     }
 
+  while (len >= 4)
+    {
+      acc  += *(FAR const uint32_t *)data;
+      data += 4;
+      len  -= 4;
+    }
+#endif
+
+  /* A uint16_t length limits the number of 16-bit words so that this
+   * cannot overflow a 32-bit accumulator.
+   */
+
+  while (len >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
+
+  if (len > 0)
+    {
+      part.u8[0] = *data;
+      part.u8[1] = 0;
+      acc       += part.u16;
+    }
+
+  /* Fold the accumulator down to 16 bits */
+
+#ifdef CONFIG_HAVE_LONG_LONG
+  while ((acc >> 32) != 0)
+    {
+      acc = (acc & 0xffffffff) + (acc >> 32);
+    }
+#endif
+
+  result = (uint32_t)acc;
+  while ((result >> 16) != 0)
+    {
+      result = (result & 0xffff) + (result >> 16);
+    }
+
+  /* The sum is in network order on a big-endian machine when the data
+   * began at an even address.
+   */
+
+#ifdef CONFIG_ENDIAN_BIG
+  if (odd)
+#else
+  if (!odd)
+#endif
+    {
+      result = ((result << 8) | (result >> 8)) & 0xffff;
+    }
+
+  /* Add in the partial sum from the previous call */
+
+  result += sum;
+  result  = (result & 0xffff) + (result >> 16);
+
   /* Return sum in host byte order. */
 
-  return sum;
+  return (uint16_t)result;
 }
-#endif /* CONFIG_NET_ARCH_CHKSUM */
+#endif /* !CONFIG_NET_ARCH_CHKSUM && !CONFIG_NET_ARCH_CHKSUM_PARTIAL */
 
 /****************************************************************************
  * Name: net_chksum
@@ -153,4 +241,111 @@ uint16_t net_chksum(FAR uint16_t *data, uint16_t len)
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
 
+/****************************************************************************
+ * Name: net_chksum_adjust
+ *
+ * Description:
+ *   Incrementally update a checksum when one 16-bit word of the
+ *   checksummed data changes, without summing the data again.  The
+ *   computation is HC' = ~(~HC + ~m + m') from RFC 1624, equation 3, which
+ *   (unlike equation 2 of RFC 1141) never produces a -0 checksum.
+ *
+ *   The checksum and the old and new values may be in either byte order,
+ *   as long as all three use the same order.
+ *
+ * Input Parameters:
+ *   chksum - The checksum as it appears in the header
+ *   oldval - The old value of the 16-bit word
+ *   newval - The new value of the 16-bit word
+ *
+ * Returned Value:
+ *   The updated checksum.
+ *
+ ****************************************************************************/
+
+uint16_t net_chksum_adjust(uint16_t chksum, uint16_t oldval, uint16_t newval)
+{
+  uint32_t sum;
+
+  sum = (uint32_t)(uint16_t)~chksum + (uint16_t)~oldval + newval;
+  sum = (sum & 0xffff) + (sum >> 16);
+  sum = (sum & 0xffff) + (sum >> 16);
+
+  return (uint16_t)~sum;
+}
+
+/****************************************************************************
+ * Name: net_iob_chksum
+ *
+ * Description:
+ *   Calculate the raw checksum (like chksum()) over 'len' bytes of data
+ *   held in an I/O buffer chain, beginning 'offset' bytes into the chain.
+ *   The data is summed in place, one I/O buffer at a time.  I/O buffers
+ *   holding an odd number of bytes are accounted for by byte swapping the
+ *   partial sum of the I/O buffer that follows.
+ *
+ * Input Parameters:
+ *   sum    - Partial calculations carried over from a previous call
+ *   iob    - The head of the I/O buffer chain
+ *   offset - Offset into the chain of the first byte to sum
+ *   len    - Number of bytes to sum
+ *
+ * Returned Value:
+ *   The updated checksum value in host byte order.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_IOB
+uint16_t net_iob_chksum(uint16_t sum, FAR struct iob_s *iob,
+                        unsigned int offset, unsigned int len)
+{
+  uint32_t result = sum;
+  uint32_t partial;
+  unsigned int seglen;
+  bool odd = false;
+
+  /* Skip to the I/O buffer containing the first byte */
+
+  while (iob != NULL && offset >= iob->io_len)
+    {
+      offset -= iob->io_len;
+      iob     = iob->io_flink;
+    }
+
+  while (iob != NULL && len > 0)
+    {
+      seglen = iob->io_len - offset;
+      if (seglen > len)
+        {
+          seglen = len;
+        }
+
+      partial = chksum(0, &iob->io_data[iob->io_offset + offset], seglen);
+
+      /* If an odd number of bytes precede this I/O buffer, then its bytes
+       * are in the opposite halves of the 16-bit words.
+       */
+
+      if (odd)
+        {
+          partial = ((partial << 8) | (partial >> 8)) & 0xffff;
+        }
+
+      result += partial;
+      result  = (result & 0xffff) + (result >> 16);
+
+      if ((seglen & 1) != 0)
+        {
+          odd = !odd;
+        }
+
+      len   -= seglen;
+      offset = 0;
+      iob    = iob->io_flink;
+    }
+
+  return (uint16_t)result;
+}
+#endif /* CONFIG_MM_IOB */
+
 #endif /* CONFIG_NET */
@@ -43,6 +43,7 @@
 #include <stdint.h>
 #include <assert.h>
 
+#include <nuttx/mm/iob.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ip.h>
@@ -58,6 +59,47 @@
 #define IPv4BUF  ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF  ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: upperlayer_payload_chksum
+ *
+ * Description:
+ *   Sum the upper layer header and payload.  If the payload was left in an
+ *   I/O buffer chain by devif_iob_send_nocopy(), then only the upper layer
+ *   header is in d_buf and the remainder is summed from the chain.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NET_ARCH_CHKSUM
+static uint16_t upperlayer_payload_chksum(FAR struct net_driver_s *dev,
+                                          uint16_t sum,
+                                          FAR const uint8_t *data,
+                                          uint16_t upperlen)
+{
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+  if (dev->d_txiob != NULL)
+    {
+      uint16_t hdrlen = upperlen - dev->d_txlen;
+
+      /* The upper layer header length is always a multiple of four so the
+       * payload begins on a 16-bit boundary of the sum.
+       */
+
+      DEBUGASSERT(upperlen >= dev->d_txlen && (hdrlen & 1) == 0);
+
+      sum = chksum(sum, data, hdrlen);
+      return net_iob_chksum(sum, dev->d_txiob, dev->d_txoffset,
+                            dev->d_txlen);
+    }
+#endif
+
+  return chksum(sum, data, upperlen);
+}
+#endif /* CONFIG_NET_ARCH_CHKSUM */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -98,9 +140,15 @@ uint16_t ipv4_upperlayer_chksum(FAR struct net_driver_s *dev, uint8_t proto)
 
   upperlen = (((uint16_t)(ipv4->len[0]) << 8) + ipv4->len[1]) - iphdrlen;
 
-  /* Verify some minimal assumptions */
+  /* Verify some minimal assumptions.  If the payload is in an I/O buffer
+   * chain, then the packet may be larger than d_buf.
+   */
 
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+  if (dev->d_txiob == NULL && upperlen > NETDEV_PKTSIZE(dev))
+#else
   if (upperlen > NETDEV_PKTSIZE(dev))
+#endif
     {
       return 0;
     }
@@ -118,7 +166,9 @@ uint16_t ipv4_upperlayer_chksum(FAR struct net_driver_s *dev, uint8_t proto)
 
   /* Sum IP payload data. */
 
-  sum = chksum(sum, &dev->d_buf[iphdrlen + NET_LL_HDRLEN(dev)], upperlen);
+  sum = upperlayer_payload_chksum(dev, sum,
+                                  &dev->d_buf[iphdrlen + NET_LL_HDRLEN(dev)],
+                                  upperlen);
   return (sum == 0) ? 0xffff : htons(sum);
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
@@ -164,9 +214,15 @@ uint16_t ipv6_upperlayer_chksum(FAR struct net_driver_s *dev,
 
   upperlen -= (iplen - IPv6_HDRLEN);
 
-  /* Verify some minimal assumptions */
+  /* Verify some minimal assumptions.  If the payload is in an I/O buffer
+   * chain, then the packet may be larger than d_buf.
+   */
 
+#ifdef CONFIG_NET_TCP_SEND_ZEROCOPY
+  if (dev->d_txiob == NULL && upperlen > NETDEV_PKTSIZE(dev))
+#else
   if (upperlen > NETDEV_PKTSIZE(dev))
+#endif
     {
       return 0;
     }
@@ -185,7 +241,9 @@ uint16_t ipv6_upperlayer_chksum(FAR struct net_driver_s *dev,
 
   /* Sum IP payload data. */
 
-  sum = chksum(sum, &dev->d_buf[NET_LL_HDRLEN(dev) + iplen], upperlen);
+  sum = upperlayer_payload_chksum(dev, sum,
+                                  &dev->d_buf[NET_LL_HDRLEN(dev) + iplen],
+                                  upperlen);
   return (sum == 0) ? 0xffff : htons(sum);
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
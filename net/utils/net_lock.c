@@ -50,6 +50,7 @@
 #include <nuttx/semaphore.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
 
 #include "utils/utils.h"
 
@@ -421,3 +422,142 @@ FAR struct iob_s *net_ioballoc(bool throttled, enum iob_user_e consumerid)
   return iob;
 }
 #endif
+
+/****************************************************************************
+ * Name: net_connlock
+ *
+ * Description:
+ *   Take a per-connection lock.  Per-connection locks protect connection
+ *   state that is also accessed by the socket layer without the network
+ *   lock (such as the read-ahead queues).  They may be taken with or
+ *   without the network lock held but, to avoid deadlocks, the network
+ *   lock must never be taken while holding a per-connection lock.  The
+ *   device input and poll paths wait for these locks, so they must only
+ *   be held briefly and never while copying data to or from a user
+ *   buffer.
+ *
+ * Input Parameters:
+ *   lock - The per-connection lock to take
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void net_connlock(FAR sem_t *lock)
+{
+  int ret;
+
+  /* Wait uninterruptibly:  The network lock (if held) must not be broken
+   * here because the caller may be in the middle of packet processing.
+   */
+
+  ret = nxsem_wait_uninterruptible(lock);
+  DEBUGASSERT(ret == OK);
+  UNUSED(ret);
+}
+
+/****************************************************************************
+ * Name: net_connunlock
+ *
+ * Description:
+ *   Release a per-connection lock taken by net_connlock().
+ *
+ * Input Parameters:
+ *   lock - The per-connection lock to release
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void net_connunlock(FAR sem_t *lock)
+{
+  (void)nxsem_post(lock);
+}
+
+/****************************************************************************
+ * Name: net_devlock
+ *
+ * Description:
+ *   Take the re-entrant lock of a network device.  See
+ *   include/nuttx/net/netdev.h for the rules of its use.
+ *
+ * Input Parameters:
+ *   dev - The network device to lock
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void net_devlock(FAR struct net_driver_s *dev)
+{
+  pid_t me;
+  int ret;
+
+  if (up_interrupt_context())
+    {
+      return;
+    }
+
+  /* Does this thread already hold the device lock? */
+
+  me = getpid();
+  if (dev->d_lockholder == me)
+    {
+      /* Yes.. just increment the reference count */
+
+      dev->d_lockcount++;
+    }
+  else
+    {
+      /* No.. take the lock, waiting uninterruptibly as for the
+       * per-connection locks.
+       */
+
+      ret = nxsem_wait_uninterruptible(&dev->d_lock);
+      DEBUGASSERT(ret == OK);
+      UNUSED(ret);
+
+      dev->d_lockholder = me;
+      dev->d_lockcount  = 1;
+    }
+}
+
+/****************************************************************************
+ * Name: net_devunlock
+ *
+ * Description:
+ *   Release the lock of a network device taken by net_devlock().
+ *
+ * Input Parameters:
+ *   dev - The network device to unlock
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void net_devunlock(FAR struct net_driver_s *dev)
+{
+  if (up_interrupt_context())
+    {
+      return;
+    }
+
+  DEBUGASSERT(dev->d_lockholder == getpid() && dev->d_lockcount > 0);
+
+  /* If the count would go to zero, then release the lock */
+
+  if (dev->d_lockcount == 1)
+    {
+      dev->d_lockholder = NO_HOLDER;
+      dev->d_lockcount  = 0;
+      (void)nxsem_post(&dev->d_lock);
+    }
+  else
+    {
+      dev->d_lockcount--;
+    }
+}
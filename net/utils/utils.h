@@ -57,6 +57,16 @@ enum tv2ds_remainder_e
   TV2DS_CEIL       /* Force to next larger full decisecond */
 };
 
+/* Describes the occupancy of one connection hash table */
+
+struct net_hashstat_s
+{
+  uint16_t nbuckets;   /* Number of buckets in the table */
+  uint16_t nused;      /* Number of non-empty buckets */
+  uint16_t nentries;   /* Number of connections in the table */
+  uint16_t maxchain;   /* Length of the longest hash chain */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -111,6 +121,20 @@ int net_breaklock(FAR unsigned int *count);
 
 int net_restorelock(unsigned int count);
 
+/****************************************************************************
+ * Name: net_connlock and net_connunlock
+ *
+ * Description:
+ *   Take or release a per-connection lock.  The network lock must never be
+ *   taken while a per-connection lock is held.  Locks that are taken by
+ *   logic running on behalf of a network device must only be held briefly
+ *   and never while copying data to or from a user buffer.
+ *
+ ****************************************************************************/
+
+void net_connlock(FAR sem_t *lock);
+void net_connunlock(FAR sem_t *lock);
+
 /****************************************************************************
  * Name: net_dsec2timeval
  *
@@ -216,28 +240,6 @@ uint8_t net_ipv6_mask2pref(FAR const uint16_t *mask);
 void net_ipv6_pref2mask(uint8_t preflen, net_ipv6addr_t mask);
 #endif
 
-/****************************************************************************
- * Name: chksum
- *
- * Description:
- *   Calculate the raw change some over the memory region described by
- *   data and len.
- *
- * Input Parameters:
- *   sum  - Partial calculations carried over from a previous call to chksum().
- *          This should be zero on the first time that check sum is called.
- *   data - Beginning of the data to include in the checksum.
- *   len  - Length of the data to include in the checksum.
- *
- * Returned Value:
- *   The updated checksum value.
- *
- ****************************************************************************/
-
-#ifndef CONFIG_NET_ARCH_CHKSUM
-uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len);
-#endif
-
 /****************************************************************************
  * Name: net_chksum
  *
@@ -267,6 +269,52 @@ uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len);
 uint16_t net_chksum(FAR uint16_t *data, uint16_t len);
 #endif
 
+/****************************************************************************
+ * Name: net_chksum_adjust
+ *
+ * Description:
+ *   Incrementally update a checksum when one 16-bit word of the
+ *   checksummed data changes (RFC 1624).  The checksum and the old and new
+ *   values may be in either byte order, as long as all three use the same
+ *   order.
+ *
+ * Input Parameters:
+ *   chksum - The checksum as it appears in the header
+ *   oldval - The old value of the 16-bit word
+ *   newval - The new value of the 16-bit word
+ *
+ * Returned Value:
+ *   The updated checksum.
+ *
+ ****************************************************************************/
+
+uint16_t net_chksum_adjust(uint16_t chksum, uint16_t oldval, uint16_t newval);
+
+/****************************************************************************
+ * Name: net_iob_chksum
+ *
+ * Description:
+ *   Calculate the raw checksum (like chksum()) over 'len' bytes of data in
+ *   an I/O buffer chain, beginning 'offset' bytes into the chain, without
+ *   copying the data into a contiguous buffer.
+ *
+ * Input Parameters:
+ *   sum    - Partial calculations carried over from a previous call
+ *   iob    - The head of the I/O buffer chain
+ *   offset - Offset into the chain of the first byte to sum
+ *   len    - Number of bytes to sum
+ *
+ * Returned Value:
+ *   The updated checksum value in host byte order.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_IOB
+struct iob_s;  /* Forward reference */
+uint16_t net_iob_chksum(uint16_t sum, FAR struct iob_s *iob,
+                        unsigned int offset, unsigned int len);
+#endif
+
 /****************************************************************************
  * Name: ipv4_upperlayer_chksum
  *
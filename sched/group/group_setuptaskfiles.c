@@ -88,9 +88,6 @@ static inline void sched_dupfiles(FAR struct task_tcb_s *tcb)
   /* The parent task is the one at the head of the ready-to-run list */
 
   FAR struct tcb_s *rtcb = this_task();
-  FAR struct file *parent;
-  FAR struct file *child;
-  int i;
 
   DEBUGASSERT(tcb && tcb->cmn.group && rtcb->group);
 
@@ -100,27 +97,8 @@ static inline void sched_dupfiles(FAR struct task_tcb_s *tcb)
    * accordingly above.
    */
 
-  /* Get pointers to the parent and child task file lists */
-
-  parent = rtcb->group->tg_filelist.fl_files;
-  child  = tcb->cmn.group->tg_filelist.fl_files;
-
-  /* Check each file in the parent file list */
-
-  for (i = 0; i < NFDS_TOCLONE; i++)
-    {
-      /* Check if this file is opened by the parent.  We can tell if
-       * if the file is open because it contain a reference to a non-NULL
-       * i-node structure.
-       */
-
-      if (parent[i].f_inode)
-        {
-          /* Yes... duplicate it for the child */
-
-          (void)file_dup2(&parent[i], &child[i]);
-        }
-    }
+  files_duplist(&rtcb->group->tg_filelist, &tcb->cmn.group->tg_filelist,
+                NFDS_TOCLONE);
 }
 #else /* !CONFIG_FDCLONE_DISABLE */
 #  define sched_dupfiles(tcb)
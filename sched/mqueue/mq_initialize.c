@@ -74,6 +74,12 @@ sq_queue_t  g_msgfree;
 
 sq_queue_t  g_msgfreeirq;
 
+#ifdef CONFIG_SMP
+/* This spinlock protects both g_msgfree and g_msgfreeirq */
+
+volatile spinlock_t g_msgfreelock SP_SECTION = SP_UNLOCKED;
+#endif
+
 /* The g_desfree data structure is a list of message descriptors available
  * to the operating system for general use. The number of messages in the
  * pool is a constant.
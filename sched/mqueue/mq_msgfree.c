@@ -81,9 +81,9 @@ void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
        * list from interrupt handlers.
        */
 
-      flags = enter_critical_section();
+      flags = spin_lock_save(&g_msgfreelock);
       sq_addlast((FAR sq_entry_t *)mqmsg, &g_msgfree);
-      leave_critical_section(flags);
+      spin_unlock_restore(&g_msgfreelock, flags);
     }
 
   /* If this is a message pre-allocated for interrupts,
@@ -96,9 +96,9 @@ void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
        * list from interrupt handlers.
        */
 
-      flags = enter_critical_section();
+      flags = spin_lock_save(&g_msgfreelock);
       sq_addlast((FAR sq_entry_t *)mqmsg, &g_msgfreeirq);
-      leave_critical_section(flags);
+      spin_unlock_restore(&g_msgfreelock, flags);
     }
 
   /* Otherwise, deallocate it.  Note:  interrupt handlers
@@ -148,8 +148,11 @@ FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
 
   if (up_interrupt_context())
     {
-      /* Try the general free list */
+      /* Try the general free list.  Interrupts are already disabled on
+       * this CPU, but in the SMP case another CPU may be using the list.
+       */
 
+      flags = spin_lock_save(&g_msgfreelock);
       mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfree);
       if (mqmsg == NULL)
         {
@@ -157,6 +160,8 @@ FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
 
           mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfreeirq);
         }
+
+      spin_unlock_restore(&g_msgfreelock, flags);
     }
 
   /* We were not called from an interrupt handler. */
@@ -167,9 +172,9 @@ FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
        * Disable interrupts -- we might be called from an interrupt handler.
        */
 
-      flags = enter_critical_section();
+      flags = spin_lock_save(&g_msgfreelock);
       mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfree);
-      leave_critical_section(flags);
+      spin_unlock_restore(&g_msgfreelock, flags);
 
       /* If we cannot a message from the free list, then we will have to
        * allocate one.
@@ -50,6 +50,7 @@
 #include <mqueue.h>
 #include <sched.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/mqueue.h>
 
 #if CONFIG_MQ_MAXMSGSIZE > 0
@@ -124,6 +125,14 @@ EXTERN sq_queue_t  g_msgfree;
 
 EXTERN sq_queue_t  g_msgfreeirq;
 
+#ifdef CONFIG_SMP
+/* This spinlock protects both g_msgfree and g_msgfreeirq.  Message
+ * allocation and release then do not require the global IRQ lock.
+ */
+
+EXTERN volatile spinlock_t g_msgfreelock;
+#endif
+
 /* The g_desfree data structure is a list of message descriptors available
  * to the operating system for general use. The number of messages in the
  * pool is a constant.
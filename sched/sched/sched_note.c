@@ -39,11 +39,13 @@
 
 #include <nuttx/config.h>
 
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
 
+#include <nuttx/arch.h>
 #include <nuttx/sched.h>
 #include <nuttx/clock.h>
 #include <nuttx/spinlock.h>
@@ -57,6 +59,27 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* In the SMP case, each CPU has its own circular buffer.  Only that CPU
+ * ever adds notes to its buffer (with local interrupts disabled) so no
+ * lock is needed when adding notes.
+ */
+
+#ifdef CONFIG_SMP
+#  define NOTE_NBUFFERS CONFIG_SMP_NCPUS
+#  define note_this()   (&g_note_info[this_cpu()])
+#else
+#  define NOTE_NBUFFERS 1
+#  define note_this()   (&g_note_info[0])
+#endif
+
+/* The note data must be visible before the updated head index (and the
+ * copied note must be complete before the updated tail index).
+ */
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -65,6 +88,9 @@ struct note_info_s
 {
   volatile unsigned int ni_head;
   volatile unsigned int ni_tail;
+#ifdef CONFIG_SCHED_NOTE_GET
+  volatile unsigned int ni_dropped;
+#endif
   uint8_t ni_buffer[CONFIG_SCHED_NOTE_BUFSIZE];
 };
 
@@ -92,10 +118,12 @@ static void note_add(FAR const uint8_t *note, uint8_t notelen);
  * Private Data
  ****************************************************************************/
 
-static struct note_info_s g_note_info;
+static struct note_info_s g_note_info[NOTE_NBUFFERS];
 
-#ifdef CONFIG_SMP
-static volatile spinlock_t g_note_lock;
+#if defined(CONFIG_SCHED_NOTE_GET) && defined(CONFIG_SMP)
+/* Serializes readers.  Writers never take this lock. */
+
+static volatile spinlock_t g_note_readlock;
 #endif
 
 /****************************************************************************
@@ -148,7 +176,11 @@ static inline unsigned int note_next(unsigned int ndx, unsigned int offset)
 static void note_common(FAR struct tcb_s *tcb, FAR struct note_common_s *note,
                         uint8_t length, uint8_t type)
 {
+#ifdef CONFIG_SCHED_NOTE_HIRES
+  uint32_t systime    = up_critmon_gettime();
+#else
   uint32_t systime    = (uint32_t)clock_systimer();
+#endif
 
   /* Save all of the common fields */
 
@@ -209,18 +241,17 @@ void note_spincommon(FAR struct tcb_s *tcb, FAR volatile spinlock_t *spinlock,
  *   Length of data currently in circular buffer.
  *
  * Input Parameters:
- *   None
+ *   ni - The circular buffer
  *
  * Returned Value:
  *   Length of data currently in circular buffer.
  *
  ****************************************************************************/
 
-#if defined(CONFIG_SCHED_NOTE_GET) || defined(CONFIG_DEBUG_ASSERTIONS)
-static unsigned int note_length(void)
+static unsigned int note_length(FAR struct note_info_s *ni)
 {
-  unsigned int head = g_note_info.ni_head;
-  unsigned int tail = g_note_info.ni_tail;
+  unsigned int head = ni->ni_head;
+  unsigned int tail = ni->ni_tail;
 
   if (tail > head)
     {
@@ -229,7 +260,46 @@ static unsigned int note_length(void)
 
   return head - tail;
 }
-#endif
+
+/****************************************************************************
+ * Name: note_copyin
+ *
+ * Description:
+ *   Copy a note to the head of the circular buffer and then publish the
+ *   new head index.  There must be room for the note.
+ *
+ * Input Parameters:
+ *   ni      - The circular buffer
+ *   note    - The note to copy
+ *   notelen - The length of the note
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void note_copyin(FAR struct note_info_s *ni,
+                        FAR const uint8_t *note, unsigned int notelen)
+{
+  unsigned int head = ni->ni_head;
+  unsigned int nbytes;
+
+  /* Copy up to the end of the buffer, then the remainder (if any) to the
+   * beginning of the buffer.
+   */
+
+  nbytes = CONFIG_SCHED_NOTE_BUFSIZE - head;
+  if (nbytes > notelen)
+    {
+      nbytes = notelen;
+    }
+
+  memcpy(&ni->ni_buffer[head], note, nbytes);
+  memcpy(ni->ni_buffer, note + nbytes, notelen - nbytes);
+
+  SP_DMB();
+  ni->ni_head = note_next(head, notelen);
+}
 
 /****************************************************************************
  * Name: note_remove
@@ -238,61 +308,73 @@ static unsigned int note_length(void)
  *   Remove the variable length note from the tail of the circular buffer
  *
  * Input Parameters:
- *   None
+ *   ni - The circular buffer
  *
  * Returned Value:
  *   None
  *
  * Assumptions:
- *   We are within a critical section.
+ *   Only called by the owner of the tail index:  The reader if
+ *   CONFIG_SCHED_NOTE_GET is enabled; the writer with local interrupts
+ *   disabled otherwise.
  *
  ****************************************************************************/
 
-static void note_remove(void)
+static void note_remove(FAR struct note_info_s *ni)
 {
-  FAR struct note_common_s *note;
   unsigned int tail;
   unsigned int length;
 
   /* Get the tail index of the circular buffer */
 
-  tail = g_note_info.ni_tail;
+  tail = ni->ni_tail;
   DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
 
-  /* Get the length of the note at the tail index */
+  /* Get the length of the note at the tail index.  nc_length is the first
+   * byte of the note.
+   */
 
-  note   = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
-  length = note->nc_length;
-  DEBUGASSERT(length <= note_length());
+  length = ni->ni_buffer[tail];
+  DEBUGASSERT(length <= note_length(ni));
 
   /* Increment the tail index to remove the entire note from the circular
    * buffer.
    */
 
-  g_note_info.ni_tail = note_next(tail, length);
+  ni->ni_tail = note_next(tail, length);
 }
 
 /****************************************************************************
  * Name: note_add
  *
  * Description:
- *   Add the variable length note to the head of the circular buffer
+ *   Add the variable length note to the head of this CPU's circular buffer
  *
  * Input Parameters:
- *   None
+ *   note    - The note to add
+ *   notelen - The length of the note
  *
  * Returned Value:
  *   None
  *
- * Assumptions:
- *   We are within a critical section.
- *
  ****************************************************************************/
 
 static void note_add(FAR const uint8_t *note, uint8_t notelen)
 {
-  unsigned int head;
-  unsigned int next;
+  FAR struct note_info_s *ni;
+  irqstate_t flags;
+#ifdef CONFIG_SCHED_NOTE_GET
+  unsigned int needed;
+#endif
+
+  DEBUGASSERT(note != NULL && notelen < CONFIG_SCHED_NOTE_BUFSIZE);
+
+  /* Disable local interrupts so that a nested interrupt on this CPU cannot
+   * add a note at the same time.  Interrupts must be disabled before
+   * this_cpu() is sampled.
+   */
+
+  flags = up_irq_save();
 
 #ifdef CONFIG_SMP
   /* Ignore notes that are not in the set of monitored CPUs */
@@ -301,51 +383,171 @@ static void note_add(FAR const uint8_t *note, uint8_t notelen)
     {
       /* Not in the set of monitored CPUs.  Do not log the note. */
 
+      up_irq_restore(flags);
       return;
     }
 #endif
 
-#ifdef CONFIG_SMP
-  irqstate_t flags = up_irq_save();
-  spin_lock_wo_note(&g_note_lock);
-#endif
+  ni = note_this();
 
-  /* Get the index to the head of the circular buffer */
+#ifdef CONFIG_SCHED_NOTE_GET
+  /* The tail index belongs to the reader, so the oldest notes cannot be
+   * discarded here.  If there is no room, then drop the new note instead
+   * and report the number of dropped notes when there is room again.
+   * One byte is always left unused so that a full buffer can be
+   * distinguished from an empty one.
+   */
 
-  DEBUGASSERT(note != NULL && notelen < CONFIG_SCHED_NOTE_BUFSIZE);
-  head = g_note_info.ni_head;
+  needed = notelen;
+  if (ni->ni_dropped > 0)
+    {
+      needed += sizeof(struct note_dropped_s);
+    }
 
-  /* Loop until all bytes have been transferred to the circular buffer */
+  if (note_length(ni) + needed >= CONFIG_SCHED_NOTE_BUFSIZE)
+    {
+      ni->ni_dropped++;
+      up_irq_restore(flags);
+      return;
+    }
 
-  while (notelen > 0)
+  if (ni->ni_dropped > 0)
     {
-      /* Get the next head index.  Would it collide with the current tail
-       * index?
+      struct note_dropped_s dropped;
+      unsigned int count;
+
+      /* The NOTE_DROPPED note carries the same thread, CPU, and time as the
+       * note that follows it.
        */
 
-      next = note_next(head, 1);
-      if (next == g_note_info.ni_tail)
-        {
-          /* Yes, then remove the note at the tail index */
+      memcpy(&dropped.ndr_cmn, note, sizeof(struct note_common_s));
+      dropped.ndr_cmn.nc_length = sizeof(struct note_dropped_s);
+      dropped.ndr_cmn.nc_type   = NOTE_DROPPED;
 
-          note_remove();
-        }
+      count = ni->ni_dropped < UINT16_MAX ? ni->ni_dropped : UINT16_MAX;
+      dropped.ndr_count[0] = (uint8_t)(count & 0xff);
+      dropped.ndr_count[1] = (uint8_t)((count >> 8) & 0xff);
 
-      /* Save the next byte at the head index */
-
-      g_note_info.ni_buffer[head] = *note++;
+      note_copyin(ni, (FAR const uint8_t *)&dropped,
+                  sizeof(struct note_dropped_s));
+      ni->ni_dropped = 0;
+    }
+#else
+  /* Nothing reads the buffer while the system runs.  Remove the oldest
+   * notes until the new note fits.
+   */
 
-      head = next;
-      notelen--;
+  while (note_length(ni) + notelen >= CONFIG_SCHED_NOTE_BUFSIZE)
+    {
+      note_remove(ni);
     }
+#endif
 
-  g_note_info.ni_head = head;
+  note_copyin(ni, note, notelen);
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: note_readlock and note_readunlock
+ *
+ * Description:
+ *   Serialize readers of the note buffers.  These do not use
+ *   enter_critical_section() (or any lock that is itself instrumented) so
+ *   reading notes does not generate more notes.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_NOTE_GET
+static irqstate_t note_readlock(void)
+{
+  irqstate_t flags = up_irq_save();
+#ifdef CONFIG_SMP
+  spin_lock_wo_note(&g_note_readlock);
+#endif
+  return flags;
+}
 
+static void note_readunlock(irqstate_t flags)
+{
 #ifdef CONFIG_SMP
-  spin_unlock_wo_note(&g_note_lock);
+  spin_unlock_wo_note(&g_note_readlock);
+#endif
   up_irq_restore(flags);
+}
+#endif
+
+/****************************************************************************
+ * Name: note_oldest
+ *
+ * Description:
+ *   Find the circular buffer whose next note is the oldest, so that notes
+ *   from all CPUs are returned in time order.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The circular buffer holding the oldest note or NULL if all of the
+ *   buffers are empty.
+ *
+ * Assumptions:
+ *   The caller holds the read lock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_NOTE_GET
+static FAR struct note_info_s *note_oldest(void)
+{
+  FAR struct note_info_s *oldest = NULL;
+#ifdef CONFIG_SMP
+  uint32_t oldtime = 0;
+  int i;
+
+  for (i = 0; i < NOTE_NBUFFERS; i++)
+    {
+      FAR struct note_info_s *ni = &g_note_info[i];
+      unsigned int ndx;
+      uint32_t systime;
+      int j;
+
+      if (note_length(ni) == 0)
+        {
+          continue;
+        }
+
+      /* Get the little endian time stamp of the note at the tail.  The
+       * note header may wrap around the end of the buffer.
+       */
+
+      SP_DMB();
+      ndx     = note_next(ni->ni_tail,
+                          offsetof(struct note_common_s, nc_systime));
+      systime = 0;
+
+      for (j = 0; j < 4; j++)
+        {
+          systime |= (uint32_t)ni->ni_buffer[ndx] << (8 * j);
+          ndx      = note_next(ndx, 1);
+        }
+
+      /* Compare allowing for wraparound of the time stamp */
+
+      if (oldest == NULL || (int32_t)(systime - oldtime) < 0)
+        {
+          oldest  = ni;
+          oldtime = systime;
+        }
+    }
+#else
+  if (note_length(&g_note_info[0]) > 0)
+    {
+      oldest = &g_note_info[0];
+    }
 #endif
+
+  return oldest;
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -595,6 +797,7 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock)
  * Description:
  *   Remove the next note from the tail of the circular buffer.  The note
  *   is also removed from the circular buffer to make room for futher notes.
+ *   In the SMP case, the oldest note from any CPU's buffer is returned.
  *
  * Input Parameters:
  *   buffer - Location to return the next note
@@ -610,35 +813,36 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock)
 #ifdef CONFIG_SCHED_NOTE_GET
 ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
 {
-  FAR struct note_common_s *note;
+  FAR struct note_info_s *ni;
   irqstate_t flags;
-  unsigned int remaining;
   unsigned int tail;
+  unsigned int nbytes;
   ssize_t notelen;
-  size_t circlen;
 
   DEBUGASSERT(buffer != NULL);
-  flags = enter_critical_section();
+  flags = note_readlock();
 
-  /* Verify that the circular buffer is not empty */
+  /* Find the buffer holding the oldest note.  Return zero if all of the
+   * buffers are empty.
+   */
 
-  circlen = note_length();
-  if (circlen <= 0)
+  ni = note_oldest();
+  if (ni == NULL)
     {
       notelen = 0;
-      goto errout_with_csection;
+      goto errout_with_lock;
     }
 
   /* Get the index to the tail of the circular buffer */
 
-  tail    = g_note_info.ni_tail;
+  SP_DMB();
+  tail    = ni->ni_tail;
   DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
 
   /* Get the length of the note at the tail index */
 
-  note    = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
+  notelen = ni->ni_buffer[tail];
+  DEBUGASSERT(notelen <= note_length(ni));
 
   /* Is the user buffer large enough to hold the note? */
 
@@ -646,33 +850,32 @@ ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
     {
       /* Remove the large note so that we do not get constipated. */
 
-      note_remove();
+      note_remove(ni);
 
       /* and return an error */
 
       notelen = -EFBIG;
-      goto errout_with_csection;
+      goto errout_with_lock;
     }
 
-  /* Loop until the note has been transferred to the user buffer */
+  /* Copy the note to the user buffer in (at most) two pieces */
 
-  remaining = (unsigned int)notelen;
-  while (remaining > 0)
+  nbytes = CONFIG_SCHED_NOTE_BUFSIZE - tail;
+  if (nbytes > notelen)
     {
-      /* Copy the next byte at the tail index */
-
-      *buffer++ = g_note_info.ni_buffer[tail];
+      nbytes = notelen;
+    }
 
-      /* Adjust indices and counts */
+  memcpy(buffer, &ni->ni_buffer[tail], nbytes);
+  memcpy(buffer + nbytes, ni->ni_buffer, notelen - nbytes);
 
-      tail = note_next(tail, 1);
-      remaining--;
-    }
+  /* Release the space only after the note has been copied */
 
-  g_note_info.ni_tail = tail;
+  SP_DMB();
+  ni->ni_tail = note_next(tail, notelen);
 
-errout_with_csection:
-  leave_critical_section(flags);
+errout_with_lock:
+  note_readunlock(flags);
   return notelen;
 }
 #endif
@@ -695,36 +898,20 @@ errout_with_csection:
 #ifdef CONFIG_SCHED_NOTE_GET
 ssize_t sched_note_size(void)
 {
-  FAR struct note_common_s *note;
+  FAR struct note_info_s *ni;
   irqstate_t flags;
-  unsigned int tail;
-  ssize_t notelen;
-  size_t circlen;
+  ssize_t notelen = 0;
 
-  flags = enter_critical_section();
+  flags = note_readlock();
 
-  /* Verify that the circular buffer is not empty */
-
-  circlen = note_length();
-  if (circlen <= 0)
+  ni = note_oldest();
+  if (ni != NULL)
     {
-      notelen = 0;
-      goto errout_with_csection;
+      SP_DMB();
+      notelen = ni->ni_buffer[ni->ni_tail];
     }
 
-  /* Get the index to the tail of the circular buffer */
-
-  tail = g_note_info.ni_tail;
-  DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
-
-  /* Get the length of the note at the tail index */
-
-  note    = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
-
-errout_with_csection:
-  leave_critical_section(flags);
+  note_readunlock(flags);
   return notelen;
 }
 #endif
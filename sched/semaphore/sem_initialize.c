@@ -41,6 +41,16 @@
 
 #include "semaphore/semaphore.h"
 
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+/* This spinlock protects the counts of all semaphores */
+
+volatile spinlock_t g_semlock SP_SECTION = SP_UNLOCKED;
+#endif
+
 /* Currently only need to setup priority inheritance logic */
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
@@ -88,12 +88,22 @@ int nxsem_post(FAR sem_t *sem)
 {
   FAR struct tcb_s *stcb = NULL;
   irqstate_t flags;
+  int16_t semcount;
   int ret = -EINVAL;
 
   /* Make sure we were supplied with a valid semaphore. */
 
   if (sem != NULL)
     {
+      /* If the semaphore has no holders and no task is waiting for it,
+       * then give the count back without entering the critical section.
+       */
+
+      if (NXSEM_NOHOLDERS(sem) && nxsem_trygive(sem) == OK)
+        {
+          return OK;
+        }
+
       /* The following operations must be performed with interrupts
        * disabled because sem_post() may be called from an interrupt
        * handler.
@@ -120,7 +130,10 @@ int nxsem_post(FAR sem_t *sem)
 
       DEBUGASSERT(sem->semcount < SEM_VALUE_MAX);
       nxsem_releaseholder(sem);
-      sem->semcount++;
+
+      nxsem_countlock();
+      semcount = ++sem->semcount;
+      nxsem_countunlock();
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
       /* Don't let any unblocked tasks run until we complete any priority
@@ -137,7 +150,7 @@ int nxsem_post(FAR sem_t *sem)
        * there must be some task waiting for the semaphore.
        */
 
-      if (sem->semcount <= 0)
+      if (semcount <= 0)
         {
           /* Check if there are any tasks in the waiting for semaphore
            * task list that are waiting for this semaphore. This is a
@@ -194,6 +207,44 @@ int nxsem_post(FAR sem_t *sem)
   return ret;
 }
 
+/****************************************************************************
+ * Name: nxsem_trygive
+ *
+ * Description:
+ *   Give a count back to the semaphore if no task is waiting for it.  This
+ *   may be called from interrupt handlers and with other spinlocks held:
+ *   It only takes the semaphore count lock.  No holder is released, so it
+ *   is intended for semaphores that are used for counting resources.
+ *
+ * Input Parameters:
+ *   sem - Semaphore descriptor
+ *
+ * Returned Value:
+ *   Zero (OK) if the count was given back; -EAGAIN if a task may be waiting
+ *   for the semaphore.  In that case the count was not changed and the
+ *   caller must use nxsem_post() instead.
+ *
+ ****************************************************************************/
+
+int nxsem_trygive(FAR sem_t *sem)
+{
+  irqstate_t flags;
+  int ret = -EAGAIN;
+
+  DEBUGASSERT(sem != NULL);
+
+  flags = spin_lock_save(&g_semlock);
+  if (sem->semcount >= 0)
+    {
+      DEBUGASSERT(sem->semcount < SEM_VALUE_MAX);
+      sem->semcount++;
+      ret = OK;
+    }
+
+  spin_unlock_restore(&g_semlock, flags);
+  return ret;
+}
+
 /****************************************************************************
  * Name: sem_post
  *
@@ -110,7 +110,9 @@ void nxsem_recover(FAR struct tcb_s *tcb)
        * place.
        */
 
+      nxsem_countlock();
       sem->semcount++;
+      nxsem_countunlock();
 
       /* Clear the semaphore to assure that it is not reused.  But leave the
        * state as TSTATE_WAIT_SEM.  This is necessary because this is a
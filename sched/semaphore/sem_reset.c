@@ -112,11 +112,14 @@ int nxsem_reset(FAR sem_t *sem, int16_t count)
    * value of sem->semcount is already correct in this case.
    */
 
+  nxsem_countlock();
   if (sem->semcount >= 0)
     {
       sem->semcount = count;
     }
 
+  nxsem_countunlock();
+
   /* Allow any pending context switches to occur now */
 
   leave_critical_section(flags);
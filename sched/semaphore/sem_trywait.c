@@ -90,32 +90,29 @@ int nxsem_trywait(FAR sem_t *sem)
 
   if (sem != NULL)
     {
-      /* The following operations must be performed with interrupts disabled
-       * because sem_post() may be called from an interrupt handler.
+      /* A semaphore without holders needs nothing more than the count.
+       * Otherwise, the following operations must be performed with
+       * interrupts disabled because sem_post() may be called from an
+       * interrupt handler.
        */
 
-      flags = enter_critical_section();
-
-      /* If the semaphore is available, give it to the requesting task */
-
-      if (sem->semcount > 0)
+      if (NXSEM_NOHOLDERS(sem))
         {
-          /* It is, let the task take the semaphore */
-
-          sem->semcount--;
-          rtcb->waitsem = NULL;
-          ret = OK;
+          ret = nxsem_trytake(sem);
         }
       else
         {
-          /* Semaphore is not available */
-
-          ret = -EAGAIN;
+          flags = enter_critical_section();
+          ret   = nxsem_trytake(sem);
+          leave_critical_section(flags);
         }
 
-      /* Interrupts may now be enabled. */
+      /* If the semaphore was available, the task now has it */
 
-      leave_critical_section(flags);
+      if (ret == OK)
+        {
+          rtcb->waitsem = NULL;
+        }
     }
   else
     {
@@ -125,6 +122,70 @@ int nxsem_trywait(FAR sem_t *sem)
   return ret;
 }
 
+/****************************************************************************
+ * Name: nxsem_trytake
+ *
+ * Description:
+ *   Take a count from the semaphore if one is available.  Unlike
+ *   nxsem_trywait(), this may be called from interrupt handlers and with
+ *   other spinlocks held:  It only takes the semaphore count lock.  No
+ *   holder is recorded, so it is intended for semaphores that are used for
+ *   counting resources.
+ *
+ * Input Parameters:
+ *   sem - the semaphore descriptor
+ *
+ * Returned Value:
+ *   Zero (OK) if a count was taken; -EAGAIN if the count was not positive.
+ *
+ ****************************************************************************/
+
+int nxsem_trytake(FAR sem_t *sem)
+{
+  irqstate_t flags;
+  int ret = -EAGAIN;
+
+  DEBUGASSERT(sem != NULL);
+
+  flags = spin_lock_save(&g_semlock);
+  if (sem->semcount > 0)
+    {
+      sem->semcount--;
+      ret = OK;
+    }
+
+  spin_unlock_restore(&g_semlock, flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: nxsem_decrement
+ *
+ * Description:
+ *   Take a count from the semaphore even if none is available.  The count
+ *   may become negative without any task waiting.  This is only useful for
+ *   counts that may be overdrawn, such as the IOB throttle count.  Like
+ *   nxsem_trytake(), this may be called from interrupt handlers.
+ *
+ * Input Parameters:
+ *   sem - the semaphore descriptor
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxsem_decrement(FAR sem_t *sem)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(sem != NULL);
+
+  flags = spin_lock_save(&g_semlock);
+  sem->semcount--;
+  spin_unlock_restore(&g_semlock, flags);
+}
+
 /****************************************************************************
  * Name: sem_trywait
  *
@@ -93,6 +93,16 @@ int nxsem_wait(FAR sem_t *sem)
 
   DEBUGASSERT(sem != NULL && up_interrupt_context() == false);
 
+  /* If the semaphore has no holders and a count is available, then take
+   * the count without entering the critical section.
+   */
+
+  if (sem != NULL && NXSEM_NOHOLDERS(sem) && nxsem_trytake(sem) == OK)
+    {
+      rtcb->waitsem = NULL;
+      return OK;
+    }
+
   /* The following operations must be performed with interrupts
    * disabled because nxsem_post() may be called from an interrupt
    * handler.
@@ -106,11 +116,14 @@ int nxsem_wait(FAR sem_t *sem)
     {
       /* Check if the lock is available */
 
+      nxsem_countlock();
       if (sem->semcount > 0)
         {
           /* It is, let the task take the semaphore. */
 
           sem->semcount--;
+          nxsem_countunlock();
+
           nxsem_addholder(sem);
           rtcb->waitsem = NULL;
           ret = OK;
@@ -133,6 +146,7 @@ int nxsem_wait(FAR sem_t *sem)
           /* Handle the POSIX semaphore (but don't set the owner yet) */
 
           sem->semcount--;
+          nxsem_countunlock();
 
           /* Save the waited on semaphore in the TCB */
 
@@ -109,7 +109,9 @@ void nxsem_wait_irq(FAR struct tcb_s *wtcb, int errcode)
        * place.
        */
 
+      nxsem_countlock();
       sem->semcount++;
+      nxsem_countunlock();
 
       /* Indicate that the semaphore wait is over. */
 
@@ -49,6 +49,45 @@
 #include <sched.h>
 #include <queue.h>
 
+#include <nuttx/spinlock.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Semaphores that never record holders can be counted up or down without
+ * the critical section as long as no task has to be blocked or woken up.
+ */
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+#  define NXSEM_NOHOLDERS(s) (((s)->flags & PRIOINHERIT_FLAGS_DISABLE) != 0)
+#else
+#  define NXSEM_NOHOLDERS(s) true
+#endif
+
+/* Every change of a semaphore count is made while holding g_semlock.  These
+ * are used inside of the critical section where interrupts are already
+ * disabled.  Nothing may block or wake up a task while the lock is held.
+ */
+
+#ifdef CONFIG_SMP
+#  define nxsem_countlock()   spin_lock(&g_semlock)
+#  define nxsem_countunlock() spin_unlock(&g_semlock)
+#else
+#  define nxsem_countlock()
+#  define nxsem_countunlock()
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+/* This spinlock protects the counts of all semaphores */
+
+extern volatile spinlock_t g_semlock;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
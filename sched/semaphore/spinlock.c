@@ -43,6 +43,7 @@
 #include <sched.h>
 #include <assert.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/sched_note.h>
 #include <arch/irq.h>
@@ -395,4 +396,60 @@ void spin_clrbit(FAR volatile cpu_set_t *set, unsigned int cpu,
 }
 #endif
 
+/****************************************************************************
+ * Name: spin_lock_save
+ *
+ * Description:
+ *   Disable local interrupts and take the caller-provided spinlock.  This
+ *   protects data shared with interrupt handlers on this and other CPUs
+ *   without taking the global IRQ lock used by enter_critical_section().
+ *
+ * Input Parameters:
+ *   lock - A reference to the spinlock object to lock.
+ *
+ * Returned Value:
+ *   An opaque, architecture-specific value that represents the state of
+ *   the interrupts prior to the call to spin_lock_save();
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+irqstate_t spin_lock_save(FAR volatile spinlock_t *lock)
+{
+  irqstate_t flags;
+
+  /* Disable local interrupts first so that an interrupt handler on this
+   * CPU cannot try to take the lock that we already hold.
+   */
+
+  flags = up_irq_save();
+  spin_lock(lock);
+  return flags;
+}
+#endif
+
+/****************************************************************************
+ * Name: spin_unlock_restore
+ *
+ * Description:
+ *   Release the spinlock taken by spin_lock_save() and restore the local
+ *   interrupt state.
+ *
+ * Input Parameters:
+ *   lock  - A reference to the spinlock object to unlock.
+ *   flags - The value returned by spin_lock_save().
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+void spin_unlock_restore(FAR volatile spinlock_t *lock, irqstate_t flags)
+{
+  spin_unlock(lock);
+  up_irq_restore(flags);
+}
+#endif
+
 #endif /* CONFIG_SPINLOCK */
@@ -67,27 +67,11 @@
 
 static FAR sigactq_t *nxsig_alloc_action(void)
 {
-  FAR sigactq_t *sigact;
-
-  /* Try to get the signal action structure from the free list */
-
-  sigact = (FAR sigactq_t *)sq_remfirst(&g_sigfreeaction);
-
-  /* Check if we got one. */
-
-  if (!sigact)
-    {
-      /* Add another block of signal actions to the list */
-
-      nxsig_alloc_actionblock();
-
-      /* And try again */
-
-      sigact = (FAR sigactq_t *)sq_remfirst(&g_sigfreeaction);
-      DEBUGASSERT(sigact);
-    }
+  /* Get the signal action structure from the pool.  The pool will grow
+   * from the kernel heap if it is empty.
+   */
 
-  return sigact;
+  return (FAR sigactq_t *)kmm_pool_alloc(&g_sigactionpool);
 }
 
 /****************************************************************************
@@ -376,7 +360,7 @@ int sigaction(int signo, FAR const struct sigaction *act,
 
 void nxsig_release_action(FAR sigactq_t *sigact)
 {
-  /* Just put it back on the free list */
+  /* Just put it back into the pool */
 
-  sq_addlast((FAR sq_entry_t *)sigact, &g_sigfreeaction);
+  kmm_pool_free(&g_sigactionpool, sigact);
 }
@@ -52,11 +52,11 @@
  * Public Data
  ****************************************************************************/
 
-/* The g_sigfreeaction data structure is a list of available signal
- * action structures.
+/* The g_sigactionpool is a pool of available signal action structures.
+ * It grows from the kernel heap as needed.
  */
 
-sq_queue_t  g_sigfreeaction;
+struct kmm_pool_s g_sigactionpool;
 
 /* The g_sigpendingaction data structure is a list of available pending
  * signal action structures.
@@ -87,12 +87,6 @@ sq_queue_t  g_sigpendingirqsignal;
  * Private Data
  ****************************************************************************/
 
-/* g_sigactionalloc is a pointer to the start of the allocated blocks of
- * signal actions.
- */
-
-static sigactq_t  *g_sigactionalloc;
-
 /* g_sigpendingactionalloc is a pointer to the start of the allocated
  * blocks of pending signal actions.
  */
@@ -212,7 +206,6 @@ void nxsig_initialize(void)
 {
   /* Initialize free lists */
 
-  sq_init(&g_sigfreeaction);
   sq_init(&g_sigpendingaction);
   sq_init(&g_sigpendingirqaction);
   sq_init(&g_sigpendingsignal);
@@ -232,7 +225,8 @@ void nxsig_initialize(void)
                       SIG_ALLOC_IRQ);
   DEBUGASSERT(g_sigpendingirqactionalloc != NULL);
 
-  nxsig_alloc_actionblock();
+  kmm_pool_initialize(&g_sigactionpool, "sigaction", sizeof(sigactq_t),
+                      NULL, 0, NUM_SIGNAL_ACTIONS);
 
   g_sigpendingsignalalloc =
     nxsig_alloc_pendingsignalblock(&g_sigpendingsignal,
@@ -246,32 +240,3 @@ void nxsig_initialize(void)
                                    SIG_ALLOC_IRQ);
   DEBUGASSERT(g_sigpendingirqsignalalloc != NULL);
 }
-
-/****************************************************************************
- * Name: nxsig_alloc_actionblock
- *
- * Description:
- *   Allocate a block of signal actions and place them
- *   on the free list.
- *
- ****************************************************************************/
-
-void nxsig_alloc_actionblock(void)
-{
-  FAR sigactq_t *sigact;
-  int i;
-
-  /* Allocate a block of signal actions */
-
-  g_sigactionalloc =
-    (FAR sigactq_t *)kmm_malloc((sizeof(sigactq_t)) * NUM_SIGNAL_ACTIONS);
-
-  if (g_sigactionalloc != NULL)
-    {
-      sigact = g_sigactionalloc;
-      for (i = 0; i < NUM_SIGNAL_ACTIONS; i++)
-        {
-          sq_addlast((FAR sq_entry_t *)sigact++, &g_sigfreeaction);
-        }
-    }
-}
@@ -49,6 +49,7 @@
 #include <sched.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/mm/pool.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -123,11 +124,11 @@ typedef struct sigq_s sigq_t;
  * Public Data
  ****************************************************************************/
 
-/* The g_sigfreeaction data structure is a list of available signal action
- * structures.
+/* The g_sigactionpool is a pool of available signal action structures.
+ * It grows from the kernel heap as needed.
  */
 
-extern sq_queue_t  g_sigfreeaction;
+extern struct kmm_pool_s g_sigactionpool;
 
 /* The g_sigpendingaction data structure is a list of available pending
  * signal action structures.
@@ -165,7 +166,6 @@ struct task_group_s;
 /* sig_initializee.c */
 
 void weak_function nxsig_initialize(void);
-void               nxsig_alloc_actionblock(void);
 
 /* sig_action.c */
 
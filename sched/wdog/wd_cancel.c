@@ -73,8 +73,10 @@
 
 int wd_cancel(WDOG_ID wdog)
 {
+#ifndef CONFIG_WDOG_TIMERWHEEL
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
+#endif
   irqstate_t flags;
   int ret = -EINVAL;
 
@@ -90,6 +92,14 @@ int wd_cancel(WDOG_ID wdog)
 
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMERWHEEL
+      /* Unlink the watchdog from its timing wheel slot.  The interval timer
+       * is not reassessed:  If this watchdog was the next to expire, the
+       * worst case is one early timer event that finds nothing to do.
+       */
+
+      wd_wheel_remove(wdog);
+#else
       /* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
        * to do this because there are additional operations that need to be
        * done.
@@ -139,6 +149,7 @@ int wd_cancel(WDOG_ID wdog)
 
           sched_timer_reassess();
         }
+#endif
 
       /* Mark the watchdog inactive */
 
@@ -76,10 +76,11 @@ WDOG_ID wd_create (void)
 
   /* These actions must be atomic with respect to other tasks and also with
    * respect to interrupt handlers that may be allocating or freeing watchdog
-   * timers.
+   * timers.  Only the free list is involved so the private free list lock
+   * is sufficient.
    */
 
-  flags = enter_critical_section();
+  flags = spin_lock_save(&g_wdfreelock);
 
   /* If we are in an interrupt handler -OR- if the number of pre-allocated
    * timer structures exceeds the reserve, then take the next timer from
@@ -115,7 +116,7 @@ WDOG_ID wd_create (void)
           DEBUGASSERT(g_wdnfree == 0);
         }
 
-      leave_critical_section(flags);
+      spin_unlock_restore(&g_wdfreelock, flags);
     }
 
   /* We are in a normal tasking context AND there are not enough unreserved,
@@ -127,7 +128,7 @@ WDOG_ID wd_create (void)
     {
       /* We do not require that interrupts be disabled to do this. */
 
-      leave_critical_section(flags);
+      spin_unlock_restore(&g_wdfreelock, flags);
       wdog = (FAR struct wdog_s *)kmm_malloc(sizeof(struct wdog_s));
 
       /* Did we get one? */
@@ -82,8 +82,9 @@ int wd_delete(WDOG_ID wdog)
 
   DEBUGASSERT(wdog != NULL);
 
-  /* The following steps are atomic... the watchdog must not be active when
-   * it is being deallocated.
+  /* The watchdog must not be active when it is being deallocated.  The
+   * active list is also modified by the timer interrupt so this still
+   * requires the critical section.
    */
 
   flags = enter_critical_section();
@@ -97,6 +98,8 @@ int wd_delete(WDOG_ID wdog)
       wd_cancel(wdog);
     }
 
+  leave_critical_section(flags);
+
   /* Did this watchdog come from the pool of pre-allocated timers?  Or, was
    * it allocated from the heap?
    */
@@ -107,33 +110,26 @@ int wd_delete(WDOG_ID wdog)
        * memory.  If the timer was released from an interrupt handler,
        * sched_kfree() will defer the actual deallocation of the memory
        * until a more appropriate time.
-       *
-       * We don't need interrupts disabled to do this.
        */
 
-      leave_critical_section(flags);
       sched_kfree(wdog);
     }
 
-  /* Check if this is pre-allocated timer. */
+  /* Check if this is pre-allocated timer.  This function should not be
+   * called for statically allocated timers.
+   */
 
   else if (!WDOG_ISSTATIC(wdog))
     {
       /* Put the timer back on the free list and increment the count of free
-       * timers, all with interrupts disabled.
+       * timers, all with the free list locked.
        */
 
+      flags = spin_lock_save(&g_wdfreelock);
       sq_addlast((FAR sq_entry_t *)wdog, &g_wdfreelist);
       g_wdnfree++;
       DEBUGASSERT(g_wdnfree <= CONFIG_PREALLOC_WDOGS);
-      leave_critical_section(flags);
-    }
-
-  /* This function should not be called for statically allocated timers. */
-
-  else
-    {
-      leave_critical_section(flags);
+      spin_unlock_restore(&g_wdfreelock, flags);
     }
 
   /* Return success */
@@ -0,0 +1,510 @@
+/****************************************************************************
+ * sched/wdog/wd_wheel.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <queue.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/wdog.h>
+
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Mask of the tick bits below the slots of a wheel level */
+
+#define WDOG_WHEEL_LOWMASK(l) (((uint32_t)1 << WDOG_WHEEL_SHIFT(l)) - 1)
+
+/* The slot of a wheel level that holds the expiration time 't' */
+
+#define WDOG_WHEEL_INDEX(t,l) \
+  ((int)(((t) >> WDOG_WHEEL_SHIFT(l)) & WDOG_WHEEL_MASK))
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The hierarchical timing wheel that holds all active watchdogs */
+
+struct wd_wheel_s g_wdwheel;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_add
+ *
+ * Description:
+ *   File a watchdog into the slot selected by its expiration time relative
+ *   to the current wheel time.  Level n holds the watchdogs that expire
+ *   less than WDOG_WHEEL_NSLOTS**(n+1) ticks from now.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_add(FAR struct wdog_s *wdog)
+{
+  uint32_t expire = wdog->expire;
+  uint32_t delta  = expire - g_wdwheel.time;
+  int level;
+
+  if (delta >= WDOG_WHEEL_SPAN)
+    {
+      /* Too far in the future.  Park the watchdog in the most distant slot
+       * of the top level; it will be re-filed when that slot is cascaded.
+       */
+
+      level  = WDOG_WHEEL_NLEVELS - 1;
+      expire = g_wdwheel.time + WDOG_WHEEL_SPAN - 1;
+    }
+  else
+    {
+      for (level = 0;
+           level < WDOG_WHEEL_NLEVELS - 1 &&
+           delta > WDOG_WHEEL_LOWMASK(level + 1);
+           level++);
+    }
+
+  wdog->level = (uint8_t)level;
+  wdog->slot  = (uint8_t)WDOG_WHEEL_INDEX(expire, level);
+
+  dq_addlast((FAR dq_entry_t *)wdog,
+             &g_wdwheel.slot[level][wdog->slot]);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Move all watchdogs in one slot of an upper level down into the lower
+ *   levels.  This is done when the wheel time reaches the start of the time
+ *   range covered by that slot.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_cascade(int level, int index)
+{
+  FAR struct wdog_s *wdog;
+  dq_queue_t pending;
+
+  /* Detach the slot first:  A parked watchdog may be re-filed into the
+   * same slot.
+   */
+
+  pending = g_wdwheel.slot[level][index];
+  dq_init(&g_wdwheel.slot[level][index]);
+
+  while ((wdog = (FAR struct wdog_s *)dq_remfirst(&pending)) != NULL)
+    {
+      wd_wheel_add(wdog);
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_expiration
+ *
+ * Description:
+ *   Process the tick at the current wheel time:  Cascade the upper levels
+ *   if a level boundary has been reached, advance the wheel time, then
+ *   execute every watchdog in the level 0 slot for the tick.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_expiration(void)
+{
+  FAR struct wdog_s *wdog;
+  FAR dq_queue_t *slot;
+  uint32_t time = g_wdwheel.time;
+  int level;
+
+  /* The lower levels must be cascaded first */
+
+  for (level = 1;
+       level < WDOG_WHEEL_NLEVELS && (time & WDOG_WHEEL_LOWMASK(level)) == 0;
+       level++)
+    {
+      wd_wheel_cascade(level, WDOG_WHEEL_INDEX(time, level));
+    }
+
+  g_wdwheel.time = time + 1;
+
+  /* Watchdogs are removed one at a time so that a watchdog function may
+   * safely cancel or restart any other watchdog in the same slot.  A
+   * watchdog restarted with a delay of WDOG_WHEEL_NSLOTS - 1 ticks is
+   * added to the tail of this very slot; it must be left for the next
+   * revolution of the wheel.
+   */
+
+  slot = &g_wdwheel.slot[0][WDOG_WHEEL_INDEX(time, 0)];
+  while ((wdog = (FAR struct wdog_s *)slot->head) != NULL &&
+         wdog->expire == time)
+    {
+      (void)dq_remfirst(slot);
+      g_wdwheel.nactive--;
+
+      /* Indicate that the watchdog is no longer active. */
+
+      WDOG_CLRACTIVE(wdog);
+
+      /* Execute the watchdog function */
+
+      wd_execute(wdog);
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_next
+ *
+ * Description:
+ *   Return the number of idle ticks that may be skipped before the next
+ *   tick that must be processed by wd_wheel_expiration(), i.e. either the
+ *   expiration of a level 0 watchdog or the cascade of a non-empty upper
+ *   level slot.  The result is UINT32_MAX if there are no active
+ *   watchdogs.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS
+static uint32_t wd_wheel_next(void)
+{
+  uint32_t time = g_wdwheel.time;
+  uint32_t next = UINT32_MAX;
+  uint32_t base;
+  int level;
+  int i;
+
+  if (g_wdwheel.nactive == 0)
+    {
+      return UINT32_MAX;
+    }
+
+  /* Is a cascade due on this very tick? */
+
+  for (level = 1;
+       level < WDOG_WHEEL_NLEVELS && (time & WDOG_WHEEL_LOWMASK(level)) == 0;
+       level++)
+    {
+      if (g_wdwheel.slot[level][WDOG_WHEEL_INDEX(time, level)].head != NULL)
+        {
+          return 0;
+        }
+    }
+
+  /* Level 0 slots hold exactly one expiration time each */
+
+  for (i = 0; i < WDOG_WHEEL_NSLOTS; i++)
+    {
+      if (g_wdwheel.slot[0][WDOG_WHEEL_INDEX(time + i, 0)].head != NULL)
+        {
+          next = i;
+          break;
+        }
+    }
+
+  /* The upper levels can only contribute the start of a later slot.  Stop
+   * as soon as that cannot be earlier than what we already have.
+   */
+
+  for (level = 1; level < WDOG_WHEEL_NLEVELS; level++)
+    {
+      base = (time >> WDOG_WHEEL_SHIFT(level)) + 1;
+      if (next <= (base << WDOG_WHEEL_SHIFT(level)) - time)
+        {
+          break;
+        }
+
+      for (i = 0; i < WDOG_WHEEL_NSLOTS; i++)
+        {
+          if (g_wdwheel.slot[level][(base + i) & WDOG_WHEEL_MASK].head !=
+              NULL)
+            {
+              uint32_t start = (base + i) << WDOG_WHEEL_SHIFT(level);
+
+              if (start - time < next)
+                {
+                  next = start - time;
+                }
+
+              break;
+            }
+        }
+    }
+
+  DEBUGASSERT(next != UINT32_MAX);
+  return next;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_initialize
+ *
+ * Description:
+ *   Initialize the watchdog timing wheel.
+ *
+ ****************************************************************************/
+
+void wd_wheel_initialize(void)
+{
+  int level;
+  int i;
+
+  for (level = 0; level < WDOG_WHEEL_NLEVELS; level++)
+    {
+      for (i = 0; i < WDOG_WHEEL_NSLOTS; i++)
+        {
+          dq_init(&g_wdwheel.slot[level][i]);
+        }
+    }
+
+  g_wdwheel.time    = 0;
+  g_wdwheel.nactive = 0;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_insert
+ *
+ * Description:
+ *   Add a watchdog to the timing wheel so that it expires after 'delay'
+ *   further ticks have been processed by wd_timer().
+ *
+ * Input Parameters:
+ *   wdog  - The watchdog to add.  It must not already be active.
+ *   delay - The number of ticks until expiration (must be at least one)
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void wd_wheel_insert(FAR struct wdog_s *wdog, int32_t delay)
+{
+  DEBUGASSERT(delay > 0);
+
+#ifdef CONFIG_SCHED_TICKLESS
+  /* wd_timer() is not called while the wheel is empty so the tickbase must
+   * be brought up to date when the first watchdog is added.
+   */
+
+  if (g_wdwheel.nactive == 0)
+    {
+      g_wdtickbase = clock_systimer();
+    }
+#endif
+
+  /* The tick at the current wheel time is the first tick to be processed */
+
+  wdog->expire = g_wdwheel.time + (uint32_t)delay - 1;
+  wd_wheel_add(wdog);
+  g_wdwheel.nactive++;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remove
+ *
+ * Description:
+ *   Remove an active watchdog from the timing wheel.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void wd_wheel_remove(FAR struct wdog_s *wdog)
+{
+  DEBUGASSERT(g_wdwheel.nactive > 0);
+
+  dq_rem((FAR dq_entry_t *)wdog, &g_wdwheel.slot[wdog->level][wdog->slot]);
+  g_wdwheel.nactive--;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remaining
+ *
+ * Description:
+ *   Return the number of ticks that remain before an active watchdog
+ *   expires (not accounting for wd_elapse()).
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+int wd_wheel_remaining(FAR struct wdog_s *wdog)
+{
+  return (int)(wdog->expire - g_wdwheel.time) + 1;
+}
+
+/****************************************************************************
+ * Name: wd_timer
+ *
+ * Description:
+ *   This function is called from the timer interrupt handler to determine
+ *   if it is time to execute a watchdog function.  If so, the watchdog
+ *   function will be executed in the context of the timer interrupt
+ *   handler.
+ *
+ * Input Parameters:
+ *   ticks - If CONFIG_SCHED_TICKLESS is defined then the number of ticks
+ *     in the interval that just expired is provided.  Otherwise,
+ *     this function is called on each timer interrupt and a value of one
+ *     is implicit.
+ *
+ * Returned Value:
+ *   If CONFIG_SCHED_TICKLESS is defined then the number of ticks for the
+ *   next delay is provided (zero if no delay).  Otherwise, this function
+ *   has no returned value.
+ *
+ * Assumptions:
+ *   Called from interrupt handler logic with interrupts disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS
+unsigned int wd_timer(int ticks)
+{
+#ifdef CONFIG_SMP
+  irqstate_t flags;
+#endif
+  unsigned int ret;
+  uint32_t next;
+
+#ifdef CONFIG_SMP
+  /* We are in an interrupt handler as, as a consequence, interrupts are
+   * disabled.  But in the SMP case, interrupts MAY be disabled only on
+   * the local CPU since most architectures do not permit disabling
+   * interrupts on other CPUS.
+   *
+   * Hence, we must follow rules for critical sections even here in the
+   * SMP case.
+   */
+
+  flags = enter_critical_section();
+#endif
+
+  /* Process only the ticks that have something to do, skipping over the
+   * idle ticks between them.
+   */
+
+  while (ticks > 0 && g_wdwheel.nactive > 0)
+    {
+      next = wd_wheel_next();
+      if (next >= (uint32_t)ticks)
+        {
+          break;
+        }
+
+      g_wdwheel.time += next;
+      g_wdtickbase   += next + 1;
+      ticks          -= next + 1;
+
+      wd_wheel_expiration();
+    }
+
+  /* Update the wheel time and the clock tickbase */
+
+  if (ticks > 0)
+    {
+      g_wdwheel.time += ticks;
+      g_wdtickbase   += ticks;
+    }
+
+  /* Return the delay for the next watchdog to expire.  This may be the
+   * time of a cascade rather than an expiration, in which case we will
+   * simply be called again a little earlier than necessary.
+   */
+
+  ret = g_wdwheel.nactive > 0 ? wd_wheel_next() + 1 : 0;
+
+#ifdef CONFIG_SMP
+  leave_critical_section(flags);
+#endif
+
+  return ret;
+}
+
+#else
+void wd_timer(void)
+{
+#ifdef CONFIG_SMP
+  irqstate_t flags;
+
+  /* We are in an interrupt handler as, as a consequence, interrupts are
+   * disabled.  But in the SMP case, interrupts MAY be disabled only on
+   * the local CPU since most architectures do not permit disabling
+   * interrupts on other CPUS.
+   *
+   * Hence, we must follow rules for critical sections even here in the
+   * SMP case.
+   */
+
+  flags = enter_critical_section();
+#endif
+
+  /* Check if there are any active watchdogs to process */
+
+  if (g_wdwheel.nactive > 0)
+    {
+      wd_wheel_expiration();
+    }
+  else
+    {
+      g_wdwheel.time++;
+    }
+
+#ifdef CONFIG_SMP
+  leave_critical_section(flags);
+#endif
+}
+#endif /* CONFIG_SCHED_TICKLESS */
+#endif /* CONFIG_WDOG_TIMERWHEEL */
@@ -45,14 +45,33 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include <queue.h>
+
 #include <nuttx/compiler.h>
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
 #include <nuttx/wdog.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* Timing wheel geometry.  Each level has WDOG_WHEEL_NSLOTS slots and each
+ * slot of level n spans WDOG_WHEEL_NSLOTS**n ticks.  Delays longer than
+ * WDOG_WHEEL_SPAN ticks are parked in the top level and re-filed each time
+ * that they are cascaded.
+ */
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+#  define WDOG_WHEEL_BITS     CONFIG_WDOG_TIMERWHEEL_BITS
+#  define WDOG_WHEEL_NLEVELS  CONFIG_WDOG_TIMERWHEEL_LEVELS
+#  define WDOG_WHEEL_NSLOTS   (1 << WDOG_WHEEL_BITS)
+#  define WDOG_WHEEL_MASK     (WDOG_WHEEL_NSLOTS - 1)
+#  define WDOG_WHEEL_SHIFT(l) ((l) * WDOG_WHEEL_BITS)
+#  define WDOG_WHEEL_SPAN \
+     ((uint32_t)1 << WDOG_WHEEL_SHIFT(WDOG_WHEEL_NLEVELS))
+#endif
+
 /****************************************************************************
  * Name: wd_elapse
  *
@@ -88,12 +107,30 @@ extern "C"
 
 extern sq_queue_t g_wdfreelist;
 
+#ifdef CONFIG_WDOG_TIMERWHEEL
+/* The g_wdwheel data structure holds the active watchdogs in a
+ * hierarchical timing wheel.  Watchdogs are hashed into a slot by their
+ * expiration time so that starting and cancelling a watchdog are O(1)
+ * operations.  Watchdogs in the upper levels are cascaded down into the
+ * lower levels as time advances.
+ */
+
+struct wd_wheel_s
+{
+  uint32_t     time;              /* The next tick to be processed */
+  unsigned int nactive;           /* The number of active watchdogs */
+  dq_queue_t   slot[WDOG_WHEEL_NLEVELS][WDOG_WHEEL_NSLOTS];
+};
+
+extern struct wd_wheel_s g_wdwheel;
+#else
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 extern sq_queue_t g_wdactivelist;
+#endif
 
 /* This is the number of free, pre-allocated watchdog structures in the
  * g_wdfreelist.  This value is used to enforce a reserve for interrupt
@@ -102,6 +139,14 @@ extern sq_queue_t g_wdactivelist;
 
 extern uint16_t g_wdnfree;
 
+#ifdef CONFIG_SMP
+/* This spinlock protects g_wdfreelist and g_wdnfree so that allocating and
+ * freeing watchdogs does not require the global IRQ lock.
+ */
+
+extern volatile spinlock_t g_wdfreelock;
+#endif
+
 /* This is wdog tickbase, for wd_gettime() may called many times
  * between 2 times of wd_timer(), we use it to update wd_gettime().
  */
@@ -188,6 +233,86 @@ void wd_timer(void);
 struct tcb_s;
 void wd_recover(FAR struct tcb_s *tcb);
 
+/****************************************************************************
+ * Name: wd_execute
+ *
+ * Description:
+ *   Execute the function of a watchdog that has just expired.  The
+ *   watchdog must already have been removed from the active timers.
+ *
+ * Input Parameters:
+ *   wdog - The expired watchdog
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from interrupt handler logic with interrupts disabled.
+ *
+ ****************************************************************************/
+
+void wd_execute(FAR struct wdog_s *wdog);
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+/****************************************************************************
+ * Name: wd_wheel_initialize
+ *
+ * Description:
+ *   Initialize the watchdog timing wheel.
+ *
+ ****************************************************************************/
+
+void wd_wheel_initialize(void);
+
+/****************************************************************************
+ * Name: wd_wheel_insert
+ *
+ * Description:
+ *   Add a watchdog to the timing wheel so that it expires after 'delay'
+ *   further ticks have been processed by wd_timer().
+ *
+ * Input Parameters:
+ *   wdog  - The watchdog to add.  It must not already be active.
+ *   delay - The number of ticks until expiration (must be at least one)
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void wd_wheel_insert(FAR struct wdog_s *wdog, int32_t delay);
+
+/****************************************************************************
+ * Name: wd_wheel_remove
+ *
+ * Description:
+ *   Remove an active watchdog from the timing wheel.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void wd_wheel_remove(FAR struct wdog_s *wdog);
+
+/****************************************************************************
+ * Name: wd_wheel_remaining
+ *
+ * Description:
+ *   Return the number of ticks that remain before an active watchdog
+ *   expires (not accounting for wd_elapse()).
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+int wd_wheel_remaining(FAR struct wdog_s *wdog);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -89,7 +89,7 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
    * new work is typically added to the work queue from interrupt handlers.
    */
 
-  flags = enter_critical_section();
+  flags = spin_lock_save(&wqueue->lock);
   if (work->worker != NULL)
     {
       /* A little test of the integrity of the work queue */
@@ -108,7 +108,7 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
       ret = OK;
     }
 
-  leave_critical_section(flags);
+  spin_unlock_restore(&wqueue->lock, flags);
   return ret;
 }
 
@@ -50,6 +50,7 @@
 #include <nuttx/kthread.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/clock.h>
+#include <nuttx/semaphore.h>
 
 #include "wqueue/wqueue.h"
 
@@ -193,8 +194,19 @@ int work_hpstart(void)
 
   sinfo("Starting high-priority kernel worker thread(s)\n");
 
+#ifdef CONFIG_SMP
+  spin_initialize(&g_hpwork.lock, SP_UNLOCKED);
+#endif
+
   for (wndx = 0; wndx < CONFIG_SCHED_HPNTHREADS; wndx++)
     {
+      /* The worker waits on this semaphore when it is idle.  It is used for
+       * signalling only, so priority inheritance must be disabled.
+       */
+
+      nxsem_init(&g_hpwork.worker[wndx].wake, 0, 0);
+      (void)nxsem_setprotocol(&g_hpwork.worker[wndx].wake, SEM_PRIO_NONE);
+
       pid = kthread_create(HPWORKNAME, CONFIG_SCHED_HPWORKPRIORITY,
                            CONFIG_SCHED_HPWORKSTACKSIZE,
                            (main_t)work_hpthread,
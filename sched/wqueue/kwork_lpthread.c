@@ -50,6 +50,7 @@
 #include <nuttx/kthread.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/clock.h>
+#include <nuttx/semaphore.h>
 
 #include "wqueue/wqueue.h"
 
@@ -189,8 +190,19 @@ int work_lpstart(void)
 
   sinfo("Starting low-priority kernel worker thread(s)\n");
 
+#ifdef CONFIG_SMP
+  spin_initialize(&g_lpwork.lock, SP_UNLOCKED);
+#endif
+
   for (wndx = 0; wndx < CONFIG_SCHED_LPNTHREADS; wndx++)
     {
+      /* The worker waits on this semaphore when it is idle.  It is used for
+       * signalling only, so priority inheritance must be disabled.
+       */
+
+      nxsem_init(&g_lpwork.worker[wndx].wake, 0, 0);
+      (void)nxsem_setprotocol(&g_lpwork.worker[wndx].wake, SEM_PRIO_NONE);
+
       pid = kthread_create(LPWORKNAME, CONFIG_SCHED_LPWORKPRIORITY,
                            CONFIG_SCHED_LPWORKSTACKSIZE,
                            (main_t)work_lpthread,
@@ -41,13 +41,12 @@
 
 #include <stdint.h>
 #include <unistd.h>
-#include <signal.h>
 #include <assert.h>
 #include <queue.h>
 
 #include <nuttx/irq.h>
 #include <nuttx/clock.h>
-#include <nuttx/signal.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/wqueue.h>
 
 #include "wqueue/wqueue.h"
@@ -111,19 +110,19 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
   clock_t ctick;
   clock_t next;
 
-  /* Then process queued work.  We need to keep interrupts disabled while
+  /* Then process queued work.  We need to hold the work queue lock while
    * we process items in the work list.
    */
 
   next  = WORK_DELAY_MAX;
-  flags = enter_critical_section();
+  flags = spin_lock_save(&wqueue->lock);
 
   /* Get the time that we started processing the queue in clock ticks. */
 
   stick = clock_systimer();
 
-  /* And check each entry in the work queue.  Since we have disabled
-   * interrupts we know:  (1) we will not be suspended unless we do
+  /* And check each entry in the work queue.  Since we hold the lock with
+   * interrupts disabled we know:  (1) we will not be suspended unless we do
    * so ourselves, and (2) there will be no changes to the work queue
    */
 
@@ -168,7 +167,7 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
                * performed... we don't have any idea how long this will take!
                */
 
-              leave_critical_section(flags);
+              spin_unlock_restore(&wqueue->lock, flags);
               worker(arg);
 
               /* Now, unfortunately, since we re-enabled interrupts we don't
@@ -176,7 +175,7 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
                * back at the head of the list.
                */
 
-              flags = enter_critical_section();
+              flags = spin_lock_save(&wqueue->lock);
               work  = (FAR struct work_s *)wqueue->q.head;
             }
           else
@@ -221,6 +220,14 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
         }
     }
 
+  /* The worker is marked idle while the lock is still held.  Work queued
+   * after the lock is released will then find the worker idle and post its
+   * semaphore, so the wake-up is not lost even if it comes before we wait.
+   */
+
+  wqueue->worker[wndx].busy = false;
+  spin_unlock_restore(&wqueue->lock, flags);
+
   /* When multiple worker threads are created for this work queue, only
    * thread 0 (wndx = 0) will monitor the unexpired works.
    *
@@ -232,30 +239,22 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
 
   if (wndx > 0 || next == WORK_DELAY_MAX)
     {
-      sigset_t set;
-
-      /* Wait indefinitely until signalled with SIGWORK */
-
-      sigemptyset(&set);
-      sigaddset(&set, SIGWORK);
+      /* Wait indefinitely until work_signal() is called */
 
-      wqueue->worker[wndx].busy = false;
-      DEBUGVERIFY(nxsig_waitinfo(&set, NULL));
-      wqueue->worker[wndx].busy = true;
+      (void)nxsem_wait(&wqueue->worker[wndx].wake);
     }
   else
     {
       /* Wait a while to check the work list.  We will wait here until
-       * either the time elapses or until we are awakened by a signal.
-       * Interrupts will be re-enabled while we wait.
+       * either the time elapses or until we are awakened by
+       * work_signal().
        */
 
-      wqueue->worker[wndx].busy = false;
-      nxsig_usleep(next * USEC_PER_TICK);
-      wqueue->worker[wndx].busy = true;
+      (void)nxsem_tickwait(&wqueue->worker[wndx].wake, clock_systimer(),
+                           MIN(next, UINT32_MAX));
     }
 
-  leave_critical_section(flags);
+  wqueue->worker[wndx].busy = true;
 }
 
 #endif /* CONFIG_SCHED_WORKQUEUE */
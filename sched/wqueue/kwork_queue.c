@@ -95,10 +95,11 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
   DEBUGASSERT(work != NULL && worker != NULL);
 
   /* Interrupts are disabled so that this logic can be called from with task
-   * logic or ifrom nterrupt handling logic.
+   * logic or ifrom nterrupt handling logic.  Only the lock of this work
+   * queue is taken; other CPUs are not held off.
    */
 
-  flags = enter_critical_section();
+  flags = spin_lock_save(&wqueue->lock);
 
   /* Is there already pending work? */
 
@@ -123,7 +124,7 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
 
   dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
 
-  leave_critical_section(flags);
+  spin_unlock_restore(&wqueue->lock, flags);
 }
 
 /****************************************************************************
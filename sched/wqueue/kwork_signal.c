@@ -39,11 +39,10 @@
 
 #include <nuttx/config.h>
 
-#include <signal.h>
 #include <errno.h>
 
 #include <nuttx/wqueue.h>
-#include <nuttx/signal.h>
+#include <nuttx/semaphore.h>
 
 #include "wqueue/wqueue.h"
 
@@ -118,9 +117,12 @@ int work_signal(int qid)
       return OK;
     }
 
-  /* Otherwise, signal the first IDLE thread found */
+  /* Otherwise, wake up the first IDLE thread found.  If the thread has
+   * not started waiting yet, the count is left on the semaphore and the
+   * thread will not wait at all.
+   */
 
-  return nxsig_kill(work->worker[i].pid, SIGWORK);
+  return nxsem_post(&work->worker[i].wake);
 }
 
 #endif /* CONFIG_SCHED_WORKQUEUE */
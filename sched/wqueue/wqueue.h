@@ -44,9 +44,11 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <semaphore.h>
 #include <queue.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/spinlock.h>
 
 #ifdef CONFIG_SCHED_WORKQUEUE
 
@@ -69,13 +71,20 @@ struct kworker_s
 {
   pid_t             pid;    /* The task ID of the worker thread */
   volatile bool     busy;   /* True: Worker is not available */
+  sem_t             wake;   /* Posted to wake up the idle worker */
 };
 
-/* This structure defines the state of one kernel-mode work queue */
+/* This structure defines the state of one kernel-mode work queue.  The
+ * queue is protected by its own spinlock rather than by the critical
+ * section, so queueing work on one queue does not stall the other CPUs.
+ */
 
 struct kwork_wqueue_s
 {
   struct dq_queue_s q;         /* The queue of pending work */
+#ifdef CONFIG_SMP
+  volatile spinlock_t lock;    /* Protects the queue */
+#endif
   struct kworker_s  worker[1]; /* Describes a worker thread */
 };
 
@@ -87,6 +96,9 @@ struct kwork_wqueue_s
 struct hp_wqueue_s
 {
   struct dq_queue_s q;         /* The queue of pending work */
+#ifdef CONFIG_SMP
+  volatile spinlock_t lock;    /* Protects the queue */
+#endif
 
   /* Describes each thread in the high priority queue's thread pool */
 
@@ -102,6 +114,9 @@ struct hp_wqueue_s
 struct lp_wqueue_s
 {
   struct dq_queue_s q;      /* The queue of pending work */
+#ifdef CONFIG_SMP
+  volatile spinlock_t lock; /* Protects the queue */
+#endif
 
   /* Describes each thread in the low priority queue's thread pool */
 
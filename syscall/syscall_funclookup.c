@@ -58,6 +58,7 @@
 #include <sys/socket.h>
 #include <sys/mount.h>
 #include <sys/boardctl.h>
+#include <sys/ioring.h>
 
 #include <stdio.h>
 #include <stdlib.h>
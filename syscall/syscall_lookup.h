@@ -217,6 +217,10 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(aio_write,                1, STUB_aio_write)
   SYSCALL_LOOKUP(aio_fsync,                2, STUB_aio_fsync)
   SYSCALL_LOOKUP(aio_cancel,               2, STUB_aio_cancel)
+#endif
+#ifdef CONFIG_FS_IORING
+  SYSCALL_LOOKUP(ioring_setup,             2, STUB_ioring_setup)
+  SYSCALL_LOOKUP(ioring_enter,             4, STUB_ioring_enter)
 #endif
   SYSCALL_LOOKUP(poll,                     3, STUB_poll)
   SYSCALL_LOOKUP(select,                   5, STUB_select)
@@ -387,7 +391,11 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(listen,                   2, STUB_listen)
   SYSCALL_LOOKUP(recv,                     4, STUB_recv)
   SYSCALL_LOOKUP(recvfrom,                 6, STUB_recvfrom)
+  SYSCALL_LOOKUP(recvmmsg,                 5, STUB_recvmmsg)
+  SYSCALL_LOOKUP(recvmsg,                  3, STUB_recvmsg)
   SYSCALL_LOOKUP(send,                     4, STUB_send)
+  SYSCALL_LOOKUP(sendmmsg,                 4, STUB_sendmmsg)
+  SYSCALL_LOOKUP(sendmsg,                  3, STUB_sendmsg)
   SYSCALL_LOOKUP(sendto,                   6, STUB_sendto)
   SYSCALL_LOOKUP(setsockopt,               5, STUB_setsockopt)
   SYSCALL_LOOKUP(socket,                   3, STUB_socket)
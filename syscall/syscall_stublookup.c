@@ -230,6 +230,12 @@ uintptr_t STUB_aio_write(int nbr, uintptr_t parm1);
 uintptr_t STUB_aio_fsync(int nbr, uintptr_t parm1, uintptr_t parm2);
 uintptr_t STUB_aio_cancel(int nbr, uintptr_t parm1, uintptr_t parm2);
 
+/* Submission/completion ring I/O */
+
+uintptr_t STUB_ioring_setup(int nbr, uintptr_t parm1, uintptr_t parm2);
+uintptr_t STUB_ioring_enter(int nbr, uintptr_t parm1, uintptr_t parm2,
+            uintptr_t parm3, uintptr_t parm4);
+
 /* Network interface indices */
 
 uintptr_t STUB_if_indextoname(int nbr, uintptr_t parm1, uintptr_t parm2);
@@ -406,8 +412,16 @@ uintptr_t STUB_recv(int nbr, uintptr_t parm1, uintptr_t parm2,
 uintptr_t STUB_recvfrom(int nbr, uintptr_t parm1, uintptr_t parm2,
             uintptr_t parm3, uintptr_t parm4, uintptr_t parm5,
             uintptr_t parm6);
+uintptr_t STUB_recvmmsg(int nbr, uintptr_t parm1, uintptr_t parm2,
+            uintptr_t parm3, uintptr_t parm4, uintptr_t parm5);
+uintptr_t STUB_recvmsg(int nbr, uintptr_t parm1, uintptr_t parm2,
+            uintptr_t parm3);
 uintptr_t STUB_send(int nbr, uintptr_t parm1, uintptr_t parm2,
             uintptr_t parm3, uintptr_t parm4);
+uintptr_t STUB_sendmmsg(int nbr, uintptr_t parm1, uintptr_t parm2,
+            uintptr_t parm3, uintptr_t parm4);
+uintptr_t STUB_sendmsg(int nbr, uintptr_t parm1, uintptr_t parm2,
+            uintptr_t parm3);
 uintptr_t STUB_sendto(int nbr, uintptr_t parm1, uintptr_t parm2,
             uintptr_t parm3, uintptr_t parm4, uintptr_t parm5,
             uintptr_t parm6);
@@ -0,0 +1,501 @@
+/****************************************************************************
+ * tools/note2json.c
+ *
+ *   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* These must agree with enum note_type_e in include/nuttx/sched_note.h */
+
+#define NOTE_START           0
+#define NOTE_STOP            1
+#define NOTE_SUSPEND         2
+#define NOTE_RESUME          3
+#define NOTE_CPU_START       4
+#define NOTE_CPU_STARTED     5
+#define NOTE_CPU_PAUSE       6
+#define NOTE_CPU_PAUSED      7
+#define NOTE_CPU_RESUME      8
+#define NOTE_CPU_RESUMED     9
+#define NOTE_PREEMPT_LOCK    10
+#define NOTE_PREEMPT_UNLOCK  11
+#define NOTE_CSECTION_ENTER  12
+#define NOTE_CSECTION_LEAVE  13
+#define NOTE_SPINLOCK_LOCK   14
+#define NOTE_SPINLOCK_LOCKED 15
+#define NOTE_SPINLOCK_UNLOCK 16
+#define NOTE_SPINLOCK_ABORT  17
+#define NOTE_DROPPED         18
+#define NOTE_NTYPES          19
+
+#define MAX_NOTE_SIZE        255
+#define MAX_CPUS             32
+#define MAX_PIDS             65536
+#define DEFAULT_FREQUENCY    100
+
+/* Each CPU is shown as a thread of one process.  Critical sections and
+ * pre-emption locks are shown on separate threads beneath each CPU.
+ */
+
+#define CPU_TID(c)           (3 * (c))
+#define CSECTION_TID(c)      (3 * (c) + 1)
+#define PREEMPT_TID(c)       (3 * (c) + 2)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const char *g_typename[NOTE_NTYPES] =
+{
+  "start", "stop", "suspend", "resume",
+  "cpu_start", "cpu_started", "cpu_pause", "cpu_paused",
+  "cpu_resume", "cpu_resumed", "preempt_lock", "preempt_unlock",
+  "csection_enter", "csection_leave", "spinlock_lock", "spinlock_locked",
+  "spinlock_unlock", "spinlock_abort", "dropped"
+};
+
+static char *g_names[MAX_PIDS];     /* Task names from NOTE_START */
+static int   g_running[MAX_CPUS];   /* PID running on each CPU or -1 */
+static bool  g_csection[MAX_CPUS];  /* CPU is in a critical section */
+static bool  g_preempt[MAX_CPUS];   /* CPU has pre-emption locked */
+static bool  g_seen[MAX_CPUS];      /* CPU has produced a note */
+static bool  g_smp;                 /* Notes include the CPU number */
+static double g_frequency = DEFAULT_FREQUENCY;
+static uint64_t g_time;             /* Extended time stamp */
+static uint32_t g_lasttime;
+static bool  g_started;             /* A time stamp has been seen */
+static bool  g_first = true;        /* Next event is the first event */
+static FILE *g_outstream;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void show_usage(const char *progname)
+{
+  fprintf(stderr, "USAGE: %s [-s] [-f <frequency>] [<note-file> "
+                  "[<json-file>]]\n\n", progname);
+  fprintf(stderr, "Where:\n\n");
+  fprintf(stderr, "  <note-file>    : Binary notes read from /dev/note "
+                  "(default: stdin)\n");
+  fprintf(stderr, "  <json-file>    : Trace event JSON output "
+                  "(default: stdout)\n");
+  fprintf(stderr, "  -s             : The notes were recorded with "
+                  "CONFIG_SMP=y\n");
+  fprintf(stderr, "  -f <frequency> : Time stamp units per second "
+                  "(default: %d)\n", DEFAULT_FREQUENCY);
+  exit(EXIT_FAILURE);
+}
+
+static unsigned int get16(const uint8_t *ptr)
+{
+  return (unsigned int)ptr[0] | ((unsigned int)ptr[1] << 8);
+}
+
+static uint32_t get32(const uint8_t *ptr)
+{
+  return (uint32_t)ptr[0] | ((uint32_t)ptr[1] << 8) |
+         ((uint32_t)ptr[2] << 16) | ((uint32_t)ptr[3] << 24);
+}
+
+static const char *task_name(int pid)
+{
+  static char buffer[16];
+
+  if (g_names[pid] != NULL)
+    {
+      return g_names[pid];
+    }
+
+  snprintf(buffer, sizeof(buffer), "pid %d", pid);
+  return buffer;
+}
+
+/* Emit one trace event.  The name is quoted without escaping:  Task names
+ * must not contain quotation marks or backslashes.
+ */
+
+static void emit(const char *ph, const char *name, int tid, int pid,
+                 const char *args)
+{
+  double usec = (double)g_time * 1000000.0 / g_frequency;
+
+  fprintf(g_outstream, "%s\n  {\"name\":\"%s\",\"ph\":\"%s\","
+          "\"ts\":%.3f,\"pid\":0,\"tid\":%d",
+          g_first ? "" : ",", name, ph, usec, tid);
+  g_first = false;
+
+  if (ph[0] == 'i')
+    {
+      fprintf(g_outstream, ",\"s\":\"t\"");
+    }
+
+  fprintf(g_outstream, ",\"args\":{\"pid\":%d%s%s}}", pid,
+          args != NULL ? "," : "", args != NULL ? args : "");
+}
+
+static void emit_cpu_names(void)
+{
+  int cpu;
+
+  for (cpu = 0; cpu < MAX_CPUS; cpu++)
+    {
+      if (g_seen[cpu])
+        {
+          fprintf(g_outstream, "%s\n  {\"name\":\"thread_name\","
+                  "\"ph\":\"M\",\"pid\":0,\"tid\":%d,"
+                  "\"args\":{\"name\":\"CPU %d\"}}",
+                  g_first ? "" : ",", CPU_TID(cpu), cpu);
+          g_first = false;
+          fprintf(g_outstream, ",\n  {\"name\":\"thread_name\","
+                  "\"ph\":\"M\",\"pid\":0,\"tid\":%d,"
+                  "\"args\":{\"name\":\"CPU %d csection\"}}",
+                  CSECTION_TID(cpu), cpu);
+          fprintf(g_outstream, ",\n  {\"name\":\"thread_name\","
+                  "\"ph\":\"M\",\"pid\":0,\"tid\":%d,"
+                  "\"args\":{\"name\":\"CPU %d sched_lock\"}}",
+                  PREEMPT_TID(cpu), cpu);
+        }
+    }
+}
+
+/* Close every slice still open so that the viewer shows them */
+
+static void close_slices(void)
+{
+  int cpu;
+
+  for (cpu = 0; cpu < MAX_CPUS; cpu++)
+    {
+      if (g_running[cpu] >= 0)
+        {
+          emit("E", task_name(g_running[cpu]), CPU_TID(cpu),
+               g_running[cpu], NULL);
+          g_running[cpu] = -1;
+        }
+
+      if (g_csection[cpu])
+        {
+          emit("E", "csection", CSECTION_TID(cpu), 0, NULL);
+          g_csection[cpu] = false;
+        }
+
+      if (g_preempt[cpu])
+        {
+          emit("E", "sched_lock", PREEMPT_TID(cpu), 0, NULL);
+          g_preempt[cpu] = false;
+        }
+    }
+}
+
+static void process_note(const uint8_t *note, int length)
+{
+  char args[64];
+  const uint8_t *payload;
+  uint32_t systime;
+  int hdrlen;
+  int type;
+  int cpu;
+  int pid;
+
+  hdrlen  = g_smp ? 10 : 9;
+  if (length < hdrlen)
+    {
+      fprintf(stderr, "WARNING: Skipping short note\n");
+      return;
+    }
+
+  type    = note[1];
+  cpu     = g_smp ? note[3] : 0;
+  pid     = get16(&note[hdrlen - 6]);
+  systime = get32(&note[hdrlen - 4]);
+  payload = &note[hdrlen];
+
+  if (cpu >= MAX_CPUS)
+    {
+      fprintf(stderr, "WARNING: Skipping note from CPU %d\n", cpu);
+      return;
+    }
+
+  /* Time stamps are 32-bit and wrap.  The notes are in time order, so
+   * accumulate the differences into a 64-bit time.
+   */
+
+  if (g_started)
+    {
+      g_time += (uint32_t)(systime - g_lasttime);
+    }
+
+  g_started   = true;
+  g_lasttime  = systime;
+  g_seen[cpu] = true;
+
+  switch (type)
+    {
+      case NOTE_START:
+        free(g_names[pid]);
+        g_names[pid] = NULL;
+
+        if (length > hdrlen)
+          {
+            g_names[pid] = strndup((const char *)payload, length - hdrlen);
+          }
+
+        emit("i", "start", CPU_TID(cpu), pid, NULL);
+        break;
+
+      case NOTE_STOP:
+      case NOTE_SUSPEND:
+        if (g_running[cpu] >= 0)
+          {
+            emit("E", task_name(g_running[cpu]), CPU_TID(cpu),
+                 g_running[cpu], NULL);
+            g_running[cpu] = -1;
+          }
+
+        if (type == NOTE_SUSPEND && length > hdrlen)
+          {
+            snprintf(args, sizeof(args), "\"state\":%u", payload[0]);
+            emit("i", "suspend", CPU_TID(cpu), pid, args);
+          }
+        break;
+
+      case NOTE_RESUME:
+        if (g_running[cpu] >= 0)
+          {
+            emit("E", task_name(g_running[cpu]), CPU_TID(cpu),
+                 g_running[cpu], NULL);
+          }
+
+        emit("B", task_name(pid), CPU_TID(cpu), pid, NULL);
+        g_running[cpu] = pid;
+        break;
+
+      case NOTE_CSECTION_ENTER:
+      case NOTE_CSECTION_LEAVE:
+        if (g_csection[cpu])
+          {
+            emit("E", "csection", CSECTION_TID(cpu), pid, NULL);
+            g_csection[cpu] = false;
+          }
+
+        if (type == NOTE_CSECTION_ENTER)
+          {
+            emit("B", "csection", CSECTION_TID(cpu), pid, NULL);
+            g_csection[cpu] = true;
+          }
+        break;
+
+      case NOTE_PREEMPT_LOCK:
+      case NOTE_PREEMPT_UNLOCK:
+        {
+          unsigned int count = length >= hdrlen + 2 ? get16(payload) : 0;
+
+          if (type == NOTE_PREEMPT_LOCK && !g_preempt[cpu])
+            {
+              emit("B", "sched_lock", PREEMPT_TID(cpu), pid, NULL);
+              g_preempt[cpu] = true;
+            }
+          else if (type == NOTE_PREEMPT_UNLOCK && count == 0 &&
+                   g_preempt[cpu])
+            {
+              emit("E", "sched_lock", PREEMPT_TID(cpu), pid, NULL);
+              g_preempt[cpu] = false;
+            }
+        }
+        break;
+
+      case NOTE_CPU_START:
+      case NOTE_CPU_PAUSE:
+      case NOTE_CPU_RESUME:
+        snprintf(args, sizeof(args), "\"target\":%u",
+                 length > hdrlen ? payload[0] : 0);
+        emit("i", g_typename[type], CPU_TID(cpu), pid, args);
+        break;
+
+      case NOTE_DROPPED:
+        snprintf(args, sizeof(args), "\"count\":%u",
+                 length >= hdrlen + 2 ? get16(payload) : 0);
+        emit("i", "dropped", CPU_TID(cpu), pid, args);
+        break;
+
+      default:
+        if (type < NOTE_NTYPES)
+          {
+            emit("i", g_typename[type], CPU_TID(cpu), pid, NULL);
+          }
+        else
+          {
+            fprintf(stderr, "WARNING: Unknown note type %d\n", type);
+          }
+        break;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char **argv)
+{
+  uint8_t note[MAX_NOTE_SIZE];
+  FILE *instream;
+  char *endptr;
+  int length;
+  int ch;
+  int i;
+
+  while ((ch = getopt(argc, argv, ":sf:h")) > 0)
+    {
+      switch (ch)
+        {
+          case 's' :
+            g_smp = true;
+            break;
+
+          case 'f' :
+            g_frequency = strtod(optarg, &endptr);
+            if (*endptr != '\0' || g_frequency <= 0.0)
+              {
+                fprintf(stderr, "ERROR: Invalid frequency: %s\n", optarg);
+                show_usage(argv[0]);
+              }
+            break;
+
+          case 'h' :
+            show_usage(argv[0]);
+            break;
+
+          case '?' :
+            fprintf(stderr, "Unrecognized option: %c\n", optopt);
+            show_usage(argv[0]);
+            break;
+
+          case ':' :
+            fprintf(stderr, "Missing option argument, option: %c\n",
+                    optopt);
+            show_usage(argv[0]);
+        }
+    }
+
+  if (argc - optind > 2)
+    {
+      fprintf(stderr, "Unexpected garbage at the end of the line\n");
+      show_usage(argv[0]);
+    }
+
+  instream = stdin;
+  if (optind < argc)
+    {
+      instream = fopen(argv[optind], "rb");
+      if (instream == NULL)
+        {
+          fprintf(stderr, "ERROR: Failed to open %s: %s\n",
+                  argv[optind], strerror(errno));
+          exit(EXIT_FAILURE);
+        }
+    }
+
+  g_outstream = stdout;
+  if (optind + 1 < argc)
+    {
+      g_outstream = fopen(argv[optind + 1], "w");
+      if (g_outstream == NULL)
+        {
+          fprintf(stderr, "ERROR: Failed to open %s: %s\n",
+                  argv[optind + 1], strerror(errno));
+          exit(EXIT_FAILURE);
+        }
+    }
+
+  for (i = 0; i < MAX_CPUS; i++)
+    {
+      g_running[i] = -1;
+    }
+
+  fprintf(g_outstream, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+  /* Each note begins with its length.  Read the length, then the rest of
+   * the note.
+   */
+
+  while ((ch = fgetc(instream)) != EOF)
+    {
+      length  = ch;
+      note[0] = (uint8_t)ch;
+
+      if (length < 2)
+        {
+          fprintf(stderr, "ERROR: Bad note length: %d\n", length);
+          break;
+        }
+
+      if (fread(&note[1], 1, length - 1, instream) != (size_t)length - 1)
+        {
+          fprintf(stderr, "WARNING: Truncated note at end of input\n");
+          break;
+        }
+
+      process_note(note, length);
+    }
+
+  close_slices();
+  emit_cpu_names();
+  fprintf(g_outstream, "\n]}\n");
+
+  if (instream != stdin)
+    {
+      fclose(instream);
+    }
+
+  if (g_outstream != stdout)
+    {
+      fclose(g_outstream);
+    }
+
+  return EXIT_SUCCESS;
+}
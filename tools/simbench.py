@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+############################################################################
+# tools/simbench.py
+#
+#   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+#   Author: Gregory Nutt <gnutt@nuttx.org>
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name NuttX nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+# Run simulations built with CONFIG_SIM_BENCH and tabulate their results.
+# Each simulation prints lines of the form
+#
+#   simbench: <test> <metric> <value> <unit>
+#
+# followed by "simbench: done".  Give several builds to compare them side
+# by side, for example one with and one without CONFIG_MM_TLSF:
+#
+#   $ tools/simbench.py nuttx-list nuttx-tlsf
+
+import argparse
+import os
+import subprocess
+import sys
+import threading
+
+
+def run(binary, timeout, verbose):
+    results = {}
+    proc = subprocess.Popen([os.path.abspath(binary)],
+                            cwd=os.path.dirname(os.path.abspath(binary)),
+                            stdin=subprocess.DEVNULL,
+                            stdout=subprocess.PIPE,
+                            stderr=subprocess.STDOUT,
+                            universal_newlines=True,
+                            errors='replace')
+    timer = threading.Timer(timeout, proc.kill)
+    timer.start()
+    done = False
+
+    try:
+        for line in proc.stdout:
+            if verbose:
+                sys.stdout.write(line)
+
+            words = line.split()
+            if len(words) >= 2 and words[0] == 'simbench:':
+                if words[1] == 'done':
+                    done = True
+                    break
+
+                if len(words) == 5:
+                    results[(words[1], words[2])] = (words[3], words[4])
+    finally:
+        timer.cancel()
+        proc.kill()
+        proc.wait()
+
+    if not done:
+        print('%s: did not finish' % binary, file=sys.stderr)
+
+    return results
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Run sim benchmarks and tabulate the results')
+    parser.add_argument('binaries', nargs='+', metavar='nuttx',
+                        help='Simulation built with CONFIG_SIM_BENCH')
+    parser.add_argument('-t', '--test', action='append',
+                        help='Only show this test (may be repeated)')
+    parser.add_argument('-T', '--timeout', type=float, default=600.0,
+                        help='Time limit for each simulation in s '
+                             '(default 600)')
+    parser.add_argument('-v', '--verbose', action='store_true',
+                        help='Echo the console output of the simulations')
+    args = parser.parse_args()
+
+    runs = [run(b, args.timeout, args.verbose) for b in args.binaries]
+
+    keys = []
+    for results in runs:
+        for key in results:
+            if key not in keys and (not args.test or key[0] in args.test):
+                keys.append(key)
+
+    names = args.binaries
+    width = max([12] + [len(n) for n in names])
+
+    print('%-10s %-16s %-8s' % ('test', 'metric', 'unit') +
+          ''.join(' %*s' % (width, n) for n in names))
+
+    for key in keys:
+        unit = ''
+        cells = ''
+        for results in runs:
+            value, u = results.get(key, ('-', ''))
+            unit = unit or u
+            cells += ' %*s' % (width, value)
+
+        print('%-10s %-16s %-8s' % (key[0], key[1], unit) + cells)
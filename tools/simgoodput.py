@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+############################################################################
+# tools/simgoodput.py
+#
+#   Copyright (C) 2026 Gregory Nutt. All rights reserved.
+#   Author: Gregory Nutt <gnutt@nuttx.org>
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name NuttX nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+# Measure the TCP goodput of the simulator over an emulated long, lossy
+# link.  The sim/tcpblaster configuration sends to this script, which adds
+# delay and loss to the simulation's TAP device with netem and counts the
+# bytes that arrive.  Must be run as root while the simulation is running:
+#
+#   $ sudo tools/simgoodput.py -d 100 -l 1 -t 30
+#   nsh> tcpblaster
+
+import argparse
+import socket
+import subprocess
+import sys
+import time
+
+IFB = 'ifb0'
+
+
+def run(cmd, check=True):
+    return subprocess.run(cmd.split(), check=check,
+                          stdout=subprocess.DEVNULL,
+                          stderr=subprocess.DEVNULL)
+
+
+def netem_on(dev, hostip, delay, loss):
+    # The TAP egress carries the host's ACKs to the simulation.  The data
+    # from the simulation arrives on the TAP ingress, which is redirected
+    # through an IFB device so that it can be delayed and dropped too.
+
+    half = '%.1fms' % (delay / 2.0)
+
+    run('ip addr replace %s/24 dev %s' % (hostip, dev))
+    run('ip link set %s up' % dev)
+    run('ip link add %s type ifb' % IFB, check=False)
+    run('ip link set %s up' % IFB)
+
+    run('tc qdisc replace dev %s root netem delay %s' % (dev, half))
+    run('tc qdisc replace dev %s ingress' % dev)
+    run('tc filter replace dev %s parent ffff: protocol all prio 1 '
+        'matchall action mirred egress redirect dev %s' % (dev, IFB))
+    run('tc qdisc replace dev %s root netem delay %s loss %.2f%%' %
+        (IFB, half, loss))
+
+
+def netem_off(dev):
+    run('tc qdisc del dev %s root' % dev, check=False)
+    run('tc qdisc del dev %s ingress' % dev, check=False)
+    run('ip link del %s' % IFB, check=False)
+
+
+def receive(hostip, port, seconds):
+    srv = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    srv.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    srv.bind((hostip, port))
+    srv.listen(1)
+
+    print('Waiting for tcpblaster on %s:%d' % (hostip, port))
+    conn, peer = srv.accept()
+    print('Connected from %s:%d' % peer)
+
+    total = 0
+    interval = 0
+    start = time.monotonic()
+    mark = start
+    conn.settimeout(1.0)
+
+    while True:
+        now = time.monotonic()
+        if now - start >= seconds:
+            break
+
+        if now - mark >= 1.0:
+            print('%6.1f s: %10.1f kbit/s' %
+                  (now - start, interval * 8 / 1000.0 / (now - mark)))
+            interval = 0
+            mark = now
+
+        try:
+            data = conn.recv(65536)
+        except socket.timeout:
+            continue
+
+        if not data:
+            break
+
+        total += len(data)
+        interval += len(data)
+
+    elapsed = time.monotonic() - start
+    conn.close()
+    srv.close()
+
+    print('Received %d bytes in %.1f s: %.1f kbit/s goodput' %
+          (total, elapsed, total * 8 / 1000.0 / elapsed))
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Measure sim TCP goodput over an emulated link')
+    parser.add_argument('-i', '--interface', default='tap0',
+                        help='TAP device of the simulation (default tap0)')
+    parser.add_argument('-a', '--address', default='10.0.1.1',
+                        help='Host address on the TAP device '
+                             '(default 10.0.1.1)')
+    parser.add_argument('-p', '--port', type=int, default=5471,
+                        help='TCP port to listen on (default 5471)')
+    parser.add_argument('-d', '--delay', type=float, default=100.0,
+                        help='Round-trip delay in ms (default 100)')
+    parser.add_argument('-l', '--loss', type=float, default=0.0,
+                        help='Packet loss of the data path in percent '
+                             '(default 0)')
+    parser.add_argument('-t', '--time', type=float, default=30.0,
+                        help='Duration of the measurement in s '
+                             '(default 30)')
+    args = parser.parse_args()
+
+    try:
+        netem_on(args.interface, args.address, args.delay, args.loss)
+    except subprocess.CalledProcessError as e:
+        netem_off(args.interface)
+        sys.exit('Failed to set up %s: %s' % (args.interface, e))
+
+    try:
+        receive(args.address, args.port, args.time)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        netem_off(args.interface)